@@ -28,9 +28,20 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <gperftools/malloc_extension.h>
+#include <gperftools/tcmalloc.h>
 
 #include "run_benchmark.h"
 
+// tc_malloc() zeroes what it returns; this doesn't (and isn't in the
+// public header).
+extern "C" void* tc_malloc_noinit(size_t size) __THROW;
+
 static void bench_fastpath_throughput(long iterations,
                                       uintptr_t param)
 {
@@ -168,17 +179,457 @@ static void bench_fastpath_rnd_dependent(long iterations,
   }
 }
 
-int main(void)
+// The bench_zero_* benchmarks measure what zeroing costs, for objects of
+// "param" bytes.  The objects are freed without being written to, so each
+// iteration zeroes one object (but for bench_zero_noinit).
+
+static void bench_zero_malloc(long iterations, uintptr_t param)
+{
+  const size_t sz = param;
+  for (; iterations>0; iterations--) {
+    void *p = tc_malloc(sz);
+    if (!p) {
+      abort();
+    }
+    tc_free(p);
+  }
+}
+
+static void bench_zero_noinit(long iterations, uintptr_t param)
+{
+  const size_t sz = param;
+  for (; iterations>0; iterations--) {
+    void *p = tc_malloc_noinit(sz);
+    if (!p) {
+      abort();
+    }
+    tc_free(p);
+  }
+}
+
+static void bench_zero_calloc(long iterations, uintptr_t param)
+{
+  const size_t sz = param;
+  for (; iterations>0; iterations--) {
+    void *p = tc_calloc(1, sz);
+    if (!p) {
+      abort();
+    }
+    tc_free(p);
+  }
+}
+
+// Grows an object of half the size to the full size, which zeroes the
+// grown half (and copies the first, if the object moves).
+static void bench_zero_realloc(long iterations, uintptr_t param)
+{
+  const size_t sz = param;
+  for (; iterations>0; iterations--) {
+    void *p = tc_malloc_noinit(sz / 2);
+    if (!p) {
+      abort();
+    }
+    p = tc_realloc(p, sz);
+    if (!p) {
+      abort();
+    }
+    tc_free(p);
+  }
+}
+
+// A dependent chain of allocations, like bench_fastpath_dependent's, of
+// "param"-byte objects which were written in full before they were freed,
+// kChainObjects of them at a time so that they don't stay in the nearest
+// caches: each malloc zeroes a dirty object whose lines have to be fetched
+// first.  (The next size depends on a byte malloc zeroed.)  Building
+// tcmalloc with -DTCMALLOC_FREELIST_PREFETCH_LINES=0 shows what prefetching
+// the next object on the free list gains.
+static const int kChainObjects = 4096;
+
+static void bench_zero_chain(long iterations, uintptr_t param)
+{
+  static char *ptrs[kChainObjects];
+  const size_t sz = param;
+  for (; iterations > 0; iterations -= kChainObjects) {
+    size_t dep = 0;
+    for (int k = 0; k < kChainObjects; k++) {
+      char *p = static_cast<char *>(malloc(sz + dep));
+      if (!p) {
+        abort();
+      }
+      dep = p[sz - 1];
+      ptrs[k] = p;
+    }
+    for (int k = 0; k < kChainObjects; k++) {
+      memset(ptrs[k], k | 1, sz);
+      free(ptrs[k]);
+    }
+  }
+}
+
+// The bench_mt_* benchmarks run several threads, and spread the
+// iterations (objects allocated and freed) over them.  Their param is the
+// number of threads, or of pairs of threads, so reports for growing
+// params show how throughput scales.
+
+static const int kMaxThreads = 64;
+
+// Objects are handed from thread to thread in batches of kBatch, through
+// queues of up to kQueueBatches batches.
+static const int kBatch = 64;
+static const int kQueueBatches = 16;
+
+struct batch_queue {
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int head;
+  int count;
+  void *batches[kQueueBatches][kBatch];
+};
+
+static batch_queue queues[kMaxThreads];
+
+static void queue_init(batch_queue *q)
+{
+  pthread_mutex_init(&q->lock, NULL);
+  pthread_cond_init(&q->cond, NULL);
+  q->head = q->count = 0;
+}
+
+static void queue_destroy(batch_queue *q)
+{
+  pthread_mutex_destroy(&q->lock);
+  pthread_cond_destroy(&q->cond);
+}
+
+static void queue_push(batch_queue *q, void **batch)
+{
+  pthread_mutex_lock(&q->lock);
+  while (q->count == kQueueBatches) {
+    pthread_cond_wait(&q->cond, &q->lock);
+  }
+  memcpy(q->batches[(q->head + q->count) % kQueueBatches], batch,
+         sizeof(q->batches[0]));
+  q->count++;
+  pthread_cond_broadcast(&q->cond);
+  pthread_mutex_unlock(&q->lock);
+}
+
+static void queue_pop(batch_queue *q, void **batch)
+{
+  pthread_mutex_lock(&q->lock);
+  while (q->count == 0) {
+    pthread_cond_wait(&q->cond, &q->lock);
+  }
+  memcpy(batch, q->batches[q->head], sizeof(q->batches[0]));
+  q->head = (q->head + 1) % kQueueBatches;
+  q->count--;
+  pthread_cond_broadcast(&q->cond);
+  pthread_mutex_unlock(&q->lock);
+}
+
+static void alloc_batch(void **batch, size_t sz)
+{
+  for (int k = 0; k < kBatch; k++) {
+    batch[k] = malloc(sz);
+    if (!batch[k]) {
+      abort();
+    }
+  }
+}
+
+static void free_batch(void **batch)
+{
+  for (int k = 0; k < kBatch; k++) {
+    free(batch[k]);
+  }
+}
+
+struct mt_thread {
+  pthread_t tid;
+  int index;
+  long rounds;
+};
+
+static void run_threads(int nthreads, long rounds, void *(*fn)(void *))
+{
+  mt_thread threads[kMaxThreads];
+  for (int i = 0; i < nthreads; i++) {
+    threads[i].index = i;
+    threads[i].rounds = rounds;
+    if (pthread_create(&threads[i].tid, NULL, fn, &threads[i]) != 0) {
+      abort();
+    }
+  }
+  for (int i = 0; i < nthreads; i++) {
+    pthread_join(threads[i].tid, NULL);
+  }
+}
+
+// Each thread of a pair allocates batches for the other to free, and
+// frees the ones it gets back.
+static void *ping_pong_thread(void *arg)
+{
+  mt_thread *t = static_cast<mt_thread *>(arg);
+  void *batch[kBatch];
+  for (long r = 0; r < t->rounds; r++) {
+    alloc_batch(batch, 64);
+    queue_push(&queues[t->index ^ 1], batch);
+    queue_pop(&queues[t->index], batch);
+    free_batch(batch);
+  }
+  return NULL;
+}
+
+static void bench_mt_ping_pong(long iterations, uintptr_t param)
+{
+  const int nthreads = 2 * static_cast<int>(param);
+  for (int i = 0; i < nthreads; i++) {
+    queue_init(&queues[i]);
+  }
+  run_threads(nthreads, iterations / (nthreads * kBatch) + 1,
+              ping_pong_thread);
+  for (int i = 0; i < nthreads; i++) {
+    queue_destroy(&queues[i]);
+  }
+}
+
+// Even threads allocate, odd ones free, through one shared queue.
+static void *producer_consumer_thread(void *arg)
+{
+  mt_thread *t = static_cast<mt_thread *>(arg);
+  void *batch[kBatch];
+  for (long r = 0; r < t->rounds; r++) {
+    if (t->index % 2 == 0) {
+      alloc_batch(batch, 64);
+      queue_push(&queues[0], batch);
+    } else {
+      queue_pop(&queues[0], batch);
+      free_batch(batch);
+    }
+  }
+  return NULL;
+}
+
+static void bench_mt_producer_consumer(long iterations, uintptr_t param)
 {
-  report_benchmark("bench_fastpath_throughput", bench_fastpath_throughput, 0);
-  report_benchmark("bench_fastpath_dependent", bench_fastpath_dependent, 0);
-  report_benchmark("bench_fastpath_simple", bench_fastpath_simple, 0);
+  const int nthreads = 2 * static_cast<int>(param);
+  queue_init(&queues[0]);
+  run_threads(nthreads, 2 * iterations / (nthreads * kBatch) + 1,
+              producer_consumer_thread);
+  queue_destroy(&queues[0]);
+}
+
+// Each thread allocates and frees a few objects of sizes all over the
+// place, so that many of its size classes hold a few objects.
+static const int kFew = 8;
+
+static void *few_allocs_thread(void *arg)
+{
+  mt_thread *t = static_cast<mt_thread *>(arg);
+  void *ptrs[kFew];
+  size_t sz = 16 + 16 * t->index;
+  for (long r = 0; r < t->rounds; r++) {
+    for (int k = 0; k < kFew; k++) {
+      ptrs[k] = malloc(sz);
+      if (!ptrs[k]) {
+        abort();
+      }
+      sz = (sz * 7 + 16) & 32767;
+    }
+    for (int k = kFew - 1; k >= 0; k--) {
+      free(ptrs[k]);
+    }
+  }
+  return NULL;
+}
+
+static void bench_mt_few_allocs(long iterations, uintptr_t param)
+{
+  const int nthreads = static_cast<int>(param);
+  run_threads(nthreads, iterations / (nthreads * kFew) + 1,
+              few_allocs_thread);
+}
+
+// Here an iteration is a whole thread, which allocates and frees a few
+// objects and exits, so its cache is set up and torn down again.
+static void *churn_thread(void *arg)
+{
+  mt_thread *t = static_cast<mt_thread *>(arg);
+  t->rounds = 1;
+  return few_allocs_thread(arg);
+}
+
+static void bench_mt_thread_churn(long iterations, uintptr_t param)
+{
+  const int nthreads = static_cast<int>(param);
+  for (; iterations > 0; iterations -= nthreads) {
+    run_threads(nthreads, 1, churn_thread);
+  }
+}
+
+// Each iteration allocates a large buffer, writes to each of its pages
+// and frees it again, so what it costs is mostly in how the page heap
+// releases and reuses the pages: system calls and page faults.
+static long large_cycles;
+
+static void bench_large_cycle(long iterations, uintptr_t param)
+{
+  const size_t page = 4096;
+  for (; iterations > 0; iterations--) {
+    char *p = static_cast<char *>(malloc(param));
+    if (!p) {
+      abort();
+    }
+    for (size_t i = 0; i < param; i += page) {
+      p[i] = 1;
+    }
+    free(p);
+    large_cycles++;
+  }
+}
+
+// Which benchmarks to run: those whose names contain the filter, or just
+// the bench_fastpath ones if there is none.  (The bench_zero ones cover
+// every size class, and take a while.)
+static const char *filter;
+
+static bool selected(const char *name)
+{
+  if (filter == NULL) {
+    return strncmp(name, "bench_fastpath", 14) == 0;
+  }
+  return strstr(name, filter) != NULL;
+}
+
+static void report(const char *name, bench_body body, uintptr_t param)
+{
+  if (selected(name)) {
+    report_benchmark(name, body, param);
+  }
+}
+
+static void report_zeroing(const char *name, bench_body body)
+{
+  if (!selected(name)) {
+    return;
+  }
+  // Every size class up to the largest, by its largest size
+  const size_t max_size = 512 << 10;
+  size_t class_size = 0;
+  for (size_t sz = 1; sz <= max_size; sz = class_size + 1) {
+    class_size = MallocExtension::instance()->GetEstimatedAllocatedSize(sz);
+    if (class_size > max_size) {
+      break;
+    }
+    report_benchmark_bytes(name, body, class_size, class_size);
+  }
+}
+
+// Reports for 1, 2, 4... threads (or pairs of them), up to the number of
+// CPUs.
+static void report_scaling(const char *name, bench_body body, bool pairs)
+{
+  if (!selected(name)) {
+    return;
+  }
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (pairs) {
+    cpus /= 2;
+  }
+  if (cpus > kMaxThreads / 2) {
+    cpus = kMaxThreads / 2;
+  }
+  for (long n = 1; n == 1 || n <= cpus; n <<= 1) {
+    report_benchmark(name, body, n);
+  }
+}
+
+struct large_counters {
+  long minor_faults;
+  size_t reserves;
+  size_t commits;
+  size_t decommits;
+};
+
+static void get_large_counters(large_counters *c)
+{
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  c->minor_faults = ru.ru_minflt;
+  MallocExtension *ext = MallocExtension::instance();
+  c->reserves = c->commits = c->decommits = 0;
+  ext->GetNumericProperty("tcmalloc.pageheap_reserve_count", &c->reserves);
+  ext->GetNumericProperty("tcmalloc.pageheap_commit_count", &c->commits);
+  ext->GetNumericProperty("tcmalloc.pageheap_decommit_count", &c->decommits);
+}
+
+static double rss_mib()
+{
+  long pages = 0;
+  FILE *f = fopen("/proc/self/statm", "r");
+  if (f) {
+    if (fscanf(f, "%*ld %ld", &pages) != 1) {
+      pages = 0;
+    }
+    fclose(f);
+  }
+  return pages * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+// Reports bench_large_cycle for a buffer of "size" bytes, and what each
+// cycle cost in page faults and page heap system calls.
+static void report_large(const char *name, size_t size)
+{
+  if (!selected(name)) {
+    return;
+  }
+  large_counters before, after;
+  get_large_counters(&before);
+  large_cycles = 0;
+  report_benchmark_bytes(name, bench_large_cycle, size, size);
+  get_large_counters(&after);
+  const double cycles = large_cycles;
+  printf("  per cycle: %.2f minor faults, %.2f reserve, %.2f commit, "
+         "%.2f decommit calls; RSS %.1f MiB\n",
+         (after.minor_faults - before.minor_faults) / cycles,
+         (after.reserves - before.reserves) / cycles,
+         (after.commits - before.commits) / cycles,
+         (after.decommits - before.decommits) / cycles,
+         rss_mib());
+}
+
+int main(int argc, char **argv)
+{
+  if (argc > 1) {
+    filter = argv[1];
+  }
+  report("bench_fastpath_throughput", bench_fastpath_throughput, 0);
+  report("bench_fastpath_dependent", bench_fastpath_dependent, 0);
+  report("bench_fastpath_simple", bench_fastpath_simple, 0);
   for (int i = 8; i <= 512; i <<= 1) {
-    report_benchmark("bench_fastpath_stack", bench_fastpath_stack, i);
+    report("bench_fastpath_stack", bench_fastpath_stack, i);
+  }
+  report("bench_fastpath_stack_simple", bench_fastpath_stack_simple, 32);
+  report("bench_fastpath_stack_simple", bench_fastpath_stack_simple, 8192);
+  report("bench_fastpath_rnd_dependent", bench_fastpath_rnd_dependent, 32);
+  report("bench_fastpath_rnd_dependent", bench_fastpath_rnd_dependent, 8192);
+  report_zeroing("bench_zero_malloc", bench_zero_malloc);
+  report_zeroing("bench_zero_noinit", bench_zero_noinit);
+  report_zeroing("bench_zero_calloc", bench_zero_calloc);
+  report_zeroing("bench_zero_realloc", bench_zero_realloc);
+  if (selected("bench_zero_chain")) {
+    for (size_t sz = 64; sz <= 1024; sz <<= 2) {
+      report_benchmark_bytes("bench_zero_chain", bench_zero_chain, sz, sz);
+    }
   }
-  report_benchmark("bench_fastpath_stack_simple", bench_fastpath_stack_simple, 32);
-  report_benchmark("bench_fastpath_stack_simple", bench_fastpath_stack_simple, 8192);
-  report_benchmark("bench_fastpath_rnd_dependent", bench_fastpath_rnd_dependent, 32);
-  report_benchmark("bench_fastpath_rnd_dependent", bench_fastpath_rnd_dependent, 8192);
+  report_scaling("bench_mt_ping_pong", bench_mt_ping_pong, true);
+  report_scaling("bench_mt_producer_consumer", bench_mt_producer_consumer,
+                 true);
+  report_scaling("bench_mt_few_allocs", bench_mt_few_allocs, false);
+  report_scaling("bench_mt_thread_churn", bench_mt_thread_churn, false);
+  report_large("bench_large_cycle", 1 << 20);
+  report_large("bench_large_cycle", 8 << 20);
+  report_large("bench_large_cycle", 64 << 20);
   return 0;
 }
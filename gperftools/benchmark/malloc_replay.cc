@@ -0,0 +1,292 @@
+// -*- Mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*-
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Replays an allocation trace written with TCMALLOC_TRACE_FILE (see
+// src/alloc_trace.h), so that the same allocations can be tried with
+// different settings (TCMALLOC_* environment variables, or builds):
+//
+//   malloc_replay [-s] [-n] trace
+//
+// Each recorded thread gets a thread of its own, and the events are
+// replayed in their recorded order, handing off from thread to thread
+// as it changes; -s replays them all on one thread instead.  The gaps
+// between events are not replayed.  -n allocates with
+// tc_malloc_noinit(), which does not zero.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <map>
+#include <vector>
+
+#include <gperftools/malloc_extension.h>
+#include <gperftools/tcmalloc.h>
+
+#include "alloc_trace.h"
+
+extern "C" void* tc_malloc_noinit(size_t size) __THROW;
+
+using tcmalloc::AllocTraceRecord;
+using tcmalloc::kAllocTraceFree;
+using tcmalloc::kAllocTraceMagic;
+
+// An event, with the recorded pointer turned into a slot in "slots" and
+// the recorded thread into a worker.
+struct op {
+  uint64_t size;
+  uint32_t slot;
+  uint16_t worker;
+  bool is_free;
+};
+
+static std::vector<op> ops;
+static std::vector<void *> slots;
+static int nworkers;
+static bool use_noinit;
+
+static long dropped_frees;  // of objects allocated before the trace started
+
+static void load_trace(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  char magic[sizeof(kAllocTraceMagic)];
+  if (fread(magic, sizeof(magic), 1, f) != 1 ||
+      memcmp(magic, kAllocTraceMagic, sizeof(magic)) != 0) {
+    fprintf(stderr, "%s: not an allocation trace\n", path);
+    exit(1);
+  }
+
+  std::map<uint64_t, uint32_t> live;      // recorded pointer -> slot
+  std::map<uint64_t, uint16_t> threads;   // recorded thread -> worker
+  std::vector<uint32_t> free_slots;
+  AllocTraceRecord r;
+  while (fread(&r, sizeof(r), 1, f) == 1) {
+    op o;
+    std::map<uint64_t, uint16_t>::iterator t = threads.find(r.thread);
+    if (t == threads.end()) {
+      t = threads.insert(std::make_pair(r.thread,
+                                        (uint16_t)threads.size())).first;
+    }
+    o.worker = t->second;
+    o.is_free = (r.size == kAllocTraceFree);
+    if (o.is_free) {
+      std::map<uint64_t, uint32_t>::iterator l = live.find(r.ptr);
+      if (l == live.end()) {
+        dropped_frees++;
+        continue;
+      }
+      o.size = 0;
+      o.slot = l->second;
+      free_slots.push_back(l->second);
+      live.erase(l);
+    } else {
+      o.size = r.size;
+      if (free_slots.empty()) {
+        o.slot = slots.size();
+        slots.push_back(NULL);
+      } else {
+        o.slot = free_slots.back();
+        free_slots.pop_back();
+      }
+      live[r.ptr] = o.slot;
+    }
+    ops.push_back(o);
+  }
+  fclose(f);
+  nworkers = threads.size();
+}
+
+static size_t live_bytes;
+static size_t peak_live_bytes;
+static size_t peak_heap_bytes;
+static std::vector<size_t> slot_sizes;
+
+static void sample_heap()
+{
+  size_t heap = 0;
+  MallocExtension::instance()->GetNumericProperty("generic.heap_size",
+                                                  &heap);
+  if (heap > peak_heap_bytes) {
+    peak_heap_bytes = heap;
+  }
+}
+
+// Runs ops [begin, end).  Only one thread runs ops at a time.
+static void run_ops(size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++) {
+    const op &o = ops[i];
+    if (o.is_free) {
+      free(slots[o.slot]);
+      live_bytes -= slot_sizes[o.slot];
+    } else {
+      void *p = use_noinit ? tc_malloc_noinit(o.size) : malloc(o.size);
+      if (p == NULL && o.size != 0) {
+        abort();
+      }
+      slots[o.slot] = p;
+      slot_sizes[o.slot] = o.size;
+      live_bytes += o.size;
+      if (live_bytes > peak_live_bytes) {
+        peak_live_bytes = live_bytes;
+      }
+    }
+    if ((i & 0xffff) == 0) {
+      sample_heap();
+    }
+  }
+}
+
+// Workers take turns: whichever one the next op belongs to runs ops
+// until they belong to another, and then wakes that one up.
+static pthread_mutex_t turn_lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t next_op;
+static std::vector<pthread_cond_t> turn_conds;
+
+static void *worker_thread(void *arg)
+{
+  const int me = static_cast<int>(reinterpret_cast<intptr_t>(arg));
+  pthread_mutex_lock(&turn_lock);
+  while (1) {
+    while (next_op < ops.size() && ops[next_op].worker != me) {
+      pthread_cond_wait(&turn_conds[me], &turn_lock);
+    }
+    if (next_op == ops.size()) {
+      break;
+    }
+    size_t begin = next_op, end = next_op;
+    pthread_mutex_unlock(&turn_lock);
+    while (end < ops.size() && ops[end].worker == me) {
+      end++;
+    }
+    run_ops(begin, end);
+    pthread_mutex_lock(&turn_lock);
+    next_op = end;
+    if (next_op < ops.size()) {
+      pthread_cond_signal(&turn_conds[ops[next_op].worker]);
+    } else {
+      for (int w = 0; w < nworkers; w++) {
+        pthread_cond_signal(&turn_conds[w]);
+      }
+    }
+  }
+  pthread_mutex_unlock(&turn_lock);
+  return NULL;
+}
+
+static void replay_threaded()
+{
+  std::vector<pthread_t> tids(nworkers);
+  turn_conds.resize(nworkers);
+  for (int w = 0; w < nworkers; w++) {
+    pthread_cond_init(&turn_conds[w], NULL);
+  }
+  for (int w = 0; w < nworkers; w++) {
+    if (pthread_create(&tids[w], NULL, worker_thread,
+                       reinterpret_cast<void *>(static_cast<intptr_t>(w)))) {
+      abort();
+    }
+  }
+  for (int w = 0; w < nworkers; w++) {
+    pthread_join(tids[w], NULL);
+  }
+  for (int w = 0; w < nworkers; w++) {
+    pthread_cond_destroy(&turn_conds[w]);
+  }
+}
+
+static size_t get_property(const char *name)
+{
+  size_t value = 0;
+  MallocExtension::instance()->GetNumericProperty(name, &value);
+  return value;
+}
+
+int main(int argc, char **argv)
+{
+  bool single_thread = false;
+  int i;
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-s") == 0) {
+      single_thread = true;
+    } else if (strcmp(argv[i], "-n") == 0) {
+      use_noinit = true;
+    } else {
+      break;
+    }
+  }
+  if (i != argc - 1) {
+    fprintf(stderr, "usage: %s [-s] [-n] trace\n", argv[0]);
+    return 1;
+  }
+
+  load_trace(argv[i]);
+  slot_sizes.resize(slots.size());
+
+  struct rusage ru_before, ru_after;
+  struct timeval tv_before, tv_after;
+  // (The heap already holds the ops; we report how much it grows.)
+  const size_t heap_before = get_property("generic.heap_size");
+  const size_t decommits_before =
+      get_property("tcmalloc.pageheap_decommit_count");
+  getrusage(RUSAGE_SELF, &ru_before);
+  gettimeofday(&tv_before, NULL);
+  if (single_thread || nworkers <= 1) {
+    run_ops(0, ops.size());
+  } else {
+    replay_threaded();
+  }
+  gettimeofday(&tv_after, NULL);
+  getrusage(RUSAGE_SELF, &ru_after);
+  sample_heap();
+
+  const double nsec = (tv_after.tv_sec - tv_before.tv_sec) * 1E9 +
+      (tv_after.tv_usec - tv_before.tv_usec) * 1E3;
+  printf("events:           %zu (%ld frees of older objects dropped)\n",
+         ops.size(), dropped_frees);
+  printf("threads:          %d%s\n", nworkers,
+         single_thread ? " (replayed on one)" : "");
+  printf("time:             %.3f sec, %.1f nsec per event\n",
+         nsec / 1E9, ops.empty() ? 0.0 : nsec / ops.size());
+  printf("peak live bytes:  %zu\n", peak_live_bytes);
+  printf("peak heap growth: %zu (sampled)\n",
+         peak_heap_bytes > heap_before ? peak_heap_bytes - heap_before : 0);
+  printf("minor faults:     %ld\n", ru_after.ru_minflt - ru_before.ru_minflt);
+  printf("decommit calls:   %zu\n",
+         get_property("tcmalloc.pageheap_decommit_count") - decommits_before);
+  return 0;
+}
@@ -25,12 +25,20 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // for sched_getaffinity and sched_getcpu
+#endif
+
 #include "run_benchmark.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 struct internal_bench {
   bench_body body;
@@ -71,33 +79,253 @@ static double measure_once(struct internal_bench *b, long iterations)
 #define TRIAL_NSEC 0.3E9
 #define TARGET_NSEC 3E9
 
-static double run_benchmark(struct internal_bench *b)
+// Runs the body for TARGET_NSEC or so, and returns the time per
+// iteration.  (*iterations is how many it took.)
+static double run_benchmark(struct internal_bench *b, long *iterations)
 {
-  long iterations = 128;
+  long n = 128;
   double nsec;
   while (1) {
-    nsec = measure_once(b, iterations);
+    nsec = measure_once(b, n);
     if (nsec > TRIAL_NSEC) {
       break;
     }
-    iterations <<= 1;
+    n <<= 1;
   }
   while (nsec < TARGET_NSEC) {
-    iterations = (long)(iterations * TARGET_NSEC * 1.1 / nsec);
-    nsec = measure_once(b, iterations);
+    n = (long)(n * TARGET_NSEC * 1.1 / nsec);
+    nsec = measure_once(b, n);
+  }
+  *iterations = n;
+  return nsec / n;
+}
+
+// The environment controls how benchmarks are run and reported:
+//   BENCHMARK_REPEATS  how many times each one is measured (3)
+//   BENCHMARK_WARMUP   how many runs before that are thrown away (0)
+//   BENCHMARK_FORMAT   "csv" or "json" for a record per benchmark, with
+//                      the mean, stddev, min, max and 95% confidence
+//                      interval of its repeats, instead of a line per
+//                      repeat ("text")
+//   BENCHMARK_OUT      file to write the csv or json records to, in
+//                      which case the text lines still go to stdout
+// The json records are one object per line, after one describing the
+// machine (CPU frequency and affinity), which csv has as # comments.
+
+enum format { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON };
+
+static struct {
+  int initialized;
+  int repeats;
+  int warmup;
+  enum format format;
+  FILE *out;         // for the csv or json records
+  int print_text;
+} config;
+
+static int env_int(const char *name, int def)
+{
+  const char *value = getenv(name);
+  if (value == NULL || *value == '\0') {
+    return def;
+  }
+  return atoi(value);
+}
+
+static void read_cpu_mhz(char *buf, size_t len)
+{
+  FILE *f;
+  char line[256];
+  snprintf(buf, len, "unknown");
+  f = fopen("/proc/cpuinfo", "r");
+  if (f == NULL) {
+    return;
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    double mhz;
+    if (strncmp(line, "cpu MHz", 7) == 0 &&
+        sscanf(strchr(line, ':') + 1, "%lf", &mhz) == 1) {
+      snprintf(buf, len, "%.0f", mhz);
+      break;
+    }
+  }
+  fclose(f);
+}
+
+static void read_governor(char *buf, size_t len)
+{
+  FILE *f;
+  snprintf(buf, len, "unknown");
+  f = fopen("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", "r");
+  if (f == NULL) {
+    return;
+  }
+  if (fgets(buf, (int)len, f) == NULL) {
+    snprintf(buf, len, "unknown");
+  }
+  buf[strcspn(buf, "\n")] = '\0';
+  fclose(f);
+}
+
+static void print_context(void)
+{
+  char mhz[32], governor[64];
+  int allowed_cpus = -1, cpu = -1;
+#ifdef __linux__
+  cpu_set_t set;
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    allowed_cpus = CPU_COUNT(&set);
+  }
+  cpu = sched_getcpu();
+#endif
+  read_cpu_mhz(mhz, sizeof(mhz));
+  read_governor(governor, sizeof(governor));
+
+  if (config.format == FORMAT_JSON) {
+    fprintf(config.out,
+            "{\"context\": {\"cpu_mhz\": \"%s\", \"governor\": \"%s\", "
+            "\"allowed_cpus\": %d, \"cpu\": %d, \"repeats\": %d, "
+            "\"warmup\": %d}}\n",
+            mhz, governor, allowed_cpus, cpu, config.repeats, config.warmup);
+  } else {
+    fprintf(config.out,
+            "# cpu_mhz=%s governor=%s allowed_cpus=%d cpu=%d repeats=%d "
+            "warmup=%d\n",
+            mhz, governor, allowed_cpus, cpu, config.repeats, config.warmup);
+    fprintf(config.out,
+            "name,param,bytes,repeats,iterations,mean_ns,stddev_ns,"
+            "min_ns,max_ns,ci95_ns\n");
+  }
+}
+
+static void init_config(void)
+{
+  const char *format = getenv("BENCHMARK_FORMAT");
+  const char *out = getenv("BENCHMARK_OUT");
+
+  config.initialized = 1;
+  config.repeats = env_int("BENCHMARK_REPEATS", 3);
+  if (config.repeats < 1) {
+    config.repeats = 1;
+  }
+  config.warmup = env_int("BENCHMARK_WARMUP", 0);
+  config.format = FORMAT_TEXT;
+  if (format != NULL && strcmp(format, "csv") == 0) {
+    config.format = FORMAT_CSV;
+  } else if (format != NULL && strcmp(format, "json") == 0) {
+    config.format = FORMAT_JSON;
   }
-  return nsec / iterations;
+  config.out = stdout;
+  config.print_text = (config.format == FORMAT_TEXT);
+  if (config.format != FORMAT_TEXT && out != NULL && *out != '\0') {
+    config.out = fopen(out, "w");
+    if (config.out == NULL) {
+      perror(out);
+      abort();
+    }
+    config.print_text = 1;
+  }
+  if (config.format != FORMAT_TEXT) {
+    print_context();
+  }
+}
+
+// Two-sided 95% quantiles of Student's t distribution, by degrees of
+// freedom; past the end of the table the normal one is close enough.
+static double t95(int df)
+{
+  static const double table[] = {
+    0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+    2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+    2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045,
+    2.042
+  };
+  if (df < (int)(sizeof(table) / sizeof(table[0]))) {
+    return table[df];
+  }
+  return 1.960;
+}
+
+static void print_record(const char *name, uintptr_t param, size_t bytes,
+                         const double *nsecs, long iterations)
+{
+  int i, n = config.repeats;
+  double sum = 0, sq = 0, min = nsecs[0], max = nsecs[0];
+  double mean, stddev = 0, ci95 = 0;
+  for (i = 0; i < n; i++) {
+    sum += nsecs[i];
+    if (nsecs[i] < min) {
+      min = nsecs[i];
+    }
+    if (nsecs[i] > max) {
+      max = nsecs[i];
+    }
+  }
+  mean = sum / n;
+  if (n > 1) {
+    for (i = 0; i < n; i++) {
+      sq += (nsecs[i] - mean) * (nsecs[i] - mean);
+    }
+    stddev = sqrt(sq / (n - 1));
+    ci95 = t95(n - 1) * stddev / sqrt(n);
+  }
+
+  if (config.format == FORMAT_JSON) {
+    fprintf(config.out, "{\"name\": \"");
+    for (; *name; name++) {
+      if (*name == '"' || *name == '\\') {
+        fputc('\\', config.out);
+      }
+      fputc(*name, config.out);
+    }
+    fprintf(config.out,
+            "\", \"param\": %llu, \"bytes\": %llu, \"repeats\": %d, "
+            "\"iterations\": %ld, \"mean_ns\": %f, \"stddev_ns\": %f, "
+            "\"min_ns\": %f, \"max_ns\": %f, \"ci95_ns\": %f}\n",
+            (unsigned long long)param, (unsigned long long)bytes, n,
+            iterations, mean, stddev, min, max, ci95);
+  } else {
+    fprintf(config.out, "%s,%llu,%llu,%d,%ld,%f,%f,%f,%f,%f\n",
+            name, (unsigned long long)param, (unsigned long long)bytes, n,
+            iterations, mean, stddev, min, max, ci95);
+  }
+  fflush(config.out);
 }
 
 void report_benchmark(const char *name, bench_body body, uintptr_t param)
+{
+  report_benchmark_bytes(name, body, param, 0);
+}
+
+void report_benchmark_bytes(const char *name, bench_body body,
+                            uintptr_t param, size_t bytes)
 {
   int i;
   struct internal_bench b = {.body = body, .param = param};
-  for (i = 0; i < 3; i++) {
-    double nsec = run_benchmark(&b);
+  double *nsecs;
+  long iterations = 0;
+
+  if (!config.initialized) {
+    init_config();
+  }
+  nsecs = (double *)malloc(config.repeats * sizeof(*nsecs));
+  if (nsecs == NULL) {
+    abort();
+  }
+
+  for (i = 0; i < config.warmup; i++) {
+    run_benchmark(&b, &iterations);
+  }
+  for (i = 0; i < config.repeats; i++) {
+    double nsec = run_benchmark(&b, &iterations);
     int slen;
     int padding_size;
 
+    nsecs[i] = nsec;
+    if (!config.print_text) {
+      continue;
+    }
+
     slen = printf("Benchmark: %s", name);
     if (param && name[strlen(name)-1] != ')') {
       slen += printf("(%lld)", (long long)param);
@@ -106,7 +334,18 @@ void report_benchmark(const char *name, bench_body body, uintptr_t param)
     if (padding_size < 1) {
       padding_size = 1;
     }
-    printf("%*c%f nsec\n", padding_size, ' ', nsec);
+    if (bytes) {
+      // (bytes per nsec is GB/s)
+      printf("%*c%f nsec %10.3f GB/s\n", padding_size, ' ', nsec,
+             bytes / nsec);
+    } else {
+      printf("%*c%f nsec\n", padding_size, ' ', nsec);
+    }
     fflush(stdout);
   }
+
+  if (config.format != FORMAT_TEXT) {
+    print_record(name, param, bytes, nsecs, iterations);
+  }
+  free(nsecs);
 }
@@ -26,6 +26,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _RUN_BENCHMARK_H_
 #define _RUN_BENCHMARK_H_
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -34,8 +35,17 @@ extern "C" {
 
 typedef void (*bench_body)(long iterations, uintptr_t param);
 
+// How many times benchmarks are measured, and whether the results are
+// also written as csv or json, is up to BENCHMARK_* environment
+// variables; see run_benchmark.c.
+
 void report_benchmark(const char *name, bench_body body, uintptr_t param);
 
+// Like report_benchmark, but also reports the throughput in GB/s, given
+// that each iteration handles "bytes" bytes.
+void report_benchmark_bytes(const char *name, bench_body body,
+                            uintptr_t param, size_t bytes);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,157 @@
+// -*- Mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*-
+// Copyright (c) 2008, Google Inc.
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <config.h>
+#include "alloc_trace.h"
+
+#include <errno.h>                      // for errno, EINTR
+#include <fcntl.h>                      // for open, O_WRONLY, etc
+#include <stddef.h>                     // for size_t, NULL
+#include <time.h>                       // for clock_gettime
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>                     // for write, close
+#endif
+#ifdef HAVE_PTHREAD
+#include <pthread.h>                    // for pthread_self
+#endif
+
+#include <gperftools/malloc_hook.h>     // for MallocHook
+#include "base/spinlock.h"              // for SpinLockHolder, SpinLock
+#include "getenv_safe.h"                // for TCMallocGetenvSafe
+#include "internal_logging.h"           // for Log, kLog
+
+namespace tcmalloc {
+
+// Events are buffered here, and written out a buffer at a time, all
+// under trace_lock.  We can't allocate, being called from the hooks.
+static SpinLock trace_lock(SpinLock::LINKER_INITIALIZED);
+static const int kTraceBufferRecords = 4096;
+static AllocTraceRecord trace_buffer[kTraceBufferRecords];
+static int trace_buffered = 0;
+static int trace_fd = -1;
+static uint64_t trace_start_nanos = 0;
+
+static uint64_t NowNanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static bool WriteFully(int fd, const void* buf, size_t len) {
+  const char* p = static_cast<const char*>(buf);
+  while (len > 0) {
+    ssize_t n = write(fd, p, len);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    len -= n;
+  }
+  return true;
+}
+
+static void FlushLocked() {
+  if (trace_buffered > 0 &&
+      !WriteFully(trace_fd, trace_buffer,
+                  trace_buffered * sizeof(trace_buffer[0]))) {
+    // Stop, rather than write a trace with holes in it
+    close(trace_fd);
+    trace_fd = -1;
+  }
+  trace_buffered = 0;
+}
+
+static void Record(const void* ptr, uint64_t size) {
+  if (ptr == NULL) return;
+  AllocTraceRecord r;
+  r.ptr = reinterpret_cast<uintptr_t>(ptr);
+  r.size = size;
+#ifdef HAVE_PTHREAD
+  r.thread = (uint64_t)pthread_self();
+#else
+  r.thread = 0;
+#endif
+  SpinLockHolder h(&trace_lock);
+  if (trace_fd < 0) return;
+  // (taken under the lock, so that the times are in order)
+  r.nanos = NowNanos() - trace_start_nanos;
+  trace_buffer[trace_buffered++] = r;
+  if (trace_buffered == kTraceBufferRecords) {
+    FlushLocked();
+  }
+}
+
+static void TraceNewHook(const void* ptr, size_t size) {
+  Record(ptr, size);
+}
+
+static void TraceDeleteHook(const void* ptr) {
+  Record(ptr, kAllocTraceFree);
+}
+
+void StartAllocationTrace() {
+  const char* path = TCMallocGetenvSafe("TCMALLOC_TRACE_FILE");
+  if (path == NULL || *path == '\0') return;
+#ifdef NO_TCMALLOC_MALLOC_HOOKS
+  Log(kLog, __FILE__, __LINE__,
+      "TCMALLOC_TRACE_FILE is ignored: tcmalloc was built without "
+      "malloc hooks");
+  return;
+#endif
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    Log(kLog, __FILE__, __LINE__,
+        "Could not open the allocation trace file", path);
+    return;
+  }
+  if (!WriteFully(fd, kAllocTraceMagic, sizeof(kAllocTraceMagic))) {
+    close(fd);
+    return;
+  }
+  {
+    SpinLockHolder h(&trace_lock);
+    trace_fd = fd;
+    trace_start_nanos = NowNanos();
+  }
+  MallocHook::AddNewHook(&TraceNewHook);
+  MallocHook::AddDeleteHook(&TraceDeleteHook);
+}
+
+void FinishAllocationTrace() {
+  if (trace_fd < 0) return;
+  MallocHook::RemoveNewHook(&TraceNewHook);
+  MallocHook::RemoveDeleteHook(&TraceDeleteHook);
+  SpinLockHolder h(&trace_lock);
+  if (trace_fd < 0) return;
+  FlushLocked();
+  if (trace_fd >= 0) close(trace_fd);
+  trace_fd = -1;
+}
+
+}  // namespace tcmalloc
@@ -0,0 +1,68 @@
+// -*- Mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*-
+// Copyright (c) 2008, Google Inc.
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// ---
+// Allocation traces: with TCMALLOC_TRACE_FILE set, every allocation and
+// free the malloc hooks see is written to that file, for
+// benchmark/malloc_replay to replay later.
+
+#ifndef TCMALLOC_ALLOC_TRACE_H_
+#define TCMALLOC_ALLOC_TRACE_H_
+
+#include "config.h"
+#ifdef HAVE_STDINT_H
+#include <stdint.h>                     // for uint64_t
+#endif
+
+namespace tcmalloc {
+
+// The file starts with kAllocTraceMagic (8 bytes, with its '\0'), and
+// then has one record per event, in the order the events happened, in
+// the byte order of the machine that wrote it.
+static const char kAllocTraceMagic[8] = "TCMTRC1";
+
+struct AllocTraceRecord {
+  uint64_t ptr;
+  uint64_t size;      // with kAllocTraceFree set for frees
+  uint64_t thread;    // pthread_self() of the thread, just to tell them apart
+  uint64_t nanos;     // since the trace started
+};
+
+static const uint64_t kAllocTraceFree = 1ULL << 63;
+
+// Starts tracing if TCMALLOC_TRACE_FILE names a file we can write.
+void StartAllocationTrace();
+
+// Writes out what is buffered, and stops tracing.
+void FinishAllocationTrace();
+
+}  // namespace tcmalloc
+
+#endif  // TCMALLOC_ALLOC_TRACE_H_
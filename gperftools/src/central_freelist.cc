@@ -33,11 +33,13 @@
 
 #include "config.h"
 #include <algorithm>
+#include <string.h>                     // for memset
 #include "central_freelist.h"
 #include "internal_logging.h"  // for ASSERT, MESSAGE
 #include "linked_list.h"       // for SLL_Next, SLL_Push, etc
 #include "page_heap.h"         // for PageHeap
 #include "static_vars.h"       // for Static
+#include "thread_cache.h"      // for ThreadCache
 
 using std::min;
 using std::max;
@@ -47,9 +49,13 @@ namespace tcmalloc {
 void CentralFreeList::Init(size_t cl) {
   size_class_ = cl;
   tcmalloc::DLL_Init(&empty_);
-  tcmalloc::DLL_Init(&nonempty_);
+  for (int node = 0; node < kMaxNumaNodes; ++node) {
+    tcmalloc::DLL_Init(&nonempty_[node]);
+  }
   num_spans_ = 0;
   counter_ = 0;
+  num_empty_spans_ = 0;
+  max_empty_spans_ = 0;
 
   max_cache_size_ = kMaxNumTransferEntries;
 #ifdef TCMALLOC_SMALL_BUT_SLOW
@@ -74,9 +80,33 @@ void CentralFreeList::Init(size_t cl) {
     max_cache_size_ = (min)(max_cache_size_,
                           (max)(1, (1024 * 1024) / (bytes * objs_to_move)));
     cache_size_ = (min)(cache_size_, max_cache_size_);
+#ifndef TCMALLOC_SMALL_BUT_SLOW
+    // The same for the spans kept after they empty.
+    const size_t span_bytes = Static::sizemap()->class_to_pages(cl) << kPageShift;
+    max_empty_spans_ = (min)(static_cast<size_t>(kMaxEmptySpans),
+                             (1024 * 1024) / span_bytes);
+#endif
   }
   used_slots_ = 0;
   ASSERT(cache_size_ <= max_cache_size_);
+
+  // The shards hold up to this many more batches, so they are only used
+  // where the 1MB limit above would let the transfer cache itself have
+  // that many.
+#ifdef TCMALLOC_SMALL_BUT_SLOW
+  use_shards_ = false;
+#else
+  use_shards_ = (cl > 0 &&
+                 max_cache_size_ >= kNumTransferShards * kShardEntries);
+#endif
+  for (int i = 0; i < kNumTransferShards; ++i) {
+    shards_[i].used = 0;
+  }
+}
+
+CentralFreeList::TransferShard* CentralFreeList::CurrentShard() {
+  return &shards_[(ThreadCache::CurrentCpu() / kCpusPerShard) %
+                  kNumTransferShards];
 }
 
 void CentralFreeList::ReleaseListToSpans(void* start) {
@@ -87,6 +117,13 @@ void CentralFreeList::ReleaseListToSpans(void* start) {
   }
 }
 
+// Returns the end of the last whole object of the given size in span.
+static inline char* UntouchedLimit(const Span* span, size_t size) {
+  const size_t bytes = span->length << kPageShift;
+  return reinterpret_cast<char*>(span->start << kPageShift) +
+      (bytes / size) * size;
+}
+
 // MapObjectToSpan should logically be part of ReleaseToSpans.  But
 // this triggers an optimization bug in gcc 4.5.0.  Moving to a
 // separate function, and making sure that function isn't inlined,
@@ -107,9 +144,9 @@ void CentralFreeList::ReleaseToSpans(void* object) {
   ASSERT(span->refcount > 0);
 
   // If span is empty, move it to non-empty list
-  if (span->objects == NULL) {
+  if (span->objects == NULL && span->untouched == NULL) {
     tcmalloc::DLL_Remove(span);
-    tcmalloc::DLL_Prepend(&nonempty_, span);
+    tcmalloc::DLL_Prepend(&nonempty_[span->node], span);
     Event(span, 'N', 0);
   }
 
@@ -121,18 +158,29 @@ void CentralFreeList::ReleaseToSpans(void* object) {
       ASSERT(p != object);
       got++;
     }
-    ASSERT(got + span->refcount ==
-           (span->length<<kPageShift) /
-           Static::sizemap()->ByteSizeForClass(span->sizeclass));
+    const size_t size = Static::sizemap()->ByteSizeForClass(span->sizeclass);
+    if (span->untouched != NULL) {
+      got += (UntouchedLimit(span, size) - span->untouched) / size;
+    }
+    ASSERT(got + span->refcount == (span->length<<kPageShift) / size);
   }
 
   counter_++;
   span->refcount--;
   if (span->refcount == 0) {
+    tcmalloc::DLL_Remove(span);
+    if (max_empty_spans_ > 0) {
+      // Keep it for Populate(), with its objects still counted as free.
+      // (while trimming drops lock_, others may add theirs)
+      while (num_empty_spans_ == max_empty_spans_) {
+        TrimEmptySpans(max_empty_spans_ / 2);
+      }
+      empty_spans_[num_empty_spans_++] = span;
+      return;
+    }
     Event(span, '#', 0);
     counter_ -= ((span->length<<kPageShift) /
                  Static::sizemap()->ByteSizeForClass(span->sizeclass));
-    tcmalloc::DLL_Remove(span);
     --num_spans_;
 
     // Release central list lock while operating on pageheap
@@ -141,6 +189,7 @@ void CentralFreeList::ReleaseToSpans(void* object) {
       SpinLockHolder h(Static::pageheap_lock());
       Static::pageheap()->Delete(span);
     }
+    Static::pageheap()->ReleaseDeferred();
     lock_.Lock();
   } else {
     *(reinterpret_cast<void**>(object)) = span->objects;
@@ -228,7 +277,18 @@ bool CentralFreeList::ShrinkCache(int locked_size_class, bool force)
   return true;
 }
 
-void CentralFreeList::InsertRange(void *start, void *end, int N) {
+void CentralFreeList::InsertRange(void *start, void *end, int N, int zero) {
+  if (use_shards_ && N == Static::sizemap()->num_objects_to_move(size_class_)) {
+    TransferShard* shard = CurrentShard();
+    SpinLockHolder h(&shard->lock);
+    if (shard->used < kShardEntries) {
+      TCEntry *entry = &shard->entries[shard->used++];
+      entry->head = start;
+      entry->tail = end;
+      entry->zero = zero;
+      return;
+    }
+  }
   SpinLockHolder h(&lock_);
   if (N == Static::sizemap()->num_objects_to_move(size_class_) &&
     MakeCacheSpace()) {
@@ -238,13 +298,27 @@ void CentralFreeList::InsertRange(void *start, void *end, int N) {
     TCEntry *entry = &tc_slots_[slot];
     entry->head = start;
     entry->tail = end;
+    entry->zero = zero;
     return;
   }
   ReleaseListToSpans(start);
 }
 
-int CentralFreeList::RemoveRange(void **start, void **end, int N) {
+int CentralFreeList::RemoveRange(void **start, void **end, int N, int *zero,
+                                 FreshRange* fresh) {
   ASSERT(N > 0);
+  if (fresh != NULL) fresh->count = 0;
+  if (use_shards_ && N == Static::sizemap()->num_objects_to_move(size_class_)) {
+    TransferShard* shard = CurrentShard();
+    SpinLockHolder h(&shard->lock);
+    if (shard->used > 0) {
+      TCEntry *entry = &shard->entries[--shard->used];
+      *start = entry->head;
+      *end = entry->tail;
+      *zero = entry->zero;
+      return N;
+    }
+  }
   lock_.Lock();
   if (N == Static::sizemap()->num_objects_to_move(size_class_) &&
       used_slots_ > 0) {
@@ -253,6 +327,7 @@ int CentralFreeList::RemoveRange(void **start, void **end, int N) {
     TCEntry *entry = &tc_slots_[slot];
     *start = entry->head;
     *end = entry->tail;
+    *zero = entry->zero;
     lock_.Unlock();
     return N;
   }
@@ -261,15 +336,24 @@ int CentralFreeList::RemoveRange(void **start, void **end, int N) {
   *start = NULL;
   *end = NULL;
   // TODO: Prefetch multiple TCEntries?
-  result = FetchFromOneSpansSafe(N, start, end);
+  result = FetchFromOneSpansSafe(N, start, end, zero, fresh);
   if (result != 0) {
+    // Number of objects in the *start..*end range.
+    int linked = result - (fresh != NULL ? fresh->count : 0);
     while (result < N) {
-      int n;
+      int n, n_zero;
       void* head = NULL;
       void* tail = NULL;
-      n = FetchFromOneSpans(N - result, &head, &tail);
+      const int fresh_before = (fresh != NULL ? fresh->count : 0);
+      n = FetchFromOneSpans(N - result, &head, &tail, &n_zero, fresh);
       if (!n) break;
       result += n;
+      if (head == NULL) continue;
+      // Later ranges go in front, so their zero objects only extend the
+      // zero tail if everything behind them is zero too.
+      if (*zero == linked) *zero += n_zero;
+      linked += n - ((fresh != NULL ? fresh->count : 0) - fresh_before);
+      if (*end == NULL) *end = tail;
       SLL_PushRange(start, head, tail);
     }
   }
@@ -278,47 +362,144 @@ int CentralFreeList::RemoveRange(void **start, void **end, int N) {
 }
 
 
-int CentralFreeList::FetchFromOneSpansSafe(int N, void **start, void **end) {
-  int result = FetchFromOneSpans(N, start, end);
+int CentralFreeList::FetchFromOneSpansSafe(int N, void **start, void **end,
+                                           int *zero, FreshRange* fresh) {
+  int result = FetchFromOneSpans(N, start, end, zero, fresh);
   if (!result) {
     Populate();
-    result = FetchFromOneSpans(N, start, end);
+    result = FetchFromOneSpans(N, start, end, zero, fresh);
   }
   return result;
 }
 
-int CentralFreeList::FetchFromOneSpans(int N, void **start, void **end) {
-  if (tcmalloc::DLL_IsEmpty(&nonempty_)) return 0;
-  Span* span = nonempty_.next;
+int CentralFreeList::FetchFromOneSpans(int N, void **start, void **end,
+                                       int *zero, FreshRange* fresh) {
+  *zero = 0;
+  *start = NULL;
+  *end = NULL;
+  // Spans on the calling thread's node first
+  const int local = Static::pageheap()->CurrentNode();
+  Span* list = NULL;
+  for (int i = 0; i < kMaxNumaNodes; ++i) {
+    Span* l = &nonempty_[(local + i) % kMaxNumaNodes];
+    if (!tcmalloc::DLL_IsEmpty(l)) {
+      list = l;
+      break;
+    }
+  }
+  if (list == NULL) return 0;
+  Span* span = list->next;
 
-  ASSERT(span->objects != NULL);
+  ASSERT(span->objects != NULL || span->untouched != NULL);
 
+  // Objects which have been freed back to the span come first.
   int result = 0;
-  void *prev, *curr;
-  curr = span->objects;
-  do {
-    prev = curr;
-    curr = *(reinterpret_cast<void**>(curr));
-  } while (++result < N && curr != NULL);
-
-  if (curr == NULL) {
+  if (span->objects != NULL) {
+    void *prev, *curr;
+    curr = span->objects;
+    do {
+      prev = curr;
+      curr = *(reinterpret_cast<void**>(curr));
+    } while (++result < N && curr != NULL);
+    *start = span->objects;
+    *end = prev;
+    span->objects = curr;
+    SLL_SetNext(*end, NULL);
+  }
+
+  // Then objects which have never been handed out.  If they are still
+  // zero, these go to *fresh without being touched if we can; otherwise
+  // they are linked onto the end of the range.
+  if (result < N && span->untouched != NULL) {
+    const size_t size = Static::sizemap()->ByteSizeForClass(size_class_);
+    char* limit = UntouchedLimit(span, size);
+    int n = (limit - span->untouched) / size;
+    if (n > N - result) n = N - result;
+    if (span->zeroed && fresh != NULL && fresh->count == 0) {
+      fresh->start = span->untouched;
+      fresh->count = n;
+    } else {
+      char* p = span->untouched;
+      for (int i = 0; i < n - 1; ++i, p += size) SLL_SetNext(p, p + size);
+      SLL_SetNext(p, NULL);
+      if (*end != NULL) SLL_SetNext(*end, span->untouched);
+      else *start = span->untouched;
+      *end = p;
+      if (span->zeroed) *zero = n;
+    }
+    span->untouched += n * size;
+    if (span->untouched == limit) span->untouched = NULL;
+    result += n;
+  }
+
+  if (span->objects == NULL && span->untouched == NULL) {
     // Move to empty list
     tcmalloc::DLL_Remove(span);
     tcmalloc::DLL_Prepend(&empty_, span);
     Event(span, 'E', 0);
   }
 
-  *start = span->objects;
-  *end = prev;
-  span->objects = curr;
-  SLL_SetNext(*end, NULL);
   span->refcount += result;
   counter_ -= result;
   return result;
 }
 
 // Fetch memory from the system and add to the central cache freelist.
+void CentralFreeList::ReleaseEmptySpans() {
+  SpinLockHolder h(&lock_);
+  TrimEmptySpans(0);
+}
+
+void CentralFreeList::TrimEmptySpans(int n) {
+  if (num_empty_spans_ <= n) return;
+  const int count = num_empty_spans_ - n;
+  Span* spans[kMaxEmptySpans];
+  for (int i = 0; i < count; ++i) {
+    spans[i] = empty_spans_[i];
+    counter_ -= ((spans[i]->length<<kPageShift) /
+                 Static::sizemap()->ByteSizeForClass(spans[i]->sizeclass));
+  }
+  for (int i = count; i < num_empty_spans_; ++i) {
+    empty_spans_[i - count] = empty_spans_[i];
+  }
+  num_empty_spans_ = n;
+  num_spans_ -= count;
+
+  // Release central list lock while operating on pageheap
+  lock_.Unlock();
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    for (int i = 0; i < count; ++i) {
+      Event(spans[i], '#', 0);
+      Static::pageheap()->Delete(spans[i]);
+    }
+  }
+  Static::pageheap()->ReleaseDeferred();
+  lock_.Lock();
+}
+
 void CentralFreeList::Populate() {
+  const size_t size = Static::sizemap()->ByteSizeForClass(size_class_);
+  if (num_empty_spans_ > 0) {
+    // Reuse the span which emptied last (its pages are most likely to still
+    // be in the cache), zeroing all of its used objects in one go.
+    Span* span = empty_spans_[--num_empty_spans_];
+    lock_.Unlock();
+    const size_t bytes = span->length << kPageShift;
+    tcmalloc_zero_object(reinterpret_cast<void*>(span->start << kPageShift),
+                         bytes);
+    span->zeroed = true;
+    ThreadCache* heap = ThreadCache::GetCacheIfPresent();
+    if (heap) heap->RecordZeroed(ZeroStats::kRefill, size_class_, bytes,
+                                 bytes / size);
+    span->objects = NULL;
+    span->untouched = reinterpret_cast<char*>(span->start << kPageShift);
+    span->home = ThreadCache::CurrentHome();
+    lock_.Lock();
+    tcmalloc::DLL_Prepend(&nonempty_[span->node], span);
+    return;
+  }
+
   // Release central list lock while operating on pageheap
   lock_.Unlock();
   const size_t npages = Static::sizemap()->class_to_pages(size_class_);
@@ -336,6 +517,7 @@ void CentralFreeList::Populate() {
     return;
   }
   ASSERT(span->length == npages);
+  span->home = ThreadCache::CurrentHome();
   // Cache sizeclass info eagerly.  Locking is not necessary.
   // (Instead of being eager, we could just replace any stale info
   // about this span, but that seems to be no better in practice.)
@@ -343,33 +525,44 @@ void CentralFreeList::Populate() {
     Static::pageheap()->CacheSizeClass(span->start + i, size_class_);
   }
 
-  // Split the block into pieces and add to the free-list
+  if (!span->zeroed && ThreadCache::prezero_spans()) {
+    // One big memset, while we're not holding any lock
+    const size_t bytes = npages << kPageShift;
+    tcmalloc_zero_object(reinterpret_cast<void*>(span->start << kPageShift),
+                         bytes);
+    span->zeroed = true;
+    ThreadCache* heap = ThreadCache::GetCacheIfPresent();
+    if (heap) heap->RecordZeroed(ZeroStats::kRefill, size_class_, bytes,
+                                 bytes / size);
+  }
+
+  // Don't split the block into pieces here: FetchFromOneSpans() carves
+  // objects off span->untouched as they are needed, so pages aren't
+  // faulted in (or, if they are known to be zero, dirtied) before their
+  // objects are handed out.
   // TODO: coloring of objects to avoid cache conflicts?
-  void** tail = &span->objects;
   char* ptr = reinterpret_cast<char*>(span->start << kPageShift);
-  char* limit = ptr + (npages << kPageShift);
-  const size_t size = Static::sizemap()->ByteSizeForClass(size_class_);
-  int num = 0;
-  while (ptr + size <= limit) {
-    *tail = ptr;
-    tail = reinterpret_cast<void**>(ptr);
-    ptr += size;
-    num++;
-  }
-  ASSERT(ptr <= limit);
-  *tail = NULL;
+  const int num = (UntouchedLimit(span, size) - ptr) / size;
+  span->objects = NULL;
+  span->untouched = ptr;
   span->refcount = 0; // No sub-object in use yet
 
   // Add span to list of non-empty spans
   lock_.Lock();
-  tcmalloc::DLL_Prepend(&nonempty_, span);
+  tcmalloc::DLL_Prepend(&nonempty_[span->node], span);
   ++num_spans_;
   counter_ += num;
 }
 
 int CentralFreeList::tc_length() {
+  // (the shards are read without their locks; this is only for stats)
+  int entries = 0;
+  for (int i = 0; i < kNumTransferShards; ++i) {
+    entries += shards_[i].used;
+  }
   SpinLockHolder h(&lock_);
-  return used_slots_ * Static::sizemap()->num_objects_to_move(size_class_);
+  entries += used_slots_;
+  return entries * Static::sizemap()->num_objects_to_move(size_class_);
 }
 
 size_t CentralFreeList::OverheadBytes() {
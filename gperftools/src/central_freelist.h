@@ -46,6 +46,12 @@
 
 namespace tcmalloc {
 
+// A run of consecutive, never handed out objects of one size class.
+struct FreshRange {
+  char* start;
+  int count;
+};
+
 // Data kept per size-class in central cache.
 class CentralFreeList {
  public:
@@ -59,11 +65,18 @@ class CentralFreeList {
   // These methods all do internal locking.
 
   // Insert the specified range into the central freelist.  N is the number of
-  // elements in the range.  RemoveRange() is the opposite operation.
-  void InsertRange(void *start, void *end, int N);
+  // elements in the range, of which the last 'zero' are known to be zero
+  // apart from their freelist link.  RemoveRange() is the opposite operation.
+  void InsertRange(void *start, void *end, int N, int zero = 0);
 
   // Returns the actual number of fetched elements and sets *start and *end.
-  int RemoveRange(void **start, void **end, int N);
+  // *zero is set to the number of elements at the end of the range which
+  // are known to be zero, apart from their freelist link.  If fresh is
+  // non-NULL, some of the elements may instead be returned in it, as a run
+  // of consecutive objects which have not been linked (and so are entirely
+  // zero); these are not part of the *start..*end range.
+  int RemoveRange(void **start, void **end, int N, int *zero,
+                  FreshRange* fresh = NULL);
 
   // Returns the number of free objects in cache.
   int length() {
@@ -71,23 +84,30 @@ class CentralFreeList {
     return counter_;
   }
 
-  // Returns the number of free objects in the transfer cache.
+  // Returns the number of free objects in the transfer cache (including
+  // its shards).
   int tc_length();
 
+  // Returns the spans kept for reuse after they emptied (see
+  // empty_spans_) to the page heap.
+  void ReleaseEmptySpans() LOCKS_EXCLUDED(lock_);
+
   // Returns the memory overhead (internal fragmentation) attributable
   // to the freelist.  This is memory lost when the size of elements
   // in a freelist doesn't exactly divide the page-size (an 8192-byte
   // page full of 5-byte objects would have 2 bytes memory overhead).
   size_t OverheadBytes();
 
-  // Lock/Unlock the internal SpinLock. Used on the pthread_atfork call
-  // to set the lock in a consistent state before the fork.
+  // Lock/Unlock the internal SpinLocks. Used on the pthread_atfork call
+  // to set the locks in a consistent state before the fork.
   void Lock() {
+    for (int i = 0; i < kNumTransferShards; ++i) shards_[i].lock.Lock();
     lock_.Lock();
   }
 
   void Unlock() {
     lock_.Unlock();
+    for (int i = 0; i < kNumTransferShards; ++i) shards_[i].lock.Unlock();
   }
 
  private:
@@ -97,6 +117,7 @@ class CentralFreeList {
   struct TCEntry {
     void *head;  // Head of chain of objects.
     void *tail;  // Tail of chain of objects.
+    int zero;    // Number of objects at the tail known to be zero.
   };
 
   // A central cache freelist can have anywhere from 0 to kMaxNumTransferEntries
@@ -111,16 +132,46 @@ class CentralFreeList {
   static const int kMaxNumTransferEntries = 64;
 #endif
 
+  // In front of the transfer cache, each size class whose batches are
+  // small enough has a few more TCEntry slots per group of kCpusPerShard
+  // CPUs.  A thread hands batches to (and takes them from) its CPU's
+  // shard under that shard's own lock, which is held for just a few
+  // stores; only when the shard is full (or empty) does it go on to
+  // lock_.  So threads on different CPUs rarely contend for one lock.
+#ifdef TCMALLOC_SMALL_BUT_SLOW
+  static const int kNumTransferShards = 1;  // (not used)
+#else
+  static const int kNumTransferShards = 8;
+#endif
+  static const int kCpusPerShard = 8;
+  static const int kShardEntries = 2;
+
+  struct TransferShard {
+    // Like lock_, this may be used before its constructor runs.
+    TransferShard() : lock(base::LINKER_INITIALIZED) { }
+
+    SpinLock lock;
+    int32_t used;                       // Protected by lock
+    TCEntry entries[kShardEntries];     // Protected by lock
+  } CACHELINE_ALIGNED;
+
+  // The calling thread's shard.
+  TransferShard* CurrentShard();
+
   // REQUIRES: lock_ is held
   // Remove object from cache and return.
   // Return NULL if no free entries in cache.
-  int FetchFromOneSpans(int N, void **start, void **end) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // *zero and *fresh are set as for RemoveRange(), except that *fresh is
+  // only used if it doesn't already hold a range.
+  int FetchFromOneSpans(int N, void **start, void **end, int *zero,
+                        FreshRange* fresh) EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // REQUIRES: lock_ is held
   // Remove object from cache and return.  Fetches
   // from pageheap if cache is empty.  Only returns
   // NULL on allocation failure.
-  int FetchFromOneSpansSafe(int N, void **start, void **end) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  int FetchFromOneSpansSafe(int N, void **start, void **end, int *zero,
+                            FreshRange* fresh) EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // REQUIRES: lock_ is held
   // Release a linked list of objects to spans.
@@ -137,6 +188,12 @@ class CentralFreeList {
   // May temporarily release lock_.
   void Populate() EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // REQUIRES: lock_ is held
+  // Returns the oldest of empty_spans_ to the page heap until at most n
+  // are left.
+  // May temporarily release lock_.
+  void TrimEmptySpans(int n) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // REQUIRES: lock is held.
   // Tries to make room for a TCEntry.  If the cache is full it will try to
   // expand it at the cost of some other cache size.  Return false if there is
@@ -166,10 +223,26 @@ class CentralFreeList {
   // We keep linked lists of empty and non-empty spans.
   size_t   size_class_;     // My size class
   Span     empty_;          // Dummy header for list of empty spans
-  Span     nonempty_;       // Dummy header for list of non-empty spans
-  size_t   num_spans_;      // Number of spans in empty_ plus nonempty_
+  // Dummy headers for lists of non-empty spans, by NUMA node (see
+  // PageHeap::CurrentNode()), so that threads get objects on their own
+  // node where there are any.
+  Span     nonempty_[kMaxNumaNodes];
+  size_t   num_spans_;      // Number of spans in empty_, nonempty_ and
+                            // empty_spans_
   size_t   counter_;        // Number of free objects in cache entry
 
+  // Spans whose objects have all come back are kept here, oldest first, for
+  // Populate() to reuse, rather than going straight back to the page heap
+  // (which may decommit them, only for the next Populate() to fault them
+  // back in).  When a span empties with max_empty_spans_ of them here
+  // already, the oldest go back until half are left, so a class whose use
+  // goes back and forth across a span boundary doesn't return one on every
+  // other free.  Their objects still count as free in counter_.
+  static const int kMaxEmptySpans = 4;
+  Span*    empty_spans_[kMaxEmptySpans];
+  int32_t  num_empty_spans_;
+  int32_t  max_empty_spans_;  // At most 1MB of them, set in Init()
+
   // Here we reserve space for TCEntry cache slots.  Space is preallocated
   // for the largest possible number of entries than any one size class may
   // accumulate.  Not all size classes are allowed to accumulate
@@ -186,6 +259,10 @@ class CentralFreeList {
   int32_t cache_size_;
   // Maximum size of the cache for a given size class.
   int32_t max_cache_size_;
+
+  // Whether shards_ are used for this size class.  Set in Init().
+  bool use_shards_;
+  TransferShard shards_[kNumTransferShards];
 };
 
 // Pads each CentralCache object to multiple of 64 bytes.  Since some
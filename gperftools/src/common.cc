@@ -32,7 +32,23 @@
 // Author: Sanjay Ghemawat <opensource@google.com>
 
 #include <stdlib.h> // for getenv and strtol
+#include <string.h> // for memset
 #include "config.h"
+#ifdef __SSE2__
+#include <emmintrin.h> // for _mm_stream_si128
+#endif
+#if defined(__x86_64__) && (defined(__clang__) || __GNUC__ >= 5)
+#include <cpuid.h>     // for __get_cpuid_max, __cpuid_count
+#include <immintrin.h> // for _mm256_storeu_si256, _mm512_storeu_si512
+#define HAVE_X86_ZERO_KERNELS 1
+#endif
+#if defined(__aarch64__) && defined(__GNUC__)
+#define HAVE_ARM_ZERO_KERNELS 1
+#endif
+#if defined(HAVE_FCNTL_H) && defined(HAVE_UNISTD_H)
+#include <fcntl.h>  // for open
+#include <unistd.h> // for read, close
+#endif
 #include "common.h"
 #include "system-alloc.h"
 #include "base/spinlock.h"
@@ -118,21 +134,24 @@ int SizeMap::NumMoveSize(size_t size) {
   return num;
 }
 
-// Initialize the mapping arrays
-void SizeMap::Init() {
-  InitTCMallocTransferNumObjects();
-
-  // Do some sanity checking on add_amount[]/shift_amount[]/class_array[]
-  if (ClassIndex(0) != 0) {
-    Log(kCrash, __FILE__, __LINE__,
-        "Invalid class index for size 0", ClassIndex(0));
-  }
-  if (ClassIndex(kMaxSize) >= sizeof(class_array_)) {
-    Log(kCrash, __FILE__, __LINE__,
-        "Invalid class index for kMaxSize", ClassIndex(kMaxSize));
-  }
+size_t SizeMap::ClassPages(size_t size) {
+  int blocks_to_move = NumMoveSize(size) / 4;
+  size_t psize = 0;
+  do {
+    psize += kPageSize;
+    // Allocate enough pages so leftover is less than 1/8 of total.
+    // This bounds wasted space to at most 12.5%.
+    while ((psize % size) > (psize >> 3)) {
+      psize += kPageSize;
+    }
+    // Continue to add pages until there are at least as many objects in
+    // the span as are needed when moving objects from the central
+    // freelists and spans to the thread caches.
+  } while ((psize / size) < (blocks_to_move));
+  return psize >> kPageShift;
+}
 
-  // Compute the size classes we want to use
+int SizeMap::DefaultClasses() {
   int sc = 1;   // Next size class to assign
   int alignment = kAlignment;
   CHECK_CONDITION(kAlignment <= kMinAlign);
@@ -140,20 +159,7 @@ void SizeMap::Init() {
     alignment = AlignmentForSize(size);
     CHECK_CONDITION((size % alignment) == 0);
 
-    int blocks_to_move = NumMoveSize(size) / 4;
-    size_t psize = 0;
-    do {
-      psize += kPageSize;
-      // Allocate enough pages so leftover is less than 1/8 of total.
-      // This bounds wasted space to at most 12.5%.
-      while ((psize % size) > (psize >> 3)) {
-        psize += kPageSize;
-      }
-      // Continue to add pages until there are at least as many objects in
-      // the span as are needed when moving objects from the central
-      // freelists and spans to the thread caches.
-    } while ((psize / size) < (blocks_to_move));
-    const size_t my_pages = psize >> kPageShift;
+    const size_t my_pages = ClassPages(size);
 
     if (sc > 1 && my_pages == class_to_pages_[sc-1]) {
       // See if we can merge this into the previous class without
@@ -173,21 +179,678 @@ void SizeMap::Init() {
     class_to_size_[sc] = size;
     sc++;
   }
+  return sc;
+}
+
+// The classes DefaultClasses() makes in the default configuration (8K
+// pages, 16-byte alignment, TCMALLOC_TRANSFER_NUM_OBJ unset), worked out
+// ahead of time, so that processes don't have to at startup.
+#if !defined(TCMALLOC_32K_PAGES) && !defined(TCMALLOC_64K_PAGES) && \
+    !defined(TCMALLOC_ALIGN_8BYTES)
+#define HAVE_DEFAULT_CLASS_TABLES 1
+
+static const size_t kDefaultClassToSize[kNumClasses] = {
+  0, 8, 16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224,
+  240, 256, 288, 320, 352, 384, 416, 448, 480, 512, 576, 640, 704, 768,
+  832, 896, 960, 1024, 1152, 1280, 1408, 1536, 1792, 2048, 2304, 2560,
+  2816, 3072, 3328, 4096, 4608, 5120, 6144, 6656, 8192, 9216, 10240, 12288,
+  13312, 16384, 20480, 24576, 26624, 32768, 40960, 49152, 57344, 65536,
+  73728, 81920, 90112, 98304, 106496, 114688, 122880, 131072, 139264,
+  147456, 155648, 163840, 172032, 180224, 188416, 196608, 204800, 212992,
+  221184, 229376, 237568, 245760, 253952, 262144, 270336, 278528, 286720,
+  294912, 303104, 311296, 319488, 327680, 335872, 344064, 352256, 360448,
+  368640, 376832, 385024, 393216, 401408, 409600, 417792, 425984, 434176,
+  442368, 450560, 458752, 466944, 475136, 483328, 491520, 499712, 507904,
+  516096, 524288,
+};
+
+static const size_t kDefaultClassToPages[kNumClasses] = {
+  0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 3, 2, 3, 2,
+  3, 5, 2, 5, 4, 3, 5, 2, 5, 3, 7, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+  15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32,
+  33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50,
+  51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64,
+};
+
+static const int kDefaultNumObjectsToMove[kNumClasses] = {
+  0, 8192, 4096, 2048, 1365, 1024, 819, 682, 585, 512, 455, 409, 372, 341,
+  315, 292, 273, 256, 227, 204, 186, 170, 157, 146, 136, 128, 113, 102, 93,
+  85, 78, 73, 68, 64, 56, 51, 46, 42, 36, 32, 28, 25, 23, 21, 19, 16, 14,
+  12, 10, 9, 8, 7, 6, 5, 4, 4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  2,
+};
+#endif
+
+bool SizeMap::TableClasses() {
+#ifdef HAVE_DEFAULT_CLASS_TABLES
+  if (FLAGS_tcmalloc_transfer_num_objects != kDefaultTransferNumObjecs) {
+    return false;
+  }
+#ifndef NDEBUG
+  // Debug builds make sure the tables are still what DefaultClasses()
+  // would make.
+  CHECK_CONDITION(DefaultClasses() == kNumClasses);
+  for (int cl = 1; cl < kNumClasses; cl++) {
+    CHECK_CONDITION(class_to_size_[cl] == kDefaultClassToSize[cl]);
+    CHECK_CONDITION(class_to_pages_[cl] == kDefaultClassToPages[cl]);
+    CHECK_CONDITION(NumMoveSize(class_to_size_[cl]) ==
+                    kDefaultNumObjectsToMove[cl]);
+  }
+#endif
+  memcpy(class_to_size_, kDefaultClassToSize, sizeof(class_to_size_));
+  memcpy(class_to_pages_, kDefaultClassToPages, sizeof(class_to_pages_));
+  memcpy(num_objects_to_move_, kDefaultNumObjectsToMove,
+         sizeof(num_objects_to_move_));
+  return true;
+#else
+  return false;
+#endif
+}
+
+// A size class profile is a text file of "<size> <count>" lines (counting
+// the allocations made of that many bytes), where '#' starts a comment.
+// It is read during Init(), when nothing may call malloc, so all the
+// working storage is static.
+static const int kMaxProfileSizes = 512;
+static const int kMaxCandidates = kNumClasses + kMaxProfileSizes;
+static const size_t kMaxProfileFile = 64 << 10;
+static char profile_text[kMaxProfileFile];
+static size_t profile_size[kMaxCandidates];
+static double profile_count[kMaxCandidates];
+static double profile_cum_count[kMaxCandidates + 1];
+static double profile_cum_bytes[kMaxCandidates + 1];
+static double profile_cost[2][kMaxCandidates];
+static unsigned short profile_choice[kNumClasses][kMaxCandidates];
+
+// Profiled sizes count for this much more than the sizes of the default
+// table, which are only there to settle ties between sizes nobody uses.
+static const double kProfileWeight = 1 << 20;
+
+// Smallest size >= "size" that can be a class of its own
+static size_t RoundUpToClassSize(size_t size) {
+  for (;;) {
+    const size_t alignment = AlignmentForSize(size);
+    const size_t rounded = (size + alignment - 1) & ~(alignment - 1);
+    if (rounded == size) return size;
+    size = rounded;
+  }
+}
+
+static char* SkipBlanks(char* p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+  return p;
+}
+
+// Reads the "<size> <count>" pairs in "path" into profile_size[] and
+// profile_count[].  Returns the number of pairs, or -1 on error.
+static int ReadClassProfile(const char* path) {
+#if defined(HAVE_FCNTL_H) && defined(HAVE_UNISTD_H)
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return -1;
+  size_t len = 0;
+  ssize_t r;
+  while (len < kMaxProfileFile - 1 &&
+         (r = read(fd, profile_text + len, kMaxProfileFile - 1 - len)) > 0) {
+    len += r;
+  }
+  close(fd);
+  profile_text[len] = '\0';
+
+  int n = 0;
+  char* p = profile_text;
+  while (*p != '\0') {
+    p = SkipBlanks(p);
+    if (*p != '#' && *p != '\n' && *p != '\0') {
+      char* end;
+      const unsigned long size = strtoul(p, &end, 10);
+      if (end == p) return -1;
+      p = end;
+      const double count = strtod(p, &end);
+      if (end == p) return -1;
+      p = SkipBlanks(end);
+      if (*p != '#' && *p != '\n' && *p != '\0') return -1;
+      if (size > 0 && size <= kMaxSize && count > 0) {
+        if (n == kMaxProfileSizes) return -1;
+        profile_size[n] = size;
+        profile_count[n] = count * kProfileWeight;
+        n++;
+      }
+    }
+    while (*p != '\0' && *p != '\n') p++;  // (the rest is a comment)
+    if (*p == '\n') p++;
+  }
+  return n;
+#else
+  return -1;
+#endif
+}
+
+bool SizeMap::ProfileClasses(const char* path) {
+  int n = ReadClassProfile(path);
+  if (n < 0) {
+    Log(kLog, __FILE__, __LINE__,
+        "tcmalloc: can't use size class profile, using default classes");
+    return false;
+  }
+
+  // The candidates are the profiled sizes (rounded up to valid class
+  // sizes) and the default classes, which also guarantee kMaxSize.
+  for (int i = 0; i < n; i++) {
+    profile_size[i] = RoundUpToClassSize(profile_size[i]);
+  }
+  const int ndefault = DefaultClasses();
+  for (int cl = 1; cl < ndefault; cl++) {
+    profile_size[n] = class_to_size_[cl];
+    profile_count[n] = 1;
+    n++;
+  }
+
+  // Sort by size (there aren't many) and merge duplicates
+  for (int i = 1; i < n; i++) {
+    const size_t size = profile_size[i];
+    const double count = profile_count[i];
+    int j = i;
+    for (; j > 0 && profile_size[j-1] > size; j--) {
+      profile_size[j] = profile_size[j-1];
+      profile_count[j] = profile_count[j-1];
+    }
+    profile_size[j] = size;
+    profile_count[j] = count;
+  }
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    if (m > 0 && profile_size[m-1] == profile_size[i]) {
+      profile_count[m-1] += profile_count[i];
+    } else {
+      profile_size[m] = profile_size[i];
+      profile_count[m] = profile_count[i];
+      m++;
+    }
+  }
+  n = m;
+  const int k = kNumClasses - 1;
+  ASSERT(n >= k && profile_size[n-1] == kMaxSize);
+
+  // Each allocation is zeroed (and takes up memory) at the size of the
+  // class it lands in, so what a class costs is its slack over the sizes
+  // it serves, times how often they're allocated.  For the sizes in
+  // (size[i], size[j]], served by class size[j], that's size[j] * count
+  // - bytes, from these prefix sums.
+  profile_cum_count[0] = profile_cum_bytes[0] = 0;
+  for (int i = 0; i < n; i++) {
+    profile_cum_count[i+1] = profile_cum_count[i] + profile_count[i];
+    profile_cum_bytes[i+1] = profile_cum_bytes[i] +
+                             profile_count[i] * profile_size[i];
+  }
+
+  // Row c of the cost table is the cheapest way to serve all sizes up to
+  // size[j] with c + 1 classes, the largest being size[j].  Only two rows
+  // are kept, but the choices (the class below j) are kept for all.
+  double* prev = profile_cost[0];
+  double* cur = profile_cost[1];
+  for (int j = 0; j < n; j++) {
+    prev[j] = profile_size[j] * profile_cum_count[j+1] - profile_cum_bytes[j+1];
+  }
+  for (int c = 1; c < k; c++) {
+    for (int j = c; j < n; j++) {
+      double best = 0;
+      int best_i = -1;
+      for (int i = c - 1; i < j; i++) {
+        const double cost = prev[i] +
+            profile_size[j] * (profile_cum_count[j+1] - profile_cum_count[i+1]) -
+            (profile_cum_bytes[j+1] - profile_cum_bytes[i+1]);
+        if (best_i < 0 || cost < best) {
+          best = cost;
+          best_i = i;
+        }
+      }
+      cur[j] = best;
+      profile_choice[c][j] = best_i;
+    }
+    double* t = prev;
+    prev = cur;
+    cur = t;
+  }
+
+  // Walk the choices back from kMaxSize
+  int j = n - 1;
+  for (int c = k - 1; c >= 0; c--) {
+    class_to_size_[c+1] = profile_size[j];
+    class_to_pages_[c+1] = ClassPages(profile_size[j]);
+    if (c > 0) j = profile_choice[c][j];
+  }
+  return true;
+}
+
+// Objects of at least this many bytes (if non-zero) are only written where
+// they aren't zero already.
+static size_t check_zero_threshold;
+
+void ZeroNonTemporal(void* ptr, size_t size) {
+  // Streaming stores would dirty lines the check-first mode leaves alone.
+  if (check_zero_threshold != 0 && size >= check_zero_threshold) {
+    tcmalloc_zero_object(ptr, size);
+    return;
+  }
+#ifdef __SSE2__
+  char* p = reinterpret_cast<char*>(ptr);
+  char* const end = p + size;
+  size_t head = (-reinterpret_cast<uintptr_t>(p)) & 15;
+  if (head > size) head = size;
+  memset(p, 0, head);
+  p += head;
+  const __m128i zero = _mm_setzero_si128();
+  for (; p + 64 <= end; p += 64) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(p), zero);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(p + 16), zero);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(p + 32), zero);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(p + 48), zero);
+  }
+  for (; p + 16 <= end; p += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(p), zero);
+  }
+  // Order the streaming stores before anything the caller does with ptr.
+  _mm_sfence();
+  memset(p, 0, end - p);
+#else
+  memset(ptr, 0, size);
+#endif
+}
+
+// The zeroing kernels.  Each zeroes size bytes at ptr, for any size and
+// alignment; the ones built on wide stores or whole-line instructions
+// leave the odd ends to memset.
+typedef void (*ZeroKernelFunction)(void* ptr, size_t size);
+
+static void ZeroWithMemset(void* ptr, size_t size) {
+  memset(ptr, 0, size);
+}
+
+#ifdef HAVE_X86_ZERO_KERNELS
+static void ZeroWithRepStosb(void* ptr, size_t size) {
+  __asm__ __volatile__("rep stosb"
+                       : "+D"(ptr), "+c"(size)
+                       : "a"(0)
+                       : "memory");
+}
+
+__attribute__((target("avx2")))
+static void ZeroWithAVX2(void* ptr, size_t size) {
+  if (size < 32) {
+    memset(ptr, 0, size);
+    return;
+  }
+  char* p = reinterpret_cast<char*>(ptr);
+  char* const end = p + size;
+  const __m256i zero = _mm256_setzero_si256();
+  for (; p + 128 <= end; p += 128) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), zero);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 32), zero);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 64), zero);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 96), zero);
+  }
+  for (; p + 32 <= end; p += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), zero);
+  }
+  // (the last store overlaps the one before it)
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32), zero);
+}
+
+__attribute__((target("avx512f")))
+static void ZeroWithAVX512(void* ptr, size_t size) {
+  if (size < 64) {
+    memset(ptr, 0, size);
+    return;
+  }
+  char* p = reinterpret_cast<char*>(ptr);
+  char* const end = p + size;
+  const __m512i zero = _mm512_setzero_si512();
+  for (; p + 256 <= end; p += 256) {
+    _mm512_storeu_si512(p, zero);
+    _mm512_storeu_si512(p + 64, zero);
+    _mm512_storeu_si512(p + 128, zero);
+    _mm512_storeu_si512(p + 192, zero);
+  }
+  for (; p + 64 <= end; p += 64) {
+    _mm512_storeu_si512(p, zero);
+  }
+  _mm512_storeu_si512(end - 64, zero);
+}
+#endif
+
+// clzero (AMD) and dc zva (AArch64) zero a whole line or block at a time
+// without reading it first; they only pay off for big objects, and the
+// rest is left to the kernel we'd otherwise use.
+static const size_t kLineZeroMinSize = 32 << 10;
+static ZeroKernelFunction zero_fallback_function = ZeroWithMemset;
+
+#ifdef HAVE_X86_ZERO_KERNELS
+static void ZeroWithClzero(void* ptr, size_t size) {
+  if (size < kLineZeroMinSize) {
+    zero_fallback_function(ptr, size);
+    return;
+  }
+  char* const p = reinterpret_cast<char*>(ptr);
+  char* const end = p + size;
+  char* line = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(p) + 63) & ~static_cast<uintptr_t>(63));
+  char* const last = reinterpret_cast<char*>(
+      reinterpret_cast<uintptr_t>(end) & ~static_cast<uintptr_t>(63));
+  zero_fallback_function(p, line - p);
+  for (; line < last; line += 64) {
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xfc"  // clzero (%rax)
+                         : : "a"(line) : "memory");
+  }
+  // clzero is weakly ordered, like a streaming store.
+  _mm_sfence();
+  zero_fallback_function(last, end - last);
+}
+#endif
+
+#ifdef HAVE_ARM_ZERO_KERNELS
+// dc zva's block size, or 0 if it's prohibited.
+static size_t zva_block_size;
+
+static void ZeroWithDcZva(void* ptr, size_t size) {
+  const size_t block = zva_block_size;
+  if (size < kLineZeroMinSize) {
+    memset(ptr, 0, size);
+    return;
+  }
+  char* const p = reinterpret_cast<char*>(ptr);
+  char* const end = p + size;
+  char* line = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(p) + block - 1) & ~(block - 1));
+  char* const last = reinterpret_cast<char*>(
+      reinterpret_cast<uintptr_t>(end) & ~(block - 1));
+  memset(p, 0, line - p);
+  for (; line < last; line += block) {
+    __asm__ __volatile__("dc zva, %0" : : "r"(line) : "memory");
+  }
+  memset(last, 0, end - last);
+}
+#endif
+
+static ZeroKernelFunction zero_function = ZeroWithMemset;
+static ZeroKernel zero_kernel_in_use = kZeroMemset;
+// Bit k is set if this CPU can run kernel k.
+static unsigned supported_zero_kernels = 1 << kZeroMemset;
+
+static const ZeroKernelFunction kZeroKernelFunctions[kNumZeroKernels] = {
+  ZeroWithMemset,
+#ifdef HAVE_X86_ZERO_KERNELS
+  ZeroWithRepStosb, ZeroWithAVX2, ZeroWithAVX512, ZeroWithClzero,
+#else
+  NULL, NULL, NULL, NULL,
+#endif
+#ifdef HAVE_ARM_ZERO_KERNELS
+  ZeroWithDcZva,
+#else
+  NULL,
+#endif
+};
+
+#ifdef HAVE_X86_ZERO_KERNELS
+// Which of the register states in mask the OS saves on context switches.
+static bool OSSavesState(unsigned mask) {
+  unsigned eax, ebx, ecx, edx;
+  __cpuid(1, eax, ebx, ecx, edx);
+  if ((ecx & (1 << 27)) == 0)  // OSXSAVE
+    return false;
+  unsigned lo, hi;
+  __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return (lo & mask) == mask;
+}
+#endif
+
+void InitZeroKernel() {
+  bool fast_short_rep = false;
+#ifdef HAVE_X86_ZERO_KERNELS
+  unsigned eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0, NULL) >= 7) {
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if (ebx & (1 << 9))  // ERMSB
+      supported_zero_kernels |= 1 << kZeroRepStosb;
+    if (edx & (1 << 4)) {  // FSRM
+      supported_zero_kernels |= 1 << kZeroRepStosb;
+      fast_short_rep = true;
+    }
+    if ((ebx & (1 << 5)) && OSSavesState(0x6))  // AVX2; XMM and YMM
+      supported_zero_kernels |= 1 << kZeroAVX2;
+    if ((ebx & (1 << 16)) && OSSavesState(0xe6))  // AVX512F; and ZMM
+      supported_zero_kernels |= 1 << kZeroAVX512;
+  }
+  if (__get_cpuid_max(0x80000000, NULL) >= 0x80000008) {
+    __cpuid(0x80000008, eax, ebx, ecx, edx);
+    if (ebx & 1)  // CLZERO
+      supported_zero_kernels |= 1 << kZeroClzero;
+  }
+#endif
+#ifdef HAVE_ARM_ZERO_KERNELS
+  uint64_t dczid;
+  __asm__("mrs %0, dczid_el0" : "=r"(dczid));
+  if ((dczid & 16) == 0) {  // DZP: dc zva is prohibited
+    zva_block_size = 4 << (dczid & 15);
+    supported_zero_kernels |= 1 << kZeroDcZva;
+  }
+#endif
+
+  // rep stosb is the best choice only if short ones are fast too; AVX-512
+  // stores can lower the clock, so they're only used if asked for.
+  ZeroKernel fallback = kZeroMemset;
+  if (fast_short_rep) {
+    fallback = kZeroRepStosb;
+  } else if (supported_zero_kernels & (1 << kZeroAVX2)) {
+    fallback = kZeroAVX2;
+  } else if (supported_zero_kernels & (1 << kZeroRepStosb)) {
+    fallback = kZeroRepStosb;
+  }
+  zero_fallback_function = kZeroKernelFunctions[fallback];
+  ZeroKernel kernel = fallback;
+  if (supported_zero_kernels & (1 << kZeroClzero)) {
+    kernel = kZeroClzero;
+  } else if (supported_zero_kernels & (1 << kZeroDcZva)) {
+    kernel = kZeroDcZva;
+  }
+
+  const char* check = TCMallocGetenvSafe("TCMALLOC_CHECK_ZERO_THRESHOLD");
+  check_zero_threshold = check ? strtoul(check, NULL, 10) : 0;
+
+  const char* pinned = TCMallocGetenvSafe("TCMALLOC_ZERO_KERNEL");
+  if (pinned == NULL || !SetZeroKernel(strtol(pinned, NULL, 10))) {
+    SetZeroKernel(kernel);
+  }
+}
+
+ZeroKernel zero_kernel() {
+  return zero_kernel_in_use;
+}
+
+bool SetZeroKernel(int kernel) {
+  if (kernel < 0 || kernel >= kNumZeroKernels ||
+      (supported_zero_kernels & (1 << kernel)) == 0) {
+    return false;
+  }
+  // (racing allocations zero with either kernel, which is fine)
+  zero_kernel_in_use = static_cast<ZeroKernel>(kernel);
+  zero_function = kZeroKernelFunctions[kernel];
+  return true;
+}
+
+size_t check_zero_threshold_bytes() {
+  return check_zero_threshold;
+}
+
+void set_check_zero_threshold_bytes(size_t threshold) {
+  check_zero_threshold = threshold;
+}
+
+// Whether the 64 bytes at p, which are 64-byte aligned, are all zero.
+static inline bool LineIsZero(const char* p) {
+#ifdef __SSE2__
+  const __m128i* v = reinterpret_cast<const __m128i*>(p);
+  const __m128i bits = _mm_or_si128(
+      _mm_or_si128(_mm_load_si128(v), _mm_load_si128(v + 1)),
+      _mm_or_si128(_mm_load_si128(v + 2), _mm_load_si128(v + 3)));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) ==
+         0xffff;
+#else
+  const uint64_t* w = reinterpret_cast<const uint64_t*>(p);
+  return (w[0] | w[1] | w[2] | w[3] | w[4] | w[5] | w[6] | w[7]) == 0;
+#endif
+}
+
+static bool BytesAreZero(const char* p, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (p[i] != 0) return false;
+  }
+  return true;
+}
+
+// Zeroes size bytes at ptr, writing only the cache lines that aren't zero
+// already.  Reading a page that's shared copy-on-write (with a forked
+// parent, or merged by KSM), or that was never touched, leaves it shared;
+// writing it, even with zeroes, gets it a private copy.  Each run of
+// non-zero lines goes to the zeroing kernel in one call.
+static void ZeroDirtyLines(void* ptr, size_t size) {
+  char* const p = reinterpret_cast<char*>(ptr);
+  char* const end = p + size;
+  char* line = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(p) + 63) & ~static_cast<uintptr_t>(63));
+  char* const last = reinterpret_cast<char*>(
+      reinterpret_cast<uintptr_t>(end) & ~static_cast<uintptr_t>(63));
+  if (line >= last) {
+    zero_function(p, size);
+    return;
+  }
+  if (!BytesAreZero(p, line - p)) zero_function(p, line - p);
+  char* dirty = NULL;  // start of the current run of non-zero lines
+  for (; line < last; line += 64) {
+    if (LineIsZero(line)) {
+      if (dirty != NULL) {
+        zero_function(dirty, line - dirty);
+        dirty = NULL;
+      }
+    } else if (dirty == NULL) {
+      dirty = line;
+    }
+  }
+  if (dirty != NULL) zero_function(dirty, last - dirty);
+  if (!BytesAreZero(last, end - last)) zero_function(last, end - last);
+}
+
+// Stops the call before it becoming a tail call, which would drop the
+// caller's frame.
+#ifdef __GNUC__
+#define NO_TAIL_CALL() __asm__ __volatile__("" : : : "memory")
+#else
+#define NO_TAIL_CALL()
+#endif
+
+// memset() sets up no frame, so unwinding by frame pointers from inside it
+// skips its caller.  That caller is this, rather than tcmalloc_zero_object.
+static ATTRIBUTE_NOINLINE void ZeroBytes(void* ptr, size_t size) {
+  const size_t threshold = check_zero_threshold;
+  if (threshold != 0 && size >= threshold) {
+    ZeroDirtyLines(ptr, size);
+  } else {
+    zero_function(ptr, size);
+  }
+  NO_TAIL_CALL();
+}
+
+extern "C" ATTRIBUTE_NOINLINE void tcmalloc_zero_object(void* ptr,
+                                                       size_t size) {
+  ZeroBytes(ptr, size);
+  NO_TAIL_CALL();
+}
+
+#undef NO_TAIL_CALL
+
+// With a constant size, the compiler expands memset() into a fixed
+// sequence of (vector) stores.
+template <size_t N>
+static void ZeroFixed(void* ptr) {
+  memset(ptr, 0, N);
+}
+
+// Fills table[i] with ZeroFixed<i * 8>, for 0 < i <= N / 8.
+template <size_t N>
+struct FixedZeroers {
+  static void Fill(SizeMap::ZeroFunction* table) {
+    table[N / 8] = &ZeroFixed<N>;
+    FixedZeroers<N - 8>::Fill(table);
+  }
+};
+
+template <>
+struct FixedZeroers<0> {
+  static void Fill(SizeMap::ZeroFunction* table) { }
+};
+
+// Initialize the mapping arrays
+void SizeMap::Init() {
+  InitTCMallocTransferNumObjects();
+
+  // Do some sanity checking on the class array indexing
+  if (SmallClassIndex(kMaxSmallSize) >= sizeof(small_class_)) {
+    Log(kCrash, __FILE__, __LINE__,
+        "Invalid class index for kMaxSmallSize",
+        SmallClassIndex(kMaxSmallSize));
+  }
+  if (LargeClassIndex(kMaxSmallSize + 1) != 0) {
+    Log(kCrash, __FILE__, __LINE__,
+        "Invalid class index for kMaxSmallSize + 1",
+        LargeClassIndex(kMaxSmallSize + 1));
+  }
+  if (LargeClassIndex(kMaxSize) >= sizeof(large_class_)) {
+    Log(kCrash, __FILE__, __LINE__,
+        "Invalid class index for kMaxSize", LargeClassIndex(kMaxSize));
+  }
+
+  // Compute the size classes we want to use
+  const char* profile = TCMallocGetenvSafe("TCMALLOC_SIZE_CLASS_PROFILE");
+  bool from_tables = false;
+  int sc;
+  if (profile != NULL && ProfileClasses(profile)) {
+    sc = kNumClasses;
+  } else if (TableClasses()) {
+    sc = kNumClasses;
+    from_tables = true;
+  } else {
+    sc = DefaultClasses();
+  }
   if (sc != kNumClasses) {
     Log(kCrash, __FILE__, __LINE__,
         "wrong number of size classes: (found vs. expected )", sc, kNumClasses);
   }
 
-  // Initialize the mapping arrays
+  // Initialize the mapping arrays.  A large_class_ entry is the class of
+  // the smallest size in its bucket (or of kMaxSize, for the buckets above
+  // it).
   int next_size = 0;
   for (int c = 1; c < kNumClasses; c++) {
     const int max_size_in_class = class_to_size_[c];
-    for (int s = next_size; s <= max_size_in_class; s += kAlignment) {
-      class_array_[ClassIndex(s)] = c;
+    for (int s = next_size;
+         s <= max_size_in_class && s <= kMaxSmallSize; s += kAlignment) {
+      small_class_[SmallClassIndex(s)] = c;
     }
     next_size = max_size_in_class + kAlignment;
   }
+  int c = 1;
+  for (size_t i = 0; i < kLargeClassArraySize; i++) {
+    const int lg = kLgMaxSmallSize + (i >> kLargeBucketBits);
+    const size_t bucket = i & ((1 << kLargeBucketBits) - 1);
+    const size_t smallest = (static_cast<size_t>(1) << lg) +
+        (bucket << (lg - kLargeBucketBits)) + 1;
+    while (c < kNumClasses - 1 && class_to_size_[c] < smallest) c++;
+    large_class_[i] = c;
+  }
 
+#ifndef NDEBUG
   // Double-check sizes just to be safe
   for (size_t size = 0; size <= kMaxSize;) {
     const int sc = SizeClass(size);
@@ -210,10 +873,45 @@ void SizeMap::Init() {
       size += 128;
     }
   }
+#endif
 
   // Initialize the num_objects_to_move array.
-  for (size_t cl = 1; cl  < kNumClasses; ++cl) {
-    num_objects_to_move_[cl] = NumMoveSize(ByteSizeForClass(cl));
+  if (!from_tables) {
+    for (size_t cl = 1; cl  < kNumClasses; ++cl) {
+      num_objects_to_move_[cl] = NumMoveSize(ByteSizeForClass(cl));
+    }
+  }
+
+  // Initialize the aligned_class array.  Spans are page-aligned, so
+  // objects of a class are aligned to the largest power of two that
+  // divides the class size.
+  for (int shift = 0; shift < kPageShift; ++shift) {
+    const size_t align = static_cast<size_t>(1) << shift;
+    int next = 0;
+    for (int cl = kNumClasses - 1; cl > 0; --cl) {
+      if ((class_to_size_[cl] & (align - 1)) == 0) next = cl;
+      aligned_class_[shift][cl] = next;
+    }
+    aligned_class_[shift][0] = 0;
+  }
+
+  const char* threshold = TCMallocGetenvSafe("TCMALLOC_NONTEMPORAL_ZERO_THRESHOLD");
+  nontemporal_zero_threshold_ = threshold ? strtoul(threshold, NULL, 10) : 0;
+  // (by default, the largest classes get the treatment they had before
+  //  kMaxSize went up to 512k)
+  threshold = TCMallocGetenvSafe("TCMALLOC_PAGE_ZERO_THRESHOLD");
+  page_zero_threshold_ = threshold ? strtoul(threshold, NULL, 10)
+                                   : 256 * 1024;
+
+  // Initialize the class_to_zero array.  The class sizes are only known
+  // here, so we pick from a kernel for every multiple of 8 bytes.
+  ZeroFunction kernels[kMaxFixedZeroSize / 8 + 1];
+  kernels[0] = NULL;
+  FixedZeroers<kMaxFixedZeroSize>::Fill(kernels);
+  for (size_t cl = 0; cl < kNumClasses; ++cl) {
+    const size_t size = class_to_size_[cl];
+    class_to_zero_[cl] = (size <= kMaxFixedZeroSize && size % 8 == 0)
+        ? kernels[size / 8] : NULL;
   }
 }
 
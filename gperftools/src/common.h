@@ -41,6 +41,7 @@
 #ifdef HAVE_STDINT_H
 #include <stdint.h>                     // for uintptr_t, uint64_t
 #endif
+#include <string.h>                     // for memset
 #include "internal_logging.h"  // for ASSERT, etc
 #include "base/basictypes.h"   // for LIKELY, etc
 
@@ -103,6 +104,10 @@ static const size_t kLargeSizeClass = 0;
 // For all span-lengths < kMaxPages we keep an exact-size list.
 static const size_t kMaxPages = 1 << (20 - kPageShift);
 
+// With TCMALLOC_NUMA, free spans are kept apart for this many NUMA nodes
+// (more nodes than that share lists).  Must fit in Span::node.
+static const int kMaxNumaNodes = 4;
+
 // Default bound on the total amount of thread caches.
 #ifdef TCMALLOC_SMALL_BUT_SLOW
 // Make the overall thread cache no bigger than that of a single thread
@@ -120,6 +125,14 @@ static const size_t kMinThreadCacheSize = kMaxSize * 2;
 // next call to Scavenge for this thread.
 static const size_t kStealAmount = 1 << 16;
 
+// A ThreadCache that has had to fetch from the central cache often since
+// its limit last grew takes more than that: kStealAmount for every
+// kFetchesPerSteal fetches, up to kMaxStealAmount.  It takes that much
+// only from threads that have been idle since the steal round-robin last
+// passed them, though, and just kStealAmount from the others.
+static const int kFetchesPerSteal = 16;
+static const size_t kMaxStealAmount = 16 * kStealAmount;
+
 // The number of times that a deallocation can cause a freelist to
 // go over its max_length() before shrinking max_length().
 static const int kMaxOverages = 3;
@@ -157,6 +170,55 @@ inline Length pages(size_t bytes) {
 // reduce the number of size classes.
 int AlignmentForSize(size_t size);
 
+// Zeroes size bytes at ptr using non-temporal stores where the target
+// supports them, so that the memory isn't pulled into the cache.
+void ZeroNonTemporal(void* ptr, size_t size);
+
+// The ways tcmalloc_zero_object can zero memory, which are the values of
+// the tcmalloc.zero_kernel property.
+enum ZeroKernel {
+  kZeroMemset,     // libc's memset()
+  kZeroRepStosb,   // rep stosb (x86 with ERMSB or FSRM)
+  kZeroAVX2,       // 32-byte vector stores
+  kZeroAVX512,     // 64-byte vector stores
+  kZeroClzero,     // clzero on the whole cache lines of big objects (AMD)
+  kZeroDcZva,      // dc zva on the whole blocks of big objects (AArch64)
+  kNumZeroKernels
+};
+
+// Picks the zeroing kernel for this CPU (using CPUID on x86), unless
+// TCMALLOC_ZERO_KERNEL pins one it supports, and reads
+// TCMALLOC_CHECK_ZERO_THRESHOLD.
+void InitZeroKernel();
+
+// The zeroing kernel in use.
+ZeroKernel zero_kernel();
+
+// Switches to the given zeroing kernel.  Returns false (and changes
+// nothing) if this CPU can't run it.
+bool SetZeroKernel(int kernel);
+
+// Objects of at least this many bytes (if non-zero) are scanned before
+// they're zeroed, and only their non-zero cache lines get written, so pages
+// that are zero already stay clean (and shared, if they're copy-on-write).
+// This is the tcmalloc.check_zero_threshold property.
+size_t check_zero_threshold_bytes();
+void set_check_zero_threshold_bytes(size_t threshold);
+
+// Zeroes size bytes at ptr.  The allocator's memsets all go through this
+// never-inlined function, so CPU profiles can tell them from other
+// memsets: pprof reports it, ZeroNonTemporal and the fixed-size zeroing
+// functions together as tcmalloc_zero_object.
+extern "C" void tcmalloc_zero_object(void* ptr, size_t size);
+
+// ceil(log2(N)), at compile time
+template <size_t N> struct LgCeil {
+  enum { value = LgCeil<(N + 1) / 2>::value + 1 };
+};
+template <> struct LgCeil<1> {
+  enum { value = 0 };
+};
+
 // Size-class information + mapping
 class SizeMap {
  private:
@@ -171,49 +233,116 @@ class SizeMap {
   // Mapping from size to size_class and vice versa
   //-------------------------------------------------------------------
 
-  // Sizes <= 1024 have an alignment >= 8.  So for such sizes we have an
-  // array indexed by ceil(size/8).  Sizes > 1024 have an alignment >= 128.
-  // So for these larger sizes we have an array indexed by ceil(size/128).
+  // Sizes <= 1024 have an alignment >= 8, so for them we have a dense
+  // array indexed by ceil(size/8), which spans two or three cachelines.
   //
-  // We flatten both logical arrays into one physical array and use
-  // arithmetic to compute an appropriate index.  The constants used by
-  // ClassIndex() were selected to make the flattening work.
+  // Above that, the classes are spaced in proportion to their size, so an
+  // array indexed by ceil(size/128) would mostly repeat itself, over
+  // several KB of cold cachelines with kMaxSize at 512 KB.  Instead, each
+  // range (2^k, 2^(k+1)] is split into 2^kLargeBucketBits buckets, which
+  // map to the smallest class for the smallest size in the bucket; the
+  // class for a size is that one or one of the next few.
   //
   // Examples:
-  //   Size       Expression                      Index
+  //   Size       Array         Index
   //   -------------------------------------------------------
-  //   0          (0 + 7) / 8                     0
-  //   1          (1 + 7) / 8                     1
+  //   0          small         0
+  //   1          small         1
+  //   ...
+  //   1024       small         128
+  //   1025       large         0           (k = 10, bucket 0)
   //   ...
-  //   1024       (1024 + 7) / 8                  128
-  //   1025       (1025 + 127 + (120<<7)) / 128   129
+  //   2048       large         15          (k = 10, bucket 15)
+  //   2049       large         16          (k = 11, bucket 0)
   //   ...
-  //   32768      (32768 + 127 + (120<<7)) / 128  376
+  //   kMaxSize   large         kLargeClassArraySize - 1
   static const int kMaxSmallSize = 1024;
-  static const size_t kClassArraySize =
-      ((kMaxSize + 127 + (120 << 7)) >> 7) + 1;
-  unsigned char class_array_[kClassArraySize];
+  static const int kLgMaxSmallSize = 10;
+  static const int kLargeBucketBits = 4;
+
+  static const size_t kSmallClassArraySize = (kMaxSmallSize >> 3) + 1;
+  static const size_t kLargeClassArraySize =
+      (LgCeil<kMaxSize>::value - kLgMaxSmallSize) << kLargeBucketBits;
+  unsigned char small_class_[kSmallClassArraySize];
+  unsigned char large_class_[kLargeClassArraySize];
 
-  // Compute index of the class_array[] entry for a given size
-  static inline size_t ClassIndex(int s) {
+  // Compute index of the small_class_[] entry for a size <= kMaxSmallSize
+  static inline size_t SmallClassIndex(int s) {
     // Use unsigned arithmetic to avoid unnecessary sign extensions.
     ASSERT(0 <= s);
+    ASSERT(s <= kMaxSmallSize);
+    return (static_cast<uint32_t>(s) + 7) >> 3;
+  }
+
+  // Compute index of the large_class_[] entry for a size above
+  // kMaxSmallSize
+  static inline size_t LargeClassIndex(int s) {
+    ASSERT(kMaxSmallSize < s);
     ASSERT(s <= kMaxSize);
-    if (LIKELY(s <= kMaxSmallSize)) {
-      return (static_cast<uint32_t>(s) + 7) >> 3;
-    } else {
-      return (static_cast<uint32_t>(s) + 127 + (120 << 7)) >> 7;
-    }
+    const uint32_t v = static_cast<uint32_t>(s) - 1;
+#if defined(__GNUC__)
+    const int lg = 31 ^ __builtin_clz(v);
+#else
+    int lg = kLgMaxSmallSize;
+    while ((v >> (lg + 1)) != 0) lg++;
+#endif
+    const uint32_t bucket =
+        (v >> (lg - kLargeBucketBits)) & ((1 << kLargeBucketBits) - 1);
+    return ((lg - kLgMaxSmallSize) << kLargeBucketBits) + bucket;
+  }
+
+  // The class for a size above kMaxSmallSize
+  inline int LargeSizeClass(int size) {
+    int cl = large_class_[LargeClassIndex(size)];
+    while (class_to_size_[cl] < size) cl++;
+    return cl;
   }
 
   int NumMoveSize(size_t size);
 
+  // Number of pages to allocate at a time for objects of "size" bytes
+  size_t ClassPages(size_t size);
+
+  // Fill in class_to_size_ and class_to_pages_, by the default rule (which
+  // returns the number of classes made), or to fit the allocation histogram
+  // in a profile file (which returns false if the file can't be used).
+  int DefaultClasses();
+  bool ProfileClasses(const char* path);
+  // Fill them in (and num_objects_to_move_) from the tables built in for
+  // the default rule, if there are some for this configuration.
+  bool TableClasses();
+
   // Mapping from size class to max size storable in that class
   size_t class_to_size_[kNumClasses];
 
   // Mapping from size class to number of pages to allocate at a time
   size_t class_to_pages_[kNumClasses];
 
+ public:
+  // Zeroes one object of a particular (fixed) size.
+  typedef void (*ZeroFunction)(void* ptr);
+
+  // Classes up to this size get their own zeroing function, instead of
+  // going through memset() with a variable size.
+  static const size_t kMaxFixedZeroSize = 256;
+
+ private:
+  // Mapping from size class to its zeroing function (or NULL)
+  ZeroFunction class_to_zero_[kNumClasses];
+
+  // Mapping from alignment (log2, below kPageShift) and size class to the
+  // first class at least that large whose objects all have that alignment,
+  // or 0 if there is none
+  unsigned char aligned_class_[kPageShift][kNumClasses];
+
+  // Objects of at least this size (if non-zero) are zeroed with
+  // non-temporal stores, which bypass the cache.
+  size_t nontemporal_zero_threshold_;
+
+  // Allocations that must be zeroed and are bigger than this (if non-zero)
+  // come from whole pages, even if they would fit a size class.
+  size_t page_zero_threshold_;
+
  public:
   // Constructor should do nothing since we rely on explicit Init()
   // call, which may or may not be called before the constructor runs.
@@ -223,7 +352,20 @@ class SizeMap {
   void Init();
 
   inline int SizeClass(int size) {
-    return class_array_[ClassIndex(size)];
+    if (LIKELY(size <= kMaxSmallSize)) {
+      return small_class_[SmallClassIndex(size)];
+    }
+    return LargeSizeClass(size);
+  }
+
+  // Smallest size class for "size" whose objects are aligned to "align",
+  // or 0 if there is none.
+  // REQUIRES: size <= kMaxSize, align is a power of two below kPageSize
+  inline int AlignedSizeClass(size_t size, size_t align) {
+    ASSERT(align < kPageSize && (align & (align - 1)) == 0);
+    int shift = 0;
+    while ((static_cast<size_t>(1) << shift) < align) shift++;
+    return aligned_class_[shift][SizeClass(size)];
   }
 
   // Get the byte-size for a specified class
@@ -236,6 +378,46 @@ class SizeMap {
     return class_to_size_[cl];
   }
 
+  // Zero an object of the specified class, which is class_to_size(cl) bytes.
+  inline void ZeroObject(size_t cl, void* ptr) {
+    ZeroFunction fn = class_to_zero_[cl];
+    if (LIKELY(fn != NULL)) {
+      (*fn)(ptr);
+    } else {
+      const size_t size = class_to_size_[cl];
+      if (nontemporal_zero_threshold_ != 0 &&
+          size >= nontemporal_zero_threshold_) {
+        ZeroNonTemporal(ptr, size);
+      } else {
+        tcmalloc_zero_object(ptr, size);
+      }
+    }
+  }
+
+  inline size_t nontemporal_zero_threshold() const {
+    return nontemporal_zero_threshold_;
+  }
+
+  inline void set_nontemporal_zero_threshold(size_t threshold) {
+    nontemporal_zero_threshold_ = threshold;
+  }
+
+  // Whether an allocation of "size" bytes that has to be zeroed should skip
+  // the size classes.  Page-level spans are often zero already (and their
+  // untouched pages stay unbacked), where a class object would need one
+  // big memset.
+  inline bool ZeroFromPages(size_t size) const {
+    return page_zero_threshold_ != 0 && size > page_zero_threshold_;
+  }
+
+  inline size_t page_zero_threshold() const {
+    return page_zero_threshold_;
+  }
+
+  inline void set_page_zero_threshold(size_t threshold) {
+    page_zero_threshold_ = threshold;
+  }
+
   // Mapping from size class to number of pages to allocate at a time
   inline size_t class_to_pages(size_t cl) {
     return class_to_pages_[cl];
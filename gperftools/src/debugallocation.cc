@@ -128,6 +128,14 @@ DEFINE_int32(max_free_queue_size,
              "the total size of all blocks in the queue would otherwise exceed "
              "this limit.");
 
+DEFINE_bool(malloc_returns_zero,
+            EnvToBool("TCMALLOC_MALLOC_RETURNS_ZERO", false),
+            "If set, new memory is zero rather than filled with a pattern, "
+            "as with the non-debug tcmalloc that code built with "
+            "malloc-returns-zero (SafeInit) relies on.  The *_noinit "
+            "functions still return patterned memory, and freed memory is "
+            "still poisoned.");
+
 DEFINE_bool(symbolize_stacktrace,
             EnvToBool("TCMALLOC_SYMBOLIZE_STACKTRACE", true),
             "Symbolize the stack trace when provided (on some error exits)");
@@ -380,7 +388,8 @@ class MallocBlock {
 
  private:  // other helpers
 
-  void Initialize(size_t size, int type) {
+  // If zeroed is set, the data is zero already, and is left that way.
+  void Initialize(size_t size, int type, bool zeroed) {
     RAW_CHECK(IsValidMagicValue(magic1_), "");
     // record us as allocated in the map
     alloc_map_lock_.Lock();
@@ -398,7 +407,7 @@ class MallocBlock {
       *size2_addr() = size;
     }
     alloc_map_lock_.Unlock();
-    memset(data_addr(), kMagicUninitializedByte, size);
+    if (!zeroed) memset(data_addr(), kMagicUninitializedByte, size);
     if (!IsMMapped()) {
       RAW_CHECK(size1_ == *size2_addr(), "should hold");
       RAW_CHECK(magic1_ == *magic2_addr(), "should hold");
@@ -490,7 +499,9 @@ class MallocBlock {
 
  public:  // our main interface
 
-  static MallocBlock* Allocate(size_t size, int type) {
+  // If zero is set, the block's data is zero, rather than filled with
+  // kMagicUninitializedByte.
+  static MallocBlock* Allocate(size_t size, int type, bool zero = false) {
     // Prevent an integer overflow / crash with large allocation sizes.
     // TODO - Note that for a e.g. 64-bit size_t, max_size_t may not actually
     // be the maximum value, depending on how the compiler treats ~0. The worst
@@ -525,11 +536,15 @@ class MallocBlock {
         RAW_LOG(FATAL, "Guard page setup failed: %s", strerror(errno));
       }
       b = (MallocBlock*) (p + (num_pages - 1) * pagesize - sz);
+      // (fresh from mmap, so zero already)
     } else {
-      b = (MallocBlock*) do_malloc(real_malloced_size(size));
+      size_t sz = real_malloced_size(size);
+      // tcmalloc often knows the memory to be zero, and can skip zeroing it.
+      b = (MallocBlock*) do_malloc(sz, zero);
     }
 #else
-    b = (MallocBlock*) do_malloc(real_malloced_size(size));
+    size_t sz = real_malloced_size(size);
+    b = (MallocBlock*) do_malloc(sz, zero);
 #endif
 
     // It would be nice to output a diagnostic on allocation failure
@@ -538,7 +553,7 @@ class MallocBlock {
     // malloc semantics and return NULL on failure.
     if (b != NULL) {
       b->magic1_ = use_malloc_page_fence ? kMagicMMap : kMagicMalloc;
-      b->Initialize(size, type);
+      b->Initialize(size, type, zero);
     }
     return b;
   }
@@ -1023,8 +1038,12 @@ void __malloctrace_write(const char *buf, size_t size) {
 
 // General debug allocation/deallocation
 
-static inline void* DebugAllocate(size_t size, int type) {
-  MallocBlock* ptr = MallocBlock::Allocate(size, type);
+// init is false for the *_noinit functions, whose callers initialize
+// every byte themselves: their memory is never zeroed, so that reads
+// before that show up.
+static inline void* DebugAllocate(size_t size, int type, bool init = true) {
+  MallocBlock* ptr =
+      MallocBlock::Allocate(size, type, init && FLAGS_malloc_returns_zero);
   if (ptr == NULL)  return NULL;
   MALLOC_TRACE("malloc", size, ptr->data_addr());
   return ptr->data_addr();
@@ -1172,11 +1191,12 @@ REGISTER_MODULE_DESTRUCTOR(debugallocation, {
 struct debug_alloc_retry_data {
   size_t size;
   int new_type;
+  bool init;
 };
 
 static void *retry_debug_allocate(void *arg) {
   debug_alloc_retry_data *data = static_cast<debug_alloc_retry_data *>(arg);
-  return DebugAllocate(data->size, data->new_type);
+  return DebugAllocate(data->size, data->new_type, data->init);
 }
 
 // This is mostly the same a cpp_alloc in tcmalloc.cc.
@@ -1184,26 +1204,30 @@ static void *retry_debug_allocate(void *arg) {
 // don't have to reproduce the logic here.  To make tc_new_mode work
 // properly, I think we'll need to separate out the logic of throwing
 // from the logic of calling the new-handler.
-inline void* debug_cpp_alloc(size_t size, int new_type, bool nothrow) {
-  void* p = DebugAllocate(size, new_type);
+inline void* debug_cpp_alloc(size_t size, int new_type, bool nothrow,
+                             bool init = true) {
+  void* p = DebugAllocate(size, new_type, init);
   if (p != NULL) {
     return p;
   }
   struct debug_alloc_retry_data data;
   data.size = size;
   data.new_type = new_type;
+  data.init = init;
   return handle_oom(retry_debug_allocate, &data,
                     true, nothrow);
 }
 
-inline void* do_debug_malloc_or_debug_cpp_alloc(size_t size) {
-  void* p = DebugAllocate(size, MallocBlock::kMallocType);
+inline void* do_debug_malloc_or_debug_cpp_alloc(size_t size,
+                                                bool init = true) {
+  void* p = DebugAllocate(size, MallocBlock::kMallocType, init);
   if (p != NULL) {
     return p;
   }
   struct debug_alloc_retry_data data;
   data.size = size;
   data.new_type = MallocBlock::kMallocType;
+  data.init = init;
   return handle_oom(retry_debug_allocate, &data,
                     false, true);
 }
@@ -1216,11 +1240,68 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_malloc(size_t size) __THROW {
   return ptr;
 }
 
+extern "C" PERFTOOLS_DLL_DECL void* tc_malloc_noinit(size_t size) __THROW {
+  void* ptr = do_debug_malloc_or_debug_cpp_alloc(size, false);
+  MallocHook::InvokeNewHook(ptr, size);
+  return ptr;
+}
+
 extern "C" PERFTOOLS_DLL_DECL void tc_free(void* ptr) __THROW {
   MallocHook::InvokeDeleteHook(ptr);
   DebugDeallocate(ptr, MallocBlock::kMallocType);
 }
 
+// The batches are just loops here, so that each block gets checked.
+extern "C" PERFTOOLS_DLL_DECL size_t tc_malloc_batch(size_t size, void** ptrs,
+                                                     size_t n) __THROW {
+  for (size_t i = 0; i < n; i++) {
+    ptrs[i] = do_debug_malloc_or_debug_cpp_alloc(size);
+    if (ptrs[i] == NULL) return i;
+    MallocHook::InvokeNewHook(ptrs[i], size);
+  }
+  return n;
+}
+
+extern "C" PERFTOOLS_DLL_DECL size_t tc_malloc_batch_noinit(size_t size,
+                                                            void** ptrs,
+                                                            size_t n) __THROW {
+  for (size_t i = 0; i < n; i++) {
+    ptrs[i] = do_debug_malloc_or_debug_cpp_alloc(size, false);
+    if (ptrs[i] == NULL) return i;
+    MallocHook::InvokeNewHook(ptrs[i], size);
+  }
+  return n;
+}
+
+extern "C" PERFTOOLS_DLL_DECL void tc_free_batch(void** ptrs, size_t n,
+                                                 size_t size) __THROW {
+  for (size_t i = 0; i < n; i++) {
+    MallocHook::InvokeDeleteHook(ptrs[i]);
+    DebugDeallocate(ptrs[i], MallocBlock::kMallocType);
+  }
+}
+
+// The debug allocator's blocks have nothing to spare past what was asked
+// for (that's where it checks for overruns).
+extern "C" PERFTOOLS_DLL_DECL void* tc_malloc_sized(size_t size,
+                                                    size_t* actual) __THROW {
+  void* ptr = do_debug_malloc_or_debug_cpp_alloc(size);
+  MallocHook::InvokeNewHook(ptr, size);
+  if (actual) *actual = (ptr != NULL) ? size : 0;
+  return ptr;
+}
+
+extern "C" PERFTOOLS_DLL_DECL void* tc_new_sized(size_t size,
+                                                 size_t* actual) {
+  void* ptr = debug_cpp_alloc(size, MallocBlock::kNewType, false);
+  MallocHook::InvokeNewHook(ptr, size);
+  if (ptr == NULL) {
+    RAW_LOG(FATAL, "Unable to allocate %" PRIuS " bytes: new failed.", size);
+  }
+  if (actual) *actual = size;
+  return ptr;
+}
+
 extern "C" PERFTOOLS_DLL_DECL void* tc_calloc(size_t count, size_t size) __THROW {
   // Overflow check
   const size_t total_size = count * size;
@@ -1228,7 +1309,7 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_calloc(size_t count, size_t size) __THROW
 
   void* block = do_debug_malloc_or_debug_cpp_alloc(total_size);
   MallocHook::InvokeNewHook(block, total_size);
-  if (block)  memset(block, 0, total_size);
+  if (block && !FLAGS_malloc_returns_zero)  memset(block, 0, total_size);
   return block;
 }
 
@@ -1250,7 +1331,8 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_realloc(void* ptr, size_t size) __THROW {
   }
   MallocBlock* old = MallocBlock::FromRawPointer(ptr);
   old->Check(MallocBlock::kMallocType);
-  MallocBlock* p = MallocBlock::Allocate(size, MallocBlock::kMallocType);
+  MallocBlock* p = MallocBlock::Allocate(size, MallocBlock::kMallocType,
+                                         FLAGS_malloc_returns_zero);
 
   // If realloc fails we are to leave the old block untouched and
   // return null
@@ -1284,6 +1366,15 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_new(size_t size) {
   return ptr;
 }
 
+extern "C" PERFTOOLS_DLL_DECL void* tc_new_noinit(size_t size) {
+  void* ptr = debug_cpp_alloc(size, MallocBlock::kNewType, false, false);
+  MallocHook::InvokeNewHook(ptr, size);
+  if (ptr == NULL) {
+    RAW_LOG(FATAL, "Unable to allocate %" PRIuS " bytes: new failed.", size);
+  }
+  return ptr;
+}
+
 extern "C" PERFTOOLS_DLL_DECL void* tc_new_nothrow(size_t size, const std::nothrow_t&) __THROW {
   void* ptr = debug_cpp_alloc(size, MallocBlock::kNewType, true);
   MallocHook::InvokeNewHook(ptr, size);
@@ -1311,6 +1402,15 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_newarray(size_t size) {
   return ptr;
 }
 
+extern "C" PERFTOOLS_DLL_DECL void* tc_newarray_noinit(size_t size) {
+  void* ptr = debug_cpp_alloc(size, MallocBlock::kArrayNewType, false, false);
+  MallocHook::InvokeNewHook(ptr, size);
+  if (ptr == NULL) {
+    RAW_LOG(FATAL, "Unable to allocate %" PRIuS " bytes: new[] failed.", size);
+  }
+  return ptr;
+}
+
 extern "C" PERFTOOLS_DLL_DECL void* tc_newarray_nothrow(size_t size, const std::nothrow_t&)
     __THROW {
   void* ptr = debug_cpp_alloc(size, MallocBlock::kArrayNewType, true);
@@ -1330,6 +1430,17 @@ extern "C" PERFTOOLS_DLL_DECL void tc_deletearray_nothrow(void* p, const std::no
   DebugDeallocate(p, MallocBlock::kArrayNewType);
 }
 
+// The size isn't needed here, the block header has it.
+extern "C" PERFTOOLS_DLL_DECL void tc_delete_sized(void* p, size_t size) __THROW {
+  MallocHook::InvokeDeleteHook(p);
+  DebugDeallocate(p, MallocBlock::kNewType);
+}
+
+extern "C" PERFTOOLS_DLL_DECL void tc_deletearray_sized(void* p, size_t size) __THROW {
+  MallocHook::InvokeDeleteHook(p);
+  DebugDeallocate(p, MallocBlock::kArrayNewType);
+}
+
 // This is mostly the same as do_memalign in tcmalloc.cc.
 static void *do_debug_memalign(size_t alignment, size_t size) {
   // Allocate >= size bytes aligned on "alignment" boundary
@@ -287,6 +287,13 @@ class PERFTOOLS_DLL_DECL HeapLeakChecker {
   // are being used.
   static void IgnoreLiveObjectsLocked(const char* name, const char* name2);
 
+  // Helper for IgnoreLiveObjectsLocked that takes objects off live_objects
+  // and looks for heap pointers in them until there are none left.
+  // "scan" is a LiveObjectScan (see our .cc file) with its parameters and
+  // results; with FLAGS_heap_check_scan_threads, several threads run this
+  // at once (so it's also a clone(2) entry point).
+  static int ScanLiveObjectsLocked(void* scan);
+
   // Do the overall whole-program heap leak check if needed;
   // returns true when did the leak check.
   static bool DoMainHeapCheck();
@@ -82,6 +82,14 @@ class PERFTOOLS_DLL_DECL SysAllocator {
   // Returns NULL if failed. Otherwise, the returned pointer p up to and
   // including (p + actual_size -1) have been allocated.
   virtual void* Alloc(size_t size, size_t *actual_size, size_t alignment) = 0;
+
+  // Like Alloc(), but also sets "*zeroed" to whether all of the returned
+  // memory is known to read as zero (as fresh anonymous mmap()s do), so
+  // that the malloc implementation needn't zero it itself for calloc()
+  // and the like.  The default implementation calls Alloc() and sets
+  // "*zeroed" to false.
+  virtual void* AllocMaybeZeroed(size_t size, size_t *actual_size,
+                                 size_t alignment, bool* zeroed);
 };
 
 // The default implementations of the following routines do nothing.
@@ -206,6 +214,77 @@ class PERFTOOLS_DLL_DECL MallocExtension {
   //        virtual memory usage, and depending on the OS, typically
   //        do not count towards physical memory usage.  This property
   //        is not writable.
+  //
+  // "tcmalloc.pageheap_reserve_count"
+  // "tcmalloc.pageheap_commit_count"
+  // "tcmalloc.pageheap_decommit_count"
+  //      Number of times the page heap has asked the system for memory,
+  //      committed released pages again, and released (decommitted)
+  //      pages, since the program started.  Reserving and releasing
+  //      take a system call each; committing takes none on most
+  //      systems, but the pages fault in again when first touched.
+  //      These properties are not writable.
+  //
+  // "tcmalloc.zeroed_bytes"
+  // "tcmalloc.zeroed_objects"
+  //      Number of bytes (objects) tcmalloc has had to zero, e.g. for
+  //      calloc, since the program started.  GetStats() breaks this
+  //      down by size class and by allocation path.  These
+  //      properties are not writable.
+  //
+  // "tcmalloc.zero_skipped_bytes"
+  //      Number of bytes tcmalloc did not have to zero, because they
+  //      were known to be zero already (e.g. fresh from the OS).
+  //      This property is not writable.
+  //
+  // "tcmalloc.thread_cache_fetches"
+  // "tcmalloc.thread_cache_releases"
+  //      Number of times the thread caches have had to fetch objects
+  //      from (release objects to) the central cache since the program
+  //      started.  These properties are not writable.
+  //
+  // "tcmalloc.this_thread_cache_fetches"
+  // "tcmalloc.this_thread_cache_releases"
+  // "tcmalloc.this_thread_cache_max_bytes"
+  //      The same counts for the calling thread's cache alone, and the
+  //      current limit on its size, which grows faster the more often
+  //      the thread fetches.  (With per-CPU caches, the thread's own
+  //      cache holds nothing.)  These properties are not writable.
+  //
+  // "tcmalloc.background_release"
+  //      1 if a thread of tcmalloc's own releases free memory to the
+  //      system (see TCMALLOC_BACKGROUND_RELEASE), 0 otherwise.  This
+  //      property is not writable.
+  //
+  // "tcmalloc.prefault_bytes"
+  //      Number of bytes prefaulted at startup (see
+  //      TCMALLOC_PREFAULT_BYTES), which are never released to the
+  //      system.  This property is not writable.
+  //
+  // "tcmalloc.max_cached_object_size"
+  //      Objects of more than this many bytes aren't kept in the thread
+  //      (or per-CPU) caches, but go back to the central free lists
+  //      right away (see TCMALLOC_MAX_CACHED_OBJECT_SIZE).  This
+  //      property is writable.
+  //
+  // "tcmalloc.direct_mmap_threshold"
+  //      Allocations of at least this many bytes are mapped from the
+  //      system for themselves, and unmapped when freed, rather than
+  //      carved from the page heap (see TCMALLOC_DIRECT_MMAP_THRESHOLD);
+  //      0 if none are.  This property is writable.
+  //
+  // "tcmalloc.parallel_zero_threshold"
+  //      Memory of at least this many bytes that calloc (or realloc,
+  //      etc.) has to zero is zeroed by helper threads along with the
+  //      caller (see TCMALLOC_PARALLEL_ZERO_THRESHOLD); 0 if none is.
+  //      Setting it starts the helpers if they aren't running yet.  This
+  //      property is writable.
+  //
+  // "tcmalloc.stats_page"
+  //      Address of the MallocStatsPage (see malloc_stats_page.h) kept
+  //      up to date with TCMALLOC_STATS_PAGE set, or 0.  Unlike the
+  //      properties above, reading it takes no allocator locks.  This
+  //      property is not writable.
   // -------------------------------------------------------------------
 
   // Get the named "property"'s value.  Returns true if the property
@@ -240,6 +319,14 @@ class PERFTOOLS_DLL_DECL MallocExtension {
   // Most malloc implementations ignore this routine.
   virtual void MarkThreadBusy();
 
+  // Zero the free memory cached for the current thread, so that it need
+  // not be zeroed when it is allocated again.  This is meant to be called
+  // by threads with nothing better to do (e.g. idle workers), to take the
+  // cost of zeroing off the allocation path.
+  //
+  // Most malloc implementations ignore this routine.
+  virtual void ZeroThreadFreeMemory();
+
   // Gets the system allocator used by the malloc extension instance. Returns
   // NULL for malloc implementations that do not support pluggable system
   // allocators.
@@ -74,6 +74,7 @@ PERFTOOLS_DLL_DECL void MallocExtension_GetStats(char* buffer, int buffer_length
 PERFTOOLS_DLL_DECL int MallocExtension_GetNumericProperty(const char* property, size_t* value);
 PERFTOOLS_DLL_DECL int MallocExtension_SetNumericProperty(const char* property, size_t value);
 PERFTOOLS_DLL_DECL void MallocExtension_MarkThreadIdle(void);
+PERFTOOLS_DLL_DECL void MallocExtension_ZeroThreadFreeMemory(void);
 PERFTOOLS_DLL_DECL void MallocExtension_MarkThreadBusy(void);
 PERFTOOLS_DLL_DECL void MallocExtension_ReleaseToSystem(size_t num_bytes);
 PERFTOOLS_DLL_DECL void MallocExtension_ReleaseFreeMemory(void);
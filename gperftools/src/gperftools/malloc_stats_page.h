@@ -0,0 +1,101 @@
+/* Copyright (c) 2008, Google Inc.
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---
+ * The layout of the statistics page TCMalloc keeps with
+ * TCMALLOC_STATS_PAGE set (see doc/tcmalloc.html).  An allocator thread
+ * refreshes the page every TCMALLOC_STATS_PAGE_INTERVAL_MS; readers, in
+ * the process or out of it (by mapping the file the variable names
+ * read-only), copy it out without taking any allocator locks.
+ *
+ * The page is a seqlock: "sequence" is odd while the page is being
+ * written, and changes with every update.  A reader loads it (with
+ * acquire semantics), copies the page, and loads it again after an
+ * acquire fence; if either load was odd or they differ, the copy may be
+ * torn and it tries again.  MallocStatsPage_Read() does this with the
+ * GCC atomic builtins.
+ */
+
+#ifndef _MALLOC_STATS_PAGE_H_
+#define _MALLOC_STATS_PAGE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define MALLOC_STATS_PAGE_MAGIC      "TCMSTP1"   /* with its '\0' */
+#define MALLOC_STATS_PAGE_MAX_CLASSES 128
+
+struct MallocStatsPage {
+  char magic[8];                  /* MALLOC_STATS_PAGE_MAGIC */
+  uint64_t sequence;              /* odd while being written */
+  uint64_t updates;               /* completed updates so far */
+
+  /* As for the "generic.*" and "tcmalloc.*" numeric properties of the
+   * same names (see malloc_extension.h). */
+  uint64_t current_allocated_bytes;
+  uint64_t heap_size;
+  uint64_t pageheap_free_bytes;
+  uint64_t pageheap_unmapped_bytes;
+  uint64_t pageheap_committed_bytes;
+  uint64_t thread_cache_free_bytes;
+  uint64_t central_cache_free_bytes;
+  uint64_t transfer_cache_free_bytes;
+  uint64_t metadata_bytes;
+  uint64_t pageheap_reserve_count;
+  uint64_t pageheap_commit_count;
+  uint64_t pageheap_decommit_count;
+  uint64_t zeroed_bytes;
+  uint64_t zero_skipped_bytes;    /* known zero, so not zeroed */
+  uint64_t prefault_bytes;        /* kept faulted in, never released */
+
+  /* Free objects by size class, in the thread, central and transfer
+   * caches together; class 0 is unused. */
+  uint64_t num_classes;
+  uint64_t class_size[MALLOC_STATS_PAGE_MAX_CLASSES];
+  uint64_t class_free[MALLOC_STATS_PAGE_MAX_CLASSES];
+};
+
+#if defined(__GNUC__)
+/* Copies a consistent snapshot of *page into *out, retrying while the
+ * allocator updates it.  Returns 0 if *page isn't a stats page. */
+static inline int MallocStatsPage_Read(const struct MallocStatsPage* page,
+                                       struct MallocStatsPage* out) {
+  uint64_t before, after;
+  if (memcmp(page->magic, MALLOC_STATS_PAGE_MAGIC, 8) != 0) return 0;
+  do {
+    before = __atomic_load_n(&page->sequence, __ATOMIC_ACQUIRE);
+    memcpy(out, page, sizeof(*out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&page->sequence, __ATOMIC_RELAXED);
+  } while ((before & 1) != 0 || before != after);
+  return 1;
+}
+#endif
+
+#endif  /* _MALLOC_STATS_PAGE_H_ */
@@ -0,0 +1,71 @@
+/* Copyright (c) 2008, Google Inc.
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---
+ * The stack high-water mark for SafeInit frame clearing (built with
+ * "-mllvm -frame-init-stack-mark", x86-64 Linux only).  Each thread's
+ * stack is known to be zero below the mark, so functions whose frames lie
+ * there needn't clear them; the compiled code lowers the mark as it
+ * writes the stack, and drops it altogether before calling anything that
+ * wasn't built to keep it.
+ *
+ * The mark starts out unset.  __safeinit_stack_reset() zeroes the stack
+ * below its caller and sets it, so it pays off when called from a
+ * function that only calls code built with the mark, e.g. the dispatch
+ * loop of a server built that way throughout.  It also gives the thread an
+ * alternate signal stack: signal handlers may be installed only with
+ * SA_ONSTACK while the mark is in use, since they would otherwise write
+ * below the frame they interrupt.
+ */
+
+#ifndef _SAFEINIT_STACK_H_
+#define _SAFEINIT_STACK_H_
+
+/* Annoying stuff for windows; makes sure clients can import these functions */
+#ifndef PERFTOOLS_DLL_DECL
+# ifdef _WIN32
+#   define PERFTOOLS_DLL_DECL  __declspec(dllimport)
+# else
+#   define PERFTOOLS_DLL_DECL
+# endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* (The compiler knows it by name: calling it doesn't count as calling
+ * code that doesn't keep the mark.) */
+PERFTOOLS_DLL_DECL void __safeinit_stack_reset(void);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif  /* _SAFEINIT_STACK_H_ */
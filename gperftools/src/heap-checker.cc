@@ -83,6 +83,14 @@
 #include "base/commandlineflags.h"
 #include "base/elfcore.h"              // for i386_regs
 #include "base/thread_lister.h"
+#include "base/linuxthreads.h"         // for THREADS
+#ifdef THREADS
+#include <sched.h>                     // for clone
+#include <sys/wait.h>
+#ifndef CLONE_UNTRACED
+#define CLONE_UNTRACED 0x00800000
+#endif
+#endif
 #include "heap-profile-table.h"
 #include "base/low_level_alloc.h"
 #include "malloc_hook-inl.h"
@@ -208,6 +216,20 @@ DEFINE_int64(heap_check_max_pointer_offset,
              "pointers going inside of heap allocated objects. "
              "Set to -1 to use the actual largest heap object size.");
 
+DEFINE_int32(heap_check_scan_threads,
+             EnvToInt("HEAP_CHECK_SCAN_THREADS", 1),
+             "Number of threads (including the one doing the check) "
+             "looking for live objects while the other threads are stopped. "
+             "Large heaps get checked faster with more.");
+
+DEFINE_bool(heap_check_incremental,
+            EnvToBool("HEAP_CHECK_INCREMENTAL", false),
+            "If true, pages of heap objects which held nothing that "
+            "could be a heap pointer at the previous leak check, and which "
+            "the kernel's soft-dirty bits show weren't written since, "
+            "aren't looked at again. (This clears the soft-dirty bits "
+            "of the process at every check.)");
+
 DEFINE_bool(heap_check_run_under_gdb,
             EnvToBool("HEAP_CHECK_RUN_UNDER_GDB", false),
             "If false, turns off heap-checking library when running under gdb "
@@ -989,6 +1011,187 @@ static enum {
   CALLBACK_COMPLETED,
 } thread_listing_status = CALLBACK_NOT_STARTED;
 
+//----------------------------------------------------------------------
+// Incremental leak checking
+//----------------------------------------------------------------------
+
+// With FLAGS_heap_check_incremental we remember which pages of heap objects
+// held no word that could be a heap pointer when we last looked at them,
+// and clear the soft-dirty bits of the process right after each check
+// (while all threads are still stopped). A page which the next check finds
+// still clean in /proc/self/pagemap can't hold a heap pointer either then,
+// so it doesn't need to be looked at. (What could be a heap pointer depends
+// on min_heap_address and max_heap_address, so we start over whenever those
+// move.) Nothing else in the process should clear the soft-dirty bits.
+
+// Bit of a /proc/self/pagemap entry that gets set when the page is written
+// (see linux/Documentation/vm/soft-dirty.txt).
+static const int kPagemapSoftDirtyBit = 55;
+
+// Whether the soft-dirty bits work for us: 0 if we haven't found out yet,
+// 1 if they do, -1 if they don't (protected by our lock)
+static int soft_dirty_bits_work = 0;
+
+// /proc/self/pagemap, once we've opened it (protected by our lock)
+static int pagemap_fd = -1;
+
+// Clears the soft-dirty bits of all our pages.
+static bool ClearSoftDirtyBits() {
+  int fd = open("/proc/self/clear_refs", O_WRONLY);
+  if (fd < 0) return false;
+  const bool ok = write(fd, "4", 1) == 1;
+  close(fd);
+  return ok;
+}
+
+// Reads the soft-dirty bits of a run of pages, a buffer's worth at a time.
+class SoftDirtyReader {
+ public:
+  SoftDirtyReader() : first_(0), count_(0) { }
+  // Returns true if page number "page" may have been written since
+  // the soft-dirty bits were cleared; "last" is the last page we're
+  // going to ask about, for reading ahead.
+  bool IsDirty(uintptr_t page, uintptr_t last) {
+    if (page < first_  ||  page >= first_ + count_) {
+      count_ = min<uintptr_t>(last - page + 1, kEntries);
+      const ssize_t want = count_ * sizeof(entries_[0]);
+      if (pread(pagemap_fd, entries_, want, page * sizeof(entries_[0]))
+          != want) {
+        count_ = 0;
+        return true;
+      }
+      first_ = page;
+    }
+    return (entries_[page - first_] >> kPagemapSoftDirtyBit) & 1;
+  }
+ private:
+  static const int kEntries = 64;
+  uint64 entries_[kEntries];
+  uintptr_t first_;
+  uintptr_t count_;
+};
+
+// Byte per page of the heap address range [min_address, max_address]:
+// 1 if the page held no possible heap pointer when we last looked at it.
+// The bytes are allocated a leaf of kLeafPages pages at a time, as we get to
+// look at pages in the leaf.
+class CleanPageMap {
+ public:
+  static const int kLeafBits = 15;
+  static const uintptr_t kLeafPages = uintptr_t(1) << kLeafBits;
+
+  CleanPageMap(uintptr_t min_address, uintptr_t max_address, int page_shift)
+    : min_address_(min_address), max_address_(max_address),
+      page_shift_(page_shift), first_page_(min_address >> page_shift),
+      num_leaves_((((max_address >> page_shift) - first_page_)
+                   >> kLeafBits) + 1),
+      allocs_(2) {
+    leaves_ = static_cast<uint8**>(
+        HeapLeakChecker::Allocator::Allocate(num_leaves_ * sizeof(uint8*)));
+    memset(leaves_, 0, num_leaves_ * sizeof(uint8*));
+  }
+  ~CleanPageMap() {
+    for (size_t i = 0; i < num_leaves_; ++i) {
+      HeapLeakChecker::Allocator::Free(leaves_[i]);
+    }
+    HeapLeakChecker::Allocator::Free(leaves_);
+  }
+
+  // Whether we recorded pages for the current heap address range.
+  bool IsFor(uintptr_t min_address, uintptr_t max_address) const {
+    return min_address == min_address_  &&  max_address == max_address_;
+  }
+
+  int page_shift() const { return page_shift_; }
+
+  // Number of Allocator objects we hold (counting ourselves).
+  int allocs() const { return allocs_; }
+
+  // Returns the byte for page number "page", or NULL if it's out of range.
+  // "lock", if not NULL, protects the allocation of new leaves.
+  uint8* Find(uintptr_t page, SpinLock* lock) {
+    if (page < first_page_) return NULL;
+    const uintptr_t leaf = (page - first_page_) >> kLeafBits;
+    if (leaf >= num_leaves_) return NULL;
+    if (leaves_[leaf] == NULL) {
+      if (lock) lock->Lock();
+      if (leaves_[leaf] == NULL) {
+        uint8* bytes = static_cast<uint8*>(
+            HeapLeakChecker::Allocator::Allocate(kLeafPages));
+        memset(bytes, 0, kLeafPages);
+        leaves_[leaf] = bytes;
+        allocs_ += 1;
+      }
+      if (lock) lock->Unlock();
+    }
+    return &leaves_[leaf][(page - first_page_) & (kLeafPages - 1)];
+  }
+
+ private:
+  const uintptr_t min_address_;
+  const uintptr_t max_address_;
+  const int page_shift_;
+  const uintptr_t first_page_;
+  const size_t num_leaves_;
+  uint8** leaves_;
+  int allocs_;
+};
+
+// The pages we found clean at the last check, if we're checking
+// incrementally (protected by our lock)
+static CleanPageMap* clean_pages = NULL;
+
+// Number of Allocator objects in clean_pages.
+static int CleanPageMapAllocs() {
+  return clean_pages ? clean_pages->allocs() : 0;
+}
+
+// Whether the liveness walking we're doing can use and update clean_pages:
+// only done while all threads are stopped (protected by our lock)
+static bool incremental_scan = false;
+
+// Number of pages we skipped in the current check (protected by our lock)
+static int64 skipped_pages_total;
+
+// Prepares clean_pages for a leak check, if we're checking incrementally.
+static void PrepareIncrementalCheckLocked() {
+  RAW_DCHECK(heap_checker_lock.IsHeld(), "");
+  if (!FLAGS_heap_check_incremental  ||  soft_dirty_bits_work < 0) return;
+  if (soft_dirty_bits_work == 0) {
+    // Kernels without soft-dirty bits (or with pagemap hidden from us)
+    // show every page as clean, so see that a page we write shows as dirty.
+    static volatile char probe;
+    pagemap_fd = open("/proc/self/pagemap", O_RDONLY);
+    soft_dirty_bits_work = -1;
+    if (pagemap_fd >= 0  &&  ClearSoftDirtyBits()) {
+      probe = 1;
+      const uintptr_t page =
+        AsInt(const_cast<char*>(&probe)) / getpagesize();
+      if (SoftDirtyReader().IsDirty(page, page)) soft_dirty_bits_work = 1;
+    }
+    if (soft_dirty_bits_work < 0) {
+      RAW_LOG(WARNING, "Soft-dirty bits don't work here: "
+                       "won't do incremental leak checks");
+      if (pagemap_fd >= 0) close(pagemap_fd);
+      pagemap_fd = -1;
+      return;
+    }
+  }
+  if (clean_pages != NULL  &&
+      !clean_pages->IsFor(min_heap_address, max_heap_address)) {
+    RAW_VLOG(11, "Heap address range changed: "
+                 "looking at all pages of heap objects again");
+    HeapLeakChecker::Allocator::DeleteAndNull(&clean_pages);
+  }
+  if (clean_pages == NULL  &&  min_heap_address <= max_heap_address) {
+    int page_shift = 0;
+    while ((1 << page_shift) < getpagesize()) ++page_shift;
+    clean_pages =
+      new(HeapLeakChecker::Allocator::Allocate(sizeof(CleanPageMap)))
+        CleanPageMap(min_heap_address, max_heap_address, page_shift);
+  }
+}
+
 // Ideally to avoid deadlocks this function should not result in any libc
 // or other function calls that might need to lock a mutex:
 // It is called when all threads of a process are stopped
@@ -1025,6 +1228,7 @@ static enum {
   RAW_DCHECK(heap_checker_lock.IsHeld(), "");
   thread_listing_status = CALLBACK_STARTED;
   RAW_VLOG(11, "Found %d threads (from pid %d)", num_threads, getpid());
+  incremental_scan = clean_pages != NULL;
 
   if (FLAGS_heap_check_ignore_global_live) {
     UseProcMapsLocked(RECORD_GLOBAL_DATA);
@@ -1079,6 +1283,15 @@ static enum {
   }
   // Do all other liveness walking while all threads are stopped:
   IgnoreNonThreadLiveObjectsLocked();
+  // The next incremental check looks at what gets written from now on:
+  if (incremental_scan) {
+    incremental_scan = false;
+    if (!ClearSoftDirtyBits()) {
+      RAW_LOG(WARNING, "Can't clear soft-dirty bits: "
+                       "next leak check won't be incremental");
+      Allocator::DeleteAndNull(&clean_pages);
+    }
+  }
   // Can now resume the threads:
   TCMalloc_ResumeAllProcessThreads(num_threads, thread_pids);
   thread_listing_status = CALLBACK_COMPLETED;
@@ -1267,6 +1480,8 @@ void HeapLeakChecker::IgnoreAllLiveObjectsLocked(const void* self_stack_top) {
   // reset the counts
   live_objects_total = 0;
   live_bytes_total = 0;
+  skipped_pages_total = 0;
+  PrepareIncrementalCheckLocked();
   // Reduce max_heap_object_size to FLAGS_heap_check_max_pointer_offset
   // for the time of leak check.
   // FLAGS_heap_check_max_pointer_offset caps max_heap_object_size
@@ -1339,6 +1554,7 @@ void HeapLeakChecker::IgnoreAllLiveObjectsLocked(const void* self_stack_top) {
   // Do all other live data ignoring here if we did not do it
   // within thread listing callback with all threads stopped.
   if (need_to_ignore_non_thread_objects) {
+    incremental_scan = false;
     if (FLAGS_heap_check_ignore_global_live) {
       UseProcMapsLocked(RECORD_GLOBAL_DATA);
     }
@@ -1348,6 +1564,10 @@ void HeapLeakChecker::IgnoreAllLiveObjectsLocked(const void* self_stack_top) {
     RAW_VLOG(10, "Ignoring %" PRId64 " reachable objects of %" PRId64 " bytes",
                 live_objects_total, live_bytes_total);
   }
+  if (skipped_pages_total) {
+    RAW_VLOG(10, "Skipped %" PRId64 " clean pages of heap objects",
+                skipped_pages_total);
+  }
   // Free these: we made them here and heap_profile never saw them
   Allocator::DeleteAndNull(&live_objects);
   Allocator::DeleteAndNull(&stack_tops);
@@ -1362,6 +1582,32 @@ static size_t pointer_source_alignment = kPointerSourceAlignment;
 // to protect pointer_source_alignment.
 static SpinLock alignment_checker_lock(SpinLock::LINKER_INITIALIZED);
 
+// Upper limit for FLAGS_heap_check_scan_threads.
+static const int kMaxScanThreads = 64;
+// Stack size of the threads looking for live objects besides ours.
+static const size_t kScanThreadStackSize = 64 << 10;
+// Large objects get looked at in chunks of this size (by several threads).
+static const size_t kScanChunkSize = 1 << 20;
+
+// Parameters and results of ScanLiveObjectsLocked in one thread.
+struct LiveObjectScan {
+  const char* name2;  // as for IgnoreLiveObjectsLocked
+  bool shared;        // whether other threads are scanning too
+  int64 live_object_count;
+  int64 live_byte_count;
+  int64 skipped_pages;
+  LiveObjectScan()
+    : name2(NULL), shared(false), live_object_count(0), live_byte_count(0),
+      skipped_pages(0) { }
+};
+
+// Protects live_objects, and the live bits of heap_profile, when several
+// threads are in ScanLiveObjectsLocked.
+static SpinLock live_objects_lock(SpinLock::LINKER_INITIALIZED);
+// Number of those threads that are looking at an object
+// (protected by live_objects_lock).
+static int busy_scanners = 0;
+
 // This function changes the live bits in the heap_profile-table's state:
 // we only record the live objects to be skipped.
 //
@@ -1392,9 +1638,114 @@ static SpinLock alignment_checker_lock(SpinLock::LINKER_INITIALIZED);
 /*static*/ void HeapLeakChecker::IgnoreLiveObjectsLocked(const char* name,
                                                          const char* name2) {
   RAW_DCHECK(heap_checker_lock.IsHeld(), "");
+  LiveObjectScan scan[kMaxScanThreads];
+  int num_threads = 1;
+  scan[0].name2 = name2;
+  scan[0].shared = false;
+#ifdef THREADS
+  // Look at large heaps in parallel:
+  // the other threads are clones running in our address space,
+  // like the one TCMalloc_ListAllProcessThreads runs us in.
+  pid_t scan_pids[kMaxScanThreads];
+  char* scan_stacks = NULL;
+  const int want_threads = min(FLAGS_heap_check_scan_threads, kMaxScanThreads);
+  if (want_threads > 1  &&  !live_objects->empty()) {
+    scan_stacks = static_cast<char*>(
+        Allocator::Allocate((want_threads - 1) * kScanThreadStackSize));
+    scan[0].shared = true;
+    RAW_DCHECK(busy_scanners == 0, "");
+    for (; num_threads < want_threads; ++num_threads) {
+      LiveObjectScan* s = &scan[num_threads];
+      s->name2 = name2;
+      s->shared = true;
+      char* stack_top = scan_stacks + num_threads * kScanThreadStackSize;
+      scan_pids[num_threads] =
+        clone(ScanLiveObjectsLocked, stack_top,
+              CLONE_VM|CLONE_FS|CLONE_FILES|CLONE_UNTRACED, s);
+      if (scan_pids[num_threads] < 0) {
+        RAW_VLOG(11, "Could only start %d threads to look for live objects "
+                     "(errno=%d)", num_threads, errno);
+        break;
+      }
+    }
+  }
+#endif
+  ScanLiveObjectsLocked(&scan[0]);
+#ifdef THREADS
+  for (int i = 1; i < num_threads; ++i) {
+    int status = 0;
+    while (waitpid(scan_pids[i], &status, __WALL) < 0) {
+      if (errno != EINTR) break;
+    }
+    if (!WIFEXITED(status)) {
+      RAW_LOG(FATAL, "Thread looking for live objects crashed");
+    }
+  }
+  if (scan_stacks) Allocator::Free(scan_stacks);
+#endif
   int64 live_object_count = 0;
   int64 live_byte_count = 0;
-  while (!live_objects->empty()) {
+  for (int i = 0; i < num_threads; ++i) {
+    live_object_count += scan[i].live_object_count;
+    live_byte_count += scan[i].live_byte_count;
+    skipped_pages_total += scan[i].skipped_pages;
+  }
+  live_objects_total += live_object_count;
+  live_bytes_total += live_byte_count;
+  if (live_object_count) {
+    RAW_VLOG(10, "Removed %" PRId64 " live heap objects of %" PRId64 " bytes: %s%s",
+                live_object_count, live_byte_count, name, name2);
+  }
+}
+
+// Marks the heap object at ptr as live and adds it to live_objects
+// if we haven't done so yet; returns true if we did now.
+static bool MarkLiveLocked(const void* ptr, size_t size, bool shared) {
+  if (shared) live_objects_lock.Lock();
+  const bool marked = heap_profile->MarkAsLive(ptr);
+  if (marked) {
+    live_objects->push_back(AllocObject(ptr, size, IGNORED_ON_HEAP));
+  }
+  if (shared) live_objects_lock.Unlock();
+  return marked;
+}
+
+/*static*/ int HeapLeakChecker::ScanLiveObjectsLocked(void* arg) {
+  LiveObjectScan* scan = static_cast<LiveObjectScan*>(arg);
+  const bool shared = scan->shared;
+  int64 live_object_count = 0;
+  int64 live_byte_count = 0;
+  int64 skipped_pages = 0;
+  // Pages of heap objects can be looked at one at a time, and skipped if
+  // they can't hold heap pointers, when pointers can't straddle two pages:
+  CleanPageMap* const clean_map =
+    incremental_scan  &&  pointer_source_alignment == sizeof(void*)
+    ? clean_pages : NULL;
+  const uintptr_t page_size =
+    clean_map ? uintptr_t(1) << clean_map->page_shift() : 0;
+  // (when "shared", other threads are taking objects off live_objects too,
+  //  so we hold live_objects_lock to touch it, or the live bits of objects,
+  //  and only give up on an empty live_objects once none of them is looking
+  //  at an object, which might lead to more)
+  bool busy = false;
+  while (true) {
+    if (shared) {
+      live_objects_lock.Lock();
+      if (busy) busy_scanners -= 1;
+      while (live_objects->empty()  &&  busy_scanners > 0) {
+        live_objects_lock.Unlock();
+        sched_yield();
+        live_objects_lock.Lock();
+      }
+      busy = !live_objects->empty();
+      if (!busy) {
+        live_objects_lock.Unlock();
+        break;
+      }
+      busy_scanners += 1;
+    } else if (live_objects->empty()) {
+      break;
+    }
     const char* object =
       reinterpret_cast<const char*>(live_objects->back().ptr);
     size_t size = live_objects->back().size;
@@ -1404,6 +1755,7 @@ static SpinLock alignment_checker_lock(SpinLock::LINKER_INITIALIZED);
       live_object_count += 1;
       live_byte_count += size;
     }
+    if (shared) live_objects_lock.Unlock();
     RAW_VLOG(13, "Looking for heap pointers in %p of %" PRIuS " bytes",
                 object, size);
     const char* const whole_object = object;
@@ -1423,7 +1775,7 @@ static SpinLock alignment_checker_lock(SpinLock::LINKER_INITIALIZED);
 #ifdef NO_FRAME_POINTER
     // Frame pointer omission requires us to use libunwind, which uses direct
     // mmap and munmap system calls, and that needs special handling.
-    if (name2 == kUnnamedProcSelfMapEntry) {
+    if (scan->name2 == kUnnamedProcSelfMapEntry) {
       static const uintptr_t page_mask = ~(getpagesize() - 1);
       const uintptr_t addr = reinterpret_cast<uintptr_t>(object);
       if ((addr & page_mask) == 0 && (size & page_mask) == 0) {
@@ -1444,66 +1796,106 @@ static SpinLock alignment_checker_lock(SpinLock::LINKER_INITIALIZED);
     }
 #endif
 
+    // Leave the rest of a large object to whichever thread gets to it first.
+    // Our chunk ends a pointer less a byte after the rest starts,
+    // so that we look at every position in the object exactly once.
+    if (shared  &&  size > kScanChunkSize + sizeof(void*)) {
+      SpinLockHolder l(&live_objects_lock);
+      live_objects->push_back(
+          AllocObject(object + kScanChunkSize, size - kScanChunkSize,
+                      place == MUST_BE_ON_HEAP ? IGNORED_ON_HEAP : place));
+      size = kScanChunkSize + sizeof(void*) - 1;
+    }
+
+    const bool by_page = clean_map != NULL  &&
+                         (place == MUST_BE_ON_HEAP  ||
+                          place == IGNORED_ON_HEAP)  &&
+                         size >= 2 * page_size;
+    SoftDirtyReader soft_dirty;
     const char* const max_object = object + size - sizeof(void*);
     while (object <= max_object) {
-      // potentially unaligned load:
-      const uintptr_t addr = *reinterpret_cast<const uintptr_t*>(object);
-      // Do fast check before the more expensive HaveOnHeapLocked lookup:
-      // this code runs for all memory words that are potentially pointers:
-      const bool can_be_on_heap =
-        // Order tests by the likelyhood of the test failing in 64/32 bit modes.
-        // Yes, this matters: we either lose 5..6% speed in 32 bit mode
-        // (which is already slower) or by a factor of 1.5..1.91 in 64 bit mode.
-        // After the alignment test got dropped the above performance figures
-        // must have changed; might need to revisit this.
+      // Look at the rest of the object, or just (what it has of) the next page
+      const char* last = max_object;
+      uint8* clean = NULL;
+      if (by_page) {
+        const uintptr_t page_start = AsInt(object) & ~(page_size - 1);
+        const uintptr_t page_end = page_start + page_size;
+        if (AsInt(last) > page_end - sizeof(void*)) {
+          last = reinterpret_cast<const char*>(page_end - sizeof(void*));
+        }
+        if (AsInt(object) == page_start  &&
+            AsInt(last) == page_end - sizeof(void*)) {
+          // The object has all of the page:
+          const uintptr_t page = page_start >> clean_map->page_shift();
+          clean = clean_map->Find(page, shared ? &live_objects_lock : NULL);
+          const uintptr_t last_page =
+            (AsInt(max_object) - (page_size - sizeof(void*)))
+            >> clean_map->page_shift();
+          if (clean  &&  *clean  &&  !soft_dirty.IsDirty(page, last_page)) {
+            skipped_pages += 1;
+            object = reinterpret_cast<const char*>(page_end);
+            continue;
+          }
+        }
+      }
+      bool saw_heap_address = false;
+      for (; object <= last; object += pointer_source_alignment) {
+        // potentially unaligned load:
+        const uintptr_t addr = *reinterpret_cast<const uintptr_t*>(object);
+        // Do fast check before the more expensive HaveOnHeapLocked lookup:
+        // this code runs for all memory words that are potentially pointers:
+        const bool can_be_on_heap =
+          // Order tests by the likelyhood of the test failing in 64/32 bit modes.
+          // Yes, this matters: we either lose 5..6% speed in 32 bit mode
+          // (which is already slower) or by a factor of 1.5..1.91 in 64 bit mode.
+          // After the alignment test got dropped the above performance figures
+          // must have changed; might need to revisit this.
 #if defined(__x86_64__)
-        addr <= max_heap_address  &&  // <= is for 0-sized object with max addr
-        min_heap_address <= addr;
+          addr <= max_heap_address  &&  // <= is for 0-sized object with max addr
+          min_heap_address <= addr;
 #else
-        min_heap_address <= addr  &&
-        addr <= max_heap_address;  // <= is for 0-sized object with max addr
+          min_heap_address <= addr  &&
+          addr <= max_heap_address;  // <= is for 0-sized object with max addr
 #endif
-      if (can_be_on_heap) {
-        const void* ptr = reinterpret_cast<const void*>(addr);
-        // Too expensive (inner loop): manually uncomment when debugging:
-        // RAW_VLOG(17, "Trying pointer to %p at %p", ptr, object);
-        size_t object_size;
-        if (HaveOnHeapLocked(&ptr, &object_size)  &&
-            heap_profile->MarkAsLive(ptr)) {
-          // We take the (hopefully low) risk here of encountering by accident
-          // a byte sequence in memory that matches an address of
-          // a heap object which is in fact leaked.
-          // I.e. in very rare and probably not repeatable/lasting cases
-          // we might miss some real heap memory leaks.
-          RAW_VLOG(14, "Found pointer to %p of %" PRIuS " bytes at %p "
-                      "inside %p of size %" PRIuS "",
-                      ptr, object_size, object, whole_object, whole_size);
-          if (VLOG_IS_ON(15)) {
-            // log call stacks to help debug how come something is not a leak
-            HeapProfileTable::AllocInfo alloc;
-            if (!heap_profile->FindAllocDetails(ptr, &alloc)) {
-              RAW_LOG(FATAL, "FindAllocDetails failed on ptr %p", ptr);
-            }
-            RAW_LOG(INFO, "New live %p object's alloc stack:", ptr);
-            for (int i = 0; i < alloc.stack_depth; ++i) {
-              RAW_LOG(INFO, "  @ %p", alloc.call_stack[i]);
+        if (can_be_on_heap) {
+          saw_heap_address = true;
+          const void* ptr = reinterpret_cast<const void*>(addr);
+          // Too expensive (inner loop): manually uncomment when debugging:
+          // RAW_VLOG(17, "Trying pointer to %p at %p", ptr, object);
+          size_t object_size;
+          if (HaveOnHeapLocked(&ptr, &object_size)  &&
+              MarkLiveLocked(ptr, object_size, shared)) {
+            // We take the (hopefully low) risk here of encountering by accident
+            // a byte sequence in memory that matches an address of
+            // a heap object which is in fact leaked.
+            // I.e. in very rare and probably not repeatable/lasting cases
+            // we might miss some real heap memory leaks.
+            RAW_VLOG(14, "Found pointer to %p of %" PRIuS " bytes at %p "
+                        "inside %p of size %" PRIuS "",
+                        ptr, object_size, object, whole_object, whole_size);
+            if (VLOG_IS_ON(15)) {
+              // log call stacks to help debug how come something is not a leak
+              HeapProfileTable::AllocInfo alloc;
+              if (!heap_profile->FindAllocDetails(ptr, &alloc)) {
+                RAW_LOG(FATAL, "FindAllocDetails failed on ptr %p", ptr);
+              }
+              RAW_LOG(INFO, "New live %p object's alloc stack:", ptr);
+              for (int i = 0; i < alloc.stack_depth; ++i) {
+                RAW_LOG(INFO, "  @ %p", alloc.call_stack[i]);
+              }
             }
+            live_object_count += 1;
+            live_byte_count += object_size;
           }
-          live_object_count += 1;
-          live_byte_count += object_size;
-          live_objects->push_back(AllocObject(ptr, object_size,
-                                              IGNORED_ON_HEAP));
         }
       }
-      object += pointer_source_alignment;
+      if (clean) *clean = !saw_heap_address;
     }
   }
-  live_objects_total += live_object_count;
-  live_bytes_total += live_byte_count;
-  if (live_object_count) {
-    RAW_VLOG(10, "Removed %" PRId64 " live heap objects of %" PRId64 " bytes: %s%s",
-                live_object_count, live_byte_count, name, name2);
-  }
+  scan->live_object_count = live_object_count;
+  scan->live_byte_count = live_byte_count;
+  scan->skipped_pages = skipped_pages;
+  return 0;
 }
 
 //----------------------------------------------------------------------
@@ -1751,7 +2143,8 @@ bool HeapLeakChecker::DoNoLeaks(ShouldSymbolize should_symbolize) {
 
     // Keep track of number of internally allocated objects so we
     // can detect leaks in the heap-leak-checket itself
-    const int initial_allocs = Allocator::alloc_count();
+    // (clean_pages is kept from one check to the next, so it doesn't count)
+    const int initial_allocs = Allocator::alloc_count() - CleanPageMapAllocs();
 
     if (name_ == NULL) {
       RAW_LOG(FATAL, "Heap leak checker must not be turned on "
@@ -1779,10 +2172,10 @@ bool HeapLeakChecker::DoNoLeaks(ShouldSymbolize should_symbolize) {
       // path since in the leak path we temporarily release
       // heap_checker_lock and another thread can come in and disturb
       // allocation counts.
-      if (Allocator::alloc_count() != initial_allocs) {
+      const int allocs = Allocator::alloc_count() - CleanPageMapAllocs();
+      if (allocs != initial_allocs) {
         RAW_LOG(FATAL, "Internal HeapChecker leak of %d objects ; %d -> %d",
-                Allocator::alloc_count() - initial_allocs,
-                initial_allocs, Allocator::alloc_count());
+                allocs - initial_allocs, initial_allocs, allocs);
       }
     } else if (FLAGS_heap_check_test_pointer_alignment) {
       if (pointer_source_alignment == 1) {
@@ -2243,6 +2636,7 @@ void HeapLeakChecker::TurnItselfOffLocked() {
     Allocator::DeleteAndNullIfNot(&ignored_objects);
     Allocator::DeleteAndNullIfNot(&disabled_ranges);
     Allocator::DeleteAndNullIfNot(&global_region_caller_ranges);
+    Allocator::DeleteAndNullIfNot(&clean_pages);
     Allocator::Shutdown();
     MemoryRegionMap::Shutdown();
   }
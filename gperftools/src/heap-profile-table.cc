@@ -128,6 +128,7 @@ HeapProfileTable::HeapProfileTable(Allocator alloc,
     : alloc_(alloc),
       dealloc_(dealloc),
       profile_mmap_(profile_mmap),
+      sample_period_(0),
       bucket_table_(NULL),
       num_buckets_(0),
       address_map_(NULL) {
@@ -222,7 +223,7 @@ void HeapProfileTable::RecordAlloc(
   address_map_->Insert(ptr, v);
 }
 
-void HeapProfileTable::RecordFree(const void* ptr) {
+bool HeapProfileTable::RecordFree(const void* ptr) {
   AllocValue v;
   if (address_map_->FindAndRemove(ptr, &v)) {
     Bucket* b = v.bucket();
@@ -230,7 +231,22 @@ void HeapProfileTable::RecordFree(const void* ptr) {
     b->free_size += v.bytes;
     total_.frees++;
     total_.free_size += v.bytes;
+    return true;
   }
+  return false;
+}
+
+void HeapProfileTable::RecordFreedAlloc(
+    size_t bytes, int stack_depth, const void* const call_stack[]) {
+  Bucket* b = GetBucket(stack_depth, call_stack);
+  b->allocs++;
+  b->alloc_size += bytes;
+  b->frees++;
+  b->free_size += bytes;
+  total_.allocs++;
+  total_.alloc_size += bytes;
+  total_.frees++;
+  total_.free_size += bytes;
 }
 
 bool HeapProfileTable::FindAlloc(const void* ptr, size_t* object_size) const {
@@ -363,13 +379,11 @@ int HeapProfileTable::FillOrderedProfile(char buf[], int size) const {
 
   Stats stats;
   memset(&stats, 0, sizeof(stats));
-  int bucket_length = snprintf(buf, size, "%s", kProfileHeader);
-  if (bucket_length < 0 || bucket_length >= size) {
+  int bucket_length = FillProfileHeader(buf, size, &stats);
+  if (bucket_length == 0) {
       dealloc_(list);
       return 0;
   }
-  bucket_length = UnparseBucket(total_, buf, bucket_length, size,
-                                " heapprofile", &stats);
 
   // Dump the mmap list first.
   if (profile_mmap_) {
@@ -392,11 +406,59 @@ int HeapProfileTable::FillOrderedProfile(char buf[], int size) const {
   return bucket_length + map_length;
 }
 
+// A bucket's line is at most this long (with kMaxStackDepth frames).
+static const int kMaxBucketLineLength = 1024;
+
+void HeapProfileTable::DumpOrderedProfile(RawFD fd, char buf[],
+                                          int size) const {
+  RAW_DCHECK(size >= 4 * kMaxBucketLineLength, "");
+  Bucket** list = MakeSortedBucketList();
+
+  BufferArgs buffer(buf, FillProfileHeader(buf, size, NULL), size, fd);
+  if (profile_mmap_) {
+    MemoryRegionMap::IterateBuckets<BufferArgs*>(DumpBucketIterator, &buffer);
+  }
+  for (int i = 0; i < num_buckets_; i++) {
+    DumpBucketIterator(list[i], &buffer);
+  }
+  FlushBuffer(&buffer, true);
+
+  dealloc_(list);
+
+  RawWrite(fd, kProcSelfMapsHeader, strlen(kProcSelfMapsHeader));
+  DumpProcSelfMaps(fd);
+}
+
+int HeapProfileTable::FillProfileHeader(char buf[], int size,
+                                        Stats* profile_stats) const {
+  int length = snprintf(buf, size, "%s", kProfileHeader);
+  if (length < 0 || length >= size) return 0;
+  char profile_type[64];
+  if (sample_period_ > 0) {
+    snprintf(profile_type, sizeof(profile_type), " heap_v2/%" PRId64,
+             sample_period_);
+  } else {
+    snprintf(profile_type, sizeof(profile_type), " heapprofile");
+  }
+  return UnparseBucket(total_, buf, length, size, profile_type,
+                       profile_stats);
+}
+
+// static
+void HeapProfileTable::FlushBuffer(BufferArgs* args, bool all) {
+  if (args->fd == kIllegalRawFD) return;
+  if (all || args->buflen > args->bufsize - kMaxBucketLineLength) {
+    RawWrite(args->fd, args->buf, args->buflen);
+    args->buflen = 0;
+  }
+}
+
 // static
 void HeapProfileTable::DumpBucketIterator(const Bucket* bucket,
                                           BufferArgs* args) {
   args->buflen = UnparseBucket(*bucket, args->buf, args->buflen, args->bufsize,
                                "", NULL);
+  FlushBuffer(args, false);
 }
 
 inline
@@ -104,7 +104,13 @@ class HeapProfileTable {
                    int stack_depth, const void* const call_stack[]);
 
   // Record the deallocation of memory at 'ptr'.
-  void RecordFree(const void* ptr);
+  // Returns false if we have no allocation recorded at 'ptr'.
+  bool RecordFree(const void* ptr);
+
+  // Record an allocation of 'bytes' bytes, like RecordAlloc, which has
+  // been freed again since (so it's only counted in the stats).
+  void RecordFreedAlloc(size_t bytes,
+                        int stack_depth, const void* const call_stack[]);
 
   // Return true iff we have recorded an allocation at 'ptr'.
   // If yes, fill *object_size with the allocation byte size.
@@ -158,6 +164,17 @@ class HeapProfileTable {
   // We do not provision for 0-terminating 'buf'.
   int FillOrderedProfile(char buf[], int size) const;
 
+  // Same as FillOrderedProfile, but writes the profile to 'fd' as it
+  // goes, using 'buf' (of at least 4KB) only as scratch space.  So the
+  // profile is never cut short, and we don't need memory for all of it.
+  void DumpOrderedProfile(RawFD fd, char buf[], int size) const;
+
+  // Mark the profile as holding only objects sampled once per "period"
+  // bytes on average, so FillOrderedProfile writes a "heap_v2" header
+  // that lets pprof scale the samples back up.  0 (the default) means
+  // every allocation is recorded.
+  void set_sample_period(int64 period) { sample_period_ = period; }
+
   // Cleanup any old profile files matching prefix + ".*" + kFileExt.
   static void CleanupOldProfiles(const char* prefix);
 
@@ -225,15 +242,18 @@ class HeapProfileTable {
 
   // Arguments that need to be passed DumpBucketIterator callback below.
   struct BufferArgs {
-    BufferArgs(char* buf_arg, int buflen_arg, int bufsize_arg)
+    BufferArgs(char* buf_arg, int buflen_arg, int bufsize_arg,
+               RawFD fd_arg = kIllegalRawFD)
         : buf(buf_arg),
           buflen(buflen_arg),
-          bufsize(bufsize_arg) {
+          bufsize(bufsize_arg),
+          fd(fd_arg) {
     }
 
     char* buf;
     int buflen;
     int bufsize;
+    RawFD fd;  // if set, where to write buf out to whenever it fills up
 
     DISALLOW_COPY_AND_ASSIGN(BufferArgs);
   };
@@ -288,6 +308,14 @@ class HeapProfileTable {
   inline static void DumpBucketIterator(const Bucket* bucket,
                                         BufferArgs* args);
 
+  // Helper for DumpOrderedProfile: writes args->buf out to args->fd
+  // unless it still has room for another bucket (or "all" is true).
+  static void FlushBuffer(BufferArgs* args, bool all);
+
+  // Helper for FillOrderedProfile and DumpOrderedProfile: prints the
+  // profile header and our totals line into 'buf'.
+  int FillProfileHeader(char buf[], int size, Stats* profile_stats) const;
+
   // Helper for DumpNonLiveProfile to do object-granularity
   // heap profile dumping. It gets passed to AllocationMap::Iterate.
   inline static void DumpNonLiveIterator(const void* ptr, AllocValue* v,
@@ -331,6 +359,9 @@ class HeapProfileTable {
 
   bool profile_mmap_;
 
+  // See set_sample_period().
+  int64 sample_period_;
+
   // Bucket hash table for malloc.
   // We hand-craft one instead of using one of the pre-written
   // ones because we do not want to use malloc when operating on the table.
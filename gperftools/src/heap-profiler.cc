@@ -53,6 +53,7 @@
 #include <assert.h>
 #include <sys/types.h>
 #include <signal.h>
+#include <math.h>
 
 #include <algorithm>
 #include <string>
@@ -72,6 +73,7 @@
 #include "base/sysinfo.h"      // for GetUniquePathFromEnv()
 #include "heap-profile-table.h"
 #include "memory_region_map.h"
+#include "static_vars.h"       // for Static::set_sampled_hooks()
 
 
 #ifndef	PATH_MAX
@@ -123,7 +125,18 @@ DEFINE_bool(only_mmap_profile,
             EnvToBool("HEAP_PROFILE_ONLY_MMAP", false),
             "If heap-profiling is on, only profile mmap, mremap, and sbrk; "
             "do not profile malloc/new/etc");
-
+DEFINE_bool(heap_profile_sampled,
+            EnvToBool("HEAP_PROFILE_SAMPLED", false),
+            "If heap-profiling is on, record only the allocations tcmalloc "
+            "samples (see TCMALLOC_SAMPLE_PARAMETER) instead of hooking "
+            "every malloc/new/etc");
+DEFINE_bool(heap_profile_buffered,
+            EnvToBool("HEAP_PROFILE_BUFFERED", false),
+            "If heap-profiling is on, keep new allocations in small "
+            "per-thread buffers and move them into the profile in batches, "
+            "instead of taking a global lock for every malloc/new/etc");
+
+DECLARE_int64(tcmalloc_sample_parameter);
 
 //----------------------------------------------------------------------
 // Locking
@@ -178,10 +191,23 @@ static int64 last_dump_time = 0;      // The time of the last dump
 
 static HeapProfileTable* heap_profile = NULL;  // the heap profile table
 
+// In sampled mode the table holds only sampled objects, so the dump
+// intervals are driven by these estimates of the unsampled totals.
+static bool   sampled = false;          // Recording only sampled objects
+static int64  sample_period = 0;        // tcmalloc's sampling period
+static double sampled_alloc_size = 0;   // Estimated bytes allocated
+static double sampled_free_size = 0;    // Estimated bytes freed
+
+// Whether allocations go through the buffers below first.
+static bool buffered = false;
+
 //----------------------------------------------------------------------
 // Profile generation
 //----------------------------------------------------------------------
 
+// defined below
+static void EmptyAllocBuffersLocked(bool flush);
+
 // Input must be a buffer of size at least 1MB.
 static char* DoGetHeapProfileLocked(char* buf, int buflen) {
   // We used to be smarter about estimating the required memory and
@@ -192,6 +218,7 @@ static char* DoGetHeapProfileLocked(char* buf, int buflen) {
   RAW_DCHECK(heap_lock.IsHeld(), "");
   int bytes_written = 0;
   if (is_on) {
+    if (buffered) EmptyAllocBuffersLocked(true);
     HeapProfileTable::Stats const stats = heap_profile->total();
     (void)stats;   // avoid an unused-variable warning in non-debug mode.
     bytes_written = heap_profile->FillOrderedProfile(buf, buflen - 1);
@@ -252,9 +279,11 @@ static void DumpProfileLocked(const char* reason) {
         reinterpret_cast<char*>(ProfilerMalloc(kProfileBufferSize));
   }
 
-  char* profile = DoGetHeapProfileLocked(global_profiler_buffer,
-                                         kProfileBufferSize);
-  RawWrite(fd, profile, strlen(profile));
+  // Write the profile out as we go, so it isn't limited by the size of
+  // our buffer.
+  if (buffered) EmptyAllocBuffersLocked(true);
+  heap_profile->DumpOrderedProfile(fd, global_profiler_buffer,
+                                   kProfileBufferSize);
   RawClose(fd);
 
   dumping = false;
@@ -264,11 +293,22 @@ static void DumpProfileLocked(const char* reason) {
 // Profile collection
 //----------------------------------------------------------------------
 
+// Return the profile's totals, scaled up to the whole heap in sampled
+// mode.
+static HeapProfileTable::Stats TotalLocked() {
+  HeapProfileTable::Stats total = heap_profile->total();
+  if (sampled) {
+    total.alloc_size = static_cast<int64>(sampled_alloc_size);
+    total.free_size = static_cast<int64>(sampled_free_size);
+  }
+  return total;
+}
+
 // Dump a profile after either an allocation or deallocation, if
 // the memory use has changed enough since the last dump.
 static void MaybeDumpProfileLocked() {
   if (!dumping) {
-    const HeapProfileTable::Stats& total = heap_profile->total();
+    const HeapProfileTable::Stats total = TotalLocked();
     const int64 inuse_bytes = total.alloc_size - total.free_size;
     bool need_to_dump = false;
     char buf[128];
@@ -312,6 +352,145 @@ static void MaybeDumpProfileLocked() {
   }
 }
 
+//----------------------------------------------------------------------
+// Buffered recording
+//----------------------------------------------------------------------
+
+// In buffered mode new allocations are kept in one of kAllocBuffers small
+// buffers, picked by the address of the allocating thread's stack (so
+// that each thread mostly has a buffer to itself), and moved into
+// heap_profile in a batch under heap_lock when their buffer fills up.
+// Objects freed while still in the freeing thread's buffer are just
+// marked as freed there, so short-lived objects never take heap_lock.
+// Other frees take heap_lock as before, and look in all the buffers
+// if heap_profile doesn't know about the object yet.
+//
+// Profiles flush all the buffers first; the dump interval checks only
+// see what's been moved into heap_profile so far.
+// Lock ordering: heap_lock, then AllocBuffer::lock.
+
+static const int kAllocBuffers = 16;
+static const int kAllocBufferSize = 32;
+
+struct BufferedAlloc {
+  const void* ptr;
+  size_t bytes;
+  bool freed;
+  int depth;
+  void* stack[HeapProfileTable::kMaxStackDepth];
+};
+
+struct AllocBuffer {
+  // Used from our hooks at any time, so nothing's initialized here.
+  AllocBuffer() : lock(base::LINKER_INITIALIZED) { }
+
+  SpinLock lock;
+  int count;
+  BufferedAlloc allocs[kAllocBufferSize];
+};
+
+static AllocBuffer alloc_buffers[kAllocBuffers];
+
+// The buffer for the thread whose stack holds "local".
+static AllocBuffer* AllocBufferFor(const void* local) {
+  // Thread stacks are at least a few pages apart.
+  uint64 h = reinterpret_cast<uintptr_t>(local) >> 16;
+  h *= 0x9E3779B97F4A7C15ULL;
+  return &alloc_buffers[(h >> 32) % kAllocBuffers];
+}
+
+// Marks the allocation at "ptr" in "buffer" as freed.  Returns false if
+// it's not there.
+static bool MarkBufferedFree(AllocBuffer* buffer, const void* ptr) {
+  // Search backwards: the newest objects are the most likely to go.
+  for (int i = buffer->count - 1; i >= 0; --i) {
+    BufferedAlloc* a = &buffer->allocs[i];
+    if (a->ptr == ptr && !a->freed) {
+      a->freed = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Moves the contents of "buffer" into heap_profile.
+static void FlushAllocBufferLocked(AllocBuffer* buffer) {
+  RAW_DCHECK(heap_lock.IsHeld(), "");
+  for (int i = 0; i < buffer->count; ++i) {
+    const BufferedAlloc& a = buffer->allocs[i];
+    if (a.freed) {
+      heap_profile->RecordFreedAlloc(a.bytes, a.depth, a.stack);
+    } else {
+      heap_profile->RecordAlloc(a.ptr, a.bytes, a.depth, a.stack);
+    }
+  }
+  buffer->count = 0;
+}
+
+// Moves the contents of all the buffers into heap_profile if "flush",
+// or drops it.
+static void EmptyAllocBuffersLocked(bool flush) {
+  RAW_DCHECK(heap_lock.IsHeld(), "");
+  for (int i = 0; i < kAllocBuffers; ++i) {
+    SpinLockHolder l(&alloc_buffers[i].lock);
+    if (flush) {
+      FlushAllocBufferLocked(&alloc_buffers[i]);
+    } else {
+      alloc_buffers[i].count = 0;
+    }
+  }
+}
+
+// Record an allocation in a buffer.
+static void RecordBufferedAlloc(const void* ptr, size_t bytes,
+                                int skip_count) {
+  // Take the stack trace outside the critical section.
+  BufferedAlloc a;
+  a.ptr = ptr;
+  a.bytes = bytes;
+  a.freed = false;
+  a.depth = HeapProfileTable::GetCallerStackTrace(skip_count + 1, a.stack);
+  AllocBuffer* buffer = AllocBufferFor(&a);
+  {
+    SpinLockHolder l(&buffer->lock);
+    if (buffer->count < kAllocBufferSize) {
+      buffer->allocs[buffer->count++] = a;
+      return;
+    }
+  }
+  // It's full: move it all into the profile.
+  SpinLockHolder l(&heap_lock);
+  if (is_on) {
+    {
+      SpinLockHolder bl(&buffer->lock);
+      FlushAllocBufferLocked(buffer);
+      buffer->allocs[buffer->count++] = a;
+    }
+    MaybeDumpProfileLocked();
+  }
+}
+
+// Record a deallocation in buffered mode.
+static void RecordBufferedFree(const void* ptr) {
+  AllocBuffer* buffer = AllocBufferFor(&ptr);
+  {
+    SpinLockHolder l(&buffer->lock);
+    if (MarkBufferedFree(buffer, ptr)) return;
+  }
+  SpinLockHolder l(&heap_lock);
+  if (is_on) {
+    // Objects only move from the buffers to heap_profile under heap_lock,
+    // so if it's not in heap_profile it's in some buffer (or unknown).
+    if (!heap_profile->RecordFree(ptr)) {
+      for (int i = 0; i < kAllocBuffers; ++i) {
+        SpinLockHolder bl(&alloc_buffers[i].lock);
+        if (MarkBufferedFree(&alloc_buffers[i], ptr)) break;
+      }
+    }
+    MaybeDumpProfileLocked();
+  }
+}
+
 // Record an allocation in the profile.
 static void RecordAlloc(const void* ptr, size_t bytes, int skip_count) {
   // Take the stack trace outside the critical section.
@@ -333,18 +512,58 @@ static void RecordFree(const void* ptr) {
   }
 }
 
+// The expected number of bytes allocated per sampled object of "bytes"
+// bytes: tcmalloc samples such an object with probability
+// 1 - exp(-bytes/period).
+static double SampleWeight(size_t bytes) {
+  return bytes / -expm1(-(bytes / static_cast<double>(sample_period)));
+}
+
+// Record a sampled allocation in the profile.  tcmalloc has already
+// taken the stack trace.
+static void RecordSampledAlloc(const void* ptr,
+                               const tcmalloc::StackTrace& stack) {
+  SpinLockHolder l(&heap_lock);
+  if (is_on && sampled) {
+    heap_profile->RecordAlloc(ptr, stack.size, stack.depth, stack.stack);
+    sampled_alloc_size += SampleWeight(stack.size);
+    MaybeDumpProfileLocked();
+  }
+}
+
+// Record a sampled deallocation in the profile.
+static void RecordSampledFree(const void* ptr) {
+  SpinLockHolder l(&heap_lock);
+  size_t bytes;
+  if (is_on && sampled && heap_profile->FindAlloc(ptr, &bytes)) {
+    heap_profile->RecordFree(ptr);
+    sampled_free_size += SampleWeight(bytes);
+    MaybeDumpProfileLocked();
+  }
+}
+
 //----------------------------------------------------------------------
 // Allocation/deallocation hooks for MallocHook
 //----------------------------------------------------------------------
 
 // static
 void NewHook(const void* ptr, size_t size) {
-  if (ptr != NULL) RecordAlloc(ptr, size, 0);
+  if (ptr == NULL) return;
+  if (buffered) {
+    RecordBufferedAlloc(ptr, size, 0);
+  } else {
+    RecordAlloc(ptr, size, 0);
+  }
 }
 
 // static
 void DeleteHook(const void* ptr) {
-  if (ptr != NULL) RecordFree(ptr);
+  if (ptr == NULL) return;
+  if (buffered) {
+    RecordBufferedFree(ptr);
+  } else {
+    RecordFree(ptr);
+  }
 }
 
 // TODO(jandrews): Re-enable stack tracing
@@ -461,6 +680,27 @@ extern "C" void HeapProfilerStart(const char* prefix) {
   heap_profile = new(ProfilerMalloc(sizeof(HeapProfileTable)))
       HeapProfileTable(ProfilerMalloc, ProfilerFree, FLAGS_mmap_profile);
 
+  // When we start from HeapProfilerInit, tcmalloc's flag may not have
+  // been initialized yet.
+  sample_period = FLAGS_tcmalloc_sample_parameter;
+  if (sample_period == 0) {
+    sample_period = EnvToInt64("TCMALLOC_SAMPLE_PARAMETER", 0);
+  }
+  sampled = FLAGS_heap_profile_sampled && !FLAGS_only_mmap_profile;
+  if (sampled && (sample_period <= 0 || FLAGS_mmap_profile)) {
+    RAW_LOG(WARNING, "HeapProfiler: HEAP_PROFILE_SAMPLED needs tcmalloc "
+            "sampling and no mmap profiling; hooking every allocation");
+    sampled = false;
+  }
+  if (sampled) {
+    heap_profile->set_sample_period(sample_period);
+  }
+  buffered = FLAGS_heap_profile_buffered && !sampled &&
+             !FLAGS_only_mmap_profile;
+  EmptyAllocBuffersLocked(false);  // from before the last HeapProfilerStop
+  sampled_alloc_size = 0;
+  sampled_free_size = 0;
+
   last_dump_alloc = 0;
   last_dump_free = 0;
   high_water_mark = 0;
@@ -470,7 +710,11 @@ extern "C" void HeapProfilerStart(const char* prefix) {
   // HeapProfilerStart/HeapProfileStop, we will get a continuous
   // sequence of profiles.
 
-  if (FLAGS_only_mmap_profile == false) {
+  if (sampled) {
+    // Have tcmalloc tell us about the objects it samples.
+    tcmalloc::Static::set_sampled_hooks(&RecordSampledAlloc,
+                                        &RecordSampledFree);
+  } else if (FLAGS_only_mmap_profile == false) {
     // Now set the hooks that capture new/delete and malloc/free.
     RAW_CHECK(MallocHook::AddNewHook(&NewHook), "");
     RAW_CHECK(MallocHook::AddDeleteHook(&DeleteHook), "");
@@ -494,7 +738,9 @@ extern "C" void HeapProfilerStop() {
 
   if (!is_on) return;
 
-  if (FLAGS_only_mmap_profile == false) {
+  if (sampled) {
+    tcmalloc::Static::set_sampled_hooks(NULL, NULL);
+  } else if (FLAGS_only_mmap_profile == false) {
     // Unset our new/delete hooks, checking they were set:
     RAW_CHECK(MallocHook::RemoveNewHook(&NewHook), "");
     RAW_CHECK(MallocHook::RemoveDeleteHook(&DeleteHook), "");
@@ -594,7 +840,7 @@ struct HeapProfileEndWriter {
   ~HeapProfileEndWriter() {
     char buf[128];
     if (heap_profile) {
-      const HeapProfileTable::Stats& total = heap_profile->total();
+      const HeapProfileTable::Stats total = TotalLocked();
       const int64 inuse_bytes = total.alloc_size - total.free_size;
 
       if ((inuse_bytes >> 20) > 0) {
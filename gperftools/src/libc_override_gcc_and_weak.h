@@ -70,6 +70,12 @@ void operator delete(void* p, const std::nothrow_t& nt) __THROW
     ALIAS(tc_delete_nothrow);
 void operator delete[](void* p, const std::nothrow_t& nt) __THROW
     ALIAS(tc_deletearray_nothrow);
+// C++14 sized deallocation; compilers call these when
+// -fsized-deallocation is on (the default for g++ in C++14 mode).
+void operator delete(void* p, size_t size) __THROW
+    ALIAS(tc_delete_sized);
+void operator delete[](void* p, size_t size) __THROW
+    ALIAS(tc_deletearray_sized);
 
 extern "C" {
   void* malloc(size_t size) __THROW               ALIAS(tc_malloc);
@@ -106,6 +106,11 @@ void MallocExtension::Initialize() {
 
 // SysAllocator implementation
 SysAllocator::~SysAllocator() {}
+void* SysAllocator::AllocMaybeZeroed(size_t size, size_t *actual_size,
+                                     size_t alignment, bool* zeroed) {
+  *zeroed = false;
+  return Alloc(size, actual_size, alignment);
+}
 
 // Default implementation -- does nothing
 MallocExtension::~MallocExtension() { }
@@ -151,6 +156,10 @@ void MallocExtension::MarkThreadBusy() {
   // Default implementation does nothing
 }
 
+void MallocExtension::ZeroThreadFreeMemory() {
+  // Default implementation does nothing
+}
+
 SysAllocator* MallocExtension::GetSystemAllocator() {
   return NULL;
 }
@@ -364,6 +373,7 @@ C_SHIM(SetNumericProperty, int,
        (const char* property, size_t value), (property, value));
 
 C_SHIM(MarkThreadIdle, void, (void), ());
+C_SHIM(ZeroThreadFreeMemory, void, (void), ());
 C_SHIM(MarkThreadBusy, void, (void), ());
 C_SHIM(ReleaseFreeMemory, void, (void), ());
 C_SHIM(ReleaseToSystem, void, (size_t num_bytes), (num_bytes));
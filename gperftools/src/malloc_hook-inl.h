@@ -120,10 +120,15 @@ inline MallocHook::NewHook MallocHook::GetNewHook() {
   return base::internal::new_hooks_.GetSingular();
 }
 
+// Set NO_TCMALLOC_MALLOC_HOOKS (--disable-malloc-hooks) to leave the
+// checks for new and delete hooks out of every allocation and deallocation
+// altogether; those hooks can't be added then (see malloc_hook.cc).
 inline void MallocHook::InvokeNewHook(const void* p, size_t s) {
+#ifndef NO_TCMALLOC_MALLOC_HOOKS
   if (!base::internal::new_hooks_.empty()) {
     InvokeNewHookSlow(p, s);
   }
+#endif
 }
 
 // The following method is DEPRECATED
@@ -132,9 +137,11 @@ inline MallocHook::DeleteHook MallocHook::GetDeleteHook() {
 }
 
 inline void MallocHook::InvokeDeleteHook(const void* p) {
+#ifndef NO_TCMALLOC_MALLOC_HOOKS
   if (!base::internal::delete_hooks_.empty()) {
     InvokeDeleteHookSlow(p);
   }
+#endif
 }
 
 // The following method is DEPRECATED
@@ -295,7 +295,12 @@ using base::internal::sbrk_hooks_;
 extern "C"
 int MallocHook_AddNewHook(MallocHook_NewHook hook) {
   RAW_VLOG(10, "AddNewHook(%p)", hook);
+#ifdef NO_TCMALLOC_MALLOC_HOOKS
+  // (it would never be called)
+  return 0;
+#else
   return new_hooks_.Add(hook);
+#endif
 }
 
 extern "C"
@@ -307,7 +312,11 @@ int MallocHook_RemoveNewHook(MallocHook_NewHook hook) {
 extern "C"
 int MallocHook_AddDeleteHook(MallocHook_DeleteHook hook) {
   RAW_VLOG(10, "AddDeleteHook(%p)", hook);
+#ifdef NO_TCMALLOC_MALLOC_HOOKS
+  return 0;
+#else
   return delete_hooks_.Add(hook);
+#endif
 }
 
 extern "C"
@@ -423,13 +432,21 @@ int MallocHook_RemoveSbrkHook(MallocHook_SbrkHook hook) {
 extern "C"
 MallocHook_NewHook MallocHook_SetNewHook(MallocHook_NewHook hook) {
   RAW_VLOG(10, "SetNewHook(%p)", hook);
+#ifdef NO_TCMALLOC_MALLOC_HOOKS
+  return NULL;
+#else
   return new_hooks_.ExchangeSingular(hook);
+#endif
 }
 
 extern "C"
 MallocHook_DeleteHook MallocHook_SetDeleteHook(MallocHook_DeleteHook hook) {
   RAW_VLOG(10, "SetDeleteHook(%p)", hook);
+#ifdef NO_TCMALLOC_MALLOC_HOOKS
+  return NULL;
+#else
   return delete_hooks_.ExchangeSingular(hook);
+#endif
 }
 
 extern "C"
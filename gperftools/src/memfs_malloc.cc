@@ -52,6 +52,7 @@
 #include <sys/mman.h>                   // for mmap, MAP_FAILED, etc
 #include <sys/statfs.h>                 // for fstatfs, statfs
 #include <unistd.h>                     // for ftruncate, off_t, unlink
+#include <limits>                       // for numeric_limits
 #include <new>                          // for operator new
 #include <string>
 
@@ -60,6 +61,7 @@
 #include "base/googleinit.h"
 #include "base/sysinfo.h"
 #include "internal_logging.h"
+#include "system-alloc.h"
 
 // TODO(sanjay): Move the code below into the tcmalloc namespace
 using tcmalloc::kLog;
@@ -86,6 +88,9 @@ DEFINE_bool(memfs_malloc_map_private,
             EnvToBool("TCMALLOC_MEMFS_MAP_PRIVATE", false),
 	    "Use MAP_PRIVATE with mmap");
 
+// f_type of a hugetlbfs mount (HUGETLBFS_MAGIC in <linux/magic.h>)
+static const long kHugetlbfsMagic = 0x958458f6;
+
 // Hugetlbfs based allocator for tcmalloc
 class HugetlbSysAllocator: public SysAllocator {
 public:
@@ -98,6 +103,8 @@ public:
   }
 
   void* Alloc(size_t size, size_t *actual_size, size_t alignment);
+  void* AllocMaybeZeroed(size_t size, size_t *actual_size, size_t alignment,
+                         bool* zeroed);
   bool Initialize();
 
   bool failed_;          // Whether failed to allocate memory.
@@ -117,14 +124,20 @@ static char hugetlb_space[sizeof(HugetlbSysAllocator)];
 // us with an internal lock held (see tcmalloc/system-alloc.cc).
 void* HugetlbSysAllocator::Alloc(size_t size, size_t *actual_size,
                                  size_t alignment) {
+  bool zeroed;
+  return AllocMaybeZeroed(size, actual_size, alignment, &zeroed);
+}
+
+void* HugetlbSysAllocator::AllocMaybeZeroed(size_t size, size_t *actual_size,
+                                            size_t alignment, bool* zeroed) {
   if (failed_) {
-    return fallback_->Alloc(size, actual_size, alignment);
+    return fallback_->AllocMaybeZeroed(size, actual_size, alignment, zeroed);
   }
 
   // We don't respond to allocation requests smaller than big_page_size_ unless
   // the caller is ok to take more than they asked for. Used by MetaDataAlloc.
   if (actual_size == NULL && size < big_page_size_) {
-    return fallback_->Alloc(size, actual_size, alignment);
+    return fallback_->AllocMaybeZeroed(size, actual_size, alignment, zeroed);
   }
 
   // Enforce huge page alignment.  Be careful to deal with overflow.
@@ -133,11 +146,13 @@ void* HugetlbSysAllocator::Alloc(size_t size, size_t *actual_size,
   size_t aligned_size = ((size + new_alignment - 1) /
                          new_alignment) * new_alignment;
   if (aligned_size < size) {
-    return fallback_->Alloc(size, actual_size, alignment);
+    return fallback_->AllocMaybeZeroed(size, actual_size, alignment, zeroed);
   }
 
   void* result = AllocInternal(aligned_size, actual_size, new_alignment);
   if (result != NULL) {
+    // (AllocInternal() maps a part of the file that was never used before)
+    *zeroed = true;
     return result;
   }
   Log(kLog, __FILE__, __LINE__,
@@ -146,7 +161,7 @@ void* HugetlbSysAllocator::Alloc(size_t size, size_t *actual_size,
     Log(kCrash, __FILE__, __LINE__,
         "memfs_malloc_abort_on_fail is set");
   }
-  return fallback_->Alloc(size, actual_size, alignment);
+  return fallback_->AllocMaybeZeroed(size, actual_size, alignment, zeroed);
 }
 
 void* HugetlbSysAllocator::AllocInternal(size_t size, size_t* actual_size,
@@ -157,6 +172,13 @@ void* HugetlbSysAllocator::AllocInternal(size_t size, size_t* actual_size,
     extra = alignment - big_page_size_;
   }
 
+  // The file can't grow past the largest off_t (and a bigger size would
+  // truncate it instead, below, under pages already handed out).
+  if (size + extra >
+      static_cast<size_t>(std::numeric_limits<off_t>::max() - hugetlb_base_)) {
+    return NULL;
+  }
+
   // Test if this allocation would put us over the limit.
   off_t limit = FLAGS_memfs_malloc_limit_mb*1024*1024;
   if (limit > 0 && hugetlb_base_ + size + extra > limit) {
@@ -249,6 +271,16 @@ bool HugetlbSysAllocator::Initialize() {
   }
   int64 page_size = sfs.f_bsize;
 
+  // Every Alloc() maps a part of the file that was never used before, and
+  // so reads as zero, as tcmalloc expects of new memory.  But its pages
+  // can't be given back by madvise(): hugetlbfs doesn't split huge pages
+  // (or support MADV_DONTNEED at all, on older kernels), and shared pages
+  // of the file would keep their contents, so tcmalloc must zero free
+  // memory itself rather than count on released pages reading as zero.
+  if (sfs.f_type == kHugetlbfsMagic || !FLAGS_memfs_malloc_map_private) {
+    TCMalloc_SystemSetReleaseInPlace();
+  }
+
   hugetlb_fd_ = hugetlb_fd;
   big_page_size_ = page_size;
   failed_ = false;
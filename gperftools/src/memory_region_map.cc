@@ -120,9 +120,11 @@
 
 #include "memory_region_map.h"
 
+#include "base/atomicops.h"
 #include "base/googleinit.h"
 #include "base/logging.h"
 #include "base/low_level_alloc.h"
+#include "base/spinlock_internal.h"
 #include "malloc_hook-inl.h"
 
 #include <gperftools/stacktrace.h>
@@ -283,6 +285,56 @@ bool MemoryRegionMap::IsRecordingLocked() {
   return client_count_ > 0;
 }
 
+// ========================================================================= //
+
+// Records of mmap/munmap/etc. calls that our hooks saw while another
+// thread held lock_.  Instead of waiting for that thread to finish, the
+// hooks put them here, and the next thread to take lock_ (which may be
+// the one holding it now) applies them in order from TookLock().  This
+// keeps threads that mmap a lot (e.g. with tcmalloc's decommits or JITs)
+// from being serialized on lock_ by each other's bookkeeping.
+//
+// Any number of threads add records, only lock_'s holder takes them:
+// a record is added by reserving slot pending_tail (by CAS), filling it
+// in and then marking it kPendingReady, and taken by waiting for the
+// slot at pending_head to be ready, applying it, marking it kPendingFree
+// and advancing pending_head.  If the queue is full, hooks just wait
+// for lock_ as before.
+
+static const int kPendingRecords = 64;
+
+enum PendingState { kPendingFree = 0, kPendingWriting, kPendingReady };
+
+struct PendingRecord {
+  Atomic32 state;       // a PendingState
+  bool is_addition;     // else a removal of region.start_addr..end_addr
+  MemoryRegionMap::Region region;  // (with call stack for additions)
+};
+
+static PendingRecord pending_records[kPendingRecords];
+static Atomic32 pending_head = 0;  // next record to apply (lock_'s holder)
+static Atomic32 pending_tail = 0;  // next slot to reserve
+
+// Queues the record for a hook which could not get lock_ right away.
+// Returns false if the queue is full.
+static bool AddPendingRecord(bool is_addition,
+                             const MemoryRegionMap::Region& region) {
+  Atomic32 tail;
+  do {
+    tail = base::subtle::NoBarrier_Load(&pending_tail);
+    const Atomic32 head = base::subtle::Acquire_Load(&pending_head);
+    if (static_cast<uint32>(tail - head) >= kPendingRecords) return false;
+  } while (base::subtle::Acquire_CompareAndSwap(&pending_tail, tail, tail + 1)
+           != tail);
+  PendingRecord* r = &pending_records[static_cast<uint32>(tail) %
+                                      kPendingRecords];
+  base::subtle::NoBarrier_Store(&r->state, kPendingWriting);
+  r->is_addition = is_addition;
+  r->region = region;
+  base::subtle::Release_Store(&r->state, kPendingReady);
+  return true;
+}
+
 // Invariants (once libpthread_initialized is true):
 //   * While lock_ is not held, recursion_count_ is 0 (and
 //     lock_owner_tid_ is the previous owner, but we don't rely on
@@ -305,6 +357,26 @@ void MemoryRegionMap::Lock() {
     }
   }
   lock_.Lock();
+  TookLock();
+}
+
+bool MemoryRegionMap::TryLock() {
+  {
+    SpinLockHolder l(&owner_lock_);
+    if (recursion_count_ > 0 && current_thread_is(lock_owner_tid_)) {
+      RAW_CHECK(lock_.IsHeld(), "Invariants violated");
+      recursion_count_++;
+      RAW_CHECK(recursion_count_ <= 5,
+                "recursive lock nesting unexpectedly deep");
+      return true;
+    }
+  }
+  if (!lock_.TryLock()) return false;
+  TookLock();
+  return true;
+}
+
+void MemoryRegionMap::TookLock() {
   {
     SpinLockHolder l(&owner_lock_);
     RAW_CHECK(recursion_count_ == 0,
@@ -313,6 +385,31 @@ void MemoryRegionMap::Lock() {
       lock_owner_tid_ = pthread_self();
     recursion_count_ = 1;
   }
+  // Apply the records queued while other threads held lock_, including
+  // any which get queued while we do that.
+  while (true) {
+    const Atomic32 head = base::subtle::NoBarrier_Load(&pending_head);
+    if (head == base::subtle::Acquire_Load(&pending_tail)) break;
+    PendingRecord* r = &pending_records[static_cast<uint32>(head) %
+                                        kPendingRecords];
+    // The slot is reserved, but its hook may still be filling it in.
+    for (int loop = 0;
+         base::subtle::Acquire_Load(&r->state) != kPendingReady; loop++) {
+      base::internal::SpinLockDelay(&r->state, kPendingWriting, loop);
+    }
+    // Records left from before a Shutdown() are of no use to anyone.
+    if (client_count_ > 0) {
+      if (r->is_addition) {
+        RecordRegionAdditionLocked(r->region);
+      } else {
+        RecordRegionRemovalLocked(
+            reinterpret_cast<void*>(r->region.start_addr),
+            r->region.end_addr - r->region.start_addr);
+      }
+    }
+    base::subtle::NoBarrier_Store(&r->state, kPendingFree);
+    base::subtle::Release_Store(&pending_head, head + 1);
+  }
 }
 
 void MemoryRegionMap::Unlock() {
@@ -615,7 +712,18 @@ void MemoryRegionMap::RecordRegionAddition(const void* start, size_t size) {
               reinterpret_cast<void*>(region.end_addr),
               reinterpret_cast<void*>(region.caller()));
   // Note: none of the above allocates memory.
-  Lock();  // recursively lock
+  if (!TryLock()) {  // (recursively locks if we already hold it)
+    if (AddPendingRecord(true, region)) return;
+    Lock();
+  }
+  RecordRegionAdditionLocked(region);
+  Unlock();
+}
+
+void MemoryRegionMap::RecordRegionAdditionLocked(const Region& region) {
+  RAW_CHECK(LockIsHeld(), "should be held (by this thread)");
+  const int depth = region.call_stack_depth;
+  const size_t size = region.end_addr - region.start_addr;
   map_size_ += size;
   InsertRegionLocked(region);
     // This will (eventually) allocate storage for and copy over the stack data
@@ -630,11 +738,22 @@ void MemoryRegionMap::RecordRegionAddition(const void* start, size_t size) {
       recursive_insert = false;
     }
   }
-  Unlock();
 }
 
 void MemoryRegionMap::RecordRegionRemoval(const void* start, size_t size) {
-  Lock();
+  if (!TryLock()) {
+    Region region;
+    region.Create(start, size);
+    if (AddPendingRecord(false, region)) return;
+    Lock();
+  }
+  RecordRegionRemovalLocked(start, size);
+  Unlock();
+}
+
+void MemoryRegionMap::RecordRegionRemovalLocked(const void* start,
+                                                size_t size) {
+  RAW_CHECK(LockIsHeld(), "should be held (by this thread)");
   if (recursive_insert) {
     // First remove the removed region from saved_regions, if it's
     // there, to prevent overrunning saved_regions in recursive
@@ -665,7 +784,6 @@ void MemoryRegionMap::RecordRegionRemoval(const void* start, size_t size) {
   }
   if (regions_ == NULL) {  // We must have just unset the hooks,
                            // but this thread was already inside the hook.
-    Unlock();
     return;
   }
   if (!recursive_insert) {
@@ -748,7 +866,6 @@ void MemoryRegionMap::RecordRegionRemoval(const void* start, size_t size) {
               regions_->size());
   if (VLOG_IS_ON(12))  LogAllLocked();
   unmap_size_ += size;
-  Unlock();
 }
 
 void MemoryRegionMap::RecordRegionRemovalInBucket(int depth,
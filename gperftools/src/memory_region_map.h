@@ -115,6 +115,10 @@ class MemoryRegionMap {
   // Locks to protect our internal data structures.
   // These also protect use of arena_ if our Init() has been done.
   // The lock is recursive.
+  // Our hooks don't wait for the lock when another thread holds it:
+  // they leave what they saw in a small queue, and whoever takes the
+  // lock next applies it before doing anything else.  So when holding
+  // the lock the data is always up to date.
   static void Lock() EXCLUSIVE_LOCK_FUNCTION(lock_);
   static void Unlock() UNLOCK_FUNCTION(lock_);
 
@@ -372,6 +376,17 @@ class MemoryRegionMap {
   // Record deletion of a memory region at address "start" of size "size"
   // (called from our munmap/mremap/sbrk hooks).
   static void RecordRegionRemoval(const void* start, size_t size);
+  // The parts of the above two that need Lock() to be held.
+  static void RecordRegionAdditionLocked(const Region& region);
+  static void RecordRegionRemovalLocked(const void* start, size_t size);
+
+  // Like Lock(), but returns false instead of waiting
+  // if another thread holds the lock.
+  static bool TryLock() EXCLUSIVE_TRYLOCK_FUNCTION(true);
+  // To be called by Lock() and TryLock() right after they took lock_:
+  // records this thread as the owner and applies the records our hooks
+  // queued while other threads held it.
+  static void TookLock() EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // Record deletion of a memory region of size "size" in a bucket whose
   // caller stack trace is "key".  The stack trace is used to a depth of
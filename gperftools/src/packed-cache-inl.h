@@ -42,7 +42,7 @@
 // raciness will not necessarily lead to bugginess.  The cache entries
 // must be large enough to hold a partial key and a value packed
 // together.  The partial keys are bit strings of length
-// kKeybits - kHashbits, and the values are bit strings of length kValuebits.
+// kKeybits - hashbits, and the values are bit strings of length kValuebits.
 //
 // In an effort to use minimal space, every cache entry represents
 // some <key, value> pair; the class provides no way to mark a cache
@@ -54,18 +54,18 @@
 // Usage Considerations
 // --------------------
 //
-// kHashbits controls the size of the cache.  The best value for
-// kHashbits will of course depend on the application.  Perhaps try
-// tuning the value of kHashbits by measuring different values on your
-// favorite benchmark.  Also remember not to be a pig; other
+// The hashbits constructor argument controls the size of the cache.
+// The best value will of course depend on the application.  Perhaps
+// try tuning it by measuring different values on your favorite
+// benchmark.  Also remember not to be a pig; other
 // programs that need resources may suffer if you are.
 //
 // The main uses for this class will be when performance is
 // critical and there's a convenient type to hold the cache's
 // entries.  As described above, the number of bits required
-// for a cache entry is (kKeybits - kHashbits) + kValuebits.  Suppose
+// for a cache entry is (kKeybits - hashbits) + kValuebits.  Suppose
 // kKeybits + kValuebits is 43.  Then it probably makes sense to
-// chose kHashbits >= 11 so that cache entries fit in a uint32.
+// chose hashbits >= 11 so that cache entries fit in a uint32.
 //
 // On the other hand, suppose kKeybits = kValuebits = 64.  Then
 // using this class may be less worthwhile.  You'll probably
@@ -91,7 +91,7 @@
 //    cache, you must specify an "initial value."  The initialization
 //    procedure is equivalent to Clear(initial_value), which is
 //    equivalent to Put(k, initial_value) for all keys k from 0 to
-//    2^kHashbits - 1.
+//    2^hashbits - 1.
 //
 // 3. If key and key' differ then the only way Put(key, value) may
 //    cause Has(key') to change is that Has(key') may change from true to
@@ -100,12 +100,12 @@
 //
 // Implementation details:
 //
-// This is a direct-mapped cache with 2^kHashbits entries; the hash
+// This is a direct-mapped cache with 2^hashbits entries; the hash
 // function simply takes the low bits of the key.  We store whole keys
 // if a whole key plus a whole value fits in an entry.  Otherwise, an
 // entry is the high bits of a key and a value, packed together.
 // E.g., a 20 bit key and a 7 bit value only require a uint16 for each
-// entry if kHashbits >= 11.
+// entry if hashbits >= 11.
 //
 // Alternatives to this scheme will be added as needed.
 
@@ -129,8 +129,10 @@
 // The types K and V provide upper bounds on the number of valid keys
 // and values, but we explicitly require the keys to be less than
 // 2^kKeybits and the values to be less than 2^kValuebits.  The size of
-// the table is controlled by kHashbits, and the type of each entry in
-// the cache is T.  See also the big comment at the top of the file.
+// the table is 2^hashbits entries of type T, where hashbits is picked
+// when the cache is constructed (kHashbits by default), within
+// [kMinHashbits, kMaxHashbits].  See also the big comment at the top of
+// the file.
 template <int kKeybits, typename T>
 class PackedCache {
  public:
@@ -145,15 +147,33 @@ class PackedCache {
   static const int kValuebits = 7;
   static const bool kUseWholeKeys = kKeybits + kValuebits <= 8 * sizeof(T);
 
-  explicit PackedCache(V initial_value) {
+  // The partial key kept in an entry must fit next to the value, which
+  // bounds hashbits from below when whole keys don't fit.  The upper
+  // bound is just to keep the table's memory reasonable.
+  static const int kMinHashbits =
+      kUseWholeKeys ? 1 : kKeybits + kValuebits - 8 * sizeof(T);
+  static const int kMaxHashbits = kKeybits < 22 ? kKeybits : 22;
+
+  // The table is obtained from "allocator", and never freed.  "hashbits"
+  // is clamped to [kMinHashbits, kMaxHashbits].
+  PackedCache(V initial_value, int hashbits, void* (*allocator)(size_t)) {
     COMPILE_ASSERT(kKeybits <= sizeof(K) * 8, key_size);
     COMPILE_ASSERT(kValuebits <= sizeof(V) * 8, value_size);
     COMPILE_ASSERT(kHashbits <= kKeybits, hash_function);
     COMPILE_ASSERT(kKeybits - kHashbits + kValuebits <= kTbits,
                    entry_size_must_be_big_enough);
+    if (hashbits < kMinHashbits) hashbits = kMinHashbits;
+    if (hashbits > kMaxHashbits) hashbits = kMaxHashbits;
+    hashbits_ = hashbits;
+    hash_mask_ = N_ONES_(size_t, hashbits);
+    array_ = reinterpret_cast<volatile T*>(
+        (*allocator)(sizeof(T) << hashbits));
     Clear(initial_value);
   }
 
+  // The number of entries is 2^hashbits().
+  int hashbits() const { return hashbits_; }
+
   void Put(K key, V value) {
     ASSERT(key == (key & kKeyMask));
     ASSERT(value == (value & kValueMask));
@@ -177,7 +197,7 @@ class PackedCache {
 
   void Clear(V value) {
     ASSERT(value == (value & kValueMask));
-    for (int i = 0; i < 1 << kHashbits; i++) {
+    for (size_t i = 0; i <= hash_mask_; i++) {
       ASSERT(kUseWholeKeys || KeyToUpper(i) == 0);
       array_[i] = kUseWholeKeys ? (value | KeyToUpper(i)) : value;
     }
@@ -193,45 +213,42 @@ class PackedCache {
   static V EntryToValue(T t) { return t & kValueMask; }
 
   // If we have space for a whole key, we just shift it left.
-  // Otherwise kHashbits determines where in a K to find the upper
+  // Otherwise hashbits_ determines where in a K to find the upper
   // part of the key, and kValuebits determines where in the entry to
   // put it.
-  static UPPER KeyToUpper(K k) {
+  UPPER KeyToUpper(K k) const {
     if (kUseWholeKeys) {
       return static_cast<T>(k) << kValuebits;
     } else {
-      const int shift = kHashbits - kValuebits;
-      // Assume kHashbits >= kValuebits.  It'd be easy to lift this assumption.
-      return static_cast<T>(k >> shift) & kUpperMask;
+      return static_cast<T>(k >> hashbits_) << kValuebits;
     }
   }
 
-  static size_t Hash(K key) {
-    return static_cast<size_t>(key) & N_ONES_(size_t, kHashbits);
+  size_t Hash(K key) const {
+    return static_cast<size_t>(key) & hash_mask_;
   }
 
   // Does the entry match the relevant part of the given key?
-  static bool KeyMatch(T entry, K key) {
+  bool KeyMatch(T entry, K key) const {
     return kUseWholeKeys ?
         (entry >> kValuebits == key) :
-        ((KeyToUpper(key) ^ entry) & kUpperMask) == 0;
+        ((KeyToUpper(key) ^ entry) & ~static_cast<T>(kValueMask)) == 0;
   }
 
   static const int kTbits = 8 * sizeof(T);
-  static const int kUpperbits = kUseWholeKeys ? kKeybits : kKeybits - kHashbits;
 
   // For masking a K.
   static const K kKeyMask = N_ONES_(K, kKeybits);
 
-  // For masking a T.
-  static const T kUpperMask = N_ONES_(T, kUpperbits) << kValuebits;
-
   // For masking a V or a T.
   static const V kValueMask = N_ONES_(V, kValuebits);
 
+  int hashbits_;
+  size_t hash_mask_;
+
   // array_ is the cache.  Its elements are volatile because any
   // thread can write any array element at any time.
-  volatile T array_[1 << kHashbits];
+  volatile T* array_;
 };
 
 #undef N_ONES_
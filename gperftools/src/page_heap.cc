@@ -36,9 +36,12 @@
 #include <inttypes.h>                   // for PRIuPTR
 #endif
 #include <errno.h>                      // for ENOMEM, errno
+#include <algorithm>                    // for max, min
+#include <string.h>                     // for memset
 #include <gperftools/malloc_extension.h>      // for MallocRange, etc
 #include "base/basictypes.h"
 #include "base/commandlineflags.h"
+#include "getenv_safe.h"       // for TCMallocGetenvSafe
 #include "internal_logging.h"  // for ASSERT, TCMalloc_Printer, etc
 #include "page_heap_allocator.h"  // for PageHeapAllocator
 #include "static_vars.h"       // for Static
@@ -65,34 +68,63 @@ namespace tcmalloc {
 
 PageHeap::PageHeap()
     : pagemap_(MetaDataAlloc),
-      pagemap_cache_(0),
+      // (the flags aren't necessarily set up yet, so read the environment)
+      pagemap_cache_(0,
+                     tcmalloc::commandlineflags::StringToInt(
+                         TCMallocGetenvSafe("TCMALLOC_PAGEMAP_CACHE_BITS"),
+                         PageMapCache::kHashbits),
+                     MetaDataAlloc),
+      queued_bytes_(0),
       scavenge_counter_(0),
+      coalesce_pages_(0),
       // Start scavenging at kMaxPages list
       release_index_(kMaxPages),
-      aggressive_decommit_(false) {
+      prezero_index_(0),
+      aggressive_decommit_(false),
+      background_release_(false),
+      committed_floor_(0),
+      direct_threshold_(0) {
   COMPILE_ASSERT(kNumClasses <= (1 << PageMapCache::kValuebits), valuebits);
-  DLL_Init(&large_.normal);
-  DLL_Init(&large_.returned);
-  for (int i = 0; i < kMaxPages; i++) {
-    DLL_Init(&free_[i].normal);
-    DLL_Init(&free_[i].returned);
+  num_nodes_ = (TCMalloc_SystemNumaNode() >= 0) ? kMaxNumaNodes : 1;
+  for (int node = 0; node < kMaxNumaNodes; node++) {
+    for (int i = 0; i < kMaxPages; i++) {
+      DLL_Init(&free_[node][i].normal);
+      DLL_Init(&free_[node][i].returned);
+    }
   }
+  DLL_Init(&deferred_);
+}
+
+int PageHeap::CurrentNodeSlow() const {
+  const int node = TCMalloc_SystemNumaNode();
+  return (node < 0) ? 0 : node % kMaxNumaNodes;
 }
 
 Span* PageHeap::SearchFreeAndLargeLists(Length n) {
+  // Pages on the calling thread's node first, then any others, rather
+  // than growing the heap.
+  const int local = CurrentNode();
+  for (int i = 0; i < num_nodes_; i++) {
+    Span* result = SearchNodeLists(n, (local + i) % num_nodes_);
+    if (result != NULL) return result;
+  }
+  return NULL;
+}
+
+Span* PageHeap::SearchNodeLists(Length n, int node) {
   ASSERT(Check());
   ASSERT(n > 0);
 
   // Find first size >= n that has a non-empty list
   for (Length s = n; s < kMaxPages; s++) {
-    Span* ll = &free_[s].normal;
+    Span* ll = &free_[node][s].normal;
     // If we're lucky, ll is non-empty, meaning it has a suitable span.
     if (!DLL_IsEmpty(ll)) {
       ASSERT(ll->next->location == Span::ON_NORMAL_FREELIST);
       return Carve(ll->next, n);
     }
     // Alternatively, maybe there's a usable returned span.
-    ll = &free_[s].returned;
+    ll = &free_[node][s].returned;
     if (!DLL_IsEmpty(ll)) {
       // We did not call EnsureLimit before, to avoid releasing the span
       // that will be taken immediately back.
@@ -109,18 +141,26 @@ Span* PageHeap::SearchFreeAndLargeLists(Length n) {
     }
   }
   // No luck in free lists, our last chance is in a larger class.
-  return AllocLarge(n);  // May be NULL
+  return AllocLarge(n, node);  // May be NULL
 }
 
 static const size_t kForcedCoalesceInterval = 128*1024*1024;
 
+// How many pages of a forced coalesce one allocation (or one round of
+// the background release thread) releases at most.
+static const Length kCoalescePagesPerStep = (4 << 20) >> kPageShift;
+
 Span* PageHeap::New(Length n) {
   ASSERT(Check());
   ASSERT(n > 0);
 
   Span* result = SearchFreeAndLargeLists(n);
-  if (result != NULL)
+  if (result != NULL) {
+    if (coalesce_pages_ > 0 && !background_release_) {
+      CoalesceStep(kCoalescePagesPerStep);
+    }
     return result;
+  }
 
   if (stats_.free_bytes != 0 && stats_.unmapped_bytes != 0
       && stats_.free_bytes + stats_.unmapped_bytes >= stats_.system_bytes / 4
@@ -142,14 +182,20 @@ Span* PageHeap::New(Length n) {
     //
     // See also large_heap_fragmentation_unittest.cc and
     // https://code.google.com/p/gperftools/issues/detail?id=368
-    ReleaseAtLeastNPages(static_cast<Length>(0x7fffffff));
+    //
+    // Unmapping them all at once, under pageheap_lock, would stall every
+    // allocating thread for as long as that takes, so we release about
+    // as many pages as we need now, and the rest a few at a time as
+    // later allocations come by (or in the background release thread).
+    coalesce_pages_ = stats_.free_bytes >> kPageShift;
+    CoalesceStep(std::max(n, kCoalescePagesPerStep));
 
     // then try again. If we are forced to grow heap because of large
     // spans fragmentation and not because of problem described above,
-    // then at the very least we've just unmapped free but
-    // insufficiently big large spans back to OS. So in case of really
-    // unlucky memory fragmentation we'll be consuming virtual address
-    // space, but not real memory
+    // then at the very least we'll unmap free but insufficiently big
+    // large spans back to OS. So in case of really unlucky memory
+    // fragmentation we'll be consuming virtual address space, but not
+    // real memory
     result = SearchFreeAndLargeLists(n);
     if (result != NULL) return result;
   }
@@ -169,38 +215,35 @@ Span* PageHeap::New(Length n) {
   return SearchFreeAndLargeLists(n);
 }
 
-Span* PageHeap::AllocLarge(Length n) {
-  // find the best span (closest to n in size).
-  // The following loops implements address-ordered best-fit.
+Span* PageHeap::AllocLarge(Length n, int node) {
+  // Find the best span (closest to n in size): the sets are ordered by
+  // length and then address, so this is address-ordered best-fit.
   Span *best = NULL;
-
-  // Search through normal list
-  for (Span* span = large_.normal.next;
-       span != &large_.normal;
-       span = span->next) {
-    if (span->length >= n) {
-      if ((best == NULL)
-          || (span->length < best->length)
-          || ((span->length == best->length) && (span->start < best->start))) {
-        best = span;
-        ASSERT(best->location == Span::ON_NORMAL_FREELIST);
-      }
-    }
+  Span *bestNormal = NULL;
+
+  // Create a Span to use as an upper bound.
+  Span bound;
+  bound.start = 0;
+  bound.length = n;
+
+  // First search the NORMAL spans.
+  SpanSet::iterator place = large_normal_[node].upper_bound(
+      SpanPtrWithLength(&bound));
+  if (place != large_normal_[node].end()) {
+    best = place->span;
+    bestNormal = best;
+    ASSERT(best->location == Span::ON_NORMAL_FREELIST);
   }
 
-  Span *bestNormal = best;
-
-  // Search through released list in case it has a better fit
-  for (Span* span = large_.returned.next;
-       span != &large_.returned;
-       span = span->next) {
-    if (span->length >= n) {
-      if ((best == NULL)
-          || (span->length < best->length)
-          || ((span->length == best->length) && (span->start < best->start))) {
-        best = span;
-        ASSERT(best->location == Span::ON_RETURNED_FREELIST);
-      }
+  // Try to find better fit from RETURNED spans.
+  place = large_returned_[node].upper_bound(SpanPtrWithLength(&bound));
+  if (place != large_returned_[node].end()) {
+    Span *c = place->span;
+    ASSERT(c->location == Span::ON_RETURNED_FREELIST);
+    if (best == NULL
+        || c->length < best->length
+        || (c->length == best->length && c->start < best->start)) {
+      best = c;
     }
   }
 
@@ -218,7 +261,7 @@ Span* PageHeap::AllocLarge(Length n) {
     // best could have been destroyed by coalescing.
     // bestNormal is not a best-fit, and it could be destroyed as well.
     // We retry, the limit is already ensured:
-    return AllocLarge(n);
+    return AllocLarge(n, node);
   }
 
   // If bestNormal existed, EnsureLimit would succeeded:
@@ -237,6 +280,8 @@ Span* PageHeap::Split(Span* span, Length n) {
   const int extra = span->length - n;
   Span* leftover = NewSpan(span->start + n, extra);
   ASSERT(leftover->location == Span::IN_USE);
+  leftover->zeroed = span->zeroed;
+  leftover->node = span->node;
   Event(leftover, 'U', extra);
   RecordSpan(leftover);
   pagemap_.set(span->start + n - 1, span); // Update map from pageid to span
@@ -245,15 +290,55 @@ Span* PageHeap::Split(Span* span, Length n) {
   return leftover;
 }
 
+bool PageHeap::GrowSpan(Span* span, Length n, bool* zeroed) {
+  ASSERT(n > span->length);
+  ASSERT(span->location == Span::IN_USE);
+  ASSERT(span->sizeclass == 0);
+  // (what follows a direct span is some other mapping's)
+  if (span->direct) return false;
+  Span* next = GetDescriptor(span->start + span->length);
+  if (next == NULL || next->location == Span::IN_USE ||
+      next->node != span->node || span->length + next->length < n) {
+    return false;
+  }
+  const Length extra = n - span->length;
+  if (next->location == Span::ON_RETURNED_FREELIST) {
+    // As in SearchFreeAndLargeLists, recommitting must respect the heap
+    // limit.  Releasing may coalesce |next|, so look it up again.
+    if (!EnsureLimit(extra)) return false;
+    next = GetDescriptor(span->start + span->length);
+    ASSERT(next != NULL && next->location != Span::IN_USE);
+    if (span->length + next->length < n) return false;
+  }
+  // Carve() hands back |extra| committed pages and works out whether
+  // they are zero; we then fold them into |span|.
+  next = Carve(next, extra);
+  *zeroed = next->zeroed;
+  Event(span, 'G', n);
+  pagemap_.set(next->start, span);
+  pagemap_.set(next->start + extra - 1, span);
+  span->length = n;
+  DeleteSpan(next);
+  ASSERT(Check());
+  return true;
+}
+
 void PageHeap::CommitSpan(Span* span) {
   TCMalloc_SystemCommit(reinterpret_cast<void*>(span->start << kPageShift),
                         static_cast<size_t>(span->length << kPageShift));
   stats_.committed_bytes += span->length << kPageShift;
+  stats_.commit_count++;
 }
 
 bool PageHeap::DecommitSpan(Span* span) {
+  // (never let go of the memory Prefault() is to keep)
+  if (stats_.committed_bytes < committed_floor_ +
+      (static_cast<uint64_t>(span->length) << kPageShift)) {
+    return false;
+  }
   bool rv = TCMalloc_SystemRelease(reinterpret_cast<void*>(span->start << kPageShift),
                                    static_cast<size_t>(span->length << kPageShift));
+  stats_.decommit_count++;
   if (rv) {
     stats_.committed_bytes -= span->length << kPageShift;
   }
@@ -274,6 +359,8 @@ Span* PageHeap::Carve(Span* span, Length n) {
   if (extra > 0) {
     Span* leftover = NewSpan(span->start + n, extra);
     leftover->location = old_location;
+    leftover->zeroed = span->zeroed;
+    leftover->node = span->node;
     Event(leftover, 'S', extra);
     RecordSpan(leftover);
 
@@ -294,6 +381,21 @@ Span* PageHeap::Carve(Span* span, Length n) {
     pagemap_.set(span->start + n - 1, span);
   }
   ASSERT(Check());
+  // Returned spans were decommitted, so their pages read back as zero,
+  // unless they were only released lazily and the OS hasn't taken them
+  // yet.  Spans on the normal list may hold whatever was last stored in
+  // them, unless BackgroundRelease() has zeroed them.
+  const bool prezeroed =
+      (old_location == Span::ON_NORMAL_FREELIST) && span->zeroed;
+  span->zeroed = (old_location == Span::ON_RETURNED_FREELIST);
+  if (span->zeroed && TCMalloc_SystemReleaseIsLazy()) {
+    // (for small spans, zeroing is cheaper than asking)
+    span->zeroed = (n >= kMinLazyCheckPages) &&
+        TCMalloc_SystemIsReclaimed(
+            reinterpret_cast<void*>(span->start << kPageShift),
+            static_cast<size_t>(n << kPageShift));
+  }
+  if (prezeroed) span->zeroed = true;
   if (old_location == Span::ON_RETURNED_FREELIST) {
     // We need to recommit this address space.
     CommitSpan(span);
@@ -304,6 +406,68 @@ Span* PageHeap::Carve(Span* span, Length n) {
   return span;
 }
 
+Span* PageHeap::NewDirect(Length n) {
+  ASSERT(n > 0);
+  if (n > kMaxValidPages) return NULL;
+  if (FLAGS_tcmalloc_heap_limit_mb > 0) {
+    SpinLockHolder h(Static::pageheap_lock());
+    if (!EnsureLimit(n)) return NULL;
+  }
+  void* ptr = TCMalloc_SystemMap(n << kPageShift, kPageSize);
+  if (ptr == NULL) return NULL;
+
+  int node = 0;
+  if (num_nodes_ > 1) {
+    const int system_node = TCMalloc_SystemNumaNode();
+    if (system_node >= 0) {
+      TCMalloc_SystemBindToNode(ptr, n << kPageShift, system_node);
+      node = system_node % kMaxNumaNodes;
+    }
+  }
+
+  const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
+  Span* span = NULL;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    // (with the entries on either side, as GrowHeap() does, so the spans
+    // next to it can look at it when they're merged)
+    if (pagemap_.Ensure(p - 1, n + 2)) {
+      span = NewSpan(p, n);
+      RecordSpan(span);
+      span->location = Span::IN_USE;
+      span->zeroed = true;
+      span->direct = true;
+      span->node = node;
+      stats_.system_bytes += n << kPageShift;
+      stats_.committed_bytes += n << kPageShift;
+      stats_.reserve_count++;
+      Event(span, 'M', n);
+    }
+  }
+  if (span == NULL) TCMalloc_SystemUnmap(ptr, n << kPageShift);
+  return span;
+}
+
+void PageHeap::DeleteDirect(Span* span) {
+  ASSERT(span->direct);
+  ASSERT(span->location == Span::IN_USE);
+  void* const start = reinterpret_cast<void*>(span->start << kPageShift);
+  const size_t bytes = span->length << kPageShift;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    ASSERT(GetDescriptor(span->start) == span);
+    ASSERT(GetDescriptor(span->start + span->length - 1) == span);
+    pagemap_.set(span->start, NULL);
+    pagemap_.set(span->start + span->length - 1, NULL);
+    stats_.system_bytes -= bytes;
+    stats_.committed_bytes -= bytes;
+    DeleteSpan(span);
+  }
+  // (only once the pagemap has forgotten them, as the OS may hand the
+  // pages out again right away)
+  TCMalloc_SystemUnmap(start, bytes);
+}
+
 void PageHeap::Delete(Span* span) {
   ASSERT(Check());
   ASSERT(span->location == Span::IN_USE);
@@ -311,18 +475,110 @@ void PageHeap::Delete(Span* span) {
   ASSERT(GetDescriptor(span->start) == span);
   ASSERT(GetDescriptor(span->start + span->length - 1) == span);
   const Length n = span->length;
+  if (span->sizeclass != 0) {
+    for (Length i = 0; i < n; i++) {
+      pagemap_.set_sizeclass(span->start + i, 0);
+    }
+  }
   span->sizeclass = 0;
   span->sample = 0;
-  span->location = Span::ON_NORMAL_FREELIST;
+  span->zeroed = false;
   Event(span, 'D', span->length);
+  if (aggressive_decommit_ &&
+      (background_release_ || TCMalloc_SystemHugePageSize() == 0)) {
+    span->queued = true;
+    queued_bytes_ += n << kPageShift;
+    DLL_Prepend(&deferred_, span);
+    return;
+  }
+  span->location = Span::ON_NORMAL_FREELIST;
   MergeIntoFreeList(span);  // Coalesces if possible
   IncrementalScavenge(n);
   ASSERT(stats_.unmapped_bytes+ stats_.committed_bytes==stats_.system_bytes);
   ASSERT(Check());
 }
 
+void PageHeap::ReleaseDeferred() {
+  if (background_release_ || !HasDeferred()) return;
+  ReleaseDeferredSpans();
+}
+
+void PageHeap::ReleaseDeferredSpans() {
+  Span* list;
+  // How much we may release without going below committed_floor_.  (The
+  // queued spans are committed, so this is all of them unless Prefault()
+  // was used.)
+  uint64_t releasable;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    if (DLL_IsEmpty(&deferred_)) return;
+    releasable = (stats_.committed_bytes > committed_floor_) ?
+        stats_.committed_bytes - committed_floor_ : 0;
+    // Take the whole queue, as a NULL-terminated list
+    list = deferred_.next;
+    deferred_.prev->next = NULL;
+    DLL_Init(&deferred_);
+  }
+
+  // The spans are ours until they're on the free lists again, so their
+  // pages can be released without the lock.  (With huge pages, which
+  // only get here in background release mode, MergeIntoFreeList()
+  // decides what to release, once the spans are merged.)
+  const bool release = (TCMalloc_SystemHugePageSize() == 0);
+  Span* released = NULL;
+  Span* kept = NULL;
+  while (list != NULL) {
+    Span* span = list;
+    list = span->next;
+    const uint64_t bytes = static_cast<uint64_t>(span->length) << kPageShift;
+    if (release && bytes <= releasable && TCMalloc_SystemRelease(
+            reinterpret_cast<void*>(span->start << kPageShift),
+            static_cast<size_t>(span->length << kPageShift))) {
+      releasable -= bytes;
+      span->next = released;
+      released = span;
+    } else {
+      span->next = kept;
+      kept = span;
+    }
+  }
+
+  SpinLockHolder h(Static::pageheap_lock());
+  while (released != NULL || kept != NULL) {
+    Span* span;
+    if (release) stats_.decommit_count++;
+    if (released != NULL) {
+      span = released;
+      released = span->next;
+      span->location = Span::ON_RETURNED_FREELIST;
+      stats_.committed_bytes -= span->length << kPageShift;
+    } else {
+      span = kept;
+      kept = span->next;
+      span->location = Span::ON_NORMAL_FREELIST;
+    }
+    span->next = NULL;
+    span->prev = NULL;
+    span->queued = false;
+    const Length n = span->length;
+    queued_bytes_ -= n << kPageShift;
+    MergeIntoFreeList(span);  // Coalesces if possible
+    IncrementalScavenge(n);
+  }
+  ASSERT(stats_.unmapped_bytes+ stats_.committed_bytes==stats_.system_bytes);
+  ASSERT(Check());
+}
+
+bool PageHeap::KeepCommitted(const Span* span) {
+  const size_t huge = TCMalloc_SystemHugePageSize();
+  return huge != 0 && (span->length << kPageShift) >= huge;
+}
+
 bool PageHeap::MayMergeSpans(Span *span, Span *other) {
-  if (aggressive_decommit_) {
+  if (span->node != other->node) return false;
+  // (with huge pages, some normal spans are never decommitted, so we can't
+  //  merge everything and decommit the lot)
+  if (aggressive_decommit_ && TCMalloc_SystemHugePageSize() == 0) {
     return other->location != Span::IN_USE;
   }
   return span->location == other->location;
@@ -358,9 +614,18 @@ void PageHeap::MergeIntoFreeList(Span* span) {
   // based on memory usage and free heap sizes.
 
   uint64_t temp_committed = 0;
+  // Is every piece of the merged span decommitted already?
+  bool all_returned = (span->location == Span::ON_RETURNED_FREELIST);
+  // Or on the normal list, and zeroed by BackgroundRelease()?
+  bool all_zeroed =
+      (span->location == Span::ON_NORMAL_FREELIST) && span->zeroed;
 
   const PageID p = span->start;
   const Length n = span->length;
+  if (aggressive_decommit_ && span->location == Span::ON_RETURNED_FREELIST) {
+    // This span isn't committed either (see below).
+    temp_committed = n << kPageShift;
+  }
   Span* prev = GetDescriptor(p-1);
   if (prev != NULL && MayMergeSpans(span, prev)) {
     // Merge preceding span into this span
@@ -372,8 +637,11 @@ void PageHeap::MergeIntoFreeList(Span* span) {
       // one as released and decrease stats_.committed_bytes by the size of the
       // merged span.  To make the math work out we temporarily increase the
       // stats_.committed_bytes amount.
-      temp_committed = prev->length << kPageShift;
+      temp_committed += prev->length << kPageShift;
     }
+    all_returned &= (prev->location == Span::ON_RETURNED_FREELIST);
+    all_zeroed &= (prev->location == Span::ON_NORMAL_FREELIST) &&
+        prev->zeroed;
     RemoveFromFreeList(prev);
     DeleteSpan(prev);
     span->start -= len;
@@ -390,6 +658,9 @@ void PageHeap::MergeIntoFreeList(Span* span) {
       // See the comment below 'if (prev->location ...' for explanation.
       temp_committed += next->length << kPageShift;
     }
+    all_returned &= (next->location == Span::ON_RETURNED_FREELIST);
+    all_zeroed &= (next->location == Span::ON_NORMAL_FREELIST) &&
+        next->zeroed;
     RemoveFromFreeList(next);
     DeleteSpan(next);
     span->length += len;
@@ -397,26 +668,52 @@ void PageHeap::MergeIntoFreeList(Span* span) {
     Event(span, 'R', len);
   }
 
-  assert(aggressive_decommit_);
-  if (aggressive_decommit_) {
+  if (aggressive_decommit_ && TCMalloc_SystemHugePageSize() != 0) {
+    // Only like spans were merged.  Big enough spans stay committed, on the
+    // normal list, so that they keep their huge pages.
+    if (span->location == Span::ON_NORMAL_FREELIST && !KeepCommitted(span) &&
+        DecommitSpan(span)) {
+      span->location = Span::ON_RETURNED_FREELIST;
+    }
+  } else if (aggressive_decommit_ && all_returned) {
+    // Nothing to decommit, so no need for a system call.
+    span->location = Span::ON_RETURNED_FREELIST;
+  } else if (aggressive_decommit_) {
+    stats_.committed_bytes += temp_committed;
     if (DecommitSpan(span)) {
       span->location = Span::ON_RETURNED_FREELIST;
-      stats_.committed_bytes += temp_committed;
     } else {
-      ASSERT(temp_committed == 0);
+      // We couldn't release it, so the whole (possibly merged) span is now
+      // committed, and may be dirty.
+      span->location = Span::ON_NORMAL_FREELIST;
     }
   }
+  span->zeroed = all_zeroed;
   PrependToFreeList(span);
 }
 
 void PageHeap::PrependToFreeList(Span* span) {
   ASSERT(span->location != Span::IN_USE);
-  SpanList* list = (span->length < kMaxPages) ? &free_[span->length] : &large_;
   if (span->location == Span::ON_NORMAL_FREELIST) {
     stats_.free_bytes += (span->length << kPageShift);
-    DLL_Prepend(&list->normal, span);
   } else {
     stats_.unmapped_bytes += (span->length << kPageShift);
+  }
+
+  if (span->length >= kMaxPages) {
+    SpanSet *set = (span->location == Span::ON_NORMAL_FREELIST) ?
+        &large_normal_[span->node] : &large_returned_[span->node];
+    std::pair<SpanSet::iterator, bool> p =
+        set->insert(SpanPtrWithLength(span));
+    ASSERT(p.second);  // We never have duplicates since span->start is unique.
+    span->SetSpanSetIterator(p.first);
+    return;
+  }
+
+  SpanList* list = &free_[span->node][span->length];
+  if (span->location == Span::ON_NORMAL_FREELIST) {
+    DLL_Prepend(&list->normal, span);
+  } else {
     DLL_Prepend(&list->returned, span);
   }
 }
@@ -428,7 +725,16 @@ void PageHeap::RemoveFromFreeList(Span* span) {
   } else {
     stats_.unmapped_bytes -= (span->length << kPageShift);
   }
-  DLL_Remove(span);
+  if (span->length >= kMaxPages) {
+    SpanSet *set = (span->location == Span::ON_NORMAL_FREELIST) ?
+        &large_normal_[span->node] : &large_returned_[span->node];
+    SpanSet::iterator iter = span->ExtractSpanSetIterator();
+    ASSERT(iter->span == span);
+    ASSERT(set->find(SpanPtrWithLength(span)) == iter);
+    set->erase(iter);
+  } else {
+    DLL_Remove(span);
+  }
 }
 
 void PageHeap::IncrementalScavenge(Length n) {
@@ -436,6 +742,12 @@ void PageHeap::IncrementalScavenge(Length n) {
   scavenge_counter_ -= n;
   if (scavenge_counter_ >= 0) return;  // Not yet time to scavenge
 
+  // (BackgroundRelease() will see the counter has run out)
+  if (background_release_) return;
+  Scavenge();
+}
+
+void PageHeap::Scavenge() {
   const double rate = FLAGS_tcmalloc_release_rate;
   if (rate <= 1e-6) {
     // Tiny release rate means that releasing is disabled.
@@ -443,7 +755,10 @@ void PageHeap::IncrementalScavenge(Length n) {
     return;
   }
 
-  Length released_pages = ReleaseAtLeastNPages(1);
+  // (if memory can't be released, zeroing it in place is the next best
+  //  thing: it takes the cost out of calloc() and friends)
+  Length released_pages = TCMalloc_SystemReleaseIsInPlace() ?
+      ZeroNextNormalSpan() : ReleaseAtLeastNPages(1);
 
   if (released_pages == 0) {
     // Nothing to scavenge, delay for a while.
@@ -458,12 +773,120 @@ void PageHeap::IncrementalScavenge(Length n) {
       // Avoid overflow and bound to reasonable range.
       wait = kMaxReleaseDelay;
     }
-    scavenge_counter_ = static_cast<int64_t>(wait);
+    if (background_release_) {
+      // Pages freed since the counter ran out count towards the wait.
+      scavenge_counter_ += static_cast<int64_t>(wait);
+    } else {
+      scavenge_counter_ = static_cast<int64_t>(wait);
+    }
+  }
+}
+
+void PageHeap::CoalesceStep(Length max_pages) {
+  const Length released =
+      ReleaseAtLeastNPages(std::min(coalesce_pages_, max_pages));
+  // (nothing left to release, or releasing isn't supported)
+  if (released == 0 || released >= coalesce_pages_) {
+    coalesce_pages_ = 0;
+  } else {
+    coalesce_pages_ -= released;
+  }
+}
+
+void PageHeap::FinishRelease() {
+  SpinLockHolder h(&release_lock_);
+  ReleaseDeferredSpans();
+}
+
+void PageHeap::BackgroundRelease() {
+  SpinLockHolder r(&release_lock_);
+  ReleaseDeferredSpans();
+
+  // Catch up with the release rate.  Each Scavenge() releases one span,
+  // and we let go of the lock in between.
+  for (;;) {
+    SpinLockHolder h(Static::pageheap_lock());
+    if (scavenge_counter_ >= 0) break;
+    Scavenge();
+  }
+
+  // And with any forced coalesce New() started.
+  for (;;) {
+    SpinLockHolder h(Static::pageheap_lock());
+    if (coalesce_pages_ == 0) break;
+    CoalesceStep(kCoalescePagesPerStep);
+  }
+
+  PrezeroFreeSpans(kPrezeroBytesPerRound);
+}
+
+void PageHeap::PrezeroFreeSpans(size_t max_bytes) {
+  const int num_lists = kMaxPages * num_nodes_;
+  size_t zeroed = 0;
+  for (int i = 0; i < num_lists && zeroed < max_bytes; i++) {
+    Span* span = NULL;
+    {
+      SpinLockHolder h(Static::pageheap_lock());
+      if (prezero_index_ >= num_lists) prezero_index_ = 0;
+      Span* list =
+          &free_[prezero_index_ / kMaxPages][prezero_index_ % kMaxPages].normal;
+      prezero_index_++;
+      // (zeroed spans are merged back in at the front, so look from the
+      //  back)
+      int scanned = 0;
+      for (Span* s = list->prev; s != list && scanned < kPrezeroScanSpans;
+           s = s->prev, scanned++) {
+        if (!s->zeroed) {
+          span = s;
+          break;
+        }
+      }
+      if (span == NULL) continue;
+      // Like the spans queued by Delete(), it is IN_USE while we zero it,
+      // so that nothing merges with it or hands it out.
+      RemoveFromFreeList(span);
+      span->location = Span::IN_USE;
+      span->queued = true;
+      queued_bytes_ += span->length << kPageShift;
+    }
+
+    const size_t bytes = span->length << kPageShift;
+    tcmalloc_zero_object(reinterpret_cast<void*>(span->start << kPageShift),
+                         bytes);
+    zeroed += bytes;
+
+    SpinLockHolder h(Static::pageheap_lock());
+    span->zeroed = true;
+    span->queued = false;
+    queued_bytes_ -= bytes;
+    span->location = Span::ON_NORMAL_FREELIST;
+    MergeIntoFreeList(span);  // Coalesces if possible
+    ASSERT(Check());
   }
 }
 
-Length PageHeap::ReleaseLastNormalSpan(SpanList* slist) {
-  Span* s = slist->normal.prev;
+Length PageHeap::ZeroNextNormalSpan() {
+  const int num_lists = kMaxPages * num_nodes_;
+  for (int i = 0; i < num_lists; i++) {
+    if (prezero_index_ >= num_lists) prezero_index_ = 0;
+    Span* list =
+        &free_[prezero_index_ / kMaxPages][prezero_index_ % kMaxPages].normal;
+    prezero_index_++;
+    int scanned = 0;
+    for (Span* s = list->prev; s != list && scanned < kPrezeroScanSpans;
+         s = s->prev, scanned++) {
+      if (!s->zeroed) {
+        tcmalloc_zero_object(reinterpret_cast<void*>(s->start << kPageShift),
+                             s->length << kPageShift);
+        s->zeroed = true;
+        return s->length;
+      }
+    }
+  }
+  return 0;
+}
+
+Length PageHeap::ReleaseSpan(Span* s) {
   ASSERT(s->location == Span::ON_NORMAL_FREELIST);
 
   if (DecommitSpan(s)) {
@@ -480,21 +903,29 @@ Length PageHeap::ReleaseLastNormalSpan(SpanList* slist) {
 Length PageHeap::ReleaseAtLeastNPages(Length num_pages) {
   Length released_pages = 0;
 
-  // Round robin through the lists of free spans, releasing the last
-  // span in each list.  Stop after releasing at least num_pages
-  // or when there is nothing more to release.
+  // Round robin through the lists of free spans (of all the nodes),
+  // releasing the last span in each list, and the shortest large span.  Stop after releasing at least
+  // num_pages or when there is nothing more to release.
+  const int num_lists = (kMaxPages+1) * num_nodes_;
   while (released_pages < num_pages && stats_.free_bytes > 0) {
-    for (int i = 0; i < kMaxPages+1 && released_pages < num_pages;
+    for (int i = 0; i < num_lists && released_pages < num_pages;
          i++, release_index_++) {
-      if (release_index_ > kMaxPages) release_index_ = 0;
-      SpanList* slist = (release_index_ == kMaxPages) ?
-          &large_ : &free_[release_index_];
-      if (!DLL_IsEmpty(&slist->normal)) {
-        Length released_len = ReleaseLastNormalSpan(slist);
-        // Some systems do not support release
-        if (released_len == 0) return released_pages;
-        released_pages += released_len;
+      if (release_index_ >= num_lists) release_index_ = 0;
+      const int node = release_index_ / (kMaxPages+1);
+      const int index = release_index_ % (kMaxPages+1);
+      Span* s;
+      if (index == kMaxPages) {
+        if (large_normal_[node].empty()) continue;
+        s = large_normal_[node].begin()->span;  // the shortest large span
+      } else {
+        SpanList* slist = &free_[node][index];
+        if (DLL_IsEmpty(&slist->normal)) continue;
+        s = slist->normal.prev;
       }
+      Length released_len = ReleaseSpan(s);
+      // Some systems do not support release
+      if (released_len == 0) return released_pages;
+      released_pages += released_len;
     }
   }
   return released_pages;
@@ -534,12 +965,19 @@ void PageHeap::RegisterSizeClass(Span* span, size_t sc) {
   for (Length i = 1; i < span->length-1; i++) {
     pagemap_.set(span->start+i, span);
   }
+  for (Length i = 0; i < span->length; i++) {
+    pagemap_.set_sizeclass(span->start+i, sc);
+  }
 }
 
 void PageHeap::GetSmallSpanStats(SmallSpanStats* result) {
   for (int s = 0; s < kMaxPages; s++) {
-    result->normal_length[s] = DLL_Length(&free_[s].normal);
-    result->returned_length[s] = DLL_Length(&free_[s].returned);
+    result->normal_length[s] = 0;
+    result->returned_length[s] = 0;
+    for (int node = 0; node < num_nodes_; node++) {
+      result->normal_length[s] += DLL_Length(&free_[node][s].normal);
+      result->returned_length[s] += DLL_Length(&free_[node][s].returned);
+    }
   }
 }
 
@@ -547,13 +985,17 @@ void PageHeap::GetLargeSpanStats(LargeSpanStats* result) {
   result->spans = 0;
   result->normal_pages = 0;
   result->returned_pages = 0;
-  for (Span* s = large_.normal.next; s != &large_.normal; s = s->next) {
-    result->normal_pages += s->length;;
-    result->spans++;
-  }
-  for (Span* s = large_.returned.next; s != &large_.returned; s = s->next) {
-    result->returned_pages += s->length;
-    result->spans++;
+  for (int node = 0; node < num_nodes_; node++) {
+    for (SpanSet::iterator it = large_normal_[node].begin();
+         it != large_normal_[node].end(); ++it) {
+      result->normal_pages += it->length;
+      result->spans++;
+    }
+    for (SpanSet::iterator it = large_returned_[node].begin();
+         it != large_returned_[node].end(); ++it) {
+      result->returned_pages += it->length;
+      result->spans++;
+    }
   }
 }
 
@@ -567,6 +1009,11 @@ bool PageHeap::GetNextRange(PageID start, base::MallocRange* r) {
   r->fraction = 0;
   switch (span->location) {
     case Span::IN_USE:
+      if (span->queued) {
+        // (freed, and soon to be on a free list)
+        r->type = base::MallocRange::FREE;
+        break;
+      }
       r->type = base::MallocRange::INUSE;
       r->fraction = 1;
       if (span->sizeclass > 0) {
@@ -596,21 +1043,36 @@ static void RecordGrowth(size_t growth) {
   Static::set_growth_stacks(t);
 }
 
-bool PageHeap::GrowHeap(Length n) {
+bool PageHeap::Prefault(size_t bytes) {
+  const Length n = (bytes + kPageSize - 1) >> kPageShift;
+  if (n == 0) return true;
+  committed_floor_ = static_cast<uint64_t>(n) << kPageShift;
+  return GrowHeap(n, true);
+}
+
+bool PageHeap::GrowHeap(Length n, bool populate) {
   ASSERT(kMaxPages >= kMinSystemAlloc);
   if (n > kMaxValidPages) return false;
   Length ask = (n>kMinSystemAlloc) ? n : static_cast<Length>(kMinSystemAlloc);
+  // Grow in whole huge pages, so they are aligned and can be used as such
+  const Length huge_pages = TCMalloc_SystemHugePageSize() >> kPageShift;
+  if (ask < huge_pages) ask = huge_pages;
   size_t actual_size;
+  bool zeroed = false;
   void* ptr = NULL;
   if (EnsureLimit(ask)) {
-      ptr = TCMalloc_SystemAlloc(ask << kPageShift, &actual_size, kPageSize);
+      ptr = TCMalloc_SystemAlloc(ask << kPageShift, &actual_size, kPageSize,
+                                 &zeroed);
+      stats_.reserve_count++;
   }
   if (ptr == NULL) {
     if (n < ask) {
       // Try growing just "n" pages
       ask = n;
       if (EnsureLimit(ask)) {
-        ptr = TCMalloc_SystemAlloc(ask << kPageShift, &actual_size, kPageSize);
+        ptr = TCMalloc_SystemAlloc(ask << kPageShift, &actual_size, kPageSize,
+                                   &zeroed);
+        stats_.reserve_count++;
       }
     }
     if (ptr == NULL) return false;
@@ -618,9 +1080,25 @@ bool PageHeap::GrowHeap(Length n) {
   ask = actual_size >> kPageShift;
   RecordGrowth(ask << kPageShift);
 
+  // Bind the new pages (before anything touches them) to the node of the
+  // thread that asked for them, which is probably the one to use them.
+  int node = 0;
+  if (num_nodes_ > 1) {
+    const int system_node = TCMalloc_SystemNumaNode();
+    if (system_node >= 0) {
+      TCMalloc_SystemBindToNode(ptr, ask << kPageShift, system_node);
+      node = system_node % kMaxNumaNodes;
+    }
+  }
+
+  if (populate) {
+    // (after binding them, so they come from the right node)
+    TCMalloc_SystemPopulate(ptr, ask << kPageShift);
+    if (!zeroed) tcmalloc_zero_object(ptr, ask << kPageShift);
+  }
+
   uint64_t old_system_bytes = stats_.system_bytes;
   stats_.system_bytes += (ask << kPageShift);
-  stats_.committed_bytes += (ask << kPageShift);
   const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
   ASSERT(p > 0);
 
@@ -637,34 +1115,56 @@ bool PageHeap::GrowHeap(Length n) {
   // Plus ensure one before and one after so coalescing code
   // does not need bounds-checking.
   if (pagemap_.Ensure(p-1, ask+2)) {
-    // Pretend the new area is allocated and then Delete() it to cause
-    // any necessary coalescing to occur.
+    // Put the new area on the free lists, coalescing as necessary.  If the
+    // system allocator says it reads as zero, it's as good as decommitted
+    // memory: it goes on the returned list, which tells Carve() it is zero
+    // (so calloc() and friends can skip zeroing it).  Otherwise it may hold
+    // anything, as freed memory does.
     Span* span = NewSpan(p, ask);
     RecordSpan(span);
-    Delete(span);
+    span->node = node;
+    // Populated memory is committed and zero, as if BackgroundRelease() had
+    // zeroed it.
+    if (populate) {
+      span->location = Span::ON_NORMAL_FREELIST;
+      span->zeroed = true;
+      stats_.committed_bytes += ask << kPageShift;
+    } else if (zeroed) {
+      span->location = Span::ON_RETURNED_FREELIST;
+    } else {
+      span->location = Span::ON_NORMAL_FREELIST;
+      stats_.committed_bytes += ask << kPageShift;
+    }
+    MergeIntoFreeList(span);
+    IncrementalScavenge(ask);  // (as Delete() would have)
     ASSERT(stats_.unmapped_bytes+ stats_.committed_bytes==stats_.system_bytes);
     ASSERT(Check());
     return true;
   } else {
     // We could not allocate memory within "pagemap_"
     // TODO: Once we can return memory to the system, return the new span
+    stats_.committed_bytes += (ask << kPageShift);
     return false;
   }
 }
 
 bool PageHeap::Check() {
-  ASSERT(free_[0].normal.next == &free_[0].normal);
-  ASSERT(free_[0].returned.next == &free_[0].returned);
+  for (int node = 0; node < num_nodes_; node++) {
+    ASSERT(free_[node][0].normal.next == &free_[node][0].normal);
+    ASSERT(free_[node][0].returned.next == &free_[node][0].returned);
+  }
   return true;
 }
 
 bool PageHeap::CheckExpensive() {
   bool result = Check();
-  CheckList(&large_.normal, kMaxPages, 1000000000, Span::ON_NORMAL_FREELIST);
-  CheckList(&large_.returned, kMaxPages, 1000000000, Span::ON_RETURNED_FREELIST);
-  for (Length s = 1; s < kMaxPages; s++) {
-    CheckList(&free_[s].normal, s, s, Span::ON_NORMAL_FREELIST);
-    CheckList(&free_[s].returned, s, s, Span::ON_RETURNED_FREELIST);
+  for (int node = 0; node < num_nodes_; node++) {
+    CheckSet(&large_normal_[node], kMaxPages, Span::ON_NORMAL_FREELIST);
+    CheckSet(&large_returned_[node], kMaxPages, Span::ON_RETURNED_FREELIST);
+    for (Length s = 1; s < kMaxPages; s++) {
+      CheckList(&free_[node][s].normal, s, s, Span::ON_NORMAL_FREELIST);
+      CheckList(&free_[node][s].returned, s, s, Span::ON_RETURNED_FREELIST);
+    }
   }
   return result;
 }
@@ -681,4 +1181,16 @@ bool PageHeap::CheckList(Span* list, Length min_pages, Length max_pages,
   return true;
 }
 
+bool PageHeap::CheckSet(SpanSet* spanset, Length min_pages, int freelist) {
+  for (SpanSet::iterator it = spanset->begin(); it != spanset->end(); ++it) {
+    Span* s = it->span;
+    CHECK_CONDITION(s->length == it->length);
+    CHECK_CONDITION(s->location == freelist);  // NORMAL or RETURNED
+    CHECK_CONDITION(s->length >= min_pages);
+    CHECK_CONDITION(GetDescriptor(s->start) == s);
+    CHECK_CONDITION(GetDescriptor(s->start+s->length-1) == s);
+  }
+  return true;
+}
+
 }  // namespace tcmalloc
@@ -41,6 +41,7 @@
 #endif
 #include <gperftools/malloc_extension.h>
 #include "base/basictypes.h"
+#include "base/spinlock.h"
 #include "common.h"
 #include "packed-cache-inl.h"
 #include "pagemap.h"
@@ -113,8 +114,30 @@ class PERFTOOLS_DLL_DECL PageHeap {
   // Delete the span "[p, p+n-1]".
   // REQUIRES: span was returned by earlier call to New() and
   //           has not yet been deleted.
+  //
+  // In aggressive decommit mode (without huge pages, or in background
+  // release mode), the span is only queued, to keep the system call that
+  // releases its pages out of pageheap_lock: the caller must call
+  // ReleaseDeferred() once it has dropped the lock.
   void Delete(Span* span);
 
+  // Release the pages of the spans queued by Delete() to the system, and
+  // put them on the free lists.  Takes pageheap_lock (twice), but makes
+  // the system calls without it.  In background release mode, this is
+  // left to BackgroundRelease(), and does nothing.
+  // REQUIRES: pageheap_lock is *not* held.
+  void ReleaseDeferred();
+
+  // Wait for the current BackgroundRelease() (if any) to finish, and
+  // then ReleaseDeferred(), even in background release mode: for when
+  // all free memory is to be released right away.
+  // REQUIRES: pageheap_lock is *not* held.
+  void FinishRelease();
+
+  // Are there spans waiting for ReleaseDeferred()?  Only a hint, as it
+  // is read without the lock.
+  bool HasDeferred() const { return !DLL_IsEmpty(&deferred_); }
+
   // Mark an allocated span as being used for small objects of the
   // specified size-class.
   // REQUIRES: span was returned by an earlier call to New()
@@ -131,6 +154,40 @@ class PERFTOOLS_DLL_DECL PageHeap {
   // REQUIRES: span->sizeclass == 0
   Span* Split(Span* span, Length n);
 
+  // Extend an allocated span to "n" pages by taking over the free
+  // pages that directly follow it.  Returns false, leaving "*span"
+  // alone, if those pages are in use or too few.  On success, sets
+  // "*zeroed" to whether the added pages are known to read as zero.
+  //
+  // REQUIRES: "n > span->length"
+  // REQUIRES: span->location == IN_USE
+  // REQUIRES: span->sizeclass == 0
+  bool GrowSpan(Span* span, Length n, bool* zeroed);
+
+  // Allocations of at least GetDirectThreshold() bytes (0 for none) are
+  // to be made with NewDirect() rather than New().  By default, those of
+  // kDefaultDirectThreshold bytes (TCMALLOC_DIRECT_MMAP_THRESHOLD).
+  static const size_t kDefaultDirectThreshold = 64 << 20;
+  size_t GetDirectThreshold() const { return direct_threshold_; }
+  void SetDirectThreshold(size_t bytes) { direct_threshold_ = bytes; }
+  bool IsDirect(Length n) const {
+    return direct_threshold_ != 0 &&
+           n > ((direct_threshold_ - 1) >> kPageShift);
+  }
+
+  // Allocate a run of "n" pages mapped from the OS for it alone, rather
+  // than from the free lists: it is zero (as fresh mappings are), and
+  // never coalesced with other spans or grown, and DeleteDirect() gives
+  // it straight back to the OS.  Takes pageheap_lock only to register the
+  // span, not for the system calls.  Returns NULL if the pages couldn't
+  // be mapped; New() may still be able to allocate them.
+  // REQUIRES: pageheap_lock is *not* held.
+  Span* NewDirect(Length n);
+
+  // Unmap a span returned by NewDirect().
+  // REQUIRES: pageheap_lock is *not* held.
+  void DeleteDirect(Span* span);
+
   // Return the descriptor for the specified page.  Returns NULL if
   // this PageID was not allocated previously.
   inline Span* GetDescriptor(PageID p) const {
@@ -143,14 +200,25 @@ class PERFTOOLS_DLL_DECL PageHeap {
 
   // Page heap statistics
   struct Stats {
-    Stats() : system_bytes(0), free_bytes(0), unmapped_bytes(0), committed_bytes(0) {}
+    Stats() : system_bytes(0), free_bytes(0), unmapped_bytes(0), committed_bytes(0),
+              reserve_count(0), commit_count(0), decommit_count(0) {}
     uint64_t system_bytes;    // Total bytes allocated from system
     uint64_t free_bytes;      // Total bytes on normal freelists
     uint64_t unmapped_bytes;  // Total bytes on returned freelists
     uint64_t committed_bytes;  // Bytes committed, always <= system_bytes_.
 
+    // Number of system calls made to get memory from the system, and to
+    // commit and decommit (release) it.
+    uint64_t reserve_count;
+    uint64_t commit_count;
+    uint64_t decommit_count;
   };
-  inline Stats stats() const { return stats_; }
+  inline Stats stats() const {
+    // (the spans queued by Delete(), or being zeroed, are free too)
+    Stats stats = stats_;
+    stats.free_bytes += queued_bytes_;
+    return stats;
+  }
 
   struct SmallSpanStats {
     // For each free list of small spans, the length (in spans) of the
@@ -173,6 +241,7 @@ class PERFTOOLS_DLL_DECL PageHeap {
   bool CheckExpensive();
   bool CheckList(Span* list, Length min_pages, Length max_pages,
                  int freelist);  // ON_NORMAL_FREELIST or ON_RETURNED_FREELIST
+  bool CheckSet(SpanSet *s, Length min_pages, int freelist);
 
   // Try to release at least num_pages for reuse by the OS.  Returns
   // the actual number of pages released, which may be less than
@@ -192,11 +261,59 @@ class PERFTOOLS_DLL_DECL PageHeap {
   }
   void CacheSizeClass(PageID p, size_t cl) const { pagemap_cache_.Put(p, cl); }
 
+  // Return the sizeclass for p from the pagemap itself: one walk of the
+  // radix tree, no span.  0 means p is not part of a span that holds
+  // small objects (unlike with GetSizeClassIfCached(), this is exact).
+  // Like the pagemap, this can be read without locking.
+  size_t GetSizeClass(PageID p) const { return pagemap_.sizeclass(p); }
+
+  // Start loading the pagemap entry GetSizeClass(p) will read.
+  void PrefetchSizeClass(PageID p) const { pagemap_.PrefetchSizeClass(p); }
+
+  // The NUMA node (mod kMaxNumaNodes) of the calling thread, whose free
+  // pages New() tries first; 0 unless TCMALLOC_NUMA is set.
+  int CurrentNode() const {
+    return (num_nodes_ > 1) ? CurrentNodeSlow() : 0;
+  }
+
+  // Grows the heap by (at least) "bytes", faulting the new memory in and
+  // zeroing it, so that it costs no page faults or zeroing to use; and
+  // from then on, never releases memory to the system if that would leave
+  // less than "bytes" of it committed.  For TCMALLOC_PREFAULT_BYTES.
+  // Returns false if the heap couldn't be grown.
+  // REQUIRES: pageheap_lock is held.
+  bool Prefault(size_t bytes);
+  uint64_t GetCommittedFloor() const { return committed_floor_; }
+
   bool GetAggressiveDecommit(void) {return aggressive_decommit_;}
   void SetAggressiveDecommit(bool aggressive_decommit) {
     aggressive_decommit_ = aggressive_decommit;
   }
 
+  // In background release mode, a thread of tcmalloc's own calls
+  // BackgroundRelease() every so often, and the threads that free memory
+  // never make system calls to release it: Delete() queues the spans
+  // that aggressive decommit would release, and keeps count of the pages
+  // freed, but leaves the releasing (at FLAGS_tcmalloc_release_rate) to
+  // BackgroundRelease().
+  // REQUIRES: pageheap_lock is held (for SetBackgroundRelease()).
+  bool GetBackgroundRelease() const { return background_release_; }
+  void SetBackgroundRelease(bool background_release) {
+    background_release_ = background_release;
+  }
+
+  // One round of the background release thread's work: release the spans
+  // queued by Delete(), release as many pages as the release rate calls
+  // for, and zero up to kPrezeroBytesPerRound of the spans on the normal
+  // free lists, so that calloc() etc. needn't zero them when they're
+  // reused.  Holds pageheap_lock for one span at a time at most.
+  // REQUIRES: pageheap_lock is *not* held.
+  void BackgroundRelease();
+
+  // Held throughout BackgroundRelease() and FinishRelease(), and around
+  // fork().  Taken before pageheap_lock, never while holding it.
+  SpinLock* release_lock() { return &release_lock_; }
+
  private:
   // Allocates a big block of memory for the pagemap once we reach more than
   // 128MB
@@ -211,6 +328,11 @@ class PERFTOOLS_DLL_DECL PageHeap {
   // REQUIRED: kMinSystemAlloc <= kMaxPages;
   static const int kMinSystemAlloc = kMaxPages;
 
+  // With lazily released memory, only spans of at least this many
+  // pages are checked for having been reclaimed, when they're reused;
+  // smaller ones are just zeroed.
+  static const Length kMinLazyCheckPages = 8;
+
   // Never delay scavenging for more than the following number of
   // deallocated pages.  With 4K pages, this comes to 4GB of
   // deallocation.
@@ -220,6 +342,11 @@ class PERFTOOLS_DLL_DECL PageHeap {
   // scavenging again.  With 4K pages, this comes to 1GB of memory.
   static const int kDefaultReleaseDelay = 1 << 18;
 
+  // Limits on the zeroing done by one BackgroundRelease(): the bytes
+  // zeroed, and the spans looked at in each free list to find dirty ones.
+  static const size_t kPrezeroBytesPerRound = 1 << 20;
+  static const int kPrezeroScanSpans = 16;
+
   // Pick the appropriate map and cache types based on pointer size
   typedef MapSelector<kAddressBits>::Type PageMap;
   typedef MapSelector<kAddressBits>::CacheType PageMapCache;
@@ -234,18 +361,39 @@ class PERFTOOLS_DLL_DECL PageHeap {
     Span        returned;
   };
 
-  // List of free spans of length >= kMaxPages
-  SpanList large_;
+  // Free spans are kept per NUMA node, for num_nodes_ nodes: 1, unless
+  // TCMALLOC_NUMA is set.  Spans on different nodes are never merged.
+
+  // Sets of free spans of length >= kMaxPages, ordered by length and then
+  // address, so AllocLarge() finds the best fit in O(log n).
+  SpanSet large_normal_[kMaxNumaNodes];
+  SpanSet large_returned_[kMaxNumaNodes];
+
+  // Spans deleted but not yet released; see Delete().  They stay IN_USE
+  // meanwhile, so nothing merges with them or hands them out.
+  Span deferred_;
 
   // Array mapping from span length to a doubly linked list of free spans
-  SpanList free_[kMaxPages];
+  SpanList free_[kMaxNumaNodes][kMaxPages];
+
+  int num_nodes_;
 
   // Statistics on system, free, and unmapped bytes
   Stats stats_;
 
+  // Bytes in spans that are free but IN_USE for now (Span::queued).
+  uint64_t queued_bytes_;
+
   Span* SearchFreeAndLargeLists(Length n);
 
-  bool GrowHeap(Length n);
+  // Like SearchFreeAndLargeLists(), but only looks at node's lists.
+  Span* SearchNodeLists(Length n, int node);
+
+  int CurrentNodeSlow() const;
+
+  // Grows the heap by at least n pages.  If "populate", the new pages are
+  // faulted in and zeroed, and stay committed.
+  bool GrowHeap(Length n, bool populate = false);
 
   // REQUIRES: span->length >= n
   // REQUIRES: span->location != IN_USE
@@ -263,9 +411,10 @@ class PERFTOOLS_DLL_DECL PageHeap {
     }
   }
 
-  // Allocate a large span of length == n.  If successful, returns a
-  // span of exactly the specified length.  Else, returns NULL.
-  Span* AllocLarge(Length n);
+  // Allocate a large span of length == n, from node's lists.  If
+  // successful, returns a span of exactly the specified length.  Else,
+  // returns NULL.
+  Span* AllocLarge(Length n, int node);
 
   // Coalesce span with neighboring spans if possible, prepend to
   // appropriate free list, and adjust stats.
@@ -287,9 +436,30 @@ class PERFTOOLS_DLL_DECL PageHeap {
   // IncrementalScavenge(n) is called whenever n pages are freed.
   void IncrementalScavenge(Length n);
 
-  // Release the last span on the normal portion of this list.
+  // Release some memory, and set scavenge_counter_ to the number of
+  // pages to free before the next time, according to the release rate.
+  void Scavenge();
+
+  // Release up to max_pages of the coalesce_pages_ still to go.
+  void CoalesceStep(Length max_pages);
+
+  // ReleaseDeferred(), even in background release mode.
+  void ReleaseDeferredSpans();
+
+  // Zero dirty spans on the normal free lists (of at most kMaxPages-1
+  // pages), about max_bytes' worth, taking them off the lists meanwhile.
+  // REQUIRES: pageheap_lock is *not* held.
+  void PrezeroFreeSpans(size_t max_bytes);
+
+  // Zero the next dirty span on the normal free lists in place, for
+  // Scavenge() when memory can't be released (see
+  // TCMalloc_SystemReleaseIsInPlace).  Return the length of that span or
+  // zero if there was none.
+  Length ZeroNextNormalSpan();
+
+  // Release this span, which must be on a normal free list.
   // Return the length of that span or zero if release failed.
-  Length ReleaseLastNormalSpan(SpanList* slist);
+  Length ReleaseSpan(Span* span);
 
   // Checks if we are allowed to take more memory from the system.
   // If limit is reached and allowRelease is true, tries to release
@@ -298,13 +468,35 @@ class PERFTOOLS_DLL_DECL PageHeap {
 
   bool MayMergeSpans(Span *span, Span *other);
 
+  // Should span stay committed when it's freed (to keep its huge pages)?
+  bool KeepCommitted(const Span* span);
+
   // Number of pages to deallocate before doing more scavenging
   int64_t scavenge_counter_;
 
+  // Number of free pages still to be released by a forced coalesce (see
+  // New()); CoalesceStep() works them off a few at a time.
+  Length coalesce_pages_;
+
   // Index of last free list where we released memory to the OS.
   int release_index_;
 
+  // Index of the free list PrezeroFreeSpans() (or ZeroNextNormalSpan())
+  // is to look at next.
+  int prezero_index_;
+
   bool aggressive_decommit_;
+
+  bool background_release_;
+
+  // Bytes that stay committed, whatever the release policy (see
+  // Prefault()).
+  uint64_t committed_floor_;
+
+  // See GetDirectThreshold().
+  size_t direct_threshold_;
+
+  SpinLock release_lock_;
 };
 
 }  // namespace tcmalloc
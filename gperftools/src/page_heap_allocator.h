@@ -36,14 +36,18 @@
 
 #include <stddef.h>                     // for NULL, size_t
 
+#include <new>                        // for placement new
+
+#include "base/basictypes.h"   // for LinkerInitialized
 #include "common.h"            // for MetaDataAlloc
 #include "internal_logging.h"  // for ASSERT
 
 namespace tcmalloc {
 
 // Simple allocator for objects of a specified type.  External locking
-// is required before accessing one of these objects.
-template <class T>
+// is required before accessing one of these objects.  The objects are
+// carved, one after the other, out of slabs of kAllocIncrement bytes.
+template <class T, int kAllocIncrement = 128 << 10>
 class PageHeapAllocator {
  public:
   // We use an explicit Init function because these variables are statically
@@ -95,9 +99,6 @@ class PageHeapAllocator {
   int inuse() const { return inuse_; }
 
  private:
-  // How much to allocate from system at a time
-  static const int kAllocIncrement = 128 << 10;
-
   // Free area from which to carve new objects
   char* free_area_;
   size_t free_avail_;
@@ -109,6 +110,77 @@ class PageHeapAllocator {
   int inuse_;
 };
 
+// STL-compatible allocator which forwards allocations to a PageHeapAllocator.
+// Like PageHeapAllocator, it requires external locking (pageheap_lock for
+// the containers inside the page heap).  Only single objects are ever
+// allocated, which is all node-based containers such as std::set need.
+//
+// LockingTag just keeps containers guarded by different locks from sharing
+// one underlying PageHeapAllocator.
+template <typename T, class LockingTag>
+class STLPageHeapAllocator {
+ public:
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+  typedef T*         pointer;
+  typedef const T*   const_pointer;
+  typedef T&         reference;
+  typedef const T&   const_reference;
+  typedef T          value_type;
+
+  template <class T1> struct rebind {
+    typedef STLPageHeapAllocator<T1, LockingTag> other;
+  };
+
+  STLPageHeapAllocator() { }
+  STLPageHeapAllocator(const STLPageHeapAllocator&) { }
+  template <class T1> STLPageHeapAllocator(
+      const STLPageHeapAllocator<T1, LockingTag>&) { }
+  ~STLPageHeapAllocator() { }
+
+  pointer address(reference x) const { return &x; }
+  const_pointer address(const_reference x) const { return &x; }
+
+  size_type max_size() const { return size_t(-1) / sizeof(T); }
+
+  void construct(pointer p, const T& val) { ::new(p) T(val); }
+  void construct(pointer p) { ::new(p) T(); }
+  void destroy(pointer p) { p->~T(); }
+
+  // There's no state, so these allocators are always equal
+  bool operator==(const STLPageHeapAllocator&) const { return true; }
+  bool operator!=(const STLPageHeapAllocator&) const { return false; }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (!underlying_.initialized) {
+      underlying_.allocator.Init();
+      underlying_.initialized = true;
+    }
+
+    CHECK_CONDITION(n == 1);
+    return underlying_.allocator.New();
+  }
+  void deallocate(pointer p, size_type n) {
+    CHECK_CONDITION(n == 1);
+    underlying_.allocator.Delete(p);
+  }
+
+ private:
+  // The containers using this allocator are themselves static (PageHeap
+  // lives in Static), so the storage must be usable before constructors
+  // run: it relies on zero-initialization of the static below.
+  struct Storage {
+    explicit Storage(base::LinkerInitialized) { }
+    PageHeapAllocator<T> allocator;
+    bool initialized;
+  };
+  static Storage underlying_;
+};
+
+template <typename T, class LockingTag>
+typename STLPageHeapAllocator<T, LockingTag>::Storage
+    STLPageHeapAllocator<T, LockingTag>::underlying_(base::LINKER_INITIALIZED);
+
 }  // namespace tcmalloc
 
 #endif  // TCMALLOC_PAGE_HEAP_ALLOCATOR_H_
@@ -39,6 +39,10 @@
 // a three-level radix tree that strips away approximately 1/3rd of
 // the bits every time.
 //
+// Next to each pointer, the maps also keep a byte for the size class
+// of the page, so that free() can get it with one walk and without
+// touching the span.
+//
 // The BITS parameter should be the number of bits required to hold
 // a page number.  E.g., with 32 bit pointers and 4K pages (i.e.,
 // page offset fits in lower 12 bits), BITS == 20.
@@ -59,6 +63,12 @@
 #endif
 #include "internal_logging.h"  // for ASSERT
 
+#if defined(__GNUC__)
+#define PAGEMAP_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PAGEMAP_PREFETCH(addr)
+#endif
+
 // Single-level array
 template <int BITS>
 class TCMalloc_PageMap1 {
@@ -66,6 +76,7 @@ class TCMalloc_PageMap1 {
   static const int LENGTH = 1 << BITS;
 
   void** array_;
+  unsigned char* sizeclass_;
 
  public:
   typedef uintptr_t Number;
@@ -73,6 +84,8 @@ class TCMalloc_PageMap1 {
   explicit TCMalloc_PageMap1(void* (*allocator)(size_t)) {
     array_ = reinterpret_cast<void**>((*allocator)(sizeof(void*) << BITS));
     memset(array_, 0, sizeof(void*) << BITS);
+    sizeclass_ = reinterpret_cast<unsigned char*>((*allocator)(LENGTH));
+    memset(sizeclass_, 0, LENGTH);
   }
 
   // Ensure that the map contains initialized entries "x .. x+n-1".
@@ -104,6 +117,28 @@ class TCMalloc_PageMap1 {
     array_[k] = v;
   }
 
+  // Return the size class set for KEY.  Returns 0 if not yet set, or
+  // if k is out of range.
+  size_t sizeclass(Number k) const {
+    if ((k >> BITS) > 0) {
+      return 0;
+    }
+    return sizeclass_[k];
+  }
+
+  // REQUIRES "k" is in range "[0,2^BITS-1]".
+  // REQUIRES "k" has been ensured before.
+  void set_sizeclass(Number k, size_t cl) {
+    sizeclass_[k] = static_cast<unsigned char>(cl);
+  }
+
+  // Start loading the size class for KEY into the cache.
+  void PrefetchSizeClass(Number k) const {
+    if ((k >> BITS) == 0) {
+      PAGEMAP_PREFETCH(&sizeclass_[k]);
+    }
+  }
+
   // Return the first non-NULL pointer found in this map for
   // a page number >= k.  Returns NULL if no such number is found.
   void* Next(Number k) const {
@@ -129,6 +164,7 @@ class TCMalloc_PageMap2 {
   // Leaf node
   struct Leaf {
     void* values[LEAF_LENGTH];
+    unsigned char sizeclass[LEAF_LENGTH];
   };
 
   Leaf* root_[ROOT_LENGTH];             // Pointers to 32 child nodes
@@ -158,6 +194,30 @@ class TCMalloc_PageMap2 {
     root_[i1]->values[i2] = v;
   }
 
+  size_t sizeclass(Number k) const {
+    const Number i1 = k >> LEAF_BITS;
+    const Number i2 = k & (LEAF_LENGTH-1);
+    if ((k >> BITS) > 0 || root_[i1] == NULL) {
+      return 0;
+    }
+    return root_[i1]->sizeclass[i2];
+  }
+
+  void set_sizeclass(Number k, size_t cl) {
+    const Number i1 = k >> LEAF_BITS;
+    const Number i2 = k & (LEAF_LENGTH-1);
+    ASSERT(i1 < ROOT_LENGTH);
+    root_[i1]->sizeclass[i2] = static_cast<unsigned char>(cl);
+  }
+
+  void PrefetchSizeClass(Number k) const {
+    const Number i1 = k >> LEAF_BITS;
+    const Number i2 = k & (LEAF_LENGTH-1);
+    if ((k >> BITS) == 0 && root_[i1] != NULL) {
+      PAGEMAP_PREFETCH(&root_[i1]->sizeclass[i2]);
+    }
+  }
+
   bool Ensure(Number start, size_t n) {
     for (Number key = start; key <= start + n - 1; ) {
       const Number i1 = key >> LEAF_BITS;
@@ -224,6 +284,7 @@ class TCMalloc_PageMap3 {
   // Leaf node
   struct Leaf {
     void* values[LEAF_LENGTH];
+    unsigned char sizeclass[LEAF_LENGTH];
   };
 
   Node* root_;                          // Root of radix tree
@@ -264,6 +325,38 @@ class TCMalloc_PageMap3 {
     reinterpret_cast<Leaf*>(root_->ptrs[i1]->ptrs[i2])->values[i3] = v;
   }
 
+  size_t sizeclass(Number k) const {
+    const Number i1 = k >> (LEAF_BITS + INTERIOR_BITS);
+    const Number i2 = (k >> LEAF_BITS) & (INTERIOR_LENGTH-1);
+    const Number i3 = k & (LEAF_LENGTH-1);
+    if ((k >> BITS) > 0 ||
+        root_->ptrs[i1] == NULL || root_->ptrs[i1]->ptrs[i2] == NULL) {
+      return 0;
+    }
+    return reinterpret_cast<Leaf*>(root_->ptrs[i1]->ptrs[i2])->sizeclass[i3];
+  }
+
+  void set_sizeclass(Number k, size_t cl) {
+    ASSERT(k >> BITS == 0);
+    const Number i1 = k >> (LEAF_BITS + INTERIOR_BITS);
+    const Number i2 = (k >> LEAF_BITS) & (INTERIOR_LENGTH-1);
+    const Number i3 = k & (LEAF_LENGTH-1);
+    reinterpret_cast<Leaf*>(root_->ptrs[i1]->ptrs[i2])->sizeclass[i3] =
+        static_cast<unsigned char>(cl);
+  }
+
+  // The interior nodes are few and hot; it's the leaf that misses.
+  void PrefetchSizeClass(Number k) const {
+    const Number i1 = k >> (LEAF_BITS + INTERIOR_BITS);
+    const Number i2 = (k >> LEAF_BITS) & (INTERIOR_LENGTH-1);
+    const Number i3 = k & (LEAF_LENGTH-1);
+    if ((k >> BITS) == 0 &&
+        root_->ptrs[i1] != NULL && root_->ptrs[i1]->ptrs[i2] != NULL) {
+      PAGEMAP_PREFETCH(
+          &reinterpret_cast<Leaf*>(root_->ptrs[i1]->ptrs[i2])->sizeclass[i3]);
+    }
+  }
+
   bool Ensure(Number start, size_t n) {
     for (Number key = start; key <= start + n - 1; ) {
       const Number i1 = key >> (LEAF_BITS + INTERIOR_BITS);
@@ -321,4 +414,6 @@ class TCMalloc_PageMap3 {
   }
 };
 
+#undef PAGEMAP_PREFETCH
+
 #endif  // TCMALLOC_PAGEMAP_H_
@@ -0,0 +1,156 @@
+// -*- Mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*-
+// Copyright (c) 2008, Google Inc.
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// ---
+// The stack high-water mark for SafeInit frame clearing: see
+// gperftools/safeinit_stack.h.  It lives here, rather than in a runtime
+// of its own, since every SafeInit binary links against us anyway.
+
+#include <config.h>
+#include <gperftools/safeinit_stack.h>
+
+#if defined(__linux__) && defined(__x86_64__) && defined(HAVE_TLS)
+
+#include <pthread.h>                    // for pthread_getattr_np, etc
+#include <signal.h>                     // for sigaltstack, stack_t
+#include <stddef.h>                     // for size_t, NULL
+#include <stdint.h>                     // for uintptr_t
+#include <sys/mman.h>                   // for madvise, mmap, munmap
+#include <unistd.h>                     // for getpagesize
+
+#include "internal_logging.h"           // for Log, kLog
+
+// What the compiled code reads and writes, as initial-exec TLS (so we must
+// be loaded at startup): the thread's stack is zero from base up to
+// base + mark.  A mark of 0 means nothing is known.
+struct SafeInitStack {
+  uintptr_t base;
+  uintptr_t mark;
+};
+extern "C" PERFTOOLS_DLL_DECL __thread SafeInitStack __safeinit_stack
+    __attribute__ ((tls_model ("initial-exec")));
+__thread SafeInitStack __safeinit_stack;
+
+namespace {
+
+const size_t kSignalStackSize = 64 << 10;
+
+// Whether the thread has an alternate signal stack: one the program set up,
+// or ours, which a TSD destructor unmaps when the thread exits.
+__thread bool signal_stack_ready = false;
+pthread_key_t signal_stack_key;
+pthread_once_t signal_stack_once = PTHREAD_ONCE_INIT;
+
+void FreeSignalStack(void* stack) {
+  stack_t ss;
+  ss.ss_sp = NULL;
+  ss.ss_size = 0;
+  ss.ss_flags = SS_DISABLE;
+  sigaltstack(&ss, NULL);
+  munmap(stack, kSignalStackSize);
+}
+
+void CreateSignalStackKey() {
+  pthread_key_create(&signal_stack_key, FreeSignalStack);
+}
+
+void SetUpSignalStack() {
+  signal_stack_ready = true;
+  // Keep an alternate signal stack the program installed itself.
+  stack_t old;
+  if (sigaltstack(NULL, &old) != 0) {
+    tcmalloc::Log(tcmalloc::kCrash, __FILE__, __LINE__,
+                  "can't get the signal stack");
+  }
+  if (!(old.ss_flags & SS_DISABLE)) {
+    return;
+  }
+
+  pthread_once(&signal_stack_once, CreateSignalStackKey);
+  void* stack = mmap(NULL, kSignalStackSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (stack == MAP_FAILED) {
+    tcmalloc::Log(tcmalloc::kCrash, __FILE__, __LINE__,
+                  "can't map a signal stack");
+  }
+  stack_t ss;
+  ss.ss_sp = stack;
+  ss.ss_size = kSignalStackSize;
+  ss.ss_flags = 0;
+  if (sigaltstack(&ss, NULL) != 0) {
+    tcmalloc::Log(tcmalloc::kCrash, __FILE__, __LINE__,
+                  "can't set the signal stack");
+  }
+  pthread_setspecific(signal_stack_key, stack);
+}
+
+}  // namespace
+
+// Everything below our own frame (rounded down to a page) is zeroed by
+// dropping the pages; madvise itself writes nothing to the stack, and the
+// little stack it uses as a function is within the page we leave.
+extern "C" PERFTOOLS_DLL_DECL __attribute__ ((noinline))
+void __safeinit_stack_reset(void) {
+  if (!signal_stack_ready) {
+    SetUpSignalStack();
+  }
+  if (!__safeinit_stack.base) {
+    pthread_attr_t attr;
+    void* addr;
+    size_t size;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+      return;
+    }
+    pthread_attr_getstack(&attr, &addr, &size);
+    pthread_attr_destroy(&attr);
+    __safeinit_stack.base = reinterpret_cast<uintptr_t>(addr);
+  }
+
+  const uintptr_t page_size = getpagesize();
+  uintptr_t end =
+      (reinterpret_cast<uintptr_t>(__builtin_frame_address(0)) &
+       ~(page_size - 1)) - page_size;
+  if (end <= __safeinit_stack.base) {
+    __safeinit_stack.mark = 0;
+    return;
+  }
+  // (Pages the stack never grew into fail with ENOMEM, but read as zero.)
+  madvise(reinterpret_cast<void*>(__safeinit_stack.base),
+          end - __safeinit_stack.base, MADV_DONTNEED);
+  __safeinit_stack.mark = end - __safeinit_stack.base;
+}
+
+#else
+
+// Nothing is built with the mark here.
+extern "C" PERFTOOLS_DLL_DECL void __safeinit_stack_reset(void) {
+}
+
+#endif
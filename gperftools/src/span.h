@@ -37,21 +37,61 @@
 #define TCMALLOC_SPAN_H_
 
 #include <config.h>
+#include <set>
 #include "common.h"
+#include "page_heap_allocator.h"
 
 namespace tcmalloc {
 
+struct Span;
+
+// Store a pointer to a span along with a cached copy of its length.
+// These are used as set elements to improve the performance of
+// comparisons during tree traversal: the lengths are inline with the
+// tree nodes and thus avoid expensive cache misses to dereference
+// the actual Span objects in most cases.
+struct SpanPtrWithLength {
+  explicit SpanPtrWithLength(Span* s);
+
+  Span* span;
+  Length length;
+};
+// Orders spans by length, then by address: the first span not less than
+// a span of length n found this way is the address-ordered best fit.
+struct SpanBestFitLess {
+  bool operator()(SpanPtrWithLength a, SpanPtrWithLength b) const;
+};
+
+typedef std::set<SpanPtrWithLength, SpanBestFitLess,
+                 STLPageHeapAllocator<SpanPtrWithLength, void> > SpanSet;
+
 // Information kept for a span (a contiguous run of pages).
+// The fields the page heap looks at when it splits and merges spans come
+// first, in the first 24 bytes.
 struct Span {
   PageID        start;          // Starting page number
   Length        length;         // Number of pages in span
-  Span*         next;           // Used when in link list
-  Span*         prev;           // Used when in link list
-  void*         objects;        // Linked list of free objects
   unsigned int  refcount : 16;  // Number of non-free objects
   unsigned int  sizeclass : 8;  // Size-class for small objects (or 0)
   unsigned int  location : 2;   // Is the span on a freelist, and if so, which?
   unsigned int  sample : 1;     // Sampled object?
+  unsigned int  zeroed : 1;     // Were the pages known to be zero when carved?
+  unsigned int  node : 2;       // NUMA node (mod kMaxNumaNodes) of the pages
+  unsigned int  queued : 1;     // IN_USE, but free: see PageHeap::Delete()
+  unsigned int  has_span_iter : 1;  // Iff span_iter_space holds an iterator
+  unsigned short home : 15;     // Remote-free queue of the thread that
+                                // carved it up (or 0): see PushRemoteFree()
+  unsigned short direct : 1;    // Mapped for itself: see PageHeap::NewDirect()
+  Span*         next;           // Used when in link list
+  Span*         prev;           // Used when in link list
+  union {
+    void*       objects;        // Linked list of free objects
+    // Position in the page heap's SpanSet, while a free span of length
+    // >= kMaxPages is on it; see SetSpanSetIterator().
+    char        span_iter_space[sizeof(SpanSet::iterator)];
+  };
+  char*         untouched;      // Never handed out (and still zero if the
+                                // span is zeroed), or NULL
 
 #undef SPAN_HISTORY
 #ifdef SPAN_HISTORY
@@ -63,8 +103,37 @@ struct Span {
 
   // What freelist the span is on: IN_USE if on none, or normal or returned
   enum { IN_USE, ON_NORMAL_FREELIST, ON_RETURNED_FREELIST };
+
+  // Remember where in its SpanSet this span was inserted, so removing it
+  // doesn't need another O(log n) search.
+  void SetSpanSetIterator(const SpanSet::iterator& iter) {
+    ASSERT(!has_span_iter);
+    has_span_iter = 1;
+    new (span_iter_space) SpanSet::iterator(iter);
+  }
+
+  // Prerequisite: SetSpanSetIterator() was called since the last extract.
+  SpanSet::iterator ExtractSpanSetIterator() {
+    ASSERT(has_span_iter);
+    has_span_iter = 0;
+    return *reinterpret_cast<SpanSet::iterator*>(span_iter_space);
+  }
 };
 
+inline SpanPtrWithLength::SpanPtrWithLength(Span* s)
+    : span(s),
+      length(s->length) {
+}
+
+inline bool SpanBestFitLess::operator()(SpanPtrWithLength a,
+                                        SpanPtrWithLength b) const {
+  if (a.length < b.length)
+    return true;
+  if (a.length > b.length)
+    return false;
+  return a.span->start < b.span->start;
+}
+
 #ifdef SPAN_HISTORY
 void Event(Span* span, char op, int v = 0);
 #else
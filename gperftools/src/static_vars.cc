@@ -41,6 +41,7 @@
 #include "internal_logging.h"  // for CHECK_CONDITION
 #include "common.h"
 #include "sampler.h"           // for Sampler
+#include "thread_cache.h"      // for ThreadCache
 #include "getenv_safe.h"       // TCMallocGetenvSafe
 #include "base/googleinit.h"
 #include "maybe_threads.h"
@@ -54,6 +55,8 @@ namespace tcmalloc {
 
 void CentralCacheLockAll()
 {
+  ThreadCache::LockCpuCaches();
+  if (Static::pageheap() != NULL) Static::pageheap()->release_lock()->Lock();
   Static::pageheap_lock()->Lock();
   for (int i = 0; i < kNumClasses; ++i)
     Static::central_cache()[i].Lock();
@@ -64,21 +67,26 @@ void CentralCacheUnlockAll()
   for (int i = 0; i < kNumClasses; ++i)
     Static::central_cache()[i].Unlock();
   Static::pageheap_lock()->Unlock();
+  if (Static::pageheap() != NULL) Static::pageheap()->release_lock()->Unlock();
+  ThreadCache::UnlockCpuCaches();
 }
 #endif
 
 SpinLock Static::pageheap_lock_(SpinLock::LINKER_INITIALIZED);
 SizeMap Static::sizemap_;
 CentralFreeListPadded Static::central_cache_[kNumClasses];
-PageHeapAllocator<Span> Static::span_allocator_;
+Static::SpanAllocator Static::span_allocator_;
 PageHeapAllocator<StackTrace> Static::stacktrace_allocator_;
 Span Static::sampled_objects_;
 PageHeapAllocator<StackTraceTable::Bucket> Static::bucket_allocator_;
 StackTrace* Static::growth_stacks_ = NULL;
+Static::SampledAllocHook Static::sampled_alloc_hook_ = NULL;
+Static::SampledFreeHook Static::sampled_free_hook_ = NULL;
 PageHeap* Static::pageheap_ = NULL;
 
 
 void Static::InitStaticVars() {
+  InitZeroKernel();
   sizemap_.Init();
   span_allocator_.Init();
   span_allocator_.New(); // Reduce cache conflicts
@@ -101,9 +109,22 @@ void Static::InitStaticVars() {
     tcmalloc::commandlineflags::StringToBool(
       TCMallocGetenvSafe("TCMALLOC_AGGRESSIVE_DECOMMIT"), true);
 
-  assert(aggressive_decommit);
   pageheap_->SetAggressiveDecommit(aggressive_decommit);
 
+  // (the flags aren't necessarily set up yet, so read the environment)
+  pageheap_->SetDirectThreshold(
+    tcmalloc::commandlineflags::StringToLongLong(
+      TCMallocGetenvSafe("TCMALLOC_DIRECT_MMAP_THRESHOLD"),
+      PageHeap::kDefaultDirectThreshold));
+
+  const long long prefault_bytes =
+    tcmalloc::commandlineflags::StringToLongLong(
+      TCMallocGetenvSafe("TCMALLOC_PREFAULT_BYTES"), 0);
+  if (prefault_bytes > 0 && !pageheap_->Prefault(prefault_bytes)) {
+    Log(kLog, __FILE__, __LINE__,
+        "tcmalloc: couldn't prefault (bytes)", prefault_bytes);
+  }
+
   DLL_Init(&sampled_objects_);
   Sampler::InitStatics();
 }
@@ -111,13 +132,21 @@ void Static::InitStaticVars() {
 
 #if defined(HAVE_FORK) && defined(HAVE_PTHREAD) && !defined(__APPLE__)
 
+// The child doesn't inherit the background release thread (if any), so
+// it releases memory itself.
+static void CentralCacheUnlockAllInChild()
+{
+  Static::pageheap()->SetBackgroundRelease(false);
+  CentralCacheUnlockAll();
+}
+
 static inline
 void SetupAtForkLocksHandler()
 {
   perftools_pthread_atfork(
     CentralCacheLockAll,    // parent calls before fork
     CentralCacheUnlockAll,  // parent calls after fork
-    CentralCacheUnlockAll); // child calls after fork
+    CentralCacheUnlockAllInChild); // child calls after fork
 }
 REGISTER_MODULE_INITIALIZER(tcmalloc_fork_handler, SetupAtForkLocksHandler());
 
@@ -68,7 +68,13 @@ class Static {
   // Page-level allocator.
   static PageHeap* pageheap() { return pageheap_; }
 
-  static PageHeapAllocator<Span>* span_allocator() { return &span_allocator_; }
+  // Spans come from slabs of one huge page each, rather than from small
+  // chunks interleaved with the other metadata, so that the spans the page
+  // heap walks over are close together (and, with TCMALLOC_HUGEPAGES, take
+  // few TLB misses).
+  static const int kSpanSlabSize = 2 << 20;
+  typedef PageHeapAllocator<Span, kSpanSlabSize> SpanAllocator;
+  static SpanAllocator* span_allocator() { return &span_allocator_; }
 
   static PageHeapAllocator<StackTrace>* stacktrace_allocator() {
     return &stacktrace_allocator_;
@@ -83,6 +89,19 @@ class Static {
     return &bucket_allocator_;
   }
 
+  // Callbacks for the heap profiler's sampled mode (HEAP_PROFILE_SAMPLED):
+  // if set, called for each sampled allocation once it is made, and for
+  // each sampled object before it is freed, without pageheap_lock held.
+  typedef void (*SampledAllocHook)(const void* ptr, const StackTrace& stack);
+  typedef void (*SampledFreeHook)(const void* ptr);
+  static SampledAllocHook sampled_alloc_hook() { return sampled_alloc_hook_; }
+  static SampledFreeHook sampled_free_hook() { return sampled_free_hook_; }
+  static void set_sampled_hooks(SampledAllocHook alloc_hook,
+                                SampledFreeHook free_hook) {
+    sampled_alloc_hook_ = alloc_hook;
+    sampled_free_hook_ = free_hook;
+  }
+
   // Check if InitStaticVars() has been run.
   static bool IsInited() { return pageheap() != NULL; }
 
@@ -96,7 +115,7 @@ class Static {
 
   static SizeMap sizemap_;
   static CentralFreeListPadded central_cache_[kNumClasses];
-  static PageHeapAllocator<Span> span_allocator_;
+  static SpanAllocator span_allocator_;
   static PageHeapAllocator<StackTrace> stacktrace_allocator_;
   static Span sampled_objects_;
   static PageHeapAllocator<StackTraceTable::Bucket> bucket_allocator_;
@@ -107,6 +126,9 @@ class Static {
   // is stored in trace->stack[kMaxStackDepth-1].
   static StackTrace* growth_stacks_;
 
+  static SampledAllocHook sampled_alloc_hook_;
+  static SampledFreeHook sampled_free_hook_;
+
   static PageHeap* pageheap_;
 };
 
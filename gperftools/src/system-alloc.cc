@@ -48,6 +48,9 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>                     // for sbrk, getpagesize, off_t
 #endif
+#ifdef HAVE_SYS_SYSCALL_H
+#include <sys/syscall.h>                // for SYS_getcpu, SYS_mbind
+#endif
 #include <new>                          // for operator new
 #include <assert.h>
 #include <gperftools/malloc_extension.h>
@@ -66,7 +69,18 @@
 // MADV_FREE is specifically designed for use by malloc(), but only
 // FreeBSD supports it; in linux we fall back to the somewhat inferior
 // MADV_DONTNEED.
-#if !defined(MADV_FREE) && defined(MADV_DONTNEED)
+// We rely on released pages reading back as zero, though, and newer linux
+// MADV_FREE releases pages lazily (so they may keep their old contents);
+// so on linux we use MADV_DONTNEED unless lazy freeing was asked for (see
+// TCMalloc_SystemReleaseIsLazy).
+#if defined(__linux__) && defined(MADV_DONTNEED)
+# ifdef MADV_FREE
+#  define HAVE_MADV_LAZYFREE 1
+static const int kMadvLazyFree = MADV_FREE;
+# endif
+# undef MADV_FREE
+# define MADV_FREE  MADV_DONTNEED
+#elif !defined(MADV_FREE) && defined(MADV_DONTNEED)
 # define MADV_FREE  MADV_DONTNEED
 #endif
 
@@ -139,6 +153,23 @@ DEFINE_bool(malloc_disable_memory_release,
             EnvToBool("TCMALLOC_DISABLE_MEMORY_RELEASE", false),
             "Whether MADV_FREE/MADV_DONTNEED should be used"
             " to return unused memory to the system.");
+DEFINE_bool(malloc_lazy_free,
+            EnvToBool("TCMALLOC_LAZY_FREE", false),
+            "Whether memory should be returned to the system lazily (with"
+            " linux's MADV_FREE), so the kernel only takes it back under"
+            " memory pressure.  Pages it didn't take are zeroed on reuse.");
+DEFINE_bool(malloc_hugepages,
+            EnvToBool("TCMALLOC_HUGEPAGES", false),
+            "Whether large regions should be obtained from the system"
+            " aligned to, and backed by, transparent huge pages.");
+DEFINE_bool(malloc_numa,
+            EnvToBool("TCMALLOC_NUMA", false),
+            "Whether memory should be bound to the NUMA node of the thread"
+            " that gets it from the system, and free pages reused on the"
+            " node they are on.");
+
+// Size of a transparent huge page.
+static const size_t kHugePageSize = 2 << 20;
 
 // static allocators
 class SbrkSysAllocator : public SysAllocator {
@@ -146,6 +177,8 @@ public:
   SbrkSysAllocator() : SysAllocator() {
   }
   void* Alloc(size_t size, size_t *actual_size, size_t alignment);
+  void* AllocMaybeZeroed(size_t size, size_t *actual_size, size_t alignment,
+                         bool* zeroed);
 };
 static char sbrk_space[sizeof(SbrkSysAllocator)];
 
@@ -154,6 +187,11 @@ public:
   MmapSysAllocator() : SysAllocator() {
   }
   void* Alloc(size_t size, size_t *actual_size, size_t alignment);
+  void* AllocMaybeZeroed(size_t size, size_t *actual_size, size_t alignment,
+                         bool* zeroed) {
+    *zeroed = true;
+    return Alloc(size, actual_size, alignment);
+  }
 };
 static char mmap_space[sizeof(MmapSysAllocator)];
 
@@ -182,6 +220,8 @@ class DefaultSysAllocator : public SysAllocator {
     }
   }
   void* Alloc(size_t size, size_t *actual_size, size_t alignment);
+  void* AllocMaybeZeroed(size_t size, size_t *actual_size, size_t alignment,
+                         bool* zeroed);
 
  private:
   static const int kMaxAllocators = 2;
@@ -265,6 +305,22 @@ void* SbrkSysAllocator::Alloc(size_t size, size_t *actual_size,
 #endif  // HAVE_SBRK
 }
 
+void* SbrkSysAllocator::AllocMaybeZeroed(size_t size, size_t *actual_size,
+                                         size_t alignment, bool* zeroed) {
+  void* result = Alloc(size, actual_size, alignment);
+#ifdef __linux__
+  // Linux unmaps the pages above the break when it goes down, so pages
+  // wholly above it come fresh.  (The page the break was in may keep
+  // whatever was stored there before the break last went down, and other
+  // systems may keep more.)
+  if (pagesize == 0) pagesize = getpagesize();
+  *zeroed = (reinterpret_cast<uintptr_t>(result) & (pagesize - 1)) == 0;
+#else
+  *zeroed = false;
+#endif
+  return result;
+}
+
 void* MmapSysAllocator::Alloc(size_t size, size_t *actual_size,
                               size_t alignment) {
 #ifndef HAVE_MMAP
@@ -424,9 +480,16 @@ void* DevMemSysAllocator::Alloc(size_t size, size_t *actual_size,
 
 void* DefaultSysAllocator::Alloc(size_t size, size_t *actual_size,
                                  size_t alignment) {
+  bool zeroed;
+  return AllocMaybeZeroed(size, actual_size, alignment, &zeroed);
+}
+
+void* DefaultSysAllocator::AllocMaybeZeroed(size_t size, size_t *actual_size,
+                                            size_t alignment, bool* zeroed) {
   for (int i = 0; i < kMaxAllocators; i++) {
     if (!failed_[i] && allocs_[i] != NULL) {
-      void* result = allocs_[i]->Alloc(size, actual_size, alignment);
+      void* result = allocs_[i]->AllocMaybeZeroed(size, actual_size,
+                                                  alignment, zeroed);
       if (result != NULL) {
         return result;
       }
@@ -472,7 +535,7 @@ void InitSystemAllocators(void) {
 }
 
 void* TCMalloc_SystemAlloc(size_t size, size_t *actual_size,
-                           size_t alignment) {
+                           size_t alignment, bool* zeroed) {
   // Discard requests that overflow
   if (size + alignment < size) return NULL;
 
@@ -486,29 +549,140 @@ void* TCMalloc_SystemAlloc(size_t size, size_t *actual_size,
   // Enforce minimum alignment
   if (alignment < sizeof(MemoryAligner)) alignment = sizeof(MemoryAligner);
 
+  // Hand out whole, aligned huge pages for large regions
+  const bool huge = FLAGS_malloc_hugepages && size >= kHugePageSize;
+  if (huge) {
+    const size_t huge_size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    if (huge_size < size) return NULL;
+    size = huge_size;
+    if (alignment < kHugePageSize) alignment = kHugePageSize;
+  }
+
   size_t actual_size_storage;
   if (actual_size == NULL) {
     actual_size = &actual_size_storage;
   }
 
-  void* result = sys_alloc->Alloc(size, actual_size, alignment);
+  bool zeroed_storage;
+  if (zeroed == NULL) {
+    zeroed = &zeroed_storage;
+  }
+
+  void* result = sys_alloc->AllocMaybeZeroed(size, actual_size, alignment,
+                                             zeroed);
   if (result != NULL) {
     CHECK_CONDITION(
       CheckAddressBits<kAddressBits>(
         reinterpret_cast<uintptr_t>(result) + *actual_size - 1));
     TCMalloc_SystemTaken += *actual_size;
+#ifdef MADV_HUGEPAGE
+    // (just a hint; hugetlbfs-backed memory is huge pages already)
+    if (huge) madvise(result, *actual_size, MADV_HUGEPAGE);
+#endif
   }
   return result;
 }
 
+int TCMalloc_SystemNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu) && defined(SYS_mbind)
+  if (!FLAGS_malloc_numa) return -1;
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) return -1;
+  return node;
+#else
+  return -1;
+#endif
+}
+
+void TCMalloc_SystemBindToNode(void* start, size_t length, int node) {
+#if defined(__linux__) && defined(SYS_getcpu) && defined(SYS_mbind)
+  // (from <numaif.h>, which needs libnuma)
+  static const int kMpolPreferred = 1;
+  if (node < 0 || node >= 8 * sizeof(unsigned long)) return;
+  unsigned long nodemask = 1UL << node;
+  // Only a preference: if the node runs out, the kernel goes elsewhere.
+  syscall(SYS_mbind, start, length, kMpolPreferred, &nodemask,
+          8 * sizeof(nodemask), 0);
+#endif
+}
+
+void TCMalloc_SystemPopulate(void* start, size_t length) {
+  if (pagesize == 0) pagesize = getpagesize();
+#if defined(__linux__) && defined(HAVE_MMAP)
+  // MADV_POPULATE_WRITE (linux 5.14) does them all in one go.  (Unlike
+  // MADV_WILLNEED, which doesn't fault in anonymous memory.)
+  static const int kMadvPopulateWrite = 23;
+  if (madvise(start, length, kMadvPopulateWrite) == 0) return;
+#endif
+  // Otherwise touch each page, storing back what's there.
+  char* const end = reinterpret_cast<char*>(start) + length;
+  for (char* p = reinterpret_cast<char*>(start); p < end; p += pagesize) {
+    volatile char* v = p;
+    *v = *v;
+  }
+}
+
+size_t TCMalloc_SystemHugePageSize() {
+  return FLAGS_malloc_hugepages ? kHugePageSize : 0;
+}
+
+#ifdef HAVE_MADV_LAZYFREE
+// Set if lazy freeing turned out not to work.
+static bool lazy_free_unsupported = false;
+#endif
+
+bool TCMalloc_SystemReleaseIsLazy() {
+#ifdef HAVE_MADV_LAZYFREE
+  return FLAGS_malloc_lazy_free && !lazy_free_unsupported;
+#else
+  return false;
+#endif
+}
+
+// Set once memory is to be zeroed in place rather than released.
+static bool release_in_place = false;
+
+bool TCMalloc_SystemReleaseIsInPlace() {
+  return release_in_place;
+}
+
+void TCMalloc_SystemSetReleaseInPlace() {
+  release_in_place = true;
+}
+
+bool TCMalloc_SystemIsReclaimed(void* start, size_t length) {
+#if defined(HAVE_MMAP) && defined(HAVE_MADV_LAZYFREE)
+  // A page the kernel took back isn't resident, and any page that isn't
+  // resident reads back as zero.
+  if (pagesize == 0) pagesize = getpagesize();
+  static const size_t kChunkPages = 256;
+  unsigned char vec[kChunkPages];
+  char* p = reinterpret_cast<char*>(start);
+  char* const end = p + length;
+  while (p < end) {
+    size_t n = (end - p + pagesize - 1) / pagesize;
+    if (n > kChunkPages) n = kChunkPages;
+    if (mincore(p, n * pagesize, vec) != 0) return false;
+    for (size_t i = 0; i < n; ++i) {
+      if (vec[i] & 1) return false;
+    }
+    p += n * pagesize;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 bool TCMalloc_SystemRelease(void* start, size_t length) {
 #ifdef MADV_FREE
   if (FLAGS_malloc_devmem_start) {
     // It's not safe to use MADV_FREE/MADV_DONTNEED if we've been
     // mapping /dev/mem for heap memory.
-    abort(); // return false;
+    return false;
   }
-  if (FLAGS_malloc_disable_memory_release) abort(); // return false;
+  if (FLAGS_malloc_disable_memory_release) return false;
+  if (release_in_place) return false;
   if (pagesize == 0) pagesize = getpagesize();
   const size_t pagemask = pagesize - 1;
 
@@ -533,6 +707,17 @@ bool TCMalloc_SystemRelease(void* start, size_t length) {
 
   if (new_end > new_start) {
     int result;
+#ifdef HAVE_MADV_LAZYFREE
+    if (TCMalloc_SystemReleaseIsLazy()) {
+      do {
+        result = madvise(reinterpret_cast<char*>(new_start),
+            new_end - new_start, kMadvLazyFree);
+      } while (result == -1 && errno == EAGAIN);
+      if (result != -1) return true;
+      // (the kernel predates MADV_FREE: don't try again)
+      if (errno == EINVAL) lazy_free_unsupported = true;
+    }
+#endif
     do {
       result = madvise(reinterpret_cast<char*>(new_start),
           new_end - new_start, MADV_FREE);
@@ -551,3 +736,40 @@ void TCMalloc_SystemCommit(void* start, size_t length) {
   // such that they need to be re-committed before they can be used by the
   // application.
 }
+
+void* TCMalloc_SystemMap(size_t size, size_t alignment) {
+#ifndef HAVE_MMAP
+  return NULL;
+#else
+  if (FLAGS_malloc_skip_mmap || release_in_place) return NULL;
+  if (pagesize == 0) pagesize = getpagesize();
+  if (alignment < pagesize) alignment = pagesize;
+  // (like MmapSysAllocator::Alloc: map extra, and trim it to alignment)
+  const size_t extra = alignment - pagesize;
+  if (size + extra < size) return NULL;
+  void* result = mmap(NULL, size + extra, PROT_READ|PROT_WRITE,
+                      MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+  if (result == reinterpret_cast<void*>(MAP_FAILED)) return NULL;
+  uintptr_t ptr = reinterpret_cast<uintptr_t>(result);
+  const size_t adjust = (alignment - (ptr & (alignment - 1))) & (alignment - 1);
+  if (adjust > 0) {
+    munmap(reinterpret_cast<void*>(ptr), adjust);
+  }
+  if (adjust < extra) {
+    munmap(reinterpret_cast<void*>(ptr + adjust + size), extra - adjust);
+  }
+  ptr += adjust;
+  CHECK_CONDITION(CheckAddressBits<kAddressBits>(ptr + size - 1));
+  SpinLockHolder lock_holder(&spinlock);
+  TCMalloc_SystemTaken += size;
+  return reinterpret_cast<void*>(ptr);
+#endif  // HAVE_MMAP
+}
+
+void TCMalloc_SystemUnmap(void* start, size_t size) {
+#ifdef HAVE_MMAP
+  munmap(start, size);
+  SpinLockHolder lock_holder(&spinlock);
+  TCMalloc_SystemTaken -= size;
+#endif
+}
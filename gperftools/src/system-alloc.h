@@ -58,9 +58,12 @@ class SysAllocator;
 // aligned.
 //
 // Returns NULL when out of memory.
+//
+// If "zeroed" is non-NULL, sets "*zeroed" to whether the memory is known
+// to read as zero (see SysAllocator::AllocMaybeZeroed).
 extern PERFTOOLS_DLL_DECL
 void* TCMalloc_SystemAlloc(size_t bytes, size_t *actual_bytes,
-			   size_t alignment = 0);
+			   size_t alignment = 0, bool* zeroed = NULL);
 
 // This call is a hint to the operating system that the pages
 // contained in the specified range of memory will not be used for a
@@ -76,6 +79,31 @@ void* TCMalloc_SystemAlloc(size_t bytes, size_t *actual_bytes,
 extern PERFTOOLS_DLL_DECL
 bool TCMalloc_SystemRelease(void* start, size_t length);
 
+// Returns true if memory released with TCMalloc_SystemRelease may keep
+// its contents, because the OS only reclaims it when it needs to (as
+// with linux's MADV_FREE, which TCMALLOC_LAZY_FREE asks for).
+extern PERFTOOLS_DLL_DECL
+bool TCMalloc_SystemReleaseIsLazy();
+
+// Returns true if memory is never to be released, but zeroed in place
+// instead when tcmalloc would release it.  This is for system allocators
+// (like memfs_malloc's) whose memory is backed by a file: releasing its
+// pages may fail, or leave them with their old contents, rather than
+// dropping them.
+extern PERFTOOLS_DLL_DECL
+bool TCMalloc_SystemReleaseIsInPlace();
+
+// Called by a system allocator whose memory can't be released (see
+// TCMalloc_SystemReleaseIsInPlace) when it is installed.
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemSetReleaseInPlace();
+
+// Returns true if all of the pages in the specified range of (released)
+// memory are known to have been reclaimed by the OS, and so read back
+// as zero.  May return false if this can't be told.
+extern PERFTOOLS_DLL_DECL
+bool TCMalloc_SystemIsReclaimed(void* start, size_t length);
+
 // Called to ressurect memory which has been previously released
 // to the system via TCMalloc_SystemRelease.  An attempt to
 // commit a page that is already committed does not cause this
@@ -83,6 +111,42 @@ bool TCMalloc_SystemRelease(void* start, size_t length);
 extern PERFTOOLS_DLL_DECL
 void TCMalloc_SystemCommit(void* start, size_t length);
 
+// Returns the size of the (transparent) huge pages large regions are
+// aligned to and backed with, or 0 if huge pages are not in use.  Spans
+// of at least this size are kept committed, and zeroed in place when
+// they are reused, rather than released (which would split the huge
+// pages up again).
+extern PERFTOOLS_DLL_DECL
+size_t TCMalloc_SystemHugePageSize();
+
+// Returns the NUMA node of the CPU the calling thread is running on, or
+// -1 if NUMA awareness (TCMALLOC_NUMA) is off or not supported.
+extern PERFTOOLS_DLL_DECL
+int TCMalloc_SystemNumaNode();
+
+// Asks the OS to back the specified range of memory with pages from the
+// given NUMA node, where possible (including when released pages are
+// faulted back in).
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemBindToNode(void* start, size_t length, int node);
+
+// Faults in the pages of the specified range of memory, for writing,
+// without changing their contents.
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemPopulate(void* start, size_t length);
+
+// Maps "bytes" of fresh, zeroed memory aligned to "alignment" (a power
+// of two) straight from the OS, bypassing the system allocator, for
+// PageHeap::NewDirect().  Returns NULL if that's not possible (without
+// mmap, or with a system allocator whose memory is backed by a file; see
+// TCMalloc_SystemReleaseIsInPlace), or if the OS is out of memory.
+extern PERFTOOLS_DLL_DECL
+void* TCMalloc_SystemMap(size_t bytes, size_t alignment);
+
+// Gives memory returned by TCMalloc_SystemMap back to the OS.
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemUnmap(void* start, size_t bytes);
+
 // The current system allocator.
 extern PERFTOOLS_DLL_DECL SysAllocator* sys_alloc;
 
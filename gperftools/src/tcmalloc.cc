@@ -63,7 +63,9 @@
 // the sizeclass is 0.  The cache may have stale information for pages that do
 // not hold the beginning of any free()'able object.  Staleness is eliminated
 // in Populate() for pages with sizeclass > 0 objects, and in do_malloc() and
-// do_memalign() for all other relevant pages.
+// do_memalign() for all other relevant pages.  Its size can be set with
+// TCMALLOC_PAGEMAP_CACHE_BITS.  On a miss, the pagemap's own per-page
+// sizeclass byte gives the answer with one walk, without loading the span.
 //
 // PAGEMAP
 // -------
@@ -107,6 +109,10 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>                     // for getpagesize, write, etc
 #endif
+#include <fcntl.h>                      // for open, O_RDWR, etc
+#ifdef HAVE_MMAP
+#include <sys/mman.h>                   // for mmap, MAP_SHARED, etc
+#endif
 #include <algorithm>                    // for max, min
 #include <limits>                       // for numeric_limits
 #include <new>                          // for nothrow_t (ptr only), etc
@@ -114,12 +120,17 @@
 
 #include <gperftools/malloc_extension.h>
 #include <gperftools/malloc_hook.h>         // for MallocHook
+#include <gperftools/malloc_stats_page.h>   // for MallocStatsPage
+#include "alloc_trace.h"           // for StartAllocationTrace, etc
+#include "base/atomicops.h"             // for Release_Store, etc
 #include "base/basictypes.h"            // for int64
 #include "base/commandlineflags.h"      // for RegisterFlagValidator, etc
 #include "base/dynamic_annotations.h"   // for RunningOnValgrind
 #include "base/spinlock.h"              // for SpinLockHolder
+#include "base/sysinfo.h"               // for SleepForMilliseconds
 #include "central_freelist.h"  // for CentralFreeListPadded
 #include "common.h"            // for StackTrace, kPageShift, etc
+#include "getenv_safe.h"       // for TCMallocGetenvSafe
 #include "internal_logging.h"  // for ASSERT, TCMalloc_Printer, etc
 #include "linked_list.h"       // for SLL_SetNext
 #include "malloc_hook-inl.h"       // for MallocHook::InvokeNewHook, etc
@@ -151,6 +162,7 @@
 #undef small
 
 using STL_NAMESPACE::max;
+using STL_NAMESPACE::min;
 using STL_NAMESPACE::numeric_limits;
 using STL_NAMESPACE::vector;
 
@@ -176,6 +188,7 @@ using tcmalloc::Span;
 using tcmalloc::StackTrace;
 using tcmalloc::Static;
 using tcmalloc::ThreadCache;
+using tcmalloc::ZeroStats;
 
 DECLARE_int64(tcmalloc_sample_parameter);
 DECLARE_double(tcmalloc_release_rate);
@@ -244,13 +257,47 @@ extern "C" {
 
   void* tc_new(size_t size)
       ATTRIBUTE_SECTION(google_malloc);
+  void* tc_new_noinit(size_t size)
+      ATTRIBUTE_SECTION(google_malloc);
   void tc_delete(void* p) __THROW
       ATTRIBUTE_SECTION(google_malloc);
   void* tc_newarray(size_t size)
       ATTRIBUTE_SECTION(google_malloc);
+  void* tc_newarray_noinit(size_t size)
+      ATTRIBUTE_SECTION(google_malloc);
   void tc_deletearray(void* p) __THROW
       ATTRIBUTE_SECTION(google_malloc);
 
+  // Batches of objects of one size.
+  size_t tc_malloc_batch(size_t size, void** ptrs, size_t n) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  size_t tc_malloc_batch_noinit(size_t size, void** ptrs, size_t n) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  void tc_free_batch(void** ptrs, size_t n, size_t size) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+
+  // Size-returning allocation.
+  void* tc_malloc_sized(size_t size, size_t* actual) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  void* tc_new_sized(size_t size, size_t* actual)
+      ATTRIBUTE_SECTION(google_malloc);
+
+  // Arenas.
+  tc_arena* tc_arena_create(size_t chunk_size) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  void* tc_arena_alloc(tc_arena* arena, size_t size) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  void tc_arena_reset(tc_arena* arena) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  void tc_arena_destroy(tc_arena* arena) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+
+  // Sized deallocation, which doesn't have to look up the size class.
+  void tc_delete_sized(void* p, size_t size) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+  void tc_deletearray_sized(void* p, size_t size) __THROW
+      ATTRIBUTE_SECTION(google_malloc);
+
   // And the nothrow variants of these:
   void* tc_new_nothrow(size_t size, const std::nothrow_t&) __THROW
       ATTRIBUTE_SECTION(google_malloc);
@@ -352,6 +399,156 @@ static void ExtractStats(TCMallocStats* r, uint64_t* class_count,
   }
 }
 
+// The page StartStatsPage() maps, if any.
+static MallocStatsPage* stats_page = NULL;
+
+// With a parallel zero threshold (TCMALLOC_PARALLEL_ZERO_THRESHOLD), the
+// memory ZeroPages() has to zero is split into chunks when there's at
+// least that much of it, and a pool of helper threads zeroes chunks along
+// with the caller, which returns once they are all done.  One range is
+// zeroed that way at a time; other callers meanwhile zero theirs alone.
+// With TCMALLOC_NUMA, helpers only take chunks of a range whose pages
+// belong to the node they're running on.
+static const size_t kParallelZeroChunk = 8 << 20;
+static const int kMaxZeroHelpers = 64;
+static size_t parallel_zero_threshold = 0;
+
+#ifdef HAVE_PTHREAD
+struct ParallelZeroJob {
+  char* start;
+  size_t size;
+  bool nontemporal;
+  int node;                // of the pages, or -1 if that doesn't matter
+  AtomicWord next_chunk;   // first chunk nobody has taken yet
+};
+
+static pthread_mutex_t zero_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t zero_posted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t zero_left = PTHREAD_COND_INITIALIZER;
+// The range being zeroed (NULL if none), how many helpers are at it,
+// and how many ranges have been posted.  Protected by zero_mutex.
+static ParallelZeroJob* zero_job = NULL;
+static int zero_job_helpers = 0;
+static uint64_t zero_jobs_posted = 0;
+// Helper threads started.  Protected by zero_mutex.
+static int zero_helper_count = 0;
+
+// Zeroes chunks of the job until there are none left.
+static void ZeroChunks(ParallelZeroJob* job) {
+  const AtomicWord chunks =
+      (job->size + kParallelZeroChunk - 1) / kParallelZeroChunk;
+  for (;;) {
+    AtomicWord chunk;
+    do {
+      chunk = base::subtle::NoBarrier_Load(&job->next_chunk);
+      if (chunk >= chunks) return;
+    } while (base::subtle::NoBarrier_CompareAndSwap(
+                 &job->next_chunk, chunk, chunk + 1) != chunk);
+    const size_t offset = chunk * kParallelZeroChunk;
+    char* const start = job->start + offset;
+    const size_t size = min(kParallelZeroChunk, job->size - offset);
+    if (job->nontemporal) {
+      tcmalloc::ZeroNonTemporal(start, size);
+    } else {
+      tcmalloc::tcmalloc_zero_object(start, size);
+    }
+  }
+}
+
+static void* ParallelZeroThread(void*) {
+  uint64_t seen = 0;
+  pthread_mutex_lock(&zero_mutex);
+  for (;;) {
+    while (zero_job == NULL || zero_jobs_posted == seen) {
+      pthread_cond_wait(&zero_posted, &zero_mutex);
+    }
+    seen = zero_jobs_posted;
+    ParallelZeroJob* job = zero_job;
+    zero_job_helpers++;
+    pthread_mutex_unlock(&zero_mutex);
+    if (job->node < 0 || Static::pageheap()->CurrentNode() == job->node) {
+      ZeroChunks(job);
+    }
+    pthread_mutex_lock(&zero_mutex);
+    if (--zero_job_helpers == 0) pthread_cond_signal(&zero_left);
+  }
+  return NULL;
+}
+
+// Helpers only ever zero, so they get small stacks rather than taking
+// the default's (often 8MiB) address space each.
+static const size_t kZeroHelperStack = 64 << 10;
+
+// Starts helpers until there are "count" of them (at most).
+static void StartParallelZeroHelpers(int count) {
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, kZeroHelperStack);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  pthread_mutex_lock(&zero_mutex);
+  while (zero_helper_count < min(count, kMaxZeroHelpers)) {
+    pthread_t thread;
+    if (pthread_create(&thread, &attr, ParallelZeroThread, NULL) != 0) {
+      Log(kLog, __FILE__, __LINE__,
+          "Could not start a parallel zeroing thread");
+      break;
+    }
+    zero_helper_count++;
+  }
+  pthread_mutex_unlock(&zero_mutex);
+  pthread_attr_destroy(&attr);
+}
+#endif  // HAVE_PTHREAD
+
+// Zeroes size bytes at ptr with the helpers' help, and returns true, or
+// returns false (having done nothing) if they're busy or there are none.
+static bool ParallelZero(void* ptr, size_t size, bool nontemporal) {
+#ifdef HAVE_PTHREAD
+  ParallelZeroJob job;
+  job.start = static_cast<char*>(ptr);
+  job.size = size;
+  job.nontemporal = nontemporal;
+  // (without TCMALLOC_NUMA every span and thread is on node 0)
+  const Span* span = Static::pageheap()->GetDescriptor(
+      reinterpret_cast<uintptr_t>(ptr) >> kPageShift);
+  job.node = (span != NULL) ? span->node : -1;
+  job.next_chunk = 0;
+
+  // (a trylock, not to queue up behind another range)
+  if (pthread_mutex_trylock(&zero_mutex) != 0) return false;
+  if (zero_job != NULL || zero_helper_count == 0) {
+    pthread_mutex_unlock(&zero_mutex);
+    return false;
+  }
+  zero_job = &job;
+  zero_jobs_posted++;
+  pthread_cond_broadcast(&zero_posted);
+  pthread_mutex_unlock(&zero_mutex);
+
+  ZeroChunks(&job);
+
+  // Once no chunks are left, wait for the helpers still zeroing theirs.
+  pthread_mutex_lock(&zero_mutex);
+  zero_job = NULL;
+  while (zero_job_helpers > 0) pthread_cond_wait(&zero_left, &zero_mutex);
+  pthread_mutex_unlock(&zero_mutex);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Sets the parallel zero threshold, starting the helpers if need be.
+static void SetParallelZeroThreshold(size_t threshold) {
+#ifdef HAVE_PTHREAD
+  if (threshold != 0) {
+    StartParallelZeroHelpers(tcmalloc::commandlineflags::StringToInt(
+        TCMallocGetenvSafe("TCMALLOC_PARALLEL_ZERO_THREADS"), 4));
+  }
+  parallel_zero_threshold = threshold;
+#endif
+}
+
 static double PagesToMiB(uint64_t pages) {
   return (pages << kPageShift) / 1048576.0;
 }
@@ -420,6 +617,22 @@ static void DumpStats(TCMalloc_Printer* out, int level) {
       uint64_t(ThreadCache::HeapsInUse()),
       uint64_t(kPageSize));
 
+  ZeroStats zero;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    ThreadCache::GetZeroStats(&zero);
+  }
+  out->printf("------------------------------------------------\n");
+  out->printf("Zeroing done, and skipped for memory known to be zero\n");
+  out->printf("------------------------------------------------\n");
+  for (int path = 0; path < ZeroStats::kNumPaths; ++path) {
+    out->printf("ZERO: %-8s : %12" PRIu64 " bytes in %10" PRIu64 " objs"
+                " zeroed; %12" PRIu64 " bytes in %10" PRIu64 " objs skipped\n",
+                ZeroStats::PathName(path),
+                zero.zeroed_bytes[path], zero.zeroed_objects[path],
+                zero.skipped_bytes[path], zero.skipped_objects[path]);
+  }
+
   if (level >= 2) {
     out->printf("------------------------------------------------\n");
     out->printf("Total size of freelists for per-thread caches,\n");
@@ -440,6 +653,19 @@ static void DumpStats(TCMalloc_Printer* out, int level) {
       }
     }
 
+    out->printf("------------------------------------------------\n");
+    out->printf("Objects zeroed and skipped, by size class"
+                " (class 0 is whole pages)\n");
+    out->printf("------------------------------------------------\n");
+    for (int cl = 0; cl < kNumClasses; ++cl) {
+      if (zero.class_zeroed[cl] + zero.class_skipped[cl] > 0) {
+        out->printf("class %3d [ %8" PRIuS " bytes ] : "
+                    "%10" PRIu64 " objs zeroed; %10" PRIu64 " objs skipped\n",
+                    cl, Static::sizemap()->ByteSizeForClass(cl),
+                    zero.class_zeroed[cl], zero.class_skipped[cl]);
+      }
+    }
+
     // append page heap info
     int nonempty_sizes = 0;
     for (int s = 0; s < kMaxPages; s++) {
@@ -698,6 +924,24 @@ class TCMallocImplementation : public MallocExtension {
       return true;
     }
 
+    if (strcmp(name, "tcmalloc.pageheap_reserve_count") == 0) {
+      SpinLockHolder l(Static::pageheap_lock());
+      *value = Static::pageheap()->stats().reserve_count;
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.pageheap_commit_count") == 0) {
+      SpinLockHolder l(Static::pageheap_lock());
+      *value = Static::pageheap()->stats().commit_count;
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.pageheap_decommit_count") == 0) {
+      SpinLockHolder l(Static::pageheap_lock());
+      *value = Static::pageheap()->stats().decommit_count;
+      return true;
+    }
+
     if (strcmp(name, "tcmalloc.max_total_thread_cache_bytes") == 0) {
       SpinLockHolder l(Static::pageheap_lock());
       *value = ThreadCache::overall_thread_cache_size();
@@ -716,6 +960,124 @@ class TCMallocImplementation : public MallocExtension {
       return true;
     }
 
+    if (strcmp(name, "tcmalloc.zero_on_free") == 0) {
+      *value = size_t(ThreadCache::zero_on_free());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.prezero_spans") == 0) {
+      *value = size_t(ThreadCache::prezero_spans());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.malloc_fill_byte") == 0) {
+      *value = size_t(ThreadCache::malloc_fill_byte());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.max_cached_object_size") == 0) {
+      *value = ThreadCache::max_cached_size();
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.per_cpu_caches") == 0) {
+      *value = size_t(ThreadCache::per_cpu());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.remote_free") == 0) {
+      *value = size_t(ThreadCache::remote_free());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.background_release") == 0) {
+      *value = size_t(Static::pageheap()->GetBackgroundRelease());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.prefault_bytes") == 0) {
+      *value = size_t(Static::pageheap()->GetCommittedFloor());
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.direct_mmap_threshold") == 0) {
+      *value = Static::pageheap()->GetDirectThreshold();
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.stats_page") == 0) {
+      *value = reinterpret_cast<uintptr_t>(stats_page);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.nontemporal_zero_threshold") == 0) {
+      *value = Static::sizemap()->nontemporal_zero_threshold();
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.parallel_zero_threshold") == 0) {
+      *value = parallel_zero_threshold;
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.page_zero_threshold") == 0) {
+      *value = Static::sizemap()->page_zero_threshold();
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.zero_kernel") == 0) {
+      *value = tcmalloc::zero_kernel();
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.check_zero_threshold") == 0) {
+      *value = tcmalloc::check_zero_threshold_bytes();
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.zeroed_bytes") == 0 ||
+        strcmp(name, "tcmalloc.zeroed_objects") == 0 ||
+        strcmp(name, "tcmalloc.zero_skipped_bytes") == 0) {
+      ZeroStats zero;
+      {
+        SpinLockHolder l(Static::pageheap_lock());
+        ThreadCache::GetZeroStats(&zero);
+      }
+      const uint64_t* counts =
+          (strcmp(name, "tcmalloc.zeroed_bytes") == 0) ? zero.zeroed_bytes :
+          (strcmp(name, "tcmalloc.zeroed_objects") == 0) ? zero.zeroed_objects :
+          zero.skipped_bytes;
+      uint64_t total = 0;
+      for (int path = 0; path < ZeroStats::kNumPaths; ++path) {
+        total += counts[path];
+      }
+      *value = total;
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.thread_cache_fetches") == 0 ||
+        strcmp(name, "tcmalloc.thread_cache_releases") == 0) {
+      uint64_t fetches, releases;
+      {
+        SpinLockHolder l(Static::pageheap_lock());
+        ThreadCache::GetCentralCacheTrips(&fetches, &releases);
+      }
+      *value = (strcmp(name, "tcmalloc.thread_cache_fetches") == 0) ?
+          fetches : releases;
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.this_thread_cache_fetches") == 0 ||
+        strcmp(name, "tcmalloc.this_thread_cache_releases") == 0 ||
+        strcmp(name, "tcmalloc.this_thread_cache_max_bytes") == 0) {
+      ThreadCache* heap = ThreadCache::GetCache();
+      *value = (strcmp(name, "tcmalloc.this_thread_cache_fetches") == 0) ?
+          heap->fetches() :
+          (strcmp(name, "tcmalloc.this_thread_cache_releases") == 0) ?
+          heap->releases() : heap->max_size();
+      return true;
+    }
+
     return false;
   }
 
@@ -733,6 +1095,60 @@ class TCMallocImplementation : public MallocExtension {
       return true;
     }
 
+    if (strcmp(name, "tcmalloc.direct_mmap_threshold") == 0) {
+      Static::pageheap()->SetDirectThreshold(value);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.zero_on_free") == 0) {
+      ThreadCache::set_zero_on_free(value != 0);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.prezero_spans") == 0) {
+      ThreadCache::set_prezero_spans(value != 0);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.malloc_fill_byte") == 0) {
+      ThreadCache::set_malloc_fill_byte(value);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.max_cached_object_size") == 0) {
+      ThreadCache::set_max_cached_size(value);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.nontemporal_zero_threshold") == 0) {
+      Static::sizemap()->set_nontemporal_zero_threshold(value);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.parallel_zero_threshold") == 0) {
+#ifdef HAVE_PTHREAD
+      SetParallelZeroThreshold(value);
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    if (strcmp(name, "tcmalloc.page_zero_threshold") == 0) {
+      Static::sizemap()->set_page_zero_threshold(value);
+      return true;
+    }
+
+    if (strcmp(name, "tcmalloc.zero_kernel") == 0) {
+      return value < tcmalloc::kNumZeroKernels &&
+             tcmalloc::SetZeroKernel(value);
+    }
+
+    if (strcmp(name, "tcmalloc.check_zero_threshold") == 0) {
+      tcmalloc::set_check_zero_threshold_bytes(value);
+      return true;
+    }
+
     return false;
   }
 
@@ -740,6 +1156,11 @@ class TCMallocImplementation : public MallocExtension {
     ThreadCache::BecomeIdle();
   }
 
+  virtual void ZeroThreadFreeMemory() {
+    ThreadCache* heap = ThreadCache::GetCacheIfPresent();
+    if (heap) heap->ZeroFreeLists();
+  }
+
   virtual void MarkThreadBusy();  // Implemented below
 
   virtual SysAllocator* GetSystemAllocator() {
@@ -753,6 +1174,12 @@ class TCMallocImplementation : public MallocExtension {
   }
 
   virtual void ReleaseToSystem(size_t num_bytes) {
+    // The central lists' emptied spans are free memory too.
+    for (int cl = 1; cl < kNumClasses; ++cl) {
+      Static::central_cache()[cl].ReleaseEmptySpans();
+    }
+    // (the background release thread may not have got to them yet)
+    Static::pageheap()->FinishRelease();
     SpinLockHolder h(Static::pageheap_lock());
     if (num_bytes <= extra_bytes_released_) {
       // We released too much on a prior call, so don't release any
@@ -909,6 +1336,150 @@ class TCMallocImplementation : public MallocExtension {
   }
 };
 
+// With TCMALLOC_BACKGROUND_RELEASE, this thread does the releasing of
+// memory to the system that would otherwise be done by the threads
+// freeing it (see PageHeap::SetBackgroundRelease()).
+static const int kBackgroundReleaseIntervalMs = 10;
+
+#ifdef HAVE_PTHREAD
+static void* BackgroundReleaseThread(void*) {
+  for (;;) {
+    Static::pageheap()->BackgroundRelease();
+    SleepForMilliseconds(kBackgroundReleaseIntervalMs);
+  }
+  return NULL;
+}
+#endif
+
+static void StartBackgroundRelease() {
+#ifdef HAVE_PTHREAD
+  if (!tcmalloc::commandlineflags::StringToBool(
+          TCMallocGetenvSafe("TCMALLOC_BACKGROUND_RELEASE"), false)) {
+    return;
+  }
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, BackgroundReleaseThread, NULL) != 0) {
+    Log(kLog, __FILE__, __LINE__,
+        "Could not start the background release thread");
+    return;
+  }
+  pthread_detach(thread);
+  SpinLockHolder h(Static::pageheap_lock());
+  Static::pageheap()->SetBackgroundRelease(true);
+#endif
+}
+
+// With TCMALLOC_STATS_PAGE set, this thread keeps a MallocStatsPage in
+// the file it names up to date, so that monitoring agents can read the
+// stats lock-free, however often they like; the thread alone pays for
+// collecting them.
+static void UpdateStatsPage(MallocStatsPage* page) {
+  TCMallocStats stats;
+  uint64_t class_count[kNumClasses];
+  ExtractStats(&stats, class_count, NULL, NULL);
+  ZeroStats zero;
+  uint64_t prefault_bytes;
+  {
+    SpinLockHolder l(Static::pageheap_lock());
+    ThreadCache::GetZeroStats(&zero);
+    prefault_bytes = Static::pageheap()->GetCommittedFloor();
+  }
+
+  // Writers: only this thread, so a plain seqlock.
+  volatile base::subtle::Atomic64* sequence =
+      reinterpret_cast<volatile base::subtle::Atomic64*>(&page->sequence);
+  const base::subtle::Atomic64 seq = base::subtle::NoBarrier_Load(sequence);
+  base::subtle::NoBarrier_Store(sequence, seq + 1);
+  base::subtle::MemoryBarrier();
+
+  page->current_allocated_bytes = stats.pageheap.system_bytes
+                                  - stats.thread_bytes
+                                  - stats.central_bytes
+                                  - stats.transfer_bytes
+                                  - stats.pageheap.free_bytes
+                                  - stats.pageheap.unmapped_bytes;
+  page->heap_size = stats.pageheap.system_bytes;
+  page->pageheap_free_bytes = stats.pageheap.free_bytes;
+  page->pageheap_unmapped_bytes = stats.pageheap.unmapped_bytes;
+  page->pageheap_committed_bytes = stats.pageheap.committed_bytes;
+  page->thread_cache_free_bytes = stats.thread_bytes;
+  page->central_cache_free_bytes = stats.central_bytes;
+  page->transfer_cache_free_bytes = stats.transfer_bytes;
+  page->metadata_bytes = stats.metadata_bytes;
+  page->pageheap_reserve_count = stats.pageheap.reserve_count;
+  page->pageheap_commit_count = stats.pageheap.commit_count;
+  page->pageheap_decommit_count = stats.pageheap.decommit_count;
+  page->zeroed_bytes = 0;
+  page->zero_skipped_bytes = 0;
+  for (int path = 0; path < ZeroStats::kNumPaths; ++path) {
+    page->zeroed_bytes += zero.zeroed_bytes[path];
+    page->zero_skipped_bytes += zero.skipped_bytes[path];
+  }
+  page->prefault_bytes = prefault_bytes;
+  page->num_classes = kNumClasses;
+  for (int cl = 0; cl < kNumClasses; ++cl) {
+    page->class_size[cl] = Static::sizemap()->ByteSizeForClass(cl);
+    page->class_free[cl] = class_count[cl];
+  }
+  page->updates++;
+
+  base::subtle::Release_Store(sequence, seq + 2);
+}
+
+#if defined(HAVE_PTHREAD) && defined(HAVE_MMAP)
+static void* StatsPageThread(void* arg) {
+  const int interval_ms = *static_cast<int*>(arg);
+  for (;;) {
+    UpdateStatsPage(stats_page);
+    SleepForMilliseconds(interval_ms);
+  }
+  return NULL;
+}
+#endif
+
+static void StartStatsPage() {
+#if defined(HAVE_PTHREAD) && defined(HAVE_MMAP)
+  COMPILE_ASSERT(kNumClasses <= MALLOC_STATS_PAGE_MAX_CLASSES,
+                 stats_page_has_room_for_all_classes);
+  const char* path = TCMallocGetenvSafe("TCMALLOC_STATS_PAGE");
+  if (path == NULL || *path == '\0') return;
+  static int interval_ms;
+  interval_ms = tcmalloc::commandlineflags::StringToInt(
+      TCMallocGetenvSafe("TCMALLOC_STATS_PAGE_INTERVAL_MS"), 100);
+  if (interval_ms <= 0) interval_ms = 100;
+
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    Log(kLog, __FILE__, __LINE__, "Could not open the stats page", path);
+    return;
+  }
+  void* p = MAP_FAILED;
+  if (ftruncate(fd, sizeof(MallocStatsPage)) == 0) {
+    p = mmap(NULL, sizeof(MallocStatsPage), PROT_READ | PROT_WRITE,
+             MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (p == MAP_FAILED) {
+    Log(kLog, __FILE__, __LINE__, "Could not map the stats page", path);
+    return;
+  }
+  MallocStatsPage* page = static_cast<MallocStatsPage*>(p);
+  UpdateStatsPage(page);
+  // (readers check the magic, so it goes in last)
+  base::subtle::MemoryBarrier();
+  memcpy(page->magic, MALLOC_STATS_PAGE_MAGIC, sizeof(page->magic));
+  stats_page = page;
+
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, StatsPageThread, &interval_ms) != 0) {
+    Log(kLog, __FILE__, __LINE__,
+        "Could not start the stats page thread");
+    return;
+  }
+  pthread_detach(thread);
+#endif
+}
+
 // The constructor allocates an object to ensure that initialization
 // runs before main(), and therefore we do not have a chance to become
 // multi-threaded before initialization.  We also create the TSD key
@@ -928,6 +1499,11 @@ TCMallocGuard::TCMallocGuard() {
     tc_free(tc_malloc(1));
     ThreadCache::InitTSD();
     tc_free(tc_malloc(1));
+    StartBackgroundRelease();
+    StartStatsPage();
+    SetParallelZeroThreshold(tcmalloc::commandlineflags::StringToLongLong(
+        TCMallocGetenvSafe("TCMALLOC_PARALLEL_ZERO_THRESHOLD"), 0));
+    tcmalloc::StartAllocationTrace();
     // Either we, or debugallocation.cc, or valgrind will control memory
     // management.  We register our extension if we're the winner.
 #ifdef TCMALLOC_USING_DEBUGALLOCATION
@@ -944,6 +1520,7 @@ TCMallocGuard::TCMallocGuard() {
 
 TCMallocGuard::~TCMallocGuard() {
   if (--tcmallocguard_refcount == 0) {
+    tcmalloc::FinishAllocationTrace();
     const char* env = NULL;
     if (!RunningOnValgrind()) {
       // Valgrind uses it's own malloc so we cannot do MALLOCSTATS
@@ -982,31 +1559,49 @@ static inline void* SpanToMallocResult(Span *span) {
       CheckedMallocResult(reinterpret_cast<void*>(span->start << kPageShift));
 }
 
-static void* DoSampledAllocation(size_t size) {
-  // Grab the stack trace outside the heap lock
+static void* DoSampledAllocation(ThreadCache* heap, size_t size) {
+  // Grab the stack trace outside the heap lock, straight into the
+  // thread's spare trace if it has one (it only lacks one the first time,
+  // or if we ran out of memory).
+  StackTrace* stack = heap->TakeSpareStackTrace();
   StackTrace tmp;
-  tmp.depth = GetStackTrace(tmp.stack, tcmalloc::kMaxStackDepth, 1);
-  tmp.size = size;
+  StackTrace* trace = (stack != NULL) ? stack : &tmp;
+  trace->depth = GetStackTrace(trace->stack, tcmalloc::kMaxStackDepth, 1);
+  trace->size = size;
 
-  SpinLockHolder h(Static::pageheap_lock());
-  // Allocate span
-  Span *span = Static::pageheap()->New(tcmalloc::pages(size == 0 ? 1 : size));
-  if (UNLIKELY(span == NULL)) {
-    return NULL;
-  }
+  void* result;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    // Allocate span
+    Span *span =
+        Static::pageheap()->New(tcmalloc::pages(size == 0 ? 1 : size));
+    if (UNLIKELY(span == NULL)) {
+      heap->SetSpareStackTraceLocked(stack);
+      return NULL;
+    }
+
+    // Allocate stack trace
+    if (UNLIKELY(stack == NULL)) {
+      stack = Static::stacktrace_allocator()->New();
+      if (UNLIKELY(stack == NULL)) {
+        // Sampling failed because of lack of memory
+        return SpanToMallocResult(span);
+      }
+      *stack = tmp;
+    }
+    span->sample = 1;
+    span->objects = stack;
+    tcmalloc::DLL_Prepend(Static::sampled_objects(), span);
 
-  // Allocate stack trace
-  StackTrace *stack = Static::stacktrace_allocator()->New();
-  if (UNLIKELY(stack == NULL)) {
-    // Sampling failed because of lack of memory
-    return span;
+    // Set up the next sample's trace while we hold the lock anyway.
+    heap->SetSpareStackTraceLocked(Static::stacktrace_allocator()->New());
+
+    result = SpanToMallocResult(span);
   }
-  *stack = tmp;
-  span->sample = 1;
-  span->objects = stack;
-  tcmalloc::DLL_Prepend(Static::sampled_objects(), span);
 
-  return SpanToMallocResult(span);
+  Static::SampledAllocHook hook = Static::sampled_alloc_hook();
+  if (hook != NULL) (*hook)(result, *stack);
+  return result;
 }
 
 namespace {
@@ -1140,61 +1735,215 @@ inline bool should_report_large(Length num_pages) {
 }
 
 // Helper for do_malloc().
-inline void* do_malloc_pages(ThreadCache* heap, size_t size) {
+// Zero size bytes at ptr, bypassing the cache if that's been asked for,
+// and with the parallel zeroing helpers if it's big enough.
+static void ZeroPages(void* ptr, size_t size) {
+  const size_t threshold = Static::sizemap()->nontemporal_zero_threshold();
+  const bool nontemporal = (threshold != 0 && size >= threshold);
+  if (UNLIKELY(parallel_zero_threshold != 0) &&
+      size >= parallel_zero_threshold &&
+      ParallelZero(ptr, size, nontemporal)) {
+    return;
+  }
+  if (nontemporal) {
+    tcmalloc::ZeroNonTemporal(ptr, size);
+  } else {
+    tcmalloc::tcmalloc_zero_object(ptr, size);
+  }
+}
+
+// Objects of the big size classes can be much bigger than what was asked
+// for (malloc(262145) gets 294912 bytes), so do_malloc() only zeroes what
+// was asked for, and leaves the rest of the object (its tail) to be
+// zeroed when it can first be seen: by malloc_usable_size() and friends,
+// or by a realloc(), which both get the size from GetSizeWithCallback().
+// Until then, the last word of the object says where the tail starts,
+// tagged with the object's address.  No-init allocations overwrite that
+// word, so a mark left by an earlier life of the object is never taken
+// for a new one.
+static const size_t kLazyTailMinSlack = 4096;
+static const uintptr_t kLazyTailTag =
+    static_cast<uintptr_t>(0x7a11c1ea7a11c1eaULL);
+
+static inline uintptr_t* LazyTailMark(void* ptr, size_t size) {
+  return reinterpret_cast<uintptr_t*>(static_cast<char*>(ptr) + size) - 1;
+}
+
+// Records that only the first head bytes of the size-byte object at ptr
+// are zero.
+static inline void SetLazyTail(void* ptr, size_t size, size_t head) {
+  *LazyTailMark(ptr, size) =
+      head ^ reinterpret_cast<uintptr_t>(ptr) ^ kLazyTailTag;
+}
+
+static inline void ForgetLazyTail(void* ptr, size_t size) {
+  *LazyTailMark(ptr, size) = 0;
+}
+
+// Zeroes the tail of the size-byte object at ptr, if it's still pending.
+static inline void ClearLazyTail(void* ptr, size_t size) {
+  uintptr_t* mark = LazyTailMark(ptr, size);
+  const uintptr_t head =
+      *mark ^ reinterpret_cast<uintptr_t>(ptr) ^ kLazyTailTag;
+  if (head + kLazyTailMinSlack <= size && head % kAlignment == 0) {
+    ZeroPages(static_cast<char*>(ptr) + head, size - head);
+  }
+}
+
+// size is rounded up to a whole number of pages.  If need_to_zero is set,
+// the result is zeroed; if is_zero is non-NULL, *is_zero tells whether
+// the result is known to be all zero.
+inline void* do_malloc_pages(ThreadCache* heap, size_t &size,
+                             bool need_to_zero, bool* is_zero) {
   void* result;
   bool report_large;
+  bool zeroed = false;
 
   Length num_pages = tcmalloc::pages(size);
   size = num_pages << kPageShift;
 
   if ((FLAGS_tcmalloc_sample_parameter > 0) && heap->SampleAllocation(size)) {
-    result = DoSampledAllocation(size);
+    result = DoSampledAllocation(heap, size);
 
     SpinLockHolder h(Static::pageheap_lock());
     report_large = should_report_large(num_pages);
   } else {
+    // Huge allocations get pages of their own, without pageheap_lock
+    // around the system calls.
+    Span* span = NULL;
+    if (Static::pageheap()->IsDirect(num_pages)) {
+      span = Static::pageheap()->NewDirect(num_pages);
+    }
     SpinLockHolder h(Static::pageheap_lock());
-    Span* span = Static::pageheap()->New(num_pages);
+    if (span == NULL) span = Static::pageheap()->New(num_pages);
     result = (UNLIKELY(span == NULL) ? NULL : SpanToMallocResult(span));
+    zeroed = (span != NULL && span->zeroed);
     report_large = should_report_large(num_pages);
   }
 
+  // (outside the lock: the span is ours now, and this may take a while)
+  if (need_to_zero && result != NULL) {
+    if (zeroed) {
+      heap->RecordKnownZero(ZeroStats::kPages, 0, size);
+    } else {
+      ZeroPages(result, size);
+      heap->RecordZeroed(ZeroStats::kPages, 0, size);
+      zeroed = true;
+    }
+  }
+  if (is_zero) *is_zero = zeroed;
+
   if (report_large) {
     ReportLargeAlloc(num_pages, result);
   }
   return result;
 }
 
-ALWAYS_INLINE void* do_malloc_small(ThreadCache* heap, size_t &size) {
+// If zeroed is non-NULL, *zeroed tells whether the object is known to be
+// zero apart from its first word.
+ALWAYS_INLINE void* do_malloc_small(ThreadCache* heap, size_t &size,
+                                    bool* zeroed = NULL) {
   ASSERT(Static::IsInited());
   ASSERT(heap != NULL);
   size_t cl = Static::sizemap()->SizeClass(size);
   size = Static::sizemap()->class_to_size(cl);
 
   if (UNLIKELY(FLAGS_tcmalloc_sample_parameter > 0) && heap->SampleAllocation(size)) {
-    return DoSampledAllocation(size);
+    if (zeroed) *zeroed = false;
+    void* result = DoSampledAllocation(heap, size);
+    // The object has a span of its own, all of which it owns (and
+    // GetSizeWithCallback() reports), so that's its size now.
+    size = tcmalloc::pages(size) << kPageShift;
+    return result;
   } else {
     // The common case, and also the simplest.  This just pops the
     // size-appropriate freelist, after replenishing it if it's empty.
-    return CheckedMallocResult(heap->Allocate(size, cl));
+    return CheckedMallocResult(heap->Allocate(size, cl, zeroed));
   }
 }
 
-ALWAYS_INLINE void* do_malloc(size_t &size, bool need_to_zero) {
+// do_malloc_small() for the fast path, which threads only take if
+// allocations aren't sampled (see ThreadCache::sample_allocations()), and
+// so doesn't check for sampling.
+ALWAYS_INLINE void* do_malloc_small_unsampled(ThreadCache* heap, size_t &size,
+                                              bool* zeroed) {
+  ASSERT(Static::IsInited());
+  ASSERT(heap != NULL);
+  size_t cl = Static::sizemap()->SizeClass(size);
+  size = Static::sizemap()->class_to_size(cl);
+  return CheckedMallocResult(heap->Allocate(size, cl, zeroed));
+}
+
+// If is_zero is non-NULL, *is_zero tells whether the result is known to be
+// all zero even when need_to_zero is false (e.g. because it was carved from
+// fresh pages).
+ALWAYS_INLINE void* do_malloc(size_t &size, bool need_to_zero,
+                              bool* is_zero = NULL) {
+  const size_t requested = size;
   void *ptr;
+  bool zeroed;
+  ThreadCache* heap;
+  if (need_to_zero && Static::sizemap()->ZeroFromPages(size)) {
+    return do_malloc_pages(ThreadCache::GetCache(), size, true, is_zero);
+  }
   if (ThreadCache::have_tls &&
       LIKELY(size < ThreadCache::MinSizeForSlowPath())) {
-    ptr = do_malloc_small(ThreadCache::GetCacheWhichMustBePresent(), size);
+    heap = ThreadCache::GetCacheWhichMustBePresent();
+    ptr = do_malloc_small_unsampled(heap, size, &zeroed);
   } else if (size <= kMaxSize) {
-    ptr = do_malloc_small(ThreadCache::GetCache(), size);
+    heap = ThreadCache::GetCache();
+    ptr = do_malloc_small(heap, size, &zeroed);
   } else {
-    // never need to zero, underlying code does MADV_DONTNEED
-    return do_malloc_pages(ThreadCache::GetCache(), size);
+    return do_malloc_pages(ThreadCache::GetCache(), size, need_to_zero,
+                           is_zero);
   }
-  if (need_to_zero) {
-    // size got updated already
-    memset(ptr, 0, size);
+  if (zeroed && (need_to_zero || is_zero)) {
+    // only the freelist link is dirty
+    *reinterpret_cast<void**>(ptr) = NULL;
+    if (need_to_zero) {
+      heap->RecordKnownZero(ZeroStats::kSmall,
+                            Static::sizemap()->SizeClass(size), size);
+    }
+  } else if (need_to_zero && LIKELY(ptr != NULL)) {
+    const size_t cl = Static::sizemap()->SizeClass(size);
+    if (UNLIKELY(Static::sizemap()->class_to_size(cl) != size)) {
+      // A sampled object, whose size is its span's (see do_malloc_small())
+      ZeroPages(ptr, size);
+      heap->RecordZeroed(ZeroStats::kPages, 0, size);
+      zeroed = true;
+    } else if (UNLIKELY(size - requested >= kLazyTailMinSlack) &&
+        Static::pageheap()->GetSizeClass(
+            reinterpret_cast<uintptr_t>(ptr) >> kPageShift) == cl) {
+      // (see kLazyTailMinSlack; sampled objects have spans of their own,
+      // whose size GetSizeWithCallback() reports instead)
+      const size_t head = (requested + kAlignment - 1) & ~(kAlignment - 1);
+      ZeroPages(ptr, head);
+      SetLazyTail(ptr, size, head);
+      heap->RecordZeroed(ZeroStats::kSmall, cl, head);
+      zeroed = false;
+    } else {
+#ifdef TCMALLOC_LTO_BITCODE
+      // In libtcmalloc_minimal_lto.a this gets inlined into the caller,
+      // which knows how much it asked for and may overwrite all of it:
+      // zero that with a memset it can see, and the rest of the class's
+      // size as usual.
+      memset(ptr, 0, requested);
+      if (size > requested) {
+        tcmalloc::tcmalloc_zero_object(reinterpret_cast<char*>(ptr) + requested,
+                                       size - requested);
+      }
+#else
+      // size got rounded up to its class's size already, so we can use
+      // the class's fixed-size zeroing
+      Static::sizemap()->ZeroObject(cl, ptr);
+#endif
+      heap->RecordZeroed(ZeroStats::kSmall, cl, size);
+      zeroed = true;
+    }
+  } else if (UNLIKELY(size > kLazyTailMinSlack) && LIKELY(ptr != NULL)) {
+    ForgetLazyTail(ptr, size);
   }
+  if (is_zero) *is_zero = zeroed;
   return ptr;
 }
 
@@ -1203,16 +1952,40 @@ ALWAYS_INLINE void* do_malloc(size_t size) {
   return do_malloc(size, false);
 }
 
+// Allocates for malloc and operator new, filling the memory with the
+// malloc fill byte (see ThreadCache::malloc_fill_byte()).  That's zero,
+// which do_malloc can often skip, unless the program expects a pattern.
+ALWAYS_INLINE void* do_malloc_init(size_t &size) {
+  void* ptr = do_malloc(size, LIKELY(ThreadCache::malloc_fill_byte() == 0));
+  // (read again: the first do_malloc is what reads the environment)
+  const int fill = ThreadCache::malloc_fill_byte();
+  if (UNLIKELY(fill != 0) && ptr != NULL) {
+    memset(ptr, fill, size);
+  }
+  return ptr;
+}
+
 static void *retry_malloc(void* size) {
-  // This is a rare case. We just always zero here.
+  // This is a rare case. We just always initialize here.
+  return do_malloc_init(*reinterpret_cast<size_t*>(size));
+}
+
+static void *retry_calloc(void* size) {
   return do_malloc(*reinterpret_cast<size_t*>(size), true);
 }
 
-ALWAYS_INLINE void* do_malloc_or_cpp_alloc(size_t &size, bool need_to_zero) {
-  void *rv = do_malloc(size, need_to_zero);
+// need_to_init is false only for realloc and the no-init entry points;
+// see do_malloc_init() for what it means otherwise.  is_zero is as for
+// do_malloc.
+ALWAYS_INLINE void* do_malloc_or_cpp_alloc(size_t &size, bool need_to_init,
+                                            bool* is_zero = NULL) {
+  void *rv = need_to_init ? do_malloc_init(size)
+                          : do_malloc(size, false, is_zero);
   if (LIKELY(rv != NULL)) {
     return rv;
   }
+  // (retry_malloc always initializes, which with a pattern isn't zero)
+  if (is_zero) *is_zero = ThreadCache::malloc_fill_byte() == 0;
   return handle_oom(retry_malloc, reinterpret_cast<void *>(&size),
                     false, true);
 }
@@ -1222,8 +1995,12 @@ ALWAYS_INLINE void* do_calloc(size_t n, size_t elem_size) {
   size_t size = n * elem_size;
   if (elem_size != 0 && size / elem_size != n) return NULL;
 
-  void* result = do_malloc_or_cpp_alloc(size, true);
-  return result;
+  void* result = do_malloc(size, true);
+  if (LIKELY(result != NULL)) {
+    return result;
+  }
+  return handle_oom(retry_calloc, reinterpret_cast<void *>(&size),
+                    false, true);
 }
 
 // If ptr is NULL, do nothing.  Otherwise invoke the given function.
@@ -1260,27 +2037,18 @@ ALWAYS_INLINE void do_free_helper(void* ptr,
     free_null_or_invalid(ptr, invalid_free_fn);
     return;
   }
-  Span* span = NULL;
   const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
   size_t cl = Static::pageheap()->GetSizeClassIfCached(p);
   if (UNLIKELY(cl == 0)) {
-    span = Static::pageheap()->GetDescriptor(p);
-    if (UNLIKELY(!span)) {
-      // span can be NULL because the pointer passed in is NULL or invalid
-      // (not something returned by malloc or friends), or because the
-      // pointer was allocated with some other allocator besides
-      // tcmalloc.  The latter can happen if tcmalloc is linked in via
-      // a dynamic library, but is not listed last on the link line.
-      // In that case, libraries after it on the link line will
-      // allocate with libc malloc, but free with tcmalloc's free.
-      free_null_or_invalid(ptr, invalid_free_fn);
-      return;
+    // Small objects' pages have their sizeclass in the pagemap too, so
+    // only large ones (and bad pointers) need the span here.
+    cl = Static::pageheap()->GetSizeClass(p);
+    if (cl != 0) {
+      Static::pageheap()->CacheSizeClass(p, cl);
     }
-    cl = span->sizeclass;
-    Static::pageheap()->CacheSizeClass(p, cl);
   }
-  ASSERT(ptr != NULL);
   if (LIKELY(cl != 0)) {
+    ASSERT(ptr != NULL);
     ASSERT(!Static::pageheap()->GetDescriptor(p)->sample);
     if (heap_must_be_valid || heap != NULL) {
       heap->Deallocate(ptr, cl);
@@ -1290,16 +2058,42 @@ ALWAYS_INLINE void do_free_helper(void* ptr,
       Static::central_cache()[cl].InsertRange(ptr, ptr, 1);
     }
   } else {
-    SpinLockHolder h(Static::pageheap_lock());
-    ASSERT(reinterpret_cast<uintptr_t>(ptr) % kPageSize == 0);
-    ASSERT(span != NULL && span->start == p);
+    Span* span = Static::pageheap()->GetDescriptor(p);
+    if (UNLIKELY(!span)) {
+      // span can be NULL because the pointer passed in is NULL or invalid
+      // (not something returned by malloc or friends), or because the
+      // pointer was allocated with some other allocator besides
+      // tcmalloc.  The latter can happen if tcmalloc is linked in via
+      // a dynamic library, but is not listed last on the link line.
+      // In that case, libraries after it on the link line will
+      // allocate with libc malloc, but free with tcmalloc's free.
+      free_null_or_invalid(ptr, invalid_free_fn);
+      return;
+    }
+    ASSERT(span->sizeclass == 0);
+    if (span->direct) {
+      Static::pageheap()->DeleteDirect(span);
+      return;
+    }
     if (span->sample) {
-      StackTrace* st = reinterpret_cast<StackTrace*>(span->objects);
-      tcmalloc::DLL_Remove(span);
-      Static::stacktrace_allocator()->Delete(st);
-      span->objects = NULL;
+      // Tell the heap profiler before the pages can be reused, so it
+      // can't confuse this object with a later one at the same address.
+      Static::SampledFreeHook hook = Static::sampled_free_hook();
+      if (hook != NULL) (*hook)(ptr);
     }
-    Static::pageheap()->Delete(span);
+    {
+      SpinLockHolder h(Static::pageheap_lock());
+      ASSERT(reinterpret_cast<uintptr_t>(ptr) % kPageSize == 0);
+      ASSERT(span != NULL && span->start == p);
+      if (span->sample) {
+        StackTrace* st = reinterpret_cast<StackTrace*>(span->objects);
+        tcmalloc::DLL_Remove(span);
+        Static::stacktrace_allocator()->Delete(st);
+        span->objects = NULL;
+      }
+      Static::pageheap()->Delete(span);
+    }
+    Static::pageheap()->ReleaseDeferred();
   }
 }
 
@@ -1313,6 +2107,9 @@ ALWAYS_INLINE void do_free_with_callback(void* ptr,
                                          void (*invalid_free_fn)(void*)) {
   ThreadCache* heap = NULL;
   if (LIKELY(ThreadCache::IsFastPathAllowed())) {
+    // Overlap the pagemap miss, if any, with the thread cache lookup.
+    Static::pageheap()->PrefetchSizeClass(
+        reinterpret_cast<uintptr_t>(ptr) >> kPageShift);
     heap = ThreadCache::GetCacheWhichMustBePresent();
     do_free_helper(ptr, invalid_free_fn, heap, true);
   } else {
@@ -1326,6 +2123,25 @@ ALWAYS_INLINE void do_free(void* ptr) {
   do_free_with_callback(ptr, &InvalidFree);
 }
 
+// Like do_free(), for an object allocated with do_malloc(size): the
+// size gives the size class, so that the pagemap isn't touched.  Small
+// objects can still live in spans of their own, when they were sampled
+// or zeroed from pages; those are page-aligned, and so are only the
+// first objects of class spans, so page-aligned pointers take the
+// do_free() path.
+ALWAYS_INLINE void do_free_sized(void* ptr, size_t size) {
+  if (LIKELY(ThreadCache::IsFastPathAllowed()) &&
+      LIKELY(size <= kMaxSize) &&
+      LIKELY((reinterpret_cast<uintptr_t>(ptr) & (kPageSize - 1)) != 0)) {
+    const size_t cl = Static::sizemap()->SizeClass(size);
+    ASSERT(cl == Static::pageheap()->GetSizeClass(
+        reinterpret_cast<uintptr_t>(ptr) >> kPageShift));
+    ThreadCache::GetCacheWhichMustBePresent()->Deallocate(ptr, cl);
+    return;
+  }
+  do_free(ptr);
+}
+
 // NOTE: some logic here is duplicated in GetOwnership (above), for
 // speed.  If you change this function, look at that one too.
 inline size_t GetSizeWithCallback(const void* ptr,
@@ -1334,19 +2150,62 @@ inline size_t GetSizeWithCallback(const void* ptr,
     return 0;
   const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
   size_t cl = Static::pageheap()->GetSizeClassIfCached(p);
-  if (cl != 0) {
-    return Static::sizemap()->ByteSizeForClass(cl);
-  } else {
+  if (cl == 0) {
+    cl = Static::pageheap()->GetSizeClass(p);
+    if (cl != 0) Static::pageheap()->CacheSizeClass(p, cl);
+  }
+  if (cl == 0) {
     const Span *span = Static::pageheap()->GetDescriptor(p);
     if (UNLIKELY(span == NULL)) {  // means we do not own this memory
       return (*invalid_getsize_fn)(ptr);
     } else if (span->sizeclass != 0) {
-      Static::pageheap()->CacheSizeClass(p, span->sizeclass);
-      return Static::sizemap()->ByteSizeForClass(span->sizeclass);
+      cl = span->sizeclass;
+      Static::pageheap()->CacheSizeClass(p, cl);
     } else {
       return span->length << kPageShift;
     }
   }
+  const size_t size = Static::sizemap()->ByteSizeForClass(cl);
+  if (UNLIKELY(size > kLazyTailMinSlack)) {
+    // The tail is about to be seen (see kLazyTailMinSlack)
+    ClearLazyTail(const_cast<void*>(ptr), size);
+  }
+  return size;
+}
+
+// Try to grow the page-level allocation at ptr to new_size bytes by
+// taking over the free pages right after it, to save realloc the copy.
+// Any pages added are zeroed (unless they are known to be zero already).
+static bool GrowPagesInPlace(void* ptr, size_t old_size, size_t new_size) {
+  if (old_size <= kMaxSize) return false;  // (small objects have a class)
+  const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
+  Span* span;
+  bool zeroed;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    span = Static::pageheap()->GetDescriptor(p);
+    if (span == NULL || span->sizeclass != 0 || span->sample ||
+        span->start != p) {
+      return false;
+    }
+    ASSERT(old_size == (span->length << kPageShift));
+    if (!Static::pageheap()->GrowSpan(span, tcmalloc::pages(new_size),
+                                      &zeroed)) {
+      return false;
+    }
+  }
+  // (outside the lock: the span is ours)
+  const size_t added = tcmalloc::pages(new_size) * kPageSize - old_size;
+  if (UNLIKELY(ThreadCache::malloc_fill_byte() != 0)) {
+    memset(reinterpret_cast<char*>(ptr) + old_size,
+           ThreadCache::malloc_fill_byte(), added);
+  } else if (zeroed) {
+    ThreadCache::GetCache()->RecordKnownZero(ZeroStats::kRealloc, 0, added);
+  } else {
+    ZeroPages(reinterpret_cast<char*>(ptr) + old_size, added);
+    ThreadCache::GetCache()->RecordZeroed(ZeroStats::kRealloc, 0, added);
+  }
+  return true;
 }
 
 // This lets you call back to a given function pointer if ptr is invalid.
@@ -1367,25 +2226,51 @@ ALWAYS_INLINE void* do_realloc_with_callback(
   const size_t lower_bound_to_grow = old_size + old_size / 4ul;
   const size_t upper_bound_to_shrink = old_size / 2ul;
   if ((new_size > old_size) || (new_size < upper_bound_to_shrink)) {
+    // Large buffers can often grow in place, which saves the copy.
+    if (new_size > old_size &&
+        ((new_size < lower_bound_to_grow &&
+          GrowPagesInPlace(old_ptr, old_size, lower_bound_to_grow)) ||
+         GrowPagesInPlace(old_ptr, old_size, new_size))) {
+      MallocHook::InvokeDeleteHook(old_ptr);
+      MallocHook::InvokeNewHook(old_ptr, new_size);
+      return old_ptr;
+    }
+
     // Need to reallocate.
     void* new_ptr = NULL;
     size_t real_new_size = lower_bound_to_grow;
+    bool is_zero = false;
 
     if (new_size > old_size && new_size < lower_bound_to_grow) {
-      new_ptr = do_malloc_or_cpp_alloc(real_new_size, false); // do NOT zero
+      new_ptr = do_malloc_or_cpp_alloc(real_new_size, false, &is_zero); // do NOT zero
     }
     if (new_ptr == NULL) {
       // Either new_size is not a tiny increment, or last do_malloc failed.
       real_new_size = new_size;
-      new_ptr = do_malloc_or_cpp_alloc(real_new_size, false); // do NOT zero
+      new_ptr = do_malloc_or_cpp_alloc(real_new_size, false, &is_zero); // do NOT zero
     }
     if (UNLIKELY(new_ptr == NULL)) {
       return NULL;
     }
     MallocHook::InvokeNewHook(new_ptr, new_size);
     memcpy(new_ptr, old_ptr, ((old_size < new_size) ? old_size : new_size));
-    if (old_size < real_new_size) // need to clear the WHOLE new buffer
-      memset((char *)new_ptr + old_size, 0, real_new_size - old_size);
+    // need to initialize the WHOLE new buffer, as malloc would (unless it
+    // came from fresh pages)
+    if (old_size < real_new_size) {
+      const size_t cl = (real_new_size <= kMaxSize)
+          ? Static::sizemap()->SizeClass(real_new_size) : 0;
+      const size_t tail = real_new_size - old_size;
+      if (UNLIKELY(ThreadCache::malloc_fill_byte() != 0)) {
+        memset((char *)new_ptr + old_size, ThreadCache::malloc_fill_byte(),
+               tail);
+      } else if (is_zero) {
+        ThreadCache::GetCache()->RecordKnownZero(ZeroStats::kRealloc, cl,
+                                                 tail);
+      } else {
+        tcmalloc::tcmalloc_zero_object((char *)new_ptr + old_size, tail);
+        ThreadCache::GetCache()->RecordZeroed(ZeroStats::kRealloc, cl, tail);
+      }
+    }
     MallocHook::InvokeDeleteHook(old_ptr);
     // We could use a variant of do_free() that leverages the fact
     // that we already know the sizeclass of old_ptr.  The benefit
@@ -1403,63 +2288,19 @@ ALWAYS_INLINE void* do_realloc_with_callback(
 ALWAYS_INLINE void* do_realloc(void* old_ptr, size_t new_size) {
   void *result = do_realloc_with_callback(old_ptr, new_size,
                                   &InvalidFree, &InvalidGetSizeForRealloc);
-  // TODO: If we allocated shiny new pages then we don't need to zero.
-  // TODO: we should deal with this inside do_realloc_with_callback, anyway
   return result;
 }
 
-// For use by exported routines below that want specific alignments
-//
-// Note: this code can be slow for alignments > 16, and can
-// significantly fragment memory.  The expectation is that
-// memalign/posix_memalign/valloc/pvalloc will not be invoked very
-// often.  This requirement simplifies our implementation and allows
-// us to tune for expected allocation patterns.
-void* do_memalign(size_t align, size_t size) {
-  ASSERT((align & (align - 1)) == 0);
-  ASSERT(align > 0);
-  if (size + align < size) return NULL;         // Overflow
-
-  // Fall back to malloc if we would already align this memory access properly.
-  if (align <= AlignmentForSize(size)) {
-    void* p = do_malloc(size, true);
-    ASSERT((reinterpret_cast<uintptr_t>(p) % align) == 0);
-    return p;
-  }
-
-  if (UNLIKELY(Static::pageheap() == NULL)) ThreadCache::InitModule();
-
-  // Allocate at least one byte to avoid boundary conditions below
-  if (size == 0) size = 1;
-
-  if (size <= kMaxSize && align < kPageSize) {
-    // Search through acceptable size classes looking for one with
-    // enough alignment.  This depends on the fact that
-    // InitSizeClasses() currently produces several size classes that
-    // are aligned at powers of two.  We will waste time and space if
-    // we miss in the size class array, but that is deemed acceptable
-    // since memalign() should be used rarely.
-    int cl = Static::sizemap()->SizeClass(size);
-    while (cl < kNumClasses &&
-           ((Static::sizemap()->class_to_size(cl) & (align - 1)) != 0)) {
-      cl++;
-    }
-    if (cl < kNumClasses) {
-      ThreadCache* heap = ThreadCache::GetCache();
-      size = Static::sizemap()->class_to_size(cl);
-      return CheckedMallocResult(heap->Allocate(size, cl));
-    }
-  }
-
-  // We will allocate directly from the page heap
+// Allocates a span of size bytes (rounded up to pages) that starts at a
+// multiple of align.  The span is not zeroed.
+static Span* do_memalign_pages(size_t align, size_t size) {
   SpinLockHolder h(Static::pageheap_lock());
 
   if (align <= kPageSize) {
     // Any page-level allocation will be fine
     // TODO: We could put the rest of this page in the appropriate
     // TODO: cache but it does not seem worth it.
-    Span* span = Static::pageheap()->New(tcmalloc::pages(size));
-    return UNLIKELY(span == NULL) ? NULL : SpanToMallocResult(span);
+    return Static::pageheap()->New(tcmalloc::pages(size));
   }
 
   // Allocate extra pages and carve off an aligned portion
@@ -1486,7 +2327,76 @@ void* do_memalign(size_t align, size_t size) {
     Span* trailer = Static::pageheap()->Split(span, needed);
     Static::pageheap()->Delete(trailer);
   }
-  return SpanToMallocResult(span);
+  return span;
+}
+
+// For use by exported routines below that want specific alignments
+//
+// Note: this code can be slow for alignments > 16, and can
+// significantly fragment memory.  The expectation is that
+// memalign/posix_memalign/valloc/pvalloc will not be invoked very
+// often.  This requirement simplifies our implementation and allows
+// us to tune for expected allocation patterns.
+//
+// Like calloc, the result is always zeroed.
+void* do_memalign(size_t align, size_t size) {
+  ASSERT((align & (align - 1)) == 0);
+  ASSERT(align > 0);
+  if (size + align < size) return NULL;         // Overflow
+
+  // Fall back to malloc if we would already align this memory access properly.
+  if (align <= AlignmentForSize(size)) {
+    void* p = do_malloc(size, true);
+    ASSERT((reinterpret_cast<uintptr_t>(p) % align) == 0);
+    return p;
+  }
+
+  if (UNLIKELY(Static::pageheap() == NULL)) ThreadCache::InitModule();
+
+  // Allocate at least one byte to avoid boundary conditions below
+  if (size == 0) size = 1;
+
+  if (size <= kMaxSize && align < kPageSize &&
+      !Static::sizemap()->ZeroFromPages(size)) {
+    // Use the first size class with enough alignment.  This depends on
+    // the fact that InitSizeClasses() currently produces several size
+    // classes that are aligned at powers of two.  We will waste time and
+    // space if we miss in the size class array, but that is deemed
+    // acceptable since memalign() should be used rarely.
+    const int cl = Static::sizemap()->AlignedSizeClass(size, align);
+    if (cl != 0) {
+      ThreadCache* heap = ThreadCache::GetCache();
+      bool zeroed = false;
+      void* p = CheckedMallocResult(
+          heap->Allocate(Static::sizemap()->class_to_size(cl), cl, &zeroed));
+      if (UNLIKELY(p == NULL)) return NULL;
+      const size_t size = Static::sizemap()->class_to_size(cl);
+      if (zeroed) {
+        // only the freelist link is dirty
+        *reinterpret_cast<void**>(p) = NULL;
+        heap->RecordKnownZero(ZeroStats::kMemalign, cl, size);
+      } else {
+        Static::sizemap()->ZeroObject(cl, p);
+        heap->RecordZeroed(ZeroStats::kMemalign, cl, size);
+      }
+      return p;
+    }
+  }
+
+  // We will allocate directly from the page heap
+  Span* span = do_memalign_pages(align, size);
+  Static::pageheap()->ReleaseDeferred();  // (the parts we didn't need)
+  if (UNLIKELY(span == NULL)) return NULL;
+  // (outside the lock: the span is ours now, and this may take a while)
+  void* result = SpanToMallocResult(span);
+  const size_t bytes = span->length << kPageShift;
+  if (span->zeroed) {
+    ThreadCache::GetCache()->RecordKnownZero(ZeroStats::kMemalign, 0, bytes);
+  } else {
+    ZeroPages(result, bytes);
+    ThreadCache::GetCache()->RecordZeroed(ZeroStats::kMemalign, 0, bytes);
+  }
+  return result;
 }
 
 // Helpers for use by exported routines below:
@@ -1527,15 +2437,32 @@ inline struct mallinfo do_mallinfo() {
 }
 #endif  // HAVE_STRUCT_MALLINFO
 
-inline void* cpp_alloc(size_t size, bool nothrow) {
-  void* p = do_malloc(size, true);
+// need_to_init is only false for the no-init entry points, which the
+// compiler uses when the constructor initializes every byte anyway.
+// size comes back as the size of what was allocated.
+inline void* cpp_alloc_actual(size_t &size, bool nothrow,
+                              bool need_to_init = true) {
+  void* p = need_to_init ? do_malloc_init(size) : do_malloc(size, false);
   if (LIKELY(p)) {
     return p;
   }
-  return handle_oom(retry_malloc, reinterpret_cast<void *>(size),
+  return handle_oom(retry_malloc, reinterpret_cast<void *>(&size),
                     true, nothrow);
 }
 
+inline void* cpp_alloc(size_t size, bool nothrow, bool need_to_init = true) {
+  return cpp_alloc_actual(size, nothrow, need_to_init);
+}
+
+// For the size-returning entry points, which hand out all size bytes of
+// the object at ptr (requested of them having been asked for): zeroes
+// the tail do_malloc() may have left for later (see kLazyTailMinSlack).
+inline void ClearSizedTail(void* ptr, size_t requested, size_t size) {
+  if (UNLIKELY(size - requested >= kLazyTailMinSlack) && ptr != NULL) {
+    ClearLazyTail(ptr, size);
+  }
+}
+
 }  // end unnamed namespace
 
 // As promised, the definition of this function, declared above.
@@ -1639,6 +2566,12 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_new(size_t size) {
   return p;
 }
 
+extern "C" PERFTOOLS_DLL_DECL void* tc_new_noinit(size_t size) {
+  void* p = cpp_alloc(size, false, false);
+  MallocHook::InvokeNewHook(p, size);
+  return p;
+}
+
 extern "C" PERFTOOLS_DLL_DECL void* tc_new_nothrow(size_t size, const std::nothrow_t&) __THROW {
   void* p = cpp_alloc(size, true);
   MallocHook::InvokeNewHook(p, size);
@@ -1669,6 +2602,12 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_newarray(size_t size) {
   return p;
 }
 
+extern "C" PERFTOOLS_DLL_DECL void* tc_newarray_noinit(size_t size) {
+  void* p = cpp_alloc(size, false, false);
+  MallocHook::InvokeNewHook(p, size);
+  return p;
+}
+
 extern "C" PERFTOOLS_DLL_DECL void* tc_newarray_nothrow(size_t size, const std::nothrow_t&)
     __THROW {
   void* p = cpp_alloc(size, true);
@@ -1686,13 +2625,166 @@ extern "C" PERFTOOLS_DLL_DECL void tc_deletearray_nothrow(void* p, const std::no
   do_free(p);
 }
 
+// Batches are handled this many objects at a time, which bounds the
+// time a per-CPU cache is kept locked.
+static const int kBatchChunk = 1024;
+
+// Allocates n objects of "size" bytes into ptrs, like that many
+// do_malloc() calls, but with one thread cache lookup and size class
+// computation, runs of objects off the freelist, and the zeroing done in
+// one pass.  Returns the number allocated, which is less than n only if
+// memory ran out (the new handler isn't called).
+static size_t do_malloc_batch(size_t size, void** ptrs, size_t n,
+                              bool need_to_zero) {
+  ThreadCache* heap = ThreadCache::GetCache();
+  if (size > kMaxSize ||
+      (need_to_zero && Static::sizemap()->ZeroFromPages(size)) ||
+      (need_to_zero && ThreadCache::malloc_fill_byte() != 0) ||
+      FLAGS_tcmalloc_sample_parameter > 0) {
+    // These don't come off the freelists in runs
+    for (size_t i = 0; i < n; i++) {
+      size_t object_size = size;
+      ptrs[i] = need_to_zero ? do_malloc_init(object_size)
+                             : do_malloc(object_size, false);
+      if (ptrs[i] == NULL) return i;
+    }
+    return n;
+  }
+  const size_t cl = Static::sizemap()->SizeClass(size);
+  const size_t bytes = Static::sizemap()->class_to_size(cl);
+  size_t done = 0;
+  while (done < n) {
+    const int chunk = min<size_t>(n - done, kBatchChunk);
+    int zero;
+    const int got = heap->AllocateBatch(bytes, cl, ptrs + done, chunk, &zero);
+    if (need_to_zero) {
+      for (int i = 0; i < got - zero; i++) {
+        Static::sizemap()->ZeroObject(cl, ptrs[done + i]);
+      }
+      for (int i = got - zero; i < got; i++) {
+        // only the freelist link is dirty
+        *reinterpret_cast<void**>(ptrs[done + i]) = NULL;
+      }
+      heap->RecordZeroed(ZeroStats::kSmall, cl, (got - zero) * bytes,
+                         got - zero);
+      heap->RecordKnownZero(ZeroStats::kSmall, cl, zero * bytes, zero);
+    } else if (bytes > kLazyTailMinSlack) {
+      for (int i = 0; i < got; i++) {
+        ForgetLazyTail(ptrs[done + i], bytes);
+      }
+    }
+    done += got;
+    if (got < chunk) break;
+  }
+  return done;
+}
+
+// Frees the n objects at ptrs, each allocated with "size" bytes, like
+// that many do_free_sized() calls, but pushing runs of them onto the
+// freelist at once.
+static void do_free_batch(void** ptrs, size_t n, size_t size) {
+  if (UNLIKELY(!ThreadCache::IsFastPathAllowed()) || size > kMaxSize) {
+    for (size_t i = 0; i < n; i++) do_free(ptrs[i]);
+    return;
+  }
+  ThreadCache* heap = ThreadCache::GetCacheWhichMustBePresent();
+  const size_t cl = Static::sizemap()->SizeClass(size);
+  // Page-aligned objects may have spans of their own (see
+  // do_free_sized()), so they split the runs and take do_free().
+  size_t start = 0;
+  for (size_t i = 0; i < n; i++) {
+    if ((reinterpret_cast<uintptr_t>(ptrs[i]) & (kPageSize - 1)) == 0) {
+      heap->DeallocateBatch(ptrs + start, i - start, cl);
+      do_free(ptrs[i]);
+      start = i + 1;
+    } else {
+      ASSERT(cl == Static::pageheap()->GetSizeClass(
+          reinterpret_cast<uintptr_t>(ptrs[i]) >> kPageShift));
+      if (i + 1 - start == kBatchChunk) {
+        heap->DeallocateBatch(ptrs + start, kBatchChunk, cl);
+        start = i + 1;
+      }
+    }
+  }
+  heap->DeallocateBatch(ptrs + start, n - start, cl);
+}
+
+// MallocHook::InvokeNewHook() and InvokeDeleteHook() for a batch, which
+// check for hooks once.
+static void InvokeNewHooks(void** ptrs, size_t n, size_t size) {
+#ifndef NO_TCMALLOC_MALLOC_HOOKS
+  if (UNLIKELY(!base::internal::new_hooks_.empty())) {
+    for (size_t i = 0; i < n; i++) MallocHook::InvokeNewHook(ptrs[i], size);
+  }
+#endif
+}
+
+static void InvokeDeleteHooks(void** ptrs, size_t n) {
+#ifndef NO_TCMALLOC_MALLOC_HOOKS
+  if (UNLIKELY(!base::internal::delete_hooks_.empty())) {
+    for (size_t i = 0; i < n; i++) MallocHook::InvokeDeleteHook(ptrs[i]);
+  }
+#endif
+}
+
+extern "C" PERFTOOLS_DLL_DECL size_t tc_malloc_batch(size_t size, void** ptrs,
+                                                     size_t n) __THROW {
+  const size_t got = do_malloc_batch(size, ptrs, n, true);
+  InvokeNewHooks(ptrs, got, size);
+  return got;
+}
+
+extern "C" PERFTOOLS_DLL_DECL size_t tc_malloc_batch_noinit(size_t size,
+                                                            void** ptrs,
+                                                            size_t n) __THROW {
+  const size_t got = do_malloc_batch(size, ptrs, n, false);
+  InvokeNewHooks(ptrs, got, size);
+  return got;
+}
+
+extern "C" PERFTOOLS_DLL_DECL void tc_free_batch(void** ptrs, size_t n,
+                                                 size_t size) __THROW {
+  InvokeDeleteHooks(ptrs, n);
+  do_free_batch(ptrs, n, size);
+}
+
+// The size comes from the size class (or page count) do_malloc() works
+// out anyway, so unlike tc_malloc_size() it costs no pagemap lookup.
+extern "C" PERFTOOLS_DLL_DECL void* tc_malloc_sized(size_t size,
+                                                    size_t* actual) __THROW {
+  size_t got = size;
+  void* result = do_malloc_or_cpp_alloc(got, true);
+  ClearSizedTail(result, size, got);
+  MallocHook::InvokeNewHook(result, got);
+  if (actual) *actual = (result != NULL) ? got : 0;
+  return result;
+}
+
+extern "C" PERFTOOLS_DLL_DECL void* tc_new_sized(size_t size,
+                                                 size_t* actual) {
+  size_t got = size;
+  void* p = cpp_alloc_actual(got, false);
+  ClearSizedTail(p, size, got);
+  MallocHook::InvokeNewHook(p, got);
+  if (actual) *actual = got;
+  return p;
+}
+
+// C++14 sized deallocation (::operator delete(ptr, size)).  "size" must
+// be the size that was passed to new.
+extern "C" PERFTOOLS_DLL_DECL void tc_delete_sized(void* p, size_t size) __THROW {
+  MallocHook::InvokeDeleteHook(p);
+  do_free_sized(p, size);
+}
+
+extern "C" PERFTOOLS_DLL_DECL void tc_deletearray_sized(void* p, size_t size) __THROW {
+  MallocHook::InvokeDeleteHook(p);
+  do_free_sized(p, size);
+}
+
 extern "C" PERFTOOLS_DLL_DECL void* tc_memalign(size_t align,
                                                 size_t size) __THROW {
   void* result = do_memalign_or_cpp_memalign(align, size);
-  if (result != NULL) {
-    if (size <= kMaxSize)
-      memset(result, 0, size);
-  }
   MallocHook::InvokeNewHook(result, size);
   return result;
 }
@@ -1711,8 +2803,6 @@ extern "C" PERFTOOLS_DLL_DECL int tc_posix_memalign(
     return ENOMEM;
   } else {
     *result_ptr = result;
-    if (size <= kMaxSize)
-      memset(result, 0, size);
     return 0;
   }
 }
@@ -1723,10 +2813,6 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_valloc(size_t size) __THROW {
   // Allocate page-aligned object of length >= size bytes
   if (pagesize == 0) pagesize = getpagesize();
   void* result = do_memalign_or_cpp_memalign(pagesize, size);
-  if (result != NULL) {
-    if (size <= kMaxSize)
-      memset(result, 0, size);
-  }
   MallocHook::InvokeNewHook(result, size);
   return result;
 }
@@ -1739,10 +2825,6 @@ extern "C" PERFTOOLS_DLL_DECL void* tc_pvalloc(size_t size) __THROW {
   }
   size = (size + pagesize - 1) & ~(pagesize - 1);
   void* result = do_memalign_or_cpp_memalign(pagesize, size);
-  if (result != NULL) {
-    if (size <= kMaxSize)
-      memset(result, 0, size);
-  }
   MallocHook::InvokeNewHook(result, size);
   return result;
 }
@@ -1766,9 +2848,135 @@ extern "C" PERFTOOLS_DLL_DECL size_t tc_malloc_size(void* ptr) __THROW {
 }
 
 extern "C" PERFTOOLS_DLL_DECL void* tc_malloc_skip_new_handler(size_t size)  __THROW {
-  void* result = do_malloc(size, true);
+  void* result = do_malloc_init(size);
   MallocHook::InvokeNewHook(result, size);
   return result;
 }
 
 #endif  // TCMALLOC_USING_DEBUGALLOCATION
+
+//-------------------------------------------------------------------
+// Arenas
+//-------------------------------------------------------------------
+
+// Arena objects are bump-allocated from chunks, which are spans of their
+// own, zeroed (unless known to be zero) once as they are taken from the
+// page heap.  Objects bigger than a quarter of a chunk get spans of their
+// own instead.  Resetting the arena gives all the spans back to the page
+// heap at once, except the current chunk, of which only what was handed
+// out is zeroed again.  Arena objects never go through the thread caches
+// or the malloc hooks, and can't be passed to free() or realloc().
+static const size_t kDefaultArenaChunk = 256 << 10;
+
+struct tc_arena {
+  Span* spans;           // all the arena's spans, chained through next
+  Span* current;         // the chunk being bump-allocated from (or NULL)
+  char* next;            // the free part of the current chunk
+  char* limit;
+  Length chunk_pages;
+};
+
+// Takes a zeroed span of n pages from the page heap, for an arena.
+static Span* NewArenaSpan(Length n) {
+  Span* span;
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    span = Static::pageheap()->New(n);
+  }
+  if (UNLIKELY(span == NULL)) return NULL;
+  Static::pageheap()->CacheSizeClass(span->start, 0);
+  // (outside the lock: the span is ours now, and this may take a while)
+  ThreadCache* heap = ThreadCache::GetCache();
+  if (span->zeroed) {
+    heap->RecordKnownZero(ZeroStats::kArena, 0, n << kPageShift);
+  } else {
+    ZeroPages(reinterpret_cast<void*>(span->start << kPageShift),
+              n << kPageShift);
+    heap->RecordZeroed(ZeroStats::kArena, 0, n << kPageShift);
+  }
+  span->next = NULL;
+  return span;
+}
+
+// Gives the arena's spans back to the page heap, except "keep".
+static void DeleteArenaSpans(tc_arena* arena, Span* keep) {
+  {
+    SpinLockHolder h(Static::pageheap_lock());
+    for (Span* span = arena->spans; span != NULL; ) {
+      Span* next = span->next;
+      if (span != keep) Static::pageheap()->Delete(span);
+      span = next;
+    }
+  }
+  Static::pageheap()->ReleaseDeferred();
+  arena->spans = keep;
+  if (keep != NULL) keep->next = NULL;
+}
+
+// tc_arena_alloc() for when the current chunk is full.
+static void* ArenaAllocSlow(tc_arena* arena, size_t size) {
+  if (size > (arena->chunk_pages << kPageShift) / 4) {
+    Span* span = NewArenaSpan(tcmalloc::pages(size));
+    if (UNLIKELY(span == NULL)) return NULL;
+    span->next = arena->spans;
+    arena->spans = span;
+    return reinterpret_cast<void*>(span->start << kPageShift);
+  }
+  Span* span = NewArenaSpan(arena->chunk_pages);
+  if (UNLIKELY(span == NULL)) return NULL;
+  span->next = arena->spans;
+  arena->spans = span;
+  arena->current = span;
+  char* start = reinterpret_cast<char*>(span->start << kPageShift);
+  arena->next = start + size;
+  arena->limit = start + (span->length << kPageShift);
+  return start;
+}
+
+extern "C" PERFTOOLS_DLL_DECL tc_arena* tc_arena_create(size_t chunk_size)
+    __THROW {
+  size_t size = sizeof(tc_arena);
+  tc_arena* arena = static_cast<tc_arena*>(do_malloc(size, true));
+  if (UNLIKELY(arena == NULL)) return NULL;
+  arena->spans = NULL;
+  arena->current = NULL;
+  arena->next = NULL;
+  arena->limit = NULL;
+  arena->chunk_pages =
+      tcmalloc::pages(chunk_size != 0 ? chunk_size : kDefaultArenaChunk);
+  return arena;
+}
+
+extern "C" PERFTOOLS_DLL_DECL void* tc_arena_alloc(tc_arena* arena,
+                                                   size_t size) __THROW {
+  if (size == 0) size = 1;
+  const uintptr_t align = min<size_t>(AlignmentForSize(size), kPageSize);
+  char* p = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(arena->next) + align - 1) & ~(align - 1));
+  if (LIKELY(p <= arena->limit &&
+             size <= static_cast<size_t>(arena->limit - p))) {
+    arena->next = p + size;
+    return p;
+  }
+  return ArenaAllocSlow(arena, size);
+}
+
+extern "C" PERFTOOLS_DLL_DECL void tc_arena_reset(tc_arena* arena) __THROW {
+  Span* keep = arena->current;
+  DeleteArenaSpans(arena, keep);
+  if (keep != NULL) {
+    char* start = reinterpret_cast<char*>(keep->start << kPageShift);
+    if (arena->next > start) {
+      ZeroPages(start, arena->next - start);
+      ThreadCache::GetCache()->RecordZeroed(ZeroStats::kArena, 0,
+                                            arena->next - start);
+    }
+    arena->next = start;
+  }
+}
+
+extern "C" PERFTOOLS_DLL_DECL void tc_arena_destroy(tc_arena* arena) __THROW {
+  if (arena == NULL) return;
+  DeleteArenaSpans(arena, NULL);
+  do_free(arena);
+}
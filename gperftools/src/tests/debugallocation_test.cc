@@ -77,6 +77,20 @@ static int test_counter = 0;    // incremented every time the macro is called
 
 // This flag won't be compiled in in opt mode.
 DECLARE_int32(max_free_queue_size);
+DECLARE_bool(malloc_returns_zero);
+
+// These aren't in the public header; SafeInit-compiled code calls them.
+extern "C" void* tc_malloc_noinit(size_t size) __THROW;
+extern "C" void* tc_newarray_noinit(size_t size);
+
+static bool AllBytesAre(const void* p, size_t size, unsigned char c) {
+  const volatile unsigned char* b =
+      reinterpret_cast<const volatile unsigned char*>(p);
+  for (size_t i = 0; i < size; i++) {
+    if (b[i] != c) return false;
+  }
+  return true;
+}
 
 // Test match as well as mismatch rules.  But do not test on OS X; on
 // OS X the OS converts new/new[] to malloc before it gets to us, so
@@ -314,6 +328,41 @@ TEST(DebugAllocationTest, ReallocAfterMemalign) {
   EXPECT_EQ(rv, 0);
 }
 
+TEST(DebugAllocationTest, MallocReturnsZero) {
+  const bool old_returns_zero = FLAGS_malloc_returns_zero;
+  FLAGS_malloc_returns_zero = true;
+  static const size_t kSizes[] = { 1, 100, 5000, 100000 };
+  // Go around enough times that the memory has been freed (and so
+  // poisoned) and reused.
+  for (int round = 0; round < 100; round++) {
+    for (int i = 0; i < sizeof(kSizes) / sizeof(*kSizes); i++) {
+      const size_t size = kSizes[i];
+      char* p = static_cast<char*>(malloc(size));
+      EXPECT_TRUE(AllBytesAre(p, size, 0));
+      memset(p, 0x11, size);
+      p = static_cast<char*>(realloc(p, size * 2));
+      EXPECT_TRUE(AllBytesAre(p, size, 0x11));
+      EXPECT_TRUE(AllBytesAre(p + size, size, 0));
+      free(p);
+
+      p = new char[size];
+      EXPECT_TRUE(AllBytesAre(p, size, 0));
+      memset(p, 0x11, size);
+      delete[] p;
+
+      // The noinit functions' callers promise to initialize the memory,
+      // so it stays patterned, to catch reads before that.
+      p = static_cast<char*>(tc_malloc_noinit(size));
+      EXPECT_TRUE(AllBytesAre(p, size, 0xAB));
+      free(p);
+      p = static_cast<char*>(tc_newarray_noinit(size));
+      EXPECT_TRUE(AllBytesAre(p, size, 0xAB));
+      delete[] p;
+    }
+  }
+  FLAGS_malloc_returns_zero = old_returns_zero;
+}
+
 int main(int argc, char** argv) {
   // If you run without args, we run the non-death parts of the test.
   // Otherwise, argv[1] should be a number saying which death-test
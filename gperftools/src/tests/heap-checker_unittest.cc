@@ -1328,6 +1328,49 @@ static void VerifyMemoryRegionMapStackGet() {
   munmap(addr, 100);
 }
 
+static const int kMmapperThreads = 8;
+static const size_t kMmapperSize = 4096;
+
+static void* MmapperThreadBody(void* arg) {
+  void** kept = reinterpret_cast<void**>(arg);
+  void* addr = NULL;
+  for (int i = 0; i < 200; ++i) {
+    if (addr != NULL) munmap(addr, kMmapperSize);
+    addr = mmap(NULL, kMmapperSize, PROT_READ|PROT_WRITE,
+                MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    CHECK(addr != MAP_FAILED);
+  }
+  *kept = addr;
+  return NULL;
+}
+
+// Verify that mmap-s and munmap-s done by other threads while
+// MemoryRegionMap is locked (so that its hooks have to queue them)
+// end up in it once it's unlocked.
+static void VerifyMemoryRegionMapConcurrentMmaps() {
+  pthread_t tids[kMmapperThreads];
+  void* kept[kMmapperThreads];
+  { MemoryRegionMap::LockHolder l;
+    for (int i = 0; i < kMmapperThreads; ++i) {
+      CHECK_EQ(pthread_create(&tids[i], NULL, MmapperThreadBody, &kept[i]), 0);
+    }
+    usleep(10000);  // let them fill the queue
+  }
+  for (int i = 0; i < kMmapperThreads; ++i) {
+    CHECK_EQ(pthread_join(tids[i], NULL), 0);
+  }
+  for (int i = 0; i < kMmapperThreads; ++i) {
+    MemoryRegionMap::Region region;
+    // (the last byte, as the kernel may put another mapping right before)
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(kept[i]) +
+                           kMmapperSize - 1;
+    CHECK(MemoryRegionMap::FindRegion(addr, &region));
+    CHECK(region.start_addr <= addr - (kMmapperSize - 1));
+    munmap(kept[i], kMmapperSize);
+    CHECK(!MemoryRegionMap::FindRegion(addr, &region));
+  }
+}
+
 static void* Mallocer(uintptr_t* addr_after_malloc_call) {
   void* r = malloc(100);
   sleep(0);  // undo -foptimize-sibling-calls
@@ -1402,6 +1445,10 @@ int main(int argc, char** argv) {
   //                 find potential problems like this one!
   TestLibCAllocate();
 
+  if (HeapLeakChecker::IsActive() && !FLAGS_no_threads) {
+    VerifyMemoryRegionMapConcurrentMmaps();
+  }
+
   if (FLAGS_interfering_threads) {
     RunHeapBusyThreads();  // add interference early
   }
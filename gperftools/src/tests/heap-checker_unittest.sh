@@ -84,6 +84,14 @@ run_check "local"
 run_check "normal"
 run_check "strict"
 
+# Walk the live objects with several threads, and (where the kernel
+# has soft-dirty bits) skip the heap pages that haven't changed.
+export HEAP_CHECK_SCAN_THREADS=4
+run_check "normal"
+export HEAP_CHECK_INCREMENTAL=1
+run_check "strict"
+unset HEAP_CHECK_SCAN_THREADS HEAP_CHECK_INCREMENTAL
+
 rm -rf $TMPDIR      # clean up
 
 echo "PASS"
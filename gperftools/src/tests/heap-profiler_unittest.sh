@@ -140,6 +140,24 @@ VerifyOutputContains "62 MB freed"
 # testing of the HeapProfileStart/Stop functionality.
 $HEAP_PROFILER >"$TEST_TMPDIR/output2" 2>&1
 
+# In sampled mode, check we still dump and write a profile that pprof
+# knows to scale back up.
+rm -f "$HEAPPROFILE".*
+HEAP_PROFILE_SAMPLED=1 TCMALLOC_SAMPLE_PARAMETER=65536 \
+    $HEAP_PROFILER >"$TEST_TMPDIR/output" 2>&1
+if ! grep "@ heap_v2/65536" "$HEAPPROFILE".*.heap >/dev/null 2>&1; then
+  echo "--- Test failed: sampled mode did not write a heap_v2 profile"
+  cat "$TEST_TMPDIR/output"
+  num_failures=`expr $num_failures + 1`
+fi
+
+# In buffered mode dumps come less often, so their numbers differ;
+# check we still saw all of the allocating and freeing.
+rm -f "$HEAPPROFILE".*
+HEAP_PROFILE_BUFFERED=1 $HEAP_PROFILER >"$TEST_TMPDIR/output" 2>&1
+VerifyOutputContains "62 MB allocated"
+VerifyOutputContains "62 MB freed"
+
 rm -rf $TMPDIR      # clean up
 
 if [ $num_failures = 0 ]; then
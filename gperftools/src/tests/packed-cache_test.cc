@@ -32,6 +32,7 @@
 // Author: Geoff Pike
 
 #include <stdio.h>
+#include <stdlib.h>
 #include "base/logging.h"
 #include "packed-cache-inl.h"
 
@@ -39,7 +40,7 @@ static const int kHashbits = PackedCache<64, uint64>::kHashbits;
 
 // A basic sanity test.
 void PackedCacheTest_basic() {
-  PackedCache<32, uint32> cache(0);
+  PackedCache<32, uint32> cache(0, kHashbits, malloc);
   CHECK_EQ(cache.GetOrDefault(0, 1), 0);
   cache.Put(0, 17);
   CHECK(cache.Has(0));
@@ -55,8 +56,41 @@ void PackedCacheTest_basic() {
   CHECK_EQ(cache.GetOrDefault(1 << kHashbits, 1), 22);
 }
 
+// The table size is picked at construction, within limits.
+void PackedCacheTest_hashbits() {
+  // Whole keys fit in the entries
+  typedef PackedCache<32, uint64> Big;
+  Big big(0, 20, malloc);
+  CHECK_EQ(big.hashbits(), 20);
+  big.Put(0, 17);
+  big.Put(1 << kHashbits, 22);   // would conflict with the default size
+  CHECK_EQ(big.GetOrDefault(0, 1), 17);
+  CHECK_EQ(big.GetOrDefault(1 << kHashbits, 1), 22);
+  big.Put(1 << 20, 5);
+  CHECK_EQ(big.GetOrDefault(0, 1), 1);
+
+  // Partial keys: 20 bit keys and 7 bit values need >= 11 hash bits
+  // for a uint16.
+  typedef PackedCache<20, uint16> Small;
+  CHECK(Small::kMinHashbits == 11);
+  Small small(0, 4, malloc);
+  CHECK_EQ(small.hashbits(), 11);
+  CHECK(small.Has(5));
+  CHECK(!small.Has(5 + (1 << 11)));
+  small.Put(5 + (3 << 11), 99);
+  CHECK_EQ(small.GetOrDefault(5 + (3 << 11), 1), 99);
+  CHECK_EQ(small.GetOrDefault(5, 1), 1);
+  CHECK_EQ(small.GetOrDefault(5 + (2 << 11), 1), 1);
+  small.Clear(3);
+  CHECK_EQ(small.GetOrDefault(5, 1), 3);
+
+  Big capped(0, 100, malloc);
+  CHECK(capped.hashbits() == Big::kMaxHashbits);
+}
+
 int main(int argc, char **argv) {
   PackedCacheTest_basic();
+  PackedCacheTest_hashbits();
 
   printf("PASS\n");
   return 0;
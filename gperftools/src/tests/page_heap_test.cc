@@ -47,6 +47,8 @@ static void TestPageHeap_Stats() {
   // Allocate a span 's1'
   tcmalloc::Span* s1 = ph->New(256);
   CheckStats(ph, 256, 0, 0);
+  // (it's fresh from the system, so known to be zero)
+  EXPECT_TRUE(s1->zeroed);
 
   // Split span 's1' into 's1', 's2'.  Delete 's2'
   tcmalloc::Span* s2 = ph->Split(s1, 128);
@@ -64,6 +66,117 @@ static void TestPageHeap_Stats() {
   delete ph;
 }
 
+static void TestPageHeap_Grow() {
+  tcmalloc::PageHeap* ph = new tcmalloc::PageHeap();
+
+  // Split span 's1' into 's1', 's2', 's3'.  Delete 's2'
+  tcmalloc::Span* s1 = ph->New(256);
+  tcmalloc::Span* s2 = ph->Split(s1, 64);
+  tcmalloc::Span* s3 = ph->Split(s2, 64);
+  ph->Delete(s2);
+  CheckStats(ph, 256, 64, 0);
+
+  // 's1' can't grow past 's3'
+  bool zeroed = true;
+  EXPECT_FALSE(ph->GrowSpan(s1, 192, &zeroed));
+  EXPECT_EQ(64, s1->length);
+
+  // Grow 's1' into part of the freed (and still dirty) pages
+  EXPECT_TRUE(ph->GrowSpan(s1, 96, &zeroed));
+  EXPECT_FALSE(zeroed);
+  EXPECT_EQ(96, s1->length);
+  EXPECT_EQ(s1, ph->GetDescriptor(s1->start + 95));
+  CheckStats(ph, 256, 32, 0);
+
+  // Unmap the rest; growing into it gives back zero pages
+  ph->ReleaseAtLeastNPages(1);
+  CheckStats(ph, 256, 0, 32);
+  EXPECT_TRUE(ph->GrowSpan(s1, 128, &zeroed));
+  EXPECT_EQ(HaveSystemRelease, zeroed);
+  EXPECT_EQ(128, s1->length);
+  CheckStats(ph, 256, 0, 0);
+  EXPECT_TRUE(ph->CheckExpensive());
+
+  ph->Delete(s1);
+  ph->Delete(s3);
+  CheckStats(ph, 256, 256, 0);
+
+  delete ph;
+}
+
+static void TestPageHeap_DeferredRelease() {
+  tcmalloc::PageHeap* ph = new tcmalloc::PageHeap();
+  ph->SetAggressiveDecommit(true);
+
+  tcmalloc::Span* s1 = ph->New(256);
+  tcmalloc::Span* s2 = ph->Split(s1, 128);
+  CheckStats(ph, 256, 0, 0);
+
+  // Deleted spans wait, still in use (but counted as free), until
+  // ReleaseDeferred()
+  ph->Delete(s2);
+  EXPECT_TRUE(ph->HasDeferred());
+  CheckStats(ph, 256, 128, 0);
+  ph->ReleaseDeferred();
+  EXPECT_FALSE(ph->HasDeferred());
+  CheckStats(ph, 256, 0, 128);
+
+  // In background release mode, only BackgroundRelease() releases them
+  ph->SetBackgroundRelease(true);
+  ph->Delete(s1);
+  ph->ReleaseDeferred();
+  EXPECT_TRUE(ph->HasDeferred());
+  CheckStats(ph, 256, 128, 128);
+  ph->BackgroundRelease();
+  EXPECT_FALSE(ph->HasDeferred());
+  CheckStats(ph, 256, 0, 256);
+  EXPECT_TRUE(ph->CheckExpensive());
+
+  delete ph;
+}
+
+static void TestPageHeap_LargeBestFit() {
+  tcmalloc::PageHeap* ph = new tcmalloc::PageHeap();
+  const Length k = kMaxPages;
+
+  // Carve [a: 3k][1][b: 2k][1][c: 2k][1][rest] and free a, b and c; the
+  // one-page spans in between keep them from coalescing.
+  tcmalloc::Span* a = ph->New(8 * k);
+  tcmalloc::Span* x = ph->Split(a, 3 * k);
+  tcmalloc::Span* b = ph->Split(x, 1);
+  tcmalloc::Span* y = ph->Split(b, 2 * k);
+  tcmalloc::Span* c = ph->Split(y, 1);
+  tcmalloc::Span* z = ph->Split(c, 2 * k);
+  tcmalloc::Span* rest = ph->Split(z, 1);
+  const PageID a_start = a->start;
+  const PageID b_start = b->start;
+  const PageID c_start = c->start;
+  ph->Delete(a);
+  ph->Delete(c);
+  ph->Delete(b);
+  EXPECT_TRUE(ph->CheckExpensive());
+
+  // Best fit, and the lowest address among equally good fits
+  tcmalloc::Span* s1 = ph->New(2 * k);
+  EXPECT_EQ(b_start, s1->start);
+  tcmalloc::Span* s2 = ph->New(k + 1);
+  EXPECT_EQ(c_start, s2->start);
+  tcmalloc::Span* s3 = ph->New(2 * k);
+  EXPECT_EQ(a_start, s3->start);
+  EXPECT_TRUE(ph->CheckExpensive());
+
+  ph->Delete(s1);
+  ph->Delete(s2);
+  ph->Delete(s3);
+  ph->Delete(x);
+  ph->Delete(y);
+  ph->Delete(z);
+  ph->Delete(rest);
+  EXPECT_TRUE(ph->CheckExpensive());
+
+  delete ph;
+}
+
 static void TestPageHeap_Limit() {
   tcmalloc::PageHeap* ph = new tcmalloc::PageHeap();
 
@@ -156,6 +269,9 @@ static void TestPageHeap_Limit() {
 
 int main(int argc, char **argv) {
   TestPageHeap_Stats();
+  TestPageHeap_Grow();
+  TestPageHeap_DeferredRelease();
+  TestPageHeap_LargeBestFit();
   TestPageHeap_Limit();
   printf("PASS\n");
   // on windows as part of library destructors we call getenv which
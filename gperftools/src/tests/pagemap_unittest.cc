@@ -161,6 +161,35 @@ void TestNext(const char* name) {
   CHECK(map.Next(103) == NULL);
 }
 
+// REQUIRES: BITS==10
+template <class Type>
+void TestSizeClass(const char* name) {
+  RAW_LOG(ERROR, "Running SizeClassTest %s\n", name);
+  Type map(malloc);
+
+  // Out of range, or not ensured yet
+  CHECK_EQ(map.sizeclass(5), 0);
+  CHECK_EQ(map.sizeclass(1<<30), 0);
+  map.PrefetchSizeClass(5);
+  map.PrefetchSizeClass(1<<30);
+
+  map.Ensure(0, 1 << 10);
+  for (int i = 0; i < (1 << 10); i++) {
+    CHECK_EQ(map.sizeclass(i), 0);
+  }
+  map.set(40, &map);
+  map.set_sizeclass(40, 7);
+  map.set_sizeclass(1023, 127);
+  map.PrefetchSizeClass(40);
+  CHECK_EQ(map.sizeclass(40), 7);
+  CHECK_EQ(map.sizeclass(41), 0);
+  CHECK_EQ(map.sizeclass(1023), 127);
+  CHECK(map.get(40) == &map);   // the pointers are separate
+  CHECK(map.get(1023) == NULL);
+  map.set_sizeclass(40, 0);
+  CHECK_EQ(map.sizeclass(40), 0);
+}
+
 int main(int argc, char** argv) {
   TestMap< TCMalloc_PageMap1<10> > (100, true);
   TestMap< TCMalloc_PageMap1<10> > (1 << 10, false);
@@ -173,6 +202,10 @@ int main(int argc, char** argv) {
   TestNext< TCMalloc_PageMap2<10> >("PageMap2");
   TestNext< TCMalloc_PageMap3<10> >("PageMap3");
 
+  TestSizeClass< TCMalloc_PageMap1<10> >("PageMap1");
+  TestSizeClass< TCMalloc_PageMap2<10> >("PageMap2");
+  TestSizeClass< TCMalloc_PageMap3<10> >("PageMap3");
+
   printf("PASS\n");
   return 0;
 }
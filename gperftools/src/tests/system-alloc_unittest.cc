@@ -34,6 +34,8 @@
 #include "config_for_unittests.h"
 #include "system-alloc.h"
 #include <stdio.h>
+#include <stdlib.h>             // for calloc, free
+#include <string.h>             // for memset
 #if defined HAVE_STDINT_H
 #include <stdint.h>             // to get uintptr_t
 #elif defined HAVE_INTTYPES_H
@@ -50,10 +52,13 @@ class ArraySysAllocator : public SysAllocator {
 public:
   // Was this allocator invoked at least once?
   bool invoked_;
+  // Should it hand out memory with garbage in it?
+  bool dirty_;
 
   ArraySysAllocator() : SysAllocator() {
     ptr_ = 0;
     invoked_ = false;
+    dirty_ = false;
   }
 
   void* Alloc(size_t size, size_t *actual_size, size_t alignment) {
@@ -80,6 +85,9 @@ public:
     }
 
     ptr_ += size;
+    if (dirty_) {
+      memset(reinterpret_cast<void *>(ptr), 0xab, size - extra);
+    }
     return reinterpret_cast<void *>(ptr);
   }
 
@@ -108,6 +116,40 @@ static void TestBasicInvoked() {
   CHECK(a.invoked_);
 }
 
+static void TestDirtyMemoryZeroed() {
+  // Our allocator doesn't say its memory is zero (as it isn't), so calloc()
+  // must zero it, even though it's new.
+  a.dirty_ = true;
+  const size_t kSize = 3 * 1024 * 1024;
+  char *p = static_cast<char *>(calloc(kSize, 1));
+  CHECK(p != NULL);
+  for (size_t i = 0; i < kSize; i++) {
+    CHECK_EQ(p[i], 0);
+  }
+  free(p);
+  a.dirty_ = false;
+}
+
+static void TestReleasedMemoryZeroed() {
+  // Memory released to the system reads back as zero once committed again
+  // (the page heap counts on that for the spans it returned), unless it was
+  // released lazily and the system hasn't taken it.
+  const size_t kSize = 1 << 20;
+  char* p = static_cast<char*>(TCMalloc_SystemMap(kSize, kPageSize));
+  if (p == NULL) return;  // (not supported here)
+  memset(p, 0xab, kSize);
+  if (TCMalloc_SystemRelease(p, kSize)) {
+    TCMalloc_SystemCommit(p, kSize);
+    if (!TCMalloc_SystemReleaseIsLazy() ||
+        TCMalloc_SystemIsReclaimed(p, kSize)) {
+      for (size_t i = 0; i < kSize; i++) {
+        CHECK_EQ(p[i], 0);
+      }
+    }
+  }
+  TCMalloc_SystemUnmap(p, kSize);
+}
+
 #if 0  // could port this to various OSs, but won't bother for now
 TEST(AddressBits, CpuVirtualBits) {
   // Check that kAddressBits is as least as large as either the number of bits
@@ -148,6 +190,8 @@ static void TestBasicRetryFailTest() {
 
 int main(int argc, char** argv) {
   TestBasicInvoked();
+  TestDirtyMemoryZeroed();
+  TestReleasedMemoryZeroed();
   TestBasicRetryFailTest();
 
   printf("PASS\n");
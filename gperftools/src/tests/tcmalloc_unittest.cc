@@ -82,6 +82,9 @@
 #ifdef HAVE_MALLOC_H
 #include <malloc.h>        // defines pvalloc/etc on cygwin
 #endif
+#ifdef __linux__
+#include <sched.h>         // for sched_setaffinity
+#endif
 #include <assert.h>
 #include <vector>
 #include <algorithm>
@@ -91,6 +94,7 @@
 #include "base/simple_mutex.h"
 #include "gperftools/malloc_hook.h"
 #include "gperftools/malloc_extension.h"
+#include "gperftools/malloc_stats_page.h"
 #include "gperftools/tcmalloc.h"
 #include "thread_cache.h"
 #include "system-alloc.h"
@@ -157,6 +161,7 @@ using std::string;
 DECLARE_double(tcmalloc_release_rate);
 DECLARE_int32(max_free_queue_size);     // in debugallocation.cc
 DECLARE_int64(tcmalloc_sample_parameter);
+DECLARE_int64(tcmalloc_heap_limit_mb);
 
 namespace testing {
 
@@ -626,6 +631,263 @@ static void TestRealloc() {
 #endif
 }
 
+static bool IsAllZero(const void* p, size_t size) {
+  const char* c = static_cast<const char*>(p);
+  for (size_t i = 0; i < size; ++i) {
+    if (c[i] != 0) return false;
+  }
+  return true;
+}
+
+// Everything we hand out must read as zero, whether it was carved from fresh
+// pages (where we skip most of the memset), zeroed when it was freed, or
+// reused after being dirtied, and whichever way it gets zeroed.
+static void TestZeroing(bool zero_on_free, size_t nontemporal_threshold) {
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+  static const int kNumObjects = 1000;
+  int sizes[] = { 8, 24, 100, 1000, 10000, 100000 };
+  void* objects[kNumObjects];
+
+  size_t old_zero_on_free = 0;
+  MallocExtension::instance()->GetNumericProperty("tcmalloc.zero_on_free",
+                                                  &old_zero_on_free);
+  MallocExtension::instance()->SetNumericProperty("tcmalloc.zero_on_free",
+                                                  zero_on_free);
+  size_t old_threshold = 0;
+  MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.nontemporal_zero_threshold", &old_threshold);
+  MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.nontemporal_zero_threshold", nontemporal_threshold);
+
+  for (int s = 0; s < sizeof(sizes)/sizeof(*sizes); ++s) {
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < kNumObjects; ++i) {
+        objects[i] = malloc(sizes[s]);
+        CHECK(objects[i]);
+        CHECK(IsAllZero(objects[i], sizes[s]));
+        memset(objects[i], 0xff, sizes[s]);
+      }
+      // free every other object, so fresh and dirty objects get mixed
+      for (int i = 0; i < kNumObjects; i += 2) free(objects[i]);
+      for (int i = 1; i < kNumObjects; i += 2) free(objects[i]);
+      if (round == 1) MallocExtension::instance()->ZeroThreadFreeMemory();
+    }
+
+    // the grown part of a realloc must be zero too
+    void* p = malloc(sizes[s]);
+    memset(p, 0xff, sizes[s]);
+    void* q = realloc(p, sizes[s] * 4);
+    CHECK(q);
+    CHECK(IsAllZero(static_cast<char*>(q) + sizes[s], sizes[s] * 3));
+    free(q);
+  }
+
+  // large allocations come straight from the page heap, which may hand
+  // back pages it never decommitted
+  static const int kNumLarge = 8;
+  static const size_t kLargeSize = 1 << 20;
+  void* large[kNumLarge];
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < kNumLarge; ++i) {
+      large[i] = malloc(kLargeSize + i * 4096);
+      CHECK(large[i]);
+      CHECK(IsAllZero(large[i], kLargeSize + i * 4096));
+      memset(large[i], 0xff, kLargeSize + i * 4096);
+    }
+    for (int i = 0; i < kNumLarge; ++i) free(large[i]);
+  }
+
+  // the largest size classes can be zeroed from whole pages instead, or not
+  size_t old_page_threshold = 0;
+  MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.page_zero_threshold", &old_page_threshold);
+  for (int pass = 0; pass < 2; ++pass) {
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.page_zero_threshold", pass == 0 ? 256 << 10 : 0);
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < kNumLarge; ++i) {
+        const size_t size = (300 << 10) + i * 20000;
+        large[i] = malloc(size);
+        CHECK(large[i]);
+        CHECK(IsAllZero(large[i], size));
+        memset(large[i], 0xff, size);
+      }
+      for (int i = 0; i < kNumLarge; ++i) free(large[i]);
+    }
+  }
+  MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.page_zero_threshold", old_page_threshold);
+
+  // the slack of a big size class is zero by the time it can be seen,
+  // whether through the allocated size or realloc
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < kNumLarge; ++i) {
+      const size_t size = (128 << 10) + 1 + i * 3000;
+      large[i] = malloc(size);
+      CHECK(large[i]);
+      CHECK(IsAllZero(large[i], size));
+      if (i % 2 == 0) {
+        const size_t usable =
+            MallocExtension::instance()->GetAllocatedSize(large[i]);
+        CHECK_GE(usable, size);
+        CHECK(IsAllZero(large[i], usable));
+        memset(large[i], 0xff, usable);
+      } else {
+        memset(large[i], 0xff, size);
+        void* p = realloc(large[i], size + 1);
+        CHECK(p);
+        CHECK(IsAllZero(static_cast<char*>(p) + size, 1));
+        large[i] = p;
+      }
+    }
+    for (int i = 0; i < kNumLarge; ++i) free(large[i]);
+  }
+
+  // aligned allocations get zeroed the same way, whatever path they take
+  if (kOSSupportsMemalign) {
+    static const size_t kAligns[] = { 64, 4096, 1 << 16 };
+    static const size_t kAlignedSizes[] = { 100, 5000, 200000 };
+    for (int a = 0; a < sizeof(kAligns)/sizeof(*kAligns); ++a) {
+      for (int s = 0; s < sizeof(kAlignedSizes)/sizeof(*kAlignedSizes); ++s) {
+        const size_t size = kAlignedSizes[s];
+        for (int round = 0; round < 3; ++round) {
+          for (int i = 0; i < kNumLarge; ++i) {
+            large[i] = NULL;
+            CHECK_EQ(0, PosixMemalign(&large[i], kAligns[a], size));
+            CHECK_EQ(0, reinterpret_cast<uintptr_t>(large[i]) % kAligns[a]);
+            CHECK(IsAllZero(large[i], size));
+            memset(large[i], 0xff, size);
+          }
+          for (int i = 0; i < kNumLarge; ++i) free(large[i]);
+        }
+      }
+    }
+  }
+
+  MallocExtension::instance()->SetNumericProperty("tcmalloc.zero_on_free",
+                                                  old_zero_on_free);
+  MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.nontemporal_zero_threshold", old_threshold);
+#endif
+}
+
+#ifndef DEBUGALLOCATION
+static bool IsAllByte(const void* p, size_t size, unsigned char byte) {
+  const unsigned char* c = static_cast<const unsigned char*>(p);
+  for (size_t i = 0; i < size; ++i) {
+    if (c[i] != byte) return false;
+  }
+  return true;
+}
+#endif
+
+// With a fill byte, malloc, new and realloc's new bytes hand out the
+// pattern instead of zero, whether or not the memory was known to be zero
+// already; calloc still zeroes.
+static void TestMallocFillByte() {
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+  static const unsigned char kFill = 0xcc;
+  int sizes[] = { 8, 100, 10000, 1000000 };
+
+  size_t old_fill = 0;
+  MallocExtension::instance()->GetNumericProperty("tcmalloc.malloc_fill_byte",
+                                                  &old_fill);
+  MallocExtension::instance()->SetNumericProperty("tcmalloc.malloc_fill_byte",
+                                                  kFill);
+  for (int s = 0; s < sizeof(sizes)/sizeof(*sizes); ++s) {
+    const size_t size = sizes[s];
+    for (int round = 0; round < 3; ++round) {
+      char* p = static_cast<char*>(malloc(size));
+      CHECK(IsAllByte(p, size, kFill));
+      memset(p, 0x11, size);
+      p = static_cast<char*>(realloc(p, size * 2));
+      CHECK(IsAllByte(p, size, 0x11));
+      CHECK(IsAllByte(p + size, size, kFill));
+      free(p);
+
+      p = new char[size];
+      CHECK(IsAllByte(p, size, kFill));
+      memset(p, 0x11, size);
+      delete[] p;
+
+      p = static_cast<char*>(calloc(1, size));
+      CHECK(IsAllZero(p, size));
+      memset(p, 0x11, size);
+      free(p);
+    }
+  }
+  MallocExtension::instance()->SetNumericProperty("tcmalloc.malloc_fill_byte",
+                                                  old_fill);
+#endif
+}
+
+static size_t GetZeroCounter(const char* name) {
+  size_t value = 0;
+  CHECK(MallocExtension::instance()->GetNumericProperty(name, &value));
+  return value;
+}
+
+static void TestZeroStats() {
+#ifndef DEBUGALLOCATION  // debug alloc does its own zeroing
+  const size_t zeroed = GetZeroCounter("tcmalloc.zeroed_bytes");
+  const size_t objects = GetZeroCounter("tcmalloc.zeroed_objects");
+  const size_t skipped = GetZeroCounter("tcmalloc.zero_skipped_bytes");
+
+  // a dirty object gets zeroed, either when it's freed (in zero-on-free
+  // mode) or when calloc hands it out again
+  void* p = malloc(1000);
+  memset(p, 0xff, 1000);
+  free(p);
+  free(calloc(1, 1000));
+  CHECK_GE(GetZeroCounter("tcmalloc.zeroed_bytes"), zeroed + 1000);
+  CHECK_GT(GetZeroCounter("tcmalloc.zeroed_objects"), objects);
+
+  // and a large calloc is either zeroed or known to be zero
+  const size_t total = GetZeroCounter("tcmalloc.zeroed_bytes") +
+      GetZeroCounter("tcmalloc.zero_skipped_bytes");
+  free(calloc(1, 1 << 20));
+  CHECK_GE(GetZeroCounter("tcmalloc.zeroed_bytes") +
+           GetZeroCounter("tcmalloc.zero_skipped_bytes"), total + (1 << 20));
+  CHECK_GE(GetZeroCounter("tcmalloc.zero_skipped_bytes"), skipped);
+
+  char buffer[64 << 10];
+  MallocExtension::instance()->GetStats(buffer, sizeof(buffer));
+  CHECK(strstr(buffer, "ZERO: small") != NULL);
+  CHECK(strstr(buffer, "ZERO: pages") != NULL);
+#endif
+}
+
+// With TCMALLOC_STATS_PAGE, the page tracks what the properties say.
+static void TestStatsPage() {
+  size_t address = 0;
+  if (!MallocExtension::instance()->GetNumericProperty("tcmalloc.stats_page",
+                                                       &address) ||
+      address == 0) {
+    return;
+  }
+  const MallocStatsPage* page =
+      reinterpret_cast<const MallocStatsPage*>(address);
+  MallocStatsPage snapshot;
+  CHECK(MallocStatsPage_Read(page, &snapshot));
+  CHECK_GT(snapshot.heap_size, 0);
+  CHECK_LE(snapshot.current_allocated_bytes, snapshot.heap_size);
+  CHECK_GT(snapshot.num_classes, 1);
+  CHECK_GT(snapshot.class_size[1], 0);
+
+  // Another update picks up a big allocation
+  const size_t kSize = 64 << 20;
+  void* p = malloc(kSize);
+  const uint64_t updates = snapshot.updates;
+  struct timespec tick = { 0, 10 * 1000 * 1000 };
+  do {
+    nanosleep(&tick, NULL);
+    CHECK(MallocStatsPage_Read(page, &snapshot));
+  } while (snapshot.updates < updates + 2);
+  CHECK_GE(snapshot.current_allocated_bytes, kSize);
+  CHECK_GE(snapshot.heap_size, kSize);
+  free(p);
+}
+
 static void TestNewHandler() throw (std::bad_alloc) {
   ++news_handled;
   throw std::bad_alloc();
@@ -744,8 +1006,23 @@ static void TestNothrowNew(void* (*func)(size_t, const std::nothrow_t&)) {
   }
 
 // We do one for each hook typedef in malloc_hook.h
+#ifdef NO_TCMALLOC_MALLOC_HOOKS
+// tcmalloc was built without new and delete hooks: they can't be added,
+// and there are no calls to check.
+static void IgnoreNewHook(const void* ptr, size_t size) { }
+static void IgnoreDeleteHook(const void* ptr) { }
+static void SetNewHook() { CHECK(!MallocHook::AddNewHook(&IgnoreNewHook)); }
+static void SetDeleteHook() {
+  CHECK(!MallocHook::AddDeleteHook(&IgnoreDeleteHook));
+}
+static void ResetNewHook() { }
+static void ResetDeleteHook() { }
+static void VerifyNewHookWasCalled() { }
+static void VerifyDeleteHookWasCalled() { }
+#else
 MAKE_HOOK_CALLBACK(NewHook);
 MAKE_HOOK_CALLBACK(DeleteHook);
+#endif
 MAKE_HOOK_CALLBACK(MmapHook);
 MAKE_HOOK_CALLBACK(MremapHook);
 MAKE_HOOK_CALLBACK(MunmapHook);
@@ -837,6 +1114,15 @@ static void CheckRangeCallback(void* ptr, base::MallocRange::Type type,
 
 }
 
+// With TCMALLOC_PREFAULT_BYTES, memory is only released while enough of
+// it stays committed, which depends on everything else the test does.
+static bool PrefaultFloorSet() {
+  size_t value = 0;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.prefault_bytes", &value));
+  return value != 0;
+}
+
 static bool HaveSystemRelease =
     TCMalloc_SystemRelease(TCMalloc_SystemAlloc(kPageSize, NULL, 0), kPageSize);
 
@@ -852,6 +1138,10 @@ static void TestRanges() {
   free(a);
   CheckRangeCallback(a, base::MallocRange::FREE, MB);
   CheckRangeCallback(b, base::MallocRange::INUSE, MB);
+  if (PrefaultFloorSet()) {
+    free(b);
+    return;
+  }
   MallocExtension::instance()->ReleaseFreeMemory();
   CheckRangeCallback(a, releasedType, MB);
   CheckRangeCallback(b, base::MallocRange::INUSE, MB);
@@ -867,6 +1157,13 @@ static size_t GetUnmappedBytes() {
       "tcmalloc.pageheap_unmapped_bytes", &bytes));
   return bytes;
 }
+
+static size_t GetDecommitCount() {
+  size_t count;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.pageheap_decommit_count", &count));
+  return count;
+}
 #endif
 
 class AggressiveDecommitChanger {
@@ -886,13 +1183,25 @@ public:
   }
 };
 
+#ifndef DEBUGALLOCATION
+// The background release thread releases memory at times of its own
+// choosing, which throws off tests that expect it released at once.
+static bool BackgroundReleaseRunning() {
+  size_t value = 0;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.background_release", &value));
+  return value != 0;
+}
+#endif
+
 static void TestReleaseToSystem() {
   // Debug allocation mode adds overhead to each allocation which
   // messes up all the equality tests here.  I just disable the
   // teset in this mode.  TODO(csilvers): get it to work for debugalloc?
 #ifndef DEBUGALLOCATION
 
-  if(!HaveSystemRelease) return;
+  if(!HaveSystemRelease || BackgroundReleaseRunning() || PrefaultFloorSet())
+    return;
 
   const double old_tcmalloc_release_rate = FLAGS_tcmalloc_release_rate;
   FLAGS_tcmalloc_release_rate = 0;
@@ -910,14 +1219,17 @@ static void TestReleaseToSystem() {
   EXPECT_EQ(starting_bytes, GetUnmappedBytes());
 
   // ReleaseToSystem shouldn't do anything either.
+  const size_t starting_decommits = GetDecommitCount();
   MallocExtension::instance()->ReleaseToSystem(MB);
   EXPECT_EQ(starting_bytes, GetUnmappedBytes());
+  EXPECT_EQ(starting_decommits, GetDecommitCount());
 
   free(a);
 
-  // The span to release should be 1MB.
+  // The span to release should be 1MB, in one system call.
   MallocExtension::instance()->ReleaseToSystem(MB/2);
   EXPECT_EQ(starting_bytes + MB, GetUnmappedBytes());
+  EXPECT_EQ(starting_decommits + 1, GetDecommitCount());
 
   // Should do nothing since the previous call released too much.
   MallocExtension::instance()->ReleaseToSystem(MB/4);
@@ -955,7 +1267,8 @@ static void TestAggressiveDecommit() {
   // teset in this mode.
 #ifndef DEBUGALLOCATION
 
-  if(!HaveSystemRelease) return;
+  if(!HaveSystemRelease || BackgroundReleaseRunning() || PrefaultFloorSet())
+    return;
 
   fprintf(LOGSTREAM, "Testing aggressive de-commit\n");
 
@@ -1004,6 +1317,55 @@ static void OnNoMemory() {
   std::set_new_handler(g_old_handler);
 }
 
+static void TestBackgroundRelease() {
+#ifndef DEBUGALLOCATION
+  if (!HaveSystemRelease || !BackgroundReleaseRunning() || PrefaultFloorSet())
+    return;
+
+  fprintf(LOGSTREAM, "Testing background release\n");
+  static const int MB = 1048576;
+  struct timespec tick = { 0, 10 * 1000 * 1000 };
+
+  // (with huge pages, spans this big are kept committed)
+  if (TCMalloc_SystemHugePageSize() == 0) {
+    // Freed spans are released, but not by free()
+    AggressiveDecommitChanger enabler(1);
+    void* a = malloc(4 * MB);
+    memset(a, 1, 4 * MB);
+    const size_t starting_bytes = GetUnmappedBytes();
+    free(a);
+    for (int i = 0; i < 500 && GetUnmappedBytes() < starting_bytes + 4 * MB;
+         i++) {
+      nanosleep(&tick, NULL);
+    }
+    CHECK_GE(GetUnmappedBytes(), starting_bytes + 4 * MB);
+  }
+
+  {
+    // Free spans that stay committed get zeroed, after which calloc()
+    // trusts them to be zero
+    AggressiveDecommitChanger disabler(0);
+    static const int kBlocks = 16;
+    static const size_t kSize = 300 << 10;   // beyond the size classes
+    void* blocks[kBlocks];
+    for (int round = 0; round < 2; round++) {
+      for (int i = 0; i < kBlocks; i++) {
+        blocks[i] = malloc(kSize);
+        memset(blocks[i], 0xff, kSize);
+      }
+      for (int i = 0; i < kBlocks; i++) free(blocks[i]);
+      for (int i = 0; i < 20; i++) nanosleep(&tick, NULL);
+      for (int i = 0; i < kBlocks; i++) {
+        const char* p = static_cast<const char*>(calloc(1, kSize));
+        for (size_t j = 0; j < kSize; j++) CHECK_EQ(0, p[j]);
+        blocks[i] = const_cast<char*>(p);
+      }
+      for (int i = 0; i < kBlocks; i++) free(blocks[i]);
+    }
+  }
+#endif  // #ifndef DEBUGALLOCATION
+}
+
 static void TestSetNewMode() {
   int old_mode = tc_set_new_mode(1);
 
@@ -1047,6 +1409,480 @@ static void TestSetNewMode() {
   tc_set_new_mode(old_mode);
 }
 
+#ifndef DEBUGALLOCATION
+static size_t GetAllocatedBytes() {
+  size_t value;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "generic.current_allocated_bytes", &value));
+  return value;
+}
+#endif
+
+// Sized delete has to put each object back where a plain delete would
+// have: if it picked the wrong size class, the allocated byte count
+// would be off.
+static void TestSizedDelete() {
+  fprintf(LOGSTREAM, "Testing sized delete\n");
+  static const int kObjects = 100;
+  void* objects[kObjects];
+  for (size_t size = 0; size <= (1 << 20); size += (size < 1024 ? 5 : size)) {
+#ifndef DEBUGALLOCATION
+    const size_t before = GetAllocatedBytes();
+#endif
+    for (int i = 0; i < kObjects; i++) {
+      objects[i] = (i % 2) ? tc_new(size) : tc_newarray(size);
+      memset(objects[i], 0xab, size);
+    }
+    for (int i = 0; i < kObjects; i++) {
+      if (i % 2) {
+        tc_delete_sized(objects[i], size);
+      } else {
+        tc_deletearray_sized(objects[i], size);
+      }
+    }
+#ifndef DEBUGALLOCATION  // debug alloc holds on to freed blocks for a while
+    EXPECT_EQ(before, GetAllocatedBytes());
+#endif
+  }
+}
+
+// Batches must hand out distinct, zeroed objects, including ones that
+// come back dirty from a previous batch, and give them all back.
+static void TestBatch() {
+  fprintf(LOGSTREAM, "Testing batch allocation\n");
+  static const size_t kObjects = 3000;   // more than one chunk
+  vector<void*> ptrs(kObjects);
+  const size_t sizes[] = { 0, 8, 40, 1000, 40000, 300000 };
+  for (int s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+    const size_t size = sizes[s];
+    const size_t n = (size > 100000) ? 30 : kObjects;
+#ifndef DEBUGALLOCATION
+    const size_t before = GetAllocatedBytes();
+#endif
+    for (int round = 0; round < 2; round++) {
+      CHECK_EQ(n, tc_malloc_batch(size, &ptrs[0], n));
+      for (size_t i = 0; i < n; i++) {
+        const char* p = reinterpret_cast<const char*>(ptrs[i]);
+        CHECK(p != NULL);
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+        for (size_t j = 0; j < size; j++) {
+          CHECK_EQ(0, p[j]);
+        }
+#endif
+        memset(ptrs[i], 0xcd, size);
+      }
+      vector<void*> sorted(ptrs.begin(), ptrs.begin() + n);
+      std::sort(sorted.begin(), sorted.end());
+      for (size_t i = 1; i < n; i++) {
+        CHECK(reinterpret_cast<char*>(sorted[i - 1]) + size <=
+              reinterpret_cast<char*>(sorted[i]));
+      }
+      // Give half of them back one by one, to mix the two paths
+      for (size_t i = 0; i < n / 2; i++) free(ptrs[i]);
+      tc_free_batch(&ptrs[n / 2], n - n / 2, size);
+    }
+#ifndef DEBUGALLOCATION  // debug alloc holds on to freed blocks for a while
+    EXPECT_EQ(before, GetAllocatedBytes());
+#endif
+  }
+}
+
+// The size-returning entry points report the whole object, all of it
+// zeroed, even when it comes back dirty.
+static void TestSizedAllocation() {
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+  fprintf(LOGSTREAM, "Testing size-returning allocation\n");
+  // (262145 leaves a 32K tail malloc would zero lazily)
+  const size_t sizes[] = { 0, 8, 100, 3000, 262145, (1 << 20) + 1 };
+  for (int s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+    const size_t size = sizes[s];
+    const size_t before = GetAllocatedBytes();
+    for (int round = 0; round < 2; round++) {
+      size_t actual = 0;
+      void* p = tc_malloc_sized(size, &actual);
+      CHECK(p != NULL);
+      CHECK_GE(actual, size);
+      CHECK_EQ(actual, tc_malloc_size(p));
+      CHECK(IsAllZero(p, actual));
+      memset(p, 0xcd, actual);
+      free(p);
+
+      p = tc_new_sized(size, &actual);
+      CHECK_GE(actual, size);
+      CHECK(IsAllZero(p, actual));
+      memset(p, 0xcd, actual);
+      tc_delete_sized(p, actual);
+    }
+    EXPECT_EQ(before, GetAllocatedBytes());
+  }
+  // Sampled objects (in builds that sample) get spans of their own, and
+  // report the whole span; allocate enough that some of them are sampled.
+  for (int i = 0; i < 2000; i++) {
+    size_t actual = 0;
+    void* p = tc_malloc_sized(3000, &actual);
+    CHECK(p != NULL);
+    CHECK_EQ(actual, tc_malloc_size(p));
+    CHECK(IsAllZero(p, actual));
+    memset(p, 0xcd, actual);
+    free(p);
+  }
+#endif
+}
+
+static void TestArena() {
+  fprintf(LOGSTREAM, "Testing arenas\n");
+  tc_arena* arena = tc_arena_create(64 << 10);
+  CHECK(arena != NULL);
+  const size_t sizes[] = { 0, 1, 8, 24, 100, 3000, 20000, 100000 };
+  vector<char*> objects;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 200; i++) {
+      const size_t size = sizes[i % (sizeof(sizes) / sizeof(*sizes))];
+      char* p = static_cast<char*>(tc_arena_alloc(arena, size));
+      CHECK(p != NULL);
+      CHECK_EQ(0, reinterpret_cast<uintptr_t>(p) %
+                  std::min<size_t>(tcmalloc::AlignmentForSize(size),
+                                   kPageSize));
+      CHECK(IsAllZero(p, size));
+      memset(p, 0xff, size);
+      objects.push_back(p);
+    }
+    // (the objects don't overlap)
+    for (size_t i = 0; i < objects.size(); i++) {
+      const size_t size = sizes[i % (sizeof(sizes) / sizeof(*sizes))];
+      if (size > 0) CHECK_EQ(static_cast<char>(0xff), objects[i][size - 1]);
+    }
+    objects.clear();
+    tc_arena_reset(arena);
+  }
+
+  {
+    std::vector<int, tc_arena_allocator<int> > v(
+        (tc_arena_allocator<int>(arena)));
+    for (int i = 0; i < 10000; i++) v.push_back(i);
+    for (int i = 0; i < 10000; i++) CHECK_EQ(i, v[i]);
+  }
+  tc_arena_destroy(arena);
+  tc_arena_destroy(NULL);
+}
+
+// Spans which empty are kept by their central list for reuse, and must
+// come back zeroed.
+static void TestEmptySpanReuse() {
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+  static const int kNumObjects = 64;
+  static const size_t kSize = 20000;
+  void* objects[kNumObjects];
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < kNumObjects; ++i) {
+      objects[i] = malloc(kSize);
+      CHECK(objects[i]);
+      CHECK(IsAllZero(objects[i], kSize));
+      memset(objects[i], 0xff, kSize);
+    }
+    for (int i = 0; i < kNumObjects; ++i) free(objects[i]);
+    // (so that the objects go back to their spans)
+    MallocExtension::instance()->MarkThreadIdle();
+    if (round == 2) MallocExtension::instance()->ReleaseFreeMemory();
+  }
+#endif
+}
+
+#ifndef DEBUGALLOCATION
+static size_t HeapSize() {
+  size_t value;
+  CHECK(MallocExtension::instance()->GetNumericProperty("generic.heap_size",
+                                                        &value));
+  return value;
+}
+#endif
+
+// Allocations over the direct mmap threshold are mapped for themselves,
+// come back zero, and are unmapped again when they are freed.
+static void TestDirectMmap() {
+#ifndef DEBUGALLOCATION  // debug alloc adds its own header and trailer
+  fprintf(LOGSTREAM, "Testing direct mmap allocations\n");
+  size_t old_threshold;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.direct_mmap_threshold", &old_threshold));
+  // (sampled allocations come from the page heap, as do those that would
+  // take the heap over its limit, so that it can release memory first)
+  const int64 old_sample_parameter = FLAGS_tcmalloc_sample_parameter;
+  FLAGS_tcmalloc_sample_parameter = 0;
+  const int64 old_heap_limit_mb = FLAGS_tcmalloc_heap_limit_mb;
+  FLAGS_tcmalloc_heap_limit_mb = 0;
+  static const size_t kSize = 4 << 20;
+  CHECK(MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.direct_mmap_threshold", kSize));
+
+  for (int i = 0; i < 4; i++) {
+    const size_t before = HeapSize();
+    char* p = static_cast<char*>((i % 2) ? calloc(1, kSize) : malloc(kSize));
+    CHECK(p != NULL);
+    CHECK_EQ(HeapSize(), before + kSize);
+    CHECK(IsAllZero(p, kSize));
+    CHECK_EQ(MallocExtension::instance()->GetAllocatedSize(p), kSize);
+    memset(p, 0xab, kSize);
+
+    // Growing it can't take over the pages after it: it moves, keeping
+    // its contents, and the new pages are zero.
+    char* q = static_cast<char*>(realloc(p, 2 * kSize));
+    CHECK(q != NULL);
+    CHECK_EQ(HeapSize(), before + 2 * kSize);
+    for (size_t j = 0; j < kSize; j += 4096) CHECK_EQ(q[j], '\xab');
+    CHECK(IsAllZero(q + kSize, kSize));
+    free(q);
+    CHECK_EQ(HeapSize(), before);
+  }
+
+  // Below the threshold, allocations come from the page heap as usual.
+  void* p = malloc(kSize - kPageSize);
+  CHECK(p != NULL);
+  const size_t before = HeapSize();
+  free(p);
+  CHECK_EQ(HeapSize(), before);
+
+  CHECK(MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.direct_mmap_threshold", old_threshold));
+  FLAGS_tcmalloc_sample_parameter = old_sample_parameter;
+  FLAGS_tcmalloc_heap_limit_mb = old_heap_limit_mb;
+#endif
+}
+
+// Objects over the maximum cached size go straight back to the central
+// cache, and still come back zero.
+static void TestUncachedClasses() {
+#ifndef DEBUGALLOCATION  // debug alloc adds its own header and trailer
+  fprintf(LOGSTREAM, "Testing uncached size classes\n");
+  const size_t old_max = GetZeroCounter("tcmalloc.max_cached_object_size");
+  CHECK(MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.max_cached_object_size", 64 << 10));
+  CHECK_EQ(GetZeroCounter("tcmalloc.max_cached_object_size"), 64 << 10);
+
+  static const int kObjects = 8;
+  static const size_t kSize = 100 << 10;
+  for (int round = 0; round < 2; round++) {
+    void* ptrs[kObjects];
+    for (int i = 0; i < kObjects; i++) {
+      ptrs[i] = malloc(kSize);
+      CHECK(ptrs[i] != NULL);
+      CHECK(IsAllZero(ptrs[i], kSize));
+      memset(ptrs[i], 0x5a, kSize);
+    }
+    const size_t cached =
+        GetZeroCounter("tcmalloc.current_total_thread_cache_bytes");
+    for (int i = 0; i < kObjects; i++) free(ptrs[i]);
+    CHECK_LT(GetZeroCounter("tcmalloc.current_total_thread_cache_bytes"),
+             cached + kSize);
+  }
+
+  CHECK(MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.max_cached_object_size", old_max));
+#endif
+}
+
+// Big callocs and reallocs of memory that isn't zero already come back
+// zeroed when helper threads zero them too.
+static void TestParallelZero() {
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+  fprintf(LOGSTREAM, "Testing parallel zeroing\n");
+  const size_t old_threshold =
+      GetZeroCounter("tcmalloc.parallel_zero_threshold");
+  if (!MallocExtension::instance()->SetNumericProperty(
+          "tcmalloc.parallel_zero_threshold", 1 << 20)) {
+    return;  // no threads to zero with
+  }
+  CHECK_EQ(GetZeroCounter("tcmalloc.parallel_zero_threshold"), 1 << 20);
+
+  static const size_t kSize = 40 << 20;  // 5 chunks
+  for (int round = 0; round < 3; round++) {
+    void* p = malloc(kSize);
+    CHECK(p != NULL);
+    memset(p, 0x5a, kSize);
+    free(p);
+    p = calloc(1, kSize);
+    CHECK(p != NULL);
+    CHECK(IsAllZero(p, kSize));
+    memset(p, 0x5a, kSize);
+    void* q = realloc(p, kSize + (3 << 20));
+    CHECK(q != NULL);
+    CHECK(IsAllZero(static_cast<char*>(q) + kSize, 3 << 20));
+    free(q);
+  }
+
+  CHECK(MallocExtension::instance()->SetNumericProperty(
+      "tcmalloc.parallel_zero_threshold", old_threshold));
+#endif
+}
+
+static void CheckOwnThreadCacheTrips() {
+  // Whatever thread had the cache before, the counts start over
+  CHECK_LT(GetZeroCounter("tcmalloc.this_thread_cache_fetches"), 100);
+  vector<void*> ptrs(10000);
+  for (int i = 0; i < ptrs.size(); i++) ptrs[i] = malloc(96);
+  for (int i = 0; i < ptrs.size(); i++) free(ptrs[i]);
+  // (with per-CPU caches, the thread's own cache holds nothing)
+  if (!GetZeroCounter("tcmalloc.per_cpu_caches")) {
+    CHECK_GT(GetZeroCounter("tcmalloc.this_thread_cache_fetches"), 100);
+  }
+}
+
+// The caches of threads that exit are reused by the threads that start
+// after them.
+static void TestThreadCacheReuse() {
+  fprintf(LOGSTREAM, "Testing thread cache reuse\n");
+  for (int i = 0; i < 20; i++) RunManyThreads(&CheckOwnThreadCacheTrips, 1);
+  // (with their central cache trips still counted)
+  const size_t fetches = GetZeroCounter("tcmalloc.thread_cache_fetches");
+  RunManyThreads(&CheckOwnThreadCacheTrips, 1);
+  if (!GetZeroCounter("tcmalloc.per_cpu_caches")) {
+    CHECK_GT(GetZeroCounter("tcmalloc.thread_cache_fetches"), fetches + 100);
+  }
+}
+
+// Objects allocated by this thread and freed by another one.
+static vector<void*> remote_frees;
+
+static void FreeRemoteObjects() {
+  for (int i = 0; i < remote_frees.size(); i++) free(remote_frees[i]);
+}
+
+// In remote-free mode, objects a thread allocated and another thread
+// freed come back to the first one.
+static void TestRemoteFree() {
+  size_t value;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.remote_free", &value));
+  if (!value) return;
+
+  static const int kObjects = 1000;
+  static const size_t kSize = 1000;
+  remote_frees.resize(kObjects);
+  for (int i = 0; i < kObjects; i++) {
+    remote_frees[i] = malloc(kSize);
+    memset(remote_frees[i], 0x5a, kSize);
+  }
+  RunManyThreads(&FreeRemoteObjects, 1);
+  std::sort(remote_frees.begin(), remote_frees.end());
+
+  // Once whatever else is in our cache is used up, we get them back (but
+  // for any which came from spans other threads carved up)
+  vector<void*> ptrs;
+  int found = 0;
+  while (found < kObjects && ptrs.size() < 10 * kObjects) {
+    void* p = malloc(kSize);
+    ptrs.push_back(p);
+    if (std::binary_search(remote_frees.begin(), remote_frees.end(), p)) {
+      found++;
+    }
+  }
+  CHECK_GT(found, kObjects / 2);
+  for (int i = 0; i < ptrs.size(); i++) free(ptrs[i]);
+  remote_frees.clear();
+}
+
+// Threads on CPUs of different transfer cache shards each allocate and
+// free more objects of one class than the shards can hold, so that whole
+// batches go through full and empty shards (and on to the transfer cache
+// proper) concurrently.
+static const int kShardThreads = 8;
+static const int kShardObjects = 20000;
+static const size_t kShardSize = 64;
+
+static void ChurnTransferShards(int id) {
+#ifdef __linux__
+  // (best effort: with fewer CPUs, threads share shards)
+  const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus > 0) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((id * 8) % cpus, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+  }
+#endif
+  vector<void*> ptrs(kShardObjects);
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < kShardObjects; i++) {
+      ptrs[i] = malloc(kShardSize);
+      CHECK(ptrs[i] != NULL);
+      memset(ptrs[i], id, kShardSize);
+    }
+    for (int i = 0; i < kShardObjects; i++) {
+      CHECK_EQ(static_cast<char>(id), static_cast<char*>(ptrs[i])[0]);
+      free(ptrs[i]);
+    }
+    // (hands the thread cache's batches back to the central cache)
+    MallocExtension::instance()->MarkThreadIdle();
+  }
+}
+
+static void TestTransferShards() {
+  fprintf(LOGSTREAM, "Testing transfer cache shards\n");
+#ifndef DEBUGALLOCATION  // debug alloc holds on to freed blocks for a while
+  const size_t before = GetAllocatedBytes();
+#endif
+  RunManyThreadsWithId(&ChurnTransferShards, kShardThreads, 1 << 20);
+#ifndef DEBUGALLOCATION
+  // The allocated bytes are what the heap holds less the free objects, so
+  // a batch tc_length() missed (or counted twice) would show up here.
+  EXPECT_EQ(before, GetAllocatedBytes());
+#endif
+
+  // The transfer cache holds whole objects, and tc_length() agrees with
+  // the total.
+  // (the second call reuses the vector, so that growing it doesn't move
+  // objects into the transfer cache while it's being read)
+  vector<MallocExtension::FreeListInfo> info;
+  MallocExtension::instance()->GetFreeListSizes(&info);
+  MallocExtension::instance()->GetFreeListSizes(&info);
+  size_t transfer_bytes = 0;
+  for (int i = 0; i < info.size(); i++) {
+    if (strcmp(info[i].type, "tcmalloc.transfer") != 0) continue;
+    CHECK_EQ(0, info[i].total_bytes_free % info[i].max_object_size);
+    transfer_bytes += info[i].total_bytes_free;
+  }
+  size_t value;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.transfer_cache_free_bytes", &value));
+  CHECK_EQ(transfer_bytes, value);
+
+  // No batch was handed to two threads: what they freed comes back as
+  // distinct objects.
+  vector<void*> ptrs(kShardThreads * kShardObjects);
+  for (int i = 0; i < ptrs.size(); i++) ptrs[i] = malloc(kShardSize);
+  vector<void*> sorted(ptrs);
+  std::sort(sorted.begin(), sorted.end());
+  CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+  for (int i = 0; i < ptrs.size(); i++) free(ptrs[i]);
+}
+
+static void TestThreadCacheTrips() {
+  fprintf(LOGSTREAM, "Testing thread cache fetch and release counts\n");
+  const size_t fetches = GetZeroCounter("tcmalloc.thread_cache_fetches");
+  const size_t releases = GetZeroCounter("tcmalloc.thread_cache_releases");
+  const size_t own_fetches =
+      GetZeroCounter("tcmalloc.this_thread_cache_fetches");
+
+  // Far more than fits into a thread cache, so they have to go back
+  static const int kObjects = 100000;
+  vector<void*> ptrs(kObjects);
+  for (int i = 0; i < kObjects; i++) ptrs[i] = malloc(96);
+  for (int i = 0; i < kObjects; i++) free(ptrs[i]);
+
+  CHECK_GT(GetZeroCounter("tcmalloc.thread_cache_fetches"), fetches);
+  CHECK_GT(GetZeroCounter("tcmalloc.thread_cache_releases"), releases);
+  size_t value;
+  CHECK(MallocExtension::instance()->GetNumericProperty(
+      "tcmalloc.per_cpu_caches", &value));
+  if (!value) {
+    CHECK_GT(GetZeroCounter("tcmalloc.this_thread_cache_fetches"),
+             own_fetches);
+    CHECK_GT(GetZeroCounter("tcmalloc.this_thread_cache_max_bytes"), 0);
+  }
+  CHECK_LE(GetZeroCounter("tcmalloc.this_thread_cache_releases"),
+           GetZeroCounter("tcmalloc.thread_cache_releases"));
+}
+
 static void TestErrno(void) {
   void* ret;
   if (kOSSupportsMemalign) {
@@ -1355,6 +2191,86 @@ static int RunAllTests(int argc, char** argv) {
   fprintf(LOGSTREAM, "Testing realloc\n");
   TestRealloc();
 
+  fprintf(LOGSTREAM, "Testing zeroing\n");
+  TestZeroing(false, 0);
+  TestZeroing(true, 0);
+  TestZeroing(false, 1000);
+  {
+    size_t old_decommit = 0;
+    MallocExtension::instance()->GetNumericProperty(
+        "tcmalloc.aggressive_memory_decommit", &old_decommit);
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.aggressive_memory_decommit", 0);
+    TestZeroing(false, 0);
+    TestZeroing(false, 1000);
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.aggressive_memory_decommit", old_decommit);
+  }
+  {
+    size_t old_prezero = 0;
+    MallocExtension::instance()->GetNumericProperty(
+        "tcmalloc.prezero_spans", &old_prezero);
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.prezero_spans", 1);
+    TestZeroing(false, 0);
+    TestZeroing(true, 0);
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.prezero_spans", old_prezero);
+  }
+  {
+    // every zeroing kernel this CPU can run
+    size_t old_kernel = 0;
+    MallocExtension::instance()->GetNumericProperty("tcmalloc.zero_kernel",
+                                                    &old_kernel);
+    CHECK(!MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.zero_kernel", 1000));
+    for (size_t kernel = 0; kernel < 6; ++kernel) {
+      if (!MallocExtension::instance()->SetNumericProperty(
+              "tcmalloc.zero_kernel", kernel)) {
+        continue;
+      }
+      size_t value = 0;
+      CHECK(MallocExtension::instance()->GetNumericProperty(
+          "tcmalloc.zero_kernel", &value));
+      CHECK_EQ(value, kernel);
+      TestZeroing(false, 0);
+    }
+    MallocExtension::instance()->SetNumericProperty("tcmalloc.zero_kernel",
+                                                    old_kernel);
+  }
+  {
+    // only the non-zero lines get written, including ones at the edges
+    size_t old_check = 0;
+    MallocExtension::instance()->GetNumericProperty(
+        "tcmalloc.check_zero_threshold", &old_check);
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.check_zero_threshold", 1000);
+    TestZeroing(false, 0);
+    TestZeroing(true, 0);
+    TestZeroing(false, 1000);
+#ifndef DEBUGALLOCATION  // debug alloc fills memory with its own patterns
+    static const size_t kSize = (1 << 20) + 100;
+    for (int round = 0; round < 3; ++round) {
+      char* p = static_cast<char*>(malloc(kSize));
+      CHECK(p);
+      CHECK(IsAllZero(p, kSize));
+      for (size_t i = round; i < kSize; i += 4096 + 63 * round) p[i] = 1;
+      p[kSize - 1] = 1;
+      free(p);
+      p = static_cast<char*>(calloc(1, kSize));
+      CHECK(p);
+      CHECK(IsAllZero(p, kSize));
+      memset(p + 1000, 0xff, 100000);
+      free(p);
+    }
+#endif
+    MallocExtension::instance()->SetNumericProperty(
+        "tcmalloc.check_zero_threshold", old_check);
+  }
+  TestZeroStats();
+  TestStatsPage();
+  TestMallocFillByte();
+
   fprintf(LOGSTREAM, "Testing operator new(nothrow).\n");
   TestNothrowNew(&::operator new);
   fprintf(LOGSTREAM, "Testing operator new[](nothrow).\n");
@@ -1377,6 +2293,13 @@ static int RunAllTests(int argc, char** argv) {
 
   for (int i = 0; i < FLAGS_numthreads; ++i) delete threads[i];    // Cleanup
 
+  // These start threads of their own too, or need address space.
+  TestRemoteFree();
+  TestDirectMmap();
+  TestThreadCacheReuse();
+  TestParallelZero();
+  TestTransferShards();
+
   // Do the memory intensive tests after threads are done, since exhausting
   // the available address space can make pthread_create to fail.
 
@@ -1398,7 +2321,15 @@ static int RunAllTests(int argc, char** argv) {
   TestRanges();
   TestReleaseToSystem();
   TestAggressiveDecommit();
+  TestBackgroundRelease();
   TestSetNewMode();
+  TestSizedDelete();
+  TestBatch();
+  TestSizedAllocation();
+  TestArena();
+  TestEmptySpanReuse();
+  TestUncachedClasses();
+  TestThreadCacheTrips();
   TestErrno();
 
   return 0;
@@ -73,8 +73,79 @@ echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_AGGRESSIVE_DECOMMIT=f ... "
 
 TCMALLOC_AGGRESSIVE_DECOMMIT=f run_unittest
 
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_HUGEPAGES=t ... "
+
+TCMALLOC_HUGEPAGES=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_LAZY_FREE=t ... "
+
+TCMALLOC_LAZY_FREE=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_NUMA=t ... "
+
+TCMALLOC_NUMA=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_PER_CPU_CACHES=t ... "
+
+TCMALLOC_PER_CPU_CACHES=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_REMOTE_FREE=t ... "
+
+TCMALLOC_REMOTE_FREE=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_ZERO_KERNEL=0 ... "
+
+TCMALLOC_ZERO_KERNEL=0 run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_CHECK_ZERO_THRESHOLD=4096 ... "
+
+TCMALLOC_CHECK_ZERO_THRESHOLD=4096 run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_SIZE_CLASS_PROFILE ... "
+
+cat > $TMPDIR/size_classes <<EOF
+# size  count
+3500    100000
+7000    50000
+14000   4000    # a comment
+EOF
+TCMALLOC_SIZE_CLASS_PROFILE=$TMPDIR/size_classes run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_PAGEMAP_CACHE_BITS=20 ... "
+
+TCMALLOC_PAGEMAP_CACHE_BITS=20 run_unittest
+
 echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_HEAP_LIMIT_MB=512 ... "
 
 TCMALLOC_HEAP_LIMIT_MB=512 run_unittest
 
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_SAMPLE_PARAMETER=524288 ... "
+
+TCMALLOC_SAMPLE_PARAMETER=524288 run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_BACKGROUND_RELEASE=t ... "
+
+TCMALLOC_BACKGROUND_RELEASE=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_BACKGROUND_RELEASE=t and TCMALLOC_HUGEPAGES=t ... "
+
+TCMALLOC_BACKGROUND_RELEASE=t TCMALLOC_HUGEPAGES=t run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_PREFAULT_BYTES=67108864 ... "
+
+TCMALLOC_PREFAULT_BYTES=67108864 run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_DIRECT_MMAP_THRESHOLD=2097152 ... "
+
+TCMALLOC_DIRECT_MMAP_THRESHOLD=2097152 run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_PARALLEL_ZERO_THRESHOLD=1048576 ... "
+
+TCMALLOC_PARALLEL_ZERO_THRESHOLD=1048576 run_unittest
+
+echo -n "Testing $TCMALLOC_UNITTEST with TCMALLOC_STATS_PAGE ... "
+
+TCMALLOC_STATS_PAGE=$TMPDIR/stats_page TCMALLOC_STATS_PAGE_INTERVAL_MS=10 \
+    run_unittest
+
 echo "PASS"
@@ -45,6 +45,8 @@
 using std::min;
 using std::max;
 
+DECLARE_int64(tcmalloc_sample_parameter);
+
 // Note: this is initialized manually in InitModule to ensure that
 // it's configured at right time
 //
@@ -64,9 +66,21 @@ static bool phinited = false;
 volatile size_t ThreadCache::per_thread_cache_size_ = kMaxThreadCacheSize;
 size_t ThreadCache::overall_thread_cache_size_ = kDefaultOverallThreadCacheSize;
 ssize_t ThreadCache::unclaimed_cache_space_ = kDefaultOverallThreadCacheSize;
+bool ThreadCache::zero_on_free_ = false;
+bool ThreadCache::prezero_spans_ = false;
+int ThreadCache::malloc_fill_byte_ = 0;
+size_t ThreadCache::max_cached_size_ = kMaxSize;
+size_t ThreadCache::uncached_class_ = kNumClasses;
+bool ThreadCache::per_cpu_ = false;
+bool ThreadCache::sample_allocations_ = false;
+ThreadCache::CpuCache ThreadCache::cpu_caches_[kMaxCpus];
+int ThreadCache::cpu_cache_count_ = 0;
+bool ThreadCache::remote_free_ = false;
+ThreadCache::RemoteQueue ThreadCache::remote_queues_[kMaxHomes];
 PageHeapAllocator<ThreadCache> threadcache_allocator;
 ThreadCache* ThreadCache::thread_heaps_ = NULL;
 int ThreadCache::thread_heap_count_ = 0;
+Atomic32 ThreadCache::free_heap_count_ = 0;
 ThreadCache* ThreadCache::next_memory_steal_ = NULL;
 #ifdef HAVE_TLS
 __thread ThreadCache::ThreadLocalData ThreadCache::threadlocal_data_
@@ -76,25 +90,38 @@ __thread ThreadCache::ThreadLocalData ThreadCache::threadlocal_data_
 bool ThreadCache::tsd_inited_ = false;
 pthread_key_t ThreadCache::heap_key_;
 
-void ThreadCache::Init(pthread_t tid) {
+void ThreadCache::Init(pthread_t tid, int cpu) {
   size_ = 0;
 
   max_size_ = 0;
-  IncreaseCacheLimitLocked();
-  if (max_size_ == 0) {
-    // There isn't enough memory to go around.  Just give the minimum to
-    // this thread.
-    max_size_ = kMinThreadCacheSize;
-
-    // Take unclaimed_cache_space_ negative.
-    unclaimed_cache_space_ -= kMinThreadCacheSize;
-    ASSERT(unclaimed_cache_space_ < 0);
-  }
-
+  fetches_ = 0;
+  releases_ = 0;
+  fetches_at_grow_ = 0;
+  fetches_at_visit_ = 0;
+  fetches_at_claim_ = 0;
+  releases_at_claim_ = 0;
   next_ = NULL;
-  prev_ = NULL;
   tid_  = tid;
+  cpu_ = cpu;
+  home_ = 0;
+  free_ = 0;
+  // In per-CPU mode, only the CPU caches hold objects, so only they get a
+  // share of the overall cache size.
+  if (!per_cpu_ || cpu_ >= 0) {
+    IncreaseCacheLimitLocked();
+    if (max_size_ == 0) {
+      // There isn't enough memory to go around.  Just give the minimum to
+      // this thread.
+      max_size_ = kMinThreadCacheSize;
+
+      // Take unclaimed_cache_space_ negative.
+      unclaimed_cache_space_ -= kMinThreadCacheSize;
+      ASSERT(unclaimed_cache_space_ < 0);
+    }
+  }
+
   in_setspecific_ = false;
+  zero_stats_.Clear();
   for (size_t cl = 0; cl < kNumClasses; ++cl) {
     list_[cl].Init();
   }
@@ -102,6 +129,7 @@ void ThreadCache::Init(pthread_t tid) {
   uint32_t sampler_seed;
   memcpy(&sampler_seed, &tid, sizeof(sampler_seed));
   sampler_.Init(sampler_seed);
+  spare_stack_ = NULL;
 }
 
 void ThreadCache::Cleanup() {
@@ -115,21 +143,52 @@ void ThreadCache::Cleanup() {
 
 // Remove some objects of class "cl" from central cache and add to thread heap.
 // On success, return the first object for immediate use; otherwise return NULL.
-void* ThreadCache::FetchFromCentralCache(size_t cl, size_t byte_size) {
+void* ThreadCache::FetchFromCentralCache(size_t cl, size_t byte_size,
+                                         bool* zeroed) {
   FreeList* list = &list_[cl];
+  if (UNLIKELY(home_ != 0)) {
+    // The objects other threads freed for us may do, without a trip to
+    // the central cache
+    DrainRemoteFrees();
+    if (!list->empty()) {
+      size_ -= byte_size;
+      if (zeroed) *zeroed = list->head_is_zero();
+      return list->Pop(byte_size);
+    }
+  }
   ASSERT(list->empty());
+  fetches_++;
   const int batch_size = Static::sizemap()->num_objects_to_move(cl);
 
   const int num_to_move = min<int>(list->max_length(), batch_size);
   void *start, *end;
+  int zero;
+  FreshRange fresh;
   int fetch_count = Static::central_cache()[cl].RemoveRange(
-      &start, &end, num_to_move);
-
-  ASSERT((start == NULL) == (fetch_count == 0));
-  if (--fetch_count >= 0) {
-    size_ += byte_size * fetch_count;
-    list->PushRange(fetch_count, SLL_Next(start), end);
+      &start, &end, num_to_move, &zero, &fresh);
+
+  ASSERT(fresh.count <= fetch_count);
+  const int linked = fetch_count - fresh.count;
+  ASSERT((start == NULL) == (linked == 0));
+  ASSERT(zero <= linked);
+  void* result = NULL;
+  if (zeroed) *zeroed = false;
+  if (fetch_count > 0) size_ += byte_size * (fetch_count - 1);
+  if (linked > 0) {
+    // The zero objects are at the end, so the first is only zero if all are.
+    if (zeroed) *zeroed = (zero == linked);
+    result = start;
+    if (linked > 1) {
+      list->PushRange(linked - 1, SLL_Next(start), end,
+                      min<int>(zero, linked - 1));
+    }
+  } else if (fresh.count > 0) {
+    if (zeroed) *zeroed = true;
+    result = fresh.start;
+    fresh.start += byte_size;
+    fresh.count--;
   }
+  if (fresh.count > 0) list->SetFresh(fresh.count, fresh.start);
 
   // Increase max length slowly up to batch_size.  After that,
   // increase by batch_size in one shot so that the length is a
@@ -149,11 +208,114 @@ void* ThreadCache::FetchFromCentralCache(size_t cl, size_t byte_size) {
     ASSERT(new_length % batch_size == 0);
     list->set_max_length(new_length);
   }
-  return start;
+  return result;
+}
+
+void* ThreadCache::AllocateUncached(size_t cl, bool* zeroed) {
+  void *start, *end;
+  int zero;
+  FreshRange fresh;
+  const int fetch_count = Static::central_cache()[cl].RemoveRange(
+      &start, &end, 1, &zero, &fresh);
+  if (zeroed) *zeroed = (fresh.count > 0 || zero > 0);
+  if (fetch_count == 0) return NULL;
+  return (fresh.count > 0) ? fresh.start : start;
+}
+
+void ThreadCache::DeallocateUncached(void* ptr, size_t cl) {
+  int zero = 0;
+  if (UNLIKELY(zero_on_free_)) {
+    const size_t size = Static::sizemap()->ByteSizeForClass(cl);
+    tcmalloc_zero_object(reinterpret_cast<char*>(ptr) + sizeof(void*),
+                         size - sizeof(void*));
+    RecordZeroed(ZeroStats::kFree, cl, size);
+    zero = 1;
+  }
+  SLL_SetNext(ptr, NULL);
+  Static::central_cache()[cl].InsertRange(ptr, ptr, 1, zero);
+}
+
+void ThreadCache::set_max_cached_size(size_t bytes) {
+  // (any classes past the last one in use have size 0, and so are never
+  // the first uncached one)
+  size_t cl = 1;
+  while (cl < kNumClasses &&
+         Static::sizemap()->class_to_size(cl) <= bytes) {
+    cl++;
+  }
+  max_cached_size_ = bytes;
+  uncached_class_ = cl;
+}
+
+// The objects that are not known to be zero are put at the front of ptrs,
+// the others at the back; they're brought together at the end if we ran
+// out of memory in between.
+int ThreadCache::AllocateBatchLocal(size_t size, size_t cl, void** ptrs,
+                                    int n, int* zero) {
+  FreeList* list = &list_[cl];
+  int dirty = 0;      // ptrs[0, dirty)
+  int clean = 0;      // ptrs[n - clean, n)
+  while (dirty + clean < n) {
+    if (list->empty()) {
+      bool zeroed;
+      void* ptr = FetchFromCentralCache(cl, size, &zeroed);
+      if (ptr == NULL) break;
+      if (zeroed) {
+        ptrs[n - ++clean] = ptr;
+      } else {
+        ptrs[dirty++] = ptr;
+      }
+      continue;
+    }
+    const int count = min<int>(n - dirty - clean, list->length());
+    const int count_zero = list->zero_in_front(count);
+    void *start, *end;
+    list->PopRange(count, &start, &end, size);
+    size_ -= count * size;
+    for (int i = 0; i < count - count_zero; i++) {
+      ptrs[dirty++] = start;
+      start = SLL_Next(start);
+    }
+    for (int i = 0; i < count_zero; i++) {
+      ptrs[n - ++clean] = start;
+      start = SLL_Next(start);
+    }
+  }
+  if (dirty + clean < n) {
+    memmove(ptrs + dirty, ptrs + n - clean, clean * sizeof(*ptrs));
+  }
+  *zero = clean;
+  return dirty + clean;
+}
+
+void ThreadCache::DeallocateBatchLocal(void** ptrs, int n, size_t cl) {
+  FreeList* list = &list_[cl];
+  for (int i = 0; i < n - 1; i++) {
+    SLL_SetNext(ptrs[i], ptrs[i + 1]);
+  }
+  list->PushRange(n, ptrs[0], ptrs[n - 1], 0);
+  size_ += n * Static::sizemap()->ByteSizeForClass(cl);
+
+  // Unlike with one object at a time, the list may now be over its
+  // limit by more than what ListTooLong() gives back.
+  if (list->length() > list->max_length()) {
+    ListTooLong(list, cl);
+    if (list->length() > list->max_length()) {
+      ReleaseToCentralCache(list, cl, list->length() - list->max_length());
+    }
+  }
+  if (size_ >= max_size_) Scavenge();
 }
 
 void ThreadCache::ListTooLong(FreeList* list, size_t cl) {
   const int batch_size = Static::sizemap()->num_objects_to_move(cl);
+  // (zeroing before the release means the batch we hand to the central
+  //  cache is zero too, for whichever thread picks it up)
+  if (zero_on_free_) {
+    const size_t size = Static::sizemap()->ByteSizeForClass(cl);
+    const size_t n = list->ZeroDirty(size);
+    RecordZeroed(ZeroStats::kFree, cl, n * size, n);
+  }
   ReleaseToCentralCache(list, cl, batch_size);
 
   // If the list is too long, we need to transfer some number of
@@ -180,23 +342,91 @@ void ThreadCache::ListTooLong(FreeList* list, size_t cl) {
 void ThreadCache::ReleaseToCentralCache(FreeList* src, size_t cl, int N) {
   ASSERT(src == &list_[cl]);
   if (N > src->length()) N = src->length();
-  size_t delta_bytes = N * Static::sizemap()->ByteSizeForClass(cl);
+  const size_t size = Static::sizemap()->ByteSizeForClass(cl);
+  size_t delta_bytes = N * size;
+  releases_++;
 
   // We return prepackaged chains of the correct size to the central cache.
   // TODO: Use the same format internally in the thread caches?
   int batch_size = Static::sizemap()->num_objects_to_move(cl);
   while (N > batch_size) {
     void *tail, *head;
-    src->PopRange(batch_size, &head, &tail);
-    Static::central_cache()[cl].InsertRange(head, tail, batch_size);
+    int zero = src->zero_in_front(batch_size);
+    src->PopRange(batch_size, &head, &tail, size);
+    Static::central_cache()[cl].InsertRange(head, tail, batch_size, zero);
     N -= batch_size;
   }
   void *tail, *head;
-  src->PopRange(N, &head, &tail);
-  Static::central_cache()[cl].InsertRange(head, tail, N);
+  int zero = src->zero_in_front(N);
+  src->PopRange(N, &head, &tail, size);
+  Static::central_cache()[cl].InsertRange(head, tail, N, zero);
   size_ -= delta_bytes;
 }
 
+bool ThreadCache::PushRemoteFree(void* ptr) {
+  const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
+  const int home = Static::pageheap()->GetDescriptor(p)->home;
+  if (home == 0 || home == home_) return false;
+  RemoteQueue* queue = &remote_queues_[home];
+  if (base::subtle::NoBarrier_Load(&queue->owner) == 0) return false;
+
+  AtomicWord head;
+  do {
+    head = base::subtle::NoBarrier_Load(&queue->head);
+    SLL_SetNext(ptr, reinterpret_cast<void*>(head));
+  } while (base::subtle::Release_CompareAndSwap(
+               &queue->head, head, reinterpret_cast<AtomicWord>(ptr)) != head);
+
+  // If the owner went away meanwhile, it may have emptied its queue for
+  // the last time before we pushed; see DeleteCache().
+  base::subtle::MemoryBarrier();
+  if (base::subtle::NoBarrier_Load(&queue->owner) == 0) {
+    ReleaseRemoteFrees(queue);
+  }
+  return true;
+}
+
+void ThreadCache::DrainRemoteFrees() {
+  RemoteQueue* queue = &remote_queues_[home_];
+  if (base::subtle::NoBarrier_Load(&queue->head) == 0) return;
+  void* ptr = reinterpret_cast<void*>(
+      base::subtle::Acquire_AtomicExchange(&queue->head, 0));
+  while (ptr != NULL) {
+    void* next = SLL_Next(ptr);
+    const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
+    DeallocateLocal(ptr, Static::pageheap()->GetDescriptor(p)->sizeclass);
+    ptr = next;
+  }
+}
+
+void ThreadCache::ReleaseRemoteFrees(RemoteQueue* queue) {
+  void* ptr = reinterpret_cast<void*>(
+      base::subtle::Acquire_AtomicExchange(&queue->head, 0));
+  // (one at a time: this only happens as threads exit)
+  while (ptr != NULL) {
+    void* next = SLL_Next(ptr);
+    const PageID p = reinterpret_cast<uintptr_t>(ptr) >> kPageShift;
+    const size_t cl = Static::pageheap()->GetDescriptor(p)->sizeclass;
+    SLL_SetNext(ptr, NULL);
+    Static::central_cache()[cl].InsertRange(ptr, ptr, 1, 0);
+    ptr = next;
+  }
+}
+
+void ThreadCache::ZeroFreeLists() {
+  if (per_cpu_ && cpu_ < 0) {
+    CpuCache* cpu = &cpu_caches_[CurrentCpu()];
+    SpinLockHolder h(&cpu->lock);
+    CpuCacheLocked(cpu)->ZeroFreeLists();
+    return;
+  }
+  for (int cl = 0; cl < kNumClasses; cl++) {
+    const size_t size = Static::sizemap()->ByteSizeForClass(cl);
+    const size_t n = list_[cl].ZeroDirty(size);
+    RecordZeroed(ZeroStats::kFree, cl, n * size, n);
+  }
+}
+
 // Release idle memory to the central cache
 void ThreadCache::Scavenge() {
   // If the low-water mark for the free list is L, it means we would
@@ -237,32 +467,48 @@ void ThreadCache::IncreaseCacheLimit() {
 }
 
 void ThreadCache::IncreaseCacheLimitLocked() {
+  // A thread that keeps going to the central cache gets to grow faster.
+  const uint64_t fetches = fetches_ - fetches_at_grow_;
+  fetches_at_grow_ = fetches_;
+  const size_t want = min<size_t>(
+      max<size_t>(fetches / kFetchesPerSteal, 1) * kStealAmount,
+      kMaxStealAmount);
+
   if (unclaimed_cache_space_ > 0) {
     // Possibly make unclaimed_cache_space_ negative.
-    unclaimed_cache_space_ -= kStealAmount;
-    max_size_ += kStealAmount;
+    const size_t amount = max<size_t>(
+        min<size_t>(want, unclaimed_cache_space_), kStealAmount);
+    unclaimed_cache_space_ -= amount;
+    max_size_ += amount;
     return;
   }
   // Don't hold pageheap_lock too long.  Try to steal from 10 other
   // threads before giving up.  The i < 10 condition also prevents an
   // infinite loop in case none of the existing thread heaps are
   // suitable places to steal from.
-  for (int i = 0; i < 10;
+  size_t stolen = 0;
+  for (int i = 0; i < 10 && stolen < want;
        ++i, next_memory_steal_ = next_memory_steal_->next_) {
     // Reached the end of the linked list.  Start at the beginning.
     if (next_memory_steal_ == NULL) {
       ASSERT(thread_heaps_ != NULL);
       next_memory_steal_ = thread_heaps_;
     }
-    if (next_memory_steal_ == this ||
-        next_memory_steal_->max_size_ <= kMinThreadCacheSize) {
+    ThreadCache* victim = next_memory_steal_;
+    if (victim == this || victim->max_size_ <= kMinThreadCacheSize) {
       continue;
     }
-    next_memory_steal_->max_size_ -= kStealAmount;
-    max_size_ += kStealAmount;
-
-    next_memory_steal_ = next_memory_steal_->next_;
-    return;
+    // A thread which hasn't fetched anything since we last came by is
+    // idle, and gives up as much as we want, down to the minimum; the
+    // others give up kStealAmount, as they may need it back soon.
+    const bool idle = (victim->fetches_ == victim->fetches_at_visit_);
+    victim->fetches_at_visit_ = victim->fetches_;
+    const size_t amount = idle ?
+        min(want - stolen, victim->max_size_ - kMinThreadCacheSize) :
+        kStealAmount;
+    victim->max_size_ -= amount;
+    max_size_ += amount;
+    stolen += amount;
   }
 }
 
@@ -277,7 +523,31 @@ void ThreadCache::InitModule() {
     if (tcb) {
       set_overall_thread_cache_size(strtoll(tcb, NULL, 10));
     }
+    zero_on_free_ = tcmalloc::commandlineflags::StringToBool(
+        TCMallocGetenvSafe("TCMALLOC_ZERO_ON_FREE"), false);
+    prezero_spans_ = tcmalloc::commandlineflags::StringToBool(
+        TCMallocGetenvSafe("TCMALLOC_PREZERO_SPANS"), false);
+    const char *fill = TCMallocGetenvSafe("TCMALLOC_MALLOC_FILL_BYTE");
+    if (fill) {
+      set_malloc_fill_byte(strtol(fill, NULL, 0));  // (so 0xcc works too)
+    }
+    per_cpu_ = tcmalloc::commandlineflags::StringToBool(
+        TCMallocGetenvSafe("TCMALLOC_PER_CPU_CACHES"), false);
+    // (the CPU caches are shared already)
+    remote_free_ = !per_cpu_ && tcmalloc::commandlineflags::StringToBool(
+        TCMallocGetenvSafe("TCMALLOC_REMOTE_FREE"), false);
+#ifndef NO_TCMALLOC_SAMPLES
+    // (the flag isn't necessarily set up yet, so read the environment)
+    sample_allocations_ =
+        FLAGS_tcmalloc_sample_parameter > 0 ||
+        tcmalloc::commandlineflags::StringToLongLong(
+            TCMallocGetenvSafe("TCMALLOC_SAMPLE_PARAMETER"), 0) > 0;
+#endif
     Static::InitStaticVars();
+    // (once the size map is set up)
+    set_max_cached_size(tcmalloc::commandlineflags::StringToLongLong(
+        TCMallocGetenvSafe("TCMALLOC_MAX_CACHED_OBJECT_SIZE"),
+        kDefaultMaxCachedSize));
     threadcache_allocator.Init();
     phinited = 1;
   }
@@ -302,39 +572,43 @@ void ThreadCache::InitTSD() {
 }
 
 ThreadCache* ThreadCache::CreateCacheIfNecessary() {
-  // Initialize per-thread data if necessary
-  ThreadCache* heap = NULL;
-  {
-    SpinLockHolder h(Static::pageheap_lock());
-    // On some old glibc's, and on freebsd's libc (as of freebsd 8.1),
-    // calling pthread routines (even pthread_self) too early could
-    // cause a segfault.  Since we can call pthreads quite early, we
-    // have to protect against that in such situations by making a
-    // 'fake' pthread.  This is not ideal since it doesn't work well
-    // when linking tcmalloc statically with apps that create threads
-    // before main, so we only do it if we have to.
+  // On some old glibc's, and on freebsd's libc (as of freebsd 8.1),
+  // calling pthread routines (even pthread_self) too early could
+  // cause a segfault.  Since we can call pthreads quite early, we
+  // have to protect against that in such situations by making a
+  // 'fake' pthread.  This is not ideal since it doesn't work well
+  // when linking tcmalloc statically with apps that create threads
+  // before main, so we only do it if we have to.
 #ifdef PTHREADS_CRASHES_IF_RUN_TOO_EARLY
-    pthread_t me;
-    if (!tsd_inited_) {
-      memset(&me, 0, sizeof(me));
-    } else {
-      me = pthread_self();
-    }
+  pthread_t me;
+  if (!tsd_inited_) {
+    memset(&me, 0, sizeof(me));
+  } else {
+    me = pthread_self();
+  }
 #else
-    const pthread_t me = pthread_self();
+  const pthread_t me = pthread_self();
 #endif
 
-    // This may be a recursive malloc call from pthread_setspecific()
-    // In that case, the heap for this thread has already been created
-    // and added to the linked list.  So we search for that first.
-    for (ThreadCache* h = thread_heaps_; h != NULL; h = h->next_) {
-      if (h->tid_ == me) {
-        heap = h;
-        break;
-      }
+  // This may be a recursive malloc call from pthread_setspecific()
+  // In that case, the heap for this thread has already been created
+  // (or claimed) and is in the linked list.  So we search for that first.
+  // (No lock needed: heaps are never taken off the list.)
+  ThreadCache* heap = NULL;
+  for (ThreadCache* h = thread_heaps_; h != NULL; h = h->next_) {
+    if (h->cpu_ < 0 && !base::subtle::NoBarrier_Load(&h->free_) &&
+        h->tid_ == me) {
+      heap = h;
+      break;
     }
+  }
 
-    if (heap == NULL) heap = NewHeap(me);
+  // Otherwise a thread that exited may have left us its heap.  Only if
+  // there's none do we need the lock, to allocate one.
+  if (heap == NULL) heap = ClaimFreeHeap(me);
+  if (heap == NULL) {
+    SpinLockHolder h(Static::pageheap_lock());
+    heap = NewHeap(me);
   }
 
   // We call pthread_setspecific() outside the lock because it may
@@ -347,31 +621,95 @@ ThreadCache* ThreadCache::CreateCacheIfNecessary() {
 #ifdef HAVE_TLS
     // Also keep a copy in __thread for faster retrieval
     threadlocal_data_.heap = heap;
-    SetMinSizeForSlowPath(kMaxSize + 1);
+    SetMinSizeForSlowPath(sample_allocations_ ? 1 : kMaxSize + 1);
 #endif
     heap->in_setspecific_ = false;
   }
   return heap;
 }
 
-ThreadCache* ThreadCache::NewHeap(pthread_t tid) {
+ThreadCache* ThreadCache::NewHeap(pthread_t tid, int cpu) {
   // Create the heap and add it to the linked list
   ThreadCache *heap = threadcache_allocator.New();
-  heap->Init(tid);
+  heap->Init(tid, cpu);
   heap->next_ = thread_heaps_;
-  heap->prev_ = NULL;
-  if (thread_heaps_ != NULL) {
-    thread_heaps_->prev_ = heap;
-  } else {
+  if (thread_heaps_ == NULL) {
     // This is the only thread heap at the momment.
     ASSERT(next_memory_steal_ == NULL);
     next_memory_steal_ = heap;
   }
+  // (the heap has to be set up before the threads walking the list
+  // without the lock can see it)
+  base::subtle::MemoryBarrier();
   thread_heaps_ = heap;
   thread_heap_count_++;
+
+  if (remote_free_ && cpu < 0) heap->ClaimHome();
   return heap;
 }
 
+// (atomicops has no atomic add)
+static void AtomicAdd(Atomic32* count, Atomic32 delta) {
+  Atomic32 old;
+  do {
+    old = base::subtle::NoBarrier_Load(count);
+  } while (base::subtle::NoBarrier_CompareAndSwap(count, old, old + delta) !=
+           old);
+}
+
+ThreadCache* ThreadCache::ClaimFreeHeap(pthread_t tid) {
+  if (base::subtle::NoBarrier_Load(&free_heap_count_) <= 0) return NULL;
+  for (ThreadCache* h = thread_heaps_; h != NULL; h = h->next_) {
+    if (h->cpu_ < 0 && base::subtle::NoBarrier_Load(&h->free_) &&
+        base::subtle::Acquire_CompareAndSwap(&h->free_, 1, 0) == 1) {
+      AtomicAdd(&free_heap_count_, -1);
+      h->tid_ = tid;
+      h->in_setspecific_ = false;
+      h->fetches_at_claim_ = h->fetches_;
+      h->releases_at_claim_ = h->releases_;
+      for (size_t cl = 0; cl < kNumClasses; ++cl) {
+        h->list_[cl].Init();
+      }
+      uint32_t sampler_seed;
+      memcpy(&sampler_seed, &tid, sizeof(sampler_seed));
+      h->sampler_.Init(sampler_seed);
+      if (remote_free_) h->ClaimHome();
+      return h;
+    }
+  }
+  return NULL;
+}
+
+void ThreadCache::ClaimHome() {
+  for (int home = 1; home < kMaxHomes; ++home) {
+    if (base::subtle::NoBarrier_Load(&remote_queues_[home].owner) == 0 &&
+        base::subtle::Release_CompareAndSwap(
+            &remote_queues_[home].owner, 0,
+            reinterpret_cast<AtomicWord>(this)) == 0) {
+      home_ = home;
+      return;
+    }
+  }
+}
+
+void ThreadCache::NewCpuCache(CpuCache* cpu) {
+  SpinLockHolder h(Static::pageheap_lock());
+  cpu->cache = NewHeap(pthread_self(), cpu - cpu_caches_);
+  cpu_cache_count_++;
+}
+
+void ThreadCache::LockCpuCaches() {
+  for (int cpu = 0; cpu < kMaxCpus; ++cpu) {
+    cpu_caches_[cpu].lock.Lock();
+  }
+}
+
+void ThreadCache::UnlockCpuCaches() {
+  for (int cpu = 0; cpu < kMaxCpus; ++cpu) {
+    cpu_caches_[cpu].lock.Unlock();
+  }
+}
+
 void ThreadCache::BecomeIdle() {
   if (!tsd_inited_) return;              // No caches yet
   ThreadCache* heap = GetThreadHeap();
@@ -410,26 +748,32 @@ void ThreadCache::DestroyThreadCache(void* ptr) {
 }
 
 void ThreadCache::DeleteCache(ThreadCache* heap) {
-  // Remove all memory from heap
+  // Remove all memory from heap, and give up its home.  Whatever other
+  // threads push after we last drain it goes to the central cache, either
+  // here or (if they see the owner gone) by them.
+  if (heap->home_ != 0) {
+    heap->DrainRemoteFrees();
+  }
   heap->Cleanup();
+  if (heap->home_ != 0) {
+    RemoteQueue* queue = &remote_queues_[heap->home_];
+    base::subtle::NoBarrier_Store(&queue->owner, 0);
+    base::subtle::MemoryBarrier();
+    ReleaseRemoteFrees(queue);
+    heap->home_ = 0;
+  }
 
-  // Remove from linked list
-  SpinLockHolder h(Static::pageheap_lock());
-  if (heap->next_ != NULL) heap->next_->prev_ = heap->prev_;
-  if (heap->prev_ != NULL) heap->prev_->next_ = heap->next_;
-  if (thread_heaps_ == heap) thread_heaps_ = heap->next_;
-  thread_heap_count_--;
-
-  if (next_memory_steal_ == heap) next_memory_steal_ = heap->next_;
-  if (next_memory_steal_ == NULL) next_memory_steal_ = thread_heaps_;
-  unclaimed_cache_space_ += heap->max_size_;
-
-  threadcache_allocator.Delete(heap);
+  // Put it in the pool, with its cache limit (and spare stack trace) for
+  // the next thread to have it.
+  memset(&heap->tid_, 0, sizeof(heap->tid_));
+  base::subtle::Release_Store(&heap->free_, 1);
+  AtomicAdd(&free_heap_count_, 1);
 }
 
 void ThreadCache::RecomputePerThreadCacheSize() {
-  // Divide available space across threads
-  int n = thread_heap_count_ > 0 ? thread_heap_count_ : 1;
+  // Divide available space across threads (or CPUs)
+  const int count = per_cpu_ ? cpu_cache_count_ : thread_heap_count_;
+  int n = count > 0 ? count : 1;
   size_t space = overall_thread_cache_size_ / n;
 
   // Limit to allowed range
@@ -461,6 +805,43 @@ void ThreadCache::GetThreadStats(uint64_t* total_bytes, uint64_t* class_count) {
   }
 }
 
+void ThreadCache::GetZeroStats(ZeroStats* stats) {
+  stats->Clear();
+  for (ThreadCache* h = thread_heaps_; h != NULL; h = h->next_) {
+    stats->Add(h->zero_stats_);
+  }
+}
+
+void ThreadCache::GetCentralCacheTrips(uint64_t* fetches,
+                                       uint64_t* releases) {
+  *fetches = 0;
+  *releases = 0;
+  for (ThreadCache* h = thread_heaps_; h != NULL; h = h->next_) {
+    *fetches += h->fetches_;
+    *releases += h->releases_;
+  }
+}
+
+void ZeroStats::Add(const ZeroStats& other) {
+  for (int path = 0; path < kNumPaths; ++path) {
+    zeroed_bytes[path] += other.zeroed_bytes[path];
+    zeroed_objects[path] += other.zeroed_objects[path];
+    skipped_bytes[path] += other.skipped_bytes[path];
+    skipped_objects[path] += other.skipped_objects[path];
+  }
+  for (int cl = 0; cl < kNumClasses; ++cl) {
+    class_zeroed[cl] += other.class_zeroed[cl];
+    class_skipped[cl] += other.class_skipped[cl];
+  }
+}
+
+const char* ZeroStats::PathName(int path) {
+  static const char* const kNames[kNumPaths] = {
+    "small", "pages", "realloc", "memalign", "free", "refill", "arena"
+  };
+  return kNames[path];
+}
+
 void ThreadCache::set_overall_thread_cache_size(size_t new_size) {
   // Clip the value to a reasonable range
   if (new_size < kMinThreadCacheSize) new_size = kMinThreadCacheSize;
@@ -42,7 +42,16 @@
 #ifdef HAVE_STDINT_H
 #include <stdint.h>                     // for uint32_t, uint64_t
 #endif
+#include <string.h>                     // for memset
 #include <sys/types.h>                  // for ssize_t
+#ifdef HAVE_SCHED_H
+#include <sched.h>                      // for sched_getcpu
+#endif
+#ifdef HAVE_SYS_RSEQ_H
+#include <sys/rseq.h>                   // for __rseq_offset, struct rseq
+#endif
+#include "base/atomicops.h"
+#include "base/spinlock.h"
 #include "common.h"
 #include "linked_list.h"
 #include "maybe_threads.h"
@@ -57,8 +66,47 @@
 #include "sampler.h"           // for Sampler
 #include "static_vars.h"       // for Static
 
+// How many cache lines of the object at the head of a free list Pop()
+// prefetches for writing, once it has taken the one before it (see
+// FreeList::PrefetchHead).  0 turns the prefetching off.
+#ifndef TCMALLOC_FREELIST_PREFETCH_LINES
+# define TCMALLOC_FREELIST_PREFETCH_LINES 4
+#endif
+
 namespace tcmalloc {
 
+//-------------------------------------------------------------------
+// Counts of the zeroing done for allocations (and of the zeroing that
+// could be skipped, because the memory was known to be zero already)
+//-------------------------------------------------------------------
+
+struct ZeroStats {
+  enum Path {
+    kSmall,     // calloc and friends, for size-class objects
+    kPages,     // calloc and friends, for whole pages
+    kRealloc,   // the grown part of a realloc
+    kMemalign,  // the memalign family
+    kFree,      // zero-on-free mode
+    kRefill,    // prezero mode (whole spans, as they are cut up)
+    kArena,     // arena chunks, as they are taken and reset
+    kNumPaths
+  };
+
+  uint64_t zeroed_bytes[kNumPaths];
+  uint64_t zeroed_objects[kNumPaths];
+  uint64_t skipped_bytes[kNumPaths];
+  uint64_t skipped_objects[kNumPaths];
+
+  // Objects by size class, class 0 being whole-page allocations
+  uint64_t class_zeroed[kNumClasses];
+  uint64_t class_skipped[kNumClasses];
+
+  void Clear() { memset(this, 0, sizeof(*this)); }
+  void Add(const ZeroStats& other);
+
+  static const char* PathName(int path);
+};
+
 //-------------------------------------------------------------------
 // Data kept per thread
 //-------------------------------------------------------------------
@@ -71,11 +119,13 @@ class ThreadCache {
   enum { have_tls = false };
 #endif
 
-  // All ThreadCache objects are kept in a linked list (for stats collection)
+  // All ThreadCache objects are kept in a linked list (for stats collection).
+  // They are never deleted: the cache of a thread that exits is put back
+  // in a pool, for a new thread to claim without taking any lock.  So the
+  // list only grows, at its head, and can be walked without a lock.
   ThreadCache* next_;
-  ThreadCache* prev_;
 
-  void Init(pthread_t tid);
+  void Init(pthread_t tid, int cpu);
   void Cleanup();
 
   // Accessors (mostly just for printing stats)
@@ -86,9 +136,20 @@ class ThreadCache {
 
   // Allocate an object of the given size and class. The size given
   // must be the same as the size of the class in the size map.
-  void* Allocate(size_t size, size_t cl);
+  // If zeroed is non-NULL, *zeroed tells whether the object is known to be
+  // zero apart from its first word (the freelist link).
+  void* Allocate(size_t size, size_t cl, bool* zeroed = NULL);
   void Deallocate(void* ptr, size_t size_class);
 
+  // Allocate up to n objects of the given size and class into ptrs,
+  // taking them off the freelist a run at a time.  Returns the number
+  // allocated, which is less than n only if memory ran out.  The last
+  // *zero of them are known to be zero apart from their first word.
+  int AllocateBatch(size_t size, size_t cl, void** ptrs, int n, int* zero);
+  // Deallocate the n objects at ptrs, all of class cl, with one push
+  // onto the freelist.
+  void DeallocateBatch(void** ptrs, int n, size_t cl);
+
   void Scavenge();
 
   int GetSamplePeriod();
@@ -97,6 +158,26 @@ class ThreadCache {
   // should be sampled
   bool SampleAllocation(size_t k);
 
+  // The buffer for this thread's next sampled allocation's stack trace,
+  // set up ahead of time so that the trace is captured in place, without
+  // copying it under Static::pageheap_lock.  NULL if there is none yet.
+  StackTrace* TakeSpareStackTrace() {
+    StackTrace* t = spare_stack_;
+    spare_stack_ = NULL;
+    return t;
+  }
+  // Makes t (which may be NULL) the spare, unless a sampled allocation
+  // made while we were taking the trace (e.g. by the unwinder) already set
+  // one up.
+  // REQUIRES: Static::pageheap_lock is held.
+  void SetSpareStackTraceLocked(StackTrace* t) {
+    if (spare_stack_ == NULL) {
+      spare_stack_ = t;
+    } else if (t != NULL) {
+      Static::stacktrace_allocator()->Delete(t);
+    }
+  }
+
   static void         InitModule();
   static void         InitTSD();
   static ThreadCache* GetThreadHeap();
@@ -110,6 +191,12 @@ class ThreadCache {
 
   static bool IsFastPathAllowed() { return MinSizeForSlowPath() != 0; }
 
+  // Whether allocations may be sampled (for heap profiles), which is
+  // settled at startup.  The fast path of malloc() leaves sampling out:
+  // if this is set, threads get a MinSizeForSlowPath() of 1, so that
+  // their allocations (but for 0-byte ones) take the slow path.
+  static bool sample_allocations() { return sample_allocations_; }
+
   // Return the number of thread heaps in use.
   static inline int HeapsInUse();
 
@@ -128,35 +215,152 @@ class ThreadCache {
     return overall_thread_cache_size_;
   }
 
+  // In zero-on-free mode, freed objects are zeroed as they go back into the
+  // thread cache (or in batches, when a freelist is trimmed), so that
+  // allocating them later only has to clear their freelist link.
+  static bool zero_on_free() { return zero_on_free_; }
+  static void set_zero_on_free(bool zero) { zero_on_free_ = zero; }
+
+  // In prezero mode, a span that is cut up for a size class but may hold
+  // old data is zeroed as a whole, with one memset, rather than object by
+  // object as the objects get allocated.  Its objects then reach the
+  // thread caches as fresh (known zero, unlinked) runs.
+  static bool prezero_spans() { return prezero_spans_; }
+  static void set_prezero_spans(bool prezero) { prezero_spans_ = prezero; }
+
+  // The byte malloc and operator new fill their memory with: zero, unless
+  // the program was compiled to expect a pattern (SafeInit's pattern-init
+  // mode).  calloc and memalign zero regardless.
+  static int malloc_fill_byte() { return malloc_fill_byte_; }
+  static void set_malloc_fill_byte(int fill) { malloc_fill_byte_ = fill & 0xff; }
+
+  // Objects of more than max_cached_size() bytes aren't cached (per thread
+  // or per CPU): Allocate() and Deallocate() take them from and give them
+  // back to the central cache directly, so that a few of them don't use up
+  // a cache's whole budget, at the expense of the small ones.  By default,
+  // kDefaultMaxCachedSize (TCMALLOC_MAX_CACHED_OBJECT_SIZE).
+  // REQUIRES: the size map is initialized (for set_max_cached_size()).
+  static const size_t kDefaultMaxCachedSize = kMaxSize / 2;
+  static size_t max_cached_size() { return max_cached_size_; }
+  static void set_max_cached_size(size_t bytes);
+
+  // In per-CPU mode, which is chosen at startup, the objects are cached per
+  // CPU rather than per thread: Allocate() and Deallocate() use the cache
+  // of the CPU the calling thread runs on, under that cache's lock, and
+  // the caches of the threads themselves stay empty.  They still do the
+  // sampling and keep the zeroing stats, for their thread.  The overall
+  // cache size is then split among the CPUs instead of the threads.
+  static bool per_cpu() { return per_cpu_; }
+  static const int kMaxCpus = 256;
+
+  // Lock/Unlock all the per-CPU caches, around fork().
+  static void LockCpuCaches();
+  static void UnlockCpuCaches();
+
+  // The CPU the calling thread is running on, modulo kMaxCpus.  This may
+  // be stale by the time the caller uses it, so it may only decide which
+  // of some otherwise equivalent structures the caller uses.
+  static int CurrentCpu();
+
+  // In remote-free mode, which is chosen at startup (and not used with
+  // per-CPU caches), each thread has a home: a queue that other threads
+  // push the objects they free onto, if the objects come from a span this
+  // thread carved up.  The thread takes them back, all at once, the next
+  // time it has to fetch from the central cache, so that objects handed
+  // from a producer thread to a consumer thread go back to the producer
+  // without a trip through the central cache (and its locks).
+  static bool remote_free() { return remote_free_; }
+  static const int kMaxHomes = 1024;
+
+  // The calling thread's home, or 0 if it has none.
+  static int CurrentHome();
+
+  // Zero all the (not yet known to be zero) objects in this thread's cache
+  // (in per-CPU mode, the current CPU's), so that allocations from them
+  // don't have to. Meant to be called by threads which would otherwise be
+  // idle.
+  void ZeroFreeLists();
+
+  // Record that "objects" objects of class "cl", "bytes" bytes in all,
+  // had to be zeroed for "path" (RecordZeroed) or were known to be zero
+  // already (RecordKnownZero).
+  void RecordZeroed(ZeroStats::Path path, size_t cl, size_t bytes,
+                    size_t objects = 1) {
+    zero_stats_.zeroed_bytes[path] += bytes;
+    zero_stats_.zeroed_objects[path] += objects;
+    zero_stats_.class_zeroed[cl] += objects;
+  }
+  void RecordKnownZero(ZeroStats::Path path, size_t cl, size_t bytes,
+                       size_t objects = 1) {
+    zero_stats_.skipped_bytes[path] += bytes;
+    zero_stats_.skipped_objects[path] += objects;
+    zero_stats_.class_skipped[cl] += objects;
+  }
+
+  // Sets *stats to the zeroing done by all threads, past and present.
+  // REQUIRES: Static::pageheap_lock is held.
+  static void GetZeroStats(ZeroStats* stats);
+
+  // The number of times this cache has fetched objects from, and
+  // released objects to, the central cache (since its thread claimed it),
+  // and its current limit.
+  uint64_t fetches() const { return fetches_ - fetches_at_claim_; }
+  uint64_t releases() const { return releases_ - releases_at_claim_; }
+  size_t max_size() const { return max_size_; }
+
+  // Sets *fetches and *releases to the totals over all threads, past and
+  // present.
+  // REQUIRES: Static::pageheap_lock is held.
+  static void GetCentralCacheTrips(uint64_t* fetches, uint64_t* releases);
+
  private:
   class FreeList {
    private:
     void*    list_;       // Linked list of nodes
+    // Objects which have never been handed out since their pages were
+    // zeroed are kept out of line, as a run of consecutive objects starting
+    // at fresh_, so that nothing (not even a link) is written to them.
+    // Pop() only takes from here once the linked list is empty.
+    char*    fresh_;
 
 #ifdef _LP64
     // On 64-bit hardware, manipulating 16-bit values may be slightly slow.
-    uint32_t length_;      // Current length.
+    uint32_t length_;      // Current length (including fresh objects).
     uint32_t lowater_;     // Low water mark for list length.
     uint32_t max_length_;  // Dynamic max list length based on usage.
     // Tracks the number of times a deallocation has caused
     // length_ > max_length_.  After the kMaxOverages'th time, max_length_
     // shrinks and length_overages_ is reset to zero.
     uint32_t length_overages_;
+    // The last zero_ objects in the linked list are known to be zero, apart
+    // from their link; nothing but PushRange() into an empty list adds them.
+    uint32_t zero_;
+    uint32_t fresh_length_;  // Number of objects at fresh_.
 #else
     // If we aren't using 64-bit pointers then pack these into less space.
     uint16_t length_;
     uint16_t lowater_;
     uint16_t max_length_;
     uint16_t length_overages_;
+    uint16_t zero_;
+    uint16_t fresh_length_;
 #endif
 
+    // Number of objects on the linked list.
+    size_t linked_length() const {
+      return length_ - fresh_length_;
+    }
+
    public:
     void Init() {
       list_ = NULL;
+      fresh_ = NULL;
       length_ = 0;
       lowater_ = 0;
       max_length_ = 1;
       length_overages_ = 0;
+      zero_ = 0;
+      fresh_length_ = 0;
     }
 
     // Return current length of list
@@ -186,45 +390,189 @@ class ThreadCache {
 
     // Is list empty?
     bool empty() const {
-      return list_ == NULL;
+      return length_ == 0;
     }
 
     // Low-water mark management
     int lowwatermark() const { return lowater_; }
     void clear_lowwatermark() { lowater_ = length_; }
 
-    void Push(void* ptr) {
+    // Is the object Pop() would return known to be zero (apart from its
+    // first word)?
+    bool head_is_zero() const {
+      return linked_length() <= zero_;
+    }
+
+    // Is the whole list known to be zero (apart from the links)?
+    bool all_zero() const {
+      return zero_ == linked_length();
+    }
+
+    // If zero is set, ptr is zero apart from its link.
+    void Push(void* ptr, bool zero = false) {
       SLL_Push(&list_, ptr);
+      if (zero && zero_ == linked_length()) zero_++;
       length_++;
     }
 
-    void* Pop() {
-      ASSERT(list_ != NULL);
+    // size is the size of the objects in the list.
+    void* Pop(size_t size) {
+      ASSERT(length_ > 0);
       length_--;
       if (length_ < lowater_) lowater_ = length_;
-      return SLL_Pop(&list_);
+      if (UNLIKELY(list_ == NULL)) {
+        void* result = fresh_;
+        fresh_ += size;
+        fresh_length_--;
+        return result;
+      }
+      if (zero_ > linked_length()) zero_ = linked_length();
+      void* result = SLL_Pop(&list_);
+      PrefetchHead(size);
+      return result;
+    }
+
+    // Starts fetching the new head of the list for writing: the next Pop()
+    // reads its link, and the allocation then writes it, zeroing all of it
+    // unless it is known to be zero already.  Its lines were last written
+    // by whoever freed it, often on another core, so the misses are better
+    // taken while the caller works on the object it just got.
+    void PrefetchHead(size_t size) const {
+#if TCMALLOC_FREELIST_PREFETCH_LINES > 0 && defined(__GNUC__)
+      const size_t kLineSize = 64;
+      const char* head = static_cast<const char*>(list_);
+      if (head == NULL) return;
+      __builtin_prefetch(head, 1, 3);
+      if (head_is_zero()) return;
+      size_t lines = (size + kLineSize - 1) / kLineSize;
+      if (lines > TCMALLOC_FREELIST_PREFETCH_LINES) {
+        lines = TCMALLOC_FREELIST_PREFETCH_LINES;
+      }
+      for (size_t i = 1; i < lines; ++i) {
+        __builtin_prefetch(head + i * kLineSize, 1, 3);
+      }
+#else
+      (void)size;
+#endif
     }
 
     void* Next() {
       return SLL_Next(&list_);
     }
 
-    void PushRange(int N, void *start, void *end) {
+    // The last 'zero' objects of the range are known to be zero.
+    void PushRange(int N, void *start, void *end, int zero) {
       SLL_PushRange(&list_, start, end);
+      if (linked_length() == 0) zero_ = zero;
       length_ += N;
     }
 
-    void PopRange(int N, void **start, void **end) {
-      SLL_PopRange(&list_, N, start, end);
+    // Add N fresh objects, starting at start (the list must not have any
+    // already).
+    void SetFresh(int N, char* start) {
+      ASSERT(fresh_length_ == 0);
+      fresh_ = start;
+      fresh_length_ = N;
+      length_ += N;
+    }
+
+    // Returns the number of objects at the end of the first N which are
+    // known to be zero, as PushRange() and PopRange() count them.
+    int zero_in_front(int N) const {
+      const int dirty = static_cast<int>(linked_length() - zero_);
+      return N > dirty ? N - dirty : 0;
+    }
+
+    // Zero the objects in front of the known-zero ones (all but the first
+    // word, which is their link), making the whole list zero.  Returns
+    // the number of objects zeroed.
+    size_t ZeroDirty(size_t size) {
+      const size_t dirty = linked_length() - zero_;
+      void* p = list_;
+      for (size_t n = dirty; n > 0; --n) {
+        tcmalloc_zero_object(reinterpret_cast<char*>(p) + sizeof(void*),
+                             size - sizeof(void*));
+        p = SLL_Next(p);
+      }
+      zero_ = linked_length();
+      return dirty;
+    }
+
+    // Fresh objects are linked up (after the others) if we need them.
+    void PopRange(int N, void **start, void **end, size_t size) {
       ASSERT(length_ >= N);
+      const int avail = static_cast<int>(linked_length());
+      const int linked = (N < avail) ? N : avail;
+      SLL_PopRange(&list_, linked, start, end);
+      if (N > linked) {
+        const int n_fresh = N - linked;
+        for (int i = 0; i < n_fresh - 1; ++i) {
+          SLL_SetNext(fresh_ + i * size, fresh_ + (i + 1) * size);
+        }
+        char* last = fresh_ + (n_fresh - 1) * size;
+        SLL_SetNext(last, NULL);
+        if (*end) SLL_SetNext(*end, fresh_);
+        else *start = fresh_;
+        *end = last;
+        fresh_ += n_fresh * size;
+        fresh_length_ -= n_fresh;
+      }
       length_ -= N;
       if (length_ < lowater_) lowater_ = length_;
+      if (zero_ > linked_length()) zero_ = linked_length();
     }
   };
 
+  // A cache shared by the threads running on one CPU.  More CPUs than
+  // kMaxCpus share caches, round-robin.
+  struct CpuCache {
+    // cpu_caches_ is a static array, which may be used before its
+    // constructor runs, so the constructor must leave it alone.
+    CpuCache() : lock(base::LINKER_INITIALIZED) { }
+
+    SpinLock lock;
+    ThreadCache* cache;       // Created on first use.  Protected by lock.
+  };
+
+  // Returns cpu's cache, creating it if necessary.
+  // REQUIRES: cpu->lock is held.
+  static ThreadCache* CpuCacheLocked(CpuCache* cpu) {
+    if (UNLIKELY(cpu->cache == NULL)) NewCpuCache(cpu);
+    return cpu->cache;
+  }
+  static void NewCpuCache(CpuCache* cpu);
+
+  // The queue of objects freed by other threads for one home.  Objects
+  // are pushed onto head without a lock, and taken off all at once.
+  // owner is the ThreadCache the home belongs to, or NULL if none.
+  struct RemoteQueue {
+    AtomicWord head;
+    AtomicWord owner;
+  };
+
+  // If ptr comes from another thread's span, pushes it onto
+  // that thread's queue and returns true; otherwise returns false.
+  bool PushRemoteFree(void* ptr);
+  // Takes the objects off our own queue and into our freelists.
+  void DrainRemoteFrees();
+  // Takes the objects off a queue which has no owner (any longer) and
+  // gives them back to the central cache.
+  static void ReleaseRemoteFrees(RemoteQueue* queue);
+
+  void* AllocateLocal(size_t size, size_t cl, bool* zeroed);
+  void DeallocateLocal(void* ptr, size_t size_class);
+  // For the size classes that aren't cached (see max_cached_size()).
+  void* AllocateUncached(size_t cl, bool* zeroed);
+  void DeallocateUncached(void* ptr, size_t cl);
+  int AllocateBatchLocal(size_t size, size_t cl, void** ptrs, int n,
+                         int* zero);
+  void DeallocateBatchLocal(void** ptrs, int n, size_t cl);
+
   // Gets and returns an object from the central cache, and, if possible,
   // also adds some objects of that size class to this thread cache.
-  void* FetchFromCentralCache(size_t cl, size_t byte_size);
+  // If zeroed is non-NULL, *zeroed tells whether the object is known to be
+  // zero apart from its freelist link.
+  void* FetchFromCentralCache(size_t cl, size_t byte_size, bool* zeroed);
 
   // Releases some number of items from src.  Adjusts the list's max_length
   // to eventually converge on num_objects_to_move(cl).
@@ -234,8 +582,9 @@ class ThreadCache {
   void ReleaseToCentralCache(FreeList* src, size_t cl, int N);
 
   // Increase max_size_ by reducing unclaimed_cache_space_ or by
-  // reducing the max_size_ of some other thread.  In both cases,
-  // the delta is kStealAmount.
+  // reducing the max_size_ of other threads.  The delta grows with
+  // the number of fetches since max_size_ last grew (see
+  // kFetchesPerSteal), and is mostly taken from idle threads.
   void IncreaseCacheLimit();
   // Same as above but requires Static::pageheap_lock() is held.
   void IncreaseCacheLimitLocked();
@@ -261,12 +610,13 @@ class ThreadCache {
 #ifdef HAVE_TLS
   struct ThreadLocalData {
     ThreadCache* heap;
-    // min_size_for_slow_path is 0 if heap is NULL or kMaxSize + 1 otherwise.
+    // min_size_for_slow_path is 0 if heap is NULL or kMaxSize + 1 otherwise
+    // (1 if sample_allocations()).
     // The latter is the common case and allows allocation to be faster
     // than it would be otherwise: typically a single branch will
     // determine that the requested allocation is no more than kMaxSize
     // and we can then proceed, knowing that global and thread-local tcmalloc
-    // state is initialized.
+    // state is initialized, and that the allocation isn't to be sampled.
     size_t min_size_for_slow_path;
   };
   static __thread ThreadLocalData threadlocal_data_ ATTR_INITIAL_EXEC;
@@ -280,9 +630,12 @@ class ThreadCache {
   static bool tsd_inited_;
   static pthread_key_t heap_key_;
 
-  // Linked list of heap objects.  Protected by Static::pageheap_lock.
+  // Linked list of heap objects.  Added to under Static::pageheap_lock
+  // (see next_).
   static ThreadCache* thread_heaps_;
   static int thread_heap_count_;
+  // Number of caches in the pool (see free_).  Only a hint.
+  static Atomic32 free_heap_count_;
 
   // A pointer to one of the objects in thread_heaps_.  Represents
   // the next ThreadCache from which a thread over its max_size_ should
@@ -303,6 +656,34 @@ class ThreadCache {
   // across all ThreadCaches.  Protected by Static::pageheap_lock.
   static ssize_t unclaimed_cache_space_;
 
+  // See zero_on_free().
+  static bool zero_on_free_;
+
+  // See prezero_spans().
+  static bool prezero_spans_;
+
+  // See malloc_fill_byte().
+  static int malloc_fill_byte_;
+
+  // See max_cached_size().  Size classes from uncached_class_ on are
+  // larger than that (classes only get larger).
+  static size_t max_cached_size_;
+  static size_t uncached_class_;
+
+  // See sample_allocations().  Set once, in InitModule().
+  static bool sample_allocations_;
+
+  // See per_cpu().  Set once, in InitModule().
+  static bool per_cpu_;
+  static CpuCache cpu_caches_[kMaxCpus];
+  // Number of cpu_caches_ in use.  Protected by Static::pageheap_lock.
+  static int cpu_cache_count_;
+
+  // See remote_free().  Set once, in InitModule().  Homes are handed out
+  // (their owner set) under Static::pageheap_lock; home 0 isn't used.
+  static bool remote_free_;
+  static RemoteQueue remote_queues_[kMaxHomes];
+
   // This class is laid out with the most frequently used fields
   // first so that hot elements are placed on the same cache line.
 
@@ -311,18 +692,48 @@ class ThreadCache {
 
   // We sample allocations, biased by the size of the allocation
   Sampler       sampler_;               // A sampler
+  StackTrace*   spare_stack_;           // See TakeSpareStackTrace()
 
   FreeList      list_[kNumClasses];     // Array indexed by size-class
 
   pthread_t     tid_;                   // Which thread owns it
+  int           cpu_;                   // Or which CPU, if not -1
+  int           home_;                  // See remote_free()
   bool          in_setspecific_;        // In call to pthread_setspecific?
+  // 1 while the cache is in the pool, with no thread.  A thread claims it
+  // by setting it to 0, and then sets tid_ (which is zero in the pool).
+  Atomic32      free_;
+
+  ZeroStats     zero_stats_;            // Zeroing done by the cache's threads
+
+  uint64_t      fetches_;               // FetchFromCentralCache() calls
+  uint64_t      releases_;              // ReleaseToCentralCache() calls
+  // fetches_ and releases_ when the current thread claimed the cache.
+  uint64_t      fetches_at_claim_;
+  uint64_t      releases_at_claim_;
+  // fetches_ when max_size_ last grew, and when the steal round-robin
+  // last passed this cache.  The latter is protected by
+  // Static::pageheap_lock.
+  uint64_t      fetches_at_grow_;
+  uint64_t      fetches_at_visit_;
+
+  // Allocate a new heap (for cpu, if not -1).
+  // REQUIRES: Static::pageheap_lock is held.
+  static ThreadCache* NewHeap(pthread_t tid, int cpu = -1);
 
-  // Allocate a new heap. REQUIRES: Static::pageheap_lock is held.
-  static ThreadCache* NewHeap(pthread_t tid);
+  // Claim a heap from the pool for thread tid, or return NULL if there's
+  // none.  The heap keeps the cache limit it had: it's left to the usual
+  // stealing (see IncreaseCacheLimitLocked()) to even the limits out.
+  // Takes no lock.
+  static ThreadCache* ClaimFreeHeap(pthread_t tid);
+
+  // Give the calling thread a home, if there's one free (see remote_free()).
+  void ClaimHome();
 
   // Use only as pthread thread-specific destructor function.
   static void DestroyThreadCache(void* ptr);
 
+  // Empty the heap and put it in the pool.  Takes no lock.
   static void DeleteCache(ThreadCache* heap);
   static void RecomputePerThreadCacheSize();
 
@@ -345,19 +756,87 @@ inline bool ThreadCache::SampleAllocation(size_t k) {
   return sampler_.SampleAllocation(k);
 }
 
-inline void* ThreadCache::Allocate(size_t size, size_t cl) {
+inline int ThreadCache::CurrentCpu() {
+#if defined(HAVE_SYS_RSEQ_H) && defined(HAVE_TLS)
+  // Where glibc has registered rseq for this thread, the kernel keeps the
+  // CPU number up to date in the thread's rseq area, which is cheaper to
+  // read than a call to sched_getcpu().
+  if (LIKELY(__rseq_size > 0)) {
+    const struct rseq* rs = reinterpret_cast<const struct rseq*>(
+        reinterpret_cast<const char*>(__builtin_thread_pointer()) +
+        __rseq_offset);
+    return *reinterpret_cast<const volatile uint32_t*>(&rs->cpu_id) %
+        kMaxCpus;
+  }
+#endif
+#ifdef HAVE_SCHED_GETCPU
+  const int cpu = sched_getcpu();
+  if (LIKELY(cpu >= 0)) return cpu % kMaxCpus;
+#endif
+  return 0;
+}
+
+inline void* ThreadCache::Allocate(size_t size, size_t cl, bool* zeroed) {
+  if (UNLIKELY(cl >= uncached_class_)) return AllocateUncached(cl, zeroed);
+  if (UNLIKELY(per_cpu_)) {
+    CpuCache* cpu = &cpu_caches_[CurrentCpu()];
+    SpinLockHolder h(&cpu->lock);
+    return CpuCacheLocked(cpu)->AllocateLocal(size, cl, zeroed);
+  }
+  return AllocateLocal(size, cl, zeroed);
+}
+
+inline void ThreadCache::Deallocate(void* ptr, size_t cl) {
+  if (UNLIKELY(cl >= uncached_class_)) {
+    DeallocateUncached(ptr, cl);
+    return;
+  }
+  if (UNLIKELY(per_cpu_)) {
+    CpuCache* cpu = &cpu_caches_[CurrentCpu()];
+    SpinLockHolder h(&cpu->lock);
+    CpuCacheLocked(cpu)->DeallocateLocal(ptr, cl);
+    return;
+  }
+  if (UNLIKELY(remote_free_) && PushRemoteFree(ptr)) return;
+  DeallocateLocal(ptr, cl);
+}
+
+inline int ThreadCache::AllocateBatch(size_t size, size_t cl, void** ptrs,
+                                      int n, int* zero) {
+  if (UNLIKELY(per_cpu_)) {
+    CpuCache* cpu = &cpu_caches_[CurrentCpu()];
+    SpinLockHolder h(&cpu->lock);
+    return CpuCacheLocked(cpu)->AllocateBatchLocal(size, cl, ptrs, n, zero);
+  }
+  return AllocateBatchLocal(size, cl, ptrs, n, zero);
+}
+
+inline void ThreadCache::DeallocateBatch(void** ptrs, int n, size_t cl) {
+  if (n == 0) return;
+  if (UNLIKELY(per_cpu_)) {
+    CpuCache* cpu = &cpu_caches_[CurrentCpu()];
+    SpinLockHolder h(&cpu->lock);
+    CpuCacheLocked(cpu)->DeallocateBatchLocal(ptrs, n, cl);
+    return;
+  }
+  DeallocateBatchLocal(ptrs, n, cl);
+}
+
+inline void* ThreadCache::AllocateLocal(size_t size, size_t cl,
+                                        bool* zeroed) {
   ASSERT(size <= kMaxSize);
   ASSERT(size == Static::sizemap()->ByteSizeForClass(cl));
 
   FreeList* list = &list_[cl];
   if (UNLIKELY(list->empty())) {
-    return FetchFromCentralCache(cl, size);
+    return FetchFromCentralCache(cl, size, zeroed);
   }
   size_ -= size;
-  return list->Pop();
+  if (zeroed) *zeroed = list->head_is_zero();
+  return list->Pop(size);
 }
 
-inline void ThreadCache::Deallocate(void* ptr, size_t cl) {
+inline void ThreadCache::DeallocateLocal(void* ptr, size_t cl) {
   FreeList* list = &list_[cl];
   size_ += Static::sizemap()->ByteSizeForClass(cl);
   ssize_t size_headroom = max_size_ - size_ - 1;
@@ -367,7 +846,17 @@ inline void ThreadCache::Deallocate(void* ptr, size_t cl) {
   // the entire freelist. But this might be enough to find some bugs.
   ASSERT(ptr != list->Next());
 
-  list->Push(ptr);
+  // (only worth it while we still know the whole list to be zero; the rest
+  //  get zeroed in bulk in ListTooLong)
+  if (UNLIKELY(zero_on_free_) && list->all_zero()) {
+    size_t size = Static::sizemap()->ByteSizeForClass(cl);
+    tcmalloc_zero_object(reinterpret_cast<char*>(ptr) + sizeof(void*),
+                         size - sizeof(void*));
+    RecordZeroed(ZeroStats::kFree, cl, size);
+    list->Push(ptr, true);
+  } else {
+    list->Push(ptr);
+  }
   ssize_t list_headroom =
       static_cast<ssize_t>(list->max_length()) - list->length();
 
@@ -421,6 +910,12 @@ inline ThreadCache* ThreadCache::GetCacheIfPresent() {
   return GetThreadHeap();
 }
 
+inline int ThreadCache::CurrentHome() {
+  if (!remote_free_) return 0;
+  ThreadCache* heap = GetCacheIfPresent();
+  return heap ? heap->home_ : 0;
+}
+
 inline size_t ThreadCache::MinSizeForSlowPath() {
 #ifdef HAVE_TLS
   return threadlocal_data_.min_size_for_slow_path;
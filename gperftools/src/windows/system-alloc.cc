@@ -38,6 +38,7 @@
 #include <windows.h>
 #include <algorithm> // std::min
 #include <gperftools/malloc_extension.h>
+#include "base/commandlineflags.h"
 #include "base/logging.h"
 #include "base/spinlock.h"
 #include "internal_logging.h"
@@ -50,11 +51,108 @@ SysAllocator* sys_alloc = NULL;
 // Number of bytes taken from system.
 size_t TCMalloc_SystemTaken = 0;
 
+// Configuration parameters (the ones the linux port has that apply here).
+DEFINE_bool(malloc_disable_memory_release,
+            EnvToBool("TCMALLOC_DISABLE_MEMORY_RELEASE", false),
+            "Whether unused memory should be decommitted (or discarded)"
+            " to return it to the system.");
+DEFINE_bool(malloc_lazy_free,
+            EnvToBool("TCMALLOC_LAZY_FREE", false),
+            "Whether memory should be returned to the system lazily (with"
+            " DiscardVirtualMemory, on windows 8.1 and later), so it stays"
+            " committed.  Such pages are zeroed on reuse.");
+DEFINE_bool(malloc_numa,
+            EnvToBool("TCMALLOC_NUMA", false),
+            "Whether memory should be bound to the NUMA node of the thread"
+            " that gets it from the system, and free pages reused on the"
+            " node they are on.");
+
+// The functions newer than our _WIN32_WINNT are looked up at run time.
+namespace {
+
+typedef DWORD (WINAPI *DiscardVirtualMemoryFn)(PVOID, SIZE_T);
+typedef DWORD (WINAPI *GetCurrentProcessorNumberFn)(VOID);
+typedef BOOL (WINAPI *GetNumaProcessorNodeFn)(UCHAR, PUCHAR);
+typedef LPVOID (WINAPI *VirtualAllocExNumaFn)(HANDLE, LPVOID, SIZE_T, DWORD,
+                                              DWORD, DWORD);
+
+template <typename Fn> Fn Kernel32Function(const char* name) {
+  HMODULE kernel32 = GetModuleHandleA("kernel32.dll");
+  if (kernel32 == NULL) return NULL;
+  return reinterpret_cast<Fn>(GetProcAddress(kernel32, name));
+}
+
+DiscardVirtualMemoryFn discard_virtual_memory = NULL;
+GetCurrentProcessorNumberFn get_current_processor_number = NULL;
+GetNumaProcessorNodeFn get_numa_processor_node = NULL;
+VirtualAllocExNumaFn virtual_alloc_ex_numa = NULL;
+
+// Called by each function using them.  (Racing calls store the same values.)
+void InitKernel32Functions() {
+  static bool inited = false;
+  if (inited) return;
+  discard_virtual_memory =
+      Kernel32Function<DiscardVirtualMemoryFn>("DiscardVirtualMemory");
+  get_current_processor_number = Kernel32Function<GetCurrentProcessorNumberFn>(
+      "GetCurrentProcessorNumber");
+  get_numa_processor_node =
+      Kernel32Function<GetNumaProcessorNodeFn>("GetNumaProcessorNode");
+  virtual_alloc_ex_numa =
+      Kernel32Function<VirtualAllocExNumaFn>("VirtualAllocExNuma");
+  inited = true;
+}
+
+// Calls fn(ptr, size, arg) on each part of [start, start + length) which
+// lies in a single VirtualAlloc region; returns false if any call does.
+// (Ranges may span regions, as the page heap merges spans of adjacent ones.)
+typedef bool (*RegionFn)(char* ptr, size_t size, void* arg);
+bool ForEachRegion(void* start, size_t length, RegionFn fn, void* arg) {
+  char* ptr = static_cast<char*>(start);
+  char* end = ptr + length;
+  MEMORY_BASIC_INFORMATION info;
+  while (ptr < end) {
+    size_t resultSize = VirtualQuery(ptr, &info, sizeof(info));
+    assert(resultSize == sizeof(info));
+    size_t regionSize = std::min<size_t>(
+        static_cast<char*>(info.BaseAddress) + info.RegionSize - ptr,
+        end - ptr);
+    if (!fn(ptr, regionSize, arg)) return false;
+    ptr += regionSize;
+  }
+  return true;
+}
+
+bool DiscardRegion(char* ptr, size_t size, void*) {
+  return discard_virtual_memory(ptr, size) == ERROR_SUCCESS;
+}
+
+bool DecommitRegion(char* ptr, size_t size, void*) {
+  return VirtualFree(ptr, size, MEM_DECOMMIT) != 0;
+}
+
+bool CommitRegion(char* ptr, size_t size, void*) {
+  return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) == ptr;
+}
+
+bool BindRegion(char* ptr, size_t size, void* node) {
+  return virtual_alloc_ex_numa(GetCurrentProcess(), ptr, size, MEM_COMMIT,
+                               PAGE_READWRITE,
+                               *static_cast<DWORD*>(node)) == ptr;
+}
+
+}  // namespace
+
 class VirtualSysAllocator : public SysAllocator {
 public:
   VirtualSysAllocator() : SysAllocator() {
   }
   void* Alloc(size_t size, size_t *actual_size, size_t alignment);
+  void* AllocMaybeZeroed(size_t size, size_t *actual_size, size_t alignment,
+                         bool* zeroed) {
+    // (VirtualAlloc() zeroes the pages it commits)
+    *zeroed = true;
+    return Alloc(size, actual_size, alignment);
+  }
 };
 static char virtual_space[sizeof(VirtualSysAllocator)];
 
@@ -126,7 +224,7 @@ void InitSystemAllocators(void) {
 
 extern PERFTOOLS_DLL_DECL
 void* TCMalloc_SystemAlloc(size_t size, size_t *actual_size,
-			   size_t alignment) {
+			   size_t alignment, bool* zeroed) {
   SpinLockHolder lock_holder(&spinlock);
 
   if (!system_alloc_inited) {
@@ -134,7 +232,13 @@ void* TCMalloc_SystemAlloc(size_t size, size_t *actual_size,
     system_alloc_inited = true;
   }
 
-  void* result = sys_alloc->Alloc(size, actual_size, alignment);
+  bool zeroed_storage;
+  if (zeroed == NULL) {
+    zeroed = &zeroed_storage;
+  }
+
+  void* result = sys_alloc->AllocMaybeZeroed(size, actual_size, alignment,
+                                             zeroed);
   if (result != NULL) {
     if (actual_size) {
       TCMalloc_SystemTaken += *actual_size;
@@ -145,33 +249,75 @@ void* TCMalloc_SystemAlloc(size_t size, size_t *actual_size,
   return result;
 }
 
+// Set if DiscardVirtualMemory turned out not to work.
+static bool lazy_free_unsupported = false;
+
+extern PERFTOOLS_DLL_DECL
+bool TCMalloc_SystemReleaseIsLazy() {
+  InitKernel32Functions();
+  return FLAGS_malloc_lazy_free && discard_virtual_memory != NULL &&
+         !lazy_free_unsupported;
+}
+
+// Set once memory is to be zeroed in place rather than released.
+static bool release_in_place = false;
+
+extern PERFTOOLS_DLL_DECL
+bool TCMalloc_SystemReleaseIsInPlace() {
+  return release_in_place;
+}
+
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemSetReleaseInPlace() {
+  release_in_place = true;
+}
+
+extern PERFTOOLS_DLL_DECL
+bool TCMalloc_SystemIsReclaimed(void* start, size_t length) {
+  // Discarded pages which windows hasn't reused may keep their contents,
+  // and there's no telling which those are (being out of the working set
+  // doesn't mean they're gone).  So lazily released spans are zeroed.
+  return false;
+}
+
+// Decommitted pages read back as zero once committed again, so released
+// spans are known to be zero, as on linux.  Discarded pages (with
+// TCMALLOC_LAZY_FREE) stay committed, and may or may not read back as zero:
+// see TCMalloc_SystemIsReclaimed.
 extern PERFTOOLS_DLL_DECL
 bool TCMalloc_SystemRelease(void* start, size_t length) {
-  if (VirtualFree(start, length, MEM_DECOMMIT))
-    return true;
+  if (FLAGS_malloc_disable_memory_release || release_in_place) return false;
+
+  // Only whole pages can be released, and the span needs to be released
+  // in full to be known to be zero: refuse anything else, rather than
+  // releasing part of it.
+  const size_t pagemask = getpagesize() - 1;
+  if ((reinterpret_cast<uintptr_t>(start) & pagemask) != 0 ||
+      (length & pagemask) != 0) {
+    return false;
+  }
+  if (length == 0) return false;
+
+  if (TCMalloc_SystemReleaseIsLazy()) {
+    if (ForEachRegion(start, length, DiscardRegion, NULL))
+      return true;
+    // (e.g. under a compatibility layer which doesn't implement it; any
+    // part that was discarded is simply decommitted below)
+    lazy_free_unsupported = true;
+  }
 
   // The decommit may fail if the memory region consists of allocations
   // from more than one call to VirtualAlloc.  In this case, fall back to
   // using VirtualQuery to retrieve the allocation boundaries and decommit
   // them each individually.
-
-  char* ptr = static_cast<char*>(start);
-  char* end = ptr + length;
-  MEMORY_BASIC_INFORMATION info;
-  while (ptr < end) {
-    size_t resultSize = VirtualQuery(ptr, &info, sizeof(info));
-    assert(resultSize == sizeof(info));
-    size_t decommitSize = std::min<size_t>(info.RegionSize, end - ptr);
-    BOOL success = VirtualFree(ptr, decommitSize, MEM_DECOMMIT);
-    assert(success == TRUE);
-    ptr += decommitSize;
-  }
-
-  return true;
+  if (VirtualFree(start, length, MEM_DECOMMIT))
+    return true;
+  return ForEachRegion(start, length, DecommitRegion, NULL);
 }
 
 extern PERFTOOLS_DLL_DECL
 void TCMalloc_SystemCommit(void* start, size_t length) {
+  // (Committing discarded pages, which are still committed, does nothing.)
   if (VirtualAlloc(start, length, MEM_COMMIT, PAGE_READWRITE) == start)
     return;
 
@@ -179,20 +325,89 @@ void TCMalloc_SystemCommit(void* start, size_t length) {
   // from more than one call to VirtualAlloc.  In this case, fall back to
   // using VirtualQuery to retrieve the allocation boundaries and commit them
   // each individually.
+  bool success = ForEachRegion(start, length, CommitRegion, NULL);
+  assert(success);
+  (void)success;
+}
 
-  char* ptr = static_cast<char*>(start);
-  char* end = ptr + length;
-  MEMORY_BASIC_INFORMATION info;
-  while (ptr < end) {
-    size_t resultSize = VirtualQuery(ptr, &info, sizeof(info));
-    assert(resultSize == sizeof(info));
+extern PERFTOOLS_DLL_DECL
+size_t TCMalloc_SystemHugePageSize() {
+  // Large pages need SeLockMemoryPrivilege, and can't be decommitted.
+  return 0;
+}
 
-    size_t commitSize = std::min<size_t>(info.RegionSize, end - ptr);
-    void* newAddress = VirtualAlloc(ptr, commitSize, MEM_COMMIT,
-                                    PAGE_READWRITE);
-    assert(newAddress == ptr);
-    ptr += commitSize;
+extern PERFTOOLS_DLL_DECL
+int TCMalloc_SystemNumaNode() {
+  InitKernel32Functions();
+  if (!FLAGS_malloc_numa || get_current_processor_number == NULL ||
+      get_numa_processor_node == NULL || virtual_alloc_ex_numa == NULL) {
+    return -1;
   }
+  // (only the processors of the thread's group are told apart)
+  UCHAR node;
+  const DWORD cpu = get_current_processor_number();
+  if (cpu > 0xff || !get_numa_processor_node(static_cast<UCHAR>(cpu), &node))
+    return -1;
+  return node;
+}
+
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemBindToNode(void* start, size_t length, int node) {
+  InitKernel32Functions();
+  if (node < 0 || virtual_alloc_ex_numa == NULL) return;
+  // Only a preference, for the pages not faulted in yet (all of them, for
+  // memory fresh from the system); committing them again keeps it.
+  DWORD preferred = node;
+  ForEachRegion(start, length, BindRegion, &preferred);
+}
+
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemPopulate(void* start, size_t length) {
+  // Touch each page, storing back what's there.
+  const size_t pagesize = getpagesize();
+  char* const end = reinterpret_cast<char*>(start) + length;
+  for (char* p = reinterpret_cast<char*>(start); p < end; p += pagesize) {
+    volatile char* v = p;
+    *v = *v;
+  }
+}
+
+extern PERFTOOLS_DLL_DECL
+void* TCMalloc_SystemMap(size_t size, size_t alignment) {
+  if (release_in_place) return NULL;
+  // VirtualAlloc regions start at the allocation granularity (64KiB), and
+  // can only be freed whole, so for larger alignments we reserve enough to
+  // find an aligned address in, free that, and reserve just the aligned
+  // part; another thread may take it in between, so we may need to retry.
+  SYSTEM_INFO system_info;
+  GetSystemInfo(&system_info);
+  void* result = NULL;
+  if (alignment <= system_info.dwAllocationGranularity) {
+    result = VirtualAlloc(0, size, MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
+  } else {
+    if (size + alignment < size) return NULL;
+    for (int tries = 0; result == NULL && tries < 3; ++tries) {
+      void* reserved = VirtualAlloc(0, size + alignment, MEM_RESERVE,
+                                    PAGE_NOACCESS);
+      if (reserved == NULL) return NULL;
+      uintptr_t aligned = (reinterpret_cast<uintptr_t>(reserved) +
+                           alignment - 1) & ~(alignment - 1);
+      VirtualFree(reserved, 0, MEM_RELEASE);
+      result = VirtualAlloc(reinterpret_cast<void*>(aligned), size,
+                            MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
+    }
+  }
+  if (result == NULL) return NULL;
+  SpinLockHolder lock_holder(&spinlock);
+  TCMalloc_SystemTaken += size;
+  return result;
+}
+
+extern PERFTOOLS_DLL_DECL
+void TCMalloc_SystemUnmap(void* start, size_t size) {
+  VirtualFree(start, 0, MEM_RELEASE);
+  SpinLockHolder lock_holder(&spinlock);
+  TCMalloc_SystemTaken -= size;
 }
 
 bool RegisterSystemAllocator(SysAllocator *allocator, int priority) {
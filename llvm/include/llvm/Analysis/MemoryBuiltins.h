@@ -59,6 +59,18 @@ bool isMallocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
 bool isCallocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
                     bool LookThroughBitCast = false);
 
+/// \brief Tests if a value is a call or invoke to a function marked
+/// "safeinit-zeroed-return": one that returns null or fresh, zero-filled
+/// memory, such as a wrapper around calloc (or around malloc, where malloc
+/// returns zeroed memory). FunctionAttrs infers the attribute, and clang sets
+/// it from __attribute__((returns_zeroed)).
+bool returnsZeroedMemory(const Value *V, bool LookThroughBitCast = false);
+
+/// \brief Tests if a value is a call or invoke to a library function that
+/// allocates aligned, uninitialized memory (such as memalign).
+bool isAlignedAllocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
+                          bool LookThroughBitCast = false);
+
 /// \brief Tests if a value is a call or invoke to a library function that
 /// allocates memory (either malloc, calloc, or strdup like).
 bool isAllocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
@@ -141,6 +153,21 @@ bool getObjectSize(const Value *Ptr, uint64_t &Size, const DataLayout &DL,
                    const TargetLibraryInfo *TLI, bool RoundToAlign = false,
                    ObjSizeMode Mode = ObjSizeMode::Exact);
 
+/// \brief Returns the byte the allocation call Alloc left at Offset in the
+/// memory it returned, or -1 if that isn't known. Offset is -1 if unknown.
+/// MallocFillByte is TargetLibraryInfo::getMallocFillByte for the module:
+/// - calloc, and functions marked "safeinit-zeroed-return", return zeroed
+///   memory;
+/// - malloc and new return memory filled with MallocFillByte;
+/// - memalign and valloc return zeroed memory when the allocator is known
+///   (MallocFillByte >= 0), even in pattern-init mode;
+/// - realloc fills what it adds past the old contents with MallocFillByte,
+///   so the bytes from the size of the old object on are known if that size
+///   is (and all of them are when the old pointer is null).
+int getInitialAllocatedByte(const Value *Alloc, int64_t Offset,
+                            int MallocFillByte, const DataLayout &DL,
+                            const TargetLibraryInfo *TLI);
+
 typedef std::pair<APInt, APInt> SizeOffsetType;
 
 /// \brief Evaluate the size and offset of an object pointed to by a Value*
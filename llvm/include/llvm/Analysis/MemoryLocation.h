@@ -26,6 +26,7 @@ class LoadInst;
 class StoreInst;
 class MemTransferInst;
 class MemIntrinsic;
+class InitializedInst;
 class TargetLibraryInfo;
 
 /// Representation for a specific memory location.
@@ -88,6 +89,10 @@ public:
   /// transfer.
   static MemoryLocation getForDest(const MemIntrinsic *MI);
 
+  /// Return a location representing the range an llvm.initialized marker
+  /// stands for.
+  static MemoryLocation getForDest(const InitializedInst *II);
+
   /// Return a location representing a particular argument of a call.
   static MemoryLocation getForArgument(ImmutableCallSite CS, unsigned ArgIdx,
                                        const TargetLibraryInfo &TLI);
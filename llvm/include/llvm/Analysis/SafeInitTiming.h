@@ -0,0 +1,52 @@
+//===-- Analysis/SafeInitTiming.h - SafeInit compile time -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file breaks down the compile time SafeInit costs for -time-passes
+// (clang's -ftime-report): SafeInit's own work, and what its inits cost the
+// passes which have to reason about them.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_SAFEINITTIMING_H
+#define LLVM_ANALYSIS_SAFEINITTIMING_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Timer.h"
+#include <memory>
+
+namespace llvm {
+
+class Function;
+class raw_ostream;
+
+/// Times a region of SafeInit-related work on F, when -time-passes is given.
+/// Each region name gets a timer in the "SafeInit" group, and the time spent
+/// in a thread's outermost region is charged to F, so that the functions
+/// SafeInit costs most in can be listed too.
+class SafeInitTimeRegion {
+  std::unique_ptr<NamedRegionTimer> T;
+  const Function *ChargedF;
+  double Start;
+
+  SafeInitTimeRegion(const SafeInitTimeRegion &) = delete;
+  void operator=(const SafeInitTimeRegion &) = delete;
+
+public:
+  SafeInitTimeRegion(StringRef Name, const Function &F);
+  ~SafeInitTimeRegion();
+};
+
+/// Print the functions with the most SafeInit-related time charged to them
+/// (see -safeinit-time-report-functions), and forget them. Whatever is left
+/// is printed to the -info-output-file at llvm_shutdown().
+void printSafeInitFunctionTimes(raw_ostream &OS);
+
+} // end namespace llvm
+
+#endif
@@ -225,6 +225,19 @@ public:
     return Impl->getVectorizedFunction(F, VF);
   }
 
+  /// Tests whether malloc and operator new return zeroed memory in M, which
+  /// the "malloc-returns-zero" module flag records (SafeInit builds link
+  /// against a zeroing allocator). Module flags are carried through llvm-link,
+  /// so this also holds during LTO.
+  bool mallocReturnsZero(const Module &M) const;
+
+  /// Returns the byte malloc and operator new fill their memory with in M,
+  /// or -1 if nothing is known. That's 0 where mallocReturnsZero holds, and
+  /// the pattern recorded by the "malloc-fill-byte" module flag for
+  /// SafeInit's pattern-init mode (whose allocator fills with the pattern
+  /// instead; calloc still returns zeroed memory).
+  int getMallocFillByte(const Module &M) const;
+
   /// Tests if the function is both available and a candidate for optimized code
   /// generation.
   bool hasOptimizedCodeGen(LibFunc::Func F) const {
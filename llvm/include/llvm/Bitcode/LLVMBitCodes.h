@@ -219,6 +219,10 @@ enum GlobalValueSummarySymtabCodes {
   FS_COMBINED_ORIGINAL_NAME = 9,
   // VERSION of the summary, bumped when adding flags for instance.
   FS_VERSION = 10,
+  // PARAM_INITS: [n x bytes]
+  // Bytes of each parameter written before being read (for SafeInit),
+  // attached to the preceding PERMODULE or COMBINED record.
+  FS_PARAM_INITS = 11,
 };
 
 enum MetadataCodes {
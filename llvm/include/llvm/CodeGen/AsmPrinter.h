@@ -16,6 +16,7 @@
 #ifndef LLVM_CODEGEN_ASMPRINTER_H
 #define LLVM_CODEGEN_ASMPRINTER_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
@@ -550,6 +551,10 @@ private:
   /// Emit GlobalAlias or GlobalIFunc.
   void emitGlobalIndirectSymbol(Module &M,
                                 const GlobalIndirectSymbol& GIS);
+  /// Emit the current function's entry in the SafeInit code size section,
+  /// from the ranges of init code in SafeInitRanges.
+  void emitSafeInitSizes(ArrayRef<std::pair<MCSymbol *, MCSymbol *>>
+                             SafeInitRanges);
 };
 }
 
@@ -128,11 +128,16 @@ class MachineFrameInfo {
     /// If true, the object has been zero-extended.
     bool isSExt;
 
+    /// If true, a loop writes the whole object before anything can read it
+    /// (an llvm.initialized marker says so), so frame clearing can skip it.
+    bool isLoopInitialized;
+
     StackObject(uint64_t Sz, unsigned Al, int64_t SP, bool IM,
                 bool isSS, const AllocaInst *Val, bool A)
       : SPOffset(SP), Size(Sz), Alignment(Al), isImmutable(IM),
         isSpillSlot(isSS), isStatepointSpillSlot(false), Alloca(Val),
-        PreAllocated(false), isAliased(A), isZExt(false), isSExt(false) {}
+        PreAllocated(false), isAliased(A), isZExt(false), isSExt(false),
+        isLoopInitialized(false) {}
   };
 
   /// The alignment of the stack.
@@ -598,6 +603,19 @@ public:
     return Objects[ObjectIdx + NumFixedObjects].Size == 0;
   }
 
+  /// Returns true if a loop writes the whole object before it can be read.
+  bool isLoopInitializedObjectIndex(int ObjectIdx) const {
+    assert(unsigned(ObjectIdx+NumFixedObjects) < Objects.size() &&
+           "Invalid Object Idx!");
+    return Objects[ObjectIdx+NumFixedObjects].isLoopInitialized;
+  }
+
+  void setObjectLoopInitialized(int ObjectIdx, bool Initialized) {
+    assert(unsigned(ObjectIdx+NumFixedObjects) < Objects.size() &&
+           "Invalid Object Idx!");
+    Objects[ObjectIdx+NumFixedObjects].isLoopInitialized = Initialized;
+  }
+
   void markAsStatepointSpillSlotObjectIndex(int ObjectIdx) {
     assert(unsigned(ObjectIdx+NumFixedObjects) < Objects.size() &&
            "Invalid Object Idx!");
@@ -80,6 +80,19 @@ public:
     return SDValue();
   }
 
+  /// Emit target-specific code that performs a memset inserted by SafeInit to
+  /// initialize a stack object. These memsets are frequent and mostly fall
+  /// outside the limits for simple stores, so targets may want a lowering
+  /// that avoids the library call even where they would not for an ordinary
+  /// memset. Returning a null SDValue falls back to EmitTargetCodeForMemset.
+  virtual SDValue
+  EmitTargetCodeForSafeInitMemset(SelectionDAG &DAG, SDLoc dl, SDValue Chain,
+                                  SDValue Op1, SDValue Op2, SDValue Op3,
+                                  unsigned Align,
+                                  MachinePointerInfo DstPtrInfo) const {
+    return SDValue();
+  }
+
   /// Emit target-specific code that performs a memcmp, in cases where that is
   /// faster than a libcall. The first returned SDValue is the result of the
   /// memcmp and the second is the chain. Both SDValues can be null if a normal
@@ -203,7 +203,6 @@ namespace llvm {
       case Intrinsic::memcpy:
       case Intrinsic::memmove:
       case Intrinsic::memset:
-      case Intrinsic::initialized:
         return true;
       default: return false;
       }
@@ -294,6 +293,41 @@ namespace llvm {
     }
   };
 
+  /// This represents the llvm.initialized intrinsic, which LoopIdiomRecognize
+  /// puts in front of a loop storing to every byte of [dest, dest+len). It
+  /// emits no code, so it writes nothing itself; it only stands for the
+  /// stores of the loop (which frame clearing may rely on, see
+  /// MachineFrameInfo::isLoopInitializedObjectIndex).
+  class InitializedInst : public IntrinsicInst {
+  public:
+    Value *getRawDest() const { return const_cast<Value*>(getArgOperand(0)); }
+    Value *getLength() const { return const_cast<Value*>(getArgOperand(1)); }
+
+    /// This is just like getRawDest, but it strips off any cast
+    /// instructions that feed it, giving the original input.
+    Value *getDest() const { return getRawDest()->stripPointerCasts(); }
+
+    void setDest(Value *Ptr) {
+      assert(getRawDest()->getType() == Ptr->getType() &&
+             "setDest called with pointer of wrong type!");
+      setArgOperand(0, Ptr);
+    }
+
+    void setLength(Value *L) {
+      assert(getLength()->getType() == L->getType() &&
+             "setLength called with value of wrong type!");
+      setArgOperand(1, L);
+    }
+
+    // Methods for support type inquiry through isa, cast, and dyn_cast:
+    static inline bool classof(const IntrinsicInst *I) {
+      return I->getIntrinsicID() == Intrinsic::initialized;
+    }
+    static inline bool classof(const Value *V) {
+      return isa<IntrinsicInst>(V) && classof(cast<IntrinsicInst>(V));
+    }
+  };
+
   /// This represents the llvm.va_start intrinsic.
   class VAStartInst : public IntrinsicInst {
   public:
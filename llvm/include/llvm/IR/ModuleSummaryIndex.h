@@ -235,6 +235,12 @@ private:
   /// List of <CalleeValueInfo, CalleeInfo> call edge pairs from this function.
   std::vector<EdgeTy> CallGraphEdgeList;
 
+  /// For each parameter, the number of bytes at the start of the memory it
+  /// points to which this function always writes before reading through it
+  /// (from the "safeinit-initializes" parameter attribute). Empty if there
+  /// are none.
+  std::vector<uint64_t> ParamInitSizes;
+
 public:
   /// Summary constructors.
   FunctionSummary(GVFlags Flags, unsigned NumInsts)
@@ -272,6 +278,15 @@ public:
   /// Return the list of <CalleeValueInfo, CalleeInfo> pairs.
   std::vector<EdgeTy> &calls() { return CallGraphEdgeList; }
   const std::vector<EdgeTy> &calls() const { return CallGraphEdgeList; }
+
+  /// Record the per-parameter init sizes for this function.
+  void setParamInitSizes(std::vector<uint64_t> Sizes) {
+    ParamInitSizes = std::move(Sizes);
+  }
+
+  /// Return the per-parameter init sizes (possibly shorter than the number
+  /// of parameters, the rest are 0).
+  ArrayRef<uint64_t> paramInitSizes() const { return ParamInitSizes; }
 };
 
 /// \brief Global variable summary information to aid decisions and
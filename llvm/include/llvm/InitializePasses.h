@@ -105,7 +105,7 @@ void initializeCrossDSOCFIPass(PassRegistry&);
 void initializeDAEPass(PassRegistry&);
 void initializeDAHPass(PassRegistry&);
 void initializeDCELegacyPassPass(PassRegistry&);
-void initializeDSEPass(PassRegistry&);
+void initializeDSELegacyPassPass(PassRegistry&);
 void initializeDeadInstEliminationPass(PassRegistry&);
 void initializeDeadMachineInstructionElimPass(PassRegistry&);
 void initializeDelinearizationPass(PassRegistry &);
@@ -336,8 +336,13 @@ void initializeFunctionImportPassPass(PassRegistry &);
 void initializeLoopVersioningPassPass(PassRegistry &);
 void initializeWholeProgramDevirtPass(PassRegistry &);
 void initializePatchableFunctionPass(PassRegistry &);
-void initializeSafeInitPass(PassRegistry &);
-void initializeSafeInitTrackerPass(PassRegistry &);
+void initializeSafeInitLegacyPassPass(PassRegistry &);
+void initializeHoistLifetimesPass(PassRegistry &);
+void initializeHybridPolicyPass(PassRegistry &);
+void initializeOutlineInitsPass(PassRegistry &);
+void initializeVersionInitsPass(PassRegistry &);
+void initializeMergeZeroStoresPass(PassRegistry &);
+void initializeSafeInitTrackerLegacyPassPass(PassRegistry &);
 }
 
 #endif
@@ -0,0 +1,69 @@
+//===- SafeInitAdvice.h - SafeInit advisor candidate lists ------*- C++ -*-===//
+//
+//                      The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains a reader for SafeInit advisor candidate lists, and the
+// names advisor builds give stack sites. An advisor build is an MSan build
+// (with -fsanitize-memory-track-origins and -msan-safeinit-sites) whose
+// reports name the stack site each uninitialized read came from;
+// utils/safeinit-advisor.py turns the reports of a test run into a list of
+// the sites which ran but were never read uninitialized. Each line is of the
+// form
+//
+//   <function> <site> [<count>]
+//
+// where count (how often the function's inits ran, from a SafeInit profile)
+// is informational. Lines starting with '#' are comments.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_PROFILEDATA_SAFEINITADVICE_H
+#define LLVM_PROFILEDATA_SAFEINITADVICE_H
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <string>
+
+namespace llvm {
+
+class AllocaInst;
+
+/// Returns the name advisor builds give the stack site of AI: the variable
+/// and line of its debug info ("buf:12"), or else its IR name. Returns "" if
+/// it has neither.
+std::string getSafeInitSiteName(const AllocaInst &AI);
+
+class SafeInitAdvice {
+public:
+  static ErrorOr<std::unique_ptr<SafeInitAdvice>> create(const Twine &Path);
+  static std::unique_ptr<SafeInitAdvice>
+  create(std::unique_ptr<MemoryBuffer> Buffer);
+
+  /// Returns true if the advisor found Site in FunctionName to be written
+  /// before it was ever read.
+  bool isCandidate(StringRef FunctionName, StringRef Site) const;
+
+  /// Returns true if any site in FunctionName is a candidate.
+  bool hasCandidates(StringRef FunctionName) const {
+    return Functions.count(FunctionName);
+  }
+
+private:
+  SafeInitAdvice() = default;
+
+  StringMap<StringSet<> > Functions;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_PROFILEDATA_SAFEINITADVICE_H
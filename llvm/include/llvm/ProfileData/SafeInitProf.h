@@ -0,0 +1,76 @@
+//===- SafeInitProf.h - SafeInit init-cost profiles -------------*- C++ -*-===//
+//
+//                      The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains a reader for SafeInit init-cost profiles, which are the
+// text output of sanstats for a binary built with -fsanitize=safeinit and
+// -fsanitize-stats (see SafeInitTracker). Each line is of the form
+//
+//   <file>:<line> <function> <kind> <count>
+//
+// where kind is safeinit-stack, safeinit-heap (executions of a zero-init) or
+// safeinit-bytes (bytes it cleared). Other kinds are ignored. Repeated
+// entries are summed, so profiles of several runs merge by concatenation.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_PROFILEDATA_SAFEINITPROF_H
+#define LLVM_PROFILEDATA_SAFEINITPROF_H
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+
+namespace llvm {
+
+class SafeInitProfile {
+public:
+  /// Measured zero-init costs of a single function.
+  struct FunctionRecord {
+    unsigned StackSites = 0;
+    uint64_t StackExecs = 0;
+    uint64_t StackBytes = 0;
+    unsigned HeapSites = 0;
+    uint64_t HeapExecs = 0;
+    uint64_t HeapBytes = 0;
+  };
+
+  /// Functions whose average stack init is at most this many bytes are
+  /// candidates for frame clearing.
+  static const uint64_t SmallInitBytes = 64;
+
+  /// Functions running fewer stack inits than 1/HotFraction of the hottest
+  /// function's are left to the global options.
+  static const uint64_t HotFraction = 100;
+
+  static ErrorOr<std::unique_ptr<SafeInitProfile>> create(const Twine &Path);
+  static std::unique_ptr<SafeInitProfile>
+  create(std::unique_ptr<MemoryBuffer> Buffer);
+
+  /// Returns the record for FunctionName, or null if it has none.
+  const FunctionRecord *getFunction(StringRef FunctionName) const;
+
+  /// Returns the "safeinit-policy" to use for FunctionName, or "" to keep the
+  /// global options: "frame" for hot functions running many small stack
+  /// inits (cheaper to clear with the frame), "ir" for hot ones with big
+  /// stack inits (partial memsets clear less than the whole frame).
+  StringRef getPolicy(StringRef FunctionName) const;
+
+private:
+  SafeInitProfile() = default;
+
+  StringMap<FunctionRecord> Functions;
+  uint64_t MaxStackExecs = 0;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_PROFILEDATA_SAFEINITPROF_H
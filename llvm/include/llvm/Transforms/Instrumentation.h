@@ -35,6 +35,7 @@ inline void *getDFSanRetValTLSPtrForJIT() {
 namespace llvm {
 
 class TargetMachine;
+class Pass;
 
 /// Instrumentation passes often insert conditional checks into entry blocks.
 /// Call this function before splitting the entry block to move instructions
@@ -109,8 +110,45 @@ ModulePass *createAddressSanitizerModulePass(bool CompileKernel = false,
 // Insert MemorySanitizer instrumentation (detection of uninitialized reads)
 FunctionPass *createMemorySanitizerPass(int TrackOrigins = 0);
 
+// Which allocas a SafeInit pass initializes: all of them, or, when the
+// pipeline is split, the static scalar ones (early, so that SROA promotes them
+// to zeroes) or the others (late, once inlining and SROA are done)
+enum class SafeInitAllocas { All, Scalar, Aggregate };
+
 // Insert SafeInit instrumentation
-FunctionPass *createSafeInitPass();
+FunctionPass *createSafeInitPass(SafeInitAllocas Which = SafeInitAllocas::All);
+
+// Shrink existing SafeInit memsets using callee summaries which weren't
+// available when they were inserted (for LTO)
+FunctionPass *createSafeInitRevisitPass();
+
+// Place the existing SafeInit inits of static allocas again, after inlining
+// has moved the allocas of callees into the caller (run after
+// createSafeInitHoistLifetimesPass)
+FunctionPass *createSafeInitReplacePass();
+
+// Hoist lifetimes of loop-scoped allocas out of loops (run before SafeInit)
+Pass *createSafeInitHoistLifetimesPass();
+
+// Choose, per function, between the remaining SafeInit inits and clearing
+// the frame in the prologue (run after optimization)
+FunctionPass *createSafeInitHybridPass();
+
+// Replace common SafeInit memsets with calls to shared out-of-line zeroing
+// functions (run after optimization)
+ModulePass *createSafeInitOutlinePass();
+
+// Give variable-size SafeInit memsets an inline fast path for the small sizes
+// ScalarEvolution can bound them to (run after optimization)
+FunctionPass *createSafeInitVersionPass();
+
+// Merge the zero stores to allocas which trimmed and split inits leave behind
+// into wide vector stores (run after optimization)
+FunctionPass *createSafeInitMergeStoresPass();
+
+// Report on the SafeInit memsets left after optimization, and (with
+// Counters) count how often they run and how many bytes they clear
+ModulePass *createSafeInitTrackerPass(bool Counters = false);
 
 // Insert ThreadSanitizer (race detection) instrumentation
 FunctionPass *createThreadSanitizerPass();
@@ -0,0 +1,55 @@
+//===- Transforms/SafeInit.h - SafeInit passes ------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file provides the new pass manager interface for the SafeInit
+/// instrumentation pass and its tracker.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRANSFORMS_SAFEINIT_H
+#define LLVM_TRANSFORMS_SAFEINIT_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Instrumentation.h"
+#include <memory>
+
+namespace llvm {
+
+class SafeInitAdvice;
+class SafeInitProfile;
+
+/// Zero-initializes allocas (and heap allocations), see createSafeInitPass.
+/// It keeps the dominator tree and loop info up to date, so the passes after
+/// it needn't recompute them.
+class SafeInitPass : public PassInfoMixin<SafeInitPass> {
+public:
+  explicit SafeInitPass(SafeInitAllocas Which = SafeInitAllocas::All);
+  PreservedAnalyses run(Function &F, AnalysisManager<Function> &AM);
+
+private:
+  SafeInitAllocas Which;
+  // The profile and advice files, read once for every function.
+  std::shared_ptr<SafeInitProfile> Profile;
+  std::shared_ptr<SafeInitAdvice> Advice;
+};
+
+/// Reports on the SafeInit memsets left after optimization, see
+/// createSafeInitTrackerPass.
+class SafeInitTrackerPass : public PassInfoMixin<SafeInitTrackerPass> {
+public:
+  explicit SafeInitTrackerPass(bool Counters = false) : Counters(Counters) {}
+  PreservedAnalyses run(Module &M, AnalysisManager<Module> &AM);
+
+private:
+  bool Counters;
+};
+
+} // End llvm namespace
+
+#endif
@@ -110,6 +110,11 @@ private:
   AssumptionCache *AC;
   SetVector<BasicBlock *> DeadBlocks;
 
+  /// The byte allocations are known to be filled with (zero, unless in
+  /// SafeInit's pattern-init mode), or -1; see
+  /// TargetLibraryInfo::getMallocFillByte.
+  int MallocFillByte;
+
   ValueTable VN;
 
   /// A mapping from value numbers to lists of Value*'s that
@@ -307,6 +307,10 @@ bool removeUnreachableBlocks(Function &F, LazyValueInfo *LVI = nullptr);
 /// Metadata not listed as known via KnownIDs is removed
 void combineMetadata(Instruction *K, const Instruction *J, ArrayRef<unsigned> KnownIDs);
 
+/// Copy SafeInit's zero-init metadata (!stackzeroinit or !heapzeroinit) from
+/// From to To, which does all or part of From's initialization.
+void copyZeroInitMetadata(const Instruction *From, Instruction *To);
+
 /// Replace each use of 'From' with 'To' if that use is dominated by
 /// the given edge.  Returns the number of replacements made.
 unsigned replaceDominatedUsesWith(Value *From, Value *To, DominatorTree &DT,
@@ -20,7 +20,7 @@ namespace llvm {
 
 // Number of bits in data that are used for the sanitizer kind. Needs to match
 // __sanitizer::kKindBits in compiler-rt/lib/stats/stats.h
-enum { kSanitizerStatKindBits = 3 };
+enum { kSanitizerStatKindBits = 4 };
 
 enum SanitizerStatKind {
   SanStat_CFI_VCall,
@@ -28,6 +28,10 @@ enum SanitizerStatKind {
   SanStat_CFI_DerivedCast,
   SanStat_CFI_UnrelatedCast,
   SanStat_CFI_ICall,
+  SanStat_SafeInit_Stack,
+  SanStat_SafeInit_Heap,
+  SanStat_SafeInit_Bytes,
+  SanStat_SafeInit_Lines,
 };
 
 struct SanitizerStatReport {
@@ -37,6 +41,14 @@ struct SanitizerStatReport {
   /// with the given sanitizer kind SK.
   void create(IRBuilder<> &B, SanitizerStatKind SK);
 
+  /// Like create, but also adds each value in Counts to a counter of its own
+  /// for the same location, tagged with the kind it comes with.  (Those are
+  /// updated inline, and not atomically, so they may miss a few when threads
+  /// race.)
+  void createWithCounts(
+      IRBuilder<> &B, SanitizerStatKind SK,
+      ArrayRef<std::pair<SanitizerStatKind, Value *>> Counts);
+
   /// Finalize module stats array and add global constructor to register it.
   void finish();
 
@@ -47,6 +59,7 @@ private:
   StructType *EmptyModuleStatsTy;
 
   std::vector<Constant *> Inits;
+  Constant *addInit(IntegerType *IntPtrTy, SanitizerStatKind SK);
   ArrayType *makeModuleStatsArrayTy();
   StructType *makeModuleStatsTy();
 };
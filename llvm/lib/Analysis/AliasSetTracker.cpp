@@ -369,9 +369,8 @@ bool AliasSetTracker::add(MemSetInst *MSI) {
 bool AliasSetTracker::addUnknown(Instruction *Inst) {
   if (isa<DbgInfoIntrinsic>(Inst)) 
     return true; // Ignore DbgInfo Intrinsics.
-  if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(Inst))
-    if (II->getIntrinsicID() == Intrinsic::initialized)
-      return true;
+  if (isa<InitializedInst>(Inst))
+    return true; // Stores nothing; the loop it marks has the real stores.
 
   if (!Inst->mayReadOrWriteMemory())
     return true; // doesn't alias anything
@@ -65,6 +65,13 @@ static cl::opt<int> ColdThreshold(
     "inlinecold-threshold", cl::Hidden, cl::init(225),
     cl::desc("Threshold for inlining functions with cold attribute"));
 
+// SafeInit's memsets of callee allocas are mostly dead once the callee is
+// inlined (the caller's stores or inits cover them), so small ones shouldn't
+// keep helpers from being inlined.
+static cl::opt<unsigned> SafeInitFreeMemSetSize(
+    "inline-safeinit-memset-size", cl::Hidden, cl::init(128),
+    cl::desc("Largest SafeInit memset (in bytes) which is free to inline"));
+
 namespace {
 
 class CallAnalyzer : public InstVisitor<CallAnalyzer, bool> {
@@ -910,6 +917,12 @@ bool CallAnalyzer::visitCallSite(CallSite CS) {
         return false;
 
       case Intrinsic::memset:
+        if (II->getMetadata("stackzeroinit")) {
+          auto *Len = dyn_cast<ConstantInt>(cast<MemSetInst>(II)->getLength());
+          if (Len && Len->getZExtValue() <= SafeInitFreeMemSetSize)
+            return true;
+        }
+        // Fall through.
       case Intrinsic::memcpy:
       case Intrinsic::memmove:
         // SROA can usually chew through these intrinsics, but they aren't free.
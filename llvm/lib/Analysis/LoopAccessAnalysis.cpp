@@ -20,6 +20,7 @@
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Analysis/VectorUtils.h"
@@ -1490,6 +1491,11 @@ void LoopAccessInfo::analyzeLoop(const ValueToValueMap &Strides) {
     for (BasicBlock::iterator it = (*bb)->begin(), e = (*bb)->end(); it != e;
          ++it) {
 
+      // llvm.initialized markers (left in the body once the loop they mark is
+      // unrolled) store nothing themselves.
+      if (isa<InitializedInst>(it))
+        continue;
+
       // If this is a load, save it. If this instruction can read from memory
       // but is not a load, then we quit. Notice that we don't handle function
       // calls that read or write.
@@ -37,7 +37,8 @@ enum AllocType : uint8_t {
   CallocLike         = 1<<2, // allocates + bzero
   ReallocLike        = 1<<3, // reallocates
   StrDupLike         = 1<<4,
-  AllocLike          = MallocLike | CallocLike | StrDupLike,
+  AlignedAllocLike   = 1<<5, // allocates aligned memory
+  AllocLike          = MallocLike | CallocLike | StrDupLike | AlignedAllocLike,
   AnyAlloc           = AllocLike | ReallocLike
 };
 
@@ -52,7 +53,8 @@ struct AllocFnsTy {
 // know which functions are nounwind, noalias, nocapture parameters, etc.
 static const std::pair<LibFunc::Func, AllocFnsTy> AllocationFnData[] = {
   {LibFunc::malloc,              {MallocLike,  1, 0,  -1}},
-  {LibFunc::valloc,              {MallocLike,  1, 0,  -1}},
+  {LibFunc::valloc,              {AlignedAllocLike, 1, 0, -1}},
+  {LibFunc::memalign,            {AlignedAllocLike, 2, 1, -1}},
   {LibFunc::Znwj,                {OpNewLike,   1, 0,  -1}}, // new(unsigned int)
   {LibFunc::ZnwjRKSt9nothrow_t,  {MallocLike,  2, 0,  -1}}, // new(unsigned int, nothrow)
   {LibFunc::Znwm,                {OpNewLike,   1, 0,  -1}}, // new(unsigned long)
@@ -202,6 +204,21 @@ bool llvm::isCallocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
   return getAllocationData(V, CallocLike, TLI, LookThroughBitCast).hasValue();
 }
 
+/// \brief Tests if a value is a call or invoke to a function marked
+/// "safeinit-zeroed-return" (such as a calloc wrapper).
+bool llvm::returnsZeroedMemory(const Value *V, bool LookThroughBitCast) {
+  ImmutableCallSite CS(LookThroughBitCast ? V->stripPointerCasts() : V);
+  return CS && CS.hasFnAttr("safeinit-zeroed-return");
+}
+
+/// \brief Tests if a value is a call or invoke to a library function that
+/// allocates aligned, uninitialized memory (such as memalign).
+bool llvm::isAlignedAllocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
+                                bool LookThroughBitCast) {
+  return getAllocationData(V, AlignedAllocLike, TLI, LookThroughBitCast)
+      .hasValue();
+}
+
 /// \brief Tests if a value is a call or invoke to a library function that
 /// allocates memory (either malloc, calloc, or strdup like).
 bool llvm::isAllocLikeFn(const Value *V, const TargetLibraryInfo *TLI,
@@ -390,6 +407,29 @@ bool llvm::getObjectSize(const Value *Ptr, uint64_t &Size, const DataLayout &DL,
   return true;
 }
 
+int llvm::getInitialAllocatedByte(const Value *Alloc, int64_t Offset,
+                                  int MallocFillByte, const DataLayout &DL,
+                                  const TargetLibraryInfo *TLI) {
+  if (isCallocLikeFn(Alloc, TLI) || returnsZeroedMemory(Alloc))
+    return 0;
+  if (MallocFillByte < 0)
+    return -1;
+  if (isMallocLikeFn(Alloc, TLI))
+    return MallocFillByte;
+  // (the allocator zeroes these even where it fills malloc with a pattern)
+  if (isAlignedAllocLikeFn(Alloc, TLI))
+    return 0;
+  if (Offset < 0 || !getAllocationData(Alloc, ReallocLike, TLI))
+    return -1;
+
+  const Value *Old = ImmutableCallSite(Alloc).getArgument(0);
+  uint64_t OldSize = 0;
+  if (!isa<ConstantPointerNull>(Old->stripPointerCasts()) &&
+      !getObjectSize(Old, OldSize, DL, TLI))
+    return -1;
+  return (uint64_t)Offset >= OldSize ? MallocFillByte : -1;
+}
+
 STATISTIC(ObjectVisitorArgument,
           "Number of arguments with unsolved size and offset");
 STATISTIC(ObjectVisitorLoad,
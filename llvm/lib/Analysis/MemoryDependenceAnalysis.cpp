@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Analysis/MemoryDependenceAnalysis.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -23,6 +24,7 @@
 #include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/PHITransAddr.h"
 #include "llvm/Analysis/OrderedBasicBlock.h"
+#include "llvm/Analysis/SafeInitTiming.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/IR/DataLayout.h"
@@ -48,6 +50,10 @@ STATISTIC(NumCacheDirtyNonLocalPtr,
 STATISTIC(NumUncacheNonLocalPtr, "Number of uncached non-local ptr responses");
 STATISTIC(NumCacheCompleteNonLocalPtr,
           "Number of block queries that were completely cached");
+STATISTIC(NumSkippedZeroInits,
+          "Number of SafeInit zero-inits of other objects scanned past");
+STATISTIC(NumZeroInitQueries,
+          "Number of uncached queries for SafeInit zero-inits");
 
 // Limit for the number of instructions to scan in a block.
 
@@ -64,6 +70,22 @@ static cl::opt<unsigned>
 // Limit on the number of memdep results to process.
 static const unsigned int NumResultsLimit = 100;
 
+/// Returns true if Inst is a SafeInit zero-init memset.
+static bool isZeroInitMemSet(const Instruction *Inst) {
+  return isa<MemSetInst>(Inst) && (Inst->getMetadata("stackzeroinit") ||
+                                   Inst->getMetadata("heapzeroinit"));
+}
+
+/// Returns the object cleared by Inst if it is a SafeInit zero-init memset of
+/// a whole identified object, or null otherwise.
+static const Value *getZeroInitObject(const Instruction *Inst) {
+  if (!isZeroInitMemSet(Inst))
+    return nullptr;
+  const MemSetInst *MSI = cast<MemSetInst>(Inst);
+  const Value *Dest = MSI->getRawDest()->stripPointerCasts();
+  return isIdentifiedObject(Dest) ? Dest : nullptr;
+}
+
 /// This is a helper function that removes Val from 'Inst's set in ReverseMap.
 ///
 /// If the set becomes empty, remove Inst's entry.
@@ -148,7 +170,9 @@ static ModRefInfo GetLocation(const Instruction *Inst, MemoryLocation &Loc,
       // will allow them to be handled conservatively.
       return MRI_Mod;
     case Intrinsic::initialized:
-      // XXX Alyssa: make sure this is ok
+      // The loop following the marker stores to all of [dest, dest+len)
+      // before anything reads it, so it's a write of that range.
+      Loc = MemoryLocation::getForDest(cast<InitializedInst>(II));
       return MRI_Mod;
     default:
       break;
@@ -446,6 +470,13 @@ MemDepResult MemoryDependenceResults::getSimplePointerDependencyFrom(
 
   const DataLayout &DL = BB->getModule()->getDataLayout();
 
+  // With SafeInit, blocks (the entry block in particular) hold a zero-init
+  // memset for nearly every alloca and heap allocation. When the query is on
+  // an identified object, those of other identified objects can't alias it.
+  const Value *QueryObj = GetUnderlyingObject(MemLoc.Ptr, DL);
+  if (!isIdentifiedObject(QueryObj))
+    QueryObj = nullptr;
+
   // Create a numbered basic block to lazily compute and cache instruction
   // positions inside a BB. This is used to provide fast queries for relative
   // position between two instructions in a BB and can be used by
@@ -477,10 +508,21 @@ MemDepResult MemoryDependenceResults::getSimplePointerDependencyFrom(
       if (isa<DbgInfoIntrinsic>(II))
         continue;
 
-    // XXX Alyssa: think about this also
-    if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(Inst))
-      if (II->getIntrinsicID() == Intrinsic::initialized)
+    // llvm.initialized stores nothing itself, and the loop storing to its
+    // range comes after it, so nothing before that loop depends on it.
+    if (isa<InitializedInst>(Inst))
+      continue;
+
+    // Skip zero-inits of other objects without an alias query, and without
+    // counting them against the scan limit so that SafeInit doesn't make us
+    // give up on blocks we would otherwise have scanned in full.
+    if (QueryObj) {
+      const Value *ZeroInitObj = getZeroInitObject(Inst);
+      if (ZeroInitObj && ZeroInitObj != QueryObj) {
+        ++NumSkippedZeroInits;
         continue;
+      }
+    }
 
     // Limit the amount of scanning we do so we don't end up with quadratic
     // running time on extreme testcases.
@@ -695,6 +737,13 @@ MemDepResult MemoryDependenceResults::getDependency(Instruction *QueryInst) {
   if (!LocalCache.isDirty())
     return LocalCache;
 
+  Optional<SafeInitTimeRegion> ZeroInitQuery;
+  if (isZeroInitMemSet(QueryInst)) {
+    ++NumZeroInitQueries;
+    ZeroInitQuery.emplace("MemDep queries for SafeInit memsets",
+                          *QueryInst->getFunction());
+  }
+
   // Otherwise, if we have a dirty entry, we know we can start the scan at that
   // instruction, which may save us some work.
   if (Instruction *Inst = LocalCache.getInst()) {
@@ -895,6 +944,13 @@ void MemoryDependenceResults::getNonLocalPointerDependency(
          "Can't get pointer deps of a non-pointer!");
   Result.clear();
 
+  Optional<SafeInitTimeRegion> ZeroInitQuery;
+  if (isZeroInitMemSet(QueryInst)) {
+    ++NumZeroInitQueries;
+    ZeroInitQuery.emplace("MemDep queries for SafeInit memsets",
+                          *QueryInst->getFunction());
+  }
+
   // This routine does not expect to deal with volatile instructions.
   // Doing so would require piping through the QueryInst all the way through.
   // TODO: volatiles can't be elided, but they can be reordered with other
@@ -90,6 +90,17 @@ MemoryLocation MemoryLocation::getForDest(const MemIntrinsic *MTI) {
   return MemoryLocation(MTI->getRawDest(), Size, AATags);
 }
 
+MemoryLocation MemoryLocation::getForDest(const InitializedInst *II) {
+  uint64_t Size = UnknownSize;
+  if (ConstantInt *C = dyn_cast<ConstantInt>(II->getLength()))
+    Size = C->getValue().getZExtValue();
+
+  AAMDNodes AATags;
+  II->getAAMetadata(AATags);
+
+  return MemoryLocation(II->getRawDest(), Size, AATags);
+}
+
 MemoryLocation MemoryLocation::getForArgument(ImmutableCallSite CS,
                                               unsigned ArgIdx,
                                               const TargetLibraryInfo &TLI) {
@@ -107,13 +118,16 @@ MemoryLocation MemoryLocation::getForArgument(ImmutableCallSite CS,
     case Intrinsic::memset:
     case Intrinsic::memcpy:
     case Intrinsic::memmove:
-    case Intrinsic::initialized:
       assert((ArgIdx == 0 || ArgIdx == 1) &&
              "Invalid argument index for memory intrinsic");
       if (ConstantInt *LenCI = dyn_cast<ConstantInt>(II->getArgOperand(2)))
         return MemoryLocation(Arg, LenCI->getZExtValue(), AATags);
       break;
 
+    case Intrinsic::initialized:
+      assert(ArgIdx == 0 && "Invalid argument index");
+      return getForDest(cast<InitializedInst>(II));
+
     case Intrinsic::lifetime_start:
     case Intrinsic::lifetime_end:
     case Intrinsic::invariant_start:
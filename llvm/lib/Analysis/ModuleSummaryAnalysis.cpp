@@ -101,6 +101,18 @@ void ModuleSummaryIndexBuilder::computeFunctionSummary(
       llvm::make_unique<FunctionSummary>(Flags, NumInsts);
   FuncSummary->addCallGraphEdges(CallGraphEdges);
   FuncSummary->addRefEdges(RefEdges);
+
+  std::vector<uint64_t> ParamInitSizes;
+  for (unsigned I = 0, E = F.arg_size(); I != E; ++I) {
+    Attribute A = F.getAttributes().getAttribute(I + 1, "safeinit-initializes");
+    uint64_t Bytes = 0;
+    if (A.isStringAttribute() && A.getValueAsString().getAsInteger(10, Bytes))
+      Bytes = 0;
+    ParamInitSizes.push_back(Bytes);
+  }
+  while (!ParamInitSizes.empty() && !ParamInitSizes.back())
+    ParamInitSizes.pop_back();
+  FuncSummary->setParamInitSizes(std::move(ParamInitSizes));
   Index->addGlobalValueSummary(F.getName(), std::move(FuncSummary));
 }
 
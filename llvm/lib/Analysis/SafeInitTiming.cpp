@@ -0,0 +1,110 @@
+//===-- SafeInitTiming.cpp - SafeInit compile time ------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the timers behind the -time-passes breakdown of the
+// compile time SafeInit costs, and the list of the functions it costs most.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/SafeInitTiming.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+using namespace llvm;
+
+static cl::opt<unsigned> TopFunctions(
+    "safeinit-time-report-functions", cl::init(10), cl::Hidden,
+    cl::desc("Number of functions to list with -time-passes, by the time "
+             "spent on SafeInit and its inits in them (default = 10)"));
+
+static const char *const TimerGroupName = "SafeInit";
+
+namespace {
+/// The wall time charged to each function so far.
+struct FunctionTimes {
+  sys::SmartMutex<true> Lock;
+  StringMap<double> Seconds;
+
+  ~FunctionTimes() {
+    if (!Seconds.empty())
+      print(*CreateInfoOutputFile());
+  }
+
+  void print(raw_ostream &OS);
+};
+}
+
+static ManagedStatic<FunctionTimes> Times;
+
+// How many regions the current thread is in.
+static LLVM_THREAD_LOCAL unsigned Depth;
+
+void FunctionTimes::print(raw_ostream &OS) {
+  std::vector<std::pair<double, StringRef> > Sorted;
+  double Total = 0;
+  for (auto &Entry : Seconds) {
+    Sorted.push_back(std::make_pair(Entry.getValue(), Entry.getKey()));
+    Total += Entry.getValue();
+  }
+  size_t N = std::min<size_t>(TopFunctions, Sorted.size());
+  std::partial_sort(Sorted.begin(), Sorted.begin() + N, Sorted.end(),
+                    std::greater<std::pair<double, StringRef> >());
+
+  OS << "===" << std::string(73, '-') << "===\n"
+     << "                  SafeInit time by function (top " << N << ")\n"
+     << "===" << std::string(73, '-') << "===\n"
+     << format("  Total: %.4f seconds in %u functions\n\n", Total,
+               unsigned(Sorted.size()))
+     << "   ---Wall Time---  --- Name ---\n";
+  for (size_t i = 0; i != N; ++i)
+    OS << format("  %7.4f (%5.1f%%)  ", Sorted[i].first,
+                 Total ? 100 * Sorted[i].first / Total : 0.0)
+       << Sorted[i].second << '\n';
+  OS << '\n';
+  OS.flush();
+  Seconds.clear();
+}
+
+SafeInitTimeRegion::SafeInitTimeRegion(StringRef Name, const Function &F)
+    : ChargedF(nullptr), Start(0) {
+  if (!TimePassesIsEnabled)
+    return;
+  T.reset(new NamedRegionTimer(Name, TimerGroupName));
+  if (Depth++ == 0) {
+    ChargedF = &F;
+    Start = TimeRecord::getCurrentTime(true).getWallTime();
+  }
+}
+
+SafeInitTimeRegion::~SafeInitTimeRegion() {
+  if (!T)
+    return;
+  if (ChargedF) {
+    double Elapsed = TimeRecord::getCurrentTime(false).getWallTime() - Start;
+    sys::SmartScopedLock<true> L(Times->Lock);
+    Times->Seconds[ChargedF->getName()] += Elapsed;
+  }
+  --Depth;
+}
+
+void llvm::printSafeInitFunctionTimes(raw_ostream &OS) {
+  sys::SmartScopedLock<true> L(Times->Lock);
+  if (!Times->Seconds.empty())
+    Times->print(OS);
+}
@@ -13,9 +13,20 @@
 
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/Support/CommandLine.h"
 using namespace llvm;
 
+static cl::opt<bool> ClMallocReturnsZero(
+    "malloc-returns-zero", cl::init(false),
+    cl::desc("Assume malloc and operator new return zeroed memory, as if "
+             "every module had the malloc-returns-zero flag"));
+
+static cl::opt<int> ClMallocFillByte(
+    "malloc-fill-byte", cl::init(-1),
+    cl::desc("Assume malloc and operator new return memory filled with this "
+             "byte, as if every module had the malloc-fill-byte flag"));
+
 static cl::opt<TargetLibraryInfoImpl::VectorLibrary> ClVectorLibrary(
     "vector-library", cl::Hidden, cl::desc("Vector functions library"),
     cl::init(TargetLibraryInfoImpl::NoLibrary),
@@ -671,6 +682,8 @@ bool TargetLibraryInfoImpl::isValidProtoForLibFunc(const FunctionType &FTy,
             FTy.getReturnType()->isPointerTy());
   case LibFunc::read:
     return (NumParams == 3 && FTy.getParamType(1)->isPointerTy());
+  case LibFunc::recv:
+    return (NumParams == 4 && FTy.getParamType(1)->isPointerTy());
   case LibFunc::rewind:
     return (NumParams >= 1 && FTy.getParamType(0)->isPointerTy());
   case LibFunc::rmdir:
@@ -1132,6 +1145,23 @@ StringRef TargetLibraryInfoImpl::getScalarizedFunction(StringRef F,
   return I->ScalarFnName;
 }
 
+int TargetLibraryInfo::getMallocFillByte(const Module &M) const {
+  if (ClMallocFillByte >= 0)
+    return ClMallocFillByte & 0xff;
+  if (ClMallocReturnsZero)
+    return 0;
+  if (auto *Flag = mdconst::extract_or_null<ConstantInt>(
+          M.getModuleFlag("malloc-fill-byte")))
+    return Flag->getZExtValue() & 0xff;
+  auto *Flag = mdconst::extract_or_null<ConstantInt>(
+      M.getModuleFlag("malloc-returns-zero"));
+  return Flag && !Flag->isZero() ? 0 : -1;
+}
+
+bool TargetLibraryInfo::mallocReturnsZero(const Module &M) const {
+  return getMallocFillByte(M) == 0;
+}
+
 TargetLibraryInfo TargetLibraryAnalysis::run(Module &M) {
   if (PresetInfoImpl)
     return TargetLibraryInfo(*PresetInfoImpl);
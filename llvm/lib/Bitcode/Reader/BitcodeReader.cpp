@@ -6082,6 +6082,7 @@ std::error_code ModuleSummaryIndexBitcodeReader::parseEntireSummary() {
       }
       auto GUID = getGUIDFromValueId(ValueID);
       FS->setOriginalName(GUID.second);
+      LastSeenSummary = FS.get();
       TheIndex->addGlobalValueSummary(GUID.first, std::move(FS));
       break;
     }
@@ -6227,6 +6228,15 @@ std::error_code ModuleSummaryIndexBitcodeReader::parseEntireSummary() {
       LastSeenSummary->setOriginalName(OriginalName);
       // Reset the LastSeenSummary
       LastSeenSummary = nullptr;
+      break;
+    }
+    // FS_PARAM_INITS: [n x bytes]
+    case bitc::FS_PARAM_INITS: {
+      auto *FS = dyn_cast_or_null<FunctionSummary>(LastSeenSummary);
+      if (!FS)
+        return error("Param inits that do not follow a function record");
+      FS->setParamInitSizes(std::vector<uint64_t>(Record.begin(), Record.end()));
+      break;
     }
     }
   }
@@ -3187,6 +3187,9 @@ void ModuleBitcodeWriter::writePerModuleFunctionSummaryRecord(
   // Emit the finished record.
   Stream.EmitRecord(Code, NameVals, FSAbbrev);
   NameVals.clear();
+
+  if (!FS->paramInitSizes().empty())
+    Stream.EmitRecord(bitc::FS_PARAM_INITS, FS->paramInitSizes());
 }
 
 // Collect the global value references in the given variable's initializer,
@@ -3442,6 +3445,8 @@ void IndexBitcodeWriter::writeCombinedGlobalValueSummary() {
     // Emit the finished record.
     Stream.EmitRecord(Code, NameVals, FSAbbrev);
     NameVals.clear();
+    if (!FS->paramInitSizes().empty())
+      Stream.EmitRecord(bitc::FS_PARAM_INITS, FS->paramInitSizes());
     MaybeEmitOriginalName(*S);
   }
 
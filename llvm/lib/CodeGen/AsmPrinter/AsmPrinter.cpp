@@ -37,9 +37,12 @@
 #include "llvm/MC/MCExpr.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/MC/MCSection.h"
+#include "llvm/MC/MCSectionELF.h"
 #include "llvm/MC/MCStreamer.h"
 #include "llvm/MC/MCSymbolELF.h"
 #include "llvm/MC/MCValue.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ELF.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
@@ -62,6 +65,11 @@ static const char *const CodeViewLineTablesGroupName = "CodeView Line Tables";
 
 STATISTIC(EmittedInsts, "Number of machine instrs printed");
 
+static cl::opt<bool> SafeInitSizeSection(
+    "safeinit-size-section", cl::Hidden, cl::init(false),
+    cl::desc("Record the bytes of SafeInit and frame clearing code in each "
+             "function in a .llvm_safeinit_sizes section (ELF only)"));
+
 char AsmPrinter::ID = 0;
 
 typedef DenseMap<GCStrategy*, std::unique_ptr<GCMetadataPrinter>> gcp_map_type;
@@ -845,6 +853,22 @@ void AsmPrinter::EmitFunctionBody() {
 
   bool ShouldPrintDebugScopes = MMI->hasDebugInfo();
 
+  // Runs of instructions flagged as init code are bracketed by labels, if
+  // their size is to be recorded. Instructions which emit nothing don't end a
+  // run, but block boundaries do (so alignment padding isn't counted).
+  bool RecordSafeInit =
+      SafeInitSizeSection && MAI->hasDotTypeDotSizeDirective();
+  SmallVector<std::pair<MCSymbol *, MCSymbol *>, 4> SafeInitRanges;
+  MCSymbol *SafeInitBegin = nullptr;
+  auto EndSafeInitRange = [&]() {
+    if (!SafeInitBegin)
+      return;
+    MCSymbol *SafeInitEnd = createTempSymbol("safeinit_end");
+    OutStreamer->EmitLabel(SafeInitEnd);
+    SafeInitRanges.push_back(std::make_pair(SafeInitBegin, SafeInitEnd));
+    SafeInitBegin = nullptr;
+  };
+
   // Print out code for the function.
   bool HasAnyRealCode = false;
   for (auto &MBB : *MF) {
@@ -852,6 +876,16 @@ void AsmPrinter::EmitFunctionBody() {
     EmitBasicBlockStart(MBB);
     for (auto &MI : MBB) {
 
+      if (RecordSafeInit && !MI.isPosition() && !MI.isImplicitDef() &&
+          !MI.isKill() && !MI.isDebugValue()) {
+        if (!MI.getFlag(MachineInstr::SafeInit)) {
+          EndSafeInitRange();
+        } else if (!SafeInitBegin) {
+          SafeInitBegin = createTempSymbol("safeinit_begin");
+          OutStreamer->EmitLabel(SafeInitBegin);
+        }
+      }
+
       // Print the assembly for the instruction.
       if (!MI.isPosition() && !MI.isImplicitDef() && !MI.isKill() &&
           !MI.isDebugValue()) {
@@ -912,6 +946,7 @@ void AsmPrinter::EmitFunctionBody() {
       }
     }
 
+    EndSafeInitRange();
     EmitBasicBlockEnd(MBB);
   }
 
@@ -962,6 +997,9 @@ void AsmPrinter::EmitFunctionBody() {
       OutStreamer->emitELFSize(Sym, SizeExp);
   }
 
+  if (RecordSafeInit)
+    emitSafeInitSizes(SafeInitRanges);
+
   for (const HandlerInfo &HI : Handlers) {
     NamedRegionTimer T(HI.TimerName, HI.TimerGroupName, TimePassesIsEnabled);
     HI.Handler->markFunctionEnd();
@@ -980,6 +1018,50 @@ void AsmPrinter::EmitFunctionBody() {
   OutStreamer->AddBlankLine();
 }
 
+/// Each function's entry in .llvm_safeinit_sizes is
+///   uint32 bytes of init code, uint32 bytes of code, function name (asciz),
+/// so llvm-objdump -safeinit-sizes can report both per function and in total.
+/// The section isn't allocated, and is in the function's group if it has one,
+/// so linked binaries hold one entry for each function they keep.
+void AsmPrinter::emitSafeInitSizes(
+    ArrayRef<std::pair<MCSymbol *, MCSymbol *>> SafeInitRanges) {
+  const MCExpr *InitSize = nullptr;
+  for (const auto &Range : SafeInitRanges) {
+    const MCExpr *RangeSize = MCBinaryExpr::createSub(
+        MCSymbolRefExpr::create(Range.second, OutContext),
+        MCSymbolRefExpr::create(Range.first, OutContext), OutContext);
+    InitSize = InitSize ? MCBinaryExpr::createAdd(InitSize, RangeSize,
+                                                  OutContext)
+                        : RangeSize;
+  }
+  if (!InitSize)
+    InitSize = MCConstantExpr::create(0, OutContext);
+  const MCExpr *FnSize = MCBinaryExpr::createSub(
+      MCSymbolRefExpr::create(CurrentFnEnd, OutContext),
+      MCSymbolRefExpr::create(CurrentFnSymForSize, OutContext), OutContext);
+
+  unsigned Flags = 0;
+  StringRef Group;
+  if (auto *FnSection =
+          dyn_cast<MCSectionELF>(OutStreamer->getCurrentSectionOnly()))
+    if (const MCSymbolELF *GroupSym = FnSection->getGroup()) {
+      Flags |= ELF::SHF_GROUP;
+      Group = GroupSym->getName();
+    }
+
+  OutStreamer->PushSection();
+  OutStreamer->SwitchSection(OutContext.getELFSection(
+      ".llvm_safeinit_sizes", ELF::SHT_PROGBITS, Flags, 0, Group));
+  OutStreamer->AddComment("init code bytes");
+  OutStreamer->EmitValue(InitSize, 4);
+  OutStreamer->AddComment("code bytes");
+  OutStreamer->EmitValue(FnSize, 4);
+  std::string Name = CurrentFnSym->getName();
+  Name.push_back('\0');
+  OutStreamer->EmitBytes(Name);
+  OutStreamer->PopSection();
+}
+
 /// \brief Compute the number of Global Variables that uses a Constant.
 static unsigned getNumGlobalVariableUses(const Constant *C) {
   if (!C)
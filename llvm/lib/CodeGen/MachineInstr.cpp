@@ -1855,7 +1855,7 @@ void MachineInstr::print(raw_ostream &OS, ModuleSlotTracker &MST,
   }
 
   bool HaveSemi = false;
-  const unsigned PrintableFlags = FrameSetup | FrameDestroy;
+  const unsigned PrintableFlags = FrameSetup | FrameDestroy | SafeInit;
   if (Flags & PrintableFlags) {
     if (!HaveSemi) {
       OS << ";";
@@ -1868,6 +1868,9 @@ void MachineInstr::print(raw_ostream &OS, ModuleSlotTracker &MST,
 
     if (Flags & FrameDestroy)
       OS << "FrameDestroy";
+
+    if (Flags & SafeInit)
+      OS << "SafeInit";
   }
 
   if (!memoperands_empty()) {
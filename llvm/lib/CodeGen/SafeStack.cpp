@@ -15,11 +15,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/Analysis/ScalarEvolution.h"
 #include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/IR/Constants.h"
@@ -61,6 +63,14 @@ static cl::opt<UnsafeStackPtrStorageVal> USPStorage("safe-stack-usp-storage",
                           "Non-thread-local storage"),
                clEnumValEnd));
 
+// SafeInit clears every unsafe alloca, each with its own memset. Once they
+// are all laid out on the unsafe stack, the ones cleared on entry can share a
+// single clear of the region of the unsafe frame they occupy instead.
+static cl::opt<bool> SafeInitBulkClear("safe-stack-safeinit-bulk-clear",
+    cl::Hidden, cl::init(true),
+    cl::desc("Merge SafeInit's entry inits of unsafe allocas into one clear "
+             "of the unsafe frame"));
+
 namespace llvm {
 
 STATISTIC(NumFunctions, "Total number of functions");
@@ -73,6 +83,8 @@ STATISTIC(NumUnsafeStaticAllocas, "Number of unsafe static allocas");
 STATISTIC(NumUnsafeDynamicAllocas, "Number of unsafe dynamic allocas");
 STATISTIC(NumUnsafeByValArguments, "Number of unsafe byval arguments");
 STATISTIC(NumUnsafeStackRestorePoints, "Number of setjmps and landingpads");
+STATISTIC(NumSafeInitBulkClears, "Number of SafeInit inits merged into "
+                                 "unsafe frame clears");
 
 } // namespace llvm
 
@@ -145,6 +157,12 @@ class SafeStack : public FunctionPass {
   /// size can not be statically determined.
   uint64_t getStaticAllocaAllocationSize(const AllocaInst* AI);
 
+  /// \brief Find the SafeInit inits of allocas in \p StaticAllocas which
+  /// clear the whole object in the entry block before anything else touches
+  /// it, and which all store the same value.
+  void findBulkSafeInits(Function &F, ArrayRef<AllocaInst *> StaticAllocas,
+                         SmallDenseMap<AllocaInst *, MemSetInst *, 8> &Inits);
+
   /// \brief Allocate space for all static allocas in \p StaticAllocas,
   /// replace allocas with pointers into the unsafe stack and generate code to
   /// restore the stack pointer before all return instructions in \p Returns.
@@ -505,6 +523,47 @@ void SafeStack::checkStackGuard(IRBuilder<> &IRB, Function &F, ReturnInst &RI,
   IRBFail.CreateCall(StackChkFail, {});
 }
 
+void SafeStack::findBulkSafeInits(
+    Function &F, ArrayRef<AllocaInst *> StaticAllocas,
+    SmallDenseMap<AllocaInst *, MemSetInst *, 8> &Inits) {
+  unsigned MDKind = F.getContext().getMDKindID("stackzeroinit");
+  SmallPtrSet<const Value *, 16> Unsafe(StaticAllocas.begin(),
+                                        StaticAllocas.end());
+  SmallPtrSet<const Value *, 16> Touched;
+  ConstantInt *Byte = nullptr;
+
+  for (Instruction &I : F.getEntryBlock()) {
+    if (isa<BitCastInst>(I) || isa<GetElementPtrInst>(I))
+      continue;
+    if (auto II = dyn_cast<IntrinsicInst>(&I))
+      if (II->getIntrinsicID() == Intrinsic::lifetime_start ||
+          II->getIntrinsicID() == Intrinsic::lifetime_end)
+        continue;
+
+    if (auto MSI = dyn_cast<MemSetInst>(&I)) {
+      auto AI = dyn_cast<AllocaInst>(MSI->getRawDest()->stripPointerCasts());
+      auto Len = dyn_cast<ConstantInt>(MSI->getLength());
+      auto Val = dyn_cast<ConstantInt>(MSI->getValue());
+      if (AI && Unsafe.count(AI) && !Touched.count(AI) && Len && Val &&
+          MSI->getMetadata(MDKind) && !MSI->isVolatile() &&
+          Len->getZExtValue() == getStaticAllocaAllocationSize(AI) &&
+          (!Byte || Byte == Val)) {
+        Byte = Val;
+        Inits[AI] = MSI;
+        Touched.insert(AI);
+        continue;
+      }
+    }
+
+    for (Value *Op : I.operands())
+      if (Op->getType()->isPointerTy()) {
+        Value *Obj = GetUnderlyingObject(Op, *DL);
+        if (Unsafe.count(Obj))
+          Touched.insert(Obj);
+      }
+  }
+}
+
 /// We explicitly compute and set the unsafe stack layout for all unsafe
 /// static alloca instructions. We save the unsafe "base pointer" in the
 /// prologue into a local variable and restore it in the epilogue.
@@ -588,8 +647,23 @@ Value *SafeStack::moveStaticAllocasToUnsafeStack(
     IRB.CreateMemCpy(Off, Arg, Size, Arg->getParamAlignment());
   }
 
+  // Lay out the allocas SafeInit clears on entry next to each other, so that
+  // a single memset of the range they span replaces their inits.
+  SmallDenseMap<AllocaInst *, MemSetInst *, 8> BulkInits;
+  if (SafeInitBulkClear)
+    findBulkSafeInits(F, StaticAllocas, BulkInits);
+  SmallVector<AllocaInst *, 16> Ordered(StaticAllocas.begin(),
+                                        StaticAllocas.end());
+  if (BulkInits.size() > 1)
+    std::stable_partition(Ordered.begin(), Ordered.end(),
+                          [&](AllocaInst *AI) { return BulkInits.count(AI); });
+  else
+    BulkInits.clear();
+  int64_t BulkStart = StaticOffset, BulkEnd = StaticOffset;
+  Value *BulkByte = nullptr;
+
   // Allocate space for every unsafe static AllocaInst on the unsafe stack.
-  for (AllocaInst *AI : StaticAllocas) {
+  for (AllocaInst *AI : Ordered) {
     IRB.SetInsertPoint(AI);
 
     Type *Ty = AI->getAllocatedType();
@@ -612,6 +686,14 @@ Value *SafeStack::moveStaticAllocasToUnsafeStack(
     if (AI->hasName() && isa<Instruction>(NewAI))
       cast<Instruction>(NewAI)->takeName(AI);
 
+    auto Init = BulkInits.find(AI);
+    if (Init != BulkInits.end()) {
+      BulkEnd = StaticOffset;
+      BulkByte = Init->second->getValue();
+      Init->second->eraseFromParent();
+      ++NumSafeInitBulkClears;
+    }
+
     // Replace alloc with the new location.
     replaceDbgDeclareForAlloca(AI, BasePointer, DIB, /*Deref=*/true, -StaticOffset);
     AI->replaceAllUsesWith(NewAI);
@@ -630,6 +712,18 @@ Value *SafeStack::moveStaticAllocasToUnsafeStack(
       IRB.CreateGEP(BasePointer, ConstantInt::get(Int32Ty, -StaticOffset),
                     "unsafe_stack_static_top");
   IRB.CreateStore(StaticTop, UnsafeStackPtr);
+
+  if (BulkByte) {
+    // BasePointer is aligned to at least MaxAlignment and StackAlignment.
+    unsigned Align = MinAlign(BulkEnd, std::max(MaxAlignment,
+                                                (unsigned)StackAlignment));
+    Value *Start = IRB.CreateGEP(BasePointer,
+                                 ConstantInt::get(Int32Ty, -BulkEnd));
+    CallInst *Clear =
+        IRB.CreateMemSet(Start, BulkByte, BulkEnd - BulkStart, Align);
+    Clear->setMetadata(F.getContext().getMDKindID("stackzeroinit"),
+                       MDNode::get(F.getContext(), None));
+  }
   return StaticTop;
 }
 
@@ -4728,7 +4728,8 @@ SDValue SelectionDAG::getMemmove(SDValue Chain, SDLoc dl, SDValue Dst,
 SDValue SelectionDAG::getMemset(SDValue Chain, SDLoc dl, SDValue Dst,
                                 SDValue Src, SDValue Size,
                                 unsigned Align, bool isVol, bool isTailCall,
-                                MachinePointerInfo DstPtrInfo) {
+                                MachinePointerInfo DstPtrInfo,
+                                bool isSafeInit) {
   assert(Align && "The SDAG layer expects explicit alignment and reserves 0");
 
   // Check to see if we should lower the memset to stores first.
@@ -4747,6 +4748,15 @@ SDValue SelectionDAG::getMemset(SDValue Chain, SDLoc dl, SDValue Dst,
       return Result;
   }
 
+  // SafeInit stack initialization gets its own target hook, since the
+  // target may prefer different trade-offs for these than for user memsets.
+  if (TSI && isSafeInit && !isVol) {
+    SDValue Result = TSI->EmitTargetCodeForSafeInitMemset(
+        *this, dl, Chain, Dst, Src, Size, Align, DstPtrInfo);
+    if (Result.getNode())
+      return Result;
+  }
+
   // Then check to see if we should lower the memset with target-specific
   // code. If the target chooses to do this, this is the next best.
   if (TSI) {
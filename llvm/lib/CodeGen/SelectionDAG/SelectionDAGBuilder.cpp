@@ -4699,6 +4699,48 @@ bool SelectionDAGBuilder::EmitFuncArgumentDbgValue(
 #  define setjmp_undefined_for_msvc
 #endif
 
+/// markLoopInitializedObject - If the llvm.initialized marker I covers a whole
+/// static alloca, and comes before anything in the entry block which could
+/// read it, the loop it precedes writes the alloca in full before it can be
+/// read: mark its frame object as such, so that frame clearing (e.g.
+/// X86FrameInit) can skip it.
+static void markLoopInitializedObject(const InitializedInst &I,
+                                      FunctionLoweringInfo &FuncInfo,
+                                      MachineFrameInfo &MFI,
+                                      const DataLayout &DL) {
+  const BasicBlock *BB = I.getParent();
+  if (BB != &BB->getParent()->getEntryBlock())
+    return;
+  int64_t Offset = 0;
+  const auto *AI = dyn_cast<AllocaInst>(
+      GetPointerBaseWithConstantOffset(I.getRawDest(), Offset, DL));
+  const auto *Len = dyn_cast<ConstantInt>(I.getLength());
+  if (!AI || Offset || !Len)
+    return;
+  auto SI = FuncInfo.StaticAllocaMap.find(AI);
+  if (SI == FuncInfo.StaticAllocaMap.end() ||
+      Len->getZExtValue() < uint64_t(MFI.getObjectSize(SI->second)))
+    return;
+
+  // Nothing can reach the alloca but through its address, so it's enough
+  // that no earlier instruction uses that (computing it aside).
+  for (const Instruction &Prev : *BB) {
+    if (&Prev == &I)
+      break;
+    if (isa<BitCastInst>(Prev) || isa<GetElementPtrInst>(Prev) ||
+        isa<DbgInfoIntrinsic>(Prev))
+      continue;
+    if (const auto *II = dyn_cast<IntrinsicInst>(&Prev))
+      if (II->getIntrinsicID() == Intrinsic::lifetime_start)
+        continue;
+    for (const Value *Op : Prev.operands())
+      if (Op->getType()->isPointerTy() &&
+          GetUnderlyingObject(Op, DL, /*MaxLookup=*/0) == AI)
+        return;
+  }
+  MFI.setObjectLoopInitialized(SI->second, true);
+}
+
 /// visitIntrinsicCall - Lower the call to the specified intrinsic function.  If
 /// we want to emit this as a call to a named external function, return the name
 /// otherwise lower it and return null.
@@ -4778,8 +4820,10 @@ SelectionDAGBuilder::visitIntrinsicCall(const CallInst &I, unsigned Intrinsic) {
       Align = 1; // @llvm.memset defines 0 and 1 to both mean no alignment.
     bool isVol = cast<ConstantInt>(I.getArgOperand(4))->getZExtValue();
     bool isTC = I.isTailCall() && isInTailCallPosition(&I, DAG.getTarget());
+    bool isSafeInit = I.getMetadata("stackzeroinit") != nullptr;
     SDValue MS = DAG.getMemset(getRoot(), sdl, Op1, Op2, Op3, Align, isVol,
-                               isTC, MachinePointerInfo(I.getArgOperand(0)));
+                               isTC, MachinePointerInfo(I.getArgOperand(0)),
+                               isSafeInit);
     updateDAGForMaybeTailCall(MS);
     return nullptr;
   }
@@ -5373,9 +5417,14 @@ SelectionDAGBuilder::visitIntrinsicCall(const CallInst &I, unsigned Intrinsic) {
     return nullptr;
   case Intrinsic::assume:
   case Intrinsic::var_annotation:
-  case Intrinsic::initialized:
     // Discard annotate attributes and assumptions
     return nullptr;
+  case Intrinsic::initialized:
+    // This emits nothing, but frame clearing can use what it tells us.
+    markLoopInitializedObject(cast<InitializedInst>(I), FuncInfo,
+                              *DAG.getMachineFunction().getFrameInfo(),
+                              DAG.getDataLayout());
+    return nullptr;
 
   case Intrinsic::init_trampoline: {
     const Function *F = cast<Function>(I.getArgOperand(1)->stripPointerCasts());
@@ -42,6 +42,7 @@
 #include "llvm/CodeGen/StackProtector.h"
 #include "llvm/CodeGen/WinEHFuncInfo.h"
 #include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
@@ -75,6 +76,10 @@ STATISTIC(NumMarkerSeen,  "Number of lifetime markers found.");
 STATISTIC(StackSpaceSaved, "Number of bytes saved due to merging slots.");
 STATISTIC(StackSlotMerged, "Number of stack slot merged.");
 STATISTIC(EscapedAllocas, "Number of allocas that escaped the lifetime region");
+STATISTIC(EarlyStoreRanges, "Number of ranges extended back to a store just "
+                            "before their start");
+STATISTIC(FrameSizeBefore, "Number of bytes in stack slots before merging.");
+STATISTIC(FrameSizeAfter, "Number of bytes in stack slots after merging.");
 
 //===----------------------------------------------------------------------===//
 //                           StackColoring Pass
@@ -165,9 +170,14 @@ private:
   /// user code (for example, returning a reference to a local variable).
   /// This procedure checks all of the instructions in the function and
   /// invalidates lifetime ranges which do not contain all of the instructions
-  /// which access that frame slot.
+  /// which access that frame slot. Stores in the same block ahead of a
+  /// LIFETIME_START (such as SafeInit's inits) extend the range instead.
   void removeInvalidSlotRanges();
 
+  /// Report the stack slot bytes before and after merging.
+  void reportFrameSize(unsigned TotalSize, unsigned ReducedSize,
+                       unsigned RemovedSlots);
+
   /// Map entries which point to other entries to their destination.
   ///   A->B->C becomes A->C.
    void expungeSlotMap(DenseMap<int, int> &SlotRemap, unsigned NumSlots);
@@ -602,6 +612,18 @@ void StackColoring::remapInstructions(DenseMap<int, int> &SlotRemap) {
 }
 
 void StackColoring::removeInvalidSlotRanges() {
+  // The first LIFETIME_START of each slot in each block.
+  DenseMap<std::pair<const MachineBasicBlock *, int>, SlotIndex> FirstStarts;
+  for (const MachineInstr *MI : Markers) {
+    if (MI->getOpcode() != TargetOpcode::LIFETIME_START)
+      continue;
+    SlotIndex &Start = FirstStarts[std::make_pair(MI->getParent(),
+                                                  MI->getOperand(0).getIndex())];
+    SlotIndex ThisIndex = Indexes->getInstructionIndex(*MI);
+    if (!Start.isValid() || ThisIndex < Start)
+      Start = ThisIndex;
+  }
+
   for (MachineBasicBlock &BB : *MF)
     for (MachineInstr &I : BB) {
       if (I.getOpcode() == TargetOpcode::LIFETIME_START ||
@@ -634,7 +656,18 @@ void StackColoring::removeInvalidSlotRanges() {
         // If it is not, warn about it and invalidate the range.
         LiveInterval *Interval = &*Intervals[Slot];
         SlotIndex Index = Indexes->getInstructionIndex(I);
-        if (Interval->find(Index) == Interval->end()) {
+        if (!Interval->liveAt(Index)) {
+          // A store just ahead of the start (an init, say) is the first write
+          // of the new lifetime, so the range simply starts there instead.
+          auto Start = FirstStarts.find(std::make_pair(&BB, Slot));
+          if (I.mayStore() && !I.mayLoad() && Start != FirstStarts.end() &&
+              Index < Start->second) {
+            Interval->addSegment(LiveInterval::Segment(
+                Index, Start->second, Interval->getValNumInfo(0)));
+            DEBUG(dbgs()<<"Extending range #"<<Slot<<" to "<<Index<<"\n");
+            EarlyStoreRanges++;
+            continue;
+          }
           Interval->clear();
           DEBUG(dbgs()<<"Invalidating range #"<<Slot<<"\n");
           EscapedAllocas++;
@@ -643,6 +676,18 @@ void StackColoring::removeInvalidSlotRanges() {
     }
 }
 
+void StackColoring::reportFrameSize(unsigned TotalSize, unsigned ReducedSize,
+                                    unsigned RemovedSlots) {
+  FrameSizeBefore += TotalSize;
+  FrameSizeAfter += TotalSize - ReducedSize;
+
+  const Function *Fn = MF->getFunction();
+  emitOptimizationRemarkAnalysis(
+      Fn->getContext(), DEBUG_TYPE, *Fn, DebugLoc(),
+      Twine("merging ") + Twine(RemovedSlots) + " stack slots saved " +
+          Twine(ReducedSize) + " of " + Twine(TotalSize) + " bytes");
+}
+
 void StackColoring::expungeSlotMap(DenseMap<int, int> &SlotRemap,
                                    unsigned NumSlots) {
   // Expunge slot remap map.
@@ -705,6 +750,8 @@ bool StackColoring::runOnMachineFunction(MachineFunction &Func) {
   // stack is too small, or we are told not to optimize the slots.
   if (NumMarkers < 2 || TotalSize < 16 || DisableColoring) {
     DEBUG(dbgs()<<"Will not try to merge slots.\n");
+    if (NumMarkers)
+      reportFrameSize(TotalSize, 0, 0);
     return removeAllMarkers();
   }
 
@@ -789,6 +836,9 @@ bool StackColoring::runOnMachineFunction(MachineFunction &Func) {
           RemovedSlots+=1;
           ReducedSize += MFI->getObjectSize(SecondSlot);
           MFI->setObjectAlignment(FirstSlot, MaxAlignment);
+          // The merged slot is only written before being read if both were.
+          if (!MFI->isLoopInitializedObjectIndex(SecondSlot))
+            MFI->setObjectLoopInitialized(FirstSlot, false);
           MFI->RemoveStackObject(SecondSlot);
         }
       }
@@ -800,6 +850,7 @@ bool StackColoring::runOnMachineFunction(MachineFunction &Func) {
   StackSlotMerged += RemovedSlots;
   DEBUG(dbgs()<<"Merge "<<RemovedSlots<<" slots. Saved "<<
         ReducedSize<<" bytes\n");
+  reportFrameSize(TotalSize, ReducedSize, RemovedSlots);
 
   // Scan the entire function and update all machine operands that use frame
   // indices to use the remapped frame index.
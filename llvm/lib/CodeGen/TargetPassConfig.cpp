@@ -104,6 +104,13 @@ PrintMachineInstrs("print-machineinstrs", cl::ValueOptional,
 cl::opt<bool> MISchedPostRA("misched-postra", cl::Hidden,
   cl::desc("Run MachineScheduler post regalloc (independent of preRA sched)"));
 
+// Frame clearing is done by a pre-emit pass in each target that supports it
+// (X86FrameInit, AArch64FrameInit), which share these options.
+cl::opt<bool> EnableFrameInit("enable-frame-init", cl::Hidden, cl::init(false),
+    cl::desc("Clear stack frames in function prologues"));
+cl::opt<bool> EnableFrameClear("enable-frame-clear", cl::Hidden,
+    cl::init(false), cl::desc("Clear stack frames in function epilogues"));
+
 // Experimental option to run live interval analysis early.
 static cl::opt<bool> EarlyLiveIntervals("early-live-intervals", cl::Hidden,
     cl::desc("Run live interval analysis earlier in the pipeline"));
@@ -0,0 +1,62 @@
+//===- SafeInitAdvice.cpp - SafeInit advisor candidate lists --------------===//
+//
+//                      The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains a reader for SafeInit advisor candidate lists.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ProfileData/SafeInitAdvice.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/LineIterator.h"
+
+using namespace llvm;
+
+std::string llvm::getSafeInitSiteName(const AllocaInst &AI) {
+  // (the dbg.declare, if any, is a user of the alloca's metadata wrapper)
+  if (auto *L = LocalAsMetadata::getIfExists(const_cast<AllocaInst *>(&AI)))
+    if (auto *MDV = MetadataAsValue::getIfExists(AI.getContext(), L))
+      for (const User *U : MDV->users())
+        if (const DbgDeclareInst *DDI = dyn_cast<DbgDeclareInst>(U)) {
+          const DILocalVariable *Var = DDI->getVariable();
+          if (!Var->getName().empty())
+            return (Var->getName() + ":" + Twine(Var->getLine())).str();
+        }
+  return AI.getName().str();
+}
+
+ErrorOr<std::unique_ptr<SafeInitAdvice>>
+SafeInitAdvice::create(const Twine &Path) {
+  auto BufferOrErr = MemoryBuffer::getFileOrSTDIN(Path);
+  if (std::error_code EC = BufferOrErr.getError())
+    return EC;
+  return create(std::move(BufferOrErr.get()));
+}
+
+std::unique_ptr<SafeInitAdvice>
+SafeInitAdvice::create(std::unique_ptr<MemoryBuffer> Buffer) {
+  std::unique_ptr<SafeInitAdvice> Advice(new SafeInitAdvice());
+  for (line_iterator LI(*Buffer, /*SkipBlanks=*/true, '#'); !LI.is_at_eof();
+       ++LI) {
+    StringRef Function, Site;
+    std::tie(Function, Site) = LI->trim().split(' ');
+    Site = Site.trim().split(' ').first;
+    if (Function.empty() || Site.empty())
+      continue;
+    Advice->Functions[Function].insert(Site);
+  }
+  return Advice;
+}
+
+bool SafeInitAdvice::isCandidate(StringRef FunctionName,
+                                 StringRef Site) const {
+  auto I = Functions.find(FunctionName);
+  return I != Functions.end() && I->getValue().count(Site);
+}
@@ -0,0 +1,93 @@
+//===- SafeInitProf.cpp - SafeInit init-cost profiles ---------------------===//
+//
+//                      The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the reader for SafeInit init-cost profiles.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ProfileData/SafeInitProf.h"
+#include "llvm/Support/LineIterator.h"
+#include <map>
+
+using namespace llvm;
+
+ErrorOr<std::unique_ptr<SafeInitProfile>>
+SafeInitProfile::create(const Twine &Path) {
+  auto BufferOrErr = MemoryBuffer::getFileOrSTDIN(Path);
+  if (std::error_code EC = BufferOrErr.getError())
+    return EC;
+  return create(std::move(BufferOrErr.get()));
+}
+
+std::unique_ptr<SafeInitProfile>
+SafeInitProfile::create(std::unique_ptr<MemoryBuffer> Buffer) {
+  struct Site {
+    uint64_t Execs = 0;
+    uint64_t Bytes = 0;
+    bool Heap = false;
+  };
+  // Keyed by (function, location); sanstats reports a site's execution and
+  // byte counters separately.
+  std::map<std::pair<StringRef, StringRef>, Site> Sites;
+
+  for (line_iterator LI(*Buffer, /*SkipBlanks=*/true); !LI.is_at_eof(); ++LI) {
+    StringRef Line = LI->trim();
+    StringRef Loc, Rest, Kind, Count;
+    std::tie(Loc, Rest) = Line.split(' ');
+    std::tie(Rest, Count) = Rest.rsplit(' ');
+    std::tie(Rest, Kind) = Rest.rsplit(' ');
+    StringRef Function = Rest.trim();
+    uint64_t N;
+    // Skips lines sanstats couldn't symbolize ("<error> ...") too.
+    if (Function.empty() || Count.getAsInteger(10, N))
+      continue;
+
+    if (Kind == "safeinit-stack" || Kind == "safeinit-heap") {
+      Site &S = Sites[std::make_pair(Function, Loc)];
+      S.Execs += N;
+      S.Heap = Kind == "safeinit-heap";
+    } else if (Kind == "safeinit-bytes") {
+      Sites[std::make_pair(Function, Loc)].Bytes += N;
+    }
+  }
+
+  std::unique_ptr<SafeInitProfile> Profile(new SafeInitProfile());
+  for (auto &I : Sites) {
+    FunctionRecord &R = Profile->Functions[I.first.first];
+    const Site &S = I.second;
+    if (S.Heap) {
+      ++R.HeapSites;
+      R.HeapExecs += S.Execs;
+      R.HeapBytes += S.Bytes;
+    } else {
+      ++R.StackSites;
+      R.StackExecs += S.Execs;
+      R.StackBytes += S.Bytes;
+    }
+  }
+  for (auto &I : Profile->Functions)
+    Profile->MaxStackExecs =
+        std::max(Profile->MaxStackExecs, I.getValue().StackExecs);
+  return Profile;
+}
+
+const SafeInitProfile::FunctionRecord *
+SafeInitProfile::getFunction(StringRef FunctionName) const {
+  auto I = Functions.find(FunctionName);
+  return I == Functions.end() ? nullptr : &I->getValue();
+}
+
+StringRef SafeInitProfile::getPolicy(StringRef FunctionName) const {
+  const FunctionRecord *R = getFunction(FunctionName);
+  if (!R || !R->StackExecs || R->StackExecs * HotFraction < MaxStackExecs)
+    return "";
+  if (R->StackSites > 1 && R->StackBytes <= R->StackExecs * SmallInitBytes)
+    return "frame";
+  return "ir";
+}
@@ -45,6 +45,7 @@ FunctionPass *createAArch64A53Fix835769();
 FunctionPass *createAArch64CleanupLocalDynamicTLSPass();
 
 FunctionPass *createAArch64CollectLOHPass();
+FunctionPass *createAArch64FrameInitPass();
 
 void initializeAArch64ExpandPseudoPass(PassRegistry&);
 } // end namespace llvm
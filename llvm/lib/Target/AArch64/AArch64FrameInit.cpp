@@ -0,0 +1,380 @@
+//===-- AArch64FrameInit.cpp - AArch64 Frame Initialization ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Initialization (and clearing) of stack frames on AArch64, like
+// X86FrameInit: the locals area of the frame is zeroed right after the
+// prologue and/or right before the epilogue, with stp pairs of zero
+// registers, a loop of them for bigger frames, and optionally dc zva.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AArch64.h"
+#include "AArch64FrameLowering.h"
+#include "AArch64InstrInfo.h"
+#include "AArch64MachineFunctionInfo.h"
+#include "AArch64Subtarget.h"
+#include "MCTargetDesc/AArch64AddressingModes.h"
+#include "llvm/CodeGen/LivePhysRegs.h"
+#include "llvm/CodeGen/MachineFunctionPass.h"
+#include "llvm/CodeGen/MachineInstrBuilder.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
+using namespace llvm;
+
+#define DEBUG_TYPE "aarch64frameinit"
+
+// (defined in TargetPassConfig.cpp)
+extern cl::opt<bool> EnableFrameInit;
+extern cl::opt<bool> EnableFrameClear;
+
+static cl::opt<unsigned> FrameInitZVAThreshold(
+    "aarch64-frame-init-zva-threshold", cl::Hidden, cl::init(0),
+    cl::desc("Clear frames of at least this many bytes with dc zva "
+             "(0 = never)"));
+static cl::opt<unsigned> FrameInitZVABlockSize(
+    "aarch64-frame-init-zva-block-size", cl::Hidden, cl::init(64),
+    cl::desc("Block size in bytes which dc zva clears on the target "
+             "(see DCZID_EL0)"));
+
+namespace {
+struct AArch64FrameInit : public MachineFunctionPass {
+  static char ID;
+  AArch64FrameInit() : MachineFunctionPass(ID) {}
+
+  const AArch64Subtarget *STI;
+  const AArch64InstrInfo *TII;
+  const AArch64RegisterInfo *TRI;
+
+  MachineFunctionProperties getRequiredProperties() const override {
+    return MachineFunctionProperties().set(
+        MachineFunctionProperties::Property::AllVRegsAllocated);
+  }
+
+  bool runOnMachineFunction(MachineFunction &MF) override;
+
+  unsigned findZeroReg(const LivePhysRegs &Live);
+  void clearArea(MachineBasicBlock &MBB, MachineBasicBlock::iterator InsertPt,
+                 const LivePhysRegs &Live, int Offset, unsigned Size);
+
+  const char *getPassName() const override {
+    return "AArch64 Frame Clearing";
+  }
+};
+char AArch64FrameInit::ID = 0;
+}
+
+FunctionPass *llvm::createAArch64FrameInitPass() {
+  return new AArch64FrameInit();
+}
+
+static bool isLive(const LivePhysRegs &Live, unsigned Reg,
+                   const TargetRegisterInfo *TRI) {
+  for (MCRegAliasIterator AI(Reg, TRI, /*IncludeSelf=*/true); AI.isValid(); ++AI)
+    if (Live.contains(*AI))
+      return true;
+  return false;
+}
+
+// Computes the registers live just before InsertPt in MBB.
+static void computeLiveness(LivePhysRegs &Live, MachineBasicBlock &MBB,
+                            MachineBasicBlock::iterator InsertPt,
+                            const TargetRegisterInfo *TRI) {
+  Live.init(TRI);
+  Live.addLiveOuts(MBB);
+  for (auto I = MBB.end(); I != InsertPt;)
+    Live.stepBackward(*--I);
+}
+
+// Picks a vector register which is free at the point Live describes, from
+// v16-v31: those are neither arguments nor (partly) callee-saved. Returns 0
+// if every one is live, or we have no NEON.
+unsigned AArch64FrameInit::findZeroReg(const LivePhysRegs &Live) {
+  static const MCPhysReg QRegs[] = {
+    AArch64::Q16, AArch64::Q17, AArch64::Q18, AArch64::Q19, AArch64::Q20,
+    AArch64::Q21, AArch64::Q22, AArch64::Q23, AArch64::Q24, AArch64::Q25,
+    AArch64::Q26, AArch64::Q27, AArch64::Q28, AArch64::Q29, AArch64::Q30,
+    AArch64::Q31
+  };
+  if (!STI->hasNEON())
+    return 0;
+  for (MCPhysReg Reg : QRegs)
+    if (!isLive(Live, Reg, TRI))
+      return Reg;
+  return 0;
+}
+
+// Clears the Size bytes at SP + Offset just before InsertPt in MBB, where
+// Live holds the live registers. Size is a multiple of 16.
+//
+// Small areas get straight-line stores from SP: stp of a zeroed q register
+// (32 bytes each) if one is free, of xzr (16 bytes) otherwise. Bigger ones
+// take a loop of four stores, which needs two scratch registers; those
+// normally come from x16/x17 (IP0/IP1), which are dead around prologues and
+// epilogues. The loop counts down with cbnz, so NZCV is left alone.
+//
+// With -aarch64-frame-init-zva-threshold, areas at least that big are
+// cleared a cache block at a time with dc zva instead, storing to the
+// (unaligned) first and last blocks. The block size isn't known statically,
+// so it is an option as well; it must not be more than the hardware's.
+void AArch64FrameInit::clearArea(MachineBasicBlock &MBB,
+                                 MachineBasicBlock::iterator InsertPt,
+                                 const LivePhysRegs &Live, int Offset,
+                                 unsigned Size) {
+  MachineFunction &MF = *MBB.getParent();
+  DebugLoc DL = InsertPt != MBB.end() ? InsertPt->getDebugLoc() : DebugLoc();
+  assert(Size % 16 == 0 && "frame clearing needs 16-byte granules");
+
+  unsigned ZeroReg = findZeroReg(Live);
+  unsigned ChunkSize = ZeroReg ? 32 : 16;
+  unsigned Chunks = Size / ChunkSize;
+
+  static const MCPhysReg ScratchRegs[] = {
+    AArch64::X16, AArch64::X17, AArch64::X9, AArch64::X10, AArch64::X11,
+    AArch64::X12, AArch64::X13, AArch64::X14, AArch64::X15
+  };
+  SmallVector<unsigned, 2> Scratch;
+  for (MCPhysReg Reg : ScratchRegs)
+    if (Scratch.size() < 2 && !isLive(Live, Reg, TRI))
+      Scratch.push_back(Reg);
+
+  unsigned Block = FrameInitZVABlockSize;
+  bool UseZVA = FrameInitZVAThreshold && Size >= FrameInitZVAThreshold &&
+                isPowerOf2_32(Block) && Block >= ChunkSize && Block <= 512 &&
+                Size >= 2 * Block && Scratch.size() == 2;
+  // stp takes a signed 7-bit displacement, scaled by the register size (the
+  // xzr pairs reach the least far).
+  bool InRange = Offset >= -512 && Offset + int(Size) <= 512;
+  bool UseLoop = !UseZVA && (Chunks > 8 || !InRange) && Scratch.size() == 2;
+  if (!UseZVA && !UseLoop && !InRange)
+    report_fatal_error("no scratch registers to clear the frame of " +
+                       MF.getName());
+
+  // Stores Bytes bytes at Base + Disp; the last 16 may be a single xzr pair.
+  auto BuildStores = [&](MachineBasicBlock &BB, MachineBasicBlock::iterator I,
+                         unsigned Base, int Disp, unsigned Bytes) {
+    for (unsigned B = 0; B < Bytes;) {
+      if (ZeroReg && Bytes - B >= 32) {
+        BuildMI(BB, I, DL, TII->get(AArch64::STPQi))
+          .addReg(ZeroReg).addReg(ZeroReg).addReg(Base)
+          .addImm((Disp + int(B)) / 16);
+        B += 32;
+      } else {
+        BuildMI(BB, I, DL, TII->get(AArch64::STPXi))
+          .addReg(AArch64::XZR).addReg(AArch64::XZR).addReg(Base)
+          .addImm((Disp + int(B)) / 8);
+        B += 16;
+      }
+    }
+  };
+
+  if (ZeroReg)
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::MOVIv2d_ns), ZeroReg)
+      .addImm(0);
+  if (!UseZVA && !UseLoop) {
+    BuildStores(MBB, InsertPt, AArch64::SP, Offset, Size);
+    return;
+  }
+
+  unsigned Ptr = Scratch[0], Count = Scratch[1];
+  unsigned Step;
+  if (UseZVA) {
+    // Ptr and Count start at either end of the area, clear the blocks there,
+    // and are then rounded inwards to the first and last block boundaries;
+    // as the area holds at least two blocks, there is at least one between.
+    emitFrameOffset(MBB, InsertPt, DL, Ptr, AArch64::SP, Offset, TII);
+    emitFrameOffset(MBB, InsertPt, DL, Count, Ptr, Size, TII);
+    BuildStores(MBB, InsertPt, Ptr, 0, Block);
+    BuildStores(MBB, InsertPt, Count, -int(Block), Block);
+    uint64_t Mask = AArch64_AM::encodeLogicalImmediate(~uint64_t(Block - 1), 64);
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::ADDXri), Ptr)
+      .addReg(Ptr).addImm(Block - 1).addImm(0);
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::ANDXri), Ptr)
+      .addReg(Ptr).addImm(Mask);
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::ANDXri), Count)
+      .addReg(Count).addImm(Mask);
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::SUBXrs), Count)
+      .addReg(Count).addReg(Ptr).addImm(0);
+    // lsr Count, Count, #log2(Block)
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::UBFMXri), Count)
+      .addReg(Count).addImm(Log2_32(Block)).addImm(63);
+    Step = Block;
+  } else {
+    unsigned LoopCount = Chunks / 4;
+    emitFrameOffset(MBB, InsertPt, DL, Ptr, AArch64::SP, Offset, TII);
+    BuildMI(MBB, InsertPt, DL, TII->get(AArch64::MOVZXi), Count)
+      .addImm(LoopCount & 0xffff).addImm(0);
+    if (LoopCount >> 16)
+      BuildMI(MBB, InsertPt, DL, TII->get(AArch64::MOVKXi), Count)
+        .addReg(Count).addImm(LoopCount >> 16).addImm(16);
+    Step = ChunkSize * 4;
+  }
+
+  MachineBasicBlock *LoopBB = MF.CreateMachineBasicBlock();
+  MachineBasicBlock *TailBB = MF.CreateMachineBasicBlock();
+  MF.insert(std::next(MBB.getIterator()), LoopBB);
+  MF.insert(std::next(LoopBB->getIterator()), TailBB);
+  TailBB->splice(TailBB->end(), &MBB, InsertPt, MBB.end());
+  TailBB->transferSuccessors(&MBB);
+  MBB.addSuccessor(LoopBB);
+  LoopBB->addSuccessor(LoopBB);
+  LoopBB->addSuccessor(TailBB);
+
+  // Whatever is live at InsertPt is live through the loop.
+  const MachineRegisterInfo &MRI = MF.getRegInfo();
+  for (unsigned Reg : Live) {
+    if (MRI.isReserved(Reg))
+      continue;
+    bool HasLiveSuper = false;
+    for (MCSuperRegIterator SR(Reg, TRI); SR.isValid(); ++SR)
+      HasLiveSuper |= Live.contains(*SR);
+    if (HasLiveSuper)
+      continue;
+    LoopBB->addLiveIn(Reg);
+    TailBB->addLiveIn(Reg);
+  }
+  LoopBB->addLiveIn(Ptr);
+  LoopBB->addLiveIn(Count);
+  if (ZeroReg) {
+    LoopBB->addLiveIn(ZeroReg);
+    if (!UseZVA)
+      TailBB->addLiveIn(ZeroReg);
+  }
+  if (!UseZVA)
+    TailBB->addLiveIn(Ptr);
+  LoopBB->sortUniqueLiveIns();
+  TailBB->sortUniqueLiveIns();
+
+  if (UseZVA)
+    // dc zva, Ptr
+    BuildMI(*LoopBB, LoopBB->end(), DL, TII->get(AArch64::SYSxt))
+      .addImm(3).addImm(7).addImm(4).addImm(1).addReg(Ptr);
+  else
+    BuildStores(*LoopBB, LoopBB->end(), Ptr, 0, Step);
+  BuildMI(*LoopBB, LoopBB->end(), DL, TII->get(AArch64::ADDXri), Ptr)
+    .addReg(Ptr).addImm(Step).addImm(0);
+  BuildMI(*LoopBB, LoopBB->end(), DL, TII->get(AArch64::SUBXri), Count)
+    .addReg(Count).addImm(1).addImm(0);
+  BuildMI(*LoopBB, LoopBB->end(), DL, TII->get(AArch64::CBNZX))
+    .addReg(Count).addMBB(LoopBB);
+
+  // The loop leaves Ptr just above what it cleared.
+  if (!UseZVA)
+    BuildStores(*TailBB, TailBB->begin(), Ptr, 0, Size % Step);
+}
+
+bool AArch64FrameInit::runOnMachineFunction(MachineFunction &MF) {
+  bool DoFrameInit = EnableFrameInit;
+  bool DoFrameClear = EnableFrameClear;
+
+  // A per-function SafeInit policy overrides the global settings, as in
+  // X86FrameInit. We don't clear selectively, so "mixed" clears everything
+  // too (which is safe, just redundant with SafeInit's own inits).
+  const Function *F = MF.getFunction();
+  if (F->hasFnAttribute("safeinit-policy")) {
+    StringRef Policy = F->getFnAttribute("safeinit-policy").getValueAsString();
+    DoFrameInit = Policy == "frame" || Policy == "dynamic" || Policy == "mixed";
+    if (Policy == "none")
+      DoFrameClear = false;
+    else if (Policy == "frame-exit")
+      DoFrameClear = true;
+  }
+
+  if (!(DoFrameInit || DoFrameClear))
+    return false;
+
+  // GHC functions have no prologue, and naked ones no frame. (SafeInit
+  // initializes the latter in IR, see canClearFrame there.)
+  if (F->getCallingConv() == CallingConv::GHC ||
+      F->hasFnAttribute(Attribute::Naked))
+    return false;
+
+  STI = &MF.getSubtarget<AArch64Subtarget>();
+  TII = STI->getInstrInfo();
+  TRI = STI->getRegisterInfo();
+  const AArch64FrameLowering *AFL = STI->getFrameLowering();
+  const AArch64FunctionInfo *AFI = MF.getInfo<AArch64FunctionInfo>();
+  MachineFrameInfo *MFI = MF.getFrameInfo();
+
+  // The locals sit below the callee-saved registers, which come first (and
+  // include the frame record). After the prologue, they are at SP, or just
+  // below it in the red zone. The stack size and the callee-save area are
+  // both multiples of 16.
+  unsigned StackSize = MFI->getStackSize();
+  unsigned LocalSize = AFI->getLocalStackSize();
+  bool RedZone = !AFI->hasStackFrame() && AFL->canUseRedZone(MF);
+  DEBUG(dbgs() << "going to clear " << LocalSize << " bytes (of " << StackSize
+               << ") in " << MF.getName()
+               << (RedZone ? " (uses red zone)\n" : "\n"));
+  if (!LocalSize)
+    return false;
+
+  bool Changed = false;
+  if (DoFrameInit) {
+    // The prologue is wherever the frame setup is, which shrink-wrapping may
+    // have moved out of the entry block. A red zone frame has no setup at all.
+    MachineBasicBlock *PrologueBB =
+        MFI->getSavePoint() ? MFI->getSavePoint() : &MF.front();
+    MachineBasicBlock::iterator InsertPt = PrologueBB->begin();
+    for (MachineBasicBlock &MBB : MF) {
+      bool FoundSetup = false;
+      for (MachineInstr &MI : MBB)
+        if (MI.getFlag(MachineInstr::FrameSetup)) {
+          PrologueBB = &MBB;
+          InsertPt = std::next(MachineBasicBlock::iterator(MI));
+          FoundSetup = true;
+        }
+      if (FoundSetup)
+        break;
+    }
+    // Realignment finishes with an unflagged AND into SP. (Only that: calls
+    // clobber SP too, as far as their register masks go.)
+    if (InsertPt != PrologueBB->end() &&
+        InsertPt->getOpcode() == AArch64::ANDXri &&
+        InsertPt->getOperand(0).getReg() == AArch64::SP)
+      ++InsertPt;
+
+    LivePhysRegs Live;
+    computeLiveness(Live, *PrologueBB, InsertPt, TRI);
+    clearArea(*PrologueBB, InsertPt, Live, RedZone ? -int(LocalSize) : 0,
+              LocalSize);
+    Changed = true;
+  }
+
+  // Before the epilogue, SP is back at the bottom of the frame, unless there
+  // were dynamic allocas or realignment (which leave it elsewhere, and so
+  // are left alone).
+  if (DoFrameClear &&
+      (MFI->hasVarSizedObjects() || TRI->needsStackRealignment(MF))) {
+    DEBUG(dbgs() << "not clearing the frame of " << MF.getName()
+                 << " on return\n");
+    return Changed;
+  }
+
+  SmallVector<MachineBasicBlock *, 4> ReturnBlocks;
+  if (DoFrameClear)
+    for (MachineBasicBlock &MBB : MF)
+      if (MBB.isReturnBlock())
+        ReturnBlocks.push_back(&MBB);
+  for (MachineBasicBlock *MBB : ReturnBlocks) {
+    MachineBasicBlock::iterator InsertPt = MBB->getFirstTerminator();
+    for (MachineInstr &MI : *MBB)
+      if (MI.getFlag(MachineInstr::FrameDestroy)) {
+        InsertPt = MachineBasicBlock::iterator(MI);
+        break;
+      }
+    LivePhysRegs Live;
+    computeLiveness(Live, *MBB, InsertPt, TRI);
+    clearArea(*MBB, InsertPt, Live, RedZone ? -int(LocalSize) : 0, LocalSize);
+    Changed = true;
+  }
+
+  return Changed;
+}
@@ -419,6 +419,9 @@ void AArch64PassConfig::addPreSched2() {
 void AArch64PassConfig::addPreEmitPass() {
   if (EnableA53Fix835769)
     addPass(createAArch64A53Fix835769());
+  // Clearing the frame may add loops, so it must come before branch
+  // relaxation.
+  addPass(createAArch64FrameInitPass());
   // Relax conditional branch instructions if they're otherwise out of
   // range of their destination.
   addPass(createAArch64BranchRelaxation());
@@ -21,7 +21,9 @@ namespace llvm {
 
 class FunctionPass;
 class ImmutablePass;
+class MachineFunction;
 class PassRegistry;
+class X86Subtarget;
 class X86TargetMachine;
 
 /// This pass converts a legalized DAG into a X86-specific DAG, ready for
@@ -82,6 +84,18 @@ FunctionPass *createX86FixupBWInsts();
 
 FunctionPass *createX86FrameInitPass();
 
+/// Whether the prologue of \p MF may clear its whole frame as it allocates it,
+/// leaving nothing for the frame clearing pass to do there.
+bool canClearX86FrameInPrologue(const MachineFunction &MF);
+
+/// The width in bytes of the vector stores which clear stack frames.
+unsigned getX86FrameInitChunkSize(const X86Subtarget &STI);
+
+/// Whether the dynamic allocas of \p MF are cleared as they are allocated
+/// (see X86TargetLowering::LowerDYNAMIC_STACKALLOC), because SafeInit left
+/// them to frame clearing.
+bool clearsX86DynamicAllocas(const MachineFunction &MF);
+
 void initializeFixupBWInstPassPass(PassRegistry &);
 } // End llvm namespace
 
@@ -16,17 +16,59 @@
 #include "X86InstrInfo.h"
 #include "X86MachineFunctionInfo.h"
 #include "X86Subtarget.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/CodeGen/LivePhysRegs.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineInstrBuilder.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
 #include "llvm/CodeGen/Passes.h"
+#include "llvm/CodeGen/PseudoSourceValue.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Target/TargetMachine.h"
 using namespace llvm;
 
 #define DEBUG_TYPE "x86frameinit"
 
-static cl::opt<bool> EnableFrameInit( "enable-frame-init", cl::Hidden, cl::init(false),
-    cl::desc("Clear stack frames in function prologues"));
-static cl::opt<bool> EnableFrameClear( "enable-frame-clear", cl::Hidden, cl::init(false),
-    cl::desc("Clear stack frames in function epilogues"));
+// (defined in TargetPassConfig.cpp)
+extern cl::opt<bool> EnableFrameInit;
+extern cl::opt<bool> EnableFrameClear;
+
+static cl::opt<unsigned> FrameInitVectorWidth( "frame-init-vector-width", cl::Hidden, cl::init(0),
+    cl::desc("Width in bytes (16, 32 or 64) of the stores clearing stack frames "
+             "(default = widest available)"));
+static cl::opt<bool> SelectiveFrameInit( "frame-init-selective", cl::Hidden, cl::init(true),
+    cl::desc("Don't clear frame objects which are written in full before "
+             "they can be read"));
+static cl::opt<unsigned> FrameInitRepStosThreshold( "frame-init-rep-stos-threshold", cl::Hidden, cl::init(4096),
+    cl::desc("Clear frames of at least this many bytes with rep stosq, if its "
+             "registers are free after the prologue (0 = never)"));
+static cl::opt<bool> FrameInitStackMark( "frame-init-stack-mark", cl::Hidden, cl::init(false),
+    cl::desc("Skip clearing frames below the thread's stack high-water mark "
+             "(needs the SafeInit tcmalloc)"));
+static cl::opt<bool> FrameInitInPrologue( "frame-init-in-prologue", cl::Hidden, cl::init(true),
+    cl::desc("Clear frames of over a page as the prologue allocates them, "
+             "touching each page in turn"));
+static cl::opt<bool> FrameInitDynamicAllocas( "frame-init-dynamic-allocas", cl::Hidden, cl::init(false),
+    cl::desc("Clear dynamic allocas as they are allocated, for configurations "
+             "without SafeInit memsets for them (always done for functions "
+             "with the \"frame\" policy)"));
+
+// The stack mark is the thread-local
+//   struct { uintptr_t Base, Mark; } __safeinit_stack;
+// which the SafeInit tcmalloc defines (see gperftools/safeinit_stack.h):
+// the thread's stack is known to be zero from Base up to Base + Mark (so a
+// Mark of 0 means nothing is known). A function whose frame is below the mark
+// needn't clear it, and lowers the mark past it; on return, a leaf function
+// which clears its frame raises the mark back if it is still there.
+// __safeinit_stack_reset() zeroes the stack below its caller and sets the
+// mark.
+static const char StackMarkSymbol[] = "__safeinit_stack";
+static const char StackMarkResetSymbol[] = "__safeinit_stack_reset";
 
 namespace {
 struct X86FrameInit : public llvm::MachineFunctionPass {
@@ -38,16 +80,63 @@ struct X86FrameInit : public llvm::MachineFunctionPass {
   const X86RegisterInfo *TRI;
   const X86FrameLowering *X86FL;
 
+  bool DoFrameInit;
+  bool DoFrameClear;
+  // Only the objects SafeInit left to us need clearing (see findIRObjects).
+  bool Mixed;
+  // Whether we keep the stack mark; if StackMarkOpen, we run code which
+  // doesn't, so can only drop it. HasCalls is set if we call anything.
+  bool StackMark;
+  bool StackMarkOpen;
+  bool HasCalls;
+
+  // The vector stores used for clearing: each clears ChunkSize bytes from a
+  // register which ZeroOpc zeroes (see findZeroReg).
+  unsigned ChunkSize;
+  unsigned StoreOpc;
+  unsigned ZeroOpc;
+
+  // Chunks (counting down from the top of the cleared area) which hold only
+  // objects written before being read, and so needn't be cleared.
+  BitVector SkipChunk;
+
   MachineFunctionProperties getRequiredProperties() const override {
     return MachineFunctionProperties().set(
         MachineFunctionProperties::Property::AllVRegsAllocated);
   }
 
   bool runOnMachineFunction(MachineFunction &MF) override;
+  bool initFrame(MachineFunction &MF);
+
+  void findIRObjects(MachineFunction &MF, SmallVectorImpl<int> &FIs);
+  void findInitializedObjects(MachineBasicBlock &MBB,
+                              MachineBasicBlock::iterator Begin,
+                              SmallVectorImpl<int> &FIs);
+  unsigned findZeroReg(const LivePhysRegs &Live);
+  void clearQword(MachineBasicBlock &MBB, MachineBasicBlock::iterator InsertPt,
+                  int Disp);
+  void clearWithRepStos(MachineBasicBlock &MBB,
+                        MachineBasicBlock::iterator InsertPt, int SPOffset,
+                        unsigned ClearFromOffset, unsigned Size);
+  void clearArea(MachineBasicBlock &MBB, MachineBasicBlock::iterator InsertPt,
+                 const LivePhysRegs &Live, int SPOffset,
+                 unsigned ClearFromOffset, unsigned Chunks,
+                 const BitVector *Skip);
+  void findStackMarkRegs(const LivePhysRegs &Live, unsigned &AddrReg,
+                         unsigned &ValReg);
+  void loadStackMarkAddr(MachineBasicBlock &MBB, MachineBasicBlock::iterator I,
+                         unsigned AddrReg);
+  MachineBasicBlock *splitAtStackMark(MachineBasicBlock &MBB,
+                                      MachineBasicBlock::iterator InsertPt,
+                                      const LivePhysRegs &Live, int Top,
+                                      MachineBasicBlock *&ContBB);
+  void lowerStackMark(MachineBasicBlock &MBB, MachineBasicBlock::iterator I,
+                      const LivePhysRegs &Live, int Bottom);
+  void raiseStackMark(MachineBasicBlock &MBB, MachineBasicBlock::iterator I,
+                      const LivePhysRegs &Live, int Bottom, int Top);
 
   const char *getPassName() const override { return "X86 Frame Clearing"; }
 
-  SmallVector<unsigned, 1> PrologueBlocks;
   SmallVector<unsigned, 4> EpilogueBlocks;
 };
 }
@@ -56,11 +145,616 @@ FunctionPass *llvm::createX86FrameInitPass() {
   return new X86FrameInit();
 }
 
+// Reads the SafeInit policy of F. A per-function policy overrides the global
+// prologue setting ("frame" and "dynamic" leave the static part of the frame
+// to us, "mixed" some of it), and "frame-exit" asks for the frame to be
+// cleared on return as well.
+static void getFramePolicy(const Function &F, bool &Init, bool &Clear,
+                           bool &Mixed) {
+  Init = EnableFrameInit;
+  Clear = EnableFrameClear;
+  Mixed = false;
+  if (!F.hasFnAttribute("safeinit-policy"))
+    return;
+  StringRef Policy = F.getFnAttribute("safeinit-policy").getValueAsString();
+  Mixed = Policy == "mixed";
+  Init = Policy == "frame" || Policy == "dynamic" || Mixed;
+  if (Policy == "none")
+    Clear = false;
+  else if (Policy == "frame-exit")
+    Clear = true;
+}
+
+// The prologue can only clear everything: objects we'd skip, and the stack
+// mark, need us.
+bool llvm::canClearX86FrameInPrologue(const MachineFunction &MF) {
+  if (!FrameInitInPrologue || FrameInitStackMark)
+    return false;
+  bool Init, Clear, Mixed;
+  getFramePolicy(*MF.getFunction(), Init, Clear, Mixed);
+  return Init && !Mixed;
+}
+
+// SafeInit leaves the dynamic allocas of "frame" policy functions alone, and
+// those of every function when it doesn't run or only handles the heap; the
+// latter has to be asked for, as SafeInit's STACKZEROINIT_DYNONLY memsets
+// would clear them again.
+bool llvm::clearsX86DynamicAllocas(const MachineFunction &MF) {
+  const Function *F = MF.getFunction();
+  if (F->hasFnAttribute("safeinit-policy"))
+    return F->getFnAttribute("safeinit-policy").getValueAsString() == "frame";
+  return EnableFrameInit && FrameInitDynamicAllocas;
+}
+
+// The widest vector stores we have (see runOnMachineFunction).
+unsigned llvm::getX86FrameInitChunkSize(const X86Subtarget &STI) {
+  unsigned ChunkSize = STI.hasAVX512() ? 64 : STI.hasAVX() ? 32 : 16;
+  if (FrameInitVectorWidth && FrameInitVectorWidth < ChunkSize)
+    ChunkSize = FrameInitVectorWidth;
+  assert((ChunkSize == 16 || ChunkSize == 32 || ChunkSize == 64) &&
+         "unsupported frame clearing width");
+  return ChunkSize;
+}
+
+static bool isLive(const LivePhysRegs &Live, unsigned Reg,
+                   const TargetRegisterInfo *TRI) {
+  for (MCRegAliasIterator AI(Reg, TRI, /*IncludeSelf=*/true); AI.isValid(); ++AI)
+    if (Live.contains(*AI))
+      return true;
+  return false;
+}
+
+// Computes the registers live just before InsertPt in MBB.
+static void computeLiveness(LivePhysRegs &Live, MachineBasicBlock &MBB,
+                            MachineBasicBlock::iterator InsertPt,
+                            const TargetRegisterInfo *TRI) {
+  Live.init(TRI);
+  Live.addLiveOuts(MBB);
+  for (auto I = MBB.end(); I != InsertPt;)
+    Live.stepBackward(*--I);
+}
+
+// Adds Live to the live-ins of MBB, a block split off at the point it
+// describes.
+static void addLiveIns(MachineBasicBlock &MBB, const LivePhysRegs &Live,
+                       const TargetRegisterInfo *TRI) {
+  const MachineRegisterInfo &MRI = MBB.getParent()->getRegInfo();
+  for (unsigned Reg : Live) {
+    if (MRI.isReserved(Reg))
+      continue;
+    bool HasLiveSuper = false;
+    for (MCSuperRegIterator SR(Reg, TRI); SR.isValid(); ++SR)
+      HasLiveSuper |= Live.contains(*SR);
+    if (HasLiveSuper)
+      continue;
+    MBB.addLiveIn(Reg);
+  }
+  MBB.sortUniqueLiveIns();
+}
+
+// Finds where the prologue ends: after the frame setup, which shrink-wrapping
+// may have moved out of the entry block. RSP is getStackSize() below its
+// value on entry there.
+static MachineBasicBlock::iterator findPrologueEnd(MachineFunction &MF,
+                                                   MachineBasicBlock *&MBB) {
+  MBB = &MF.front();
+  MachineBasicBlock::iterator InsertPt = MBB->begin();
+  for (MachineBasicBlock &BB : MF) {
+    bool FoundSetup = false;
+    for (MachineInstr &MI : BB)
+      if (MI.getFlag(MachineInstr::FrameSetup)) {
+        MBB = &BB;
+        InsertPt = std::next(MachineBasicBlock::iterator(MI));
+        FoundSetup = true;
+      }
+    if (FoundSetup)
+      break;
+  }
+  return InsertPt;
+}
+
+// Whether calls to F reach a definition which keeps the stack mark: one whose
+// prologue we clear. (This mirrors the policy check in runOnMachineFunction.)
+static bool maintainsStackMark(const Function &F, const TargetMachine &TM) {
+  if (F.isDeclaration() || F.isInterposable() ||
+      F.hasFnAttribute(Attribute::Naked))
+    return false;
+  // In PIC code, calls to default-visibility symbols may be preempted.
+  if (TM.getRelocationModel() == Reloc::PIC_ && !F.hasLocalLinkage() &&
+      F.hasDefaultVisibility())
+    return false;
+  if (!F.hasFnAttribute("safeinit-policy"))
+    return EnableFrameInit;
+  StringRef Policy = F.getFnAttribute("safeinit-policy").getValueAsString();
+  return Policy == "frame" || Policy == "dynamic" || Policy == "mixed";
+}
+
+static bool isStackMarkReset(const MachineOperand &Callee) {
+  if (Callee.isSymbol())
+    return StringRef(Callee.getSymbolName()) == StackMarkResetSymbol;
+  return Callee.isGlobal() &&
+         Callee.getGlobal()->getName() == StackMarkResetSymbol;
+}
+
+// Whether MF runs code which doesn't keep the stack mark, or moves RSP in ways
+// we don't follow. Calls to the reset don't count (see runOnMachineFunction).
+static bool isOpenToStackMark(MachineFunction &MF, bool &HasCalls) {
+  bool Open = MF.getFrameInfo()->hasVarSizedObjects();
+  HasCalls = false;
+  for (MachineBasicBlock &MBB : MF)
+    for (MachineInstr &MI : MBB) {
+      // (these call __tls_get_addr, but aren't marked as calls)
+      if (MI.isInlineAsm() || MI.getOpcode() == X86::TLS_addr64 ||
+          MI.getOpcode() == X86::TLS_base_addr64) {
+        Open = true;
+        continue;
+      }
+      if (!MI.isCall())
+        continue;
+      HasCalls = true;
+      const MachineOperand &Callee = MI.getOperand(0);
+      if (isStackMarkReset(Callee))
+        continue;
+      const Function *F =
+          Callee.isGlobal() ? dyn_cast<Function>(Callee.getGlobal()) : nullptr;
+      if (!F || !maintainsStackMark(*F, MF.getTarget()))
+        Open = true;
+    }
+  return Open;
+}
+
+// Adds the address of field Field (0 for Base, 1 for Mark) of the stack mark,
+// whose offset from the thread pointer is in AddrReg.
+static const MachineInstrBuilder &
+addStackMarkField(const MachineInstrBuilder &MIB, unsigned AddrReg,
+                  unsigned Field) {
+  return MIB.addReg(AddrReg).addImm(1).addReg(0).addImm(8 * Field)
+    .addReg(X86::FS);
+}
+
+// Picks two free registers for the stack mark sequences, which also clobber
+// EFLAGS.
+void X86FrameInit::findStackMarkRegs(const LivePhysRegs &Live,
+                                     unsigned &AddrReg, unsigned &ValReg) {
+  static const MCPhysReg Regs[] = {
+    X86::R11, X86::R10, X86::RAX, X86::RCX, X86::RDX, X86::RSI, X86::RDI,
+    X86::R8, X86::R9
+  };
+  AddrReg = ValReg = 0;
+  if (!isLive(Live, X86::EFLAGS, TRI))
+    for (MCPhysReg Reg : Regs) {
+      if (isLive(Live, Reg, TRI))
+        continue;
+      if (!AddrReg) {
+        AddrReg = Reg;
+        continue;
+      }
+      ValReg = Reg;
+      break;
+    }
+  if (!ValReg)
+    report_fatal_error("no free registers for the frame clearing stack mark");
+}
+
+// Loads the offset of the stack mark from the thread pointer (initial-exec
+// TLS, so tcmalloc must be loaded at startup).
+void X86FrameInit::loadStackMarkAddr(MachineBasicBlock &MBB,
+                                     MachineBasicBlock::iterator I,
+                                     unsigned AddrReg) {
+  DebugLoc DL = I != MBB.end() ? I->getDebugLoc() : DebugLoc();
+  BuildMI(MBB, I, DL, TII->get(X86::MOV64rm), AddrReg)
+    .addReg(X86::RIP).addImm(1).addReg(0)
+    .addExternalSymbol(StackMarkSymbol, X86II::MO_GOTTPOFF).addReg(0);
+}
+
+// Splits MBB at InsertPt for a frame area whose top is at RSP + Top: the empty
+// block returned, where the caller clears the area, is skipped if the area is
+// below the stack mark; ContBB gets the rest of MBB. The return address slot
+// just below the mark is written by every call before the callee can lower
+// the mark, so it doesn't count. (The comparison is unsigned, so areas on
+// other stacks are always cleared.)
+MachineBasicBlock *
+X86FrameInit::splitAtStackMark(MachineBasicBlock &MBB,
+                               MachineBasicBlock::iterator InsertPt,
+                               const LivePhysRegs &Live, int Top,
+                               MachineBasicBlock *&ContBB) {
+  MachineFunction &MF = *MBB.getParent();
+  DebugLoc DL = InsertPt != MBB.end() ? InsertPt->getDebugLoc() : DebugLoc();
+  unsigned AddrReg, ValReg;
+  findStackMarkRegs(Live, AddrReg, ValReg);
+
+  loadStackMarkAddr(MBB, InsertPt, AddrReg);
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::LEA64r), ValReg)
+    .addReg(X86::RSP).addImm(1).addReg(0).addImm(Top + 8).addReg(0);
+  addStackMarkField(BuildMI(MBB, InsertPt, DL, TII->get(X86::SUB64rm), ValReg)
+                      .addReg(ValReg), AddrReg, 0);
+  addStackMarkField(BuildMI(MBB, InsertPt, DL, TII->get(X86::CMP64rm))
+                      .addReg(ValReg), AddrReg, 1);
+
+  MachineBasicBlock *ClearBB = MF.CreateMachineBasicBlock();
+  ContBB = MF.CreateMachineBasicBlock();
+  MF.insert(std::next(MBB.getIterator()), ClearBB);
+  MF.insert(std::next(ClearBB->getIterator()), ContBB);
+  ContBB->splice(ContBB->end(), &MBB, InsertPt, MBB.end());
+  ContBB->transferSuccessors(&MBB);
+  MBB.addSuccessor(ClearBB);
+  MBB.addSuccessor(ContBB);
+  ClearBB->addSuccessor(ContBB);
+  addLiveIns(*ClearBB, Live, TRI);
+  addLiveIns(*ContBB, Live, TRI);
+  BuildMI(MBB, MBB.end(), DL, TII->get(X86::JBE_1)).addMBB(ContBB);
+  return ClearBB;
+}
+
+// Records, before I, that the stack from RSP + Bottom up may have been
+// written: lowers the mark there, unless it's lower already (or we're on
+// another stack). Functions which are open to code that doesn't keep the mark
+// drop it instead.
+void X86FrameInit::lowerStackMark(MachineBasicBlock &MBB,
+                                  MachineBasicBlock::iterator I,
+                                  const LivePhysRegs &Live, int Bottom) {
+  DebugLoc DL = I != MBB.end() ? I->getDebugLoc() : DebugLoc();
+  unsigned AddrReg, ValReg;
+  findStackMarkRegs(Live, AddrReg, ValReg);
+
+  loadStackMarkAddr(MBB, I, AddrReg);
+  if (StackMarkOpen) {
+    addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::MOV64mi32)),
+                      AddrReg, 1).addImm(0);
+    return;
+  }
+  BuildMI(MBB, I, DL, TII->get(X86::LEA64r), ValReg)
+    .addReg(X86::RSP).addImm(1).addReg(0).addImm(Bottom).addReg(0);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::SUB64rm), ValReg)
+                      .addReg(ValReg), AddrReg, 0);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::CMP64rm))
+                      .addReg(ValReg), AddrReg, 1);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::CMOVAE64rm), ValReg)
+                      .addReg(ValReg), AddrReg, 1);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::MOV64mr)), AddrReg, 1)
+    .addReg(ValReg);
+}
+
+// For a leaf function which has just cleared RSP + Bottom up to RSP + Top on
+// return: if the mark is still at Bottom, where the prologue lowered it,
+// nothing else has written there since, and we raise it back to Top.
+void X86FrameInit::raiseStackMark(MachineBasicBlock &MBB,
+                                  MachineBasicBlock::iterator I,
+                                  const LivePhysRegs &Live, int Bottom,
+                                  int Top) {
+  DebugLoc DL = I != MBB.end() ? I->getDebugLoc() : DebugLoc();
+  unsigned AddrReg, ValReg;
+  findStackMarkRegs(Live, AddrReg, ValReg);
+
+  loadStackMarkAddr(MBB, I, AddrReg);
+  BuildMI(MBB, I, DL, TII->get(X86::LEA64r), ValReg)
+    .addReg(X86::RSP).addImm(1).addReg(0).addImm(Bottom).addReg(0);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::SUB64rm), ValReg)
+                      .addReg(ValReg), AddrReg, 0);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::CMP64rm))
+                      .addReg(ValReg), AddrReg, 1);
+  BuildMI(MBB, I, DL, TII->get(X86::LEA64r), ValReg)
+    .addReg(ValReg).addImm(1).addReg(0).addImm(Top - Bottom).addReg(0);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::CMOVNE64rm), ValReg)
+                      .addReg(ValReg), AddrReg, 1);
+  addStackMarkField(BuildMI(MBB, I, DL, TII->get(X86::MOV64mr)), AddrReg, 1)
+    .addReg(ValReg);
+}
+
+// Picks a vector register of the store width which is free at the point
+// Live describes. The low eight come first, since SSE stores from them need no
+// REX prefix; the highest of those are the least likely to hold arguments (or
+// return values). Returns 0 if every one is live.
+unsigned X86FrameInit::findZeroReg(const LivePhysRegs &Live) {
+  static const MCPhysReg XMMs[] = {
+    X86::XMM7, X86::XMM6, X86::XMM5, X86::XMM4, X86::XMM3, X86::XMM2,
+    X86::XMM1, X86::XMM0, X86::XMM8, X86::XMM9, X86::XMM10, X86::XMM11,
+    X86::XMM12, X86::XMM13, X86::XMM14, X86::XMM15
+  };
+  for (MCPhysReg XMM : XMMs) {
+    unsigned Reg = XMM;
+    if (ChunkSize >= 32)
+      Reg = TRI->getMatchingSuperReg(Reg, X86::sub_xmm, &X86::VR256RegClass);
+    if (ChunkSize == 64)
+      Reg = TRI->getMatchingSuperReg(Reg, X86::sub_ymm, &X86::VR512RegClass);
+    if (!isLive(Live, Reg, TRI))
+      return Reg;
+  }
+  return 0;
+}
+
+// Clears the 8 bytes at RSP + Disp, for an area whose top isn't aligned.
+void X86FrameInit::clearQword(MachineBasicBlock &MBB,
+                              MachineBasicBlock::iterator InsertPt, int Disp) {
+  DebugLoc DL = InsertPt != MBB.end() ? InsertPt->getDebugLoc() : DebugLoc();
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::MOV64mi32))
+    .addReg(X86::RSP).addImm(1).addReg(0).addImm(Disp).addReg(0)
+    .addImm(0);
+}
+
+// Clears Chunks chunks below the first ClearFromOffset bytes of the frame (as
+// measured from RSP on entry) just before InsertPt in MBB, where RSP is
+// SPOffset bytes below its value on entry and Live holds the live registers.
+// Chunks set in Skip are left alone by the straight-line stores, which clear
+// the top of the area; the loop clears the rest. The loop is indexed by R11,
+// so we only have one if R11 and EFLAGS are free; besides those, nothing is
+// touched but the zeroed vector register and (see below) a base register.
+void X86FrameInit::clearArea(MachineBasicBlock &MBB,
+                             MachineBasicBlock::iterator InsertPt,
+                             const LivePhysRegs &Live, int SPOffset,
+                             unsigned ClearFromOffset, unsigned Chunks,
+                             const BitVector *Skip) {
+  MachineFunction &MF = *MBB.getParent();
+  DebugLoc DL = InsertPt != MBB.end() ? InsertPt->getDebugLoc() : DebugLoc();
+
+  unsigned ZeroReg = findZeroReg(Live);
+  unsigned LoopCount = 0;
+  if (!isLive(Live, X86::R11, TRI) && !isLive(Live, X86::EFLAGS, TRI))
+    LoopCount = Chunks / 4;
+  if (LoopCount < 2)
+    LoopCount = 0;
+  unsigned CountInFirstBlock = Chunks - 4 * LoopCount;
+  int LoopBytes = ChunkSize * 4 * LoopCount;
+  int Top = SPOffset - ClearFromOffset;
+  // (the loop stores to R11 + LoopDisp onwards, below the straight-line ones)
+  int LoopDisp = Top - ChunkSize * CountInFirstBlock;
+
+  // Addressing the stores from RSP takes a SIB byte, and big frames need
+  // 4-byte displacements. If a register is free, it can be cheaper to point
+  // it at the bottom of the stores first (with EVEX, displacements are scaled
+  // by the chunk size, otherwise we offset it to use the negative ones too).
+  unsigned Base = X86::RSP;
+  int BaseDisp = 0;
+  if (ZeroReg && Chunks) {
+    auto DispSize = [&](int Disp) {
+      if (ChunkSize == 64)
+        return Disp % 64 == 0 && isInt<8>(Disp / 64) ? 1 : 4;
+      return isInt<8>(Disp) ? 1 : 4;
+    };
+    int NewBaseDisp = LoopDisp + (ChunkSize == 64 ? 0 : 128);
+    int Saving = -(4 + (isInt<8>(NewBaseDisp) ? 1 : 4)); // the LEA
+    for (unsigned n = 0; n < CountInFirstBlock; ++n) {
+      int Disp = Top - ChunkSize*(n+1);
+      Saving += 1 + DispSize(Disp) - DispSize(Disp - NewBaseDisp);
+    }
+    for (unsigned n = 0; LoopCount && n < 4; ++n) {
+      int Disp = LoopDisp + ChunkSize*n;
+      Saving += DispSize(Disp) - DispSize(Disp - NewBaseDisp);
+    }
+    static const MCPhysReg BaseRegs[] = {
+      X86::RAX, X86::RCX, X86::RDX, X86::RSI, X86::RDI, X86::R8, X86::R9,
+      X86::R10
+    };
+    for (MCPhysReg Reg : BaseRegs)
+      if (Saving > 0 && !isLive(Live, Reg, TRI)) {
+        Base = Reg;
+        BaseDisp = NewBaseDisp;
+        break;
+      }
+  }
+
+  // Without a free vector register, we store immediate zeroes instead.
+  auto BuildStore = [&](MachineBasicBlock &BB, MachineBasicBlock::iterator I,
+                        unsigned Index, int Disp) {
+    if (ZeroReg) {
+      BuildMI(BB, I, DL, TII->get(StoreOpc))
+        .addReg(Base).addImm(1).addReg(Index).addImm(Disp - BaseDisp).addReg(0)
+        .addReg(ZeroReg);
+      return;
+    }
+    for (unsigned B = 0; B < ChunkSize; B += 8)
+      BuildMI(BB, I, DL, TII->get(X86::MOV64mi32))
+        .addReg(Base).addImm(1).addReg(Index).addImm(Disp - BaseDisp + B)
+        .addReg(0).addImm(0);
+  };
+
+  if (Base != X86::RSP)
+    BuildMI(MBB, InsertPt, DL, TII->get(X86::LEA64r), Base)
+      .addReg(X86::RSP).addImm(1).addReg(0).addImm(BaseDisp).addReg(0);
+  if (Chunks && ZeroReg)
+    BuildMI(MBB, InsertPt, DL, TII->get(ZeroOpc), ZeroReg)
+      .addReg(ZeroReg, RegState::Undef).addReg(ZeroReg, RegState::Undef);
+  for (unsigned n = 0; n < CountInFirstBlock; ++n)
+    if (!Skip || !(*Skip)[n])
+      BuildStore(MBB, InsertPt, 0, Top - ChunkSize*(n+1));
+  if (!LoopCount)
+    return;
+
+  // R11 counts up from -LoopBytes to 0, clearing four chunks each time.
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::MOV64ri32), X86::R11)
+    .addImm(-LoopBytes);
+
+  MachineBasicBlock *LoopBB = MF.CreateMachineBasicBlock();
+  MachineBasicBlock *TailBB = MF.CreateMachineBasicBlock();
+  MF.insert(std::next(MBB.getIterator()), LoopBB);
+  MF.insert(std::next(LoopBB->getIterator()), TailBB);
+  TailBB->splice(TailBB->end(), &MBB, InsertPt, MBB.end());
+  TailBB->transferSuccessors(&MBB);
+  MBB.addSuccessor(LoopBB);
+  LoopBB->addSuccessor(LoopBB);
+  LoopBB->addSuccessor(TailBB);
+
+  // Whatever is live at InsertPt is live through the loop.
+  addLiveIns(*LoopBB, Live, TRI);
+  addLiveIns(*TailBB, Live, TRI);
+  LoopBB->addLiveIn(X86::R11);
+  if (ZeroReg)
+    LoopBB->addLiveIn(ZeroReg);
+  if (Base != X86::RSP)
+    LoopBB->addLiveIn(Base);
+  LoopBB->sortUniqueLiveIns();
+
+  for (unsigned n = 0; n < 4; ++n)
+    BuildStore(*LoopBB, LoopBB->end(), X86::R11, LoopDisp + ChunkSize*n);
+  unsigned AddOpc = isInt<8>(ChunkSize * 4) ? X86::ADD64ri8 : X86::ADD64ri32;
+  BuildMI(*LoopBB, LoopBB->end(), DL, TII->get(AddOpc), X86::R11)
+    .addReg(X86::R11).addImm(ChunkSize * 4);
+  BuildMI(*LoopBB, LoopBB->end(), DL, TII->get(X86::JNE_1)).addMBB(LoopBB);
+}
+
+// Finds the frame objects of allocas which SafeInit initializes in IR, under
+// the "mixed" policy: those not marked !frame_zeroinit. Objects which aren't
+// allocas (spill slots aside) are for us to clear. If StackColoring merged a
+// marked alloca into another's slot, we can't tell which slot that is, so
+// then we clear them all.
+void X86FrameInit::findIRObjects(MachineFunction &MF,
+                                 SmallVectorImpl<int> &FIs) {
+  MachineFrameInfo *MFI = MF.getFrameInfo();
+  SmallVector<int, 8> IRObjects;
+  for (int FI = MFI->getObjectIndexBegin(); FI != MFI->getObjectIndexEnd(); ++FI) {
+    const AllocaInst *AI = MFI->getObjectAllocation(FI);
+    if (!AI)
+      continue;
+    if (AI->getMetadata("frame_zeroinit")) {
+      if (MFI->isDeadObjectIndex(FI))
+        return;
+      continue;
+    }
+    if (!MFI->isDeadObjectIndex(FI) && MFI->getObjectSize(FI))
+      IRObjects.push_back(FI);
+  }
+  FIs.append(IRObjects.begin(), IRObjects.end());
+}
+
+// Finds the frame objects which MBB writes in full, from Begin (just after the
+// prologue), before anything can read them: that is, before any call, or any
+// load we can't attribute to a frame object. These include allocas cleared by
+// SafeInit memsets which were lowered to stores. Anything else is left to be
+// cleared.
+void X86FrameInit::findInitializedObjects(MachineBasicBlock &MBB,
+                                          MachineBasicBlock::iterator Begin,
+                                          SmallVectorImpl<int> &FIs) {
+  const uint64_t MaxTrackedSize = 4096;
+  MachineFunction &MF = *MBB.getParent();
+  MachineFrameInfo *MFI = MF.getFrameInfo();
+  const DataLayout &DL = MF.getDataLayout();
+
+  DenseMap<const Value *, int> AllocaFIs;
+  for (int FI = MFI->getObjectIndexBegin(); FI != MFI->getObjectIndexEnd(); ++FI)
+    if (!MFI->isDeadObjectIndex(FI))
+      if (const AllocaInst *AI = MFI->getObjectAllocation(FI))
+        AllocaFIs[AI] = FI;
+
+  // Finds the object and range within it accessed through MMO.
+  auto Resolve = [&](const MachineMemOperand *MMO, int &FI, uint64_t &Offset) {
+    int64_t Off = MMO->getOffset();
+    if (const PseudoSourceValue *PSV = MMO->getPseudoValue()) {
+      auto *FS = dyn_cast<FixedStackPseudoSourceValue>(PSV);
+      if (!FS)
+        return false;
+      FI = FS->getFrameIndex();
+    } else {
+      if (!MMO->getValue())
+        return false;
+      int64_t BaseOff = 0;
+      const Value *Base =
+          GetPointerBaseWithConstantOffset(MMO->getValue(), BaseOff, DL);
+      auto I = AllocaFIs.find(Base);
+      if (I == AllocaFIs.end())
+        return false;
+      FI = I->second;
+      Off += BaseOff;
+    }
+    if (Off < 0 || Off + (int64_t)MMO->getSize() > MFI->getObjectSize(FI))
+      return false;
+    Offset = Off;
+    return true;
+  };
+
+  DenseMap<int, BitVector> Written;
+  DenseSet<int> Read;
+  for (auto I = Begin, E = MBB.end(); I != E; ++I) {
+    MachineInstr &MI = *I;
+    if (MI.isCall() || MI.hasUnmodeledSideEffects() ||
+        (MI.mayLoadOrStore() && MI.memoperands_empty()))
+      break;
+
+    // Loads first, for read-modify-write instructions.
+    bool Stop = false;
+    for (MachineMemOperand *MMO : MI.memoperands()) {
+      if (!MMO->isLoad())
+        continue;
+      int FI;
+      uint64_t Offset;
+      if (!Resolve(MMO, FI, Offset)) {
+        const PseudoSourceValue *PSV = MMO->getPseudoValue();
+        if (PSV && PSV->isConstant(MFI))
+          continue;
+        Stop = true;
+        break;
+      }
+      BitVector &W = Written[FI];
+      for (uint64_t B = Offset, E = Offset + MMO->getSize(); B != E; ++B)
+        if (B >= W.size() || !W[B]) {
+          Read.insert(FI);
+          break;
+        }
+    }
+    if (Stop)
+      break;
+    for (MachineMemOperand *MMO : MI.memoperands()) {
+      int FI;
+      uint64_t Offset;
+      if (!MMO->isStore() || !Resolve(MMO, FI, Offset) ||
+          MFI->getObjectSize(FI) > (int64_t)MaxTrackedSize)
+        continue;
+      BitVector &W = Written[FI];
+      W.resize(MFI->getObjectSize(FI));
+      W.set(Offset, Offset + MMO->getSize());
+    }
+  }
+
+  for (auto &W : Written)
+    if (!Read.count(W.first) && W.second.size() && W.second.all())
+      FIs.push_back(W.first);
+}
+
+// Clears Size bytes below the first ClearFromOffset bytes of the frame with
+// rep stosq, just before InsertPt, where RSP is SPOffset bytes below its value
+// on entry. The caller makes sure RAX, RCX and RDI are free; EFLAGS needn't be.
+void X86FrameInit::clearWithRepStos(MachineBasicBlock &MBB,
+                                    MachineBasicBlock::iterator InsertPt,
+                                    int SPOffset, unsigned ClearFromOffset,
+                                    unsigned Size) {
+  DebugLoc DL = InsertPt != MBB.end() ? InsertPt->getDebugLoc() : DebugLoc();
+
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::LEA64r), X86::RDI)
+    .addReg(X86::RSP).addImm(1).addReg(0)
+    .addImm(SPOffset - int(ClearFromOffset + Size)).addReg(0);
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::MOV32ri), X86::ECX).addImm(Size / 8);
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::MOV32ri), X86::EAX).addImm(0);
+  BuildMI(MBB, InsertPt, DL, TII->get(X86::REP_STOSQ_64));
+}
+
+// Everything initFrame adds (clearing code, and the stack mark's upkeep) is
+// flagged as init code, for AsmPrinter's -safeinit-size-section.
 bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
-  if (!(EnableFrameInit || EnableFrameClear))
+  SmallPtrSet<const MachineInstr *, 32> Existing;
+  for (MachineBasicBlock &MBB : MF)
+    for (MachineInstr &MI : MBB)
+      Existing.insert(&MI);
+
+  if (!initFrame(MF))
+    return false;
+
+  for (MachineBasicBlock &MBB : MF)
+    for (MachineInstr &MI : MBB)
+      if (!Existing.count(&MI))
+        MI.setFlag(MachineInstr::SafeInit);
+  return true;
+}
+
+bool X86FrameInit::initFrame(MachineFunction &MF) {
+  getFramePolicy(*MF.getFunction(), DoFrameInit, DoFrameClear, Mixed);
+
+  // Frames of over a page may have been cleared as the prologue allocated
+  // them (see X86FrameLowering::emitFrameClearInline).
+  if (MF.getInfo<X86MachineFunctionInfo>()->getFrameClearedInPrologue())
+    DoFrameInit = false;
+
+  if (!(DoFrameInit || DoFrameClear))
     return false;
 
-  PrologueBlocks.clear();
   EpilogueBlocks.clear();
 
   STI = &static_cast<const X86Subtarget &>(MF.getSubtarget());
@@ -68,11 +762,30 @@ bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
   TRI = STI->getRegisterInfo();
   X86FL = STI->getFrameLowering();
 
-  bool hasFP = X86FL->hasFP(MF);
+  // We only know the x86-64 SysV frame layout (no funclets! no stack probing!),
+  // and naked functions have no frame. SafeInit initializes these functions'
+  // stack in IR instead (see canClearFrame there), so just leave them alone.
+  if (!X86FL->Is64Bit || STI->isTargetWin64() ||
+      MF.getFunction()->hasFnAttribute(Attribute::Naked))
+    return false;
 
-  // also no Windows support (no funclets! no stack probing!) and many other limitations
-  assert(X86FL->Is64Bit && "only 64-bit mode is supported");
-  assert(!MF.getFunction()->hasFnAttribute(Attribute::Naked) && "naked functions not supported");
+  // The stack mark is kept by the functions whose prologue we clear. If we
+  // call code which doesn't keep it, we drop it in the prologue, and again
+  // after any reset, which would otherwise hand that code a valid mark.
+  StackMark = FrameInitStackMark && DoFrameInit;
+  if (StackMark) {
+    StackMarkOpen = isOpenToStackMark(MF, HasCalls);
+    if (StackMarkOpen)
+      for (MachineBasicBlock &MBB : MF)
+        for (auto I = MBB.begin(), E = MBB.end(); I != E; ++I)
+          if (I->isCall() && isStackMarkReset(I->getOperand(0))) {
+            LivePhysRegs Live;
+            computeLiveness(Live, MBB, std::next(I), TRI);
+            lowerStackMark(MBB, std::next(I), Live, 0);
+          }
+  }
+
+  bool hasFP = X86FL->hasFP(MF);
 
   MachineFrameInfo *MFI = MF.getFrameInfo();
   X86MachineFunctionInfo *X86FI = MF.getInfo<X86MachineFunctionInfo>();
@@ -82,20 +795,17 @@ bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
   /*unsigned StackSize = MFI->getStackSize() + 8;*/
   unsigned StackSize = MFI->getStackSize();
 
-  // we don't yet add a slot after checking getRestoreBasePointer() for SJLJ exceptions
-  assert(!X86FI->getRestoreBasePointer());
-
-  // We can't (easily) work out how much of the red zone is used.
-  // -> Alyssa hacked this into X86FI.
+  // In the red zone, the frame extends below RSP as far as the lowest object
+  // does, which is all that needs clearing (rather than the whole 128 bytes,
+  // or the frame size rounded up for alignment). Objects are 8 below the
+  // entry RSP (see below).
   if (X86FI->getUsesRedZone()) {
-    // TODO: I'm distrustful of the LLVM code for this. And so also this :(
-    unsigned oldSize = X86FI->getPreRedZoneSize();
-    dbgs() << "red zone use in " << MF.getFunction()->getName() << " was " << oldSize << "\n";
-
-    if (oldSize >= 128)
-      StackSize += 128; // entire red zone used
-    else
-      StackSize += oldSize; // partial red zone used
+    int64_t UsedSize = 0;
+    for (int n = MFI->getObjectIndexBegin(); n != MFI->getObjectIndexEnd(); ++n)
+      if (!MFI->isDeadObjectIndex(n) && MFI->getObjectSize(n))
+        UsedSize = std::max(UsedSize, -(MFI->getObjectOffset(n) + 8));
+    DEBUG(dbgs() << "red zone use in " << MF.getFunction()->getName() << " is " << UsedSize - StackSize << "\n");
+    StackSize = std::max<int64_t>(StackSize, UsedSize);
   }
 
   // sp-8 points to:
@@ -104,12 +814,11 @@ bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
   // <alignment>
   // [spilled non-GPRs]
 
-  // We don't know whether any realignment will happen, so we just assume the worst-case.
-  // FIXME: X86FL->calculateMaxStackAlign(MF) is private :-/ (but this is OK for our purposes)
-  if (MFI->getLocalFrameMaxAlign() > 16) {
-    dbgs() << "need to adjust for frame max align in " << MF.getFunction()->getName() << ", which is " << MFI->getLocalFrameMaxAlign() << "\n";
-    StackSize += MFI->getLocalFrameMaxAlign();
-  }
+  // We clear after the prologue, addressing the frame from RSP just like the
+  // frame lowering does, so realignment doesn't change our offsets: locals are
+  // at RSP + getObjectOffset + 8 + getStackSize either way. (It does mean the
+  // 16-byte stores can't assume alignment, see below.)
+  bool Realigned = TRI->needsStackRealignment(MF);
 
   // We don't need to clear spilled registers.
   // The frame lowering always helpfully puts them first, too.
@@ -130,6 +839,12 @@ bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
     }
   }
 
+  // SJLJ exception handling stashes the base pointer in an extra slot below
+  // the saved registers (see X86FrameLowering::emitPrologue); don't clear it.
+  if (X86FI->getRestoreBasePointer())
+    MinimumSpilledOffset = std::min(MinimumSpilledOffset,
+                                    X86FI->getRestoreBasePointerOffset() - 16);
+
   // TODO: make sure we never have to care about MFI->getOffsetAdjustment()
 
   // Sometimes there are normal allocations overlapping, so we need to adjust. TODO: wtf
@@ -161,8 +876,18 @@ bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
 
   dbgs() << "going to clear " << StackSizeToClear << " bytes (of " << StackSize << ") in " << MF.getFunction()->getName() << " (spilled size is " << SpilledStackSize << ")\n";
 
-  if (!StackSizeToClear)
-    return false;
+  if (!StackSizeToClear) {
+    // There's still the mark to keep, unless we write nothing below our
+    // return address.
+    if (!StackMark || (!HasCalls && !StackMarkOpen && !MFI->getStackSize()))
+      return false;
+    MachineBasicBlock *PrologueBB;
+    MachineBasicBlock::iterator InsertPt = findPrologueEnd(MF, PrologueBB);
+    LivePhysRegs Live;
+    computeLiveness(Live, *PrologueBB, InsertPt, TRI);
+    lowerStackMark(*PrologueBB, InsertPt, Live, 0);
+    return true;
+  }
 
   // esp-8 is aligned on function entry
   // we want to clear an aligned number of 16-byte chunks
@@ -174,155 +899,182 @@ bool X86FrameInit::runOnMachineFunction(MachineFunction &MF) {
     StackSizeToClear = 8;
   }
 
-  // Is the start offset going to write beyond our stack if we align it?
-  if (ClearFromOffset == 0) {
-    // If so, manually clear the first 8 bytes.
+  // Is the start offset unaligned? The registers are already saved when we
+  // clear, so we can't round the area up over them: manually clear the first
+  // 8 bytes instead.
+  if (ClearFromOffset % 16 != 8) {
     UnalignedClearFirst = true;
     ClearFromOffset += 8;
     assert(StackSizeToClear >= 8);
     StackSizeToClear -= 8;
   }
 
-  // Is the start offset otherwise unaligned?
-  if (ClearFromOffset % 16 != 8) {
-    assert(ClearFromOffset >= 8);
-    // If so, just clear an extra 8 bytes.
-    ClearFromOffset -= 8;
-    StackSizeToClear += 8;
+  assert(ClearFromOffset % 16 == 8);
+
+  // Clear with the widest vector stores we have. Only the 16-byte chunks are
+  // aligned; the wider stores are unaligned ones. (On AVX-512 targets
+  // X86IssueVZeroUpper does nothing, otherwise it sees the YMM use.)
+  ChunkSize = getX86FrameInitChunkSize(*STI);
+  if (ChunkSize == 64) {
+    StoreOpc = X86::VMOVUPSZmr;
+    ZeroOpc = X86::VPXORDZrr;
+  } else if (ChunkSize == 32) {
+    StoreOpc = X86::VMOVUPSYmr;
+    ZeroOpc = X86::VXORPSYrr;
+  } else if (Realigned) {
+    // RSP is aligned to more than 16, but not necessarily so that our area is.
+    StoreOpc = STI->hasAVX() ? X86::VMOVUPSmr : X86::MOVUPSmr;
+    ZeroOpc = STI->hasAVX() ? X86::VXORPSrr : X86::XORPSrr;
+  } else {
+    // Avoid SSE/AVX transitions when the wider stores were turned off.
+    StoreOpc = STI->hasAVX() ? X86::VMOVAPSmr : X86::MOVAPSmr;
+    ZeroOpc = STI->hasAVX() ? X86::VXORPSrr : X86::XORPSrr;
   }
 
-  assert(ClearFromOffset % 16 == 8);
+  // We always clear in whole chunks, to keep this simple.
+  StackSizeToClear = alignTo(StackSizeToClear, ChunkSize);
+  assert(StackSizeToClear % ChunkSize == 0);
+  unsigned BytesToClear = StackSizeToClear;
+  StackSizeToClear /= ChunkSize;
 
-  // We always clear in 16-byte chunks, to keep this simple.
-  StackSizeToClear = alignTo(StackSizeToClear, 16);
-  assert(StackSizeToClear % 16 == 0);
-  StackSizeToClear /= 16;
-
-  // notes:
-  // stack starts at MFI->getOffsetOfLocalArea() which is always -8 for us
-  // alignment is MFI->getStackAlignment() which is usually(?) 16 for us, there will be no skew
-
-  // TODO: using offsets beyond -0x80 add 3 bytes to each movaps instruction
-  //        if we have one loop then that's 12 bytes, so in some cases (1 loop plus >1 before-loop inst)
-  //        it's more efficient for code-size if we adjust the stack anyway (14 bytes)
-  //        (but this is really micro-optimizing)
-
-  if (EnableFrameInit) {
-    PrologueBlocks.push_back(MF.front().getNumber());
-
-    for (auto MBBN : PrologueBlocks) {
-      auto MBB = MF.getBlockNumbered(MBBN);
-
-      unsigned CountInFirstBlock = StackSizeToClear % 4;
-      unsigned LoopCount = StackSizeToClear / 4;
-      MachineBasicBlock *FirstBB = MBB;
-      MachineBasicBlock *LoopBB = MBB;
-
-      if (StackSizeToClear > 4) {
-        FirstBB = MF.CreateMachineBasicBlock();
-        LoopBB = MF.CreateMachineBasicBlock();
-        MF.push_front(LoopBB);
-        MF.push_front(FirstBB);
-        MBB = MF.getBlockNumbered(MBBN); // Probably the pointer changed.
-        FirstBB->addSuccessor(LoopBB);
-
-        // The loop header sets R11 (only always-available scratch register).
-        if (LoopCount > 1)
-          BuildMI(*FirstBB, FirstBB->end(), DebugLoc(), TII->get(X86::MOV32ri), X86::R11).addImm(LoopCount);
-
-        // The loop itself decrements R11 (by 1) and RSP (by 16*4), until R11 is zero.
-        LoopBB->addSuccessor(LoopBB);
-        LoopBB->addSuccessor(MBB);
-        if (LoopCount > 1) {
-          BuildMI(*LoopBB, LoopBB->end(), DebugLoc(), TII->get(X86::SUB64ri8), X86::RSP).addReg(X86::RSP).addImm(16 * 4);
-          BuildMI(*LoopBB, LoopBB->end(), DebugLoc(), TII->get(X86::SUB64ri8), X86::R11).addReg(X86::R11).addImm(1);
-          BuildMI(*LoopBB, LoopBB->end(), DebugLoc(), TII->get(X86::JNE_1)).addMBB(LoopBB);
-        }
-      } else {
-        LoopCount = 0;
-        CountInFirstBlock = StackSizeToClear;
-      }
+  // Clearing on return is for scrubbing what the function wrote, so it
+  // always covers the whole area.
+  unsigned ExitClearFromOffset = ClearFromOffset;
+  unsigned ExitChunks = StackSizeToClear;
 
-      auto StackRestorePoint = MBB->begin();
+  // We clear right after the prologue.
+  MachineBasicBlock *PrologueBB;
+  MachineBasicBlock::iterator InsertPt = findPrologueEnd(MF, PrologueBB);
+  int SPOffset = MFI->getStackSize();
 
-      // We have to adjust RSP to skip over the bit we don't clear.
-      // (We do this just before we enter the loop.)
-      int FirstStackAdjustment = ClearFromOffset;
-      if (CountInFirstBlock) {
-        FirstStackAdjustment += 16 * CountInFirstBlock;
-      }
-      if (LoopCount > 1) {
-        auto SAI = BuildMI(*FirstBB, FirstBB->begin(), DebugLoc(), TII->get(X86::SUB64ri32), X86::RSP).addReg(X86::RSP).addImm(FirstStackAdjustment);
-        SAI->getOperand(3).setIsDead(); // eflags is dead
-      }
+  // The whole area, from RSP after the prologue, for the stack mark.
+  int AreaTop =
+      SPOffset - int(ExitClearFromOffset) + (UnalignedClearFirst ? 8 : 0);
+  int AreaBottom = SPOffset - int(ExitClearFromOffset + ExitChunks * ChunkSize);
 
-      for (unsigned n = 0; n < CountInFirstBlock + 4; ++n) {
-        MachineBasicBlock *BB;
-        int Disp;
-        if (n < CountInFirstBlock) {
-          BB = FirstBB;
-          Disp = -16*(n+1) - ClearFromOffset; // RSP wasn't adjusted yet.
-        } else {
-          if (!LoopCount)
-            break;
-          BB = LoopBB;
-          Disp = -16*(n+1-CountInFirstBlock);
-          // we don't bother adjusting RSP in this case
-          if (LoopCount == 1)
-            Disp = -16*(n+1-CountInFirstBlock) - FirstStackAdjustment;
-        }
+  // For the prologue, find the chunks lying entirely within objects that are
+  // written before being read, and which no other object overlaps. Object
+  // offsets are 8 below the entry RSP (see above).
+  SkipChunk.clear();
+  SkipChunk.resize(StackSizeToClear);
+  SmallVector<int, 8> Initialized;
+  if (DoFrameInit && SelectiveFrameInit) {
+    findInitializedObjects(*PrologueBB, InsertPt, Initialized);
+    // Arrays filled by loops (see markLoopInitializedObject in
+    // SelectionDAGBuilder).
+    for (int FI = 0; FI != MFI->getObjectIndexEnd(); ++FI)
+      if (!MFI->isDeadObjectIndex(FI) && MFI->isLoopInitializedObjectIndex(FI))
+        Initialized.push_back(FI);
+  }
+  if (DoFrameInit && Mixed)
+    findIRObjects(MF, Initialized);
+  if (!Initialized.empty()) {
+    // Bit B stands for the byte at RSP - ClearFromOffset - BytesToClear + B.
+    BitVector SkipByte(BytesToClear);
+    auto MarkObject = [&](int FI, bool Skip) {
+      int64_t Begin = MFI->getObjectOffset(FI) + 8 + int64_t(ClearFromOffset) +
+                      BytesToClear;
+      int64_t End = std::min(Begin + int64_t(MFI->getObjectSize(FI)),
+                             int64_t(BytesToClear));
+      Begin = std::max(Begin, int64_t(0));
+      if (Begin >= End)
+        return;
+      if (Skip)
+        SkipByte.set(Begin, End);
+      else
+        SkipByte.reset(Begin, End);
+    };
+    for (int FI : Initialized)
+      MarkObject(FI, true);
+    for (int FI = MFI->getObjectIndexBegin(); FI != MFI->getObjectIndexEnd(); ++FI)
+      if (!MFI->isDeadObjectIndex(FI) && MFI->getObjectSize(FI) &&
+          std::find(Initialized.begin(), Initialized.end(), FI) == Initialized.end())
+        MarkObject(FI, false);
+    for (unsigned k = 0; k < StackSizeToClear; ++k) {
+      unsigned Begin = BytesToClear - ChunkSize * (k + 1);
+      bool All = true;
+      for (unsigned B = Begin; All && B != Begin + ChunkSize; ++B)
+        All = SkipByte[B];
+      if (All)
+        SkipChunk.set(k);
+    }
 
-        // mod r/m is sort of documented in lib/Target/X86/X86InstrBuilder.h
-        //BuildMI(*BB, BB->begin(), DebugLoc(), TII->get(X86::MOVUPSmr))
-        BuildMI(*BB, BB->begin(), DebugLoc(), TII->get(X86::MOVAPSmr)) // movaps isn't necessary, but just to be sure we didn't screw up the alignment..
-          .addReg(X86::RSP) // base
-          .addImm(1) // scale
-          .addReg(0) // index
-          .addImm(Disp) // displacement
-          .addReg(0) // segment
-          // src
-          .addReg(X86::XMM8)
-          ;
-      }
+    // Trim skipped chunks off both ends; holes are only skipped by the
+    // straight-line stores.
+    unsigned Top = 0;
+    while (Top < StackSizeToClear && SkipChunk[Top])
+      ++Top;
+    while (StackSizeToClear > Top && SkipChunk[StackSizeToClear - 1])
+      --StackSizeToClear;
+    BitVector Trimmed(StackSizeToClear - Top);
+    for (unsigned k = Top; k < StackSizeToClear; ++k)
+      if (SkipChunk[k])
+        Trimmed.set(k - Top);
+    SkipChunk = Trimmed;
+    StackSizeToClear -= Top;
+    ClearFromOffset += ChunkSize * Top;
+    BytesToClear = ChunkSize * StackSizeToClear;
+    DEBUG(dbgs() << "skipping " << SkipChunk.count() + Top << " chunks of initialized objects\n");
+  }
 
-      // FIXME: use xmm7 instead (no rex prefix) if it's available
-      if (StackSizeToClear)
-        BuildMI(*FirstBB, FirstBB->begin(), DebugLoc(), TII->get(X86::XORPSrr), X86::XMM8).addReg(X86::XMM8).addReg(X86::XMM8);
-
-      if (UnalignedClearFirst) {
-        BuildMI(*FirstBB, FirstBB->begin(), DebugLoc(), TII->get(X86::MOV64mi32))
-          .addReg(X86::RSP) // base
-          .addImm(1) // scale
-          .addReg(0) // index
-          .addImm(-ClearFromOffset) // displacement
-          .addReg(0) // segment
-          // src
-          .addImm(0)
-          ;
-      }
+  // Very large frames are cleared faster with rep stosq, but that needs RAX,
+  // RCX and RDI, which may hold arguments (AL does for varargs functions).
+  if (DoFrameInit) {
+    LivePhysRegs Live;
+    computeLiveness(Live, *PrologueBB, InsertPt, TRI);
+    bool UseRepStos = FrameInitRepStosThreshold &&
+      BytesToClear >= FrameInitRepStosThreshold &&
+      !isLive(Live, X86::RAX, TRI) && !isLive(Live, X86::RCX, TRI) &&
+      !isLive(Live, X86::RDI, TRI);
 
-      if (LoopCount > 1) {
-        // Restore the stack pointer.
-        int RestoreStackOffset = (16 * StackSizeToClear) + ClearFromOffset;
-        // This only works if there's no FP (maybe we can do better someday).
-        // FIXME: check if this is ok
-        RestoreStackOffset -= X86FL->mergeSPUpdates(*MBB, StackRestorePoint, false);
-        if (RestoreStackOffset) {
-          auto SRI = BuildMI(*MBB, StackRestorePoint, DebugLoc(), TII->get(X86::ADD64ri32),
-            X86::RSP).addReg(X86::RSP).addImm(RestoreStackOffset);
-          SRI->getOperand(3).setIsDead(); // eflags is dead
-        }
-      }
+    // Below the stack mark, the area is zero already.
+    MachineBasicBlock *ClearBB = PrologueBB, *ContBB = PrologueBB;
+    MachineBasicBlock::iterator ClearPt = InsertPt, ContPt = InsertPt;
+    if (StackMark) {
+      ClearBB = splitAtStackMark(*PrologueBB, InsertPt, Live, AreaTop, ContBB);
+      ClearPt = ClearBB->end();
+      ContPt = ContBB->begin();
     }
+
+    if (UnalignedClearFirst)
+      clearQword(*ClearBB, ClearPt, SPOffset - ExitClearFromOffset);
+    if (UseRepStos)
+      clearWithRepStos(*ClearBB, ClearPt, SPOffset, ClearFromOffset,
+                       BytesToClear);
+    else
+      clearArea(*ClearBB, ClearPt, Live, SPOffset, ClearFromOffset,
+                StackSizeToClear, &SkipChunk);
+
+    if (StackMark)
+      lowerStackMark(*ContBB, ContPt, Live, std::min(AreaBottom, 0));
   }
 
-  if (EnableFrameClear) {
+  // The epilogue has already popped the frame when we clear on return, so
+  // RSP is back where it was on entry; the stores go to the dead area below.
+  if (DoFrameClear) {
+    // Leaf functions can give back the stack they cleared, if the prologue
+    // lowered the mark to exactly the bottom of the area (with realignment,
+    // we don't know where the area is from the entry RSP).
+    bool RaiseMark = StackMark && !StackMarkOpen && !HasCalls &&
+                     !Realigned && AreaBottom <= 0;
+
     for (MachineBasicBlock &MBB : MF) {
       if (MBB.isReturnBlock())
         EpilogueBlocks.push_back(MBB.getNumber());
     }
 
-    // TODO
+    for (auto MBBN : EpilogueBlocks) {
+      MachineBasicBlock &MBB = *MF.getBlockNumbered(MBBN);
+      auto Term = MBB.getFirstTerminator();
+      LivePhysRegs Live;
+      computeLiveness(Live, MBB, Term, TRI);
+      if (UnalignedClearFirst)
+        clearQword(MBB, Term, -ExitClearFromOffset);
+      clearArea(MBB, Term, Live, 0, ExitClearFromOffset, ExitChunks, nullptr);
+      if (RaiseMark)
+        raiseStackMark(*Term->getParent(), Term, Live, AreaBottom - SPOffset,
+                       AreaTop - SPOffset);
+    }
   }
 
   return true;
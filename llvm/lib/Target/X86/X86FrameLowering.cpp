@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "X86FrameLowering.h"
+#include "X86.h"
 #include "X86InstrBuilder.h"
 #include "X86InstrInfo.h"
 #include "X86MachineFunctionInfo.h"
@@ -461,19 +462,35 @@ MachineInstr *X86FrameLowering::emitStackProbe(MachineFunction &MF,
   }
 }
 
+// The stub emitPrologue leaves where it allocates a frame it clears.
+static const char FrameClearStubSymbol[] = "__frame_clear_stub";
+
 void X86FrameLowering::inlineStackProbe(MachineFunction &MF,
                                         MachineBasicBlock &PrologMBB) const {
   const StringRef ChkStkStubSymbol = "__chkstk_stub";
   MachineInstr *ChkStkStub = nullptr;
+  MachineInstr *FrameClearStub = nullptr;
 
   for (MachineInstr &MI : PrologMBB) {
-    if (MI.isCall() && MI.getOperand(0).isSymbol() &&
-        ChkStkStubSymbol == MI.getOperand(0).getSymbolName()) {
-      ChkStkStub = &MI;
-      break;
+    if (MI.isCall() && MI.getOperand(0).isSymbol()) {
+      if (ChkStkStubSymbol == MI.getOperand(0).getSymbolName())
+        ChkStkStub = &MI;
+      else if (StringRef(FrameClearStubSymbol) ==
+               MI.getOperand(0).getSymbolName())
+        FrameClearStub = &MI;
     }
   }
 
+  if (FrameClearStub != nullptr) {
+    MachineBasicBlock::iterator MBBI =
+        std::next(FrameClearStub->getIterator());
+    DebugLoc DL = PrologMBB.findDebugLoc(MBBI);
+    emitFrameClearInline(
+        MF, PrologMBB, MBBI, DL,
+        MF.getInfo<X86MachineFunctionInfo>()->getFrameClearedInPrologue());
+    FrameClearStub->eraseFromParent();
+  }
+
   if (ChkStkStub != nullptr) {
     assert(!ChkStkStub->isBundled() &&
            "Not expecting bundled instructions here");
@@ -778,6 +795,165 @@ MachineInstr *X86FrameLowering::emitStackProbeInlineStub(
   return MBBI;
 }
 
+bool X86FrameLowering::canClearFrameInPrologue(MachineFunction &MF,
+                                               MachineBasicBlock &MBB,
+                                               uint64_t NumBytes) const {
+  // Smaller frames are cleared by the frame clearing pass, after the
+  // prologue, which can skip objects written before they are read.
+  if (!Is64Bit || StackPtr != X86::RSP || NumBytes <= 4096 ||
+      !isInt<32>(NumBytes) || !canClearX86FrameInPrologue(MF))
+    return false;
+  const Function *Fn = MF.getFunction();
+  X86MachineFunctionInfo *X86FI = MF.getInfo<X86MachineFunctionInfo>();
+  if (MF.getTarget().getMCAsmInfo()->usesWindowsCFI() ||
+      STI.isCallingConvWin64(Fn->getCallingConv()) ||
+      X86FI->getUsesRedZone() || MBB.isEHFuncletEntry())
+    return false;
+
+  // The loop uses R11 and the vector register 15, which nothing may be passed
+  // in or expect to be preserved; shrink-wrapped prologues may have anything
+  // live, so we only clear in the entry block.
+  if (&MBB != &MF.front())
+    return false;
+  for (const auto &LI : MBB.liveins())
+    if (TRI->regsOverlap(LI.PhysReg, X86::R11) ||
+        TRI->regsOverlap(LI.PhysReg, X86::XMM15))
+      return false;
+  for (const MCPhysReg *CSR = TRI->getCalleeSavedRegs(&MF); *CSR; ++CSR)
+    if (TRI->regsOverlap(*CSR, X86::R11) || TRI->regsOverlap(*CSR, X86::XMM15))
+      return false;
+  return true;
+}
+
+void X86FrameLowering::emitFrameClearInline(MachineFunction &MF,
+                                            MachineBasicBlock &MBB,
+                                            MachineBasicBlock::iterator MBBI,
+                                            DebugLoc DL,
+                                            uint64_t NumBytes) const {
+  const BasicBlock *LLVM_BB = MBB.getBasicBlock();
+  const Function *Fn = MF.getFunction();
+
+  // Rather than moving RSP past the whole frame and clearing it afterwards,
+  // we move it a few chunks at a time, clearing each part as RSP reaches it.
+  // So the pages of the frame are touched in order, as stack-clash protection
+  // requires, and nothing is stored below RSP. R11 holds the final RSP, which
+  // the CFA is defined from until we get there.
+  //
+  // MBB:
+  //    R11 = RSP - NumBytes
+  //    ZeroReg = 0
+  //    RSP -= NumBytes % LoopBytes; clear [RSP, RSP + NumBytes % LoopBytes)
+  // LoopMBB:
+  //    RSP -= LoopBytes; clear [RSP, RSP + LoopBytes)
+  //    if (RSP != R11) goto LoopMBB
+  // ContinueMBB:
+  //    [rest of original MBB]
+  unsigned ChunkSize = getX86FrameInitChunkSize(STI);
+  const int64_t LoopBytes = 4 * ChunkSize;
+  const int64_t Remainder = NumBytes % LoopBytes;
+  assert(NumBytes >= (uint64_t)LoopBytes && NumBytes % 8 == 0 &&
+         "frame too small to clear in the prologue");
+
+  // Stores are unaligned: RSP is only 8-byte aligned between the pushes and
+  // the end of the prologue.
+  unsigned StoreOpc, ZeroOpc, ZeroReg;
+  if (ChunkSize == 64) {
+    StoreOpc = X86::VMOVUPSZmr;
+    ZeroOpc = X86::VPXORDZrr;
+    ZeroReg = X86::ZMM15;
+  } else if (ChunkSize == 32) {
+    StoreOpc = X86::VMOVUPSYmr;
+    ZeroOpc = X86::VXORPSYrr;
+    ZeroReg = X86::YMM15;
+  } else {
+    StoreOpc = STI.hasAVX() ? X86::VMOVUPSmr : X86::MOVUPSmr;
+    ZeroOpc = STI.hasAVX() ? X86::VXORPSrr : X86::XORPSrr;
+    ZeroReg = X86::XMM15;
+  }
+
+  // Set up the new basic blocks.
+  MachineBasicBlock *LoopMBB = MF.CreateMachineBasicBlock(LLVM_BB);
+  MachineBasicBlock *ContinueMBB = MF.CreateMachineBasicBlock(LLVM_BB);
+  MachineFunction::iterator MBBIter = std::next(MBB.getIterator());
+  MF.insert(MBBIter, LoopMBB);
+  MF.insert(MBBIter, ContinueMBB);
+
+  // Split MBB and move the tail portion down to ContinueMBB.
+  MachineBasicBlock::iterator BeforeMBBI = std::prev(MBBI);
+  ContinueMBB->splice(ContinueMBB->begin(), &MBB, MBBI, MBB.end());
+  ContinueMBB->transferSuccessorsAndUpdatePHIs(&MBB);
+  MBB.addSuccessor(LoopMBB);
+  LoopMBB->addSuccessor(LoopMBB);
+  LoopMBB->addSuccessor(ContinueMBB);
+
+  // Whatever is live into the prologue is live through the loop.
+  for (const auto &LI : MBB.liveins()) {
+    LoopMBB->addLiveIn(LI);
+    ContinueMBB->addLiveIn(LI);
+  }
+  LoopMBB->addLiveIn(X86::R11);
+  LoopMBB->addLiveIn(ZeroReg);
+  LoopMBB->sortUniqueLiveIns();
+  ContinueMBB->sortUniqueLiveIns();
+
+  auto BuildStore = [&](MachineBasicBlock &BB, MachineBasicBlock::iterator I,
+                        int64_t Disp) {
+    addRegOffset(BuildMI(BB, I, DL, TII.get(StoreOpc)), StackPtr, false, Disp)
+        .addReg(ZeroReg);
+  };
+
+  addRegOffset(BuildMI(&MBB, DL, TII.get(X86::LEA64r), X86::R11),
+               StackPtr, false, -(int64_t)NumBytes);
+  bool NeedsDwarfCFI =
+      !hasFP(MF) && (MF.getMMI().hasDebugInfo() || Fn->needsUnwindTableEntry());
+  if (NeedsDwarfCFI) {
+    // (the same offset emitPrologue gives RSP at the end of the prologue)
+    int64_t CfaOffset = -(int64_t)MF.getFrameInfo()->getStackSize() - SlotSize;
+    BuildCFI(MBB, MBB.end(), DL,
+             MCCFIInstruction::createDefCfa(
+                 nullptr, TRI->getDwarfRegNum(X86::R11, true), CfaOffset));
+  }
+  BuildMI(&MBB, DL, TII.get(ZeroOpc), ZeroReg)
+      .addReg(ZeroReg, RegState::Undef)
+      .addReg(ZeroReg, RegState::Undef);
+  if (Remainder) {
+    BuildStackAdjustment(MBB, MBB.end(), DL, -Remainder, /*InEpilogue=*/false);
+    int64_t Disp = 0;
+    for (; Disp + ChunkSize <= Remainder; Disp += ChunkSize)
+      BuildStore(MBB, MBB.end(), Disp);
+    for (; Disp < Remainder; Disp += 8)
+      addRegOffset(BuildMI(&MBB, DL, TII.get(X86::MOV64mi32)), StackPtr,
+                   false, Disp)
+          .addImm(0);
+  }
+
+  BuildStackAdjustment(*LoopMBB, LoopMBB->end(), DL, -LoopBytes,
+                       /*InEpilogue=*/false);
+  for (int64_t Disp = 0; Disp < LoopBytes; Disp += ChunkSize)
+    BuildStore(*LoopMBB, LoopMBB->end(), Disp);
+  BuildMI(LoopMBB, DL, TII.get(X86::CMP64rr)).addReg(StackPtr).addReg(X86::R11);
+  BuildMI(LoopMBB, DL, TII.get(X86::JNE_1)).addMBB(LoopMBB);
+
+  // RSP is where R11 is now, so only the register changes back.
+  if (NeedsDwarfCFI)
+    BuildCFI(*ContinueMBB, ContinueMBB->begin(), DL,
+             MCCFIInstruction::createDefCfaRegister(
+                 nullptr, TRI->getDwarfRegNum(StackPtr, true)));
+
+  // Mark all the instructions added to the prolog as frame setup, and as
+  // init code (even the stack adjustments, which replace a single one).
+  for (++BeforeMBBI; BeforeMBBI != MBB.end(); ++BeforeMBBI) {
+    BeforeMBBI->setFlag(MachineInstr::FrameSetup);
+    BeforeMBBI->setFlag(MachineInstr::SafeInit);
+  }
+  for (MachineInstr &MI : *LoopMBB) {
+    MI.setFlag(MachineInstr::FrameSetup);
+    MI.setFlag(MachineInstr::SafeInit);
+  }
+  if (NeedsDwarfCFI)
+    ContinueMBB->begin()->setFlag(MachineInstr::FrameSetup);
+}
+
 static unsigned calculateSetFPREG(uint64_t SPAdjust) {
   // Win64 ABI has a less restrictive limitation of 240; 128 works equally well
   // and might require smaller successive adjustments.
@@ -971,7 +1147,6 @@ void X86FrameLowering::emitPrologue(MachineFunction &MF,
     uint64_t MinSize = X86FI->getCalleeSavedFrameSize();
     if (HasFP) MinSize += SlotSize;
     X86FI->setUsesRedZone(MinSize > 0 || StackSize > 0);
-    X86FI->setPreRedZoneSize(StackSize);
     StackSize = std::max(MinSize, StackSize > 128 ? StackSize - 128 : 0);
     MFI->setStackSize(StackSize);
   }
@@ -1203,6 +1378,13 @@ void X86FrameLowering::emitPrologue(MachineFunction &MF,
       MI->setFlag(MachineInstr::FrameSetup);
       MBB.insert(MBBI, MI);
     }
+  } else if (NumBytes && canClearFrameInPrologue(MF, MBB, NumBytes)) {
+    // Allocate the frame a part at a time, clearing each part as we go. The
+    // loop is expanded by inlineStackProbe, once the prologue is complete.
+    X86FI->setFrameClearedInPrologue(NumBytes);
+    BuildMI(MBB, MBBI, DL, TII.get(X86::CALLpcrel32))
+        .addExternalSymbol(FrameClearStubSymbol)
+        .setMIFlag(MachineInstr::FrameSetup);
   } else if (NumBytes) {
     emitSPUpdate(MBB, MBBI, -(int64_t)NumBytes, /*InEpilogue=*/false);
   }
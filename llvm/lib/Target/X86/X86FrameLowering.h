@@ -194,6 +194,16 @@ private:
                                          MachineBasicBlock::iterator MBBI,
                                          DebugLoc DL, bool InProlog) const;
 
+  /// Whether the prologue in MBB can clear the NumBytes it allocates, in
+  /// place of the frame clearing pass.
+  bool canClearFrameInPrologue(MachineFunction &MF, MachineBasicBlock &MBB,
+                               uint64_t NumBytes) const;
+
+  /// Allocate and clear the frame in place of the stub emitPrologue left.
+  void emitFrameClearInline(MachineFunction &MF, MachineBasicBlock &MBB,
+                            MachineBasicBlock::iterator MBBI, DebugLoc DL,
+                            uint64_t NumBytes) const;
+
   /// Aligns the stack pointer by ANDing it with -MaxAlign.
   void BuildStackAlignAND(MachineBasicBlock &MBB,
                           MachineBasicBlock::iterator MBBI, DebugLoc DL,
@@ -14,6 +14,7 @@
 
 #include "X86ISelLowering.h"
 #include "Utils/X86ShuffleDecode.h"
+#include "X86.h"
 #include "X86CallingConv.h"
 #include "X86FrameLowering.h"
 #include "X86InstrBuilder.h"
@@ -16581,6 +16582,18 @@ X86TargetLowering::LowerDYNAMIC_STACKALLOC(SDValue Op,
       Result = DAG.getNode(ISD::AND, dl, VT, Result,
                          DAG.getConstant(-(uint64_t)Align, dl, VT));
     Chain = DAG.getCopyToReg(Chain, dl, SPReg, Result); // Output chain
+
+    // Where frame clearing stands in for SafeInit, clear the new space (from
+    // the new stack pointer up to the old one, a multiple of the stack
+    // alignment) with the vector store loop of SafeInit memsets, rather than
+    // leaving it uninitialized or to a call to memset.
+    if (Subtarget.isTarget64BitLP64() && Subtarget.hasSSE2() &&
+        StackAlign % 16 == 0 && clearsX86DynamicAllocas(MF)) {
+      SDValue Len = DAG.getNode(ISD::SUB, dl, VT, SP, Result);
+      SDValue Zero = DAG.getConstant(0, dl, MVT::v4i32);
+      Chain = DAG.getNode(X86ISD::SAFEINIT_MEMSET, dl, MVT::Other, Chain,
+                          Result, Len, Zero);
+    }
   } else if (SplitStack) {
     MachineRegisterInfo &MRI = MF.getRegInfo();
 
@@ -21656,6 +21669,8 @@ const char *X86TargetLowering::getTargetNodeName(unsigned Opcode) const {
   case X86ISD::IRET:               return "X86ISD::IRET";
   case X86ISD::REP_STOS:           return "X86ISD::REP_STOS";
   case X86ISD::REP_MOVS:           return "X86ISD::REP_MOVS";
+  case X86ISD::SAFEINIT_MEMSET:    return "X86ISD::SAFEINIT_MEMSET";
+  case X86ISD::SAFEINIT_MEMSET_VAR: return "X86ISD::SAFEINIT_MEMSET_VAR";
   case X86ISD::GlobalBaseReg:      return "X86ISD::GlobalBaseReg";
   case X86ISD::Wrapper:            return "X86ISD::Wrapper";
   case X86ISD::WrapperRIP:         return "X86ISD::WrapperRIP";
@@ -23132,6 +23147,166 @@ X86TargetLowering::EmitLoweredSegAlloca(MachineInstr *MI,
   return continueMBB;
 }
 
+MachineBasicBlock *
+X86TargetLowering::EmitLoweredSafeInitMemset(MachineInstr *MI,
+                                             MachineBasicBlock *BB) const {
+  MachineFunction *MF = BB->getParent();
+  const TargetInstrInfo *TII = Subtarget.getInstrInfo();
+  DebugLoc DL = MI->getDebugLoc();
+  const BasicBlock *LLVM_BB = BB->getBasicBlock();
+  MachineRegisterInfo &MRI = MF->getRegInfo();
+
+  const bool HasTail = MI->getOpcode() == X86::SAFEINIT_MEMSET_VAR;
+  const unsigned StoreOpc = Subtarget.hasAVX() ? X86::VMOVUPSmr : X86::MOVUPSmr;
+
+  // BB:
+  //  ... [Till the memset]
+  //  VecLen = Len & -16              (SAFEINIT_MEMSET_VAR only)
+  //  End = Dst + VecLen
+  //  Idx = -VecLen
+  //  If Idx is zero, jump to tailMBB
+  //
+  // vecMBB:
+  //  Store Val at End + Idx
+  //  Idx += 16
+  //  If Idx is not zero, jump to vecMBB
+  //
+  // tailMBB:                         (SAFEINIT_MEMSET_VAR only)
+  //  TailEnd = End + (Len & 15)
+  //  TailIdx = -(Len & 15)
+  //  If TailIdx is zero, jump to continueMBB
+  //
+  // byteMBB:                         (SAFEINIT_MEMSET_VAR only)
+  //  Byte = low byte of Val
+  //
+  // byteLoopMBB:                     (SAFEINIT_MEMSET_VAR only)
+  //  Store Byte at TailEnd + TailIdx
+  //  TailIdx += 1
+  //  If TailIdx is not zero, jump to byteLoopMBB
+  //
+  // continueMBB:
+  //  ...
+  //  [rest of original BB]
+  //
+  // Counting a negative index up to zero lets the loops branch on the flags
+  // of the increment, so each iteration is just a store, an add and a branch.
+
+  MachineBasicBlock *vecMBB = MF->CreateMachineBasicBlock(LLVM_BB);
+  MachineBasicBlock *tailMBB =
+      HasTail ? MF->CreateMachineBasicBlock(LLVM_BB) : nullptr;
+  MachineBasicBlock *byteMBB =
+      HasTail ? MF->CreateMachineBasicBlock(LLVM_BB) : nullptr;
+  MachineBasicBlock *byteLoopMBB =
+      HasTail ? MF->CreateMachineBasicBlock(LLVM_BB) : nullptr;
+  MachineBasicBlock *continueMBB = MF->CreateMachineBasicBlock(LLVM_BB);
+
+  MachineFunction::iterator MBBIter = ++BB->getIterator();
+  MF->insert(MBBIter, vecMBB);
+  if (HasTail) {
+    MF->insert(MBBIter, tailMBB);
+    MF->insert(MBBIter, byteMBB);
+    MF->insert(MBBIter, byteLoopMBB);
+  }
+  MF->insert(MBBIter, continueMBB);
+
+  continueMBB->splice(continueMBB->begin(), BB,
+                      std::next(MachineBasicBlock::iterator(MI)), BB->end());
+  continueMBB->transferSuccessorsAndUpdatePHIs(BB);
+
+  MachineBasicBlock *afterVecMBB = HasTail ? tailMBB : continueMBB;
+
+  const TargetRegisterClass *AddrRC = &X86::GR64RegClass;
+  const TargetRegisterClass *IndexRC = &X86::GR64_NOSPRegClass;
+  unsigned DstReg = MI->getOperand(0).getReg();
+  unsigned LenReg = MI->getOperand(1).getReg();
+  unsigned ValReg = MI->getOperand(2).getReg();
+
+  unsigned VecLenReg = LenReg;
+  if (HasTail) {
+    VecLenReg = MRI.createVirtualRegister(AddrRC);
+    BuildMI(BB, DL, TII->get(X86::AND64ri8), VecLenReg)
+      .addReg(LenReg).addImm(-16);
+  }
+  unsigned EndReg = MRI.createVirtualRegister(AddrRC);
+  unsigned StartIdxReg = MRI.createVirtualRegister(IndexRC);
+  BuildMI(BB, DL, TII->get(X86::ADD64rr), EndReg)
+    .addReg(DstReg).addReg(VecLenReg);
+  BuildMI(BB, DL, TII->get(X86::NEG64r), StartIdxReg).addReg(VecLenReg);
+  BuildMI(BB, DL, TII->get(X86::JE_1)).addMBB(afterVecMBB);
+
+  unsigned IdxReg = MRI.createVirtualRegister(IndexRC);
+  unsigned NextIdxReg = MRI.createVirtualRegister(IndexRC);
+  BuildMI(vecMBB, DL, TII->get(X86::PHI), IdxReg)
+    .addReg(StartIdxReg).addMBB(BB)
+    .addReg(NextIdxReg).addMBB(vecMBB);
+  BuildMI(vecMBB, DL, TII->get(StoreOpc))
+    .addReg(EndReg).addImm(1).addReg(IdxReg).addImm(0).addReg(0)
+    .addReg(ValReg);
+  BuildMI(vecMBB, DL, TII->get(X86::ADD64ri8), NextIdxReg)
+    .addReg(IdxReg).addImm(16);
+  BuildMI(vecMBB, DL, TII->get(X86::JNE_1)).addMBB(vecMBB);
+
+  BB->addSuccessor(vecMBB);
+  BB->addSuccessor(afterVecMBB);
+  vecMBB->addSuccessor(vecMBB);
+  vecMBB->addSuccessor(afterVecMBB);
+
+  if (HasTail) {
+    unsigned TailLenReg = MRI.createVirtualRegister(AddrRC);
+    unsigned TailEndReg = MRI.createVirtualRegister(AddrRC);
+    unsigned TailStartIdxReg = MRI.createVirtualRegister(IndexRC);
+    BuildMI(tailMBB, DL, TII->get(X86::AND64ri8), TailLenReg)
+      .addReg(LenReg).addImm(15);
+    BuildMI(tailMBB, DL, TII->get(X86::ADD64rr), TailEndReg)
+      .addReg(EndReg).addReg(TailLenReg);
+    BuildMI(tailMBB, DL, TII->get(X86::NEG64r), TailStartIdxReg)
+      .addReg(TailLenReg);
+    BuildMI(tailMBB, DL, TII->get(X86::JE_1)).addMBB(continueMBB);
+
+    unsigned Val32Reg = MRI.createVirtualRegister(&X86::GR32RegClass);
+    unsigned Val8Reg = MRI.createVirtualRegister(&X86::GR8RegClass);
+    BuildMI(byteMBB, DL,
+            TII->get(Subtarget.hasAVX() ? X86::VMOVPDI2DIrr : X86::MOVPDI2DIrr),
+            Val32Reg)
+      .addReg(ValReg);
+    BuildMI(byteMBB, DL, TII->get(TargetOpcode::COPY), Val8Reg)
+      .addReg(Val32Reg, 0, X86::sub_8bit);
+
+    unsigned TailIdxReg = MRI.createVirtualRegister(IndexRC);
+    unsigned NextTailIdxReg = MRI.createVirtualRegister(IndexRC);
+    BuildMI(byteLoopMBB, DL, TII->get(X86::PHI), TailIdxReg)
+      .addReg(TailStartIdxReg).addMBB(byteMBB)
+      .addReg(NextTailIdxReg).addMBB(byteLoopMBB);
+    BuildMI(byteLoopMBB, DL, TII->get(X86::MOV8mr))
+      .addReg(TailEndReg).addImm(1).addReg(TailIdxReg).addImm(0).addReg(0)
+      .addReg(Val8Reg);
+    BuildMI(byteLoopMBB, DL, TII->get(X86::ADD64ri8), NextTailIdxReg)
+      .addReg(TailIdxReg).addImm(1);
+    BuildMI(byteLoopMBB, DL, TII->get(X86::JNE_1)).addMBB(byteLoopMBB);
+
+    tailMBB->addSuccessor(byteMBB);
+    tailMBB->addSuccessor(continueMBB);
+    byteMBB->addSuccessor(byteLoopMBB);
+    byteLoopMBB->addSuccessor(byteLoopMBB);
+    byteLoopMBB->addSuccessor(continueMBB);
+  }
+
+  // Flag everything we added as init code (see AsmPrinter's
+  // -safeinit-size-section).
+  for (auto I = std::next(MachineBasicBlock::iterator(MI)); I != BB->end(); ++I)
+    I->setFlag(MachineInstr::SafeInit);
+  for (MachineBasicBlock *InitMBB : {vecMBB, tailMBB, byteMBB, byteLoopMBB})
+    if (InitMBB)
+      for (MachineInstr &InitMI : *InitMBB)
+        InitMI.setFlag(MachineInstr::SafeInit);
+
+  // Delete the original pseudo instruction.
+  MI->eraseFromParent();
+
+  // And we're done.
+  return continueMBB;
+}
+
 MachineBasicBlock *
 X86TargetLowering::EmitLoweredWinAlloca(MachineInstr *MI,
                                         MachineBasicBlock *BB) const {
@@ -23615,6 +23790,9 @@ X86TargetLowering::EmitInstrWithCustomInserter(MachineInstr *MI,
   case X86::SEG_ALLOCA_32:
   case X86::SEG_ALLOCA_64:
     return EmitLoweredSegAlloca(MI, BB);
+  case X86::SAFEINIT_MEMSET:
+  case X86::SAFEINIT_MEMSET_VAR:
+    return EmitLoweredSafeInitMemset(MI, BB);
   case X86::TLSCall_32:
   case X86::TLSCall_64:
     return EmitLoweredTLSCall(MI, BB);
@@ -131,6 +131,12 @@ namespace llvm {
       /// Repeat move, corresponds to X86::REP_MOVSx.
       REP_MOVS,
 
+      /// Fill memory with a 128-bit vector value in a loop, used for SafeInit
+      /// stack initialization. Operands are the chain, the destination, the
+      /// byte count and the vector. SAFEINIT_MEMSET requires the count to be a
+      /// multiple of 16, SAFEINIT_MEMSET_VAR also stores the remaining bytes.
+      SAFEINIT_MEMSET, SAFEINIT_MEMSET_VAR,
+
       /// On Darwin, this node represents the result of the popl
       /// at function entry, used for PIC code.
       GlobalBaseReg,
@@ -1174,6 +1180,9 @@ namespace llvm {
     MachineBasicBlock *EmitLoweredSegAlloca(MachineInstr *MI,
                                             MachineBasicBlock *BB) const;
 
+    MachineBasicBlock *EmitLoweredSafeInitMemset(MachineInstr *MI,
+                                                 MachineBasicBlock *BB) const;
+
     MachineBasicBlock *EmitLoweredTLSAddr(MachineInstr *MI,
                                           MachineBasicBlock *BB) const;
 
@@ -98,8 +98,9 @@ class X86MachineFunctionInfo : public MachineFunctionInfo {
   /// True if this function uses the red zone.
   bool UsesRedZone = false;
 
-  // XXX added by alyssa for framezeroinit
-  unsigned PreRedZoneSize = 0;
+  /// The number of bytes of frame which the prologue cleared as it allocated
+  /// them, or 0 if it left the frame to X86FrameInit.
+  unsigned FrameClearedInPrologue = 0;
 
 private:
   /// ForwardedMustTailRegParms - A list of virtual and physical registers
@@ -176,9 +177,10 @@ public:
   bool getUsesRedZone() const { return UsesRedZone; }
   void setUsesRedZone(bool V) { UsesRedZone = V; }
 
-  // XXX added by alyssa for framezeroinit
-  unsigned getPreRedZoneSize() const { return PreRedZoneSize; }
-  void setPreRedZoneSize(unsigned size) { PreRedZoneSize = size; }
+  unsigned getFrameClearedInPrologue() const { return FrameClearedInPrologue; }
+  void setFrameClearedInPrologue(unsigned Bytes) {
+    FrameClearedInPrologue = Bytes;
+  }
 };
 
 } // End llvm namespace
@@ -18,12 +18,23 @@
 #include "X86SelectionDAGInfo.h"
 #include "llvm/CodeGen/SelectionDAG.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Target/TargetLowering.h"
 
 using namespace llvm;
 
 #define DEBUG_TYPE "x86-selectiondag-info"
 
+static cl::opt<unsigned> SafeInitInlineLimit(
+    "x86-safeinit-inline-limit", cl::init(4096), cl::Hidden,
+    cl::desc("Largest constant size of a SafeInit stack memset that is "
+             "cleared with an inline vector store loop"));
+
+static cl::opt<unsigned> SafeInitRepStosbThreshold(
+    "x86-safeinit-rep-stosb-threshold", cl::init(1024), cl::Hidden,
+    cl::desc("Smallest constant size of a SafeInit stack memset that is "
+             "cleared with rep stosb on processors with ERMSB"));
+
 bool X86SelectionDAGInfo::isBaseRegConflictPossible(
     SelectionDAG &DAG, ArrayRef<MCPhysReg> ClobberSet) const {
   // We cannot use TRI->hasBasePointer() until *after* we select all basic
@@ -194,6 +205,73 @@ SDValue X86SelectionDAGInfo::EmitTargetCodeForMemset(
   return Chain;
 }
 
+SDValue X86SelectionDAGInfo::EmitTargetCodeForSafeInitMemset(
+    SelectionDAG &DAG, SDLoc dl, SDValue Chain, SDValue Dst, SDValue Src,
+    SDValue Size, unsigned Align, MachinePointerInfo DstPtrInfo) const {
+  ConstantSDNode *ConstantSize = dyn_cast<ConstantSDNode>(Size);
+  const X86Subtarget &Subtarget =
+      DAG.getMachineFunction().getSubtarget<X86Subtarget>();
+
+  // The expansions below work on 64-bit pointers.
+  if (!Subtarget.isTarget64BitLP64() || DstPtrInfo.getAddrSpace() >= 256)
+    return SDValue();
+
+  // With ERMSB, rep stosb is as fast as a vector loop for large objects and
+  // handles any size and alignment without a tail, so use it for variable
+  // sizes too.
+  const MCPhysReg ClobberSet[] = {X86::RCX, X86::RAX, X86::RDI};
+  if (Subtarget.hasERMSB() &&
+      (!ConstantSize ||
+       ConstantSize->getZExtValue() >= SafeInitRepStosbThreshold) &&
+      !isBaseRegConflictPossible(DAG, ClobberSet)) {
+    SDValue InFlag;
+    Chain = DAG.getCopyToReg(Chain, dl, X86::AL, Src, InFlag);
+    InFlag = Chain.getValue(1);
+    Chain = DAG.getCopyToReg(Chain, dl, X86::RCX, Size, InFlag);
+    InFlag = Chain.getValue(1);
+    Chain = DAG.getCopyToReg(Chain, dl, X86::RDI, Dst, InFlag);
+    InFlag = Chain.getValue(1);
+
+    SDVTList Tys = DAG.getVTList(MVT::Other, MVT::Glue);
+    SDValue Ops[] = { Chain, DAG.getValueType(MVT::i8), InFlag };
+    return DAG.getNode(X86ISD::REP_STOS, dl, Tys, Ops);
+  }
+
+  // Large constant sizes amortize the call to memset.
+  if (!Subtarget.hasSSE2() ||
+      (ConstantSize && ConstantSize->getZExtValue() > SafeInitInlineLimit))
+    return SDValue();
+
+  // Otherwise clear the object with a loop of 16-byte stores, splatting the
+  // fill byte into a vector register first.
+  SDValue Val = DAG.getNode(ISD::MUL, dl, MVT::i32,
+                            DAG.getZExtOrTrunc(Src, dl, MVT::i32),
+                            DAG.getConstant(0x01010101, dl, MVT::i32));
+  SDValue Vec = DAG.getSplatBuildVector(MVT::v4i32, dl, Val);
+
+  if (!ConstantSize)
+    return DAG.getNode(X86ISD::SAFEINIT_MEMSET_VAR, dl, MVT::Other, Chain,
+                       Dst, Size, Vec);
+
+  uint64_t SizeVal = ConstantSize->getZExtValue();
+  uint64_t VecBytes = SizeVal & ~UINT64_C(15);
+  if (!VecBytes)
+    return SDValue();
+
+  Chain = DAG.getNode(X86ISD::SAFEINIT_MEMSET, dl, MVT::Other, Chain, Dst,
+                      DAG.getConstant(VecBytes, dl, MVT::i64), Vec);
+
+  // Handle the last 1 - 15 bytes with ordinary stores.
+  if (uint64_t BytesLeft = SizeVal - VecBytes)
+    Chain = DAG.getMemset(Chain, dl,
+                          DAG.getNode(ISD::ADD, dl, MVT::i64, Dst,
+                                      DAG.getConstant(VecBytes, dl, MVT::i64)),
+                          Src, DAG.getConstant(BytesLeft, dl, MVT::i64),
+                          MinAlign(Align, VecBytes), false, false,
+                          DstPtrInfo.getWithOffset(VecBytes));
+  return Chain;
+}
+
 SDValue X86SelectionDAGInfo::EmitTargetCodeForMemcpy(
     SelectionDAG &DAG, SDLoc dl, SDValue Chain, SDValue Dst, SDValue Src,
     SDValue Size, unsigned Align, bool isVolatile, bool AlwaysInline,
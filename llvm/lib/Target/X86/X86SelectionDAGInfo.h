@@ -39,6 +39,12 @@ public:
                                   bool isVolatile,
                                   MachinePointerInfo DstPtrInfo) const override;
 
+  SDValue
+  EmitTargetCodeForSafeInitMemset(SelectionDAG &DAG, SDLoc dl, SDValue Chain,
+                                  SDValue Dst, SDValue Src, SDValue Size,
+                                  unsigned Align,
+                                  MachinePointerInfo DstPtrInfo) const override;
+
   SDValue EmitTargetCodeForMemcpy(SelectionDAG &DAG, SDLoc dl,
                                   SDValue Chain,
                                   SDValue Dst, SDValue Src,
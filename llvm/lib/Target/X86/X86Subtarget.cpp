@@ -294,6 +294,7 @@ void X86Subtarget::initializeEnvironment() {
   HasRDRAND = false;
   HasF16C = false;
   HasFSGSBase = false;
+  HasERMSB = false;
   HasLZCNT = false;
   HasBMI = false;
   HasBMI2 = false;
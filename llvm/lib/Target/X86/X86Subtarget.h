@@ -128,6 +128,10 @@ protected:
   /// Processor has FS/GS base insturctions.
   bool HasFSGSBase;
 
+  /// Processor has enhanced REP MOVSB/STOSB, which make the byte forms of
+  /// the string instructions competitive with vector loops.
+  bool HasERMSB;
+
   /// Processor has LZCNT instruction.
   bool HasLZCNT;
 
@@ -409,6 +413,7 @@ public:
   bool hasRDRAND() const { return HasRDRAND; }
   bool hasF16C() const { return HasF16C; }
   bool hasFSGSBase() const { return HasFSGSBase; }
+  bool hasERMSB() const { return HasERMSB; }
   bool hasLZCNT() const { return HasLZCNT; }
   bool hasBMI() const { return HasBMI; }
   bool hasBMI2() const { return HasBMI2; }
@@ -23,9 +23,11 @@
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/CFG.h"
 #include "llvm/Analysis/CallGraph.h"
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/CaptureTracking.h"
+#include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/GlobalVariable.h"
@@ -48,6 +50,7 @@ STATISTIC(NumReadOnlyArg, "Number of arguments marked readonly");
 STATISTIC(NumWriteOnlyArg, "Number of arguments marked writeonly");
 STATISTIC(NumNoAlias, "Number of function returns marked noalias");
 STATISTIC(NumNonNullReturn, "Number of function returns marked nonnull");
+STATISTIC(NumZeroedReturn, "Number of functions marked safeinit-zeroed-return");
 STATISTIC(NumNoRecurse, "Number of functions marked as norecurse");
 
 namespace {
@@ -812,6 +815,101 @@ static bool addNoAliasAttrs(const SCCNodeSet &SCCNodes) {
   return MadeChange;
 }
 
+/// Tests whether the noalias pointer F returns is null or fresh, zero-filled
+/// memory: every pointer that flows to the return comes from an allocation
+/// that returns zeroed memory (calloc, a function already known to, or malloc
+/// and new where the allocator zeroes them), and nothing that runs after such
+/// an allocation writes memory before returning.
+static bool isFunctionZeroedReturn(Function &F, const TargetLibraryInfo &TLI) {
+  const DataLayout &DL = F.getParent()->getDataLayout();
+  int MallocFillByte = TLI.getMallocFillByte(*F.getParent());
+
+  SmallSetVector<Value *, 8> FlowsToReturn;
+  for (BasicBlock &BB : F)
+    if (auto *Ret = dyn_cast<ReturnInst>(BB.getTerminator()))
+      FlowsToReturn.insert(Ret->getReturnValue());
+
+  SmallVector<Instruction *, 4> Allocs;
+  for (unsigned i = 0; i != FlowsToReturn.size(); ++i) {
+    Value *RetVal = FlowsToReturn[i];
+
+    if (Constant *C = dyn_cast<Constant>(RetVal)) {
+      if (!C->isNullValue() && !isa<UndefValue>(C))
+        return false;
+      continue;
+    }
+
+    Instruction *RVI = dyn_cast<Instruction>(RetVal);
+    if (!RVI)
+      return false;
+    switch (RVI->getOpcode()) {
+    case Instruction::BitCast:
+    case Instruction::AddrSpaceCast:
+      FlowsToReturn.insert(RVI->getOperand(0));
+      continue;
+    case Instruction::Select: {
+      SelectInst *SI = cast<SelectInst>(RVI);
+      FlowsToReturn.insert(SI->getTrueValue());
+      FlowsToReturn.insert(SI->getFalseValue());
+      continue;
+    }
+    case Instruction::PHI: {
+      PHINode *PN = cast<PHINode>(RVI);
+      for (Value *IncValue : PN->incoming_values())
+        FlowsToReturn.insert(IncValue);
+      continue;
+    }
+    case Instruction::Call:
+    case Instruction::Invoke:
+      if (getInitialAllocatedByte(RVI, -1, MallocFillByte, DL, &TLI) != 0)
+        return false;
+      Allocs.push_back(RVI);
+      continue;
+    default:
+      return false;
+    }
+  }
+
+  // Writes that can't touch the new memory: to the stack, by further
+  // allocations, and on paths that never return.
+  for (Instruction &I : instructions(F)) {
+    if (!I.mayWriteToMemory() || isa<DbgInfoIntrinsic>(I))
+      continue;
+    if (auto *SI = dyn_cast<StoreInst>(&I))
+      if (isa<AllocaInst>(GetUnderlyingObject(SI->getPointerOperand(), DL)))
+        continue;
+    if (auto CS = CallSite(&I))
+      if (CS.doesNotReturn() || isAllocLikeFn(&I, &TLI) ||
+          returnsZeroedMemory(&I))
+        continue;
+    for (Instruction *Alloc : Allocs)
+      if (Alloc != &I && isPotentiallyReachable(Alloc, &I))
+        return false;
+  }
+  return true;
+}
+
+/// Deduce "safeinit-zeroed-return" for the SCC, so that loads from and zero
+/// stores to what allocator wrappers return fold like those for calloc.
+static bool addZeroedReturnAttrs(const SCCNodeSet &SCCNodes,
+                                 const TargetLibraryInfo &TLI) {
+  bool MadeChange = false;
+  for (Function *F : SCCNodes) {
+    if (F->hasFnAttribute("safeinit-zeroed-return") ||
+        !F->hasExactDefinition() || !F->getReturnType()->isPointerTy() ||
+        !F->doesNotAlias(0))
+      continue;
+    if (!isFunctionZeroedReturn(*F, TLI))
+      continue;
+
+    DEBUG(dbgs() << "Marking " << F->getName() << " as zeroed-return\n");
+    F->addFnAttr("safeinit-zeroed-return");
+    ++NumZeroedReturn;
+    MadeChange = true;
+  }
+  return MadeChange;
+}
+
 /// Tests whether this function is known to not return null.
 ///
 /// Requires that the function returns a pointer.
@@ -1078,6 +1176,7 @@ PreservedAnalyses PostOrderFunctionAttrsPass::run(LazyCallGraph::SCC &C,
   if (!HasUnknownCall) {
     Changed |= addNoAliasAttrs(SCCNodes);
     Changed |= addNonNullAttrs(SCCNodes, TLI);
+    Changed |= addZeroedReturnAttrs(SCCNodes, TLI);
     Changed |= removeConvergentAttrs(SCCNodes);
     Changed |= addNoRecurseAttrs(SCCNodes);
   }
@@ -1162,6 +1261,7 @@ bool PostOrderFunctionAttrsLegacyPass::runOnSCC(CallGraphSCC &SCC) {
   if (!ExternalNode) {
     Changed |= addNoAliasAttrs(SCCNodes);
     Changed |= addNonNullAttrs(SCCNodes, *TLI);
+    Changed |= addZeroedReturnAttrs(SCCNodes, *TLI);
     Changed |= removeConvergentAttrs(SCCNodes);
     Changed |= addNoRecurseAttrs(SCCNodes);
   }
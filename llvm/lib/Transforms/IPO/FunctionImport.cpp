@@ -15,6 +15,7 @@
 
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/IR/AutoUpgrade.h"
 #include "llvm/IR/DiagnosticPrinter.h"
@@ -460,6 +461,50 @@ std::error_code llvm::EmitImportsFiles(
   return std::error_code();
 }
 
+/// Attach the parameter init sizes from the summaries of functions defined in
+/// other modules to their declarations in \p TheModule, as
+/// "safeinit-initializes" parameter attributes for SafeInit to use.
+static void propagateParamInitSizes(Module &TheModule,
+                                    const ModuleSummaryIndex &Index) {
+  for (Function &F : TheModule) {
+    if (!F.isDeclaration() || F.isIntrinsic() || !F.hasName())
+      continue;
+    auto SummaryList = Index.findGlobalValueSummaryList(F.getGUID());
+    if (SummaryList == Index.end())
+      continue;
+
+    // Every copy of the function has to agree, and none may be replaced at
+    // link time by something we haven't seen.
+    std::vector<uint64_t> Sizes;
+    bool First = true;
+    for (auto &Summary : SummaryList->second) {
+      auto *FS = dyn_cast<FunctionSummary>(Summary.get());
+      if (!FS || GlobalValue::isInterposableLinkage(FS->linkage())) {
+        Sizes.clear();
+        break;
+      }
+      ArrayRef<uint64_t> FSSizes = FS->paramInitSizes();
+      if (First) {
+        Sizes.assign(FSSizes.begin(), FSSizes.end());
+        First = false;
+        continue;
+      }
+      Sizes.resize(std::min(Sizes.size(), FSSizes.size()));
+      for (unsigned I = 0, E = Sizes.size(); I != E; ++I)
+        Sizes[I] = std::min(Sizes[I], FSSizes[I]);
+    }
+
+    for (unsigned I = 0, E = std::min<size_t>(Sizes.size(), F.arg_size());
+         I != E; ++I) {
+      if (!Sizes[I])
+        continue;
+      AttrBuilder B;
+      B.addAttribute("safeinit-initializes", utostr(Sizes[I]));
+      F.addAttributes(I + 1, AttributeSet::get(F.getContext(), I + 1, B));
+    }
+  }
+}
+
 // Automatically import functions in Module \p DestModule based on the summaries
 // index.
 //
@@ -571,6 +616,9 @@ bool FunctionImporter::importFunctions(
 
   NumImported += ImportedCount;
 
+  // Whatever wasn't imported can still benefit from the summaries.
+  propagateParamInitSizes(DestModule, Index);
+
   DEBUG(dbgs() << "Imported " << ImportedCount << " functions for Module "
                << DestModule.getModuleIdentifier() << "\n");
   return ImportedCount;
@@ -118,6 +118,10 @@ static cl::opt<bool> UseLoopVersioningLICM(
     "enable-loop-versioning-licm", cl::init(false), cl::Hidden,
     cl::desc("Enable the experimental Loop Versioning LICM pass"));
 
+static cl::opt<bool> SafeInitLTO(
+    "safeinit-lto", cl::init(true), cl::Hidden,
+    cl::desc("Shrink SafeInit memsets using cross-module summaries at link time"));
+
 PassManagerBuilder::PassManagerBuilder() {
     OptLevel = 2;
     SizeLevel = 0;
@@ -579,6 +583,11 @@ void PassManagerBuilder::addLTOOptimizationPasses(legacy::PassManagerBase &PM) {
   // Infer attributes about declarations if possible.
   PM.add(createInferFunctionAttrsLegacyPass());
 
+  // Now that callees from other modules are visible, some SafeInit memsets
+  // may turn out to be (partly) unnecessary.
+  if (SafeInitLTO)
+    PM.add(createSafeInitRevisitPass());
+
   // Indirect call promotion. This should promote all the targets that are left
   // by the earlier promotion pass that promotes intra-module targets.
   // This two-step promotion is to save the compile time. For LTO, it should
@@ -731,6 +740,10 @@ void PassManagerBuilder::populateThinLTOPassManager(
   if (ModuleSummary)
     PM.add(createFunctionImportPass(ModuleSummary));
 
+  // (importing attached the summaries of the remaining declarations)
+  if (SafeInitLTO)
+    PM.add(createSafeInitRevisitPass());
+
   populateModulePassManager(PM);
 
   if (VerifyOutput)
@@ -1918,14 +1918,18 @@ isAllocSiteRemovable(Instruction *AI, SmallVectorImpl<WeakVH> &Users,
           default:
             return false;
 
-          case Intrinsic::initialized:
           case Intrinsic::memmove:
           case Intrinsic::memcpy:
           case Intrinsic::memset: {
             MemIntrinsic *MI = cast<MemIntrinsic>(II);
             if (MI->isVolatile() || MI->getRawDest() != PI)
               return false;
+            Users.emplace_back(I);
+            continue;
           }
+          case Intrinsic::initialized:
+            if (cast<InitializedInst>(II)->getRawDest() != PI)
+              return false;
           // fall through
           case Intrinsic::dbg_declare:
           case Intrinsic::dbg_value:
@@ -69,6 +69,13 @@ void llvm::initializeInstrumentation(PassRegistry &Registry) {
   initializeSanitizerCoverageModulePass(Registry);
   initializeDataFlowSanitizerPass(Registry);
   initializeEfficiencySanitizerPass(Registry);
+  initializeSafeInitLegacyPassPass(Registry);
+  initializeHoistLifetimesPass(Registry);
+  initializeHybridPolicyPass(Registry);
+  initializeOutlineInitsPass(Registry);
+  initializeVersionInitsPass(Registry);
+  initializeMergeZeroStoresPass(Registry);
+  initializeSafeInitTrackerLegacyPassPass(Registry);
 }
 
 /// LLVMInitializeInstrumentation - C binding for
@@ -107,6 +107,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/ValueMap.h"
+#include "llvm/ProfileData/SafeInitAdvice.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -149,6 +150,14 @@ static cl::opt<bool> ClPoisonStackWithCall("msan-poison-stack-with-call",
 static cl::opt<int> ClPoisonStackPattern("msan-poison-stack-pattern",
        cl::desc("poison uninitialized stack variables with the given pattern"),
        cl::Hidden, cl::init(0xff));
+/// \brief Name stack origins the way SafeInit advisor builds do.
+///
+/// With this, reports name stack allocations by their debug variable and line
+/// (see getSafeInitSiteName), which utils/safeinit-advisor.py matches up with
+/// SafeInit's allocas.
+static cl::opt<bool> ClSafeInitSites("msan-safeinit-sites",
+       cl::desc("name stack origins by their SafeInit site"),
+       cl::Hidden, cl::init(false));
 static cl::opt<bool> ClPoisonUndef("msan-poison-undef",
        cl::desc("poison undef temps"),
        cl::Hidden, cl::init(true));
@@ -2694,7 +2703,10 @@ struct MemorySanitizerVisitor : public InstVisitor<MemorySanitizerVisitor> {
       // It will be printed by the run-time if stack-originated UMR is found.
       // The first 4 bytes of the string are set to '----' and will be replaced
       // by __msan_va_arg_overflow_size_tls at the first call.
-      StackDescription << "----" << I.getName() << "@" << F.getName();
+      StackDescription << "----"
+                       << (ClSafeInitSites ? getSafeInitSiteName(I)
+                                           : I.getName().str())
+                       << "@" << F.getName();
       Value *Descr =
           createPrivateNonConstGlobalForString(*F.getParent(),
                                                StackDescription.str());
@@ -19,21 +19,41 @@
  * when testing.
  */
 
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SCCIterator.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/CFG.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/LoopPass.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
+#include "llvm/Analysis/SafeInitTiming.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/CFG.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/Pass.h"
+#include "llvm/ProfileData/SafeInitAdvice.h"
+#include "llvm/ProfileData/SafeInitProf.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include "llvm/Transforms/Instrumentation.h"
+#include "llvm/Transforms/SafeInit.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
 using namespace llvm;
 
 #define DEBUG_TYPE "safeinit"
@@ -42,51 +62,340 @@ using namespace llvm;
 // in particular, this means loop variables get repeatedly re-initialized.
 // (Note that StackColoring will invalidate lifetimes if it sees memory stores
 //  before the lifetime start, so we don't *have* to delete the intrinics right
-//  now, although it might be a good idea anyway.)
+//  now, although it might be a good idea anyway. Inits in the same block just
+//  ahead of the lifetime start only move the start of the range up.)
 static cl::opt<bool> IgnoreLifetimes ("STACKZEROINIT_IGNORELIFETIMES", cl::desc("Ignore lifetimes for allocas"), cl::init(false));
 
 // this is for use in combination with framezeroinit only, don't use it
+// (STACKZEROINIT_HYBRID chooses between the two per function instead)
 static cl::opt<bool> DynamicOnly ("STACKZEROINIT_DYNONLY", cl::desc("Only init dynamic allocas"), cl::init(false));
 
 // Materialize memsets without lifetimes as late as possible (either
 // just before their first uses, or dominating those uses).
 static cl::opt<bool> MaterializeLate ("STACKZEROINIT_MATERIALIZELATE", cl::desc("Materialize alloca memsets as late as possible"), cl::init(true));
 
-// Note that this is NOT SUPPORTED in the release version. To use it you
-// may have to change other optimization passes, as well as the allocator,
-// and we use a static LLVM-compile-time value in the release.
+// Pattern-init builds fill allocas with the byte the "malloc-fill-byte"
+// module flag records (see TargetLibraryInfo::getMallocFillByte), so that
+// the stack and the heap hold the same pattern and GVN and DSE know what it
+// is. This forces 0xcc without the flag, for testing only: the optimizers
+// will still assume the heap is zeroed.
 static cl::opt<bool> PoisonInit ("STACKZEROINIT_POISONINIT", cl::desc("Initialize allocas with a non-zero value"), cl::init(false));
 
+// Maximum number of separate uncovered byte ranges we're willing to initialize
+// individually, before giving up and initializing the whole alloca.
+static cl::opt<unsigned> MaxPartialRanges ("STACKZEROINIT_MAXPARTIALRANGES", cl::desc("Maximum number of partial inits per alloca"), cl::init(4));
+
+// Instead of a single init dominating all uses, put separate inits on each of
+// the paths using the alloca if those paths are cold (according to
+// BlockFrequencyInfo, so preferably with profile data).
+static cl::opt<bool> ColdPathSinking ("STACKZEROINIT_COLDSINK", cl::desc("Sink alloca inits onto cold paths"), cl::init(true));
+static cl::opt<unsigned> ColdSinkMaxCopies ("STACKZEROINIT_COLDSINKMAXCOPIES", cl::desc("Maximum number of inits to sink a single alloca init into"), cl::init(4));
+static cl::opt<unsigned> ColdSinkPercent ("STACKZEROINIT_COLDSINKPERCENT", cl::desc("Maximum frequency of sunk inits, as a percentage of the original"), cl::init(20));
+
+// Treat code only reached by unwinding as cold whatever the profile says:
+// uses of an alloca inside landing pads (and other EH pads) get inits of
+// their own there, rather than one dominating the invokes.
+static cl::opt<bool> ColdEHPads ("STACKZEROINIT_COLDEHPADS", cl::desc("Initialize allocas used by exception handling inside the EH pads"), cl::init(true));
+
+// Raise the alignment of static allocas with inits of at least this many
+// bytes to the target's vector register width, so that the memset can be
+// lowered to aligned vector stores. We never go beyond the natural stack
+// alignment, since that would force stack realignment.
+static cl::opt<unsigned> AlignThreshold ("STACKZEROINIT_ALIGNTHRESHOLD", cl::desc("Minimum init size (in bytes) for raising alloca alignment, or 0 to disable"), cl::init(64));
+
+// Zero dynamic allocas lazily, a chunk at a time, as accesses through an
+// increasing index advance a high-water mark, rather than all at once.
+static cl::opt<bool> DynamicChunks ("STACKZEROINIT_DYNCHUNKS", cl::desc("Zero dynamic allocas in chunks ahead of their accesses"), cl::init(false));
+static cl::opt<unsigned> DynamicChunkSize ("STACKZEROINIT_DYNCHUNKSIZE", cl::desc("Size (in bytes) of chunks for zeroing dynamic allocas"), cl::init(4096));
+
+// Only shrink existing inits using the (now known) callee summaries, as done
+// at link time by createSafeInitRevisitPass.
+static cl::opt<bool> RevisitOnly ("STACKZEROINIT_REVISIT", cl::desc("Revisit existing alloca inits rather than adding new ones"), cl::init(false));
+
+// Only place the existing inits of static allocas again, as done after
+// inlining by createSafeInitReplacePass.
+static cl::opt<bool> ReplaceOnly ("STACKZEROINIT_REPLACE", cl::desc("Place existing alloca inits again rather than adding new ones"), cl::init(false));
+
+// Merge static allocas which would be initialized at the same point into a
+// single combined alloca, so they can be cleared with one (wide) memset
+// rather than many small ones. The frame layout of these allocas is fixed by
+// this, so allocas with lifetimes (which StackColoring could otherwise share)
+// and ones with debug info are left alone.
+static cl::opt<bool> CoalesceAllocas ("STACKZEROINIT_COALESCE", cl::desc("Coalesce allocas initialized at the same point into a single memset"), cl::init(false));
+
+// The hardened allocator zeroes every allocation; when a malloc() (or
+// operator new) result is fully written before anything can read it, call
+// tc_malloc_noinit (or tc_new_noinit) instead so that it doesn't.
+// (This requires linking against our tcmalloc.)
+static cl::opt<bool> HeapNoInit ("STACKZEROINIT_HEAPNOINIT", cl::desc("Use the allocator's no-init entry points for fully overwritten heap allocations"), cl::init(false));
+
+// Along with STACKZEROINIT_HEAPNOINIT: when the allocator fills its memory
+// the way we fill allocas, also switch small constant-size allocations
+// which are only partly written to the no-init entry points, and zero the
+// rest inline with fixed-size stores, as we do for allocas. That skips the
+// allocator's variable-length memset, and lets the zeroing be scheduled
+// (and trimmed by later stores) with the caller's code.
+static cl::opt<bool> HeapInlineZero ("STACKZEROINIT_HEAPINLINEZERO", cl::desc("Zero small partly written heap allocations inline rather than in the allocator"), cl::init(false));
+static cl::opt<unsigned> HeapInlineZeroMaxSize ("STACKZEROINIT_HEAPINLINEZEROMAXSIZE", cl::desc("Maximum size (in bytes) of heap allocations to zero inline"), cl::init(256));
+
+// When the allocator fills its memory the way we fill allocas, move small
+// heap allocations which can't escape the function to the stack, where
+// their inits are cheaper and more often optimized away.
+static cl::opt<bool> HeapToStack ("STACKZEROINIT_HEAPTOSTACK", cl::desc("Move small non-escaping heap allocations to the stack"), cl::init(false));
+static cl::opt<unsigned> HeapToStackMaxSize ("STACKZEROINIT_HEAPTOSTACKMAXSIZE", cl::desc("Maximum size (in bytes) of heap allocations to move to the stack"), cl::init(256));
+
+// Choose the policy of functions without a "safeinit-policy" attribute from
+// measured init costs (sanstats output, see SafeInitProfile).
+static cl::opt<std::string> ProfileFile ("STACKZEROINIT_PROFILE", cl::desc("SafeInit init-cost profile to pick per-function policies from"), cl::init(""));
+
+// Leave out the inits of stack sites an advisor build found to be written
+// before they were read on every run (see SafeInitAdvice), if a stricter
+// static check than ours agrees: the alloca mustn't escape, and every read of
+// it must come after a write to it.
+static cl::opt<std::string> AdviceFile ("STACKZEROINIT_ADVICE", cl::desc("SafeInit advisor candidate list of stack sites to leave uninitialized"), cl::init(""));
+
+// Once optimization is done, choose per function whether its static allocas
+// are cleared by their remaining inits or by X86FrameInit in the prologue, or
+// a mix of the two (see createSafeInitHybridPass).
+static cl::opt<bool> Hybrid ("STACKZEROINIT_HYBRID", cl::desc("Choose between frame clearing and IR inits per function, after optimization"), cl::init(false));
+static cl::opt<unsigned> HybridMemSetCost ("STACKZEROINIT_HYBRIDMEMSETCOST", cl::desc("Fixed cost (in bytes cleared) of an init, for the hybrid cost model"), cl::init(16));
+
+// Once optimization is done, replace the most common mid-sized inits of the
+// module (which the backend would expand into long store sequences at every
+// site) with calls to shared zeroing functions, one per size and alignment
+// (see createSafeInitOutlinePass). Bigger inits are memset calls anyway.
+static cl::opt<bool> Outline ("STACKZEROINIT_OUTLINE", cl::desc("Replace common alloca inits with calls to shared zeroing functions"), cl::init(false));
+static cl::opt<unsigned> OutlineMinSize ("STACKZEROINIT_OUTLINEMINSIZE", cl::desc("Minimum size (in bytes) of inits to outline"), cl::init(64));
+static cl::opt<unsigned> OutlineMaxSize ("STACKZEROINIT_OUTLINEMAXSIZE", cl::desc("Maximum size (in bytes) of inits to outline"), cl::init(256));
+static cl::opt<unsigned> OutlineMinSites ("STACKZEROINIT_OUTLINEMINSITES", cl::desc("Minimum number of inits of the same size and alignment to outline"), cl::init(2));
+static cl::opt<unsigned> OutlineMaxFunctions ("STACKZEROINIT_OUTLINEMAXFUNCTIONS", cl::desc("Maximum number of zeroing functions per module"), cl::init(16));
+
+// Also move big inits which rarely run (by block frequency, or in cold
+// functions) out of line, into cold zeroing functions in .text.unlikely, so
+// that hot code doesn't carry their inline expansion.
+static cl::opt<bool> OutlineCold ("STACKZEROINIT_OUTLINECOLD", cl::desc("Replace big cold alloca inits with calls to cold zeroing functions"), cl::init(false));
+static cl::opt<unsigned> OutlineColdMinSize ("STACKZEROINIT_OUTLINECOLDMINSIZE", cl::desc("Minimum size (in bytes) of cold inits to outline"), cl::init(1024));
+static cl::opt<unsigned> OutlineColdPercent ("STACKZEROINIT_OUTLINECOLDPERCENT", cl::desc("Maximum frequency of cold inits, as a percentage of their function's entry"), cl::init(20));
+
+// Once optimization is done, give variable-size inits whose size ScalarEvolution
+// can bound to small multiples of a word a fast path which clears the object
+// with an inline store loop, leaving the memset call to bigger sizes (see
+// createSafeInitVersionPass). Inits known to be small lose the call entirely.
+static cl::opt<bool> Version ("STACKZEROINIT_VERSION", cl::desc("Give variable-size inits an inline fast path for small sizes"), cl::init(false));
+static cl::opt<unsigned> VersionMaxSize ("STACKZEROINIT_VERSIONMAXSIZE", cl::desc("Maximum size (in bytes) of variable-size inits cleared by the inline fast path"), cl::init(256));
+static cl::opt<unsigned> VersionMinGranule ("STACKZEROINIT_VERSIONMINGRANULE", cl::desc("Minimum known granule (in bytes) of a variable init size for the inline fast path"), cl::init(8));
+
+// Once optimization is done, merge the scalar zero stores which trimmed and
+// split inits leave behind into the widest aligned stores the target has,
+// past unrelated stores in between (see createSafeInitMergeStoresPass).
+static cl::opt<bool> MergeStores ("STACKZEROINIT_MERGESTORES", cl::desc("Merge adjacent zero stores to an alloca into wide vector stores"), cl::init(false));
+
+// Leave allocas alone which clang marks !safeinit.initialized: their
+// initializer writes every byte, and nothing can read them before it.
+static cl::opt<bool> TrustDeclInits ("STACKZEROINIT_TRUSTDECLINITS", cl::desc("Don't init allocas the frontend initializes in full at their declaration"), cl::init(true));
+
+// Initialize small allocas of first-class type with a store of the whole
+// type instead of a memset, which mem2reg and SROA promote without having to
+// split the memset (and InstCombine and GVN see through directly). Types with
+// padding keep their memset, since the store wouldn't clear the padding.
+static cl::opt<unsigned> TypedStoreMaxSize ("STACKZEROINIT_TYPEDSTOREMAXSIZE", cl::desc("Maximum size (in bytes) of allocas initialized with a typed store rather than a memset, or 0 to disable"), cl::init(16));
+
+// Move lifetimes of allocas which are scoped to a loop body out of the loop,
+// so that (when combined with SafeInit) they're initialized once per loop
+// entry rather than once per iteration.
+static cl::opt<bool> HoistLoopLifetimes ("STACKZEROINIT_HOISTLIFETIMES", cl::desc("Hoist loop-scoped alloca lifetimes out of loops"), cl::init(true));
+
+// Rather than hoisting the lifetime of a loop-scoped buffer which the loop
+// only loads from and stores to (and initializing it just once), keep
+// clearing it on every iteration, but only up to a high-water mark of what
+// was stored since it was last cleared (see SafeInit::addResetRegion).
+static cl::opt<bool> ResetRegions ("STACKZEROINIT_RESETREGIONS", cl::desc("Clear loop-scoped buffers only up to what earlier iterations stored"), cl::init(false));
+static cl::opt<unsigned> ResetRegionMinSize ("STACKZEROINIT_RESETREGIONMINSIZE", cl::desc("Minimum size (in bytes) of loop-scoped buffers to give reset regions"), cl::init(256));
+
+STATISTIC(RealignedAllocaCounter, "Counts number of allocas with alignment raised for their inits");
+STATISTIC(ChunkedAllocaCounter, "Counts number of dynamic allocas zeroed in chunks");
+STATISTIC(CoalescedAllocaCounter, "Counts number of allocas merged into a combined alloca for initialization");
+STATISTIC(HeapNoInitCounter, "Counts number of heap allocations switched to the allocator's no-init entry points");
+STATISTIC(HeapToStackCounter, "Counts number of heap allocations moved to the stack");
+STATISTIC(HeapInlineZeroCounter, "Counts number of heap allocations zeroed inline rather than by the allocator");
+STATISTIC(TypedStoreCounter, "Counts number of alloca inits emitted as typed stores rather than memsets");
+STATISTIC(ReplacedAllocaCounter, "Counts number of allocas whose inits were placed again after inlining");
 STATISTIC(AllocaCounter, "Counts number of alloca calls with zero-initialization added");
+STATISTIC(HoistedLifetimeCounter, "Counts number of alloca lifetimes hoisted out of loops");
+STATISTIC(ResetRegionCounter, "Counts number of loop-scoped allocas cleared only up to what earlier iterations stored");
+STATISTIC(OverwrittenAllocaCounter, "Counts number of alloca inits omitted because the alloca is overwritten before any read");
+STATISTIC(AdvisedCandidateCounter, "Counts number of allocas the advisor found to be written before they're read");
+STATISTIC(AdvisedAllocaCounter, "Counts number of alloca inits omitted on the advisor's advice");
+STATISTIC(DeclInitAllocaCounter, "Counts number of allocas left alone because their declaration initializes them in full");
+STATISTIC(ColdSunkCounter, "Counts number of alloca inits split onto cold paths");
+STATISTIC(EHSunkCounter, "Counts number of alloca inits split into EH pads");
+STATISTIC(PartialAllocaCounter, "Counts number of alloca inits reduced to the bytes not overwritten before any read");
+STATISTIC(HybridFrameAllocaCounter, "Counts number of allocas left to frame clearing by the hybrid cost model");
+STATISTIC(HybridFrameFunctionCounter, "Counts number of functions cleared entirely by frame clearing by the hybrid cost model");
+STATISTIC(HybridMixedFunctionCounter, "Counts number of functions cleared partly by frame clearing by the hybrid cost model");
+STATISTIC(OutlinedInitCounter, "Counts number of alloca inits replaced with calls to shared zeroing functions");
+STATISTIC(OutlinedColdInitCounter, "Counts number of cold alloca inits replaced with calls to cold zeroing functions");
+STATISTIC(VersionedInitCounter, "Counts number of variable-size alloca inits given an inline fast path");
+STATISTIC(InlinedInitCounter, "Counts number of variable-size alloca inits replaced by an inline loop");
+STATISTIC(MergedZeroStoreCounter, "Counts number of zero stores to allocas merged into wider stores");
+STATISTIC(WideZeroStoreCounter, "Counts number of wide zero stores created from merged ones");
+STATISTIC(InsertionSearchCounter, "Counts number of searches for alloca init insertion points");
+STATISTIC(ReachabilityQueryCounter, "Counts number of reachability queries between candidate init blocks");
 
 namespace {
-  struct SafeInit : public FunctionPass {
-    static char ID; // Pass identification, replacement for typeid
-    SafeInit() : FunctionPass(ID) {}
+  // A set of disjoint byte ranges [first, second) within an alloca, kept sorted.
+  struct ByteCoverage {
+    SmallVector<std::pair<uint64_t, uint64_t>, 8> Ranges;
+
+    void add(uint64_t Start, uint64_t End);
+    bool covers(uint64_t Start, uint64_t End) const;
+    void getGaps(uint64_t Size, SmallVectorImpl<std::pair<uint64_t, uint64_t> > &Gaps) const;
+  };
+
+  struct SafeInit {
+    SafeInit(bool Revisit = false, SafeInitAllocas Which = SafeInitAllocas::All,
+             bool Replace = false)
+        : Revisit(Revisit), Which(Which), Replace(Replace) {}
+
+    // Rather than adding inits, revisit the ones we added before.
+    bool Revisit;
+    // Which allocas to add inits for (see createSafeInitPass).
+    SafeInitAllocas Which;
+    // Rather than adding inits, place the ones of static allocas again (see
+    // createSafeInitReplacePass).
+    bool Replace;
 
     const TargetLibraryInfo *TLI;
+    const TargetTransformInfo *TTI;
+    const DataLayout *DL;
     DominatorTree *DT;
+    LoopInfo *LI;
+    BlockFrequencyInfo *BFI;
+    ScalarEvolution *SE;
     BasicBlock *Entry;
+    SmallPtrSet<BasicBlock *, 32> CyclicBlocks;
+    bool HasIrreducibleCycles;
     unsigned memsetMDKind;
     unsigned nozeroinitMDKind;
+    unsigned initializedMDKind;
+    // the byte allocas are filled with: zero, or the pattern of a
+    // pattern-init build
+    uint8_t InitByte;
+    // callee summaries, see getArgInitSize
+    DenseMap<const Argument *, uint64_t> ArgInitSizes;
+    // (shared with the other functions' instances under the new pass manager)
+    std::shared_ptr<SafeInitProfile> Profile;
+    std::shared_ptr<SafeInitAdvice> Advice;
+
+    bool needsBFI() const { return ColdPathSinking && !Revisit; }
+    bool needsSE() const { return (DynamicChunks || ResetRegions) && !Revisit; }
+
+    static std::shared_ptr<SafeInitProfile> readProfile();
+    static std::shared_ptr<SafeInitAdvice> readAdvice();
+
+    bool runImpl(Function &F, const TargetLibraryInfo &RunTLI,
+                 const TargetTransformInfo &RunTTI, DominatorTree &RunDT,
+                 LoopInfo &RunLI, BlockFrequencyInfo *RunBFI,
+                 ScalarEvolution *RunSE);
+
+    void addArgInitAttrs(Function &F);
+    bool revisitZeroInits(Function &F);
+    void takeFullInits(Function &F, SmallPtrSetImpl<AllocaInst *> &Allocas);
+
+    bool isInitInsensitive(AllocaInst *AI, bool &sawRead);
+    bool isWrittenBeforeRead(AllocaInst *AI);
+
+    bool getCoverageBeforeRead(Value *V, Instruction *I, uint64_t Size, ByteCoverage &Coverage,
+                               bool *Captured = nullptr);
+    uint64_t getArgInitSize(Function *F, unsigned ArgNo);
+
+    void computeCyclicBlocks(Function &F);
+    Instruction *findMatInsertPt(Instruction *Inst, unsigned Idx) const;
+    BasicBlock *findCommonDominator(SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs) const;
+    Instruction *findInsertionPointInBlock(BasicBlock *BB, Instruction *I,
+        const SmallPtrSetImpl<Instruction *> &MatInsertPts,
+        const SmallPtrSetImpl<Instruction *> &LifetimeStarts) const;
+    bool findColdInsertionPoints(Instruction *I, BasicBlock *DomBB,
+        ArrayRef<BasicBlock *> UseBBs,
+        const SmallPtrSetImpl<Instruction *> &MatInsertPts,
+        const SmallPtrSetImpl<Instruction *> &LifetimeStarts,
+        SmallVectorImpl<Instruction *> &InsertPts) const;
+    BasicBlock *findDominatingBlock(Instruction *I, SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs) const;
+    bool findEHInsertionPoints(Instruction *I,
+        const SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs,
+        const SmallPtrSetImpl<Instruction *> &MatInsertPts,
+        const SmallPtrSetImpl<Instruction *> &LifetimeStarts,
+        SmallVectorImpl<Instruction *> &InsertPts) const;
+    bool areMutuallyUnreachable(ArrayRef<BasicBlock *> BBs) const;
+    void findInsertionPoints(Instruction *I, SmallVectorImpl<Instruction *> &InsertPts) const;
+
+    bool isCoalescable(AllocaInst *AI, Instruction *IP) const;
+    unsigned getAllocaAlignment(AllocaInst *AI) const;
+    void raiseAllocaAlignment(AllocaInst *AI, uint64_t Size);
+
+    bool isChunkable(AllocaInst *AI, SmallVectorImpl<GetElementPtrInst *> &GEPs) const;
+    void addChunkedZeroInit(Module &M, AllocaInst *AI, ArrayRef<GetElementPtrInst *> GEPs);
+    Loop *getResetRegionLoop(AllocaInst *AI) const;
+    void addResetRegion(Module &M, AllocaInst *AI, Loop *L);
+    bool elideHeapInit(Module &M, CallInst *CI);
+    Instruction *getNonNullPoint(CallInst *CI, bool MayBeNull) const;
+    bool moveHeapAllocToStack(Module &M, CallInst *CI);
+    void coalesceAllocas(Module &M, ArrayRef<AllocaInst *> Allocas, Instruction *IP);
+
+    bool addZeroInitForLifetimes(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment);
+    void addZeroInitForUncovered(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment);
+    Constant *getTypedInitValue(AllocaInst *AI, Value *typesize) const;
+    void addZeroInit(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment);
+  };
+
+  struct SafeInitLegacyPass : public FunctionPass {
+    static char ID; // Pass identification, replacement for typeid
+    SafeInitLegacyPass(bool Revisit = false,
+                       SafeInitAllocas Which = SafeInitAllocas::All,
+                       bool Replace = false)
+        : FunctionPass(ID), Impl(Revisit, Which, Replace) {}
 
     const char *getPassName() const { return "Stack Zero-Initialization"; }
 
     void getAnalysisUsage(AnalysisUsage &AU) const override {
       AU.addRequired<DominatorTreeWrapperPass>();
+      AU.addRequired<LoopInfoWrapperPass>();
       AU.addRequired<TargetLibraryInfoWrapperPass>();
+      AU.addRequired<TargetTransformInfoWrapperPass>();
+      if (Impl.needsBFI())
+        AU.addRequired<BlockFrequencyInfoWrapperPass>();
+      if (Impl.needsSE())
+        AU.addRequired<ScalarEvolutionWrapperPass>();
+      // (the only blocks we split are for chunked inits, which keep these up
+      // to date)
+      AU.addPreserved<DominatorTreeWrapperPass>();
+      AU.addPreserved<LoopInfoWrapperPass>();
     }
 
-    bool runOnFunction(Function &F) override;
-
-    bool isSafeStringArray(AllocaInst *AI, bool &sawNonTrivialUse);
+    bool doInitialization(Module &M) override {
+      Impl.ArgInitSizes.clear();
+      if (!Impl.Profile)
+        Impl.Profile = SafeInit::readProfile();
+      if (!Impl.Advice)
+        Impl.Advice = SafeInit::readAdvice();
+      return false;
+    }
 
-    Instruction *findMatInsertPt(Instruction *Inst, unsigned Idx) const;
-    BasicBlock *findCommonDominator(SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs) const;
-    Instruction *findDominatingInsertionPoint(Instruction *I) const;
+    bool runOnFunction(Function &F) override {
+      return Impl.runImpl(
+          F, getAnalysis<TargetLibraryInfoWrapperPass>().getTLI(),
+          getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F),
+          getAnalysis<DominatorTreeWrapperPass>().getDomTree(),
+          getAnalysis<LoopInfoWrapperPass>().getLoopInfo(),
+          Impl.needsBFI()
+              ? &getAnalysis<BlockFrequencyInfoWrapperPass>().getBFI()
+              : nullptr,
+          Impl.needsSE() ? &getAnalysis<ScalarEvolutionWrapperPass>().getSE()
+                         : nullptr);
+    }
 
-    bool addZeroInitForLifetimes(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment);
-    void addZeroInit(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment);
+  private:
+    SafeInit Impl;
   };
 
   struct HoistLifetimes : public LoopPass {
@@ -98,43 +407,375 @@ namespace {
     const char *getPassName() const { return "Loop lifetime hoisting"; }
 
     void getAnalysisUsage(AnalysisUsage &AU) const override {
-      AU.addRequired<DominatorTreeWrapperPass>();
+      getLoopAnalysisUsage(AU);
     }
 
     bool runOnLoop(Loop *L, LPPassManager &LPM) override;
+
+    bool hoistLifetimes(Loop *L, AllocaInst *AI);
+  };
+
+  struct HybridPolicy : public FunctionPass {
+    static char ID; // Pass identification, replacement for typeid
+    HybridPolicy() : FunctionPass(ID) {}
+
+    const char *getPassName() const { return "SafeInit hybrid policy chooser"; }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.addRequired<BlockFrequencyInfoWrapperPass>();
+      AU.setPreservesCFG();
+    }
+
+    bool runOnFunction(Function &F) override;
+  };
+
+  struct OutlineInits : public ModulePass {
+    static char ID; // Pass identification, replacement for typeid
+    OutlineInits() : ModulePass(ID) {}
+
+    const char *getPassName() const { return "SafeInit init outlining"; }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      if (OutlineCold)
+        AU.addRequired<BlockFrequencyInfoWrapperPass>();
+    }
+
+    bool runOnModule(Module &M) override;
+
+    bool outlineColdInits(Module &M, unsigned memsetMDKind);
+    Function *getInitFunction(Module &M, uint8_t Byte, uint64_t Size,
+                              unsigned Align, bool Cold = false);
+  };
+
+  struct VersionInits : public FunctionPass {
+    static char ID; // Pass identification, replacement for typeid
+    VersionInits() : FunctionPass(ID) {}
+
+    const char *getPassName() const { return "SafeInit variable-size init versioning"; }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.addRequired<ScalarEvolutionWrapperPass>();
+    }
+
+    bool runOnFunction(Function &F) override;
+
+    void versionInit(MemSetInst *MSI, unsigned Granule, bool Bounded);
+  };
+
+  struct MergeZeroStores : public FunctionPass {
+    static char ID; // Pass identification, replacement for typeid
+    MergeZeroStores() : FunctionPass(ID) {}
+
+    const char *getPassName() const { return "SafeInit zero store merging"; }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.addRequired<AAResultsWrapperPass>();
+      AU.addRequired<TargetTransformInfoWrapperPass>();
+      AU.setPreservesCFG();
+    }
+
+    bool runOnFunction(Function &F) override;
+
+    unsigned mergeInBlock(BasicBlock &BB, AliasAnalysis &AA, unsigned MaxWidth);
   };
 }
 
-INITIALIZE_PASS(SafeInit, "safeinit",
+INITIALIZE_PASS(SafeInitLegacyPass, "safeinit",
     "SafeInit: initiailizes all the things.",
     false, false)
 
-FunctionPass *llvm::createSafeInitPass() {
-  return new SafeInit();
+FunctionPass *llvm::createSafeInitRevisitPass() {
+  return new SafeInitLegacyPass(true);
+}
+
+FunctionPass *llvm::createSafeInitPass(SafeInitAllocas Which) {
+  return new SafeInitLegacyPass(false, Which);
+}
+
+FunctionPass *llvm::createSafeInitReplacePass() {
+  return new SafeInitLegacyPass(false, SafeInitAllocas::All, true);
+}
+
+SafeInitPass::SafeInitPass(SafeInitAllocas Which)
+    : Which(Which), Profile(SafeInit::readProfile()),
+      Advice(SafeInit::readAdvice()) {}
+
+PreservedAnalyses SafeInitPass::run(Function &F,
+                                    AnalysisManager<Function> &AM) {
+  SafeInit Impl(false, Which);
+  Impl.Profile = Profile;
+  Impl.Advice = Advice;
+  auto &TLI = AM.getResult<TargetLibraryAnalysis>(F);
+  auto &TTI = AM.getResult<TargetIRAnalysis>(F);
+  auto &DT = AM.getResult<DominatorTreeAnalysis>(F);
+  auto &LI = AM.getResult<LoopAnalysis>(F);
+  auto *BFI = Impl.needsBFI() ? &AM.getResult<BlockFrequencyAnalysis>(F)
+                              : nullptr;
+  auto *SE = Impl.needsSE() ? &AM.getResult<ScalarEvolutionAnalysis>(F)
+                            : nullptr;
+  if (!Impl.runImpl(F, TLI, TTI, DT, LI, BFI, SE))
+    return PreservedAnalyses::all();
+  PreservedAnalyses PA;
+  PA.preserve<DominatorTreeAnalysis>();
+  PA.preserve<LoopAnalysis>();
+  return PA;
+}
+
+std::shared_ptr<SafeInitProfile> SafeInit::readProfile() {
+  if (ProfileFile.empty())
+    return nullptr;
+  auto ProfileOrErr = SafeInitProfile::create(ProfileFile);
+  if (std::error_code EC = ProfileOrErr.getError()) {
+    errs() << "Warning: could not read SafeInit profile " << ProfileFile
+           << ": " << EC.message() << "\n";
+    return nullptr;
+  }
+  return std::move(ProfileOrErr.get());
+}
+
+std::shared_ptr<SafeInitAdvice> SafeInit::readAdvice() {
+  if (AdviceFile.empty())
+    return nullptr;
+  auto AdviceOrErr = SafeInitAdvice::create(AdviceFile);
+  if (std::error_code EC = AdviceOrErr.getError()) {
+    errs() << "Warning: could not read SafeInit advice " << AdviceFile
+           << ": " << EC.message() << "\n";
+    return nullptr;
+  }
+  return std::move(AdviceOrErr.get());
+}
+
+void ByteCoverage::add(uint64_t Start, uint64_t End) {
+  if (Start >= End)
+    return;
+  auto It = Ranges.begin();
+  while (It != Ranges.end() && It->second < Start)
+    ++It;
+  // merge with everything we overlap (or touch)
+  while (It != Ranges.end() && It->first <= End) {
+    Start = std::min(Start, It->first);
+    End = std::max(End, It->second);
+    It = Ranges.erase(It);
+  }
+  Ranges.insert(It, std::make_pair(Start, End));
+}
+
+bool ByteCoverage::covers(uint64_t Start, uint64_t End) const {
+  for (auto &R : Ranges)
+    if (R.first <= Start && R.second >= End)
+      return true;
+  return Start >= End;
+}
+
+void ByteCoverage::getGaps(uint64_t Size, SmallVectorImpl<std::pair<uint64_t, uint64_t> > &Gaps) const {
+  uint64_t Pos = 0;
+  for (auto &R : Ranges) {
+    if (R.first >= Size)
+      break;
+    if (R.first > Pos)
+      Gaps.push_back(std::make_pair(Pos, R.first));
+    Pos = std::max(Pos, R.second);
+  }
+  if (Pos < Size)
+    Gaps.push_back(std::make_pair(Pos, Size));
+}
+
+INITIALIZE_PASS_BEGIN(HoistLifetimes, "safeinit-hoist-lifetimes",
+    "SafeInit: hoist loop-scoped lifetimes out of loops.",
+    false, false)
+INITIALIZE_PASS_DEPENDENCY(LoopPass)
+INITIALIZE_PASS_END(HoistLifetimes, "safeinit-hoist-lifetimes",
+    "SafeInit: hoist loop-scoped lifetimes out of loops.",
+    false, false)
+
+Pass *llvm::createSafeInitHoistLifetimesPass() {
+  return new HoistLifetimes();
+}
+
+INITIALIZE_PASS_BEGIN(HybridPolicy, "safeinit-hybrid",
+    "SafeInit: choose between frame clearing and IR inits.",
+    false, false)
+INITIALIZE_PASS_DEPENDENCY(BlockFrequencyInfoWrapperPass)
+INITIALIZE_PASS_END(HybridPolicy, "safeinit-hybrid",
+    "SafeInit: choose between frame clearing and IR inits.",
+    false, false)
+
+FunctionPass *llvm::createSafeInitHybridPass() {
+  return new HybridPolicy();
+}
+
+INITIALIZE_PASS_BEGIN(OutlineInits, "safeinit-outline",
+    "SafeInit: share zeroing functions between common inits.",
+    false, false)
+INITIALIZE_PASS_DEPENDENCY(BlockFrequencyInfoWrapperPass)
+INITIALIZE_PASS_END(OutlineInits, "safeinit-outline",
+    "SafeInit: share zeroing functions between common inits.",
+    false, false)
+
+ModulePass *llvm::createSafeInitOutlinePass() {
+  return new OutlineInits();
+}
+
+INITIALIZE_PASS_BEGIN(VersionInits, "safeinit-version",
+    "SafeInit: inline fast paths for small variable-size inits.",
+    false, false)
+INITIALIZE_PASS_DEPENDENCY(ScalarEvolutionWrapperPass)
+INITIALIZE_PASS_END(VersionInits, "safeinit-version",
+    "SafeInit: inline fast paths for small variable-size inits.",
+    false, false)
+
+FunctionPass *llvm::createSafeInitVersionPass() {
+  return new VersionInits();
+}
+
+INITIALIZE_PASS_BEGIN(MergeZeroStores, "safeinit-merge-stores",
+    "SafeInit: merge zero stores into wide stores.",
+    false, false)
+INITIALIZE_PASS_DEPENDENCY(AAResultsWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass)
+INITIALIZE_PASS_END(MergeZeroStores, "safeinit-merge-stores",
+    "SafeInit: merge zero stores into wide stores.",
+    false, false)
+
+FunctionPass *llvm::createSafeInitMergeStoresPass() {
+  return new MergeZeroStores();
+}
+
+namespace {
+  // How a library function treats one of its pointer arguments.
+  enum ArgRole {
+    AR_Write,       // only written through, maybe without a NUL terminator
+                    // (e.g. the destination of strncpy or read)
+    AR_StringWrite, // written with a string, NUL terminator and all (e.g. the
+                    // destination of strcpy)
+    AR_StringRead,  // read up to (and including) a NUL terminator
+    AR_BoundedRead  // read up to a NUL terminator or a length limit
+  };
+
+  struct InitInsensitiveArg {
+    LibFunc::Func Func;
+    unsigned ArgNo;
+    bool AndFollowing; // also applies to all later (variadic) arguments
+    ArgRole Role;
+    bool ReturnsArg;   // the return value points into this argument
+  };
+}
+
+// Library functions whose uses of a buffer can't observe anything other than
+// its first byte, as long as everything they read is a string, and everything
+// which writes it terminates that string. Anything which isn't listed here
+// can't be used with a string array.
+static const InitInsensitiveArg InitInsensitiveArgs[] = {
+  { LibFunc::strcpy,      0, false, AR_StringWrite, true  },
+  { LibFunc::strcpy,      1, false, AR_StringRead,  false },
+  { LibFunc::strncpy,     0, false, AR_Write,       true  },
+  { LibFunc::strncpy,     1, false, AR_BoundedRead, false },
+  { LibFunc::stpcpy,      0, false, AR_StringWrite, true  },
+  { LibFunc::stpcpy,      1, false, AR_StringRead,  false },
+  { LibFunc::stpncpy,     0, false, AR_Write,       true  },
+  { LibFunc::stpncpy,     1, false, AR_BoundedRead, false },
+  // strcat reads the destination to find its end
+  { LibFunc::strcat,      0, false, AR_StringRead,  true  },
+  { LibFunc::strcat,      1, false, AR_StringRead,  false },
+  { LibFunc::strncat,     0, false, AR_StringRead,  true  },
+  { LibFunc::strncat,     1, false, AR_BoundedRead, false },
+  { LibFunc::strcmp,      0, true,  AR_StringRead,  false },
+  { LibFunc::strncmp,     0, true,  AR_BoundedRead, false },
+  { LibFunc::strcasecmp,  0, true,  AR_StringRead,  false },
+  { LibFunc::strncasecmp, 0, true,  AR_BoundedRead, false },
+  { LibFunc::strlen,      0, false, AR_StringRead,  false },
+  { LibFunc::strnlen,     0, false, AR_BoundedRead, false },
+  { LibFunc::strchr,      0, false, AR_StringRead,  true  },
+  { LibFunc::strrchr,     0, false, AR_StringRead,  true  },
+  { LibFunc::strstr,      0, false, AR_StringRead,  true  },
+  { LibFunc::strstr,      1, false, AR_StringRead,  false },
+  { LibFunc::strpbrk,     0, false, AR_StringRead,  true  },
+  { LibFunc::strpbrk,     1, false, AR_StringRead,  false },
+  { LibFunc::strspn,      0, true,  AR_StringRead,  false },
+  { LibFunc::strcspn,     0, true,  AR_StringRead,  false },
+  { LibFunc::strdup,      0, false, AR_StringRead,  false },
+  { LibFunc::strndup,     0, false, AR_BoundedRead, false },
+  { LibFunc::atoi,        0, false, AR_StringRead,  false },
+  { LibFunc::atol,        0, false, AR_StringRead,  false },
+  { LibFunc::atoll,       0, false, AR_StringRead,  false },
+  { LibFunc::atof,        0, false, AR_StringRead,  false },
+  // there's no dereference, so only relevant uses of the variadic arguments
+  // of the printf family are as strings
+  { LibFunc::sprintf,     0, false, AR_StringWrite, false },
+  { LibFunc::sprintf,     1, true,  AR_StringRead,  false },
+  { LibFunc::snprintf,    0, false, AR_StringWrite, false },
+  { LibFunc::snprintf,    2, true,  AR_StringRead,  false },
+  { LibFunc::vsprintf,    0, false, AR_StringWrite, false },
+  { LibFunc::vsprintf,    1, false, AR_StringRead,  false },
+  { LibFunc::vsnprintf,   0, false, AR_StringWrite, false },
+  { LibFunc::vsnprintf,   2, false, AR_StringRead,  false },
+  { LibFunc::printf,      0, true,  AR_StringRead,  false },
+  { LibFunc::vprintf,     0, false, AR_StringRead,  false },
+  { LibFunc::fprintf,     1, true,  AR_StringRead,  false }, // not the FILE*
+  { LibFunc::vfprintf,    1, false, AR_StringRead,  false },
+  { LibFunc::puts,        0, false, AR_StringRead,  false },
+  { LibFunc::fputs,       0, false, AR_StringRead,  false },
+  { LibFunc::perror,      0, false, AR_StringRead,  false },
+  { LibFunc::sscanf,      0, false, AR_StringRead,  false },
+  { LibFunc::sscanf,      1, false, AR_StringRead,  false },
+  { LibFunc::sscanf,      2, true,  AR_Write,       false },
+  // I/O functions which fill a buffer (only fgets terminates what it reads)
+  { LibFunc::read,        1, false, AR_Write,       false },
+  { LibFunc::pread,       1, false, AR_Write,       false },
+  { LibFunc::recv,        1, false, AR_Write,       false },
+  { LibFunc::fread,       0, false, AR_Write,       false },
+  { LibFunc::fgets,       0, false, AR_StringWrite, true  },
+};
+
+static const InitInsensitiveArg *lookupInitInsensitiveArg(LibFunc::Func F, unsigned ArgNo) {
+  for (const InitInsensitiveArg &A : InitInsensitiveArgs) {
+    if (A.Func != F)
+      continue;
+    if (A.ArgNo == ArgNo || (A.AndFollowing && ArgNo > A.ArgNo))
+      return &A;
+  }
+  return nullptr;
 }
 
 /* this is an example of how you could remove inits from SafeInit
    on the insertion side rather than the optimization side,
    however this is NOT NECESSARY for any of our results,
    and "safe" should be taken with a pinch of salt */
-bool SafeInit::isSafeStringArray(AllocaInst *AI, bool &sawNonTrivialUse) {
+// Returns true if the only uses of AI write to it, or read it as a string
+// (see InitInsensitiveArgs). If any of those uses read it, sawRead is set,
+// and initializing the first byte is enough; otherwise no init is needed.
+// Reads only stop at a terminator which a string write put there, so a
+// buffer which is read must only be written with strings: a byte-count
+// write (a store, or read()) may leave the rest of it unterminated.
+bool SafeInit::isInitInsensitive(AllocaInst *AI, bool &sawRead) {
   SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
   Worklist.insert(AI);
+  bool sawRawWrite = false;
 
   // if we're poisoning with a non-zero value, string arrays are never safe
-  if (PoisonInit)
+  if (InitByte)
     return false;
 
   for (unsigned int n = 0; n < Worklist.size(); ++n) {
     Instruction *WI = Worklist[n];
-    for (Value::use_iterator U = WI->use_begin(), E = WI->use_end(); U != E; ++U) {
-      Instruction *UI = dyn_cast<Instruction>(U->getUser());
+    for (Use &U : WI->uses()) {
+      Instruction *UI = cast<Instruction>(U.getUser());
 
       if (dyn_cast<CastInst>(UI) || dyn_cast<GetElementPtrInst>(UI)) {
+        // ptrtoint loses track of the pointer
+        if (!UI->getType()->isPointerTy())
+          return false;
         Worklist.insert(UI);
         continue;
       }
 
+      if (StoreInst *SI = dyn_cast<StoreInst>(UI)) {
+        if (U.getOperandNo() != SI->getPointerOperandIndex())
+          return false; // escapes
+        sawRawWrite = true;
+        continue;
+      }
+
       if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI)) {
         switch (II->getIntrinsicID()) {
          case Intrinsic::lifetime_start:
@@ -142,342 +783,1669 @@ bool SafeInit::isSafeStringArray(AllocaInst *AI, bool &sawNonTrivialUse) {
          case Intrinsic::dbg_declare:
          case Intrinsic::dbg_value:
            continue;
+         case Intrinsic::memset:
+           sawRawWrite = true;
+           continue;
+         case Intrinsic::memcpy:
+         case Intrinsic::memmove:
+           // copying *from* the buffer doesn't stop at a terminator
+           if (U.getOperandNo() != 0)
+             return false;
+           sawRawWrite = true;
+           continue;
          default:
-           // TODO: memset is also ok?
            return false;
         }
       }
 
-      sawNonTrivialUse = true;
+      CallSite CS(UI);
+      if (!CS || !CS.isArgOperand(&U))
+        return false;
+
+      // Check if it's a library function we know about.
+      Function *F = CS.getCalledFunction();
+      LibFunc::Func Func;
+      if (!F || !TLI->getLibFunc(*F, Func) || !TLI->has(Func))
+        return false;
+      const InitInsensitiveArg *A = lookupInitInsensitiveArg(Func, CS.getArgumentNo(&U));
+      if (!A)
+        return false;
+
+      if (A->Role == AR_Write)
+        sawRawWrite = true;
+      else if (A->Role != AR_StringWrite)
+        sawRead = true;
+      if (A->ReturnsArg)
+        Worklist.insert(UI);
+    }
+  }
+
+  if (sawRead && sawRawWrite)
+    return false;
+
+  if (sawRead)
+    DEBUG(dbgs() << *AI << " is a safe string allocation\n");
+  return true;
+}
+
+// Returns true if AI doesn't escape, and everything which reads it (loads,
+// and memcpys out of it) is dominated by something which writes it (stores,
+// memsets, and memcpys into it). This doesn't show that the write covers the
+// bytes being read; that's what the advisor's runs are for.
+bool SafeInit::isWrittenBeforeRead(AllocaInst *AI) {
+  SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
+  SmallVector<Instruction *, 8> Reads, Writes;
+  Worklist.insert(AI);
+
+  for (unsigned int n = 0; n < Worklist.size(); ++n) {
+    Instruction *WI = Worklist[n];
+    for (Use &U : WI->uses()) {
+      Instruction *UI = cast<Instruction>(U.getUser());
+
+      if (isa<BitCastInst>(UI) || isa<GetElementPtrInst>(UI)) {
+        Worklist.insert(UI);
+        continue;
+      }
+
+      if (isa<LoadInst>(UI)) {
+        Reads.push_back(UI);
+        continue;
+      }
 
-      if (auto CS = CallSite(UI)) {
-        // Check if it's a string function.
-        if (Function *F = CS.getCalledFunction()) {
-          if (TLI->has(LibFunc::strcpy) &&
-              F->getName() == TLI->getName(LibFunc::strcpy)) {
-            if (U->getOperandNo() == 0) Worklist.insert(UI);
-            continue;
-          }
-          if (TLI->has(LibFunc::strncpy) &&
-              F->getName() == TLI->getName(LibFunc::strncpy)) {
-            if (U->getOperandNo() == 0) Worklist.insert(UI);
-            continue;
-          }
-          if (TLI->has(LibFunc::strcat) &&
-              F->getName() == TLI->getName(LibFunc::strcat)) {
-            if (U->getOperandNo() == 0) Worklist.insert(UI);
-            continue;
-          }
-          if (TLI->has(LibFunc::strncat) &&
-              F->getName() == TLI->getName(LibFunc::strncat)) {
-            if (U->getOperandNo() == 0) Worklist.insert(UI);
-            continue;
-          }
-          if (TLI->has(LibFunc::strcmp) &&
-              F->getName() == TLI->getName(LibFunc::strcmp)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::strncmp) &&
-              F->getName() == TLI->getName(LibFunc::strncmp)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::strlen) &&
-              F->getName() == TLI->getName(LibFunc::strlen)) {
-            continue;
-          }
-          // there's no dereference, so only relevant uses of sprintf/snprintf are as string
-          if (TLI->has(LibFunc::sprintf) &&
-              F->getName() == TLI->getName(LibFunc::sprintf)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::snprintf) &&
-              F->getName() == TLI->getName(LibFunc::snprintf)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::printf) &&
-              F->getName() == TLI->getName(LibFunc::printf)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::vprintf) &&
-              F->getName() == TLI->getName(LibFunc::vprintf)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::vsprintf) &&
-              F->getName() == TLI->getName(LibFunc::vsprintf)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::vsnprintf) &&
-              F->getName() == TLI->getName(LibFunc::vsnprintf)) {
-            continue;
-          }
-          if (TLI->has(LibFunc::fprintf) &&
-              F->getName() == TLI->getName(LibFunc::fprintf)) {
-            if (U->getOperandNo() != 0) // not the FILE*
-              continue;
-          }
-          if (TLI->has(LibFunc::vfprintf) &&
-              F->getName() == TLI->getName(LibFunc::vfprintf)) {
-            if (U->getOperandNo() != 0) // not the FILE*
-              continue;
-          }
-        }
+      if (StoreInst *SI = dyn_cast<StoreInst>(UI)) {
+        if (U.getOperandNo() != SI->getPointerOperandIndex())
+          return false; // escapes
+        Writes.push_back(UI);
+        continue;
       }
 
-      // anything else is not ok
-      // TODO: stores are also ok
-      return false;
+      IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI);
+      if (!II)
+        return false;
+      switch (II->getIntrinsicID()) {
+       case Intrinsic::lifetime_start:
+       case Intrinsic::lifetime_end:
+       case Intrinsic::dbg_declare:
+       case Intrinsic::dbg_value:
+         continue;
+       case Intrinsic::memset:
+         Writes.push_back(UI);
+         continue;
+       case Intrinsic::memcpy:
+       case Intrinsic::memmove:
+         if (U.getOperandNo() == 0)
+           Writes.push_back(UI);
+         else
+           Reads.push_back(UI);
+         continue;
+       default:
+         return false;
+      }
     }
   }
 
-  if (sawNonTrivialUse)
-    errs() << *AI << " is a safe string allocation\n";
+  for (Instruction *R : Reads) {
+    bool Dominated = false;
+    for (Instruction *W : Writes)
+      if (W != R && DT->dominates(W, R)) {
+        Dominated = true;
+        break;
+      }
+    if (!Dominated)
+      return false;
+  }
   return true;
 }
 
-// this is derived from llvm's ConstantHoisting pass
-Instruction *SafeInit::findMatInsertPt(Instruction *Inst, unsigned Idx) const {
-  // The simple and common case. This also includes constant expressions.
-  if (!isa<PHINode>(Inst) && !Inst->isEHPad())
-    return Inst;
+// Work out which bytes of the alloca V are written (by stores, memsets or
+// memcpys) on all paths from I before anything could read them; there's no
+// point initializing those bytes at I. Returns false if V isn't something we
+// can analyze.
+// We only look at straight-line code starting at I, which is where the
+// insertion point usually ends up anyway (just before the first use).
+bool SafeInit::getCoverageBeforeRead(Value *V, Instruction *I, uint64_t Size, ByteCoverage &Coverage,
+                                     bool *Captured) {
+  if (!(isa<AllocaInst>(V) || isa<Argument>(V) || isa<CallInst>(V)))
+    return false;
 
-  // We can't insert directly before a phi node or an eh pad. Insert before
-  // the terminator of the incoming or dominating block.
-  assert(Entry != Inst->getParent() && "PHI or landing pad in entry block!");
-  if (Idx != ~0U && isa<PHINode>(Inst))
-    return cast<PHINode>(Inst)->getIncomingBlock(Idx)->getTerminator();
+  // Find all pointers derived from the alloca, along with their offset
+  // (if it's a constant), and the instructions which use them.
+  const int64_t UnknownOffset = INT64_MIN;
+  SmallDenseMap<Value *, int64_t, 16> Offsets;
+  SmallPtrSet<Instruction *, 16> Users;
+  bool Escapes = false;
 
-  BasicBlock *IDom = DT->getNode(Inst->getParent())->getIDom()->getBlock();
-  return IDom->getTerminator();
-}
+  SetVector<Value *, SmallVector<Value *, 16> > Worklist;
+  Worklist.insert(V);
+  Offsets[V] = 0;
 
-// this is derived from llvm's ConstantHoisting pass
-BasicBlock *SafeInit::findCommonDominator(SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs) const {
-  while (BBs.size() >= 2) {
-    BasicBlock *BB, *BB1, *BB2;
-    BB1 = *BBs.begin();
-    BB2 = *std::next(BBs.begin());
-    BB = DT->findNearestCommonDominator(BB1, BB2);
-    if (BB == Entry)
-      return Entry;
-    BBs.remove(BB1);
-    BBs.remove(BB2);
-    BBs.insert(BB);
+  for (unsigned int n = 0; n < Worklist.size(); ++n) {
+    Value *WI = Worklist[n];
+    int64_t Offset = Offsets[WI];
+    for (Use &U : WI->uses()) {
+      Instruction *UI = cast<Instruction>(U.getUser());
+
+      if (dyn_cast<CastInst>(UI) || dyn_cast<GetElementPtrInst>(UI)) {
+        int64_t NewOffset = UnknownOffset;
+        if (!UI->getType()->isPointerTy()) {
+          // ptrtoint and friends
+          Escapes = true;
+          Users.insert(UI);
+          continue;
+        } else if (isa<CastInst>(UI)) {
+          NewOffset = Offset;
+        } else {
+          APInt GEPOffset(DL->getPointerSizeInBits(), 0);
+          if (Offset != UnknownOffset &&
+              cast<GEPOperator>(UI)->accumulateConstantOffset(*DL, GEPOffset))
+            NewOffset = Offset + GEPOffset.getSExtValue();
+        }
+        if (Worklist.insert(UI))
+          Offsets[UI] = NewOffset;
+        continue;
+      }
+
+      // comparing against null (e.g. checking a malloc result) is harmless
+      if (ICmpInst *Cmp = dyn_cast<ICmpInst>(UI))
+        if (isa<ConstantPointerNull>(Cmp->getOperand(0)) ||
+            isa<ConstantPointerNull>(Cmp->getOperand(1)))
+          continue;
+
+      Users.insert(UI);
+
+      // Work out whether the pointer might escape, in which case anything
+      // which reads memory could potentially read the alloca.
+      if (isa<LoadInst>(UI))
+        continue;
+      if (StoreInst *SI = dyn_cast<StoreInst>(UI))
+        if (U.getOperandNo() == SI->getPointerOperandIndex())
+          continue;
+      if (isa<MemIntrinsic>(UI) || isa<InitializedInst>(UI))
+        continue;
+      if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI)) {
+        if (II->getIntrinsicID() == Intrinsic::lifetime_start ||
+            II->getIntrinsicID() == Intrinsic::lifetime_end)
+          continue;
+      }
+      // callees which initialize the argument don't capture it either
+      if (CallSite CS = CallSite(UI)) {
+        Function *Callee = CS.getCalledFunction();
+        if (Callee && CS.isArgOperand(&U) &&
+            getArgInitSize(Callee, CS.getArgumentNo(&U)))
+          continue;
+      }
+      Escapes = true;
+    }
   }
-  assert((BBs.size() == 1) && "Expected only one element.");
-  return *BBs.begin();
-}
 
-// this is from Analysis/CFG.cpp but we don't want the limit imposed there :-(
-// TODO: put the LI stuff back?
-static bool isPotentiallyReachableHacked(
-    BasicBlock *From, BasicBlock *To,
-    const DominatorTree *DT) {
-  // When the stop block is unreachable, it's dominated from everywhere,
-  // regardless of whether there's a path between the two blocks.
-  if (DT && !DT->isReachableFromEntry(To))
-    DT = nullptr;
-
-  SmallVector<BasicBlock*, 32> Worklist;
-  Worklist.push_back(const_cast<BasicBlock*>(From));
-  // Limit the number of blocks we visit. The goal is to avoid run-away compile
-  // times on large CFGs without hampering sensible code. Arbitrarily chosen.
-  SmallPtrSet<const BasicBlock*, 32> Visited;
-  do {
-    BasicBlock *BB = Worklist.pop_back_val();
-    if (!Visited.insert(BB).second)
-      continue;
-    if (BB == To)
-      return true;
-    if (DT && DT->dominates(BB, To))
-      return true;
+  if (Captured)
+    *Captured = Escapes;
+  // whoever passed us an argument might have kept a copy of it
+  if (Argument *A = dyn_cast<Argument>(V))
+    if (!A->hasNoAliasAttr())
+      Escapes = true;
 
-    Worklist.append(succ_begin(BB), succ_end(BB));
-  } while (!Worklist.empty());
+  auto getOffset = [&](Value *Ptr) {
+    auto It = Offsets.find(Ptr);
+    return It == Offsets.end() ? UnknownOffset : It->second;
+  };
+  auto addRange = [&](ByteCoverage &Coverage, int64_t Offset, uint64_t Len) {
+    if (Offset < 0)
+      return;
+    Coverage.add(std::min((uint64_t)Offset, Size), std::min(Offset + Len, Size));
+  };
 
-  // We have exhausted all possible paths and are certain that 'To' can not be
-  // reached from 'From'.
-  return false;
-}
+  // Stop at the first thing which might read the alloca; whatever we covered
+  // up to that point is what we report.
+  SmallPtrSet<BasicBlock *, 8> Visited;
+  BasicBlock *BB = I->getParent();
+  BasicBlock::iterator It = I->getIterator();
+  while (Visited.insert(BB).second) {
+    for (BasicBlock::iterator E = BB->end(); It != E; ++It) {
+      if (Coverage.covers(0, Size))
+        return true;
+
+      Instruction *Inst = &*It;
+      if (!Users.count(Inst)) {
+        if (Escapes && Inst->mayReadFromMemory())
+          return true;
+        continue;
+      }
 
-// returns the instruction which we should insert *before*
-// (probably either a use, or a terminator)
-Instruction *SafeInit::findDominatingInsertionPoint(Instruction *I) const {
-  // Collect all basic blocks.
-  SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > BBs;
-  SmallPtrSet<Instruction *, 16> MatInsertPts;
-  SmallPtrSet<Instruction *, 16> LifetimeStarts;
+      if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(Inst))
+        if (II->getIntrinsicID() == Intrinsic::lifetime_start)
+          continue;
 
-  SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
-  Worklist.insert(I);
+      // (writes we can't make sense of don't help, but they don't hurt either)
+      if (StoreInst *SI = dyn_cast<StoreInst>(Inst)) {
+        int64_t Offset = getOffset(SI->getPointerOperand());
+        if (Offset != UnknownOffset)
+          addRange(Coverage, Offset, DL->getTypeStoreSize(SI->getValueOperand()->getType()));
+        continue;
+      }
 
-  for (unsigned int n = 0; n < Worklist.size(); ++n) {
-    Instruction *WI = Worklist[n];
-    for (Value::use_iterator U = WI->use_begin(), E = WI->use_end(); U != E; ++U) {
-      Instruction *UI = dyn_cast<Instruction>(U->getUser());
+      if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(Inst)) {
+        // copying from the alloca itself is a read
+        if (MemTransferInst *MTI = dyn_cast<MemTransferInst>(MI))
+          if (Offsets.count(MTI->getRawSource()))
+            return true;
+        ConstantInt *Len = dyn_cast<ConstantInt>(MI->getLength());
+        int64_t Offset = getOffset(MI->getRawDest());
+        if (Len && Offset != UnknownOffset)
+          addRange(Coverage, Offset, Len->getZExtValue());
+        continue;
+      }
+
+      // (a loop marked as storing to a whole range)
+      if (InitializedInst *Init = dyn_cast<InitializedInst>(Inst)) {
+        ConstantInt *Len = dyn_cast<ConstantInt>(Init->getLength());
+        int64_t Offset = getOffset(Init->getRawDest());
+        if (Len && Offset != UnknownOffset)
+          addRange(Coverage, Offset, Len->getZExtValue());
+        continue;
+      }
+
+      // A callee which writes the start of the pointer before reading it.
+      // It may read anything afterwards, so this is as far as we get.
+      // (this includes invoked constructors of objects from new-expressions)
+      if (CallSite CS = CallSite(Inst)) {
+        Function *Callee = CS.getCalledFunction();
+        unsigned NumPtrArgs = 0, ArgNo = 0;
+        for (unsigned i = 0, e = CS.arg_size(); i != e; ++i) {
+          if (Offsets.count(CS.getArgument(i))) {
+            NumPtrArgs++;
+            ArgNo = i;
+          }
+        }
+        int64_t Offset = NumPtrArgs == 1 ? getOffset(CS.getArgument(ArgNo)) : UnknownOffset;
+        if (Callee && Offset != UnknownOffset)
+          addRange(Coverage, Offset, getArgInitSize(Callee, ArgNo));
+      }
+
+      // anything else might read it
+      return true;
+    }
+
+    if (Coverage.covers(0, Size))
+      return true;
+
+    // every path from here has to go through the successor, and nothing
+    // else can reach the successor
+    BasicBlock *Succ = BB->getSingleSuccessor();
+    // (if we branch on the pointer being null, there's nothing to read on
+    //  the null side, so only the non-null side matters)
+    BranchInst *BI = dyn_cast<BranchInst>(BB->getTerminator());
+    if (!Succ && BI && BI->isConditional()) {
+      ICmpInst *Cmp = dyn_cast<ICmpInst>(BI->getCondition());
+      if (Cmp && Cmp->isEquality() && Offsets.count(Cmp->getOperand(0)) &&
+          isa<ConstantPointerNull>(Cmp->getOperand(1)))
+        Succ = BI->getSuccessor(Cmp->getPredicate() == ICmpInst::ICMP_EQ ? 1 : 0);
+    }
+    BB = Succ;
+    if (!BB || !BB->getSinglePredecessor())
+      return true;
+    It = BB->begin();
+  }
+
+  return true;
+}
+
+// If CI is a heap allocation whose result is fully written before anything
+// can read it, switch it to the allocator's no-init entry point (which takes
+// the same arguments) so the allocator doesn't zero it first.
+// For operator new, we only touch calls from new-expressions (which clang
+// marks with !safeinit.new, or which carry the 'builtin' attribute), since
+// only those allocations may be replaced by the implementation; the bytes
+// written by the constructor come from its argument summary, so padding
+// it leaves alone keeps the allocator's zeroing.
+// With STACKZEROINIT_HEAPINLINEZERO, small allocations which are only partly
+// written are switched too, and the rest of them is zeroed right after the
+// call (once the result is known not to be null).
+bool SafeInit::elideHeapInit(Module &M, CallInst *CI) {
+  Function *Callee = CI->getCalledFunction();
+  LibFunc::Func Func;
+  if (!Callee || !TLI->getLibFunc(*Callee, Func) || !TLI->has(Func))
+    return false;
+
+  bool IsNewExpr = CI->getMetadata("safeinit.new") ||
+                   CI->hasFnAttr(Attribute::Builtin);
+  const char *NoInitName;
+  switch (Func) {
+  case LibFunc::malloc:
+    NoInitName = "tc_malloc_noinit";
+    break;
+  case LibFunc::Znwj:
+  case LibFunc::Znwm:
+    if (!IsNewExpr)
+      return false;
+    NoInitName = "tc_new_noinit";
+    break;
+  case LibFunc::Znaj:
+  case LibFunc::Znam:
+    if (!IsNewExpr)
+      return false;
+    NoInitName = "tc_newarray_noinit";
+    break;
+  default:
+    return false;
+  }
+
+  ConstantInt *Size = dyn_cast<ConstantInt>(CI->getArgOperand(0));
+  if (!Size || Size->isZero())
+    return false;
+
+  uint64_t N = Size->getZExtValue();
+  ByteCoverage Coverage;
+  Instruction *ZeroIP = nullptr;
+  if (!getCoverageBeforeRead(CI, CI->getNextNode(), N, Coverage) ||
+      !Coverage.covers(0, N)) {
+    if (!HeapInlineZero || N > HeapInlineZeroMaxSize ||
+        TLI->getMallocFillByte(M) != InitByte)
+      return false;
+    ZeroIP = getNonNullPoint(CI, Func == LibFunc::malloc);
+    if (!ZeroIP)
+      return false;
+  }
+
+  DEBUG(dbgs() << "using no-init allocation for " << *CI << "\n");
+  Constant *NoInit = M.getOrInsertFunction(NoInitName, Callee->getFunctionType(),
+                                           Callee->getAttributes());
+  // (keep alias analysis aware that this is still a fresh allocation)
+  if (Function *NoInitF = dyn_cast<Function>(NoInit))
+    NoInitF->setDoesNotAlias(0);
+  CI->setCalledFunction(NoInit);
+  if (ZeroIP) {
+    // (as aligned as malloc's result)
+    addZeroInitForUncovered(M, CI, ZeroIP, Size, 2 * DL->getPointerSize());
+    HeapInlineZeroCounter++;
+  } else {
+    HeapNoInitCounter++;
+  }
+  return true;
+}
+
+// Returns where the result of heap allocation CI can first be written to:
+// right after the call if it can't be null, or else the start of the
+// non-null side of a null check on it which ends CI's block (if that's
+// the only way into it). Returns null if there's no such place.
+Instruction *SafeInit::getNonNullPoint(CallInst *CI, bool MayBeNull) const {
+  if (!MayBeNull || CI->paramHasAttr(AttributeSet::ReturnIndex, Attribute::NonNull))
+    return CI->getNextNode();
+
+  BranchInst *BI = dyn_cast<BranchInst>(CI->getParent()->getTerminator());
+  if (!BI || !BI->isConditional())
+    return nullptr;
+  ICmpInst *Cmp = dyn_cast<ICmpInst>(BI->getCondition());
+  if (!Cmp || !Cmp->isEquality() || Cmp->getOperand(0) != CI ||
+      !isa<ConstantPointerNull>(Cmp->getOperand(1)))
+    return nullptr;
+  BasicBlock *NonNull = BI->getSuccessor(Cmp->getPredicate() == ICmpInst::ICMP_EQ ? 1 : 0);
+  if (NonNull->getSinglePredecessor() != CI->getParent())
+    return nullptr;
+  return &*NonNull->getFirstInsertionPt();
+}
+
+// Move CI, a small heap allocation (see elideHeapInit for which operator new
+// calls we may touch), to the stack if it can't escape the function: nothing
+// may do anything with it but load from it, store to it, compare it, and
+// free it. It becomes an alloca in the entry block, initialized wherever the
+// allocation was (which might be on every iteration of a loop), as the
+// allocator would have, and the calls freeing it go.
+bool SafeInit::moveHeapAllocToStack(Module &M, CallInst *CI) {
+  Function *Callee = CI->getCalledFunction();
+  LibFunc::Func Func;
+  if (!Callee || !TLI->getLibFunc(*Callee, Func) || !TLI->has(Func))
+    return false;
+
+  switch (Func) {
+  case LibFunc::malloc:
+    break;
+  case LibFunc::Znwj:
+  case LibFunc::Znwm:
+  case LibFunc::Znaj:
+  case LibFunc::Znam:
+    if (!CI->getMetadata("safeinit.new") && !CI->hasFnAttr(Attribute::Builtin))
+      return false;
+    break;
+  default:
+    return false;
+  }
+
+  ConstantInt *Size = dyn_cast<ConstantInt>(CI->getArgOperand(0));
+  if (!Size || Size->isZero() || Size->getZExtValue() > HeapToStackMaxSize)
+    return false;
+
+  SmallVector<Instruction *, 4> Frees;
+  SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
+  Worklist.insert(CI);
+  for (unsigned int n = 0; n < Worklist.size(); ++n) {
+    Instruction *WI = Worklist[n];
+    for (Use &U : WI->uses()) {
+      Instruction *UI = cast<Instruction>(U.getUser());
+      if (isa<BitCastInst>(UI) || isa<GetElementPtrInst>(UI)) {
+        Worklist.insert(UI);
+        continue;
+      }
+      if (isa<LoadInst>(UI) || isa<ICmpInst>(UI))
+        continue;
+      if (isa<StoreInst>(UI) &&
+          U.getOperandNo() == StoreInst::getPointerOperandIndex())
+        continue;
+      // (the destination, or the source of a copy)
+      if (isa<MemIntrinsic>(UI) && U.getOperandNo() < 2)
+        continue;
+      if (isFreeCall(UI, TLI) && U.getOperandNo() == 0) {
+        Frees.push_back(UI);
+        continue;
+      }
+      return false;
+    }
+  }
+
+  DEBUG(dbgs() << "moving heap allocation to the stack: " << *CI << "\n");
+  LLVMContext &C = M.getContext();
+  uint64_t N = Size->getZExtValue();
+  // (as aligned as malloc's result)
+  unsigned Align = 2 * DL->getPointerSize();
+  AllocaInst *AI = new AllocaInst(ArrayType::get(Type::getInt8Ty(C), N), nullptr,
+                                  Align, "", &*Entry->getFirstInsertionPt());
+  AI->takeName(CI);
+  AI->setMetadata(nozeroinitMDKind, MDNode::get(C, {}));
+
+  CI->replaceAllUsesWith(new BitCastInst(AI, CI->getType(), "", CI));
+  for (Instruction *Free : Frees)
+    Free->eraseFromParent();
+  addZeroInitForUncovered(M, AI, CI, ConstantInt::get(Type::getInt64Ty(C), N), Align);
+  CI->eraseFromParent();
+  HeapToStackCounter++;
+  return true;
+}
+
+// Returns the number of bytes at the start of argument ArgNo of F which are
+// always written before anything is read through it (0 if we don't know of
+// any, or if F might capture the argument). This is either given by a
+// "safeinit-initializes" attribute on the parameter, or worked out from the
+// body of F (if it can't be replaced at link time).
+uint64_t SafeInit::getArgInitSize(Function *F, unsigned ArgNo) {
+  if (ArgNo >= F->arg_size())
+    return 0;
+
+  AttributeSet Attrs = F->getAttributes();
+  if (Attrs.hasAttribute(ArgNo + 1, "safeinit-initializes")) {
+    uint64_t Bytes = 0;
+    if (Attrs.getAttribute(ArgNo + 1, "safeinit-initializes").getValueAsString().getAsInteger(10, Bytes))
+      return 0;
+    return Bytes;
+  }
+
+  if (F->isDeclaration() || F->isInterposable())
+    return 0;
+
+  Argument *A = &*std::next(F->arg_begin(), ArgNo);
+  if (!A->getType()->isPointerTy())
+    return 0;
+
+  auto It = ArgInitSizes.find(A);
+  if (It != ArgInitSizes.end())
+    return It->second;
+  // (in case of recursion)
+  ArgInitSizes[A] = 0;
+
+  ByteCoverage Coverage;
+  bool Captured = true;
+  uint64_t Bytes = 0;
+  Instruction *Start = &*F->getEntryBlock().getFirstInsertionPt();
+  if (getCoverageBeforeRead(A, Start, UINT32_MAX, Coverage, &Captured) && !Captured &&
+      !Coverage.Ranges.empty() && Coverage.Ranges[0].first == 0)
+    Bytes = Coverage.Ranges[0].second;
+
+  ArgInitSizes[A] = Bytes;
+  return Bytes;
+}
+
+// Record our own summaries as "safeinit-initializes" attributes, so they make
+// it into the module summary (and from there to other modules) for LTO.
+void SafeInit::addArgInitAttrs(Function &F) {
+  if (F.isInterposable())
+    return;
+  for (Argument &A : F.args()) {
+    unsigned ArgNo = A.getArgNo();
+    if (!A.getType()->isPointerTy() ||
+        F.getAttributes().hasAttribute(ArgNo + 1, "safeinit-initializes"))
+      continue;
+    if (uint64_t Bytes = getArgInitSize(&F, ArgNo)) {
+      AttrBuilder B;
+      B.addAttribute("safeinit-initializes", utostr(Bytes));
+      F.addAttributes(ArgNo + 1, AttributeSet::get(F.getContext(), ArgNo + 1, B));
+    }
+  }
+}
+
+// Redo the (full) inits of allocas which we added earlier, now that more
+// callee summaries are available (e.g. at link time): remove each one, and
+// add back only what's still needed.
+bool SafeInit::revisitZeroInits(Function &F) {
+  SmallVector<MemSetInst *, 8> MemSets;
+  for (Function::iterator BB = F.begin(), E = F.end(); BB != E; ++BB)
+    for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I)
+      if (MemSetInst *MSI = dyn_cast<MemSetInst>(I))
+        if (MSI->getMetadata(memsetMDKind) && isa<AllocaInst>(MSI->getRawDest()->stripPointerCasts()))
+          MemSets.push_back(MSI);
+
+  bool MadeChanges = false;
+  Module *M = F.getParent();
+  for (MemSetInst *MSI : MemSets) {
+    AllocaInst *AI = cast<AllocaInst>(MSI->getRawDest()->stripPointerCasts());
+    ConstantInt *Len = dyn_cast<ConstantInt>(MSI->getLength());
+    if (!Len || !AI->isStaticAlloca() ||
+        Len->getZExtValue() != DL->getTypeAllocSize(AI->getAllocatedType()) *
+          cast<ConstantInt>(AI->getArraySize())->getZExtValue())
+      continue;
+
+    ByteCoverage Coverage;
+    Instruction *Next = MSI->getNextNode();
+    if (!getCoverageBeforeRead(AI, Next, Len->getZExtValue(), Coverage) || Coverage.Ranges.empty())
+      continue;
+
+    Value *Dest = MSI->getRawDest();
+    addZeroInitForUncovered(*M, AI, Next, MSI->getLength(), MSI->getAlignment());
+    MSI->eraseFromParent();
+    RecursivelyDeleteTriviallyDeadInstructions(Dest);
+    MadeChanges = true;
+  }
+
+  return MadeChanges;
+}
+
+// Take back the inits we added earlier of whole static allocas, collecting
+// the allocas in Allocas, so that they can be placed again: after inlining,
+// the inits of the callee's allocas are at the call site (which may be in a
+// loop), and allocas the inliner merged into one slot have an init for each
+// of the callees. Allocas with any other kind of init (partial ones, reset
+// regions, ...) keep all of theirs.
+void SafeInit::takeFullInits(Function &F, SmallPtrSetImpl<AllocaInst *> &Allocas) {
+  MapVector<AllocaInst *, SmallVector<Instruction *, 2> > Inits;
+  SmallPtrSet<AllocaInst *, 8> Others;
+  for (BasicBlock &BB : F) {
+    for (Instruction &I : BB) {
+      if (!I.getMetadata(memsetMDKind))
+        continue;
+      Value *Dest;
+      if (MemSetInst *MSI = dyn_cast<MemSetInst>(&I))
+        Dest = MSI->getRawDest();
+      else if (StoreInst *SI = dyn_cast<StoreInst>(&I))
+        Dest = SI->getPointerOperand();
+      else
+        continue;
+      AllocaInst *AI = dyn_cast<AllocaInst>(GetUnderlyingObject(Dest, *DL));
+      if (!AI || !AI->isStaticAlloca())
+        continue;
+      uint64_t AllocSize = DL->getTypeAllocSize(AI->getAllocatedType()) *
+        cast<ConstantInt>(AI->getArraySize())->getZExtValue();
+      bool IsInit = false;
+      if (MemSetInst *MSI = dyn_cast<MemSetInst>(&I)) {
+        ConstantInt *Len = dyn_cast<ConstantInt>(MSI->getLength());
+        ConstantInt *Val = dyn_cast<ConstantInt>(MSI->getValue());
+        IsInit = Len && Len->getZExtValue() == AllocSize && Val &&
+                 Val->getZExtValue() == InitByte && !MSI->isVolatile();
+      } else {
+        Value *Val = cast<StoreInst>(&I)->getValueOperand();
+        IsInit = Dest == AI &&
+                 Val == getTypedInitValue(AI, ConstantInt::get(
+                            Type::getInt64Ty(F.getContext()), AllocSize));
+      }
+      if (IsInit && Dest->stripPointerCasts() == AI)
+        Inits[AI].push_back(&I);
+      else
+        Others.insert(AI);
+    }
+  }
+
+  for (auto &Init : Inits) {
+    if (Others.count(Init.first))
+      continue;
+    for (Instruction *I : Init.second) {
+      Value *Dest = isa<StoreInst>(I) ? cast<StoreInst>(I)->getPointerOperand()
+                                      : cast<MemSetInst>(I)->getRawDest();
+      I->eraseFromParent();
+      // (not recursively: that could take the alloca with it)
+      if (Dest != Init.first && Dest->use_empty())
+        cast<Instruction>(Dest)->eraseFromParent();
+    }
+    Allocas.insert(Init.first);
+    ReplacedAllocaCounter++;
+  }
+}
+
+// this is derived from llvm's ConstantHoisting pass
+Instruction *SafeInit::findMatInsertPt(Instruction *Inst, unsigned Idx) const {
+  // The simple and common case. This also includes constant expressions.
+  if (!isa<PHINode>(Inst) && !Inst->isEHPad())
+    return Inst;
+
+  // We can't insert directly before a phi node or an eh pad. Insert before
+  // the terminator of the incoming or dominating block.
+  assert(Entry != Inst->getParent() && "PHI or landing pad in entry block!");
+  if (Idx != ~0U && isa<PHINode>(Inst))
+    return cast<PHINode>(Inst)->getIncomingBlock(Idx)->getTerminator();
+
+  BasicBlock *IDom = DT->getNode(Inst->getParent())->getIDom()->getBlock();
+  // (a catchswitch is a terminator, but also a pad nothing can go before)
+  while (IDom->getTerminator()->isEHPad())
+    IDom = DT->getNode(IDom)->getIDom()->getBlock();
+  return IDom->getTerminator();
+}
+
+// this is derived from llvm's ConstantHoisting pass
+BasicBlock *SafeInit::findCommonDominator(SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs) const {
+  while (BBs.size() >= 2) {
+    BasicBlock *BB, *BB1, *BB2;
+    BB1 = *BBs.begin();
+    BB2 = *std::next(BBs.begin());
+    BB = DT->findNearestCommonDominator(BB1, BB2);
+    if (BB == Entry)
+      return Entry;
+    BBs.remove(BB1);
+    BBs.remove(BB2);
+    BBs.insert(BB);
+  }
+  assert((BBs.size() == 1) && "Expected only one element.");
+  return *BBs.begin();
+}
+
+// Find all the blocks which can reach themselves (i.e. are part of a cycle
+// in the CFG), so findDominatingInsertionPoint doesn't have to search the
+// CFG again for every alloca.
+void SafeInit::computeCyclicBlocks(Function &F) {
+  CyclicBlocks.clear();
+  HasIrreducibleCycles = false;
+
+  SmallPtrSet<BasicBlock *, 32> Seen;
+  for (scc_iterator<Function *> SCC = scc_begin(&F); !SCC.isAtEnd(); ++SCC) {
+    for (BasicBlock *BB : *SCC) {
+      Seen.insert(BB);
+      if (SCC.hasLoop())
+        CyclicBlocks.insert(BB);
+    }
+  }
+
+  // Blocks which aren't reachable from the entry block aren't visited above.
+  for (BasicBlock &BB : F) {
+    if (Seen.count(&BB))
+      continue;
+    for (scc_iterator<BasicBlock *> SCC = scc_begin(&BB); !SCC.isAtEnd(); ++SCC) {
+      for (BasicBlock *SCCBB : *SCC) {
+        Seen.insert(SCCBB);
+        if (SCC.hasLoop())
+          CyclicBlocks.insert(SCCBB);
+      }
+    }
+  }
+
+  // If there are cycles which LoopInfo doesn't know about, we can't use it
+  // for placement.
+  for (BasicBlock *BB : CyclicBlocks)
+    if (!LI->getLoopFor(BB))
+      HasIrreducibleCycles = true;
+}
+
+// returns the first instruction in BB which we could insert *before*
+// (probably either a use, or a terminator)
+Instruction *SafeInit::findInsertionPointInBlock(BasicBlock *BB, Instruction *I,
+    const SmallPtrSetImpl<Instruction *> &MatInsertPts,
+    const SmallPtrSetImpl<Instruction *> &LifetimeStarts) const {
+  Instruction *insertPoint = BB->getFirstNonPHIOrDbg();
+  // If the definition is in the dominating block, then the earliest point we can insert
+  // is directly after the definition.
+  // (If there's a lifetime, this also applies; should only happen in first block..)
+  for (BasicBlock::iterator II = BB->begin(), E = BB->end(); II != E; ++II) {
+    for (auto LS : LifetimeStarts) {
+      if (&*II == LS)
+        insertPoint = II->getNextNode();
+    }
+    if (&*II == I)
+      insertPoint = II->getNextNode();
+  }
+
+  // Search until we find an instruction we can't insert (directly) before.
+  while (insertPoint != BB->getTerminator()) {
+    if (MatInsertPts.count(insertPoint))
+      break;
+    insertPoint = insertPoint->getNextNode();
+  }
+
+  return insertPoint;
+}
+
+// Try to replace a single init in DomBB with copies on each of the (cold)
+// paths which actually use the alloca. Each use block needs an init which
+// dominates it, and no path may run through more than one init (the second
+// one would clobber whatever was written after the first).
+bool SafeInit::findColdInsertionPoints(Instruction *I, BasicBlock *DomBB,
+    ArrayRef<BasicBlock *> UseBBs,
+    const SmallPtrSetImpl<Instruction *> &MatInsertPts,
+    const SmallPtrSetImpl<Instruction *> &LifetimeStarts,
+    SmallVectorImpl<Instruction *> &InsertPts) const {
+  if (!BFI || HasIrreducibleCycles || UseBBs.size() < 2)
+    return false;
+
+  // Each use gets initialized in its own block, or just before the outermost
+  // loop containing it.
+  SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > SinkBBs;
+  for (BasicBlock *BB : UseBBs) {
+    if (BB == DomBB || BB == I->getParent())
+      return false;
+    Loop *Outermost = nullptr;
+    for (Loop *L = LI->getLoopFor(BB); L && !L->contains(I); L = L->getParentLoop())
+      Outermost = L;
+    if (Outermost) {
+      BB = Outermost->getLoopPreheader();
+      if (!BB || BB == DomBB)
+        return false;
+    }
+    SinkBBs.insert(BB);
+    if (SinkBBs.size() > ColdSinkMaxCopies)
+      return false;
+  }
+
+  // It's only worth it if the copies run (much) less often than the original.
+  uint64_t DomFreq = BFI->getBlockFreq(DomBB).getFrequency();
+  uint64_t SinkFreq = 0;
+  for (BasicBlock *BB : SinkBBs)
+    SinkFreq += BFI->getBlockFreq(BB).getFrequency();
+  if (SinkFreq * 100 > DomFreq * ColdSinkPercent)
+    return false;
+
+  if (!areMutuallyUnreachable(SinkBBs.getArrayRef()))
+    return false;
+
+  for (BasicBlock *BB : SinkBBs) {
+    Instruction *insertPoint = findInsertionPointInBlock(BB, I, MatInsertPts, LifetimeStarts);
+    assert(DT->dominates(I, insertPoint) && "definition must dominate insertion point");
+    DEBUG(dbgs() << "inserting (cold) at " << *insertPoint << " for " << *I << "\n");
+    InsertPts.push_back(insertPoint);
+  }
+  ColdSunkCounter++;
+  return true;
+}
+
+// finds the block to initialize I in so that the init dominates the uses in
+// BBs (which may be modified)
+BasicBlock *SafeInit::findDominatingBlock(Instruction *I, SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs) const {
+  BasicBlock *dominatingBlock = Entry;
+
+  if (!HasIrreducibleCycles) {
+    dominatingBlock = findCommonDominator(BBs);
+
+    // We must never initialize inside a loop, since that would clobber values
+    // carried around it; instead, initialize just before the outermost loop
+    // containing the dominating block. (Loops containing the alloca itself
+    // are fine, since it's a fresh allocation on every iteration anyway.)
+    Loop *Outermost = nullptr;
+    for (Loop *L = LI->getLoopFor(dominatingBlock); L && !L->contains(I); L = L->getParentLoop())
+      Outermost = L;
+    if (Outermost) {
+      if (BasicBlock *Preheader = Outermost->getLoopPreheader())
+        dominatingBlock = Preheader;
+      else
+        dominatingBlock = DT->getNode(Outermost->getHeader())->getIDom()->getBlock();
+    }
+  } else {
+    // Without LoopInfo to rely on: if BB can reach itself (it's part of a
+    // cycle), we just add all predecessors.
+    for (unsigned int n = 0; n < BBs.size(); ++n) { // NOT an iterator
+      BasicBlock *BB = BBs[n];
+      // If this is the block in which the alloca is defined, we know that uses can only flow FROM here.
+      if (BB == I->getParent())
+        continue;
+      if (CyclicBlocks.count(BB)) {
+        for (auto PI = pred_begin(BB); PI != pred_end(BB); ++PI)
+          if (*PI)
+            BBs.insert(*PI);
+      }
+      if (BBs.count(Entry))
+        break;
+    }
+
+    if (!BBs.count(dominatingBlock))
+      dominatingBlock = findCommonDominator(BBs);
+  }
+
+  return dominatingBlock;
+}
+
+// The EH pad whose region BB is in (the nearest dominating one), if any.
+static BasicBlock *getEnclosingEHPad(BasicBlock *BB, DominatorTree *DT) {
+  for (DomTreeNode *N = DT->getNode(BB); N; N = N->getIDom()) {
+    BasicBlock *PadBB = N->getBlock();
+    if (PadBB->isEHPad())
+      return isa<CatchSwitchInst>(PadBB->getFirstNonPHI()) ? nullptr : PadBB;
+  }
+  return nullptr;
+}
+
+// Uses of I inside EH pads only run when something throws, so give each pad
+// its own init rather than initializing ahead of the invokes, where it would
+// run on the non-throwing path too; the other uses are initialized as usual.
+// As in findColdInsertionPoints, no path may run through more than one init
+// (so a cleanup for an object constructed on the normal path won't do).
+bool SafeInit::findEHInsertionPoints(Instruction *I,
+    const SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > &BBs,
+    const SmallPtrSetImpl<Instruction *> &MatInsertPts,
+    const SmallPtrSetImpl<Instruction *> &LifetimeStarts,
+    SmallVectorImpl<Instruction *> &InsertPts) const {
+  if (HasIrreducibleCycles)
+    return false;
+
+  SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > HotBBs;
+  SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > InitBBs;
+  for (BasicBlock *BB : BBs) {
+    BasicBlock *PadBB = getEnclosingEHPad(BB, DT);
+    if (!PadBB) {
+      HotBBs.insert(BB);
+      continue;
+    }
+    // The pad must be within I's scope, and not in a loop I is outside of
+    // (we'd initialize again on every iteration).
+    if (!DT->dominates(I->getParent(), PadBB))
+      return false;
+    for (Loop *L = LI->getLoopFor(PadBB); L; L = L->getParentLoop())
+      if (!L->contains(I))
+        return false;
+    InitBBs.insert(PadBB);
+  }
+
+  // A single pad using I gets its init there anyway.
+  if (InitBBs.empty() || (HotBBs.empty() && InitBBs.size() == 1))
+    return false;
+  if (!HotBBs.empty()) {
+    BasicBlock *DomBB = findDominatingBlock(I, HotBBs);
+    if (InitBBs.count(DomBB))
+      return false;
+    InitBBs.insert(DomBB);
+  }
+
+  if (!areMutuallyUnreachable(InitBBs.getArrayRef()))
+    return false;
+
+  for (BasicBlock *BB : InitBBs) {
+    Instruction *insertPoint = findInsertionPointInBlock(BB, I, MatInsertPts, LifetimeStarts);
+    assert(DT->dominates(I, insertPoint) && "definition must dominate insertion point");
+    DEBUG(dbgs() << "inserting (EH) at " << *insertPoint << " for " << *I << "\n");
+    InsertPts.push_back(insertPoint);
+  }
+  EHSunkCounter++;
+  return true;
+}
+
+// Whether none of BBs can reach another, so that an init in each of them
+// runs at most once before the uses.
+bool SafeInit::areMutuallyUnreachable(ArrayRef<BasicBlock *> BBs) const {
+  if (BBs.size() < 2)
+    return true;
+  SafeInitTimeRegion TR("SafeInit reachability", *BBs.front()->getParent());
+  // (isPotentiallyReachable is conservative, which is what we want here)
+  for (BasicBlock *From : BBs)
+    for (BasicBlock *To : BBs)
+      if (From != To) {
+        ReachabilityQueryCounter++;
+        if (isPotentiallyReachable(From, To, DT, LI))
+          return false;
+      }
+  return true;
+}
+
+// finds the instructions which we should insert *before*: normally a single
+// point which dominates all the uses, but see findColdInsertionPoints
+void SafeInit::findInsertionPoints(Instruction *I, SmallVectorImpl<Instruction *> &InsertPts) const {
+  SafeInitTimeRegion TR("SafeInit insertion point search", *I->getFunction());
+  InsertionSearchCounter++;
+  // Collect all basic blocks.
+  SetVector<BasicBlock *, SmallVector<BasicBlock *, 8> > BBs;
+  SmallPtrSet<Instruction *, 16> MatInsertPts;
+  SmallPtrSet<Instruction *, 16> LifetimeStarts;
+
+  SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
+  Worklist.insert(I);
+
+  for (unsigned int n = 0; n < Worklist.size(); ++n) {
+    Instruction *WI = Worklist[n];
+    for (Value::use_iterator U = WI->use_begin(), E = WI->use_end(); U != E; ++U) {
+      Instruction *UI = dyn_cast<Instruction>(U->getUser());
       assert(UI && "uses must be instructions");
       assert(UI != I && "nope nope nope nope super nope");
 
-      // We only follow casts/GEPs, and assume everything else is a 'real' use.
-      // TODO: Be smarter.
+      // We only follow casts/GEPs, and assume everything else is a 'real' use.
+      // TODO: Be smarter.
+      if (dyn_cast<CastInst>(UI) || dyn_cast<GetElementPtrInst>(UI)) {
+        // Just follow.
+        Worklist.insert(UI);
+        continue;
+      }
+
+      // These intrinsics don't matter, though.
+      if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI)) {
+        switch (II->getIntrinsicID()) {
+         case Intrinsic::lifetime_start:
+           // We should insert *after* these (only happens in the first block right now).
+           // TODO: (This only happens when other code is broken, right..?)
+           LifetimeStarts.insert(II);
+           continue;
+         case Intrinsic::lifetime_end:
+         case Intrinsic::dbg_declare:
+         case Intrinsic::dbg_value:
+           continue;
+         default:
+           break;
+        }
+      }
+
+      Instruction *matInsertPt = findMatInsertPt(UI, U->getOperandNo());
+      MatInsertPts.insert(matInsertPt);
+      BBs.insert(matInsertPt->getParent());
+    }
+  }
+
+  if (BBs.empty()) {
+    // TODO: we should just give up on totally unused stuff? (think of poisoninit)
+    DEBUG(dbgs() << "WARNING: stackzeroinit found no dom point (unused?) for " << *I << "\n");
+    return;
+  }
+
+  SmallVector<BasicBlock *, 8> UseBBs(BBs.begin(), BBs.end());
+
+  if (ColdEHPads &&
+      findEHInsertionPoints(I, BBs, MatInsertPts, LifetimeStarts, InsertPts))
+    return;
+
+  BasicBlock *dominatingBlock = findDominatingBlock(I, BBs);
+
+  if (ColdPathSinking &&
+      findColdInsertionPoints(I, dominatingBlock, UseBBs, MatInsertPts, LifetimeStarts, InsertPts))
+    return;
+
+  Instruction *insertPoint = findInsertionPointInBlock(dominatingBlock, I, MatInsertPts, LifetimeStarts);
+
+  // once upon a time for dynamic allocas (see e.g. gcc's c-parse.c), the above generated bad inserts. should be fine now.
+  // there's some more sanity checks here if you're paranoid.
+  assert(DT->dominates(I, insertPoint) && "definition must dominate insertion point");
+//  if (!DT->dominates(I, insertPoint))
+//    insertPoint = I->getNextNode();
+//  for (Value::use_iterator U = I->use_begin(), E = I->use_end(); U != E; ++U)
+//    if (!DT->dominates(insertPoint, *U)) { I->getParent()->dump(); I->dump(); dyn_cast<Instruction>(*U)->dump(); assert(false); }
+//    assert(((insertPoint == *U) || DT->dominates(insertPoint, *U)) && "insertion point must dominate (or be) user");
+
+  DEBUG(dbgs() << "inserting at " << *insertPoint << " for " << *I << "\n");
+  InsertPts.push_back(insertPoint);
+}
+
+// Whether AI is an alloca SROA may promote to an SSA value: a static one of
+// a single scalar (or vector).
+static bool isScalarAlloca(const AllocaInst *AI) {
+  return AI->isStaticAlloca() && !AI->isArrayAllocation() &&
+         AI->getAllocatedType()->isSingleValueType();
+}
+
+// X86FrameInit can only clear x86-64 SysV frames and AArch64FrameInit
+// AArch64 ones (except for GHC functions, which have no prologue), and naked
+// functions have none; elsewhere we initialize the static allocas ourselves,
+// whatever the policy says.
+static bool canClearFrame(const Function &F) {
+  if (F.hasFnAttribute(Attribute::Naked))
+    return false;
+  Triple T(F.getParent()->getTargetTriple());
+  if (T.getArch() == Triple::aarch64 || T.getArch() == Triple::aarch64_be)
+    return F.getCallingConv() != CallingConv::GHC;
+  return T.getArch() == Triple::x86_64 && !T.isOSWindows();
+}
+
+bool SafeInit::runImpl(Function &F, const TargetLibraryInfo &RunTLI,
+                       const TargetTransformInfo &RunTTI, DominatorTree &RunDT,
+                       LoopInfo &RunLI, BlockFrequencyInfo *RunBFI,
+                       ScalarEvolution *RunSE) {
+  SafeInitTimeRegion TR("SafeInit insertion", F);
+  bool MadeChanges = false;
+
+  // A per-function policy (see the "safeinit-policy" attribute) overrides
+  // the global options: "frame" and "none" leave us nothing to do, "dynamic"
+  // is the per-function version of DynamicOnly, and "frame-exit" only
+  // matters to X86FrameInit, which also clears on return ("mixed", set by
+  // createSafeInitHybridPass, only matters to it too). Without one, the profile
+  // (if any) may pick a policy, which is recorded as the attribute so that
+  // X86FrameInit follows it too.
+  // Frames are only ever cleared to zero, so in pattern-init mode we fill
+  // the static allocas ourselves whatever the policy says.
+  TLI = &RunTLI;
+  int FillByte = TLI->getMallocFillByte(*F.getParent());
+  InitByte = PoisonInit ? 0xcc : FillByte > 0 ? FillByte : 0;
+  bool frameClears = canClearFrame(F) && !InitByte;
+  bool dynamicOnly = DynamicOnly && frameClears;
+  if (Profile && !Revisit && !InitByte && !F.hasFnAttribute("safeinit-policy")) {
+    StringRef Policy = Profile->getPolicy(F.getName());
+    if (!Policy.empty()) {
+      F.addFnAttr("safeinit-policy", Policy);
+      MadeChanges = true;
+    }
+  }
+  if (F.hasFnAttribute("safeinit-policy")) {
+    StringRef Policy = F.getFnAttribute("safeinit-policy").getValueAsString();
+    if (Policy == "none" || (Policy == "frame" && frameClears))
+      return MadeChanges;
+    dynamicOnly = Policy == "dynamic" && frameClears;
+  }
+
+  Module *M = F.getParent();
+  const DataLayout &DL = M->getDataLayout();
+  LLVMContext &C = M->getContext();
+
+  memsetMDKind = C.getMDKindID("stackzeroinit");
+  nozeroinitMDKind = C.getMDKindID("no_zeroinit");
+  initializedMDKind = C.getMDKindID("safeinit.initialized");
+
+  Entry = &F.getEntryBlock();
+  this->DL = &DL;
+
+  DT = &RunDT;
+  LI = &RunLI;
+  BFI = RunBFI;
+  SE = RunSE;
+  TTI = &RunTTI;
+  if (MaterializeLate)
+    computeCyclicBlocks(F);
+
+  addArgInitAttrs(F);
+  if (Revisit || RevisitOnly)
+    return revisitZeroInits(F);
+
+  // When placing inits again, the walk below only visits the allocas whose
+  // inits we took back.
+  bool replace = Replace || ReplaceOnly;
+  SmallPtrSet<AllocaInst *, 16> Replaced;
+  if (replace) {
+    takeFullInits(F, Replaced);
+    if (Replaced.empty())
+      return MadeChanges;
+    MadeChanges = true;
+  }
+
+  // (this replaces calls and adds allocas, so it goes before the walk below)
+  if (HeapToStack && !replace && TLI->getMallocFillByte(*M) == InitByte) {
+    SmallVector<CallInst *, 8> Calls;
+    for (BasicBlock &BB : F)
+      for (Instruction &I : BB)
+        if (CallInst *CI = dyn_cast<CallInst>(&I))
+          Calls.push_back(CI);
+    for (CallInst *CI : Calls)
+      MadeChanges |= moveHeapAllocToStack(*M, CI);
+  }
+
+  // allocas to be merged, keyed by the point they are initialized at
+  MapVector<Instruction *, SmallVector<AllocaInst *, 8> > CoalesceGroups;
+  // dynamic allocas to be zeroed in chunks, with their (indexed) uses
+  SmallVector<std::pair<AllocaInst *, SmallVector<GetElementPtrInst *, 4> >, 4> ChunkedAllocas;
+  // loop-scoped allocas to give reset regions, with their loops
+  SmallVector<std::pair<AllocaInst *, Loop *>, 4> ResetAllocas;
+
+  // Zero-initialize the return value of all alloca calls.
+  for (Function::iterator BB = F.begin(), E = F.end(); BB != E; ++BB) {
+    for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I) {
+      if (I->getMetadata(nozeroinitMDKind))
+        continue;
+      if (TrustDeclInits && I->getMetadata(initializedMDKind)) {
+        DeclInitAllocaCounter++;
+        continue;
+      }
+
+      if (CallInst *CI = dyn_cast<CallInst>(I)) {
+        if (HeapNoInit && !replace && elideHeapInit(*M, CI))
+          MadeChanges = true;
+        continue;
+      }
+
+      if (AllocaInst *AI = dyn_cast<AllocaInst>(I)) {
+        if (replace ? !Replaced.count(AI)
+                    : Which != SafeInitAllocas::All &&
+                      isScalarAlloca(AI) != (Which == SafeInitAllocas::Scalar))
+          continue;
+        if (!replace)
+          AllocaCounter++;
+
+        if (dynamicOnly && AI->isStaticAlloca()) continue;
+
+        if (Advice && AI->isStaticAlloca() &&
+            Advice->hasCandidates(F.getName()) &&
+            Advice->isCandidate(F.getName(), getSafeInitSiteName(*AI))) {
+          AdvisedCandidateCounter++;
+          if (isWrittenBeforeRead(AI)) {
+            DEBUG(dbgs() << *AI << " is written before it's read, as advised\n");
+            AdvisedAllocaCounter++;
+            continue;
+          }
+        }
+
+        // Work out how many bytes are needed to store the type.
+        // someone could investigate getTypeStoreSize, which returns the used bytes, vs getTypeAllocSize, which returns the number of allocated bytes
+        // (for now we're conservative and use the latter, which also makes arrays easier)
+        // NOTE: ScalarReplAggregates only splits memsets which start and end on element
+        // boundaries (it uses getAllocatedType() rather than this..)
+
+	Value *newsizeV;
+        bool sawRead = false;
+        bool initAll = true;
+	// we (ab)use MaterializeLate as a flag for enabling this optimization too, for now
+        if (MaterializeLate && isInitInsensitive(AI, sawRead)) {
+          if (!sawRead)
+            continue;
+          // initialize only the first byte
+          newsizeV = ConstantInt::get(Type::getInt64Ty(C), 1);
+          initAll = false;
+        } else {
+        uint64_t typesize = DL.getTypeAllocSize(AI->getType()->getTypeAtIndex(0U));
+        Value *typesizeV = ConstantInt::get(Type::getInt64Ty(C), typesize);
+        Value *arraysizeV = AI->getArraySize();
+
+        // Multiply the two sizes (CreateMul will optimise the constant case).
+        IRBuilder<> irb(AI);
+        Value *extArraysizeV = irb.CreateZExt(arraysizeV, typesizeV->getType());
+        newsizeV = irb.CreateMul(typesizeV, extArraysizeV);
+        if (ConstantInt *SizeC = dyn_cast<ConstantInt>(newsizeV))
+          raiseAllocaAlignment(AI, SizeC->getZExtValue());
+        }
+
+        SmallVector<GetElementPtrInst *, 4> GEPs;
+        if (DynamicChunks && initAll && isChunkable(AI, GEPs)) {
+          ChunkedAllocas.push_back(std::make_pair(AI, GEPs));
+          continue;
+        }
+
+        if (ResetRegions && initAll && !IgnoreLifetimes) {
+          if (Loop *L = getResetRegionLoop(AI)) {
+            ResetAllocas.push_back(std::make_pair(AI, L));
+            continue;
+          }
+        }
+
+        if (!IgnoreLifetimes && addZeroInitForLifetimes(*M, &*I, &*I, newsizeV, AI->getAlignment())) {
+          MadeChanges = true;
+        } else {
+          SmallVector<Instruction *, 4> IPs;
+          if (MaterializeLate)
+            findInsertionPoints(&*I, IPs);
+          else
+            IPs.push_back(I->getNextNode());
+          if (CoalesceAllocas && initAll && IPs.size() == 1 && isCoalescable(AI, IPs[0])) {
+            CoalesceGroups[IPs[0]].push_back(AI);
+            continue;
+          }
+          for (Instruction *IP : IPs)
+            addZeroInitForUncovered(*M, &*I, IP, newsizeV, AI->getAlignment());
+          MadeChanges |= !IPs.empty();
+        }
+      }
+    }
+  }
+
+  // (the deferred inits below all change the function too)
+  if (!CoalesceGroups.empty() || !ResetAllocas.empty() || !ChunkedAllocas.empty())
+    MadeChanges = true;
+
+  for (auto &Group : CoalesceGroups) {
+    if (Group.second.size() == 1) {
+      AllocaInst *AI = Group.second[0];
+      uint64_t typesize = DL.getTypeAllocSize(AI->getAllocatedType()) *
+        cast<ConstantInt>(AI->getArraySize())->getZExtValue();
+      addZeroInitForUncovered(*M, AI, Group.first,
+        ConstantInt::get(Type::getInt64Ty(C), typesize), AI->getAlignment());
+    } else {
+      coalesceAllocas(*M, Group.second, Group.first);
+    }
+  }
+
+  // (this moves lifetime markers, which the loop above relies on)
+  for (auto &Reset : ResetAllocas)
+    addResetRegion(*M, Reset.first, Reset.second);
+
+  // (this changes the CFG, so we leave it until last)
+  for (auto &Chunked : ChunkedAllocas)
+    addChunkedZeroInit(*M, Chunked.first, Chunked.second);
+
+  return MadeChanges;
+}
+
+static bool hasLifetimeMarkers(Value *V) {
+  for (User *U : V->users()) {
+    if (isa<BitCastInst>(U) && hasLifetimeMarkers(U))
+      return true;
+    if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(U))
+      if (II->getIntrinsicID() == Intrinsic::lifetime_start ||
+          II->getIntrinsicID() == Intrinsic::lifetime_end)
+        return true;
+  }
+  return false;
+}
+
+// Can AI (to be initialized in full just before IP) be merged into a
+// combined alloca?
+bool SafeInit::isCoalescable(AllocaInst *AI, Instruction *IP) const {
+  if (!MaterializeLate || !AI->isStaticAlloca() || AI->getParent() != Entry)
+    return false;
+  // (the alloca following this one could be merged too, and so vanish)
+  if (isa<AllocaInst>(IP))
+    return false;
+  if (AI->isUsedWithInAlloca() || hasLifetimeMarkers(AI) || FindAllocaDbgDeclare(AI))
+    return false;
+  return true;
+}
+
+unsigned SafeInit::getAllocaAlignment(AllocaInst *AI) const {
+  unsigned Align = AI->getAlignment();
+  if (!Align)
+    Align = DL->getABITypeAlignment(AI->getAllocatedType());
+  return Align;
+}
+
+// Give AI (with an init of Size bytes) vector alignment, if that's cheap.
+void SafeInit::raiseAllocaAlignment(AllocaInst *AI, uint64_t Size) {
+  if (!AlignThreshold || Size < AlignThreshold || !AI->isStaticAlloca())
+    return;
+
+  unsigned Align = TTI->getRegisterBitWidth(true) / 8;
+  if (DL->getStackAlignment())
+    Align = std::min(Align, DL->getStackAlignment());
+  if (getAllocaAlignment(AI) >= Align)
+    return;
+
+  AI->setAlignment(Align);
+  RealignedAllocaCounter++;
+}
+
+// Can the dynamic alloca AI be zeroed lazily? Every use must be a load or
+// store through a single-index GEP, with an index which SCEV says only ever
+// increases (so the accessed prefix grows like a high-water mark, and the
+// checks we add before each access mostly fail).
+bool SafeInit::isChunkable(AllocaInst *AI, SmallVectorImpl<GetElementPtrInst *> &GEPs) const {
+  if (AI->isStaticAlloca())
+    return false;
+
+  for (User *U : AI->users()) {
+    GetElementPtrInst *GEP = dyn_cast<GetElementPtrInst>(U);
+    if (!GEP || GEP->getPointerOperand() != AI || GEP->getNumIndices() != 1)
+      return false;
+    for (User *GU : GEP->users()) {
+      if (LoadInst *Load = dyn_cast<LoadInst>(GU)) {
+        if (Load->isVolatile())
+          return false;
+      } else if (StoreInst *Store = dyn_cast<StoreInst>(GU)) {
+        if (Store->isVolatile() || Store->getPointerOperand() != GEP)
+          return false;
+      } else
+        return false;
+    }
+
+    const SCEVAddRecExpr *AR = dyn_cast<SCEVAddRecExpr>(SE->getSCEV(GEP->getOperand(1)));
+    if (!AR || !AR->isAffine() || !SE->isKnownPositive(AR->getStepRecurrence(*SE)))
+      return false;
+    GEPs.push_back(GEP);
+  }
+
+  return !GEPs.empty();
+}
+
+// Zero AI lazily: keep a high-water mark (in elements) below which AI has
+// been zeroed, and before each access at or above it, zero up to the end of
+// the chunk containing the access (or the end of AI).
+void SafeInit::addChunkedZeroInit(Module &M, AllocaInst *AI, ArrayRef<GetElementPtrInst *> GEPs) {
+  LLVMContext &C = M.getContext();
+  IntegerType *Int64Ty = Type::getInt64Ty(C);
+  uint64_t EltSize = DL->getTypeAllocSize(AI->getAllocatedType());
+  uint64_t ChunkElts = std::max<uint64_t>(PowerOf2Floor(DynamicChunkSize / EltSize), 1);
+  unsigned Align = AI->getAlignment() ? MinAlign(AI->getAlignment(), EltSize) : 0;
+
+  AllocaInst *HWMSlot = new AllocaInst(Int64Ty, "safeinit.hwm", &*Entry->getFirstInsertionPt());
+  HWMSlot->setMetadata(nozeroinitMDKind, MDNode::get(C, {}));
+
+  IRBuilder<> irb(AI->getNextNode());
+  Value *NumElts = irb.CreateZExtOrTrunc(AI->getArraySize(), Int64Ty);
+  Value *LastElt = irb.CreateSub(NumElts, ConstantInt::get(Int64Ty, 1));
+  irb.CreateStore(ConstantInt::get(Int64Ty, 0), HWMSlot);
+
+  MDNode *Unlikely = MDBuilder(C).createBranchWeights(1, 100000);
+  for (GetElementPtrInst *GEP : GEPs) {
+    irb.SetInsertPoint(GEP);
+    Value *Idx = irb.CreateSExtOrTrunc(GEP->getOperand(1), Int64Ty);
+    Value *HWM = irb.CreateLoad(HWMSlot);
+    Value *Cmp = irb.CreateICmpUGE(Idx, HWM);
+    TerminatorInst *Then = SplitBlockAndInsertIfThen(Cmp, GEP, false, Unlikely, DT, LI);
+
+    // (out-of-bounds indices are clamped, so none of this can wrap)
+    irb.SetInsertPoint(Then);
+    Value *InBounds = irb.CreateSelect(irb.CreateICmpULT(Idx, NumElts), Idx, LastElt);
+    Value *End = irb.CreateAdd(irb.CreateAnd(InBounds, ~(ChunkElts - 1)),
+                               ConstantInt::get(Int64Ty, ChunkElts));
+    End = irb.CreateSelect(irb.CreateICmpULT(End, NumElts), End, NumElts);
+    Value *Dst = irb.CreateGEP(AI, HWM);
+    Value *Len = irb.CreateMul(irb.CreateSub(End, HWM), ConstantInt::get(Int64Ty, EltSize));
+    addZeroInit(M, Dst, Then, Len, Align);
+    irb.CreateStore(End, HWMSlot);
+  }
+  ChunkedAllocaCounter++;
+}
+
+// Find the lifetime of AI (which must be defined outside L), if it's
+// entirely contained in L: there's a single lifetime.start, which dominates
+// every other use in the loop, and there are no uses at all outside the loop
+// other than casts. Also collects the lifetime.ends and the other uses.
+static IntrinsicInst *getLoopLifetime(Loop *L, AllocaInst *AI, DominatorTree *DT,
+                                      SmallVectorImpl<IntrinsicInst *> &Ends,
+                                      SmallVectorImpl<Instruction *> &LoopUses) {
+  IntrinsicInst *Start = nullptr;
+
+  SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
+  Worklist.insert(AI);
+
+  for (unsigned int n = 0; n < Worklist.size(); ++n) {
+    Instruction *WI = Worklist[n];
+    for (User *U : WI->users()) {
+      Instruction *UI = dyn_cast<Instruction>(U);
+      if (!UI)
+        return nullptr;
+
       if (dyn_cast<CastInst>(UI) || dyn_cast<GetElementPtrInst>(UI)) {
-        // Just follow.
         Worklist.insert(UI);
         continue;
       }
 
-      // These intrinsics don't matter, though.
+      // Any real use outside the loop means the value can flow out of (or
+      // into) the loop, so the per-iteration lifetime isn't the whole story.
+      if (!L->contains(UI))
+        return nullptr;
+
       if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI)) {
         switch (II->getIntrinsicID()) {
          case Intrinsic::lifetime_start:
-           // We should insert *after* these (only happens in the first block right now).
-           // TODO: (This only happens when other code is broken, right..?)
-           LifetimeStarts.insert(II);
+           // Lifetimes covering only part of the alloca aren't worth the effort.
+           if (Start || II->getArgOperand(1)->stripPointerCasts() != AI)
+             return nullptr;
+           Start = II;
            continue;
          case Intrinsic::lifetime_end:
-         case Intrinsic::dbg_declare:
-         case Intrinsic::dbg_value:
+           if (II->getArgOperand(1)->stripPointerCasts() != AI)
+             return nullptr;
+           Ends.push_back(II);
            continue;
          default:
            break;
         }
       }
 
-      Instruction *matInsertPt = findMatInsertPt(UI, U->getOperandNo());
-      MatInsertPts.insert(matInsertPt);
-      BBs.insert(matInsertPt->getParent());
+      LoopUses.push_back(UI);
     }
   }
 
-  if (BBs.empty()) {
-    // TODO: we should just give up on totally unused stuff? (think of poisoninit)
-    DEBUG(dbgs() << "WARNING: stackzeroinit found no dom point (unused?) for " << *I << "\n");
-    return NULL;
-  }
+  if (!Start || Ends.empty())
+    return nullptr;
 
-  BasicBlock *dominatingBlock = Entry;
+  for (Instruction *UI : LoopUses)
+    if (!DT->dominates(Start, UI))
+      return nullptr;
 
-  // TODO: really we should be doing this properly (or at least cache the list)
-  // for now: if there's an edge from a BB which reaches itself,
-  // we just add all predecessors.
-  for (unsigned int n = 0; n < BBs.size(); ++n) { // NOT an iterator
-    BasicBlock *BB = BBs[n];
-    // If this is the block in which the alloca is defined, we know that uses can only flow FROM here.
-    if (BB == I->getParent())
-      continue;
-    for (auto SI = succ_begin(BB); SI != succ_end(BB); ++SI) {
-      // if we can reach BB from this sucessor..
-      if (*SI && isPotentiallyReachableHacked(*SI, BB, DT)) {
-        // .. then add all predecessors of BB
-        for (auto PI = pred_begin(BB); PI != pred_end(BB); ++PI)
-          if (*PI)
-            BBs.insert(*PI);
-        break;
-      }
-    }
-    if (BBs.count(Entry))
-      break;
-  }
+  SmallVector<BasicBlock *, 8> ExitBlocks;
+  L->getUniqueExitBlocks(ExitBlocks);
+  if (!L->getLoopPreheader() || ExitBlocks.empty())
+    return nullptr;
 
-  if (!BBs.count(dominatingBlock))
-    dominatingBlock = findCommonDominator(BBs);
+  // We can't insert anything into exit blocks we can't split.
+  for (BasicBlock *BB : ExitBlocks)
+    if (BB->getFirstInsertionPt() == BB->end())
+      return nullptr;
 
-  Instruction *insertPoint = dominatingBlock->getFirstNonPHIOrDbg();
-  // If the definition is in the dominating block, then the earliest point we can insert
-  // is directly after the definition.
-  // (If there's a lifetime, this also applies; should only happen in first block..)
-  for (BasicBlock::iterator II = dominatingBlock->begin(), E = dominatingBlock->end(); II != E; ++II) {
-    for (auto LS : LifetimeStarts) {
-      if (&*II == LS)
-        insertPoint = II->getNextNode();
-    }
-    if (&*II == I)
-      insertPoint = II->getNextNode();
+  return Start;
+}
+
+// Move the lifetime of AI (as found by getLoopLifetime) out of L: start it
+// in the preheader and end it in the exit blocks.
+static void hoistLifetimeMarkers(Loop *L, AllocaInst *AI, IntrinsicInst *Start,
+                                 SmallVectorImpl<IntrinsicInst *> &Ends) {
+  LLVMContext &C = AI->getContext();
+  Type *Int8PtrTy = Type::getInt8PtrTy(C);
+  Value *Size = Start->getArgOperand(0);
+
+  IRBuilder<> PreheaderBuilder(L->getLoopPreheader()->getTerminator());
+  PreheaderBuilder.CreateLifetimeStart(
+      PreheaderBuilder.CreateBitCast(AI, Int8PtrTy), cast<ConstantInt>(Size));
+
+  SmallVector<BasicBlock *, 8> ExitBlocks;
+  L->getUniqueExitBlocks(ExitBlocks);
+  for (BasicBlock *BB : ExitBlocks) {
+    IRBuilder<> ExitBuilder(&*BB->getFirstInsertionPt());
+    ExitBuilder.CreateLifetimeEnd(
+        ExitBuilder.CreateBitCast(AI, Int8PtrTy), cast<ConstantInt>(Size));
   }
 
-  // Search until we find an instruction we can't insert (directly) before.
-  while (insertPoint != dominatingBlock->getTerminator()) {
-    if (MatInsertPts.count(insertPoint))
-      break;
-    insertPoint = insertPoint->getNextNode();
+  // Remove the old markers, along with any casts which only they used.
+  Ends.push_back(Start);
+  for (IntrinsicInst *II : Ends) {
+    Value *Ptr = II->getArgOperand(1);
+    II->eraseFromParent();
+    RecursivelyDeleteTriviallyDeadInstructions(Ptr);
   }
+}
 
-  // once upon a time for dynamic allocas (see e.g. gcc's c-parse.c), the above generated bad inserts. should be fine now.
-  // there's some more sanity checks here if you're paranoid.
-  assert(DT->dominates(I, insertPoint) && "definition must dominate insertion point");
-//  if (!DT->dominates(I, insertPoint))
-//    insertPoint = I->getNextNode();
-//  for (Value::use_iterator U = I->use_begin(), E = I->use_end(); U != E; ++U)
-//    if (!DT->dominates(insertPoint, *U)) { I->getParent()->dump(); I->dump(); dyn_cast<Instruction>(*U)->dump(); assert(false); }
-//    assert(((insertPoint == *U) || DT->dominates(insertPoint, *U)) && "insertion point must dominate (or be) user");
+// Does the loop-scoped lifetime of AI, with LoopUses (see getLoopLifetime),
+// get a reset region? Only plain loads from and stores to it may use it, so
+// that its stores account for everything an iteration can leave behind.
+static bool isResetRegionCandidate(AllocaInst *AI, ArrayRef<Instruction *> LoopUses,
+                                   const DataLayout &DL) {
+  if (!ResetRegions || !AI->isStaticAlloca())
+    return false;
+  uint64_t Size = DL.getTypeAllocSize(AI->getAllocatedType()) *
+    cast<ConstantInt>(AI->getArraySize())->getZExtValue();
+  if (Size < ResetRegionMinSize)
+    return false;
 
-  DEBUG(dbgs() << "inserting at " << *insertPoint << " for " << *I << "\n");
-  return insertPoint;
+  for (Instruction *UI : LoopUses) {
+    if (LoadInst *Load = dyn_cast<LoadInst>(UI)) {
+      if (!Load->isSimple())
+        return false;
+    } else if (StoreInst *Store = dyn_cast<StoreInst>(UI)) {
+      // (storing a pointer into AI somewhere would let it escape)
+      if (!Store->isSimple() || GetUnderlyingObject(Store->getValueOperand(), DL) == AI)
+        return false;
+    } else
+      return false;
+  }
+  return true;
 }
 
-bool SafeInit::runOnFunction(Function &F) {
-  bool MadeChanges = false;
+static IntrinsicInst *findLifetimeStart(Value *V) {
+  for (User *U : V->users()) {
+    if (isa<CastInst>(U) || isa<GetElementPtrInst>(U))
+      if (IntrinsicInst *II = findLifetimeStart(U))
+        return II;
+    if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(U))
+      if (II->getIntrinsicID() == Intrinsic::lifetime_start)
+        return II;
+  }
+  return nullptr;
+}
 
-  Module *M = F.getParent();
-  const DataLayout &DL = M->getDataLayout();
-  LLVMContext &C = M->getContext();
+// Returns the loop whose iterations are the lifetime of AI, if AI is to get
+// a reset region there (HoistLifetimes leaves these allocas to us).
+Loop *SafeInit::getResetRegionLoop(AllocaInst *AI) const {
+  IntrinsicInst *Start = findLifetimeStart(AI);
+  if (!Start)
+    return nullptr;
+  Loop *L = LI->getLoopFor(Start->getParent());
+  if (!L || L->contains(AI))
+    return nullptr;
+
+  SmallVector<IntrinsicInst *, 4> Ends;
+  SmallVector<Instruction *, 16> LoopUses;
+  if (getLoopLifetime(L, AI, DT, Ends, LoopUses) != Start ||
+      !isResetRegionCandidate(AI, LoopUses, *DL))
+    return nullptr;
+  return L;
+}
 
-  memsetMDKind = C.getMDKindID("stackzeroinit");
-  nozeroinitMDKind = C.getMDKindID("no_zeroinit");
+// Clear AI, whose lifetime is an iteration of L, only up to a high-water
+// mark (in bytes) of what it may have been stored to since it was last
+// cleared: its lifetime is hoisted out of L, and at the top of each
+// iteration we clear up to the mark and reset it. The first iteration clears
+// all of AI. Stores at constant offsets are accounted for by what the mark
+// is reset to; stores striding through an inner loop raise it once, in the
+// inner loop's preheader, to where they finish; other stores in L itself
+// raise it as they happen. If an inner-loop store is none of these, we just
+// hoist the lifetime, as HoistLifetimes would have done.
+void SafeInit::addResetRegion(Module &M, AllocaInst *AI, Loop *L) {
+  LLVMContext &C = M.getContext();
+  IntegerType *Int64Ty = Type::getInt64Ty(C);
+  uint64_t Size = DL->getTypeAllocSize(AI->getAllocatedType()) *
+    cast<ConstantInt>(AI->getArraySize())->getZExtValue();
+  Value *SizeV = ConstantInt::get(Int64Ty, Size);
+  BasicBlock *Preheader = L->getLoopPreheader();
+
+  SmallVector<IntrinsicInst *, 4> Ends;
+  SmallVector<Instruction *, 16> LoopUses;
+  IntrinsicInst *Start = getLoopLifetime(L, AI, DT, Ends, LoopUses);
+  assert(Start && "reset region candidate lost its loop-scoped lifetime");
+
+  uint64_t Fixed = 0;
+  SmallVector<std::pair<Instruction *, const SCEV *>, 4> StridedStores;
+  SmallVector<StoreInst *, 4> OtherStores;
+  bool Trackable = true;
+  for (Instruction *UI : LoopUses) {
+    StoreInst *Store = dyn_cast<StoreInst>(UI);
+    if (!Store)
+      continue;
+    uint64_t StoreSize = DL->getTypeStoreSize(Store->getValueOperand()->getType());
+    const SCEV *Off = SE->getMinusSCEV(SE->getSCEV(Store->getPointerOperand()), SE->getSCEV(AI));
+    const SCEV *End = SE->getAddExpr(Off, SE->getConstant(SE->getEffectiveSCEVType(Off->getType()), StoreSize));
 
-  Entry = &F.getEntryBlock();
+    // (offsets below AI wrap around, and so clear all of it)
+    if (const SCEVConstant *EndC = dyn_cast<SCEVConstant>(End)) {
+      Fixed = std::max(Fixed, std::min(EndC->getValue()->getZExtValue(), Size));
+      continue;
+    }
 
-  DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
-  TLI = &getAnalysis<TargetLibraryInfoWrapperPass>().getTLI();
+    const SCEVAddRecExpr *AR = dyn_cast<SCEVAddRecExpr>(End);
+    if (AR && AR->getLoop() != L && L->contains(AR->getLoop()) && AR->isAffine() &&
+        SE->isKnownPositive(AR->getStepRecurrence(*SE))) {
+      const Loop *SL = AR->getLoop();
+      BasicBlock *SLPreheader = SL->getLoopPreheader();
+      const SCEV *BTC = SE->getBackedgeTakenCount(SL);
+      if (SLPreheader && !isa<SCEVCouldNotCompute>(BTC)) {
+        const SCEV *Last = AR->evaluateAtIteration(BTC, *SE);
+        if (SE->properlyDominates(Last, SLPreheader) && isSafeToExpand(Last, *SE)) {
+          StridedStores.push_back(std::make_pair(SLPreheader->getTerminator(), Last));
+          continue;
+        }
+      }
+    }
 
-  // Zero-initialize the return value of all alloca calls.
-  for (Function::iterator BB = F.begin(), E = F.end(); BB != E; ++BB) {
-    for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I) {
-      if (I->getMetadata(nozeroinitMDKind))
-        continue;
+    // (we don't want to be raising the mark on every iteration of an inner loop)
+    if (LI->getLoopFor(Store->getParent()) != L) {
+      Trackable = false;
+      break;
+    }
+    OtherStores.push_back(Store);
+  }
 
-      if (AllocaInst *AI = dyn_cast<AllocaInst>(I)) {
-        AllocaCounter++;
+  if (!Trackable) {
+    if (HoistLoopLifetimes) {
+      hoistLifetimeMarkers(L, AI, Start, Ends);
+      addZeroInit(M, AI, Preheader->getTerminator(), SizeV, AI->getAlignment());
+      HoistedLifetimeCounter++;
+    } else {
+      addZeroInitForUncovered(M, AI, Start->getNextNode(), SizeV, AI->getAlignment());
+    }
+    return;
+  }
 
-        if (DynamicOnly && AI->isStaticAlloca()) continue;
+  AllocaInst *HWMSlot = new AllocaInst(Int64Ty, "safeinit.hwm", &*Entry->getFirstInsertionPt());
+  HWMSlot->setMetadata(nozeroinitMDKind, MDNode::get(C, {}));
 
-        // Work out how many bytes are needed to store the type.
-        // someone could investigate getTypeStoreSize, which returns the used bytes, vs getTypeAllocSize, which returns the number of allocated bytes
-        // (for now we're conservative and use the latter, which also makes arrays easier)
-        // NOTE: ScalarReplAggregates depends on the memset size matching getTypeAllocSize
-        // (it uses getAllocatedType() rather than this..)
+  IRBuilder<> irb(Preheader->getTerminator());
+  irb.CreateStore(SizeV, HWMSlot);
 
-	Value *newsizeV;
-        bool sawNonTrivialUse = false;
-	// we (ab)use MaterializeLate as a flag for enabling this optimization too, for now
-        if (MaterializeLate && isSafeStringArray(AI, sawNonTrivialUse)) {
-          if (!sawNonTrivialUse)
-            continue;
-          // initialize only the first byte
-          newsizeV = ConstantInt::get(Type::getInt64Ty(C), 1);
-        } else {
-        uint64_t typesize = DL.getTypeAllocSize(AI->getType()->getTypeAtIndex(0U));
-        Value *typesizeV = ConstantInt::get(Type::getInt64Ty(C), typesize);
-        Value *arraysizeV = AI->getArraySize();
+  // (the mark can be past the end of AI, if a store was)
+  irb.SetInsertPoint(Start);
+  Value *HWM = irb.CreateLoad(HWMSlot);
+  Value *Len = irb.CreateSelect(irb.CreateICmpULT(HWM, SizeV), HWM, SizeV);
+  addZeroInit(M, AI, Start, Len, AI->getAlignment());
+  irb.CreateStore(ConstantInt::get(Int64Ty, Fixed), HWMSlot);
 
-        // Multiply the two sizes (CreateMul will optimise the constant case).
-        IRBuilder<> irb(AI);
-        Value *extArraysizeV = irb.CreateZExt(arraysizeV, typesizeV->getType());
-        newsizeV = irb.CreateMul(typesizeV, extArraysizeV);
-        }
+  auto RaiseHWM = [&](Value *End) {
+    Value *Old = irb.CreateLoad(HWMSlot);
+    irb.CreateStore(irb.CreateSelect(irb.CreateICmpUGT(End, Old), End, Old), HWMSlot);
+  };
 
-        if (IgnoreLifetimes || !addZeroInitForLifetimes(*M, &*I, &*I, newsizeV, AI->getAlignment())) {
-          if (MaterializeLate) {
-            Instruction *IP = findDominatingInsertionPoint(&*I);
-            if (IP)
-              addZeroInit(*M, &*I, IP, newsizeV, AI->getAlignment());
-          } else
-            addZeroInit(*M, &*I, I->getNextNode(), newsizeV, AI->getAlignment());
-        }
-      }
-    }
+  SCEVExpander Expander(*SE, *DL, "safeinit");
+  for (auto &Strided : StridedStores) {
+    Value *End = Expander.expandCodeFor(Strided.second, Int64Ty, Strided.first);
+    irb.SetInsertPoint(Strided.first);
+    RaiseHWM(End);
   }
 
-  return MadeChanges;
+  for (StoreInst *Store : OtherStores) {
+    irb.SetInsertPoint(Store->getNextNode());
+    Value *Ptr = irb.CreatePtrToInt(Store->getPointerOperand(), Int64Ty);
+    Value *Off = irb.CreateSub(Ptr, irb.CreatePtrToInt(AI, Int64Ty));
+    uint64_t StoreSize = DL->getTypeStoreSize(Store->getValueOperand()->getType());
+    RaiseHWM(irb.CreateAdd(Off, ConstantInt::get(Int64Ty, StoreSize)));
+  }
+
+  hoistLifetimeMarkers(L, AI, Start, Ends);
+  ResetRegionCounter++;
+}
+
+// Replace Allocas (all static, in the entry block) with slices of a single
+// byte-array alloca, and initialize the whole thing just before IP.
+// The slices are laid out in order of decreasing alignment to keep padding
+// down; the padding is cleared too, which is harmless.
+void SafeInit::coalesceAllocas(Module &M, ArrayRef<AllocaInst *> Allocas, Instruction *IP) {
+  LLVMContext &C = M.getContext();
+
+  SmallVector<AllocaInst *, 8> Sorted(Allocas.begin(), Allocas.end());
+  std::stable_sort(Sorted.begin(), Sorted.end(), [this](AllocaInst *A, AllocaInst *B) {
+    return getAllocaAlignment(A) > getAllocaAlignment(B);
+  });
+
+  SmallVector<uint64_t, 8> Offsets;
+  uint64_t Size = 0;
+  unsigned MaxAlign = 1;
+  for (AllocaInst *AI : Sorted) {
+    unsigned Align = getAllocaAlignment(AI);
+    Size = alignTo(Size, Align);
+    Offsets.push_back(Size);
+    Size += DL->getTypeAllocSize(AI->getAllocatedType()) *
+      cast<ConstantInt>(AI->getArraySize())->getZExtValue();
+    MaxAlign = std::max(MaxAlign, Align);
+  }
+
+  // Put the combined alloca where the first of the allocas was, so it
+  // dominates all their uses.
+  AllocaInst *First = Allocas[0];
+  for (AllocaInst *AI : Allocas)
+    if (DT->dominates(AI, First))
+      First = AI;
+  AllocaInst *NewAI = new AllocaInst(ArrayType::get(Type::getInt8Ty(C), Size),
+                                     nullptr, MaxAlign, "safeinit.coalesced", First);
+
+  IRBuilder<> irb(First);
+  Value *Base = irb.CreateConstInBoundsGEP2_64(NewAI, 0, 0);
+  for (unsigned i = 0, e = Sorted.size(); i != e; ++i) {
+    AllocaInst *AI = Sorted[i];
+    Value *Ptr = Offsets[i] ? irb.CreateConstInBoundsGEP1_64(Base, Offsets[i]) : Base;
+    Value *Cast = irb.CreateBitCast(Ptr, AI->getType());
+    Cast->takeName(AI);
+    AI->replaceAllUsesWith(Cast);
+    CoalescedAllocaCounter++;
+  }
+  // (not in the loop above: First is our insertion point)
+  for (AllocaInst *AI : Sorted)
+    AI->eraseFromParent();
+
+  addZeroInitForUncovered(M, NewAI, IP, ConstantInt::get(Type::getInt64Ty(C), Size), MaxAlign);
 }
 
 // Zero-initialize based on the lifetime intrinsics, following bitcasts.
@@ -505,7 +2473,7 @@ bool SafeInit::addZeroInitForLifetimes(Module &M, Value *V, Instruction *I, Valu
         if (MaterializeLate && U->getParent() == Entry)
           continue;
         FoundLifetimes = true;
-        addZeroInit(M, V, U->getNextNode(), typesize, alignment);
+        addZeroInitForUncovered(M, V, U->getNextNode(), typesize, alignment);
       }
     }
   }
@@ -513,9 +2481,101 @@ bool SafeInit::addZeroInitForLifetimes(Module &M, Value *V, Instruction *I, Valu
   return FoundLifetimes;
 }
 
+// insert zero-init instructions for V immediately before I, but only for the
+// bytes which aren't overwritten before they can be read
+void SafeInit::addZeroInitForUncovered(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment) {
+  ByteCoverage Coverage;
+  ConstantInt *SizeC = dyn_cast<ConstantInt>(typesize);
+  if (!SizeC || !getCoverageBeforeRead(V, I, SizeC->getZExtValue(), Coverage)) {
+    addZeroInit(M, V, I, typesize, alignment);
+    return;
+  }
+
+  SmallVector<std::pair<uint64_t, uint64_t>, 8> Gaps;
+  Coverage.getGaps(SizeC->getZExtValue(), Gaps);
+  if (Gaps.empty()) {
+    OverwrittenAllocaCounter++;
+    return;
+  }
+
+  // too fragmented (or nothing covered at all), so just init everything
+  if (Gaps.size() > MaxPartialRanges ||
+      (Gaps.size() == 1 && Gaps[0].first == 0 && Gaps[0].second == SizeC->getZExtValue())) {
+    addZeroInit(M, V, I, typesize, alignment);
+    return;
+  }
+
+  LLVMContext &C = M.getContext();
+  IRBuilder<> irb(I);
+  Value *Base = irb.CreateBitCast(V, Type::getInt8PtrTy(C));
+  for (auto &Gap : Gaps) {
+    Value *Ptr = Gap.first ? irb.CreateConstInBoundsGEP1_64(Base, Gap.first) : Base;
+    Value *Len = ConstantInt::get(typesize->getType(), Gap.second - Gap.first);
+    addZeroInit(M, Ptr, I, Len, alignment ? MinAlign(alignment, Gap.first) : 0);
+  }
+  PartialAllocaCounter++;
+}
+
+// Whether a store of Ty writes every byte of its alloc size.
+static bool hasNoPadding(Type *Ty, const DataLayout &DL) {
+  if (DL.getTypeStoreSizeInBits(Ty) != DL.getTypeAllocSizeInBits(Ty) ||
+      DL.getTypeSizeInBits(Ty) != DL.getTypeStoreSizeInBits(Ty))
+    return false;
+  if (ArrayType *ATy = dyn_cast<ArrayType>(Ty))
+    return hasNoPadding(ATy->getElementType(), DL);
+  if (StructType *STy = dyn_cast<StructType>(Ty)) {
+    const StructLayout *SL = DL.getStructLayout(STy);
+    uint64_t Offset = 0;
+    for (unsigned i = 0, e = STy->getNumElements(); i != e; ++i) {
+      Type *ElTy = STy->getElementType(i);
+      if (SL->getElementOffset(i) != Offset || !hasNoPadding(ElTy, DL))
+        return false;
+      Offset += DL.getTypeAllocSize(ElTy);
+    }
+    return Offset == SL->getSizeInBytes();
+  }
+  return true;
+}
+
+// The value to store to initialize all of AI (typesize bytes of it) with a
+// single typed store, or null if it needs a memset.
+Constant *SafeInit::getTypedInitValue(AllocaInst *AI, Value *typesize) const {
+  Type *Ty = AI->getAllocatedType();
+  ConstantInt *SizeC = dyn_cast<ConstantInt>(typesize);
+  // (arrays are left alone: they're indexed, so promoting them doesn't
+  // happen anyway, and the backend splits array stores into one per element)
+  if (!SizeC || AI->isArrayAllocation() ||
+      !(Ty->isSingleValueType() || Ty->isStructTy()) ||
+      SizeC->getZExtValue() > TypedStoreMaxSize ||
+      SizeC->getZExtValue() != DL->getTypeAllocSize(Ty) ||
+      !hasNoPadding(Ty, *DL))
+    return nullptr;
+  if (!InitByte)
+    return Constant::getNullValue(Ty);
+  // (structs would need the pattern built field by field)
+  if (!Ty->isSingleValueType())
+    return nullptr;
+  unsigned Bits = DL->getTypeSizeInBits(Ty);
+  Constant *Pattern = ConstantInt::get(
+      AI->getContext(), APInt::getSplat(Bits, APInt(8, InitByte)));
+  if (Ty->isPtrOrPtrVectorTy())
+    return Ty->isPointerTy() ? ConstantExpr::getIntToPtr(Pattern, Ty) : nullptr;
+  return ConstantExpr::getBitCast(Pattern, Ty);
+}
+
 // insert zero-init instruction for V, immediately before I
 void SafeInit::addZeroInit(Module &M, Value *V, Instruction *I, Value *typesize, unsigned alignment) {
   LLVMContext &C = M.getContext();
+
+  if (AllocaInst *AI = dyn_cast<AllocaInst>(V)) {
+    if (Constant *InitVal = getTypedInitValue(AI, typesize)) {
+      StoreInst *Store = new StoreInst(InitVal, AI, false, alignment, I);
+      Store->setMetadata(memsetMDKind, MDNode::get(C, {}));
+      TypedStoreCounter++;
+      return;
+    }
+  }
+
   IntegerType *Int1Ty = Type::getInt1Ty(C);
   IntegerType *Int8Ty = Type::getInt8Ty(C);
   Type *Int8PtrTy = Type::getInt8PtrTy(C);
@@ -534,10 +2594,8 @@ void SafeInit::addZeroInit(Module &M, Value *V, Instruction *I, Value *typesize,
     V = SI;
   }
 
-  // args: pointer (dst), value (zero), size, int32 align (0, for now at least), int1 volatile (0)
-  Value *initValue = ConstantInt::get(Int8Ty, 0);
-  if (PoisonInit)
-    initValue = ConstantInt::get(Int8Ty, 0xcc); /* simplified for release */
+  // args: pointer (dst), value (zero, or the pattern), size, int32 align (0, for now at least), int1 volatile (0)
+  Value *initValue = ConstantInt::get(Int8Ty, InitByte);
   std::vector<Value*> args = { V, initValue, typesize, ConstantInt::get(Int32Ty, alignment), ConstantInt::get(Int1Ty, 0)};
   SI = CallInst::Create(MemSetIntrinsic, args);
 
@@ -547,5 +2605,556 @@ void SafeInit::addZeroInit(Module &M, Value *V, Instruction *I, Value *typesize,
   SI->insertBefore(I);
 }
 
-char SafeInit::ID = 0;
+char SafeInitLegacyPass::ID = 0;
+
+// Try to hoist the lifetime of AI (which must be defined outside L) out of L.
+// We only do this if the lifetime is entirely contained in the loop: there's
+// a single lifetime.start, which dominates every other use in the loop, and
+// there are no uses at all outside the loop other than casts. The contents
+// are dead at the top of every iteration, so extending the lifetime over the
+// whole loop doesn't change the semantics of the program; SafeInit will then
+// initialize the alloca once in the preheader, and later iterations will see
+// whatever the previous iteration left behind (never uninitialized memory).
+bool HoistLifetimes::hoistLifetimes(Loop *L, AllocaInst *AI) {
+  SmallVector<IntrinsicInst *, 4> Ends;
+  SmallVector<Instruction *, 16> LoopUses;
+  IntrinsicInst *Start = getLoopLifetime(L, AI, DT, Ends, LoopUses);
+  if (!Start)
+    return false;
+
+  // SafeInit gives these a reset region instead.
+  if (isResetRegionCandidate(AI, LoopUses, AI->getModule()->getDataLayout()))
+    return false;
+
+  hoistLifetimeMarkers(L, AI, Start, Ends);
+
+  DEBUG(dbgs() << "hoisted lifetime of " << *AI << " out of " << *L);
+  HoistedLifetimeCounter++;
+  return true;
+}
+
+bool HoistLifetimes::runOnLoop(Loop *L, LPPassManager &LPM) {
+  if (!HoistLoopLifetimes || IgnoreLifetimes || skipLoop(L))
+    return false;
+
+  DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+
+  // Candidates are the allocas outside the loop which have lifetime markers
+  // inside it. Inner loops have already been processed, so a lifetime which
+  // was hoisted into our body can be hoisted again here.
+  SetVector<AllocaInst *, SmallVector<AllocaInst *, 8> > Candidates;
+  for (BasicBlock *BB : L->blocks()) {
+    for (Instruction &I : *BB) {
+      IntrinsicInst *II = dyn_cast<IntrinsicInst>(&I);
+      if (!II || II->getIntrinsicID() != Intrinsic::lifetime_start)
+        continue;
+      AllocaInst *AI = dyn_cast<AllocaInst>(II->getArgOperand(1)->stripPointerCasts());
+      if (AI && !L->contains(AI))
+        Candidates.insert(AI);
+    }
+  }
+
+  bool MadeChanges = false;
+  for (AllocaInst *AI : Candidates)
+    MadeChanges |= hoistLifetimes(L, AI);
+
+  return MadeChanges;
+}
+
+char HoistLifetimes::ID = 0;
+
+
+// Weighs, for each static alloca, what its remaining inits cost against what
+// clearing it with the frame would: its size, once per call. Inits which were
+// optimized away (by DSE, say) cost nothing, so allocas without any are left
+// to IR; allocas whose inits run often, or are many small ones, go to the
+// frame. Functions where every alloca goes to the frame get the "frame"
+// policy; ones where only some do get "mixed", with the allocas which
+// X86FrameInit still has to clear marked !frame_zeroinit.
+bool HybridPolicy::runOnFunction(Function &F) {
+  if (!Hybrid || F.isDeclaration() || F.hasFnAttribute("safeinit-policy") ||
+      !canClearFrame(F))
+    return false;
+
+  const DataLayout &DL = F.getParent()->getDataLayout();
+  LLVMContext &C = F.getContext();
+  unsigned memsetMDKind = C.getMDKindID("stackzeroinit");
+  unsigned nozeroinitMDKind = C.getMDKindID("no_zeroinit");
+  BlockFrequencyInfo &BFI = getAnalysis<BlockFrequencyInfoWrapperPass>().getBFI();
+  uint64_t EntryFreq = BFI.getEntryFreq();
+
+  // The static allocas we could leave to the frame, with their inits.
+  MapVector<AllocaInst *, SmallVector<MemSetInst *, 2> > Allocas;
+  for (Instruction &I : F.getEntryBlock())
+    if (AllocaInst *AI = dyn_cast<AllocaInst>(&I))
+      if (AI->isStaticAlloca() && !AI->getMetadata(nozeroinitMDKind))
+        Allocas[AI];
+  if (Allocas.empty())
+    return false;
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB)
+      if (MemSetInst *MSI = dyn_cast<MemSetInst>(&I))
+        if (MSI->getMetadata(memsetMDKind)) {
+          // (the frame is cleared to zero, so pattern inits have to stay)
+          ConstantInt *Val = dyn_cast<ConstantInt>(MSI->getValue());
+          if (!Val || !Val->isZero())
+            return false;
+          auto *AI = dyn_cast<AllocaInst>(GetUnderlyingObject(MSI->getDest(), DL));
+          auto It = AI ? Allocas.find(AI) : Allocas.end();
+          if (It != Allocas.end())
+            It->second.push_back(MSI);
+        }
+
+  SmallVector<AllocaInst *, 8> FrameAllocas;
+  for (auto &A : Allocas) {
+    AllocaInst *AI = A.first;
+    uint64_t Size = DL.getTypeAllocSize(AI->getAllocatedType()) *
+      cast<ConstantInt>(AI->getArraySize())->getZExtValue();
+    double IRCost = 0;
+    for (MemSetInst *MSI : A.second) {
+      ConstantInt *Len = dyn_cast<ConstantInt>(MSI->getLength());
+      uint64_t Bytes = Len ? Len->getZExtValue() : Size;
+      double Freq = EntryFreq ?
+        (double)BFI.getBlockFreq(MSI->getParent()).getFrequency() / EntryFreq : 1.0;
+      IRCost += Freq * (Bytes + HybridMemSetCost);
+    }
+    if (IRCost > Size)
+      FrameAllocas.push_back(AI);
+  }
+  if (FrameAllocas.empty())
+    return false;
+
+  bool AllFrame = FrameAllocas.size() == Allocas.size();
+  MDNode *FrameMD = MDNode::get(C, None);
+  for (AllocaInst *AI : FrameAllocas) {
+    if (!AllFrame)
+      AI->setMetadata("frame_zeroinit", FrameMD);
+    for (MemSetInst *MSI : Allocas[AI]) {
+      Value *Dest = MSI->getRawDest();
+      MSI->eraseFromParent();
+      RecursivelyDeleteTriviallyDeadInstructions(Dest);
+    }
+    HybridFrameAllocaCounter++;
+  }
+
+  DEBUG(dbgs() << "SafeInit: " << F.getName() << " clears " << FrameAllocas.size()
+               << " of " << Allocas.size() << " static allocas with the frame\n");
+  if (AllFrame) {
+    F.addFnAttr("safeinit-policy", "frame");
+    HybridFrameFunctionCounter++;
+  } else {
+    F.addFnAttr("safeinit-policy", "mixed");
+    HybridMixedFunctionCounter++;
+  }
+  return true;
+}
+
+char HybridPolicy::ID = 0;
+
+// Returns the zeroing function for inits of Size bytes with alignment Align
+// (or, in pattern-init mode, the function filling them with Byte), creating
+// it if needed. It's linkonce_odr (in a comdat where there are any), so the
+// copies from different modules of a binary are merged by the linker. Cold
+// ones are kept apart from the rest, in .text.unlikely on ELF targets.
+Function *OutlineInits::getInitFunction(Module &M, uint8_t Byte, uint64_t Size,
+                                        unsigned Align, bool Cold) {
+  std::string Name = Byte ? "__safeinit_fill_" + utohexstr(Byte, true) + "_"
+                          : std::string("__safeinit_zero_");
+  if (Cold)
+    Name += "cold_";
+  Name += utostr(Size) + "_" + utostr(Align);
+  if (Function *F = M.getFunction(Name))
+    return F;
+
+  LLVMContext &C = M.getContext();
+  Triple TT(M.getTargetTriple());
+  FunctionType *FTy = FunctionType::get(Type::getVoidTy(C), Type::getInt8PtrTy(C), false);
+  Function *F = Function::Create(FTy, GlobalValue::LinkOnceODRLinkage, Name, &M);
+  F->setVisibility(GlobalValue::HiddenVisibility);
+  F->setUnnamedAddr(true);
+  F->addFnAttr(Attribute::NoUnwind);
+  F->addFnAttr(Attribute::NoInline);
+  F->addAttribute(1, Attribute::NoCapture);
+  if (!TT.isOSBinFormatMachO())
+    F->setComdat(M.getOrInsertComdat(Name));
+  if (Cold) {
+    F->addFnAttr(Attribute::Cold);
+    if (TT.isOSBinFormatELF())
+      F->setSection(".text.unlikely");
+  }
+
+  IRBuilder<> irb(BasicBlock::Create(C, "entry", F));
+  irb.CreateMemSet(&*F->arg_begin(), irb.getInt8(Byte), Size, Align);
+  irb.CreateRetVoid();
+  return F;
+}
+
+// Replaces the constant-size inits of at least OutlineColdMinSize bytes
+// which run at most OutlineColdPercent% as often as their function does (or
+// are in cold functions) with calls to cold zeroing functions.
+bool OutlineInits::outlineColdInits(Module &M, unsigned memsetMDKind) {
+  bool MadeChanges = false;
+  for (Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    BlockFrequencyInfo &BFI =
+        getAnalysis<BlockFrequencyInfoWrapperPass>(F).getBFI();
+    uint64_t EntryFreq = BFI.getEntryFreq();
+
+    SmallVector<MemSetInst *, 4> ColdInits;
+    for (BasicBlock &BB : F) {
+      if (!F.hasFnAttribute(Attribute::Cold) &&
+          BFI.getBlockFreq(&BB).getFrequency() * 100 >
+              EntryFreq * OutlineColdPercent)
+        continue;
+      for (Instruction &I : BB)
+        if (MemSetInst *MSI = dyn_cast<MemSetInst>(&I)) {
+          ConstantInt *Len = dyn_cast<ConstantInt>(MSI->getLength());
+          if (MSI->getMetadata(memsetMDKind) && !MSI->isVolatile() &&
+              MSI->getDestAddressSpace() == 0 && Len &&
+              isa<ConstantInt>(MSI->getValue()) &&
+              Len->getZExtValue() >= OutlineColdMinSize)
+            ColdInits.push_back(MSI);
+        }
+    }
+
+    for (MemSetInst *MSI : ColdInits) {
+      Function *InitFn = getInitFunction(
+          M, cast<ConstantInt>(MSI->getValue())->getZExtValue(),
+          cast<ConstantInt>(MSI->getLength())->getZExtValue(),
+          MSI->getAlignment(), /*Cold=*/true);
+      CallInst *CI = CallInst::Create(InitFn, MSI->getRawDest(), "", MSI);
+      CI->setDebugLoc(MSI->getDebugLoc());
+      MSI->eraseFromParent();
+      OutlinedColdInitCounter++;
+      MadeChanges = true;
+    }
+  }
+  return MadeChanges;
+}
+
+// Groups the constant-size inits of the module by value, size and
+// alignment, and outlines the groups with the most sites, up to the
+// per-module limit. Cold inits are outlined first, separately.
+bool OutlineInits::runOnModule(Module &M) {
+  if (!Outline && !OutlineCold)
+    return false;
+
+  unsigned memsetMDKind = M.getContext().getMDKindID("stackzeroinit");
+  bool MadeChanges = OutlineCold && outlineColdInits(M, memsetMDKind);
+  if (!Outline)
+    return MadeChanges;
+
+  // (value, (size, alignment))
+  typedef std::pair<unsigned, std::pair<uint64_t, unsigned> > InitKind;
+  MapVector<InitKind, SmallVector<MemSetInst *, 8> > Groups;
+  for (Function &F : M)
+    for (BasicBlock &BB : F)
+      for (Instruction &I : BB)
+        if (MemSetInst *MSI = dyn_cast<MemSetInst>(&I)) {
+          ConstantInt *Len = dyn_cast<ConstantInt>(MSI->getLength());
+          ConstantInt *Val = dyn_cast<ConstantInt>(MSI->getValue());
+          if (!MSI->getMetadata(memsetMDKind) || MSI->isVolatile() ||
+              MSI->getDestAddressSpace() != 0 || !Len || !Val ||
+              Len->getZExtValue() < OutlineMinSize ||
+              Len->getZExtValue() > OutlineMaxSize)
+            continue;
+          Groups[InitKind(Val->getZExtValue(),
+                          std::make_pair(Len->getZExtValue(),
+                                         MSI->getAlignment()))].push_back(MSI);
+        }
+
+  SmallVector<InitKind, 16> Kinds;
+  for (auto &G : Groups)
+    if (G.second.size() >= OutlineMinSites)
+      Kinds.push_back(G.first);
+  std::stable_sort(Kinds.begin(), Kinds.end(),
+                   [&](const InitKind &A, const InitKind &B) {
+                     return Groups[A].size() > Groups[B].size();
+                   });
+  if (Kinds.size() > OutlineMaxFunctions)
+    Kinds.resize(OutlineMaxFunctions);
+
+  for (const InitKind &K : Kinds) {
+    Function *InitFn = getInitFunction(M, K.first, K.second.first,
+                                       K.second.second);
+    for (MemSetInst *MSI : Groups[K]) {
+      CallInst *CI = CallInst::Create(InitFn, MSI->getRawDest(), "", MSI);
+      CI->setDebugLoc(MSI->getDebugLoc());
+      MSI->eraseFromParent();
+      OutlinedInitCounter++;
+    }
+  }
+  DEBUG(dbgs() << "SafeInit: outlined " << Kinds.size() << " init sizes\n");
+  return MadeChanges || !Kinds.empty();
+}
+
+char OutlineInits::ID = 0;
+
+// Clears the destination of MSI with a loop of Granule-sized stores when its
+// size is at most VersionMaxSize, and only runs the memset (a library call,
+// as the size isn't constant) for bigger sizes. If the size is Bounded, i.e.
+// known to be at most VersionMaxSize, the memset is removed.
+void VersionInits::versionInit(MemSetInst *MSI, unsigned Granule, bool Bounded) {
+  LLVMContext &C = MSI->getContext();
+  BasicBlock *Head = MSI->getParent();
+  Function *F = Head->getParent();
+  Value *Len = MSI->getLength();
+  Type *LenTy = Len->getType();
+  uint8_t Byte = cast<ConstantInt>(MSI->getValue())->getZExtValue();
+  unsigned Align = MinAlign(std::max(MSI->getAlignment(), 1u), Granule);
+
+  BasicBlock *Tail = Head->splitBasicBlock(MSI->getIterator(), "safeinit.cont");
+  BasicBlock *Loop = BasicBlock::Create(C, "safeinit.loop", F, Tail);
+  BasicBlock *Call = Bounded ? nullptr : BasicBlock::Create(C, "safeinit.call", F, Tail);
+
+  // Sizes 1 to VersionMaxSize take the loop; subtracting one first lets the
+  // same unsigned compare send zero sizes (which memset handles) to the call.
+  Instruction *OldTerm = Head->getTerminator();
+  IRBuilder<> irb(OldTerm);
+  irb.SetCurrentDebugLocation(MSI->getDebugLoc());
+  Value *Fast = Bounded
+      ? irb.CreateICmpNE(Len, ConstantInt::get(LenTy, 0))
+      : irb.CreateICmpULT(irb.CreateSub(Len, ConstantInt::get(LenTy, 1)),
+                          ConstantInt::get(LenTy, VersionMaxSize));
+  irb.CreateCondBr(Fast, Loop, Bounded ? Tail : Call);
+  OldTerm->eraseFromParent();
+
+  // The size is a multiple of Granule, so the loop needs no tail.
+  Type *StoreTy;
+  Constant *Val;
+  if (Granule == 16) {
+    StoreTy = VectorType::get(irb.getInt8Ty(), 16);
+    Val = ConstantVector::getSplat(16, irb.getInt8(Byte));
+  } else {
+    StoreTy = irb.getIntNTy(Granule * 8);
+    Val = ConstantInt::get(StoreTy, APInt::getSplat(Granule * 8, APInt(8, Byte)));
+  }
+  irb.SetInsertPoint(Loop);
+  PHINode *Offset = irb.CreatePHI(LenTy, 2, "safeinit.offset");
+  Offset->addIncoming(ConstantInt::get(LenTy, 0), Head);
+  Value *Ptr = irb.CreateGEP(MSI->getRawDest(), Offset);
+  StoreInst *SI = irb.CreateAlignedStore(Val, irb.CreateBitCast(Ptr, StoreTy->getPointerTo()), Align);
+  copyZeroInitMetadata(MSI, SI);
+  Value *Next = irb.CreateNUWAdd(Offset, ConstantInt::get(LenTy, Granule));
+  Offset->addIncoming(Next, Loop);
+  irb.CreateCondBr(irb.CreateICmpULT(Next, Len), Loop, Tail);
+
+  if (Bounded) {
+    MSI->eraseFromParent();
+    InlinedInitCounter++;
+  } else {
+    MSI->moveBefore(BranchInst::Create(Tail, Call));
+    VersionedInitCounter++;
+  }
+}
+
+// Finds the variable-size inits of F whose size ScalarEvolution can show to
+// be a multiple of at least VersionMinGranule bytes, and not always bigger
+// than VersionMaxSize, and versions them.
+bool VersionInits::runOnFunction(Function &F) {
+  if (!Version || F.isDeclaration())
+    return false;
+
+  unsigned memsetMDKind = F.getContext().getMDKindID("stackzeroinit");
+  ScalarEvolution &SE = getAnalysis<ScalarEvolutionWrapperPass>().getSE();
+
+  // (init, (granule, whether the size is at most VersionMaxSize))
+  SmallVector<std::pair<MemSetInst *, std::pair<unsigned, bool> >, 8> Inits;
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB)
+      if (MemSetInst *MSI = dyn_cast<MemSetInst>(&I)) {
+        Value *Len = MSI->getLength();
+        if (!MSI->getMetadata(memsetMDKind) || MSI->isVolatile() ||
+            MSI->getDestAddressSpace() != 0 || isa<Constant>(Len) ||
+            !isa<ConstantInt>(MSI->getValue()))
+          continue;
+        const SCEV *S = SE.getSCEV(Len);
+        // (stores wider than 16 bytes aren't worth it for small sizes)
+        unsigned Granule = 1u << std::min(SE.GetMinTrailingZeros(S), 4u);
+        ConstantRange Range = SE.getUnsignedRange(S);
+        if (Granule < VersionMinGranule ||
+            Range.getUnsignedMin().ugt(VersionMaxSize))
+          continue;
+        Inits.push_back(std::make_pair(MSI, std::make_pair(Granule,
+            Range.getUnsignedMax().ule(VersionMaxSize))));
+      }
+
+  for (auto &Init : Inits)
+    versionInit(Init.first, Init.second.first, Init.second.second);
+  DEBUG(dbgs() << "SafeInit: versioned " << Inits.size() << " variable-size inits in " << F.getName() << "\n");
+  return !Inits.empty();
+}
+
+char VersionInits::ID = 0;
+
+namespace {
+  // A store of zero to a static alloca, at a constant offset.
+  struct ZeroStore {
+    StoreInst *SI;
+    int64_t Offset;
+    uint64_t Size;
+    unsigned Position; // in its block
+    bool Merged;
+  };
+}
+
+// How many instructions the stores merged into one may be spread over.
+static const unsigned MergeScanLimit = 64;
+
+// Merges the zero stores of BB to each static alloca into the widest stores
+// (up to MaxWidth bytes) whose naturally aligned range they cover in full,
+// e.g. four i32 stores and an i64 store into a <2 x i64> store. The wide
+// store goes where the last of them was, so every instruction in between
+// must be unable to throw and must neither read nor write what they store;
+// unrelated field writes and the like don't get in the way. Returns the
+// number of wide stores created.
+unsigned MergeZeroStores::mergeInBlock(BasicBlock &BB, AliasAnalysis &AA,
+                                       unsigned MaxWidth) {
+  const DataLayout &DL = BB.getModule()->getDataLayout();
+  MapVector<AllocaInst *, SmallVector<ZeroStore, 8> > Stores;
+  SmallVector<Instruction *, 32> Insts;
+  for (Instruction &I : BB) {
+    Insts.push_back(&I);
+    StoreInst *SI = dyn_cast<StoreInst>(&I);
+    if (!SI || !SI->isSimple() || !isa<Constant>(SI->getValueOperand()) ||
+        !cast<Constant>(SI->getValueOperand())->isNullValue())
+      continue;
+    Type *Ty = SI->getValueOperand()->getType();
+    if (DL.getTypeStoreSizeInBits(Ty) != DL.getTypeSizeInBits(Ty))
+      continue;
+    int64_t Offset = 0;
+    Value *Base = GetPointerBaseWithConstantOffset(SI->getPointerOperand(),
+                                                   Offset, DL);
+    AllocaInst *AI = dyn_cast<AllocaInst>(Base);
+    if (!AI || !AI->isStaticAlloca() || Offset < 0)
+      continue;
+    ZeroStore ZS = { SI, Offset, DL.getTypeStoreSize(Ty),
+                     unsigned(Insts.size() - 1), false };
+    Stores[AI].push_back(ZS);
+  }
+
+  const unsigned StackAlign = std::max(DL.getStackAlignment(), 8u);
+  unsigned NumWide = 0;
+  for (auto &Entry : Stores) {
+    AllocaInst *AI = Entry.first;
+    SmallVectorImpl<ZeroStore> &ZSs = Entry.second;
+    if (ZSs.size() < 2)
+      continue;
+    // (only raise the alignment as far as the stack is aligned anyway)
+    unsigned Align = AI->getAlignment();
+    if (!Align)
+      Align = DL.getPrefTypeAlignment(AI->getAllocatedType());
+    unsigned Widest = std::min(MaxWidth, std::max(Align, StackAlign));
+
+    for (unsigned Width = Widest; Width >= 8; Width /= 2) {
+      // Collect the unmerged stores per Width-aligned window.
+      MapVector<int64_t, SmallVector<ZeroStore *, 8> > Windows;
+      for (ZeroStore &ZS : ZSs) {
+        int64_t Start = ZS.Offset - ZS.Offset % Width;
+        if (!ZS.Merged && ZS.Offset + int64_t(ZS.Size) <= Start + Width)
+          Windows[Start].push_back(&ZS);
+      }
+
+      for (auto &W : Windows) {
+        SmallVectorImpl<ZeroStore *> &Group = W.second;
+        if (Group.size() < 2)
+          continue;
+
+        // They must cover the whole window.
+        std::sort(Group.begin(), Group.end(),
+                  [](const ZeroStore *A, const ZeroStore *B) {
+                    return A->Offset < B->Offset;
+                  });
+        int64_t Covered = W.first;
+        for (ZeroStore *ZS : Group)
+          if (ZS->Offset <= Covered)
+            Covered = std::max(Covered, ZS->Offset + int64_t(ZS->Size));
+        if (Covered < W.first + int64_t(Width))
+          continue;
+
+        // Nothing in between may see the difference.
+        unsigned First = Group[0]->Position, Last = First;
+        SmallPtrSet<Instruction *, 8> InGroup;
+        for (ZeroStore *ZS : Group) {
+          First = std::min(First, ZS->Position);
+          Last = std::max(Last, ZS->Position);
+          InGroup.insert(ZS->SI);
+        }
+        if (Last - First > MergeScanLimit)
+          continue;
+        bool Safe = true;
+        for (unsigned i = First + 1; i < Last && Safe; ++i) {
+          Instruction *I = Insts[i];
+          if (!I || InGroup.count(I))
+            continue;
+          if (I->mayThrow()) {
+            Safe = false;
+            break;
+          }
+          if (!I->mayReadOrWriteMemory())
+            continue;
+          for (ZeroStore *ZS : Group)
+            if (AA.getModRefInfo(I, MemoryLocation::get(ZS->SI)) !=
+                MRI_NoModRef) {
+              Safe = false;
+              break;
+            }
+        }
+        if (!Safe)
+          continue;
+
+        StoreInst *LastSI = cast<StoreInst>(Insts[Last]);
+        if (AI->getAlignment() < Width)
+          AI->setAlignment(Width);
+        IRBuilder<> IRB(LastSI);
+        Type *Ty = Width == 8 ? (Type *)IRB.getInt64Ty()
+                              : VectorType::get(IRB.getInt64Ty(), Width / 8);
+        Value *Ptr = IRB.CreateConstInBoundsGEP1_64(
+            IRB.CreateBitCast(AI, IRB.getInt8PtrTy()), W.first);
+        StoreInst *Wide = IRB.CreateAlignedStore(
+            Constant::getNullValue(Ty),
+            IRB.CreateBitCast(Ptr, Ty->getPointerTo()), Width);
+        // It's still an init if everything merged into it was one.
+        bool AllInits = true;
+        for (ZeroStore *ZS : Group)
+          if (!ZS->SI->getMetadata("stackzeroinit"))
+            AllInits = false;
+        if (AllInits)
+          copyZeroInitMetadata(LastSI, Wide);
+        Wide->setDebugLoc(LastSI->getDebugLoc());
+
+        for (ZeroStore *ZS : Group) {
+          ZS->SI->eraseFromParent();
+          ZS->SI = nullptr;
+          ZS->Merged = true;
+          Insts[ZS->Position] = nullptr;
+        }
+        Insts[Last] = Wide;
+        MergedZeroStoreCounter += Group.size();
+        WideZeroStoreCounter++;
+        NumWide++;
+      }
+    }
+  }
+  return NumWide;
+}
+
+bool MergeZeroStores::runOnFunction(Function &F) {
+  if (!MergeStores || F.isDeclaration())
+    return false;
+
+  AliasAnalysis &AA = getAnalysis<AAResultsWrapperPass>().getAAResults();
+  const TargetTransformInfo &TTI =
+      getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
+  // (the widest store is a vector register, or a 64-bit one)
+  unsigned MaxWidth = std::max(TTI.getRegisterBitWidth(true) / 8, 8u);
+
+  unsigned NumWide = 0;
+  for (BasicBlock &BB : F)
+    NumWide += mergeInBlock(BB, AA, MaxWidth);
+  DEBUG(dbgs() << "SafeInit: created " << NumWide << " wide zero stores in " << F.getName() << "\n");
+  return NumWide != 0;
+}
 
+char MergeZeroStores::ID = 0;
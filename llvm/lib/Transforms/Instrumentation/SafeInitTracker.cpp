@@ -8,91 +8,373 @@
 //===----------------------------------------------------------------------===//
 //
 // This file checks for oversized zero-initializations and warns about them.
+// It can also write a report of every zero-initialization memset left after
+// optimization, with its location, size, loop depth and block frequency,
+// sorted by an estimate of its dynamic cost, and instrument them to count
+// how often they run and how many bytes and cache lines they clear (dumped at
+// exit by the sanitizer stats runtime, and read with sanstats).
 //
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/LoopPass.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Instrumentation.h"
+#include "llvm/Transforms/SafeInit.h"
+#include "llvm/Transforms/Utils/SanitizerStats.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 using namespace llvm;
 
 #define DEBUG_TYPE "safeinittracker"
 
 static cl::opt<unsigned> MaxHeapInitSize ("ZEROINITCHECKER_MAXHEAPINITSIZE", cl::desc("Size which is considered excessive for zero-initializing heap"), cl::init(32 * 1024));
 static cl::opt<unsigned> MaxStackInitSize ("ZEROINITCHECKER_MAXSTACKINITSIZE", cl::desc("Size which is considered excessive for zero-initializing stack"), cl::init(2 * 1024));
+// the report is a YAML document per memset, like optimization remarks
+static cl::opt<std::string> ReportFile ("ZEROINITCHECKER_REPORT", cl::desc("File to write a report of the remaining zero-initializations to ('-' for stdout)"), cl::init(""));
+static cl::opt<bool> RuntimeCounters ("ZEROINITCHECKER_COUNTERS", cl::desc("Count executions, bytes and cache lines of the remaining zero-initializations at run time"), cl::init(false));
+// for counting the cache lines zero-initializations touch, which is what they
+// add to the working set (unlike bytes, this charges partly covered lines)
+static cl::opt<unsigned> CacheLineSize ("ZEROINITCHECKER_CACHELINE", cl::desc("Cache line size (in bytes, a power of two) for counting the cache lines zero-initializations touch"), cl::init(64));
+static cl::opt<unsigned> SymbolicSizeEstimate ("ZEROINITCHECKER_SYMBOLICSIZE", cl::desc("Size (in bytes) assumed for non-constant zero-initializations when estimating their cost"), cl::init(1024));
 
 STATISTIC(FinalStackZeroInitCounter, "Counts number of stackzeroinit memsets which weren't removed");
 STATISTIC(FinalHeapZeroInitCounter, "Counts number of heapzeroinit memsets which weren't removed");
+STATISTIC(FinalStackZeroInitBytes, "Counts number of bytes in constant-size stackzeroinit memsets which weren't removed");
+STATISTIC(FinalStackZeroInitSymbolic, "Counts number of non-constant-size stackzeroinit memsets which weren't removed");
+STATISTIC(FinalZeroInitStores, "Counts number of stores split off zero-init memsets which weren't removed");
+STATISTIC(FinalZeroInitStoreBytes, "Counts number of bytes in stores split off zero-init memsets which weren't removed");
 
 namespace {
-  struct SafeInitTracker : public FunctionPass {
-    static char ID; // Pass identification, replacement for typeid
-    SafeInitTracker() : FunctionPass(ID) {}
+  // a zero-initialization memset, for the report
+  struct ZeroInitSite {
+    std::string Function;
+    std::string File;
+    unsigned Line = 0, Column = 0;
+    bool Heap;
+    bool ConstantSize;
+    uint64_t Size;
+    std::string SizeExpr;
+    unsigned LoopDepth;
+    double Frequency;           // per call of the function
+    Optional<uint64_t> EntryCount;
+    double Cost;                // estimated bytes zeroed
+  };
+
+  // The tracking itself, shared by both pass managers: initialize() once per
+  // module, instrument() each function, then finalize() writes the report
+  // and finishes the counters.
+  struct SafeInitTracker {
+    SafeInitTracker(bool Counters = false)
+        : AddCounters(Counters || RuntimeCounters) {}
 
     unsigned stackMDKind;
     unsigned heapMDKind;
 
+    std::vector<ZeroInitSite> Sites;
+
+    bool AddCounters;
+    std::unique_ptr<SanitizerStatReport> SSR;
+
+    // the report needs these, see needsAnalyses
+    LoopInfo *LI;
+    BlockFrequencyInfo *BFI;
+
+    static bool needsAnalyses() { return !ReportFile.empty(); }
+
+    bool initialize(Module &M);
+    bool instrument(Function &F, LoopInfo *RunLI, BlockFrequencyInfo *RunBFI);
+    bool finalize();
+
+    void addSite(Function &F, MemIntrinsic *II, bool Heap);
+    void writeReport(raw_ostream &OS);
+  };
+
+  // A module pass, as the counters' SanitizerStatReport is only complete
+  // (and the module valid again) once it's finished: a function pass would
+  // finish it in doFinalization, after the verifier's.
+  struct SafeInitTrackerLegacyPass : public ModulePass {
+    static char ID; // Pass identification, replacement for typeid
+    SafeInitTrackerLegacyPass(bool Counters = false)
+        : ModulePass(ID), Impl(Counters) {}
+
     const char *getPassName() const { return "Zero-Initialization Checker"; }
 
     void getAnalysisUsage(AnalysisUsage &AU) const override {
+      if (SafeInitTracker::needsAnalyses()) {
+        AU.addRequired<LoopInfoWrapperPass>();
+        AU.addRequired<BlockFrequencyInfoWrapperPass>();
+      }
+      if (!Impl.AddCounters)
+        AU.setPreservesAll();
+    }
+
+    bool runOnModule(Module &M) override {
+      bool Changed = Impl.initialize(M);
+      for (Function &F : M) {
+        if (F.isDeclaration())
+          continue;
+        if (!SafeInitTracker::needsAnalyses()) {
+          Changed |= Impl.instrument(F, nullptr, nullptr);
+          continue;
+        }
+        // (BFI's run recomputes the LoopInfo in place, so both stay valid)
+        LoopInfo *LI = &getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+        BlockFrequencyInfo *BFI =
+            &getAnalysis<BlockFrequencyInfoWrapperPass>(F).getBFI();
+        Changed |= Impl.instrument(F, LI, BFI);
+      }
+      Changed |= Impl.finalize();
+      return Changed;
     }
 
-    bool runOnFunction(Function &F) override;
+  private:
+    SafeInitTracker Impl;
   };
 }
 
-INITIALIZE_PASS(SafeInitTracker, "safeinittracker",
+INITIALIZE_PASS_BEGIN(SafeInitTrackerLegacyPass, "safeinittracker",
+    "SafeInitTracker: hack to report large uninited variables.",
+    false, false)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(BlockFrequencyInfoWrapperPass)
+INITIALIZE_PASS_END(SafeInitTrackerLegacyPass, "safeinittracker",
     "SafeInitTracker: hack to report large uninited variables.",
     false, false)
 
-bool SafeInitTracker::runOnFunction(Function &F) {
+void SafeInitTracker::addSite(Function &F, MemIntrinsic *II, bool Heap) {
+  BasicBlock *BB = II->getParent();
+
+  ZeroInitSite Site;
+  Site.Function = F.getName().str();
+  if (const DILocation *Loc = II->getDebugLoc()) {
+    Site.File = Loc->getFilename().str();
+    Site.Line = Loc->getLine();
+    Site.Column = Loc->getColumn();
+  }
+  Site.Heap = Heap;
+  Value *Length = II->getLength();
+  if (ConstantInt *CI = dyn_cast<ConstantInt>(Length)) {
+    Site.ConstantSize = true;
+    Site.Size = CI->getValue().getLimitedValue();
+  } else {
+    Site.ConstantSize = false;
+    Site.Size = SymbolicSizeEstimate;
+    raw_string_ostream OS(Site.SizeExpr);
+    Length->printAsOperand(OS, false);
+  }
+  Site.LoopDepth = LI->getLoopDepth(BB);
+  uint64_t EntryFreq = BFI->getEntryFreq();
+  Site.Frequency = EntryFreq ?
+      (double)BFI->getBlockFreq(BB).getFrequency() / EntryFreq : 1.0;
+  Site.EntryCount = F.getEntryCount();
+  Site.Cost = Site.Frequency * Site.Size;
+  if (Site.EntryCount)
+    Site.Cost *= *Site.EntryCount;
+  Sites.push_back(Site);
+}
+
+// single-quoted YAML scalar
+static void writeQuoted(raw_ostream &OS, StringRef S) {
+  OS << '\'';
+  for (char C : S) {
+    if (C == '\'')
+      OS << '\'';
+    OS << C;
+  }
+  OS << '\'';
+}
+
+void SafeInitTracker::writeReport(raw_ostream &OS) {
+  std::stable_sort(Sites.begin(), Sites.end(),
+                   [](const ZeroInitSite &A, const ZeroInitSite &B) {
+                     return A.Cost > B.Cost;
+                   });
+  for (const ZeroInitSite &Site : Sites) {
+    OS << "--- !ZeroInit\n";
+    OS << "Pass:            safeinittracker\n";
+    OS << "Name:            " << (Site.Heap ? "HeapZeroInit" : "StackZeroInit")
+       << "\n";
+    if (!Site.File.empty()) {
+      OS << "DebugLoc:        { File: ";
+      writeQuoted(OS, Site.File);
+      OS << ", Line: " << Site.Line << ", Column: " << Site.Column << " }\n";
+    }
+    OS << "Function:        ";
+    writeQuoted(OS, Site.Function);
+    OS << "\n";
+    if (Site.ConstantSize) {
+      OS << "Size:            " << Site.Size << "\n";
+    } else {
+      OS << "Size:            ";
+      writeQuoted(OS, Site.SizeExpr);
+      OS << "\n";
+    }
+    OS << "LoopDepth:       " << Site.LoopDepth << "\n";
+    OS << "BlockFrequency:  " << format("%g", Site.Frequency) << "\n";
+    if (Site.EntryCount)
+      OS << "EntryCount:      " << *Site.EntryCount << "\n";
+    OS << "EstimatedCost:   " << format("%g", Site.Cost) << "\n";
+    OS << "...\n";
+  }
+}
+
+bool SafeInitTracker::initialize(Module &M) {
+  if (AddCounters)
+    SSR.reset(new SanitizerStatReport(&M));
+  return false;
+}
+
+bool SafeInitTracker::finalize() {
+  bool Changed = false;
+  if (SSR) {
+    SSR->finish();
+    SSR.reset();
+    Changed = true;
+  }
+  if (ReportFile.empty())
+    return Changed;
+  if (ReportFile == "-") {
+    writeReport(outs());
+  } else {
+    std::error_code EC;
+    raw_fd_ostream OS(ReportFile, EC, sys::fs::F_Text);
+    if (EC)
+      errs() << "Warning: could not write zero-init report to " << ReportFile
+             << ": " << EC.message() << "\n";
+    else
+      writeReport(OS);
+  }
+  Sites.clear();
+  return Changed;
+}
+
+// Emits the number of cache lines the memset II, of Len (i64) bytes, touches.
+static Value *countLines(IRBuilder<> &B, MemIntrinsic *II, Value *Len) {
+  Type *Int64Ty = B.getInt64Ty();
+  uint64_t Mask = CacheLineSize - 1;
+  Value *Dest = B.CreatePtrToInt(II->getRawDest(), Int64Ty);
+  Value *Offset = B.CreateAnd(Dest, Mask);
+  Value *End =
+      B.CreateAdd(Offset, B.CreateAdd(Len, ConstantInt::get(Int64Ty, Mask)));
+  Value *Lines = B.CreateLShr(End, Log2_32(CacheLineSize));
+  if (auto *C = dyn_cast<ConstantInt>(Len))
+    return C->isZero() ? ConstantInt::get(Int64Ty, 0) : Lines;
+  return B.CreateSelect(B.CreateICmpEQ(Len, ConstantInt::get(Int64Ty, 0)),
+                        ConstantInt::get(Int64Ty, 0), Lines);
+}
+
+bool SafeInitTracker::instrument(Function &F, LoopInfo *RunLI,
+                                 BlockFrequencyInfo *RunBFI) {
+  LI = RunLI;
+  BFI = RunBFI;
   Module *M = F.getParent();
   LLVMContext &C = M->getContext();
 
   stackMDKind = C.getMDKindID("stackzeroinit");
   heapMDKind = C.getMDKindID("heapzeroinit");
 
+  SmallVector<MemIntrinsic *, 8> Counted;
   for (Function::iterator BB = F.begin(), E = F.end(); BB != E; ++BB) {
     for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I) {
       auto stackMD = I->getMetadata(stackMDKind);
       auto heapMD = I->getMetadata(heapMDKind);
 
+      if (!stackMD && !heapMD)
+        continue;
+
+      // InstCombine and SROA turn small inits into plain stores
+      if (StoreInst *SI = dyn_cast<StoreInst>(I)) {
+        FinalZeroInitStores++;
+        FinalZeroInitStoreBytes +=
+            M->getDataLayout().getTypeStoreSize(SI->getValueOperand()->getType());
+        continue;
+      }
+
       // update counter
       if (stackMD)
         FinalStackZeroInitCounter++;
-      else if (heapMD)
-        FinalHeapZeroInitCounter++;
       else
-        continue;
+        FinalHeapZeroInitCounter++;
 
       // see if we have a memset
       MemIntrinsic *II = dyn_cast<MemIntrinsic>(I);
       if (!II || II->getIntrinsicID() != Intrinsic::memset)
         continue;
+      if (!ReportFile.empty())
+        addSite(F, II, !stackMD);
+      if (SSR)
+        Counted.push_back(II);
       Value *length = II->getLength();
       if (ConstantInt *CI = dyn_cast<ConstantInt>(length)) {
         uint64_t value = CI->getValue().getLimitedValue();
+        if (stackMD)
+          FinalStackZeroInitBytes += value;
         // TODO: nice debug info instead?
         if (stackMD && value >= MaxStackInitSize)
           errs() << "Warning: inited stack alloc " << *II->getDest() << " (in " << F.getName() << ") is excessively large (" << value << " bytes)\n";
         if (heapMD && value >= MaxHeapInitSize)
           errs() << "Warning: inited heap alloc " << *II->getDest() << " (in " << F.getName() << ") is excessively large (" << value << "bytes)\n";
+      } else if (stackMD) {
+        FinalStackZeroInitSymbolic++;
       }
     }
   }
 
-  return false;
+  for (MemIntrinsic *II : Counted) {
+    IRBuilder<> B(II);
+    Value *Len = B.CreateZExtOrTrunc(II->getLength(), B.getInt64Ty());
+    SSR->createWithCounts(B,
+                          II->getMetadata(stackMDKind) ? SanStat_SafeInit_Stack
+                                                       : SanStat_SafeInit_Heap,
+                          {{SanStat_SafeInit_Bytes, Len},
+                           {SanStat_SafeInit_Lines, countLines(B, II, Len)}});
+  }
+
+  return !Counted.empty();
 }
 
-char SafeInitTracker::ID = 0;
+char SafeInitTrackerLegacyPass::ID = 0;
+
+ModulePass *llvm::createSafeInitTrackerPass(bool Counters) {
+  return new SafeInitTrackerLegacyPass(Counters);
+}
+
+PreservedAnalyses SafeInitTrackerPass::run(Module &M,
+                                           AnalysisManager<Module> &AM) {
+  auto &FAM = AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+  SafeInitTracker Impl(Counters);
+  bool Changed = Impl.initialize(M);
+  for (Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    if (!SafeInitTracker::needsAnalyses())
+      Changed |= Impl.instrument(F, nullptr, nullptr);
+    else
+      Changed |= Impl.instrument(F, &FAM.getResult<LoopAnalysis>(F),
+                                 &FAM.getResult<BlockFrequencyAnalysis>(F));
+  }
+  Changed |= Impl.finalize();
+  // (the counters only add instructions, but we can't say so to the new pass
+  // manager yet)
+  return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
 
@@ -12,29 +12,41 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Scalar/DeadStoreElimination.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/CaptureTracking.h"
 #include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/MemoryDependenceAnalysis.h"
+#include "llvm/Analysis/SafeInitTiming.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/PatternMatch.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/MemorySSA.h"
 using namespace llvm;
+using namespace llvm::PatternMatch;
 
 #define DEBUG_TYPE "dse"
 
@@ -42,79 +54,195 @@ STATISTIC(NumRedundantStores, "Number of redundant stores deleted");
 STATISTIC(NumFastStores, "Number of stores deleted");
 STATISTIC(NumFastOther , "Number of other instrs removed");
 STATISTIC(NumNonLocalStores, "Number of non-local stores deleted");
+STATISTIC(NumNoInitAllocs, "Number of write-only allocations switched to no-init entry points");
+STATISTIC(NumSafeInitMSSA, "Number of SafeInit memsets deleted using MemorySSA");
+STATISTIC(NumSafeInitMSSATrimmed, "Number of SafeInit memsets trimmed using MemorySSA");
+STATISTIC(NumNonLocalQueries, "Number of non-local dependencies followed");
+STATISTIC(NumNonLocalBlocks, "Number of blocks scanned for non-local dependencies");
 
 static cl::opt<bool> EnableNonLocalDSE("enable-nonlocal-dse", cl::init(true));
-static cl::opt<bool> EnableSmallNonLocalDSE("enable-small-nonlocal-dse", cl::init(false));
-extern cl::opt<bool> MallocReturnsZero;
+
+// Non-local DSE scans predecessor blocks for every store with a non-local
+// dependency, which blows up in big functions (perlbench); it used to be
+// limited to stores of more than 8 bytes for that, which kept many small
+// SafeInit memsets alive. Instead bound the blocks scanned per function.
+static cl::opt<unsigned> NonLocalBlockBudget("dse-nonlocal-block-budget", cl::init(4096),
+  cl::desc("Maximum number of blocks scanned by non-local DSE per function"));
+
+// Before the usual (MemoryDependence-based) DSE, find the SafeInit stack
+// memsets which are (in part) overwritten on every path before being read by
+// walking their MemorySSA def-use chains, and remove or trim them. This
+// looks across any CFG, adding up any number of partial overwrites, without
+// the non-local limits below, at a cost of at most SafeInitWalkLimit
+// accesses per memset.
+static cl::opt<bool> EnableSafeInitMSSA("enable-safeinit-mssa-dse", cl::init(false),
+  cl::desc("Remove dead SafeInit memsets using MemorySSA"));
+static cl::opt<unsigned> SafeInitWalkLimit("safeinit-mssa-dse-limit", cl::init(4096), cl::Hidden,
+  cl::desc("Maximum number of memory accesses visited per SafeInit memset"));
 
 /// MaxNonLocalAttempts is an arbitrary threshold that provides
 /// an early opportunitiy for bail out to control compile time.
 static const unsigned MaxNonLocalAttempts = 100;
 
 namespace {
-  struct DSE : public FunctionPass {
+  struct DSE {
     AliasAnalysis *AA;
     MemoryDependenceResults *MD;
     DominatorTree *DT;
     const TargetLibraryInfo *TLI;
+    // for comparing the sizes of variable-size writes
+    ScalarEvolution *SE;
+    // whether there are SafeInit memsets to emit remarks for
+    bool HasSafeInit;
+    // whether to look for what keeps them: someone may want missed remarks
+    bool RemarkBlockedSafeInits;
+    // the byte allocations come filled with, or -1
+    // (TargetLibraryInfo::getMallocFillByte)
+    int MallocFillByte;
+    // blocks non-local DSE may still scan in this function, and whether it
+    // ran out
+    unsigned NonLocalBlocksLeft;
+    bool NonLocalOverBudget;
+
+    DSE() : AA(nullptr), MD(nullptr), DT(nullptr), SE(nullptr) {}
+
+    bool runImpl(Function &F, AliasAnalysis &RunAA,
+                 MemoryDependenceResults &RunMD, DominatorTree &RunDT,
+                 const TargetLibraryInfo &RunTLI, ScalarEvolution &RunSE) {
+      AA = &RunAA;
+      MD = &RunMD;
+      DT = &RunDT;
+      TLI = &RunTLI;
+      SE = &RunSE;
+      MallocFillByte = TLI->getMallocFillByte(*F.getParent());
+
+      HasSafeInit = false;
+      for (Instruction &I : instructions(F))
+        if (isSafeInitMemset(&I)) {
+          HasSafeInit = true;
+          break;
+        }
+      // (A diagnostic handler may want any remark; without one, only those
+      // -pass-remarks-missed asks for get out.)
+      RemarkBlockedSafeInits =
+          HasSafeInit &&
+          (F.getContext().getDiagnosticHandler() ||
+           DiagnosticInfoOptimizationRemarkMissed(DEBUG_TYPE, F, DebugLoc(), "")
+               .isEnabled());
 
-    static char ID; // Pass identification, replacement for typeid
-    DSE() : FunctionPass(ID), AA(nullptr), MD(nullptr), DT(nullptr) {
-      initializeDSEPass(*PassRegistry::getPassRegistry());
-    }
+      NonLocalBlocksLeft = NonLocalBlockBudget;
+      NonLocalOverBudget = false;
 
-    bool runOnFunction(Function &F) override {
-      if (skipFunction(F))
-        return false;
+      bool Changed = false;
+      if (EnableSafeInitMSSA && HasSafeInit) {
+        SafeInitTimeRegion TR("DSE of SafeInit memsets with MemorySSA", F);
+        Changed |= eliminateDeadSafeInits(F);
+      }
 
-      AA = &getAnalysis<AAResultsWrapperPass>().getAAResults();
-      MD = &getAnalysis<MemoryDependenceWrapperPass>().getMemDep();
-      DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
-      TLI = &getAnalysis<TargetLibraryInfoWrapperPass>().getTLI();
+      Changed |= eliminateWriteOnlyObjects(F);
 
-      bool Changed = false;
       for (BasicBlock &I : F)
         // Only check non-dead blocks.  Dead blocks may have strange pointer
         // cycles that will confuse alias analysis.
         if (DT->isReachableFromEntry(&I))
           Changed |= runOnBasicBlock(I);
 
-      AA = nullptr; MD = nullptr; DT = nullptr;
+      AA = nullptr; MD = nullptr; DT = nullptr; SE = nullptr;
       return Changed;
     }
 
     bool runOnBasicBlock(BasicBlock &BB);
     bool MemoryIsNotModifiedBetween(Instruction *FirstI, Instruction *SecondI);
     bool HandleFree(CallInst *F);
+    bool isSameAddress(const Value *P1, const Value *P2);
+    bool isKnownNotSmaller(Value *Len1, Value *Len2);
     bool handleNonLocalDependency(Instruction *Inst);
     bool handleEndBlock(BasicBlock &BB);
+    bool eliminateWriteOnlyObjects(Function &F);
+    bool findWriteOnlyStores(Instruction *Obj,
+                             std::set<Instruction *> &DeadStores);
+    bool useNoInitAllocation(CallInst *CI);
+    bool eliminateDeadSafeInits(Function &F);
+    bool getSafeInitLiveRange(MemSetInst *MSI, MemorySSA &MSSA,
+                              int64_t &LiveBegin, int64_t &LiveEnd);
+    void remarkBlockedSafeInit(Instruction *Inst, const MemoryLocation &Loc,
+                               Instruction *Blocker, BasicBlock *BB);
     void RemoveAccessedObjects(const MemoryLocation &LoadedLoc,
                                SmallSetVector<Value *, 16> &DeadStackObjects,
                                const DataLayout &DL);
 
+    static bool isSafeInitMemset(const Instruction *I);
+  };
+
+  struct DSELegacyPass : public FunctionPass {
+    static char ID; // Pass identification, replacement for typeid
+    DSELegacyPass() : FunctionPass(ID) {
+      initializeDSELegacyPassPass(*PassRegistry::getPassRegistry());
+    }
+
+    bool runOnFunction(Function &F) override {
+      if (skipFunction(F))
+        return false;
+
+      return Impl.runImpl(
+          F, getAnalysis<AAResultsWrapperPass>().getAAResults(),
+          getAnalysis<MemoryDependenceWrapperPass>().getMemDep(),
+          getAnalysis<DominatorTreeWrapperPass>().getDomTree(),
+          getAnalysis<TargetLibraryInfoWrapperPass>().getTLI(),
+          getAnalysis<ScalarEvolutionWrapperPass>().getSE());
+    }
+
     void getAnalysisUsage(AnalysisUsage &AU) const override {
       AU.setPreservesCFG();
       AU.addRequired<DominatorTreeWrapperPass>();
       AU.addRequired<AAResultsWrapperPass>();
       AU.addRequired<MemoryDependenceWrapperPass>();
       AU.addRequired<TargetLibraryInfoWrapperPass>();
+      AU.addRequired<ScalarEvolutionWrapperPass>();
       AU.addPreserved<DominatorTreeWrapperPass>();
       AU.addPreserved<GlobalsAAWrapperPass>();
       AU.addPreserved<MemoryDependenceWrapperPass>();
     }
+
+  private:
+    DSE Impl;
   };
 }
 
-char DSE::ID = 0;
-INITIALIZE_PASS_BEGIN(DSE, "dse", "Dead Store Elimination", false, false)
+PreservedAnalyses DSEPass::run(Function &F, AnalysisManager<Function> &AM) {
+  auto &DT = AM.getResult<DominatorTreeAnalysis>(F);
+  auto &TLI = AM.getResult<TargetLibraryAnalysis>(F);
+  auto &AA = AM.getResult<AAManager>(F);
+  auto &MD = AM.getResult<MemoryDependenceAnalysis>(F);
+  auto &SE = AM.getResult<ScalarEvolutionAnalysis>(F);
+  if (!DSE().runImpl(F, AA, MD, DT, TLI, SE))
+    return PreservedAnalyses::all();
+
+  // DSE only deletes instructions, so the CFG (and what is computed from it
+  // alone) is intact for the passes after it.
+  PreservedAnalyses PA;
+  PA.preserve<DominatorTreeAnalysis>();
+  PA.preserve<LoopAnalysis>();
+  PA.preserve<GlobalsAA>();
+  PA.preserve<MemoryDependenceAnalysis>();
+  return PA;
+}
+
+char DSELegacyPass::ID = 0;
+INITIALIZE_PASS_BEGIN(DSELegacyPass, "dse", "Dead Store Elimination", false,
+                      false)
 INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(AAResultsWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(GlobalsAAWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(MemoryDependenceWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(TargetLibraryInfoWrapperPass)
-INITIALIZE_PASS_END(DSE, "dse", "Dead Store Elimination", false, false)
+INITIALIZE_PASS_DEPENDENCY(ScalarEvolutionWrapperPass)
+INITIALIZE_PASS_END(DSELegacyPass, "dse", "Dead Store Elimination", false,
+                    false)
 
-FunctionPass *llvm::createDeadStoreEliminationPass() { return new DSE(); }
+FunctionPass *llvm::createDeadStoreEliminationPass() {
+  return new DSELegacyPass();
+}
 
 //===----------------------------------------------------------------------===//
 // Helper functions
@@ -218,6 +346,9 @@ static MemoryLocation getLocForWrite(Instruction *Inst, AliasAnalysis &AA) {
     return Loc;
   }
 
+  if (InitializedInst *II = dyn_cast<InitializedInst>(Inst))
+    return MemoryLocation::getForDest(II);
+
   IntrinsicInst *II = dyn_cast<IntrinsicInst>(Inst);
   if (!II)
     return MemoryLocation();
@@ -236,6 +367,17 @@ static MemoryLocation getLocForWrite(Instruction *Inst, AliasAnalysis &AA) {
   }
 }
 
+/// getWriteLength - Return the length in bytes, possibly not a constant, of
+/// the write done by the memory intrinsic or llvm.initialized marker I, or
+/// null for any other instruction.
+static Value *getWriteLength(Instruction *I) {
+  if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(I))
+    return MI->getLength();
+  if (InitializedInst *II = dyn_cast<InitializedInst>(I))
+    return II->getLength();
+  return nullptr;
+}
+
 /// getLocForRead - Return the location read by the specified "hasMemoryWrite"
 /// instruction if any.
 static MemoryLocation getLocForRead(Instruction *Inst,
@@ -271,9 +413,11 @@ static bool isRemovable(Instruction *I) {
     case Intrinsic::memset:
     case Intrinsic::memmove:
     case Intrinsic::memcpy:
-    case Intrinsic::initialized:
       // Don't remove volatile memory intrinsics.
       return !cast<MemIntrinsic>(II)->isVolatile();
+    case Intrinsic::initialized:
+      // Markers store nothing; dropping one only loses information.
+      return true;
     }
   }
 
@@ -322,6 +466,8 @@ static Value *getStoredPointerOperand(Instruction *I) {
     return SI->getPointerOperand();
   if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(I))
     return MI->getDest();
+  if (InitializedInst *II = dyn_cast<InitializedInst>(I))
+    return II->getDest();
 
   if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(I)) {
     switch (II->getIntrinsicID()) {
@@ -511,6 +657,123 @@ static bool isPossibleSelfRead(Instruction *Inst,
   return true;
 }
 
+//===----------------------------------------------------------------------===//
+// SafeInit remarks
+//===----------------------------------------------------------------------===//
+
+// Every decision to remove, shorten or keep a zero-init memset added by
+// SafeInit (or by clang for heap allocations) is reported with -Rpass=dse or
+// -Rpass-missed=dse, naming the instruction responsible, so that we can tell
+// which limit keeps the remaining ones alive.
+
+bool DSE::isSafeInitMemset(const Instruction *I) {
+  return isa<MemSetInst>(I) && (I->getMetadata("stackzeroinit") ||
+                                I->getMetadata("heapzeroinit"));
+}
+
+/// describeForRemark - Name an instruction in a remark: the callee for calls,
+/// otherwise the opcode and (with debug info) the source line.
+/// Returns true if storing V to Ptr, in Alloc's memory, leaves it as the
+/// allocation function left it: zero for calloc, or the allocator's fill byte
+/// (if known, see TargetLibraryInfo::getMallocFillByte) for malloc and new,
+/// and so on (see getInitialAllocatedByte).
+static bool storesInitialContents(Value *V, Value *Ptr, Value *Alloc,
+                                  int MallocFillByte, const DataLayout &DL,
+                                  const TargetLibraryInfo *TLI) {
+  ConstantInt *Byte = dyn_cast_or_null<ConstantInt>(isBytewiseValue(V));
+  if (!Byte)
+    return false;
+  int64_t Offset;
+  if (GetPointerBaseWithConstantOffset(Ptr, Offset, DL) != Alloc)
+    Offset = -1;
+  int InitByte = getInitialAllocatedByte(Alloc, Offset, MallocFillByte, DL,
+                                         TLI);
+  return InitByte >= 0 && Byte->getZExtValue() == (uint64_t)InitByte;
+}
+
+static std::string describeForRemark(const Instruction *I) {
+  if (auto *CI = dyn_cast<CallInst>(I)) {
+    if (const Function *Callee = CI->getCalledFunction())
+      return ("call to " + Callee->getName()).str();
+    return "indirect call";
+  }
+  std::string Desc = I->getOpcodeName();
+  if (const DebugLoc &DL = I->getDebugLoc())
+    Desc += " at line " + utostr(DL.getLine());
+  return Desc;
+}
+
+static void remarkSafeInit(Instruction *MemSet, bool Kept, const Twine &Msg) {
+  Function *F = MemSet->getFunction();
+  if (Kept)
+    emitOptimizationRemarkMissed(F->getContext(), DEBUG_TYPE, *F,
+                                 MemSet->getDebugLoc(), Msg);
+  else
+    emitOptimizationRemark(F->getContext(), DEBUG_TYPE, *F,
+                           MemSet->getDebugLoc(), Msg);
+}
+
+/// remarkBlockedSafeInit - Blocker stopped the search for the stores Inst
+/// overwrites in BB; if a SafeInit memset is right behind it, report it as
+/// kept because of Blocker.
+void DSE::remarkBlockedSafeInit(Instruction *Inst, const MemoryLocation &Loc,
+                                Instruction *Blocker, BasicBlock *BB) {
+  if (!RemarkBlockedSafeInits || Blocker == &BB->front())
+    return;
+  MemDepResult Dep = MD->getPointerDependencyFrom(
+      Loc, false, Blocker->getIterator(), BB, Inst);
+  if ((Dep.isDef() || Dep.isClobber()) && isSafeInitMemset(Dep.getInst()))
+    remarkSafeInit(Dep.getInst(), true,
+                   "kept SafeInit memset: " + describeForRemark(Blocker) +
+                       " may read it before " + describeForRemark(Inst) +
+                       " overwrites it");
+}
+
+//===----------------------------------------------------------------------===//
+// Symbolic sizes
+//===----------------------------------------------------------------------===//
+
+// SafeInit clears variable-length allocas with a memset of the alloca's size
+// expression; the code that later fills them (often a loop that LoopIdiom has
+// turned into a memset or memcpy) computes the same size separately, so the
+// two lengths are rarely the same Value.  ScalarEvolution can still tell they
+// are equal, or that one is no smaller than the other.
+
+/// isSameAddress - Returns true if P1 and P2 are known to be the same address.
+bool DSE::isSameAddress(const Value *P1, const Value *P2) {
+  if (P1 == P2)
+    return true;
+  if (!SE || !SE->isSCEVable(P1->getType()) ||
+      P1->getType() != P2->getType())
+    return false;
+  const SCEV *Diff = SE->getMinusSCEV(SE->getSCEV(const_cast<Value *>(P1)),
+                                      SE->getSCEV(const_cast<Value *>(P2)));
+  return Diff->isZero();
+}
+
+/// isKnownNotSmaller - Returns true if length Len1 is known to be at least
+/// Len2 (as unsigned byte counts).
+bool DSE::isKnownNotSmaller(Value *Len1, Value *Len2) {
+  if (Len1 == Len2)
+    return true;
+  if (!SE || !SE->isSCEVable(Len1->getType()) ||
+      !SE->isSCEVable(Len2->getType()))
+    return false;
+  Type *Int64Ty = Type::getInt64Ty(Len1->getContext());
+  const SCEV *S1 = SE->getTruncateOrZeroExtend(SE->getSCEV(Len1), Int64Ty);
+  const SCEV *S2 = SE->getTruncateOrZeroExtend(SE->getSCEV(Len2), Int64Ty);
+  if (S1 == S2 || SE->isKnownPredicate(ICmpInst::ICMP_UGE, S1, S2))
+    return true;
+  // SCEV only keeps nuw flags inside loops, so take them from the IR for
+  // Len2 padded by a constant: Len1 = add nuw Len2, C.
+  Value *X;
+  if (match(Len1, m_NUWAdd(m_Value(X), m_ConstantInt())) &&
+      SE->getTruncateOrZeroExtend(SE->getSCEV(X), Int64Ty) == S2)
+    return true;
+  if (auto *Max = dyn_cast<SCEVUMaxExpr>(S1))
+    return std::find(Max->op_begin(), Max->op_end(), S2) != Max->op_end();
+  return false;
+}
 
 //===----------------------------------------------------------------------===//
 // DSE Pass
@@ -566,17 +829,18 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
         }
       }
 
-      // Remove null stores into the calloc'ed objects
+      // Remove null stores into the calloc'ed objects (and stores of the
+      // fill byte into malloc'ed ones, if the allocator fills)
       Constant *StoredConstant = dyn_cast<Constant>(SI->getValueOperand());
 
-      if (StoredConstant && StoredConstant->isNullValue() &&
-          isRemovable(SI)) {
+      if (StoredConstant && isRemovable(SI)) {
         Instruction *UnderlyingPointer = dyn_cast<Instruction>(
             GetUnderlyingObject(SI->getPointerOperand(), DL));
 
-        bool isCallocLike = UnderlyingPointer && isCallocLikeFn(UnderlyingPointer, TLI);
-        isCallocLike |= (UnderlyingPointer && MallocReturnsZero && isMallocLikeFn(UnderlyingPointer, TLI));
-        if (UnderlyingPointer && isCallocLike &&
+        if (UnderlyingPointer &&
+            storesInitialContents(StoredConstant, SI->getPointerOperand(),
+                                  UnderlyingPointer, MallocFillByte, DL,
+                                  TLI) &&
             MemoryIsNotModifiedBetween(UnderlyingPointer, SI)) {
           DEBUG(dbgs()
                 << "DSE: Remove null store to the calloc'ed object:\n  DEAD: "
@@ -588,17 +852,18 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
       }
     }
 
-    // remove null memset instructions into calloc'ed stuff
+    // remove null memset instructions into calloc'ed stuff (and memsets of
+    // the fill byte into malloc'ed stuff)
     if (MemSetInst *MSI = dyn_cast<MemSetInst>(Inst)) {
       Value *V = MSI->getValue();
       Value *Dest = MSI->getDest();
       Instruction *UnderlyingPointer = dyn_cast<Instruction>(GetUnderlyingObject(Dest, DL));
 
       Constant *StoredConstant = dyn_cast<Constant>(V);
-      if (StoredConstant && StoredConstant->isNullValue() && isRemovable(MSI)) {
-        bool isCallocLike = UnderlyingPointer && isCallocLikeFn(UnderlyingPointer, TLI);
-        isCallocLike |= (UnderlyingPointer && MallocReturnsZero && isMallocLikeFn(UnderlyingPointer, TLI));
-        if (UnderlyingPointer && isCallocLike &&
+      if (StoredConstant && isRemovable(MSI)) {
+        if (UnderlyingPointer &&
+            storesInitialContents(StoredConstant, Dest, UnderlyingPointer,
+                                  MallocFillByte, DL, TLI) &&
             MemoryIsNotModifiedBetween(UnderlyingPointer, MSI)) {
           DEBUG(dbgs()
                 << "DSE: Remove null memset to the calloc'ed object:\n  DEAD: "
@@ -632,8 +897,10 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
         Instruction *DepWrite = InstDep.getInst();
         MemoryLocation DepLoc = getLocForWrite(DepWrite, *AA);
         // If we didn't get a useful location, or if it isn't a size, bail out.
-        if (!DepLoc.Ptr)
+        if (!DepLoc.Ptr) {
+          remarkBlockedSafeInit(Inst, Loc, DepWrite, &BB);
           break;
+        }
 
         // If we find a write that is a) removable (i.e., non-volatile), b) is
         // completely obliterated by the store to 'Loc', and c) which we know
@@ -646,6 +913,10 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
           if (OR == OverwriteComplete) {
             DEBUG(dbgs() << "DSE: Remove Dead Store:\n  DEAD: " << *DepWrite
                          << "\n  KILLER: " << *Inst << '\n');
+            if (isSafeInitMemset(DepWrite))
+              remarkSafeInit(DepWrite, false,
+                             "removed SafeInit memset overwritten by " +
+                                 describeForRemark(Inst));
 
             // Delete the store and now-dead instructions that feed it.
             DeleteDeadInstruction(DepWrite, *MD, *TLI);
@@ -692,6 +963,11 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
               Value *TrimmedLength =
                   ConstantInt::get(DepWriteLength->getType(), NewLength);
               DepIntrinsic->setLength(TrimmedLength);
+              if (isSafeInitMemset(DepIntrinsic))
+                remarkSafeInit(DepIntrinsic, false,
+                               "shortened SafeInit memset to " +
+                                   Twine(NewLength) + " bytes, the rest is "
+                                   "overwritten by " + describeForRemark(Inst));
 
               if (!IsOverwriteEnd) {
                 int64_t OffsetMoved = (InstWriteOffset - DepWriteOffset);
@@ -703,8 +979,13 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
               }
 
               MadeChange = true;
+            } else if (isSafeInitMemset(DepWrite)) {
+              remarkSafeInit(DepWrite, true,
+                             "kept SafeInit memset: the part overwritten by " +
+                                 describeForRemark(Inst) + " is not aligned "
+                                 "for shortening it");
             }
-          } else if (MemIntrinsic *NewIntrinsic = dyn_cast<MemIntrinsic>(Inst)) {
+          } else if (Value *NewLength = getWriteLength(Inst)) {
             // We want to shorten a memset, where there's a second non-constant store.
             // TODO: if both of the stores are doing the same thing, why don't we just kill the second store instead...
             //errs() << "normal DSE failed for: " << *DepWrite << " " << *Inst << "\n";
@@ -721,12 +1002,17 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
             // can we clobber the original entirely?
             if (DepIntrinsic) {
               Value *OldV = DepIntrinsic->getLength();
-              Value *NewV = NewIntrinsic->getLength();
-              if ((P1 == P2) && (OldV == NewV)) {
+              Value *NewV = NewLength;
+              if (isSameAddress(P1, P2) &&
+                  (OldV == NewV || isKnownNotSmaller(NewV, OldV))) {
                 // this is a complete overwrite! the old memset can be removed
 
                 DEBUG(dbgs() << "DSE: Remove Dead Dyn-Size Store:\n  DEAD: " << *DepWrite
                          << "\n  KILLER: " << *Inst << '\n');
+                if (isSafeInitMemset(DepWrite))
+                  remarkSafeInit(DepWrite, false,
+                                 "removed SafeInit memset overwritten by " +
+                                     describeForRemark(Inst));
 
                 // dup of code from above
                 DeleteDeadInstruction(DepWrite, *MD, *TLI);
@@ -739,11 +1025,17 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
               }
             }
 
-            if (ObjectSize < 64) SizeIsGood = false; // there's no point shortening tiny stores
-            Value *sizeV;
+            // a memset of symbolic size (e.g. of a VLA) that SCEV shows covers
+            // the later write can be shortened without knowing the object size
+            bool Symbolic = DepIntrinsic &&
+                            DepLoc.Size == MemoryLocation::UnknownSize &&
+                            isKnownNotSmaller(DepIntrinsic->getLength(),
+                                              NewLength);
+
+            if (!Symbolic && ObjectSize < 64) SizeIsGood = false; // there's no point shortening tiny stores
+            Value *sizeV = NewLength;
             Instruction *sizeInst;
-            if (NewIntrinsic && SizeIsGood) {
-              sizeV = NewIntrinsic->getLength();
+            if (SizeIsGood && !Symbolic) {
  
               // apply super conservative security requirements (aka ruin everything)
 
@@ -764,9 +1056,10 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
             }
 
             if (SizeIsGood &&
-             (P1 == P2) && // pointers must be the same (not just the underlying ones)
-             DepIntrinsic && NewIntrinsic && // we must be (potentially) overwriting a memset
-             (ObjectSize != MemoryLocation::UnknownSize) && (ObjectSize == DepLoc.Size)) { // the overwritten memset must cover the entire object (so we don't have to check the offset, TODO: do so anyway)
+             isSameAddress(P1, P2) && // pointers must be the same (not just the underlying ones)
+             DepIntrinsic && // we must be (potentially) overwriting a memset
+             (Symbolic || // or SCEV shows the memset is at least as long
+              ((ObjectSize != MemoryLocation::UnknownSize) && (ObjectSize == DepLoc.Size)))) { // the overwritten memset must cover the entire object (so we don't have to check the offset, TODO: do so anyway)
               // If the size of the later write ('x') dominates both instructions,
               // then we can shorten the original write (changing the pointer to ptr+x and the size to size-x).
               // This is ONLY 'safe' if control is guaranteed to reach the second instruction
@@ -816,6 +1109,10 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
                   // we know the earlier write is full-length which helps
                   Value *newLength = Builder.CreateSub(Builder.CreateZExtOrTrunc(DepIntrinsic->getLength(), Builder.getInt64Ty()), zextSizeV);
                   DepIntrinsic->setLength(newLength);
+                  if (isSafeInitMemset(DepIntrinsic))
+                    remarkSafeInit(DepIntrinsic, false,
+                                   "shortened SafeInit memset, the start is "
+                                   "overwritten by " + describeForRemark(Inst));
 
                   MadeChange = true;
                 }
@@ -836,8 +1133,10 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
           break;
 
         // Can't look past this instruction if it might read 'Loc'.
-        if (AA->getModRefInfo(DepWrite, Loc) & MRI_Ref)
+        if (AA->getModRefInfo(DepWrite, Loc) & MRI_Ref) {
+          remarkBlockedSafeInit(Inst, Loc, DepWrite, &BB);
           break;
+        }
 
         InstDep = MD->getPointerDependencyFrom(Loc, false,
                                                DepWrite->getIterator(), &BB);
@@ -845,6 +1144,13 @@ bool DSE::runOnBasicBlock(BasicBlock &BB) {
     } else if (EnableNonLocalDSE && InstDep.isNonLocal()) { // DSE across BB
       if (++NumNonLocalAttempts < MaxNonLocalAttempts)
         MadeChange |= handleNonLocalDependency(Inst);
+      else if (NumNonLocalAttempts == MaxNonLocalAttempts && HasSafeInit)
+        emitOptimizationRemarkMissed(
+            BB.getContext(), DEBUG_TYPE, *BB.getParent(), Inst->getDebugLoc(),
+            "gave up on non-local DSE for the rest of this block at " +
+                describeForRemark(Inst) + " after " +
+                Twine(MaxNonLocalAttempts) + " attempts; SafeInit memsets "
+                "it overwrites in other blocks are kept");
     }
   }
 
@@ -917,7 +1223,9 @@ static bool underlyingObjectsDoNotAlias(Instruction *Inst, LoadInst *LI,
 bool DSE::handleNonLocalDependency(Instruction *Inst) {
   auto *SI = dyn_cast<StoreInst>(Inst);
   auto *MSI = dyn_cast<MemSetInst>(Inst);
-  if (!SI && !MSI)
+  if (!SI && !MSI && !isa<InitializedInst>(Inst))
+    return false;
+  if (NonLocalOverBudget)
     return false;
   // Get the location being stored to.
   // If we don't get a useful location, bail out.
@@ -925,6 +1233,12 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
   if (!Loc.Ptr)
     return false;
 
+  // (in functions with SafeInit memsets, this is part of what they cost)
+  ++NumNonLocalQueries;
+  Optional<SafeInitTimeRegion> TR;
+  if (HasSafeInit)
+    TR.emplace("DSE non-local dependencies", *Inst->getFunction());
+
   bool MadeChange = false;
   BasicBlock *BB = Inst->getParent();
   const DataLayout &DL = BB->getModule()->getDataLayout();
@@ -937,6 +1251,20 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
   findSafePreds(Blocks, SafeBlocks, BB, DT);
 
   while (!Blocks.empty()) {
+    if (!NonLocalBlocksLeft) {
+      NonLocalOverBudget = true;
+      if (HasSafeInit)
+        emitOptimizationRemarkMissed(
+            BB->getContext(), DEBUG_TYPE, *BB->getParent(), Inst->getDebugLoc(),
+            "gave up on non-local DSE at " + describeForRemark(Inst) +
+                " after scanning " + Twine(unsigned(NonLocalBlockBudget)) +
+                " blocks; SafeInit memsets overwritten in other blocks from "
+                "here on are kept");
+      break;
+    }
+    --NonLocalBlocksLeft;
+    ++NumNonLocalBlocks;
+
     BasicBlock *PB = Blocks.pop_back_val();
     MemDepResult Dep =
         MD->getPointerDependencyFrom(Loc, false, PB->end(), PB, Inst);
@@ -959,8 +1287,10 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
       MemoryLocation DepLoc = getLocForWrite(Dependency, *AA);
       if (!DepLoc.Ptr || !hasMemoryWrite(Dependency, *TLI) ||
           !isRemovable(Dependency) ||
-          (AA->getModRefInfo(Dependency, Loc) & MRI_Ref))
+          (AA->getModRefInfo(Dependency, Loc) & MRI_Ref)) {
+        remarkBlockedSafeInit(Inst, Loc, Dependency, PB);
         break;
+      }
 
       // Don't remove a store within single-block loops;
       // we need more analysis: e.g. looking for an interferring load
@@ -973,8 +1303,13 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
           break;
         }
       }
-      if (SingleBlockLoop)
+      if (SingleBlockLoop) {
+        if (isSafeInitMemset(Dependency))
+          remarkSafeInit(Dependency, true,
+                         "kept SafeInit memset in a single-block loop, "
+                         "overwritten by " + describeForRemark(Inst));
         break;
+      }
 
       int64_t InstWriteOffset, DepWriteOffset;
       OverwriteResult OR =
@@ -983,9 +1318,10 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
         DEBUG(dbgs() << "DSE: Remove Non-Local Dead Store:\n  DEAD: "
                      << *Dependency << "\n  KILLER: " << *Inst << '\n');
 
-//      if (!EnableSmallNonLocalDSE && DepLoc.Size <= 64)
-      if (!EnableSmallNonLocalDSE && DepLoc.Size <= 8)
-        break; // XXX alyssa did this to avoid crazy perf regressions (in perlbench)
+        if (isSafeInitMemset(Dependency))
+          remarkSafeInit(Dependency, false,
+                         "removed SafeInit memset overwritten by " +
+                             describeForRemark(Inst) + " in another block");
 
         // Delete redundant store and now-dead instructions that feed it.
         auto Next = std::next(Dependency->getIterator());
@@ -1000,10 +1336,6 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
                      ((OR == OverwriteBegin &&
                        isShortenableAtTheBeginning(Dependency)))) {
 
-//      if (!EnableSmallNonLocalDSE && DepLoc.Size <= 64)
-      if (!EnableSmallNonLocalDSE && DepLoc.Size <= 8)
-        break; // XXX alyssa did this to avoid crazy perf regressions (in perlbench)
-
             // TODO: base this on the target vector size so that if the earlier
             // store was too small to get vector writes anyway then its likely
             // a good idea to shorten it
@@ -1035,6 +1367,11 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
               Value *TrimmedLength =
                   ConstantInt::get(DepWriteLength->getType(), NewLength);
               DepIntrinsic->setLength(TrimmedLength);
+              if (isSafeInitMemset(DepIntrinsic))
+                remarkSafeInit(DepIntrinsic, false,
+                               "shortened SafeInit memset to " +
+                                   Twine(NewLength) + " bytes, the rest is "
+                                   "overwritten by " + describeForRemark(Inst));
 
               if (!IsOverwriteEnd) {
                 int64_t OffsetMoved = (InstWriteOffset - DepWriteOffset);
@@ -1049,8 +1386,13 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
               auto Next = std::next(Dependency->getIterator());
               Dep = MD->getPointerDependencyFrom(Loc, false, Next, PB, Inst);
               continue;
+            } else if (isSafeInitMemset(Dependency)) {
+              remarkSafeInit(Dependency, true,
+                             "kept SafeInit memset: the part overwritten by " +
+                                 describeForRemark(Inst) + " is not aligned "
+                                 "for shortening it");
             }
-          } else if (MemIntrinsic *NewIntrinsic = dyn_cast<MemIntrinsic>(Inst)) {
+          } else if (Value *NewLength = getWriteLength(Inst)) {
             // We want to shorten a memset, where there's a second non-constant store.
             // TODO: if both of the stores are doing the same thing, why don't we just kill the second store instead...
             //errs() << "normal DSE failed for: " << *DepWrite << " " << *Inst << "\n";
@@ -1063,12 +1405,17 @@ bool DSE::handleNonLocalDependency(Instruction *Inst) {
             // can we clobber the original entirely?
             if (DepIntrinsic) {
               Value *OldV = DepIntrinsic->getLength();
-              Value *NewV = NewIntrinsic->getLength();
-              if ((P1 == P2) && (OldV == NewV)) {
+              Value *NewV = NewLength;
+              if (isSameAddress(P1, P2) &&
+                  (OldV == NewV || isKnownNotSmaller(NewV, OldV))) {
                 // this is a complete overwrite! the old memset can be removed
 
                 DEBUG(dbgs() << "DSE: Remove Non-Local Dead Dyn-Size Store:\n  DEAD: " << *Dependency
                          << "\n  KILLER: " << *Inst << '\n');
+                if (isSafeInitMemset(Dependency))
+                  remarkSafeInit(Dependency, false,
+                                 "removed SafeInit memset overwritten by " +
+                                     describeForRemark(Inst));
 
                 // dup of code from above
                 auto Next = std::next(Dependency->getIterator());
@@ -1221,6 +1568,157 @@ bool DSE::HandleFree(CallInst *F) {
   return MadeChange;
 }
 
+/// findWriteOnlyStores - If the object Obj (an alloca or a heap allocation)
+/// is only ever written, directly or by nocapture writeonly callees, add the
+/// (non-volatile, non-atomic) stores into it to DeadStores, and return true.
+/// Heap allocations may also be freed; comparing the pointer doesn't count
+/// either.
+bool DSE::findWriteOnlyStores(Instruction *Obj,
+                              std::set<Instruction *> &DeadStores) {
+  const DataLayout &DL = Obj->getModule()->getDataLayout();
+  DEBUG(dbgs() << "end block DSE now pondering " << *Obj << "\n");
+  SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
+  SmallPtrSet<Instruction *, 16> FoundStores;
+  Worklist.insert(Obj);
+  // Try to find anything which uses this other than just by writing to it..
+  for (unsigned int n = 0; n < Worklist.size(); ++n) {
+    Instruction *WI = Worklist[n];
+    for (Value::use_iterator U = WI->use_begin(), E = WI->use_end(); U != E; ++U) {
+      Instruction *UI = dyn_cast<Instruction>(U->getUser());
+      // Follow casts/GEPs, but they're not real uses.
+      if (dyn_cast<CastInst>(UI) || dyn_cast<GetElementPtrInst>(UI)) {
+        Worklist.insert(UI);
+        continue;
+      }
+      if (isa<ICmpInst>(UI) || isFreeCall(UI, TLI))
+        continue;
+      if (isa<MemIntrinsic>(UI) || isa<InitializedInst>(UI)) {
+        if (U->getOperandNo() == 0 &&
+            !(isa<MemIntrinsic>(UI) && cast<MemIntrinsic>(UI)->isVolatile())) {
+          FoundStores.insert(UI);
+          continue;
+        }
+      } else if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI)) {
+        switch (II->getIntrinsicID()) {
+          case Intrinsic::lifetime_start:
+          case Intrinsic::lifetime_end:
+            // Lifetimes aren't real uses.
+            // TODO: Although we could minimise them..?
+            continue;
+          case Intrinsic::dbg_value:
+          case Intrinsic::dbg_declare:
+            continue;
+          default:
+            break;
+        }
+      }
+      if (StoreInst *SI = dyn_cast<StoreInst>(UI)) {
+        if (U->getOperandNo() == 1 && SI->isSimple()) {
+          // this is the pointer target
+          FoundStores.insert(UI);
+          continue;
+        }
+      }
+      if (auto CS = CallSite(UI)) {
+        if (CS.getCalledFunction()) { // see e.g. espresso's lack of prototypes
+          // FIXME: is this ok?
+          ModRefInfo A = AA->getModRefInfo(CS, Obj, getPointerSize(Obj, DL, *TLI));
+          auto ArgNo = U->getOperandNo();
+          // A heap pointer the call captures (say, stores to a global) may be
+          // read later, unlike an alloca's, whatever the call itself does.
+          if (!(A & MRI_Ref) &&
+              (isa<AllocaInst>(Obj) ||
+               (CS.isArgOperand(&*U) && CS.doesNotCapture(ArgNo))))
+            continue;
+          // FIXME: need to think on this. being kind of paranoid for now.
+          DEBUG(dbgs() << "pondering arg#" << ArgNo << "( " << CS.getCalledFunction()->getName() << ")\n");
+          if (CS.isArgOperand(&*U) && CS.doesNotCapture(ArgNo) &&
+              !CS.isByValArgument(ArgNo) &&
+              CS.dataOperandHasImpliedAttr(ArgNo + 1, Attribute::WriteOnly)) {
+            continue;
+          }
+        }
+      }
+      DEBUG(dbgs() << "nope; operand " << U->getOperandNo() << " of inst " << *UI << " to blame\n");
+      return false;
+    }
+  }
+  // .. if we don't find anything, kill all the removable stores.
+  DEBUG(dbgs() << "end block DSE killing written-only " << *Obj << "\n");
+  for (auto Dead : FoundStores)
+    DeadStores.insert(Dead);
+  return true;
+}
+
+/// useNoInitAllocation - If malloc returns zeroed (or pattern-filled)
+/// memory, the allocator fills every allocation; for a write-only one, call
+/// its no-init entry point (which takes the same arguments) instead. As in
+/// SafeInit, operator new is only switched for new-expressions.
+bool DSE::useNoInitAllocation(CallInst *CI) {
+  Function *Callee = CI->getCalledFunction();
+  LibFunc::Func Func;
+  if (!Callee || !TLI->getLibFunc(*Callee, Func) || !TLI->has(Func))
+    return false;
+
+  bool IsNewExpr = CI->getMetadata("safeinit.new") ||
+                   CI->hasFnAttr(Attribute::Builtin);
+  const char *NoInitName;
+  switch (Func) {
+  case LibFunc::malloc:
+    NoInitName = "tc_malloc_noinit";
+    break;
+  case LibFunc::Znwj:
+  case LibFunc::Znwm:
+    if (!IsNewExpr)
+      return false;
+    NoInitName = "tc_new_noinit";
+    break;
+  case LibFunc::Znaj:
+  case LibFunc::Znam:
+    if (!IsNewExpr)
+      return false;
+    NoInitName = "tc_newarray_noinit";
+    break;
+  default:
+    return false;
+  }
+
+  DEBUG(dbgs() << "DSE: using no-init allocation for write-only " << *CI
+               << "\n");
+  Module *M = CI->getModule();
+  Constant *NoInit = M->getOrInsertFunction(
+      NoInitName, Callee->getFunctionType(), Callee->getAttributes());
+  // (keep alias analysis aware that this is still a fresh allocation)
+  if (Function *NoInitF = dyn_cast<Function>(NoInit))
+    NoInitF->setDoesNotAlias(0);
+  CI->setCalledFunction(NoInit);
+  ++NumNoInitAllocs;
+  return true;
+}
+
+/// eliminateWriteOnlyObjects - If a buffer only exists to be passed to
+/// writeonly functions, and nothing reads from it, kill all the stores into
+/// it. The same goes for heap allocations which are only written and freed
+/// (and those also switch to a no-init allocation, see useNoInitAllocation).
+/// This looks at the whole function, so it's done once, not per end block.
+bool DSE::eliminateWriteOnlyObjects(Function &F) {
+  bool MadeChange = false;
+  std::set<Instruction *> VeryDeadStores;
+  for (Instruction &I : F.getEntryBlock())
+    if (AllocaInst *AI = dyn_cast<AllocaInst>(&I))
+      findWriteOnlyStores(AI, VeryDeadStores);
+  for (Instruction &I : instructions(F))
+    if (isAllocLikeFn(&I, TLI) && findWriteOnlyStores(&I, VeryDeadStores) &&
+        MallocFillByte >= 0)
+      MadeChange |= useNoInitAllocation(cast<CallInst>(&I));
+  for (auto Dead : VeryDeadStores) {
+    DeleteDeadInstruction(Dead, *MD, *TLI);
+    ++NumFastStores;
+    MadeChange = true;
+  }
+  return MadeChange;
+}
+
 /// handleEndBlock - Remove dead stores to stack-allocated locations in the
 /// function end block.  Ex:
 /// %A = alloca i32
@@ -1239,87 +1737,6 @@ bool DSE::handleEndBlock(BasicBlock &BB) {
 
   const DataLayout &DL = BB.getModule()->getDataLayout();
 
-  // Alyssa added this whole bit here.
-  // idea: if a buffer only exists to be passed to a writeonly function
-  // but we don't read from it, we can kill all the local stores
-  // TODO: why don't we also check other (m)allocs?
-  std::set<Instruction *> VeryDeadStores;
-  for (Instruction &I : Entry) {
-    if (AllocaInst *AI = dyn_cast<AllocaInst>(&I)) {
-      bool FoundNonWrite = false;
-      DEBUG(dbgs() << "end block DSE now pondering " << *AI << "\n");
-      SetVector<Instruction *, SmallVector<Instruction *, 16> > Worklist;
-      SmallPtrSet<Instruction *, 16> FoundStores;
-      Worklist.insert(AI);
-      // Try to find anything which uses this other than just by writing to it..
-      for (unsigned int n = 0; n < Worklist.size(); ++n) {
-        Instruction *WI = Worklist[n];
-        for (Value::use_iterator U = WI->use_begin(), E = WI->use_end(); U != E; ++U) {
-          Instruction *UI = dyn_cast<Instruction>(U->getUser());
-          // Follow casts/GEPs, but they're not real uses.
-          if (dyn_cast<CastInst>(UI) || dyn_cast<GetElementPtrInst>(UI)) {
-            Worklist.insert(UI);
-            continue;
-          }
-          if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(UI)) {
-            if (U->getOperandNo() == 0) {
-              FoundStores.insert(UI);
-              continue;
-            }
-          } else if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(UI)) {
-            switch (II->getIntrinsicID()) {
-              case Intrinsic::lifetime_start:
-              case Intrinsic::lifetime_end:
-                // Lifetimes aren't real uses.
-                // TODO: Although we could minimise them..?
-                continue;
-              case Intrinsic::dbg_value:
-              case Intrinsic::dbg_declare:
-                continue;
-              default:
-                break;
-            }
-          }
-          if (StoreInst *SI = dyn_cast<StoreInst>(UI)) {
-            if (U->getOperandNo() == 1) {
-              // this is the pointer target
-              FoundStores.insert(UI);
-              continue;
-            }
-          }
-          if (auto CS = CallSite(UI)) {
-            if (CS.getCalledFunction()) { // see e.g. espresso's lack of prototypes
-              // FIXME: is this ok?
-              ModRefInfo A = AA->getModRefInfo(CS, AI, getPointerSize(AI, DL, *TLI));
-              if (!(A & MRI_Ref))
-                continue;
-              // FIXME: need to think on this. being kind of paranoid for now.
-              auto ArgNo = U->getOperandNo();
-              DEBUG(dbgs() << "pondering arg#" << ArgNo << "( " << CS.getCalledFunction()->getName() << ")\n");
-              if (CS.doesNotCapture(ArgNo) &&
-                  !CS.isByValArgument(ArgNo) &&
-                  CS.dataOperandHasImpliedAttr(ArgNo + 1, Attribute::WriteOnly)) {
-                continue;
-              }
-            }
-          }
-          DEBUG(dbgs() << "nope; operand " << U->getOperandNo() << " of inst " << *UI << " to blame\n");
-          FoundNonWrite = true;
-          break;
-        }
-        if (FoundNonWrite) break;
-      }
-      // .. if we don't find anything, kill all the removable stores.
-      if (!FoundNonWrite) {
-        DEBUG(dbgs() << "end block DSE killing written-only " << *AI << "\n");
-        for (auto Dead : FoundStores)
-          VeryDeadStores.insert(Dead);
-      }
-    }
-  }
-  for (auto Dead : VeryDeadStores)
-    DeleteDeadInstruction(Dead, *MD, *TLI);
-
   for (Instruction &I : Entry) {
     if (isa<AllocaInst>(&I))
       DeadStackObjects.insert(&I);
@@ -1485,3 +1902,243 @@ void DSE::RemoveAccessedObjects(const MemoryLocation &LoadedLoc,
     return !AA->isNoAlias(StackLoc, LoadedLoc);
   });
 }
+
+//===----------------------------------------------------------------------===//
+// MemorySSA-based removal and trimming of SafeInit memsets
+//===----------------------------------------------------------------------===//
+
+namespace {
+  /// Disjoint byte ranges [first, second) of a SafeInit memset, kept sorted.
+  struct ByteRanges {
+    SmallVector<std::pair<int64_t, int64_t>, 4> Ranges;
+
+    void add(int64_t Begin, int64_t End) {
+      if (Begin >= End)
+        return;
+      SmallVector<std::pair<int64_t, int64_t>, 4> Merged;
+      for (auto &R : Ranges) {
+        if (R.second < Begin || R.first > End) {
+          Merged.push_back(R);
+        } else {
+          Begin = std::min(Begin, R.first);
+          End = std::max(End, R.second);
+        }
+      }
+      Merged.push_back(std::make_pair(Begin, End));
+      std::sort(Merged.begin(), Merged.end());
+      Ranges = std::move(Merged);
+    }
+
+    bool covers(int64_t Begin, int64_t End) const {
+      for (auto &R : Ranges)
+        if (R.first <= Begin && End <= R.second)
+          return true;
+      return Begin >= End;
+    }
+
+    /// Extends [HullBegin, HullEnd) to the bytes of [Begin, End) not in here.
+    void addGapsToHull(int64_t Begin, int64_t End, int64_t &HullBegin,
+                       int64_t &HullEnd) const {
+      for (auto &R : Ranges) {
+        if (R.first > Begin)
+          break;
+        Begin = std::max(Begin, R.second);
+      }
+      for (auto I = Ranges.rbegin(), E = Ranges.rend(); I != E; ++I) {
+        if (I->second < End)
+          break;
+        End = std::min(End, I->first);
+      }
+      if (Begin < End) {
+        HullBegin = std::min(HullBegin, Begin);
+        HullEnd = std::max(HullEnd, End);
+      }
+    }
+
+    ByteRanges intersect(const ByteRanges &Other) const {
+      ByteRanges Result;
+      auto I = Ranges.begin(), IE = Ranges.end();
+      auto J = Other.Ranges.begin(), JE = Other.Ranges.end();
+      while (I != IE && J != JE) {
+        int64_t Begin = std::max(I->first, J->first);
+        int64_t End = std::min(I->second, J->second);
+        if (Begin < End)
+          Result.Ranges.push_back(std::make_pair(Begin, End));
+        if (I->second < J->second)
+          ++I;
+        else
+          ++J;
+      }
+      return Result;
+    }
+
+    bool operator==(const ByteRanges &Other) const {
+      return Ranges == Other.Ranges;
+    }
+  };
+}
+
+/// getRangeInSafeInit - Work out which bytes [Begin, End) of a SafeInit
+/// memset of Size bytes at Base + BaseOffset the location Loc accesses,
+/// clipped to the memset. Returns false if that isn't known.
+static bool getRangeInSafeInit(const MemoryLocation &Loc, const Value *Base,
+                               int64_t BaseOffset, int64_t Size,
+                               const DataLayout &DL, int64_t &Begin,
+                               int64_t &End) {
+  if (!Loc.Ptr || Loc.Size == MemoryLocation::UnknownSize)
+    return false;
+  int64_t Offset;
+  if (GetPointerBaseWithConstantOffset(Loc.Ptr, Offset, DL) != Base)
+    return false;
+  Begin = std::max<int64_t>(Offset - BaseOffset, 0);
+  End = std::min<int64_t>(Offset - BaseOffset + Loc.Size, Size);
+  return true;
+}
+
+/// getSafeInitLiveRange - Find the part [LiveBegin, LiveEnd) of the SafeInit
+/// memset MSI of a (part of an) alloca that may be read before it is
+/// overwritten or the alloca's lifetime ends; the bytes around it can be
+/// dropped. Returns false if that is all of it, or isn't known.
+///
+/// Every access which may read the memset is reached through the def-use
+/// chains of its MemoryDef (through MemoryPhis), so we follow those, keeping
+/// track of the bytes overwritten on the way. Where paths join we continue
+/// with the bytes overwritten on all of them, so each access is visited
+/// again only when that shrinks.
+bool DSE::getSafeInitLiveRange(MemSetInst *MSI, MemorySSA &MSSA,
+                               int64_t &LiveBegin, int64_t &LiveEnd) {
+  const DataLayout &DL = MSI->getModule()->getDataLayout();
+  MemoryLocation Loc = getLocForWrite(MSI, *AA);
+  if (!Loc.Ptr || Loc.Size == MemoryLocation::UnknownSize || MSI->isVolatile())
+    return false;
+  const Value *Object = GetUnderlyingObject(Loc.Ptr, DL);
+  if (!isa<AllocaInst>(Object))
+    return false;
+  int64_t Size = Loc.Size, BaseOffset;
+  const Value *Base = GetPointerBaseWithConstantOffset(Loc.Ptr, BaseOffset, DL);
+
+  MemoryAccess *MA = MSSA.getMemoryAccess(MSI);
+  if (!MA)
+    return false;
+
+  LiveBegin = Size;
+  LiveEnd = 0;
+  SmallVector<std::pair<MemoryAccess *, ByteRanges>, 16> Worklist;
+  DenseMap<MemoryAccess *, ByteRanges> Seen;
+  auto pushUsers = [&](MemoryAccess *Acc, const ByteRanges &Written) {
+    for (User *U : Acc->users()) {
+      MemoryAccess *UA = cast<MemoryAccess>(U);
+      auto Ins = Seen.insert(std::make_pair(UA, Written));
+      if (!Ins.second) {
+        ByteRanges Both = Ins.first->second.intersect(Written);
+        if (Both == Ins.first->second)
+          continue;
+        Ins.first->second = Both;
+      }
+      Worklist.push_back(std::make_pair(UA, Ins.first->second));
+    }
+  };
+  pushUsers(MA, ByteRanges());
+
+  unsigned Visits = 0;
+  while (!Worklist.empty()) {
+    if (++Visits > SafeInitWalkLimit)
+      return false;
+    MemoryAccess *Acc = Worklist.back().first;
+    ByteRanges Written = std::move(Worklist.back().second);
+    Worklist.pop_back();
+    if (isa<MemoryPhi>(Acc)) {
+      pushUsers(Acc, Written);
+      continue;
+    }
+
+    Instruction *I = cast<MemoryUseOrDef>(Acc)->getMemoryInst();
+    // The end (or a new start) of the alloca's lifetime kills the memset.
+    if (auto *II = dyn_cast<IntrinsicInst>(I))
+      if ((II->getIntrinsicID() == Intrinsic::lifetime_end ||
+           II->getIntrinsicID() == Intrinsic::lifetime_start) &&
+          GetUnderlyingObject(II->getArgOperand(1), DL) == Object)
+        continue;
+
+    if (AA->getModRefInfo(I, Loc) & MRI_Ref) {
+      MemoryLocation ReadLoc;
+      if (auto *LI = dyn_cast<LoadInst>(I))
+        ReadLoc = MemoryLocation::get(LI);
+      else if (auto *MTI = dyn_cast<MemTransferInst>(I))
+        ReadLoc = MemoryLocation::getForSource(MTI);
+      int64_t Begin, End;
+      if (!getRangeInSafeInit(ReadLoc, Base, BaseOffset, Size, DL, Begin, End)) {
+        Begin = 0;
+        End = Size;
+      }
+      Written.addGapsToHull(Begin, End, LiveBegin, LiveEnd);
+      if (LiveBegin == 0 && LiveEnd == Size)
+        return false;
+    }
+    if (isa<MemoryUse>(Acc))
+      continue;
+
+    int64_t Begin, End;
+    if (getRangeInSafeInit(getLocForWrite(I, *AA), Base, BaseOffset, Size, DL,
+                           Begin, End))
+      Written.add(Begin, End);
+    if (!Written.covers(0, Size))
+      pushUsers(Acc, Written);
+  }
+  return true;
+}
+
+/// eliminateDeadSafeInits - Remove the SafeInit stack memsets of F which are
+/// overwritten before being read on every path, and trim the ones which are
+/// in part. Doing so never makes another one live, so they are all looked at
+/// with the same MemorySSA before changing any.
+bool DSE::eliminateDeadSafeInits(Function &F) {
+  MemorySSA MSSA(F);
+  std::unique_ptr<MemorySSAWalker> Walker(MSSA.buildMemorySSA(AA, DT));
+
+  struct LiveRange {
+    MemSetInst *MSI;
+    int64_t Begin, End;
+  };
+  SmallVector<LiveRange, 16> Changes;
+  for (Instruction &I : instructions(F)) {
+    auto *MSI = dyn_cast<MemSetInst>(&I);
+    int64_t Begin, End;
+    if (MSI && MSI->getMetadata("stackzeroinit") &&
+        DT->isReachableFromEntry(MSI->getParent()) &&
+        getSafeInitLiveRange(MSI, MSSA, Begin, End))
+      Changes.push_back({MSI, Begin, End});
+  }
+
+  for (LiveRange &C : Changes) {
+    MemSetInst *MSI = C.MSI;
+    if (C.Begin >= C.End) {
+      DEBUG(dbgs() << "DSE: Remove SafeInit memset overwritten on all paths: "
+                   << *MSI << '\n');
+      remarkSafeInit(MSI, false,
+                     "removed SafeInit memset overwritten on every path");
+      MSSA.removeMemoryAccess(MSSA.getMemoryAccess(MSI));
+      DeleteDeadInstruction(MSI, *MD, *TLI);
+      ++NumSafeInitMSSA;
+      continue;
+    }
+
+    DEBUG(dbgs() << "DSE: Trim SafeInit memset to [" << C.Begin << ", "
+                 << C.End << "): " << *MSI << '\n');
+    remarkSafeInit(MSI, false,
+                   "shortened SafeInit memset to bytes " + Twine(C.Begin) +
+                       " to " + Twine(C.End) + ", the rest is overwritten on "
+                       "every path");
+    Type *LenTy = MSI->getLength()->getType();
+    MSI->setLength(ConstantInt::get(LenTy, C.End - C.Begin));
+    if (C.Begin) {
+      Value *Indices[1] = {ConstantInt::get(LenTy, C.Begin)};
+      MSI->setDest(GetElementPtrInst::CreateInBounds(MSI->getRawDest(),
+                                                     Indices, "", MSI));
+      MSI->setAlignment(ConstantInt::get(
+          MSI->getAlignmentType(), MinAlign(MSI->getAlignment(), C.Begin)));
+    }
+    ++NumSafeInitMSSATrimmed;
+  }
+  return !Changes.empty();
+}
@@ -37,6 +37,7 @@
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/IRBuilder.h"
@@ -69,8 +70,6 @@ static cl::opt<bool> EnablePRE("enable-pre",
                                cl::init(true), cl::Hidden);
 static cl::opt<bool> EnableLoadPRE("enable-load-pre", cl::init(true));
 
-cl::opt<bool> MallocReturnsZero("malloc-returns-zero", cl::init(false));
-
 // Maximum allowed recursion depth.
 static cl::opt<uint32_t>
 MaxRecurseDepth("max-recurse-depth", cl::Hidden, cl::init(1000), cl::ZeroOrMore,
@@ -929,12 +928,75 @@ static int AnalyzeLoadFromClobberingLoad(Type *LoadTy, Value *LoadPtr,
 
 
 
+/// Returns the constant of type Ty whose bytes are all Byte, or null if Ty
+/// isn't a type we can build one of that way.
+static Constant *getBytewiseConstant(Type *Ty, uint8_t Byte,
+                                     const DataLayout &DL) {
+  if (Byte == 0)
+    return Constant::getNullValue(Ty);
+  if (!Ty->isIntOrIntVectorTy() && !Ty->isFPOrFPVectorTy() &&
+      !Ty->isPointerTy())
+    return nullptr;
+  uint64_t Bits = DL.getTypeSizeInBits(Ty);
+  if (Bits % 8)
+    return nullptr;
+  Constant *C = ConstantInt::get(Ty->getContext(),
+                                 APInt::getSplat(Bits, APInt(8, Byte)));
+  if (Ty->isPointerTy())
+    return ConstantExpr::getIntToPtr(C, Ty);
+  return ConstantExpr::getBitCast(C, Ty);
+}
+
+/// Returns true if the memset MSI covers all of the alloca or heap allocation
+/// that LoadPtr points into, which is how SafeInit clears variable-length
+/// allocas and malloc(n). Any load from the allocation then reads what the
+/// memset stored, as loading outside of it would be undefined.
+static bool isMemSetOfWholeObject(MemSetInst *MSI, Value *LoadPtr,
+                                  const DataLayout &DL,
+                                  const TargetLibraryInfo *TLI) {
+  Value *Obj = MSI->getDest();
+  if (GetUnderlyingObject(LoadPtr, DL) != Obj)
+    return false;
+  Value *Len = MSI->getLength();
+
+  if (AllocaInst *AI = dyn_cast<AllocaInst>(Obj)) {
+    uint64_t EltSize = DL.getTypeAllocSize(AI->getAllocatedType());
+    auto IsArraySize = [&](Value *V) {
+      if (ZExtInst *ZI = dyn_cast<ZExtInst>(V))
+        V = ZI->getOperand(0);
+      return V == AI->getArraySize();
+    };
+    // alloca T, n is cleared with a memset of sizeof(T) * zext(n).
+    Value *A, *B;
+    if (match(Len, m_Mul(m_Value(A), m_Value(B)))) {
+      if (isa<ConstantInt>(A))
+        std::swap(A, B);
+      ConstantInt *C = dyn_cast<ConstantInt>(B);
+      return C && C->getZExtValue() == EltSize && IsArraySize(A);
+    }
+    return EltSize == 1 && IsArraySize(Len);
+  }
+
+  // malloc(n) and new-expressions are cleared with a memset of n.
+  if (isMallocLikeFn(Obj, TLI))
+    return CallSite(Obj).getArgument(0) == Len;
+  return false;
+}
+
 static int AnalyzeLoadFromClobberingMemInst(Type *LoadTy, Value *LoadPtr,
                                             MemIntrinsic *MI,
-                                            const DataLayout &DL) {
-  // If the mem operation is a non-constant size, we can't handle it.
+                                            const DataLayout &DL,
+                                            const TargetLibraryInfo *TLI) {
+  // If the mem operation is a non-constant size, we can't handle it, unless
+  // it is a memset of everything the load could read.
   ConstantInt *SizeCst = dyn_cast<ConstantInt>(MI->getLength());
-  if (!SizeCst) return -1;
+  if (!SizeCst) {
+    MemSetInst *MSI = dyn_cast<MemSetInst>(MI);
+    if (MSI && !LoadTy->isStructTy() && !LoadTy->isArrayTy() &&
+        isMemSetOfWholeObject(MSI, LoadPtr, DL, TLI))
+      return 0; // (a memset provides the same value at any offset)
+    return -1;
+  }
   uint64_t MemSizeInBits = SizeCst->getZExtValue()*8;
 
   // If this is memset, we just need to see if the offset is valid in the size
@@ -1216,6 +1278,13 @@ static bool isLifetimeStart(const Instruction *Inst) {
   return false;
 }
 
+/// Returns true if Inst is a zero-init memset added by SafeInit (or by clang
+/// for heap allocations).
+static bool isSafeInitMemset(const Instruction *Inst) {
+  return isa<MemSetInst>(Inst) && (Inst->getMetadata("stackzeroinit") ||
+                                   Inst->getMetadata("heapzeroinit"));
+}
+
 bool GVN::AnalyzeLoadAvailability(LoadInst *LI, MemDepResult DepInfo,
                                   Value *Address, AvailableValue &Res) {
 
@@ -1265,7 +1334,7 @@ bool GVN::AnalyzeLoadAvailability(LoadInst *LI, MemDepResult DepInfo,
     if (MemIntrinsic *DepMI = dyn_cast<MemIntrinsic>(DepInfo.getInst())) {
       if (Address && !LI->isAtomic()) {
         int Offset = AnalyzeLoadFromClobberingMemInst(LI->getType(), Address,
-                                                      DepMI, DL);
+                                                      DepMI, DL, TLI);
         if (Offset != -1) {
           Res = AvailableValue::getMI(DepMI, Offset);
           return true;
@@ -1291,19 +1360,47 @@ bool GVN::AnalyzeLoadAvailability(LoadInst *LI, MemDepResult DepInfo,
       // Loading immediately after lifetime begin -> undef.
       isLifetimeStart(DepInst)) {
     // XXX: <AM> we only use MallocReturnsZero in combination with zeroinit -> safe
-    if (MallocReturnsZero)
-      Res = AvailableValue::get(Constant::getNullValue(LI->getType()));
-    else
+    // (and in pattern-init mode, the stack is filled with the same pattern)
+    if (MallocFillByte >= 0) {
+      Constant *Fill = getBytewiseConstant(LI->getType(), MallocFillByte, DL);
+      if (!Fill)
+        return false;
+      Res = AvailableValue::get(Fill);
+    } else {
       Res = AvailableValue::get(UndefValue::get(LI->getType()));
+    }
     return true;
   }
 
-  // Loading from calloc (which zero initializes memory) -> zero
-  if (isCallocLikeFn(DepInst, TLI)) {
+  // Loading from calloc (which zero initializes memory), or from a wrapper
+  // known to return zeroed memory -> zero
+  if (isCallocLikeFn(DepInst, TLI) || returnsZeroedMemory(DepInst)) {
     Res = AvailableValue::get(Constant::getNullValue(LI->getType()));
     return true;
   }
 
+  // Loading what memalign returned, or the tail realloc added -> the fill,
+  // with a known allocator; undef from memalign otherwise.
+  if (isAllocationFn(DepInst, TLI)) {
+    int64_t Offset;
+    if (GetPointerBaseWithConstantOffset(LI->getPointerOperand(), Offset,
+                                         DL) != DepInst)
+      Offset = -1;
+    int Byte = getInitialAllocatedByte(DepInst, Offset, MallocFillByte, DL,
+                                       TLI);
+    if (Byte >= 0) {
+      Constant *Fill = getBytewiseConstant(LI->getType(), Byte, DL);
+      if (!Fill)
+        return false;
+      Res = AvailableValue::get(Fill);
+      return true;
+    }
+    if (isAlignedAllocLikeFn(DepInst, TLI)) {
+      Res = AvailableValue::get(UndefValue::get(LI->getType()));
+      return true;
+    }
+  }
+
   if (StoreInst *S = dyn_cast<StoreInst>(DepInst)) {
     // Reject loads and stores that are to the same address but are of
     // different types if we have to. If the stored value is larger or equal to
@@ -1801,8 +1898,15 @@ bool GVN::processLoad(LoadInst *L) {
     return false;
   }
 
+  // A load of SafeInit-zeroed memory keeps the memset alive unless it is
+  // folded (-Rpass=gvn / -Rpass-missed=gvn say which).
+  Function *F = L->getFunction();
   AvailableValue AV;
   if (AnalyzeLoadAvailability(L, Dep, L->getPointerOperand(), AV)) {
+    if (isSafeInitMemset(Dep.getInst()))
+      emitOptimizationRemark(F->getContext(), DEBUG_TYPE, *F,
+                             L->getDebugLoc(),
+                             "folded load from SafeInit memset");
     Value *AvailableValue = AV.MaterializeAdjustedValue(L, L, *this);
 
     // Replace the load!
@@ -1816,6 +1920,11 @@ bool GVN::processLoad(LoadInst *L) {
     return true;
   }
 
+  if (isSafeInitMemset(Dep.getInst()))
+    emitOptimizationRemarkMissed(F->getContext(), DEBUG_TYPE, *F,
+                                 L->getDebugLoc(),
+                                 "load keeps SafeInit memset alive: its value "
+                                 "could not be forwarded from the memset");
   return false;
 }
 
@@ -2182,6 +2291,7 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   DT = &RunDT;
   VN.setDomTree(DT);
   TLI = &RunTLI;
+  MallocFillByte = TLI->getMallocFillByte(*F.getParent());
   VN.setAliasAnalysis(&RunAA);
   MD = RunMD;
   VN.setMemDep(MD);
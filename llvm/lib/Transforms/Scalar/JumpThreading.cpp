@@ -317,9 +317,8 @@ static unsigned getJumpThreadDuplicationCost(const BasicBlock *BB,
 
     // Debugger intrinsics don't incur code size.
     if (isa<DbgInfoIntrinsic>(I)) continue;
-    if (const IntrinsicInst *II = dyn_cast<IntrinsicInst>(&*I))
-      if (II->getIntrinsicID() == Intrinsic::initialized)
-        continue;
+    // Nor do llvm.initialized markers, which are dropped at codegen.
+    if (isa<InitializedInst>(I)) continue;
 
     // If this is a pointer->pointer bitcast, it is free.
     if (isa<BitCastInst>(I) && I->getType()->isPointerTy())
@@ -72,11 +72,18 @@ STATISTIC(NumHoisted, "Number of instructions hoisted out of loop");
 STATISTIC(NumMovedLoads, "Number of load insts hoisted or sunk");
 STATISTIC(NumMovedCalls, "Number of call insts hoisted or sunk");
 STATISTIC(NumPromoted, "Number of memory locations promoted to registers");
+STATISTIC(NumPromotedFromMemset,
+          "Number of promoted locations known to start out zero");
 
 static cl::opt<bool>
     DisablePromotion("disable-licm-promotion", cl::Hidden,
                      cl::desc("Disable memory promotion in LICM pass"));
 
+static cl::opt<unsigned> PromotionMemsetScanLimit(
+    "licm-promotion-memset-scan-limit", cl::Hidden, cl::init(64),
+    cl::desc("How many instructions before the loop LICM looks through for "
+             "a zero memset giving a promoted location its initial value"));
+
 static bool inSubLoop(BasicBlock *BB, Loop *CurLoop, LoopInfo *LI);
 static bool isNotUsedInLoop(const Instruction &I, const Loop *CurLoop,
                             const LICMSafetyInfo *SafetyInfo);
@@ -850,6 +857,44 @@ public:
 };
 } // end anon namespace
 
+/// If the Size bytes at Ptr are known to be zero on entry to the loop, because
+/// the last thing to write them before the preheader is a zero memset (such as
+/// the ones SafeInit adds for locals), return the zero of type Ty to use as the
+/// promoted value's initial value instead of a load.  Only the straight-line
+/// code before the preheader is searched.
+static Constant *getZeroInitialValue(Value *Ptr, Type *Ty,
+                                     BasicBlock *Preheader, AliasAnalysis &AA,
+                                     const DataLayout &DL) {
+  const int64_t Size = DL.getTypeStoreSize(Ty);
+  int64_t Offset;
+  Value *Base = GetPointerBaseWithConstantOffset(Ptr, Offset, DL);
+  MemoryLocation Loc(Ptr, Size);
+
+  unsigned Budget = PromotionMemsetScanLimit;
+  for (BasicBlock *BB = Preheader; BB; BB = BB->getSinglePredecessor()) {
+    for (Instruction &I : reverse(*BB)) {
+      if (Budget-- == 0)
+        return nullptr;
+      if (!I.mayWriteToMemory())
+        continue;
+      if (auto *MSI = dyn_cast<MemSetInst>(&I)) {
+        auto *Val = dyn_cast<ConstantInt>(MSI->getValue());
+        auto *Len = dyn_cast<ConstantInt>(MSI->getLength());
+        int64_t DestOffset;
+        Value *DestBase =
+            GetPointerBaseWithConstantOffset(MSI->getDest(), DestOffset, DL);
+        if (!MSI->isVolatile() && Val && Val->isZero() && Len &&
+            DestBase == Base && DestOffset <= Offset &&
+            Offset + Size <= DestOffset + (int64_t)Len->getZExtValue())
+          return Constant::getNullValue(Ty);
+      }
+      if (AA.getModRefInfo(&I, Loc) & MRI_Mod)
+        return nullptr;
+    }
+  }
+  return nullptr;
+}
+
 /// Try to promote memory values to scalars by sinking stores out of the
 /// loop and moving loads to before the loop.  We do this by looping over
 /// the stores in the loop, looking for stores to Must pointers which are
@@ -1052,21 +1097,31 @@ bool llvm::promoteLoopAccessesToScalars(
                         InsertPts, PIC, *CurAST, *LI, DL, Alignment, AATags);
 
   // Set up the preheader to have a definition of the value.  It is the live-out
-  // value from the preheader that uses in the loop will use.
-  LoadInst *PreheaderLoad = new LoadInst(
-      SomePtr, SomePtr->getName() + ".promoted", Preheader->getTerminator());
-  PreheaderLoad->setAlignment(Alignment);
-  PreheaderLoad->setDebugLoc(DL);
-  if (AATags)
-    PreheaderLoad->setAAMetadata(AATags);
-  SSA.AddAvailableValue(Preheader, PreheaderLoad);
+  // value from the preheader that uses in the loop will use: zero, if the
+  // location was just cleared, or else whatever we load from it.
+  Value *InitialValue = getZeroInitialValue(
+      SomePtr, SomePtr->getType()->getPointerElementType(), Preheader,
+      CurAST->getAliasAnalysis(), MDL);
+  LoadInst *PreheaderLoad = nullptr;
+  if (InitialValue) {
+    ++NumPromotedFromMemset;
+  } else {
+    PreheaderLoad = new LoadInst(SomePtr, SomePtr->getName() + ".promoted",
+                                 Preheader->getTerminator());
+    PreheaderLoad->setAlignment(Alignment);
+    PreheaderLoad->setDebugLoc(DL);
+    if (AATags)
+      PreheaderLoad->setAAMetadata(AATags);
+    InitialValue = PreheaderLoad;
+  }
+  SSA.AddAvailableValue(Preheader, InitialValue);
 
   // Rewrite all the loads in the loop and remember all the definitions from
   // stores in the loop.
   Promoter.run(LoopUses);
 
   // If the SSAUpdater didn't use the load in the preheader, just zap it now.
-  if (PreheaderLoad->use_empty())
+  if (PreheaderLoad && PreheaderLoad->use_empty())
     PreheaderLoad->eraseFromParent();
 
   return Changed;
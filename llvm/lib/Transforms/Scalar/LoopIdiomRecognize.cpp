@@ -62,6 +62,8 @@ using namespace llvm;
 
 STATISTIC(NumMemSet, "Number of memset's formed from loop stores");
 STATISTIC(NumMemCpy, "Number of memcpy's formed from loop load+stores");
+STATISTIC(NumSafeInitShrunk,
+          "Number of SafeInit memsets shrunk or removed as a loop overwrites them");
 
 namespace {
 
@@ -124,6 +126,8 @@ private:
                                const SCEVAddRecExpr *Ev, const SCEV *BECount,
                                bool NegStride, bool ForInitialized);
   bool processLoopStoreOfLoopLoad(StoreInst *SI, const SCEV *BECount);
+  bool shrinkSafeInitMemSet(Instruction *NewCall, const SCEV *Start,
+                            const SCEV *NumBytesS, bool ForInitialized);
 
   /// @}
   /// \name Noncountable Loop Idiom Handling
@@ -799,7 +803,7 @@ bool LoopIdiomRecognize::processLoopStridedStore(
       Ptr = BCI;
     }
 
-    Value *Ops[] = { Ptr, UndefValue::get(Builder.getInt8Ty()), NumBytes, Builder.getInt32(StoreAlignment), Builder.getInt1(false) };
+    Value *Ops[] = { Ptr, NumBytes };
     Type *Tys[] = { Ptr->getType(), NumBytes->getType() };
     Module *M = Preheader->getParent()->getParent();
     Value *TheFn = Intrinsic::getDeclaration(M, Intrinsic::initialized, Tys);
@@ -809,6 +813,7 @@ bool LoopIdiomRecognize::processLoopStridedStore(
     Builder.SetInstDebugLocation(NewCall);
     NewCall->setDebugLoc(TheStore->getDebugLoc());
 //    dbgs() << "*** INSERTED INITIALIZATION " << *NewCall << " from store to " << *Ev << " at " << *TheStore << "\n";
+    shrinkSafeInitMemSet(NewCall, Start, NumBytesS, true);
     return true;
   } else if (SplatValue) {
     NewCall =
@@ -838,6 +843,7 @@ bool LoopIdiomRecognize::processLoopStridedStore(
   DEBUG(dbgs() << "  Formed memset: " << *NewCall << "\n"
                << "    from store to: " << *Ev << " at: " << *TheStore << "\n");
   NewCall->setDebugLoc(TheStore->getDebugLoc());
+  shrinkSafeInitMemSet(NewCall, Start, NumBytesS, false);
 
   // Okay, the memset has been formed.  Zap the original store and anything that
   // feeds into it.
@@ -944,6 +950,7 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
       Builder.CreateMemCpy(StoreBasePtr, LoadBasePtr, NumBytes,
                            std::min(SI->getAlignment(), LI->getAlignment()));
   NewCall->setDebugLoc(SI->getDebugLoc());
+  shrinkSafeInitMemSet(NewCall, StrStart, NumBytesS, false);
 
   DEBUG(dbgs() << "  Formed memcpy: " << *NewCall << "\n"
                << "    from load ptr=" << *LoadEv << " at: " << *LI << "\n"
@@ -956,6 +963,90 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
   return true;
 }
 
+/// shrinkSafeInitMemSet - The loop has been found to store every byte of the
+/// NumBytesS bytes at Start, and NewCall (a memset, memcpy or llvm.initialized
+/// marker in the preheader) formed for it.  If SafeInit cleared the object
+/// right before the loop, drop the bytes the loop overwrites anyway from that
+/// memset, so that memory is only written once.  Markers leave the loop in
+/// place, so the loop must then run to completion once entered.
+bool LoopIdiomRecognize::shrinkSafeInitMemSet(Instruction *NewCall,
+                                              const SCEV *Start,
+                                              const SCEV *NumBytesS,
+                                              bool ForInitialized) {
+  const SCEVConstant *NumBytesC = dyn_cast<SCEVConstant>(NumBytesS);
+  if (!NumBytesC)
+    return false;
+  if (ForInitialized)
+    for (BasicBlock *BB : CurLoop->blocks())
+      for (Instruction &I : *BB)
+        if (I.mayThrow())
+          return false;
+
+  // Look for the memset in straight-line code leading to the preheader, so
+  // that every path through it reaches the loop.
+  SmallVector<Instruction *, 16> Between;
+  MemSetInst *MSI = nullptr;
+  BasicBlock *BB = NewCall->getParent();
+  BasicBlock::iterator It = NewCall->getIterator();
+  for (unsigned NumBlocks = 0; !MSI; ++NumBlocks) {
+    while (It != BB->begin()) {
+      Instruction *I = &*--It;
+      MemSetInst *Candidate = dyn_cast<MemSetInst>(I);
+      if (Candidate && Candidate->getMetadata("stackzeroinit") &&
+          !Candidate->isVolatile() &&
+          isa<ConstantInt>(Candidate->getLength()) &&
+          isa<SCEVConstant>(
+              SE->getMinusSCEV(Start, SE->getSCEV(Candidate->getDest())))) {
+        MSI = Candidate;
+        break;
+      }
+      if (I->mayReadOrWriteMemory() || I->mayThrow())
+        Between.push_back(I);
+    }
+    if (MSI)
+      break;
+    BasicBlock *Pred = BB->getSinglePredecessor();
+    if (NumBlocks == 4 || !Pred || Pred->getTerminator()->getNumSuccessors() != 1)
+      return false;
+    BB = Pred;
+    It = BB->end();
+  }
+
+  // Nothing in between may read the bytes we are about to leave to the loop.
+  MemoryLocation Loc = MemoryLocation::getForDest(MSI);
+  for (Instruction *I : Between)
+    if (I->mayThrow() || (AA->getModRefInfo(I, Loc) & MRI_Ref))
+      return false;
+
+  // The loop overwrites [Off, End) of the memset's [0, Len).
+  int64_t Off = cast<SCEVConstant>(
+      SE->getMinusSCEV(Start, SE->getSCEV(MSI->getDest())))->getAPInt()
+      .getSExtValue();
+  int64_t Len = cast<ConstantInt>(MSI->getLength())->getSExtValue();
+  int64_t End = Off + (int64_t)NumBytesC->getAPInt().getZExtValue();
+  if (Len <= 0 || Off >= Len || End <= 0)
+    return false;
+
+  DEBUG(dbgs() << "  Shrinking SafeInit memset: " << *MSI << "\n"
+               << "    overwritten in [" << Off << ", " << End << ")\n");
+  Type *LenTy = MSI->getLength()->getType();
+  if (End < Len) {
+    IRBuilder<> Builder(MSI);
+    Value *Dest = Builder.CreateConstInBoundsGEP1_64(MSI->getRawDest(), End);
+    CallInst *Rest = Builder.CreateMemSet(
+        Dest, MSI->getValue(), ConstantInt::get(LenTy, Len - End),
+        MinAlign(std::max(MSI->getAlignment(), 1u), End));
+    Rest->setMetadata("stackzeroinit", MSI->getMetadata("stackzeroinit"));
+    Rest->setDebugLoc(MSI->getDebugLoc());
+  }
+  if (Off > 0)
+    MSI->setLength(ConstantInt::get(LenTy, Off));
+  else
+    MSI->eraseFromParent();
+  ++NumSafeInitShrunk;
+  return true;
+}
+
 bool LoopIdiomRecognize::runOnNoncountableLoop() {
   return recognizePopcount();
 }
@@ -19,6 +19,7 @@
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/MemoryDependenceAnalysis.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -41,6 +42,7 @@ STATISTIC(NumMemCpyInstr, "Number of memcpy instructions deleted");
 STATISTIC(NumMemSetInfer, "Number of memsets inferred");
 STATISTIC(NumMoveToCpy,   "Number of memmoves converted to memcpy");
 STATISTIC(NumCpyToSet,    "Number of memcpys converted to memset");
+STATISTIC(NumCpyOfSame,   "Number of memcpys deleted as copying what's already there");
 
 static int64_t GetOffsetFromIndex(const GEPOperator *GEP, unsigned Idx,
                                   bool &VariableIdxFound,
@@ -341,7 +343,7 @@ namespace {
                               uint64_t cpyLen, unsigned cpyAlign, CallInst *C);
     bool processMemCpyMemCpyDependence(MemCpyInst *M, MemCpyInst *MDep);
     bool processMemSetMemCpyDependence(MemCpyInst *M, MemSetInst *MDep);
-    bool performMemCpyToMemSetOptzn(MemCpyInst *M, MemSetInst *MDep);
+    Value *getKnownByteValue(Value *Ptr, ConstantInt *Size, MemDepResult Dep);
     bool processByValArgument(CallSite CS, unsigned ArgNo);
     Instruction *tryMergingIntoMemset(Instruction *I, Value *StartPtr,
                                       Value *ByteVal);
@@ -471,6 +473,14 @@ Instruction *MemCpyOpt::tryMergingIntoMemset(Instruction *StartInst,
     if (!Range.TheStores.empty())
       AMemSet->setDebugLoc(Range.TheStores[0]->getDebugLoc());
 
+    // The memset is a zero-init only if everything merged into it was one.
+    bool AllZeroInit = true;
+    for (Instruction *SI : Range.TheStores)
+      if (!SI->getMetadata("stackzeroinit") && !SI->getMetadata("heapzeroinit"))
+        AllZeroInit = false;
+    if (AllZeroInit)
+      copyZeroInitMetadata(Range.TheStores[0], AMemSet);
+
     // Zap all the stores.
     for (Instruction *SI : Range.TheStores) {
       MD->removeInstruction(SI);
@@ -730,6 +740,7 @@ bool MemCpyOpt::processStore(StoreInst *SI, BasicBlock::iterator &BBI) {
       IRBuilder<> Builder(SI);
       auto *M = Builder.CreateMemSet(SI->getPointerOperand(), ByteVal,
                                      Size, Align, SI->isVolatile());
+      copyZeroInitMetadata(SI, M);
 
       DEBUG(dbgs() << "Promoting " << *SI << " to " << *M << "\n");
 
@@ -1078,45 +1089,54 @@ bool MemCpyOpt::processMemSetMemCpyDependence(MemCpyInst *MemCpy,
       Builder.CreateSelect(Builder.CreateICmpULE(DestSize, SrcSize),
                            ConstantInt::getNullValue(DestSize->getType()),
                            Builder.CreateSub(DestSize, SrcSize));
-  Builder.CreateMemSet(Builder.CreateGEP(Dest, SrcSize), MemSet->getOperand(1),
-                       MemsetLen, Align);
+  Instruction *NewMemSet =
+      Builder.CreateMemSet(Builder.CreateGEP(Dest, SrcSize),
+                           MemSet->getOperand(1), MemsetLen, Align);
+  copyZeroInitMetadata(MemSet, NewMemSet);
 
   MD->removeInstruction(MemSet);
   MemSet->eraseFromParent();
   return true;
 }
 
-/// Transform memcpy to memset when its source was just memset.
-/// In other words, turn:
+/// Find the byte value every one of the Size bytes at Ptr is known to hold,
+/// given the dependency Dep of a read of them: either they were just memset,
+/// as in
 /// \code
 ///   memset(dst1, c, dst1_size);
 ///   memcpy(dst2, dst1, dst2_size);
 /// \endcode
-/// into:
-/// \code
-///   memset(dst1, c, dst1_size);
-///   memset(dst2, c, dst2_size);
-/// \endcode
-/// When dst2_size <= dst1_size.
-///
-/// The \p MemCpy must have a Constant length.
-bool MemCpyOpt::performMemCpyToMemSetOptzn(MemCpyInst *MemCpy,
-                                           MemSetInst *MemSet) {
-  // This only makes sense on memcpy(..., memset(...), ...).
-  if (MemSet->getRawDest() != MemCpy->getRawSource())
-    return false;
-
-  ConstantInt *CopySize = cast<ConstantInt>(MemCpy->getLength());
-  ConstantInt *MemSetSize = dyn_cast<ConstantInt>(MemSet->getLength());
-  // Make sure the memcpy doesn't read any more than what the memset wrote.
-  // Don't worry about sizes larger than i64.
-  if (!MemSetSize || CopySize->getZExtValue() > MemSetSize->getZExtValue())
-    return false;
+/// when dst2_size <= dst1_size, or they are fresh from an allocator known to
+/// fill its memory: calloc, or malloc, new, memalign and the tail of a
+/// realloc when the module says they return zeroed memory (as in SafeInit
+/// builds).
+Value *MemCpyOpt::getKnownByteValue(Value *Ptr, ConstantInt *Size,
+                                    MemDepResult Dep) {
+  Instruction *I = Dep.getInst();
+  if (Dep.isClobber()) {
+    MemSetInst *MemSet = dyn_cast_or_null<MemSetInst>(I);
+    if (!MemSet || MemSet->isVolatile() || MemSet->getRawDest() != Ptr)
+      return nullptr;
+    // Make sure we don't read any more than what the memset wrote.
+    // Don't worry about sizes larger than i64.
+    ConstantInt *MemSetSize = dyn_cast<ConstantInt>(MemSet->getLength());
+    if (!MemSetSize || Size->getZExtValue() > MemSetSize->getZExtValue())
+      return nullptr;
+    return MemSet->getValue();
+  }
 
-  IRBuilder<> Builder(MemCpy);
-  Builder.CreateMemSet(MemCpy->getRawDest(), MemSet->getOperand(1),
-                       CopySize, MemCpy->getAlignment());
-  return true;
+  // (a def which is an allocation is the allocation of Ptr's object)
+  if (!Dep.isDef())
+    return nullptr;
+  int64_t Offset;
+  const DataLayout &DL = I->getModule()->getDataLayout();
+  if (GetPointerBaseWithConstantOffset(Ptr, Offset, DL) != I)
+    Offset = -1;
+  int Byte = getInitialAllocatedByte(
+      I, Offset, TLI->getMallocFillByte(*I->getModule()), DL, TLI);
+  if (Byte >= 0)
+    return ConstantInt::get(Type::getInt8Ty(Ptr->getContext()), Byte);
+  return nullptr;
 }
 
 /// Perform simplification of memcpy's.  If we have memcpy A
@@ -1167,7 +1187,8 @@ bool MemCpyOpt::processMemCpy(MemCpyInst *M) {
   //   c) memcpy from freshly alloca'd space or space that has just started its
   //      lifetime copies undefined data, and we can therefore eliminate the
   //      memcpy in favor of the data that was already at the destination.
-  //   d) memcpy from a just-memset'd source can be turned into memset.
+  //   d) memcpy from a just-memset'd (or freshly calloc'd) source can be
+  //      turned into memset, or dropped if the destination holds the same.
   if (DepInfo.isClobber()) {
     if (CallInst *C = dyn_cast<CallInst>(DepInfo.getInst())) {
       if (performCallSlotOptzn(M, M->getDest(), M->getSource(),
@@ -1208,14 +1229,25 @@ bool MemCpyOpt::processMemCpy(MemCpyInst *M) {
     }
   }
 
-  if (SrcDepInfo.isClobber())
-    if (MemSetInst *MDep = dyn_cast<MemSetInst>(SrcDepInfo.getInst()))
-      if (performMemCpyToMemSetOptzn(M, MDep)) {
-        MD->removeInstruction(M);
-        M->eraseFromParent();
-        ++NumCpyToSet;
-        return true;
-      }
+  // A memcpy from memory known to hold a single byte value is a memset of
+  // it, or nothing at all if the destination is known to hold it too.
+  if (Value *ByteVal = getKnownByteValue(M->getRawSource(), CopySize,
+                                         SrcDepInfo)) {
+    MemoryLocation DestLoc = MemoryLocation::getForDest(M);
+    MemDepResult DestDepInfo = MD->getPointerDependencyFrom(
+        DestLoc, false, M->getIterator(), M->getParent());
+    if (getKnownByteValue(M->getRawDest(), CopySize, DestDepInfo) == ByteVal) {
+      ++NumCpyOfSame;
+    } else {
+      IRBuilder<> Builder(M);
+      Builder.CreateMemSet(M->getRawDest(), ByteVal, CopySize,
+                           M->getAlignment());
+      ++NumCpyToSet;
+    }
+    MD->removeInstruction(M);
+    M->eraseFromParent();
+    return true;
+  }
 
   return false;
 }
@@ -2476,7 +2476,8 @@ private:
   bool rewriteIntegerStore(Value *V, StoreInst &SI) {
     assert(IntTy && "We cannot extract an integer from the alloca");
     assert(!SI.isVolatile());
-    if (DL.getTypeSizeInBits(V->getType()) != IntTy->getBitWidth()) {
+    bool Merged = DL.getTypeSizeInBits(V->getType()) != IntTy->getBitWidth();
+    if (Merged) {
       Value *Old =
           IRB.CreateAlignedLoad(&NewAI, NewAI.getAlignment(), "oldload");
       Old = convertValue(DL, IRB, Old, IntTy);
@@ -2486,8 +2487,10 @@ private:
     }
     V = convertValue(DL, IRB, V, NewAllocaTy);
     StoreInst *Store = IRB.CreateAlignedStore(V, &NewAI, NewAI.getAlignment());
+    // (a zero-init merged with what was there isn't one any more)
+    if (!Merged)
+      copyZeroInitMetadata(&SI, Store);
     Pass.DeadInsts.insert(&SI);
-    (void)Store;
     DEBUG(dbgs() << "          to: " << *Store << "\n");
     return true;
   }
@@ -2551,6 +2554,7 @@ private:
     }
     if (SI.isVolatile())
       NewSI->setAtomic(SI.getOrdering(), SI.getSynchScope());
+    copyZeroInitMetadata(&SI, NewSI);
     Pass.DeadInsts.insert(&SI);
     deleteIfTriviallyDead(OldOp);
 
@@ -2628,7 +2632,7 @@ private:
       CallInst *New = IRB.CreateMemSet(
           getNewAllocaSlicePtr(IRB, OldPtr->getType()), II.getValue(), Size,
           getSliceAlign(), II.isVolatile());
-      (void)New;
+      copyZeroInitMetadata(&II, New);
       DEBUG(dbgs() << "          to: " << *New << "\n");
       return false;
     }
@@ -2691,9 +2695,9 @@ private:
       V = convertValue(DL, IRB, V, AllocaTy);
     }
 
-    Value *New = IRB.CreateAlignedStore(V, &NewAI, NewAI.getAlignment(),
-                                        II.isVolatile());
-    (void)New;
+    StoreInst *New = IRB.CreateAlignedStore(V, &NewAI, NewAI.getAlignment(),
+                                            II.isVolatile());
+    copyZeroInitMetadata(&II, New);
     DEBUG(dbgs() << "          to: " << *New << "\n");
     return !II.isVolatile();
   }
@@ -179,7 +179,9 @@ namespace {
                                   SmallVectorImpl<AllocaInst *> &NewElts);
     void RewriteMemIntrinUserOfAlloca(MemIntrinsic *MI, Instruction *Inst,
                                       AllocaInst *AI,
-                                      SmallVectorImpl<AllocaInst *> &NewElts);
+                                      SmallVectorImpl<AllocaInst *> &NewElts,
+                                      uint64_t MemOffset = 0,
+                                      uint64_t MemSize = UINT64_MAX);
     void RewriteStoreUserOfWholeAlloca(StoreInst *SI, AllocaInst *AI,
                                        SmallVectorImpl<AllocaInst *> &NewElts);
     void RewriteLoadUserOfWholeAlloca(LoadInst *LI, AllocaInst *AI,
@@ -1594,6 +1596,51 @@ void SROA::DeleteDeadInstructions() {
   }
 }
 
+/// getElementOffset - Return the offset of element Idx of aggregate type T.
+static uint64_t getElementOffset(Type *T, unsigned Idx, const DataLayout &DL) {
+  if (StructType *ST = dyn_cast<StructType>(T))
+    return DL.getStructLayout(ST)->getElementOffset(Idx);
+  return DL.getTypeAllocSize(cast<SequentialType>(T)->getElementType()) * Idx;
+}
+
+/// isElementRangeMemSet - Return true if MI is a memset of part of an alloca
+/// of type T, at the given Offset, which starts and ends on element
+/// boundaries, such as SafeInit's zero-inits once DSE has trimmed them. These
+/// can be split into a memset of each element covered.
+static bool isElementRangeMemSet(MemIntrinsic *MI, Type *T, uint64_t Offset,
+                                 const DataLayout &DL) {
+  ConstantInt *Length = dyn_cast<ConstantInt>(MI->getLength());
+  if (!isa<MemSetInst>(MI) || MI->isVolatile() || !Length ||
+      Length->isNegative())
+    return false;
+  if (!isa<StructType>(T) && !isa<ArrayType>(T))
+    return false;
+  uint64_t AllocSize = DL.getTypeAllocSize(T);
+  uint64_t End = Offset + Length->getZExtValue();
+  if (End > AllocSize || (Offset == 0 && End == AllocSize))
+    return false;
+
+  // Each end must be at the start of an element, or at the end of T; a range
+  // ending in padding ends at the start of the next element.
+  auto IsBoundary = [&](uint64_t Off) {
+    if (Off == AllocSize)
+      return true;
+    if (StructType *ST = dyn_cast<StructType>(T)) {
+      const StructLayout *Layout = DL.getStructLayout(ST);
+      unsigned Idx = Layout->getElementContainingOffset(Off);
+      if (Layout->getElementOffset(Idx) == Off)
+        return true;
+      uint64_t EltEnd = Layout->getElementOffset(Idx) +
+                        DL.getTypeStoreSize(ST->getElementType(Idx));
+      return Off >= EltEnd &&
+             (Idx + 1 == ST->getNumElements() ||
+              Off <= Layout->getElementOffset(Idx + 1));
+    }
+    return Off % DL.getTypeAllocSize(T->getArrayElementType()) == 0;
+  };
+  return Offset < End && IsBoundary(Offset) && IsBoundary(End);
+}
+
 /// isSafeForScalarRepl - Check if instruction I is a safe use with regard to
 /// performing scalar replacement of alloca AI.  The results are flagged in
 /// the Info parameter.  Offset indicates the position within AI that is
@@ -1616,9 +1663,12 @@ void SROA::isSafeForScalarRepl(Instruction *I, uint64_t Offset,
       if (!Length || Length->isNegative())
         return MarkUnsafe(Info, User);
 
-      isSafeMemAccess(Offset, Length->getZExtValue(), nullptr,
-                      U.getOperandNo() == 0, Info, MI,
-                      true /*AllowWholeAccess*/);
+      if (isElementRangeMemSet(MI, Info.AI->getAllocatedType(), Offset, DL))
+        Info.hasSubelementAccess = true;
+      else
+        isSafeMemAccess(Offset, Length->getZExtValue(), nullptr,
+                        U.getOperandNo() == 0, Info, MI,
+                        true /*AllowWholeAccess*/);
     } else if (LoadInst *LI = dyn_cast<LoadInst>(User)) {
       if (!LI->isSimple())
         return MarkUnsafe(Info, User);
@@ -1892,6 +1942,8 @@ void SROA::RewriteForScalarRepl(Instruction *I, AllocaInst *AI, uint64_t Offset,
       uint64_t MemSize = Length->getZExtValue();
       if (Offset == 0 && MemSize == DL.getTypeAllocSize(AI->getAllocatedType()))
         RewriteMemIntrinUserOfAlloca(MI, I, AI, NewElts);
+      else if (isElementRangeMemSet(MI, AI->getAllocatedType(), Offset, DL))
+        RewriteMemIntrinUserOfAlloca(MI, I, AI, NewElts, Offset, MemSize);
       // Otherwise the intrinsic can only touch a single element and the
       // address operand will be updated, so nothing else needs to be done.
       continue;
@@ -2163,11 +2215,13 @@ void SROA::RewriteLifetimeIntrinsic(IntrinsicInst *II, AllocaInst *AI,
 }
 
 /// RewriteMemIntrinUserOfAlloca - MI is a memcpy/memset/memmove from or to AI.
-/// Rewrite it to copy or set the elements of the scalarized memory.
+/// Rewrite it to copy or set the elements of the scalarized memory. A memset
+/// may cover only the elements within [MemOffset, MemOffset+MemSize).
 void
 SROA::RewriteMemIntrinUserOfAlloca(MemIntrinsic *MI, Instruction *Inst,
                                    AllocaInst *AI,
-                                   SmallVectorImpl<AllocaInst *> &NewElts) {
+                                   SmallVectorImpl<AllocaInst *> &NewElts,
+                                   uint64_t MemOffset, uint64_t MemSize) {
   // If this is a memcpy/memmove, construct the other pointer as the
   // appropriate type.  The "Other" pointer is the pointer that goes to memory
   // that doesn't have anything to do with the alloca that we are promoting. For
@@ -2223,6 +2277,10 @@ SROA::RewriteMemIntrinUserOfAlloca(MemIntrinsic *MI, Instruction *Inst,
   const DataLayout &DL = MI->getModule()->getDataLayout();
 
   for (unsigned i = 0, e = NewElts.size(); i != e; ++i) {
+    uint64_t EltOffset = getElementOffset(AI->getAllocatedType(), i, DL);
+    if (EltOffset < MemOffset || EltOffset - MemOffset >= MemSize)
+      continue;
+
     // If this is a memcpy/memmove, emit a GEP of the other element address.
     Value *OtherElt = nullptr;
     unsigned OtherEltAlign = MemAlignment;
@@ -2233,14 +2291,6 @@ SROA::RewriteMemIntrinUserOfAlloca(MemIntrinsic *MI, Instruction *Inst,
       OtherElt = GetElementPtrInst::CreateInBounds(OtherPtr, Idx,
                                               OtherPtr->getName()+"."+Twine(i),
                                                    MI);
-      uint64_t EltOffset;
-      Type *OtherTy = AI->getAllocatedType();
-      if (StructType *ST = dyn_cast<StructType>(OtherTy)) {
-        EltOffset = DL.getStructLayout(ST)->getElementOffset(i);
-      } else {
-        Type *EltTy = cast<SequentialType>(OtherTy)->getElementType();
-        EltOffset = DL.getTypeAllocSize(EltTy) * i;
-      }
 
       // The alignment of the other pointer is the guaranteed alignment of the
       // element, which is affected by both the known alignment of the whole
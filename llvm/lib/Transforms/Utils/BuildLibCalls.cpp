@@ -277,7 +277,8 @@ bool llvm::inferLibFuncAttributes(Function &F, const TargetLibraryInfo &TLI) {
     Changed |= setDoesNotCapture(F, 1);
     return Changed;
   case LibFunc::read:
-    // May throw; "read" is a valid pthread cancellation point.
+  case LibFunc::recv:
+    // May throw; "read" and "recv" are valid pthread cancellation points.
     Changed |= setDoesNotCapture(F, 2);
     return Changed;
   case LibFunc::rewind:
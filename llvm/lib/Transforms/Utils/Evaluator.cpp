@@ -382,7 +382,7 @@ bool Evaluator::EvaluateBlock(BasicBlock::iterator CurInst,
           }
         }
 
-        if (II->getIntrinsicID() == Intrinsic::initialized) {
+        if (isa<InitializedInst>(II)) {
           ++CurInst;
           continue;
         }
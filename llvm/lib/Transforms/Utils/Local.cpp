@@ -1585,6 +1585,12 @@ void llvm::combineMetadata(Instruction *K, const Instruction *J,
       K->setMetadata(LLVMContext::MD_invariant_group, JMD);
 }
 
+void llvm::copyZeroInitMetadata(const Instruction *From, Instruction *To) {
+  for (const char *Kind : {"stackzeroinit", "heapzeroinit"})
+    if (MDNode *MD = From->getMetadata(Kind))
+      To->setMetadata(Kind, MD);
+}
+
 unsigned llvm::replaceDominatedUsesWith(Value *From, Value *To,
                                         DominatorTree &DT,
                                         const BasicBlockEdge &Root) {
@@ -40,12 +40,10 @@ StructType *SanitizerStatReport::makeModuleStatsTy() {
                                            makeModuleStatsArrayTy()});
 }
 
-void SanitizerStatReport::create(IRBuilder<> &B, SanitizerStatKind SK) {
-  Function *F = B.GetInsertBlock()->getParent();
-  Module *M = F->getParent();
-  PointerType *Int8PtrTy = B.getInt8PtrTy();
-  IntegerType *IntPtrTy = B.getIntPtrTy(M->getDataLayout());
-  ArrayType *StatTy = ArrayType::get(Int8PtrTy, 2);
+// Adds a counter tagged with SK, and returns its address.
+Constant *SanitizerStatReport::addInit(IntegerType *IntPtrTy,
+                                       SanitizerStatKind SK) {
+  PointerType *Int8PtrTy = Type::getInt8PtrTy(M->getContext());
 
   Inits.push_back(ConstantArray::get(
       StatTy,
@@ -55,18 +53,61 @@ void SanitizerStatReport::create(IRBuilder<> &B, SanitizerStatKind SK) {
                                                        kSanitizerStatKindBits)),
            Int8PtrTy)}));
 
-  FunctionType *StatReportTy =
-      FunctionType::get(B.getVoidTy(), Int8PtrTy, false);
-  Constant *StatReport = M->getOrInsertFunction(
-      "__sanitizer_stat_report", StatReportTy);
-
   auto InitAddr = ConstantExpr::getGetElementPtr(
       EmptyModuleStatsTy, ModuleStatsGV,
       ArrayRef<Constant *>{
-          ConstantInt::get(IntPtrTy, 0), ConstantInt::get(B.getInt32Ty(), 2),
+          ConstantInt::get(IntPtrTy, 0),
+          ConstantInt::get(Type::getInt32Ty(M->getContext()), 2),
           ConstantInt::get(IntPtrTy, Inits.size() - 1),
       });
-  B.CreateCall(StatReport, ConstantExpr::getBitCast(InitAddr, Int8PtrTy));
+  return ConstantExpr::getBitCast(InitAddr, Int8PtrTy);
+}
+
+void SanitizerStatReport::create(IRBuilder<> &B, SanitizerStatKind SK) {
+  Function *F = B.GetInsertBlock()->getParent();
+  Module *M = F->getParent();
+  PointerType *Int8PtrTy = B.getInt8PtrTy();
+  IntegerType *IntPtrTy = B.getIntPtrTy(M->getDataLayout());
+
+  FunctionType *StatReportTy =
+      FunctionType::get(B.getVoidTy(), Int8PtrTy, false);
+  Constant *StatReport = M->getOrInsertFunction(
+      "__sanitizer_stat_report", StatReportTy);
+
+  B.CreateCall(StatReport, addInit(IntPtrTy, SK));
+}
+
+void SanitizerStatReport::createWithCounts(
+    IRBuilder<> &B, SanitizerStatKind SK,
+    ArrayRef<std::pair<SanitizerStatKind, Value *>> Counts) {
+  Function *F = B.GetInsertBlock()->getParent();
+  Module *M = F->getParent();
+  PointerType *Int8PtrTy = B.getInt8PtrTy();
+  IntegerType *IntPtrTy = B.getIntPtrTy(M->getDataLayout());
+
+  FunctionType *StatReportTy =
+      FunctionType::get(B.getVoidTy(), Int8PtrTy, false);
+  Constant *StatReport = M->getOrInsertFunction(
+      "__sanitizer_stat_report", StatReportTy);
+
+  Constant *Addr = addInit(IntPtrTy, SK);
+  SmallVector<Constant *, 2> CountAddrs;
+  for (auto &Count : Counts)
+    CountAddrs.push_back(addInit(IntPtrTy, Count.first));
+  B.CreateCall(StatReport, Addr);
+
+  // The runtime only writes out counters with an address, so the others
+  // take the address the call just stored.
+  PointerType *IntPtrPtrTy = IntPtrTy->getPointerTo();
+  Value *Loc = B.CreateLoad(B.CreateBitCast(Addr, IntPtrPtrTy));
+  for (unsigned I = 0, E = Counts.size(); I != E; ++I) {
+    Value *CountLoc = B.CreateBitCast(CountAddrs[I], IntPtrPtrTy);
+    B.CreateStore(Loc, CountLoc);
+    Value *CountData = B.CreateConstGEP1_32(IntPtrTy, CountLoc, 1);
+    B.CreateStore(B.CreateAdd(B.CreateLoad(CountData),
+                              B.CreateZExtOrTrunc(Counts[I].second, IntPtrTy)),
+                  CountData);
+  }
 }
 
 void SanitizerStatReport::finish() {
@@ -4252,8 +4252,9 @@ void InnerLoopVectorizer::vectorizeBlockInLoop(BasicBlock *BB, PhiVector *PV) {
     }
 
     case Instruction::Call: {
-      // Ignore dbg intrinsics.
-      if (isa<DbgInfoIntrinsic>(it))
+      // Ignore dbg intrinsics, and llvm.initialized markers: the vector
+      // loop's stores carry no marker.
+      if (isa<DbgInfoIntrinsic>(it) || isa<InitializedInst>(it))
         break;
       setDebugLocFromInst(Builder, &*it);
 
@@ -4713,12 +4714,12 @@ bool LoopVectorizationLegality::canVectorizeInstrs() {
       } // end of PHI handling
 
       // We handle calls that:
-      //   * Are debug info intrinsics.
+      //   * Are debug info intrinsics or llvm.initialized markers.
       //   * Have a mapping to an IR intrinsic.
       //   * Have a vector version available.
       CallInst *CI = dyn_cast<CallInst>(it);
       if (CI && !getVectorIntrinsicIDForCall(CI, TLI) &&
-          !isa<DbgInfoIntrinsic>(CI) &&
+          !isa<DbgInfoIntrinsic>(CI) && !isa<InitializedInst>(CI) &&
           !(CI->getCalledFunction() && TLI &&
             TLI->isFunctionVectorizable(CI->getCalledFunction()->getName()))) {
         emitAnalysis(VectorizationReport(&*it)
@@ -5680,8 +5681,9 @@ LoopVectorizationCostModel::expectedCost(unsigned VF) {
 
     // For each instruction in the old loop.
     for (BasicBlock::iterator it = BB->begin(), e = BB->end(); it != e; ++it) {
-      // Skip dbg intrinsics.
-      if (isa<DbgInfoIntrinsic>(it))
+      // Skip dbg intrinsics and llvm.initialized markers, which the vector
+      // loop drops.
+      if (isa<DbgInfoIntrinsic>(it) || isa<InitializedInst>(it))
         continue;
 
       // Skip ignored values.
@@ -0,0 +1,16 @@
+; RUN: opt < %s -basicaa -aa-eval -print-all-alias-modref-info -disable-output 2>&1 | FileCheck %s
+
+; llvm.initialized only writes the range it marks.
+
+declare void @llvm.initialized.p0i8.i64(i8* nocapture, i64)
+
+define void @test(i8* %p) {
+  %q = getelementptr i8, i8* %p, i64 16
+  call void @llvm.initialized.p0i8.i64(i8* %p, i64 16)
+  store i8 0, i8* %q
+  ret void
+
+; CHECK-LABEL: Function: test:
+; CHECK: Just Mod:  Ptr: i8* %p        <->  call void @llvm.initialized.p0i8.i64(i8* %p, i64 16)
+; CHECK: NoModRef:  Ptr: i8* %q        <->  call void @llvm.initialized.p0i8.i64(i8* %p, i64 16)
+}
@@ -0,0 +1,49 @@
+; RUN: opt -S -basicaa -memdep-block-scan-limit=6 -gvn < %s | FileCheck %s
+
+; SafeInit zero-inits of other objects don't count against the block scan
+; limit, so the load is still forwarded from the store.
+
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare noalias i8* @malloc(i64)
+
+; CHECK-LABEL: @test(
+; CHECK-NOT: load
+; CHECK: ret i32 42
+define i32 @test() {
+  %a = alloca i32
+  %b = alloca [16 x i8]
+  %c = alloca [16 x i8]
+  %d = alloca [16 x i8]
+  store i32 42, i32* %a
+  %b8 = getelementptr [16 x i8], [16 x i8]* %b, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %b8, i8 0, i64 16, i32 1, i1 false), !stackzeroinit !0
+  %c8 = getelementptr [16 x i8], [16 x i8]* %c, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %c8, i8 0, i64 16, i32 1, i1 false), !stackzeroinit !0
+  %d8 = getelementptr [16 x i8], [16 x i8]* %d, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %d8, i8 0, i64 16, i32 1, i1 false), !stackzeroinit !0
+  %m = call noalias i8* @malloc(i64 16)
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 16, i32 1, i1 false), !heapzeroinit !0
+  %v = load i32, i32* %a
+  ret i32 %v
+}
+
+; Untagged memsets still count.
+; CHECK-LABEL: @untagged(
+; CHECK: load
+define i32 @untagged() {
+  %a = alloca i32
+  %b = alloca [16 x i8]
+  %c = alloca [16 x i8]
+  %d = alloca [16 x i8]
+  store i32 42, i32* %a
+  %b8 = getelementptr [16 x i8], [16 x i8]* %b, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %b8, i8 0, i64 16, i32 1, i1 false)
+  %c8 = getelementptr [16 x i8], [16 x i8]* %c, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %c8, i8 0, i64 16, i32 1, i1 false)
+  %d8 = getelementptr [16 x i8], [16 x i8]* %d, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %d8, i8 0, i64 16, i32 1, i1 false)
+  %v = load i32, i32* %a
+  ret i32 %v
+}
+
+!0 = !{}
@@ -0,0 +1,59 @@
+; RUN: llc -mtriple=aarch64-linux-gnu -enable-frame-init < %s | FileCheck %s
+; RUN: llc -mtriple=aarch64-linux-gnu -enable-frame-init -aarch64-frame-init-zva-threshold=256 < %s | FileCheck %s --check-prefix=ZVA
+; RUN: llc -mtriple=aarch64-linux-gnu -enable-frame-clear < %s | FileCheck %s --check-prefix=EXIT
+
+; The locals are cleared after the prologue with q register pairs, in a loop
+; for bigger frames, or with dc zva from -aarch64-frame-init-zva-threshold= on;
+; with -enable-frame-clear, again before the epilogue.
+
+declare void @use(i8*)
+
+define void @small() nounwind {
+; CHECK-LABEL: small:
+; CHECK:         sub sp, sp, #{{[0-9]+}}
+; CHECK:         movi v16.2d, #0000000000000000
+; CHECK-NEXT:    stp q16, q16, [sp]
+; CHECK-NEXT:    stp q16, q16, [sp, #32]
+; CHECK:         bl use
+;
+; EXIT-LABEL: small:
+; EXIT:          bl use
+; EXIT-NEXT:     movi v16.2d, #0000000000000000
+; EXIT-NEXT:     stp q16, q16, [sp]
+; EXIT-NEXT:     stp q16, q16, [sp, #32]
+; EXIT:          ret
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+define void @big() nounwind {
+; CHECK-LABEL: big:
+; CHECK:         movi v16.2d, #0000000000000000
+; CHECK-NEXT:    {{mov|add}} x16, sp
+; CHECK-NEXT:    {{mov|movz}} x17, #8
+; CHECK-NEXT:  [[LOOP:\.LBB[0-9_]+]]:
+; CHECK-NEXT:    stp q16, q16, [x16]
+; CHECK-NEXT:    stp q16, q16, [x16, #32]
+; CHECK-NEXT:    stp q16, q16, [x16, #64]
+; CHECK-NEXT:    stp q16, q16, [x16, #96]
+; CHECK-NEXT:    add x16, x16, #128
+; CHECK-NEXT:    sub x17, x17, #1
+; CHECK-NEXT:    cbnz x17, [[LOOP]]
+; CHECK:         bl use
+;
+; ZVA-LABEL: big:
+; ZVA:         [[LOOP:\.LBB[0-9_]+]]:
+; ZVA-NEXT:      dc zva, x16
+; ZVA-NEXT:      add x16, x16, #64
+; ZVA-NEXT:      sub x17, x17, #1
+; ZVA-NEXT:      cbnz x17, [[LOOP]]
+; ZVA:           bl use
+entry:
+  %buf = alloca [1024 x i8], align 16
+  %raw = getelementptr inbounds [1024 x i8], [1024 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
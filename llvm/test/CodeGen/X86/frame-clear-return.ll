@@ -0,0 +1,120 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-clear < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu < %s | FileCheck %s --check-prefix=POLICY
+
+; On return, the frame is cleared below RSP once the epilogue has popped it,
+; with a vector register the return value (or a tail call's arguments) don't
+; live in.
+
+declare void @use(i8*)
+declare void @take8(float, float, float, float, float, float, float, float)
+
+define void @nonleaf() nounwind {
+; CHECK-LABEL: nonleaf:
+; CHECK:         callq use
+; CHECK-NEXT:    addq $72, %rsp
+; CHECK-NEXT:    movq $0, -8(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, -24(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -40(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -56(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -72(%rsp)
+; CHECK-NEXT:    retq
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+; A leaf function keeps its buffer in the red zone, and returns in AL.
+define i8 @leaf(i64 %i) nounwind {
+; CHECK-LABEL: leaf:
+; CHECK-NOT:     subq {{.*}}, %rsp
+; CHECK:         movb {{.*}}, %al
+; CHECK-NEXT:    movq $0, -8(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, -24(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -40(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -56(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -72(%rsp)
+; CHECK-NEXT:    retq
+entry:
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 %i
+  store volatile i8 1, i8* %p
+  %v = load volatile i8, i8* %p
+  ret i8 %v
+}
+
+define i64 @ret_rax() nounwind {
+; CHECK-LABEL: ret_rax:
+; CHECK:         movq {{.*}}(%rsp), %rax
+; CHECK-NEXT:    addq $72, %rsp
+; CHECK-NOT:     %rax
+; CHECK:         movaps %xmm7, -72(%rsp)
+; CHECK-NEXT:    retq
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  %p = bitcast [64 x i8]* %buf to i64*
+  %v = load i64, i64* %p
+  ret i64 %v
+}
+
+define double @ret_xmm0() nounwind {
+; CHECK-LABEL: ret_xmm0:
+; CHECK:         movsd {{.*}}(%rsp), %xmm0
+; CHECK-NEXT:    addq $72, %rsp
+; CHECK-NOT:     %xmm0
+; CHECK:         xorps %xmm7, %xmm7
+; CHECK-NOT:     %xmm0
+; CHECK:         movaps %xmm7, -72(%rsp)
+; CHECK-NEXT:    retq
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  %p = bitcast [64 x i8]* %buf to double*
+  %v = load double, double* %p
+  ret double %v
+}
+
+; The tail call passes its arguments in XMM0-XMM7, so XMM8 is the first free
+; register at the TAILJMP. The frame leaves RSP off 16-byte alignment at the
+; end, so the aligned stores go through RAX.
+define void @tail(float %a, float %b, float %c, float %d, float %e, float %f, float %g, float %h) nounwind {
+; CHECK-LABEL: tail:
+; CHECK:         callq use
+; CHECK:         addq ${{[0-9]+}}, %rsp
+; CHECK-NOT:     %xmm7
+; CHECK:         leaq {{[0-9]+}}(%rsp), %rax
+; CHECK-NEXT:    xorps %xmm8, %xmm8
+; CHECK-NEXT:    movaps %xmm8, -{{[0-9]+}}(%rax)
+; CHECK-NOT:     %xmm7
+; CHECK:         jmp take8 # TAILCALL
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  tail call void @take8(float %a, float %b, float %c, float %d, float %e, float %f, float %g, float %h)
+  ret void
+}
+
+; Without -enable-frame-clear, only "frame-exit" functions are cleared.
+; POLICY-LABEL: nonleaf:
+; POLICY:         addq $72, %rsp
+; POLICY-NEXT:    retq
+; POLICY-LABEL: policy_exit:
+; POLICY:         addq $72, %rsp
+; POLICY-NEXT:    movq $0, -8(%rsp)
+; POLICY-NEXT:    xorps %xmm7, %xmm7
+; POLICY:         movaps %xmm7, -72(%rsp)
+; POLICY-NEXT:    retq
+define void @policy_exit() nounwind "safeinit-policy"="frame-exit" {
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
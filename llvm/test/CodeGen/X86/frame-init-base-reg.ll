@@ -0,0 +1,60 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s
+
+; The prologue clearing only uses registers the arguments don't live in: a
+; vector register past the XMM arguments, and a base register for the stores
+; past the GPR ones (and AL, for varargs).
+
+declare void @use(i8*)
+declare void @take(i32)
+declare void @llvm.va_start(i8*)
+
+define void @float_args(float %a, float %b, float %c, float %d, float %e, float %f, float %g, float %h) nounwind {
+; CHECK-LABEL: float_args:
+; CHECK:         subq $72, %rsp
+; CHECK-NEXT:    movq $0, 64(%rsp)
+; CHECK-NEXT:    xorps %xmm8, %xmm8
+; CHECK-NEXT:    movaps %xmm8, 48(%rsp)
+; CHECK-NEXT:    movaps %xmm8, 32(%rsp)
+; CHECK-NEXT:    movaps %xmm8, 16(%rsp)
+; CHECK-NEXT:    movaps %xmm8, (%rsp)
+; CHECK:         addss %xmm1, %xmm0
+; CHECK:         callq use
+entry:
+  %buf = alloca [64 x i8], align 16
+  %s1 = fadd float %a, %b
+  %s2 = fadd float %s1, %c
+  %s3 = fadd float %s2, %d
+  %s4 = fadd float %s3, %e
+  %s5 = fadd float %s4, %f
+  %s6 = fadd float %s5, %g
+  %s7 = fadd float %s6, %h
+  %p = bitcast [64 x i8]* %buf to float*
+  store float %s7, float* %p
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+; %n stays live in EDI, so RDI can't be the base.
+define void @varargs(i32 %n, ...) nounwind {
+; CHECK-LABEL: varargs:
+; CHECK:         subq ${{[0-9]+}}, %rsp
+; CHECK-NOT:     %xmm7
+; CHECK:         leaq {{-?[0-9]+}}(%rsp), %r10
+; CHECK-NEXT:    xorps %xmm8, %xmm8
+; CHECK:         movq ${{-[0-9]+}}, %r11
+; CHECK:         movaps %xmm8, {{-?[0-9]+}}(%r10,%r11)
+; CHECK-NOT:     %xmm7
+; CHECK:         testb %al, %al
+; CHECK:         callq use
+entry:
+  %buf = alloca [256 x i8], align 16
+  %ap = alloca [24 x i8], align 16
+  %ap.raw = getelementptr inbounds [24 x i8], [24 x i8]* %ap, i64 0, i64 0
+  call void @llvm.va_start(i8* %ap.raw)
+  %raw = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  call void @use(i8* %ap.raw)
+  call void @take(i32 %n)
+  ret void
+}
@@ -0,0 +1,51 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-pc-windows-msvc -enable-frame-init < %s | FileCheck %s --check-prefix=NOCLEAR
+; RUN: llc -mtriple=i386-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s --check-prefix=NOCLEAR
+
+; The saved frame pointer isn't cleared, and neither is anything else above
+; the area RSP addresses after a realigning prologue, where the stores are
+; unaligned ones. Only x86-64 SysV frames are cleared.
+
+declare void @use(i8*)
+
+define void @frame_pointer() nounwind "no-frame-pointer-elim"="true" {
+; CHECK-LABEL: frame_pointer:
+; CHECK:         pushq %rbp
+; CHECK-NEXT:    movq %rsp, %rbp
+; CHECK-NEXT:    subq $64, %rsp
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, 48(%rsp)
+; CHECK-NEXT:    movaps %xmm7, 32(%rsp)
+; CHECK-NEXT:    movaps %xmm7, 16(%rsp)
+; CHECK-NEXT:    movaps %xmm7, (%rsp)
+; CHECK-NEXT:    leaq -64(%rbp), %rdi
+; CHECK-NEXT:    callq use
+;
+; NOCLEAR-LABEL: frame_pointer:
+; NOCLEAR-NOT:   xmm7
+; NOCLEAR:       use
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+define void @realigned() nounwind {
+; CHECK-LABEL: realigned:
+; CHECK:         andq $-64, %rsp
+; CHECK:         xorps %xmm7, %xmm7
+; CHECK-NEXT:    movups %xmm7, 96(%rsp)
+; CHECK-NOT:     movaps
+; CHECK:         movups %xmm7, (%rsp)
+; CHECK:         callq use
+;
+; NOCLEAR-LABEL: realigned:
+; NOCLEAR-NOT:   xmm7
+; NOCLEAR:       use
+entry:
+  %buf = alloca [64 x i8], align 64
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
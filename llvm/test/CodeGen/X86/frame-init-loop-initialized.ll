@@ -0,0 +1,48 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -frame-init-selective=false < %s | FileCheck %s --check-prefix=NOSEL
+
+; An llvm.initialized marker in the entry block says the loop after it fills
+; the whole alloca before anything reads it, so the prologue needn't clear it.
+
+declare void @use(i8*, i32*)
+declare void @llvm.initialized.p0i8.i64(i8* nocapture, i64)
+
+define void @filled_by_loop() nounwind {
+; CHECK-LABEL: filled_by_loop:
+; CHECK:         subq $328, %rsp
+; CHECK-NEXT:    movq $0, 320(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NOT:     %r11
+; CHECK:         callq use
+;
+; NOSEL-LABEL: filled_by_loop:
+; NOSEL:         subq $328, %rsp
+; NOSEL-NEXT:    movq $0, 320(%rsp)
+; NOSEL:         movq $-320, %r11
+; NOSEL:         callq use
+entry:
+  %filled = alloca [64 x i32], align 16
+  %buf = alloca [64 x i8], align 16
+  %raw = bitcast [64 x i32]* %filled to i8*
+  call void @llvm.initialized.p0i8.i64(i8* %raw, i64 256)
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %next, %loop ]
+  %p = getelementptr inbounds [64 x i32], [64 x i32]* %filled, i64 0, i64 %i
+  %v = trunc i64 %i to i32
+  store i32 %v, i32* %p
+  %next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %next, 64
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %b = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  %f = getelementptr inbounds [64 x i32], [64 x i32]* %filled, i64 0, i64 0
+  call void @use(i8* %b, i32* %f)
+  ret void
+}
@@ -0,0 +1,51 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -frame-init-in-prologue=false < %s | FileCheck %s --check-prefix=NOPRO
+
+; Big frames are cleared by the prologue as it allocates them, a few chunks
+; at a time, so that the pages are touched in order and nothing is stored
+; below RSP. Frames we clear only in part are left to X86FrameInit.
+
+declare void @use(i8*)
+
+define void @huge() nounwind {
+; CHECK-LABEL: huge:
+; CHECK:         leaq -8200(%rsp), %r11
+; CHECK-NEXT:    xorps %xmm15, %xmm15
+; CHECK-NEXT:    subq $8, %rsp
+; CHECK-NEXT:    movq $0, (%rsp)
+; CHECK-NEXT:  [[LOOP:\.LBB[0-9_]+]]:
+; CHECK:         subq $64, %rsp
+; CHECK-NEXT:    movups %xmm15, (%rsp)
+; CHECK-NEXT:    movups %xmm15, 16(%rsp)
+; CHECK-NEXT:    movups %xmm15, 32(%rsp)
+; CHECK-NEXT:    movups %xmm15, 48(%rsp)
+; CHECK-NEXT:    cmpq %r11, %rsp
+; CHECK-NEXT:    jne [[LOOP]]
+; CHECK-NOT:     subq $8200, %rsp
+; CHECK-NOT:     rep;stosq
+; CHECK:         callq use
+;
+; NOPRO-LABEL: huge:
+; NOPRO:         subq $8200, %rsp
+; NOPRO-NOT:     %xmm15
+; NOPRO:         rep;stosq
+entry:
+  %buf = alloca [8192 x i8], align 16
+  %raw = getelementptr inbounds [8192 x i8], [8192 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+define void @huge_mixed() nounwind "safeinit-policy"="mixed" {
+; CHECK-LABEL: huge_mixed:
+; CHECK:         subq $8200, %rsp
+; CHECK-NOT:     %xmm15
+; CHECK:         callq use
+entry:
+  %buf = alloca [8192 x i8], align 16, !frame_zeroinit !0
+  %raw = getelementptr inbounds [8192 x i8], [8192 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,53 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s
+
+; Leaf functions keep their frame in the red zone, which is cleared below RSP
+; only as far down as the lowest object.
+
+define i8 @leaf64(i64 %i) nounwind {
+; CHECK-LABEL: leaf64:
+; CHECK-NOT:     subq {{.*}}, %rsp
+; CHECK:         movq $0, -8(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, -24(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -40(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -56(%rsp)
+; CHECK-NEXT:    movaps %xmm7, -72(%rsp)
+; CHECK-NOT:     movaps %xmm7, -88(%rsp)
+; CHECK:         retq
+entry:
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 %i
+  %v = load volatile i8, i8* %p
+  ret i8 %v
+}
+
+define i8 @leaf16(i64 %i) nounwind {
+; CHECK-LABEL: leaf16:
+; CHECK-NOT:     subq {{.*}}, %rsp
+; CHECK:         movq $0, -8(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, -24(%rsp)
+; CHECK-NOT:     %xmm7
+; CHECK:         retq
+entry:
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 %i
+  %v = load volatile i8, i8* %p
+  ret i8 %v
+}
+
+; Without a red zone, the frame is allocated and cleared above RSP.
+define i8 @leaf16_noredzone(i64 %i) nounwind noredzone {
+; CHECK-LABEL: leaf16_noredzone:
+; CHECK:         subq $24, %rsp
+; CHECK-NEXT:    movq $0, 16(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, (%rsp)
+; CHECK-NOT:     %xmm7
+; CHECK:         addq $24, %rsp
+entry:
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 %i
+  %v = load volatile i8, i8* %p
+  ret i8 %v
+}
@@ -0,0 +1,59 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -frame-init-selective=false < %s | FileCheck %s --check-prefix=NOSEL
+
+; Objects written in full before anything can read them aren't cleared in the
+; prologue, nor, under the "mixed" policy, are those SafeInit initializes in
+; IR (the allocas without !frame_zeroinit).
+
+declare void @use(i8*, i8*)
+declare void @llvm.memset.p0i8.i64(i8*, i8, i64, i32, i1)
+
+define void @selective() nounwind {
+; CHECK-LABEL: selective:
+; CHECK:         subq $136, %rsp
+; CHECK-NEXT:    movq $0, 128(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NOT:     %xmm7
+; CHECK-NOT:     %r11
+; CHECK:         callq use
+;
+; NOSEL-LABEL: selective:
+; NOSEL:         subq $136, %rsp
+; NOSEL-NEXT:    movq $0, 128(%rsp)
+; NOSEL:         movq $-128, %r11
+; NOSEL:         callq use
+entry:
+  %filled = alloca [64 x i8], align 16
+  %open = alloca [64 x i8], align 16
+  %f = getelementptr inbounds [64 x i8], [64 x i8]* %filled, i64 0, i64 0
+  %o = getelementptr inbounds [64 x i8], [64 x i8]* %open, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %f, i8 0, i64 64, i32 16, i1 false)
+  call void @use(i8* %f, i8* %o)
+  ret void
+}
+
+define void @mixed() nounwind "safeinit-policy"="mixed" {
+; CHECK-LABEL: mixed:
+; CHECK:         subq $136, %rsp
+; CHECK-NEXT:    movq $0, 128(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NEXT:    movaps %xmm7, {{[0-9]*}}(%rsp)
+; CHECK-NOT:     %xmm7
+; CHECK:         callq use
+entry:
+  %ours = alloca [64 x i8], align 16, !frame_zeroinit !0
+  %ir = alloca [64 x i8], align 16
+  %a = getelementptr inbounds [64 x i8], [64 x i8]* %ours, i64 0, i64 0
+  %b = getelementptr inbounds [64 x i8], [64 x i8]* %ir, i64 0, i64 0
+  call void @use(i8* %a, i8* %b)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,68 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -frame-init-stack-mark < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -enable-frame-clear -frame-init-stack-mark < %s | FileCheck %s --check-prefix=EXIT
+
+; With the stack mark, the prologue only clears the frame if it reaches above
+; the mark (the lowest the stack has been written since it was last cleared,
+; kept relative to the stack base in __safeinit_stack), and then lowers the
+; mark. Functions calling code which doesn't keep the mark drop it instead,
+; and leaf functions clearing on return raise it again.
+
+declare void @use(i8*)
+
+define void @open() nounwind {
+; CHECK-LABEL: open:
+; CHECK:         subq $72, %rsp
+; CHECK-NEXT:    movq __safeinit_stack@GOTTPOFF(%rip), %r11
+; CHECK-NEXT:    leaq 80(%rsp), %r10
+; CHECK-NEXT:    subq %fs:(%r11), %r10
+; CHECK-NEXT:    cmpq %fs:8(%r11), %r10
+; CHECK-NEXT:    jbe [[CONT:\.LBB[0-9_]+]]
+; CHECK:         movq $0, 64(%rsp)
+; CHECK-NEXT:    xorps %xmm7, %xmm7
+; CHECK:         movaps %xmm7, (%rsp)
+; CHECK-NEXT:  [[CONT]]:
+; CHECK-NEXT:    movq __safeinit_stack@GOTTPOFF(%rip), %r11
+; CHECK-NEXT:    movq $0, %fs:8(%r11)
+; CHECK:         callq use
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+define i8 @closed_leaf(i64 %i) nounwind {
+; CHECK-LABEL: closed_leaf:
+; CHECK:         movq __safeinit_stack@GOTTPOFF(%rip), %r11
+; CHECK-NEXT:    leaq 8(%rsp), %r10
+; CHECK-NEXT:    subq %fs:(%r11), %r10
+; CHECK-NEXT:    cmpq %fs:8(%r11), %r10
+; CHECK-NEXT:    jbe [[CONT:\.LBB[0-9_]+]]
+; CHECK:         movq $0, -8(%rsp)
+; CHECK:         movaps %xmm7, -72(%rsp)
+; CHECK-NEXT:  [[CONT]]:
+; CHECK-NEXT:    movq __safeinit_stack@GOTTPOFF(%rip), %r11
+; CHECK-NEXT:    leaq -72(%rsp), %r10
+; CHECK-NEXT:    subq %fs:(%r11), %r10
+; CHECK-NEXT:    cmpq %fs:8(%r11), %r10
+; CHECK-NEXT:    cmovaeq %fs:8(%r11), %r10
+; CHECK-NEXT:    movq %r10, %fs:8(%r11)
+; CHECK:         retq
+;
+; EXIT-LABEL: closed_leaf:
+; EXIT:          movb -72(%rsp,%rdi), %al
+; EXIT:          movaps %xmm7, -72(%rsp)
+; EXIT-NEXT:     movq __safeinit_stack@GOTTPOFF(%rip), %r11
+; EXIT-NEXT:     leaq -72(%rsp), %r10
+; EXIT-NEXT:     subq %fs:(%r11), %r10
+; EXIT-NEXT:     cmpq %fs:8(%r11), %r10
+; EXIT-NEXT:     leaq 72(%r10), %r10
+; EXIT-NEXT:     cmovneq %fs:8(%r11), %r10
+; EXIT-NEXT:     movq %r10, %fs:8(%r11)
+; EXIT-NEXT:     retq
+entry:
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 %i
+  %v = load volatile i8, i8* %p
+  ret i8 %v
+}
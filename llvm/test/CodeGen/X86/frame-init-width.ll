@@ -0,0 +1,82 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init < %s | FileCheck %s --check-prefix=SSE
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -mattr=+avx < %s | FileCheck %s --check-prefix=AVX
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -mattr=+avx512f < %s | FileCheck %s --check-prefix=AVX512
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -mattr=+avx -frame-init-vector-width=16 < %s | FileCheck %s --check-prefix=AVX16
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -frame-init-in-prologue=false < %s | FileCheck %s --check-prefix=REPSTOS
+
+; Frames are cleared with the widest vector stores the subtarget has (or
+; those -frame-init-vector-width= asks for), in a loop of four stores for
+; bigger frames, and with rep stosq from -frame-init-rep-stos-threshold= on.
+
+declare void @use(i8*)
+
+define void @medium() nounwind {
+; SSE-LABEL: medium:
+; SSE:         subq $264, %rsp
+; SSE-NEXT:    movq $0, 256(%rsp)
+; SSE-NEXT:    leaq 384(%rsp), %rax
+; SSE-NEXT:    xorps %xmm7, %xmm7
+; SSE-NEXT:    movq $-256, %r11
+; SSE:         [[LOOP:\.LBB[0-9_]+]]:
+; SSE-NEXT:    movaps %xmm7, -128(%rax,%r11)
+; SSE-NEXT:    movaps %xmm7, -112(%rax,%r11)
+; SSE-NEXT:    movaps %xmm7, -96(%rax,%r11)
+; SSE-NEXT:    movaps %xmm7, -80(%rax,%r11)
+; SSE-NEXT:    addq $64, %r11
+; SSE-NEXT:    jne [[LOOP]]
+; SSE:         callq use
+;
+; AVX-LABEL: medium:
+; AVX:         subq $264, %rsp
+; AVX-NEXT:    movq $0, 256(%rsp)
+; AVX-NEXT:    leaq 384(%rsp), %rax
+; AVX-NEXT:    vxorps %ymm7, %ymm7, %ymm7
+; AVX-NEXT:    movq $-256, %r11
+; AVX:         [[LOOP:\.LBB[0-9_]+]]:
+; AVX-NEXT:    vmovups %ymm7, -128(%rax,%r11)
+; AVX-NEXT:    vmovups %ymm7, -96(%rax,%r11)
+; AVX-NEXT:    vmovups %ymm7, -64(%rax,%r11)
+; AVX-NEXT:    vmovups %ymm7, -32(%rax,%r11)
+; AVX-NEXT:    addq $128, %r11
+; AVX-NEXT:    jne [[LOOP]]
+; AVX:         vzeroupper
+; AVX-NEXT:    callq use
+;
+; AVX512-LABEL: medium:
+; AVX512:      subq $264, %rsp
+; AVX512-NEXT: movq $0, 256(%rsp)
+; AVX512-NEXT: vpxord %zmm7, %zmm7, %zmm7
+; AVX512-NEXT: vmovups %zmm7, 192(%rsp)
+; AVX512-NEXT: vmovups %zmm7, 128(%rsp)
+; AVX512-NEXT: vmovups %zmm7, 64(%rsp)
+; AVX512-NEXT: vmovups %zmm7, (%rsp)
+; AVX512-NOT:  %r11
+; AVX512:      callq use
+;
+; AVX16-LABEL: medium:
+; AVX16:       vxorps %xmm7, %xmm7, %xmm7
+; AVX16:       vmovaps %xmm7, -128(%rax,%r11)
+; AVX16-NOT:   %ymm7
+; AVX16:       addq $64, %r11
+entry:
+  %buf = alloca [256 x i8], align 16
+  %raw = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+define void @huge() nounwind {
+; REPSTOS-LABEL: huge:
+; REPSTOS:      subq $8200, %rsp
+; REPSTOS-NEXT: movq $0, 8192(%rsp)
+; REPSTOS-NEXT: leaq (%rsp), %rdi
+; REPSTOS-NEXT: movl $1024, %ecx
+; REPSTOS-NEXT: movl $0, %eax
+; REPSTOS-NEXT: rep;stosq
+; REPSTOS:      callq use
+entry:
+  %buf = alloca [8192 x i8], align 16
+  %raw = getelementptr inbounds [8192 x i8], [8192 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
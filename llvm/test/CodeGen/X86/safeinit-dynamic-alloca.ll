@@ -0,0 +1,48 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -enable-frame-init -frame-init-dynamic-allocas < %s | FileCheck %s --check-prefix=GLOBAL
+
+; Dynamic allocas which SafeInit leaves to frame clearing are cleared as
+; they are allocated, with a vector store loop from the new stack pointer.
+
+declare void @use(i8*)
+
+define void @frame_policy(i64 %n) nounwind "safeinit-policy"="frame" {
+; CHECK-LABEL: frame_policy:
+; CHECK:       movq %{{[a-z0-9]+}}, %rsp
+; CHECK:       xorps %xmm0, %xmm0
+; CHECK:       [[LOOP:.LBB[0-9_]+]]:
+; CHECK:       movups %xmm0, (%{{[a-z0-9]+}},%{{[a-z0-9]+}})
+; CHECK-NEXT:  addq $16, %{{[a-z0-9]+}}
+; CHECK-NEXT:  jne [[LOOP]]
+; CHECK-NOT:   call{{.*}}memset
+; CHECK:       callq use
+entry:
+  %buf = alloca i8, i64 %n, align 16
+  call void @use(i8* %buf)
+  ret void
+}
+
+; "dynamic" functions get SafeInit memsets for their dynamic allocas.
+define void @dynamic_policy(i64 %n) nounwind "safeinit-policy"="dynamic" {
+; CHECK-LABEL: dynamic_policy:
+; CHECK-NOT:   movups
+; CHECK:       callq use
+entry:
+  %buf = alloca i8, i64 %n, align 16
+  call void @use(i8* %buf)
+  ret void
+}
+
+; Without a policy, only when asked for.
+define void @no_policy(i64 %n) nounwind {
+; CHECK-LABEL: no_policy:
+; CHECK-NOT:   movups
+; CHECK:       callq use
+; GLOBAL-LABEL: no_policy:
+; GLOBAL:      movups %xmm0, (%{{[a-z0-9]+}},%{{[a-z0-9]+}})
+; GLOBAL:      callq use
+entry:
+  %buf = alloca i8, i64 %n, align 16
+  call void @use(i8* %buf)
+  ret void
+}
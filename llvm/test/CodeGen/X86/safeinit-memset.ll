@@ -0,0 +1,102 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -mattr=-ermsb < %s | FileCheck %s --check-prefix=CHECK --check-prefix=LOOP
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -mattr=+ermsb < %s | FileCheck %s --check-prefix=CHECK --check-prefix=ERMSB
+
+; SafeInit stack memsets are lowered without calling memset: rep stosb on
+; processors with ERMSB, a vector store loop otherwise.
+
+declare void @llvm.memset.p0i8.i64(i8*, i8, i64, i32, i1)
+declare void @use(i8*)
+
+define void @small() nounwind {
+; CHECK-LABEL: small:
+; LOOP-NOT:    call{{.*}}memset
+; LOOP:        xorps %xmm0, %xmm0
+; LOOP:        [[LOOP:.LBB[0-9_]+]]:
+; LOOP:        movups %xmm0, (%{{[a-z0-9]+}},%{{[a-z0-9]+}})
+; LOOP-NEXT:   addq $16, %{{[a-z0-9]+}}
+; LOOP-NEXT:   jne [[LOOP]]
+; LOOP:        movl $0, {{[0-9]+}}(%rsp)
+; ERMSB-NOT:   rep;stosb
+; CHECK-NOT:   call{{.*}}memset
+; CHECK:       callq use
+entry:
+  %buf = alloca [516 x i8], align 16
+  %p = getelementptr inbounds [516 x i8], [516 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 516, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @large() nounwind {
+; CHECK-LABEL: large:
+; LOOP:        movups %xmm0
+; ERMSB:       movl $2048, %ecx
+; ERMSB:       rep;stosb
+; CHECK-NOT:   call{{.*}}memset
+; CHECK:       callq use
+entry:
+  %buf = alloca [2048 x i8], align 16
+  %p = getelementptr inbounds [2048 x i8], [2048 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 2048, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @huge() nounwind {
+; CHECK-LABEL: huge:
+; LOOP:        callq memset
+; ERMSB:       rep;stosb
+; ERMSB-NOT:   call{{.*}}memset
+; CHECK:       callq use
+entry:
+  %buf = alloca [65536 x i8], align 16
+  %p = getelementptr inbounds [65536 x i8], [65536 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 65536, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @variable(i64 %n) nounwind {
+; CHECK-LABEL: variable:
+; LOOP:        andq $-16
+; LOOP:        movups %xmm0, (%{{[a-z0-9]+}},%{{[a-z0-9]+}})
+; LOOP:        andq $15
+; LOOP:        movb %{{[a-z0-9]+}}, (%{{[a-z0-9]+}},%{{[a-z0-9]+}})
+; ERMSB:       rep;stosb
+; CHECK-NOT:   call{{.*}}memset
+; CHECK:       callq use
+entry:
+  %buf = alloca i8, i64 %n, align 16
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %n, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %buf)
+  ret void
+}
+
+define void @pattern() nounwind {
+; CHECK-LABEL: pattern:
+; LOOP:        movaps {{.*}}, %xmm0
+; LOOP:        movups %xmm0
+; ERMSB:       movb $-52, %al
+; ERMSB:       rep;stosb
+; CHECK:       callq use
+entry:
+  %buf = alloca [2048 x i8], align 16
+  %p = getelementptr inbounds [2048 x i8], [2048 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 204, i64 2048, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+; Memsets without the metadata keep calling memset.
+define void @plain() nounwind {
+; CHECK-LABEL: plain:
+; CHECK:       callq memset
+entry:
+  %buf = alloca [2048 x i8], align 16
+  %p = getelementptr inbounds [2048 x i8], [2048 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 2048, i32 16, i1 false)
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
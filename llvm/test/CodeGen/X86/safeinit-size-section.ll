@@ -0,0 +1,51 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -safeinit-size-section < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -safeinit-size-section -filetype=obj -o %t < %s
+; RUN: llvm-objdump -safeinit-sizes %t | FileCheck %s --check-prefix=OBJ
+
+; The init code of each function is bracketed by labels, and its size is
+; recorded with the function's in .llvm_safeinit_sizes.
+
+declare void @use(i8*)
+
+define void @frame_policy(i64 %n) nounwind "safeinit-policy"="frame" {
+; CHECK-LABEL: frame_policy:
+; CHECK:       .Lsafeinit_begin{{[0-9]+}}:
+; CHECK:       movups %xmm0
+; CHECK:       jne
+; CHECK-NEXT:  .Lsafeinit_end{{[0-9]+}}:
+; CHECK:       callq use
+; CHECK:       .section .llvm_safeinit_sizes,"",@progbits
+; CHECK-NEXT:  .long {{.*}}.Lsafeinit_end{{[0-9]+}}-.Lsafeinit_begin{{[0-9]+}}{{.*}} # init code bytes
+; CHECK-NEXT:  .long .Lfunc_end{{[0-9]+}}-frame_policy # code bytes
+; CHECK-NEXT:  .asciz "frame_policy"
+entry:
+  %buf = alloca i8, i64 %n, align 16
+  call void @use(i8* %buf)
+  ret void
+}
+
+define i32 @plain(i32 %x) nounwind {
+; CHECK-LABEL: plain:
+; CHECK-NOT:   .Lsafeinit_begin
+; CHECK:       .section .llvm_safeinit_sizes,"",@progbits
+; CHECK-NEXT:  .long 0 # init code bytes
+; CHECK-NEXT:  .long .Lfunc_end{{[0-9]+}}-plain # code bytes
+; CHECK-NEXT:  .asciz "plain"
+  %y = add i32 %x, 1
+  ret i32 %y
+}
+
+; Inline functions' entries are dropped with them.
+define linkonce_odr void @inline_fn() nounwind comdat {
+; CHECK-LABEL: inline_fn:
+; CHECK:       .section .llvm_safeinit_sizes,"G",@progbits,inline_fn,comdat
+  ret void
+}
+$inline_fn = comdat any
+
+; OBJ:      SafeInit code sizes:
+; OBJ-NEXT:       init       code  function
+; OBJ-NEXT: {{ +[1-9][0-9]* +[1-9][0-9]*}}  frame_policy
+; OBJ-NEXT: {{ +0 +[1-9][0-9]*}}  plain
+; OBJ-NEXT: {{ +0 +[1-9][0-9]*}}  inline_fn
+; OBJ-NEXT: {{ +[1-9][0-9]* +[1-9][0-9]*}}  <total> ({{[0-9.]+}}% init)
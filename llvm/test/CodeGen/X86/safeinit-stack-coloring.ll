@@ -0,0 +1,55 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -protect-from-escaped-allocas < %s | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -protect-from-escaped-allocas -pass-remarks-analysis=stackcoloring -o /dev/null < %s 2>&1 | FileCheck %s --check-prefix=REMARK
+
+; A SafeInit init just ahead of a lifetime start doesn't stop the slot from
+; being shared; a load there still does.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+declare i32 @foo(i32, i8*)
+declare void @llvm.lifetime.start(i64, i8* nocapture) nounwind
+declare void @llvm.lifetime.end(i64, i8* nocapture) nounwind
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: early_init:
+; CHECK: subq $136, %rsp
+; REMARK: remark: {{.*}} merging 1 stack slots saved 128 of 264 bytes
+define i32 @early_init(i32 %in) {
+entry:
+  %a = alloca [17 x i8*], align 8
+  %a2 = alloca [16 x i8*], align 8
+  %b = bitcast [17 x i8*]* %a to i8*
+  %b2 = bitcast [16 x i8*]* %a2 to i8*
+  call void @llvm.lifetime.start(i64 -1, i8* %b)
+  %t1 = call i32 @foo(i32 %in, i8* %b)
+  call void @llvm.lifetime.end(i64 -1, i8* %b)
+  call void @llvm.memset.p0i8.i64(i8* %b2, i8 0, i64 16, i32 8, i1 false), !stackzeroinit !0
+  call void @llvm.lifetime.start(i64 -1, i8* %b2)
+  %t2 = call i32 @foo(i32 %in, i8* %b2)
+  call void @llvm.lifetime.end(i64 -1, i8* %b2)
+  %t3 = add i32 %t1, %t2
+  ret i32 %t3
+}
+
+; CHECK-LABEL: early_load:
+; CHECK: subq $272, %rsp
+; REMARK: remark: {{.*}} merging 0 stack slots saved 0 of 264 bytes
+define i32 @early_load(i32 %in) {
+entry:
+  %a = alloca [17 x i8*], align 8
+  %a2 = alloca [16 x i8*], align 8
+  %b = bitcast [17 x i8*]* %a to i8*
+  %b2 = bitcast [16 x i8*]* %a2 to i8*
+  %p2 = bitcast [16 x i8*]* %a2 to i32*
+  call void @llvm.lifetime.start(i64 -1, i8* %b)
+  %t1 = call i32 @foo(i32 %in, i8* %b)
+  call void @llvm.lifetime.end(i64 -1, i8* %b)
+  %v = load volatile i32, i32* %p2
+  call void @llvm.lifetime.start(i64 -1, i8* %b2)
+  %t2 = call i32 @foo(i32 %v, i8* %b2)
+  call void @llvm.lifetime.end(i64 -1, i8* %b2)
+  %t3 = add i32 %t1, %t2
+  ret i32 %t3
+}
+
+!0 = !{}
@@ -0,0 +1,38 @@
+; Test naming stack origins the way SafeInit advisor builds do.
+; RUN: opt < %s -msan -msan-track-origins=1 -msan-safeinit-sites -S | FileCheck %s
+; RUN: opt < %s -msan -msan-track-origins=1 -S | FileCheck %s --check-prefix=DEFAULT
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @llvm.dbg.declare(metadata, metadata, metadata)
+
+; Allocas with debug info are named by their variable and line; others keep
+; their IR name.
+; CHECK-DAG: c"----buf:7@f\00"
+; CHECK-DAG: c"----tmp@f\00"
+; DEFAULT-DAG: c"----@f\00"
+; DEFAULT-DAG: c"----tmp@f\00"
+define i32 @f() sanitize_memory !dbg !4 {
+  %1 = alloca i32, align 4
+  %tmp = alloca i32, align 4
+  call void @llvm.dbg.declare(metadata i32* %1, metadata !7, metadata !DIExpression()), !dbg !9
+  %a = load i32, i32* %1
+  %b = load i32, i32* %tmp
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "clang", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)
+!1 = !DIFile(filename: "a.c", directory: "/tmp")
+!2 = !{}
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = distinct !DISubprogram(name: "f", scope: !1, file: !1, line: 5, type: !5, isLocal: false, isDefinition: true, scopeLine: 5, isOptimized: false, unit: !0, variables: !2)
+!5 = !DISubroutineType(types: !6)
+!6 = !{null}
+!7 = !DILocalVariable(name: "buf", scope: !4, file: !1, line: 7, type: !8)
+!8 = !DIBasicType(name: "int", size: 32, align: 32, encoding: DW_ATE_signed)
+!9 = !DILocation(line: 7, column: 7, scope: !4)
@@ -0,0 +1,97 @@
+; Test leaving out the inits of stack sites an advisor build found to be
+; written before they're read, where a static check agrees.
+; RUN: opt < %s -safeinit -STACKZEROINIT_ADVICE=%S/Inputs/advice.txt -S | FileCheck %s
+; RUN: opt < %s -safeinit -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i32*)
+declare void @llvm.dbg.declare(metadata, metadata, metadata)
+
+; An element at an unknown index is written, then read back.
+; CHECK-LABEL: define i32 @advised(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret i32
+; OFF-LABEL: define i32 @advised(
+; OFF: @llvm.memset
+define i32 @advised(i64 %i, i32 %v) {
+  %x = alloca [16 x i32], align 16
+  %p = getelementptr inbounds [16 x i32], [16 x i32]* %x, i64 0, i64 %i
+  store i32 %v, i32* %p
+  %r = load i32, i32* %p
+  ret i32 %r
+}
+
+; The same, but the advisor didn't list it.
+; CHECK-LABEL: define i32 @not_listed(
+; CHECK: @llvm.memset
+define i32 @not_listed(i64 %i, i32 %v) {
+  %x = alloca [16 x i32], align 16
+  %p = getelementptr inbounds [16 x i32], [16 x i32]* %x, i64 0, i64 %i
+  store i32 %v, i32* %p
+  %r = load i32, i32* %p
+  ret i32 %r
+}
+
+; Listed, but we can't see what the callee reads.
+; CHECK-LABEL: define void @escapes(
+; CHECK: @llvm.memset
+define void @escapes(i64 %i, i32 %v) {
+  %x = alloca [16 x i32], align 16
+  %p = getelementptr inbounds [16 x i32], [16 x i32]* %x, i64 0, i64 %i
+  store i32 %v, i32* %p
+  %q = getelementptr inbounds [16 x i32], [16 x i32]* %x, i64 0, i64 0
+  call void @use(i32* %q)
+  ret void
+}
+
+; Listed, but there's a path on which the read comes first.
+; CHECK-LABEL: define i32 @read_first(
+; CHECK: @llvm.memset
+define i32 @read_first(i1 %c, i64 %i, i32 %v) {
+entry:
+  %x = alloca [16 x i32], align 16
+  %p = getelementptr inbounds [16 x i32], [16 x i32]* %x, i64 0, i64 %i
+  br i1 %c, label %write, label %read
+
+write:
+  store i32 %v, i32* %p
+  br label %read
+
+read:
+  %r = load i32, i32* %p
+  ret i32 %r
+}
+
+; Without an IR name, the site is named by its debug variable and line.
+; CHECK-LABEL: define i32 @debug_named(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret i32
+; OFF-LABEL: define i32 @debug_named(
+; OFF: @llvm.memset
+define i32 @debug_named(i64 %i, i32 %v) !dbg !4 {
+  %1 = alloca [16 x i32], align 16
+  call void @llvm.dbg.declare(metadata [16 x i32]* %1, metadata !7, metadata !DIExpression()), !dbg !12
+  %2 = getelementptr inbounds [16 x i32], [16 x i32]* %1, i64 0, i64 %i
+  store i32 %v, i32* %2
+  %3 = load i32, i32* %2
+  ret i32 %3
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "clang", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)
+!1 = !DIFile(filename: "a.c", directory: "/tmp")
+!2 = !{}
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = distinct !DISubprogram(name: "debug_named", scope: !1, file: !1, line: 5, type: !5, isLocal: false, isDefinition: true, scopeLine: 5, isOptimized: false, unit: !0, variables: !2)
+!5 = !DISubroutineType(types: !6)
+!6 = !{null}
+!7 = !DILocalVariable(name: "buf", scope: !4, file: !1, line: 7, type: !8)
+!8 = !DICompositeType(tag: DW_TAG_array_type, baseType: !9, size: 512, align: 32, elements: !10)
+!9 = !DIBasicType(name: "int", size: 32, align: 32, encoding: DW_ATE_signed)
+!10 = !{!11}
+!11 = !DISubrange(count: 16)
+!12 = !DILocation(line: 7, column: 7, scope: !4)
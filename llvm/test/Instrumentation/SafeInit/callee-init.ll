@@ -0,0 +1,93 @@
+; Test that writes done by a callee before it reads its argument count
+; towards covering the caller's alloca.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%pair = type { i32, i32 }
+
+define void @init_pair(%pair* %p) {
+  %a = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  store i32 1, i32* %a
+  %b = getelementptr inbounds %pair, %pair* %p, i64 0, i32 1
+  store i32 2, i32* %b
+  ret void
+}
+
+define void @init_first(%pair* %p) {
+  %a = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  store i32 1, i32* %a
+  ret void
+}
+
+define i32 @read_first(%pair* %p) {
+  %a = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  %v = load i32, i32* %a
+  store i32 %v, i32* %a
+  ret i32 %v
+}
+
+@saved = global %pair* null
+
+define void @init_and_capture(%pair* %p) {
+  %a = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  store i32 1, i32* %a
+  %b = getelementptr inbounds %pair, %pair* %p, i64 0, i32 1
+  store i32 2, i32* %b
+  store %pair* %p, %pair** @saved
+  ret void
+}
+
+declare void @init_external(%pair* "safeinit-initializes"="8")
+declare void @use(%pair*)
+
+define void @full() {
+; CHECK-LABEL: define void @full(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+  %p = alloca %pair, align 4
+  call void @init_pair(%pair* %p)
+  call void @use(%pair* %p)
+  ret void
+}
+
+define void @half() {
+; CHECK-LABEL: define void @half(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 4, i32 4, i1 false), !stackzeroinit
+; CHECK: call void @init_first
+  %p = alloca %pair, align 4
+  call void @init_first(%pair* %p)
+  call void @use(%pair* %p)
+  ret void
+}
+
+define void @reads() {
+; CHECK-LABEL: define void @reads(
+; CHECK: store %pair zeroinitializer, %pair* %p, align 4, !stackzeroinit
+; CHECK: call i32 @read_first
+  %p = alloca %pair, align 4
+  call i32 @read_first(%pair* %p)
+  call void @use(%pair* %p)
+  ret void
+}
+
+define void @captures() {
+; CHECK-LABEL: define void @captures(
+; CHECK: store %pair zeroinitializer, %pair* %p, align 4, !stackzeroinit
+; CHECK: call void @init_and_capture
+  %p = alloca %pair, align 4
+  call void @init_and_capture(%pair* %p)
+  call void @use(%pair* %p)
+  ret void
+}
+
+define void @external() {
+; CHECK-LABEL: define void @external(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+  %p = alloca %pair, align 4
+  call void @init_external(%pair* %p)
+  call void @use(%pair* %p)
+  ret void
+}
@@ -0,0 +1,42 @@
+; Test that static allocas initialized at the same point are merged into one
+; alloca and cleared with a single memset.
+; RUN: opt < %s -safeinit -STACKZEROINIT_COALESCE -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use3(i32*, [10 x i8]*, i64*)
+declare void @use2(i32*, i64*)
+declare void @llvm.lifetime.start(i64, i8* nocapture)
+declare void @llvm.lifetime.end(i64, i8* nocapture)
+
+; Slices are ordered by alignment: %c at 0, %a at 8, %b at 12.
+define void @three() {
+; CHECK-LABEL: define void @three(
+; CHECK: %safeinit.coalesced = alloca [22 x i8], align 8
+; CHECK-NOT: alloca
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 22, i32 8, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: call void @use3(i32* %a, [10 x i8]* %b, i64* %c)
+entry:
+  %a = alloca i32, align 4
+  %b = alloca [10 x i8], align 1
+  %c = alloca i64, align 8
+  call void @use3(i32* %a, [10 x i8]* %b, i64* %c)
+  ret void
+}
+
+; Allocas with lifetimes keep their own slots (and memsets).
+define void @lifetimes() {
+; CHECK-LABEL: define void @lifetimes(
+; CHECK-NOT: safeinit.coalesced
+; CHECK: ret void
+entry:
+  %a = alloca i32, align 4
+  %c = alloca i64, align 8
+  %c8 = bitcast i64* %c to i8*
+  call void @llvm.lifetime.start(i64 8, i8* %c8)
+  call void @use2(i32* %a, i64* %c)
+  call void @llvm.lifetime.end(i64 8, i8* %c8)
+  ret void
+}
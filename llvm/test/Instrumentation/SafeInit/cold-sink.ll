@@ -0,0 +1,83 @@
+; Test that late inits for allocas only used on cold paths are sunk onto
+; those paths, rather than being done once in a common dominator.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_COLDSINK=false -S | FileCheck %s --check-prefix=NOSINK
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @report(i8*)
+
+define i32 @cold_errors(i1 %e1, i1 %e2) {
+; CHECK-LABEL: define i32 @cold_errors(
+; CHECK: entry:
+; CHECK-NOT: @llvm.memset
+; CHECK: br i1 %e1
+; NOSINK-LABEL: define i32 @cold_errors(
+; NOSINK: entry:
+; NOSINK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 128, i32 16, i1 false), !stackzeroinit
+; NOSINK-NOT: @llvm.memset
+; NOSINK: ret i32 0
+entry:
+  %msg = alloca [128 x i8], align 16
+  br i1 %e1, label %err1, label %check2, !prof !0
+
+; CHECK: err1:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 128, i32 16, i1 false), !stackzeroinit
+; CHECK: call void @report
+err1:
+  %p1 = getelementptr inbounds [128 x i8], [128 x i8]* %msg, i64 0, i64 0
+  call void @report(i8* %p1)
+  ret i32 1
+
+; CHECK: check2:
+; CHECK-NOT: @llvm.memset
+; CHECK: br i1 %e2
+check2:
+  br i1 %e2, label %err2, label %ok, !prof !0
+
+; CHECK: err2:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 128, i32 16, i1 false), !stackzeroinit
+; CHECK: call void @report
+err2:
+  %p2 = getelementptr inbounds [128 x i8], [128 x i8]* %msg, i64 0, i64 0
+  call void @report(i8* %p2)
+  ret i32 2
+
+; CHECK: ok:
+; CHECK-NOT: @llvm.memset
+; CHECK: ret i32 0
+ok:
+  ret i32 0
+}
+
+; Without branch weights both paths are equally likely, so a single init is
+; cheaper.
+define i32 @warm_errors(i1 %e1, i1 %e2) {
+; CHECK-LABEL: define i32 @warm_errors(
+; CHECK: entry:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 128, i32 16, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret i32 0
+entry:
+  %msg = alloca [128 x i8], align 16
+  br i1 %e1, label %err1, label %check2
+
+err1:
+  %p1 = getelementptr inbounds [128 x i8], [128 x i8]* %msg, i64 0, i64 0
+  call void @report(i8* %p1)
+  ret i32 1
+
+check2:
+  br i1 %e2, label %err2, label %ok
+
+err2:
+  %p2 = getelementptr inbounds [128 x i8], [128 x i8]* %msg, i64 0, i64 0
+  call void @report(i8* %p2)
+  ret i32 2
+
+ok:
+  ret i32 0
+}
+
+!0 = !{!"branch_weights", i32 1, i32 1000}
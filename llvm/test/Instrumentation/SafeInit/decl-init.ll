@@ -0,0 +1,40 @@
+; Test that allocas which clang marks as initialized in full at their
+; declaration aren't initialized again.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_TRUSTDECLINITS=false -S | FileCheck %s --check-prefix=NOTRUST
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @init(i8*)
+declare void @use(i8*)
+
+; (The initializer is opaque here; clang only marks ones it emits itself.)
+define void @marked() {
+; CHECK-LABEL: define void @marked(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+; NOTRUST-LABEL: define void @marked(
+; NOTRUST: call void @llvm.memset.p0i8.i64(i8* %{{[^ ]+}}, i8 0, i64 64, i32 {{[0-9]+}}, i1 false), !stackzeroinit
+; NOTRUST: ret void
+entry:
+  %buf = alloca [64 x i8], align 16, !safeinit.initialized !0
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @init(i8* %raw)
+  call void @use(i8* %raw)
+  ret void
+}
+
+define void @unmarked() {
+; CHECK-LABEL: define void @unmarked(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{[^ ]+}}, i8 0, i64 64, i32 {{[0-9]+}}, i1 false), !stackzeroinit
+; CHECK: ret void
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @init(i8* %raw)
+  call void @use(i8* %raw)
+  ret void
+}
+
+!0 = !{}
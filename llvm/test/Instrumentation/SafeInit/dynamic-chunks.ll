@@ -0,0 +1,52 @@
+; Test that dynamic allocas accessed through an increasing index are zeroed
+; lazily in chunks, rather than in full up front.
+; RUN: opt < %s -safeinit -STACKZEROINIT_DYNCHUNKS -STACKZEROINIT_DYNCHUNKSIZE=1024 -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i32*)
+
+define i32 @prefix(i64 %n, i64 %m) {
+; CHECK-LABEL: define i32 @prefix(
+; CHECK: %safeinit.hwm = alloca i64, !no_zeroinit
+; CHECK: %vla = alloca i32, i64 %n
+; CHECK-NOT: @llvm.memset
+; CHECK: store i64 0, i64* %safeinit.hwm
+; CHECK: loop:
+; CHECK: [[HWM:%.*]] = load i64, i64* %safeinit.hwm
+; CHECK: [[CMP:%.*]] = icmp uge i64 %i, [[HWM]]
+; CHECK: br i1 [[CMP]], {{.*}} !prof
+; CHECK: and i64 {{.*}}, -256
+; CHECK: add i64 {{.*}}, 256
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}), !stackzeroinit
+; CHECK: store i64 {{.*}}, i64* %safeinit.hwm
+; CHECK: getelementptr inbounds i32, i32* %vla, i64 %i
+entry:
+  %vla = alloca i32, i64 %n
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %sum = phi i32 [ 0, %entry ], [ %sum.next, %loop ]
+  %p = getelementptr inbounds i32, i32* %vla, i64 %i
+  %v = load i32, i32* %p
+  %sum.next = add i32 %sum, %v
+  %i.next = add nuw nsw i64 %i, 1
+  %c = icmp ult i64 %i.next, %m
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret i32 %sum.next
+}
+
+; Escaping dynamic allocas are zeroed in full.
+define void @escapes(i64 %n) {
+; CHECK-LABEL: define void @escapes(
+; CHECK-NOT: safeinit.hwm
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}), !stackzeroinit
+; CHECK: call void @use
+  %vla = alloca i32, i64 %n
+  call void @use(i32* %vla)
+  ret void
+}
@@ -0,0 +1,120 @@
+; Test that allocas used by exception handling are initialized in the EH
+; pads, off the paths which don't throw. (Cold path sinking, which would do
+; the same for some of these based on block frequencies, is kept out of it.)
+; RUN: opt < %s -safeinit -STACKZEROINIT_COLDSINKPERCENT=0 -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_COLDSINKPERCENT=0 -STACKZEROINIT_COLDEHPADS=false -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @may_throw()
+declare void @report(i8*)
+declare i32 @__gxx_personality_v0(...)
+
+; A buffer only used by the cleanups of two invokes.
+define void @cleanups() personality i32 (...)* @__gxx_personality_v0 {
+; CHECK-LABEL: define void @cleanups(
+; CHECK: entry:
+; CHECK-NOT: @llvm.memset
+; CHECK: invoke void @may_throw()
+; OFF-LABEL: define void @cleanups(
+; OFF: entry:
+; OFF: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+; OFF: invoke void @may_throw()
+; OFF-NOT: @llvm.memset
+; OFF: ret void
+entry:
+  %msg = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %msg, i64 0, i64 0
+  invoke void @may_throw()
+          to label %next unwind label %lpad1
+
+next:
+  invoke void @may_throw()
+          to label %done unwind label %lpad2
+
+done:
+  ret void
+
+; CHECK: lpad1:
+; CHECK-NEXT: landingpad
+; CHECK-NEXT: cleanup
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: call void @report
+lpad1:
+  %lp1 = landingpad { i8*, i32 }
+          cleanup
+  call void @report(i8* %p)
+  resume { i8*, i32 } %lp1
+
+; CHECK: lpad2:
+; CHECK-NEXT: landingpad
+; CHECK-NEXT: cleanup
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: call void @report
+lpad2:
+  %lp2 = landingpad { i8*, i32 }
+          cleanup
+  call void @report(i8* %p)
+  resume { i8*, i32 } %lp2
+}
+
+; A buffer used before an invoke, and by its cleanup: the cleanup may read
+; what was written before, so a single init stays ahead of both.
+define void @written_before(i1 %c) personality i32 (...)* @__gxx_personality_v0 {
+; CHECK-LABEL: define void @written_before(
+; CHECK: entry:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %msg = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %msg, i64 0, i64 0
+  call void @report(i8* %p)
+  invoke void @may_throw()
+          to label %done unwind label %lpad
+
+done:
+  ret void
+
+lpad:
+  %lp = landingpad { i8*, i32 }
+          cleanup
+  call void @report(i8* %p)
+  resume { i8*, i32 } %lp
+}
+
+; Used on a path which never reaches the invoke, and by the cleanup: each
+; gets its own init.
+define void @separate(i1 %c) personality i32 (...)* @__gxx_personality_v0 {
+; CHECK-LABEL: define void @separate(
+; CHECK: entry:
+; CHECK-NOT: @llvm.memset
+; CHECK: early:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+; CHECK: lpad:
+; CHECK-NEXT: landingpad
+; CHECK-NEXT: cleanup
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+entry:
+  %msg = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %msg, i64 0, i64 0
+  br i1 %c, label %early, label %work
+
+early:
+  call void @report(i8* %p)
+  ret void
+
+work:
+  invoke void @may_throw()
+          to label %done unwind label %lpad
+
+done:
+  ret void
+
+lpad:
+  %lp = landingpad { i8*, i32 }
+          cleanup
+  call void @report(i8* %p)
+  resume { i8*, i32 } %lp
+}
@@ -0,0 +1,72 @@
+; Test that small, partly written heap allocations are switched to the
+; allocator's no-init entry points, with the rest zeroed inline.
+; RUN: opt < %s -safeinit -STACKZEROINIT_HEAPNOINIT -STACKZEROINIT_HEAPINLINEZERO -malloc-returns-zero -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_HEAPNOINIT -STACKZEROINIT_HEAPINLINEZERO -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare noalias i8* @malloc(i64)
+declare noalias i8* @_Znwm(i64)
+declare void @use(i8*)
+
+; A new-expression whose first field is set: only the rest is zeroed,
+; right after the call.
+; CHECK-LABEL: @new_partial(
+; CHECK: %p = call i8* @tc_new_noinit(i64 32)
+; CHECK-NEXT: %[[REST:[0-9]+]] = getelementptr inbounds i8, i8* %p, i64 8
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %[[REST]], i8 0, i64 24, i32 8, i1 false), !stackzeroinit
+; CHECK-NEXT: %q = bitcast i8* %p to i64*
+; OFF-LABEL: @new_partial(
+; OFF: call i8* @_Znwm(i64 32)
+; OFF-NOT: @llvm.memset
+define i8* @new_partial(i64 %x) {
+  %p = call i8* @_Znwm(i64 32), !safeinit.new !0
+  %q = bitcast i8* %p to i64*
+  store i64 %x, i64* %q
+  call void @use(i8* %p)
+  ret i8* %p
+}
+
+; A malloc is zeroed on the non-null side of its null check.
+; CHECK-LABEL: @malloc_checked(
+; CHECK: %p = call i8* @tc_malloc_noinit(i64 16)
+; CHECK: ok:
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: call void @use(i8* %p)
+define void @malloc_checked() {
+  %p = call i8* @malloc(i64 16)
+  %null = icmp eq i8* %p, null
+  br i1 %null, label %fail, label %ok
+
+ok:
+  call void @use(i8* %p)
+  ret void
+
+fail:
+  ret void
+}
+
+; Without a null check, there's nowhere safe to zero a malloc.
+; CHECK-LABEL: @malloc_unchecked(
+; CHECK: call i8* @malloc(i64 16)
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @malloc_unchecked() {
+  %p = call i8* @malloc(i64 16)
+  call void @use(i8* %p)
+  ret void
+}
+
+; Big allocations are left to the allocator.
+; CHECK-LABEL: @too_big(
+; CHECK: call i8* @_Znwm(i64 4096)
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @too_big() {
+  %p = call i8* @_Znwm(i64 4096), !safeinit.new !0
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
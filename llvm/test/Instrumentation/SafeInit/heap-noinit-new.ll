@@ -0,0 +1,91 @@
+; Test that new-expressions whose constructor initializes every byte of the
+; object are switched to the allocator's no-init operator new.
+; RUN: opt < %s -safeinit -STACKZEROINIT_HEAPNOINIT -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%pair = type { i32, i32 }
+%padded = type { i32, i64 }
+
+declare noalias i8* @_Znwm(i64)
+declare noalias i8* @_Znam(i64)
+declare void @_ZdlPv(i8*)
+declare i32 @__gxx_personality_v0(...)
+
+define linkonce_odr void @_ZN4pairC2Ev(%pair* %this) {
+  %a = getelementptr inbounds %pair, %pair* %this, i64 0, i32 0
+  store i32 1, i32* %a
+  %b = getelementptr inbounds %pair, %pair* %this, i64 0, i32 1
+  store i32 2, i32* %b
+  ret void
+}
+
+; (leaves the padding after the first member alone)
+define linkonce_odr void @_ZN6paddedC2Ev(%padded* %this) {
+  %a = getelementptr inbounds %padded, %padded* %this, i64 0, i32 0
+  store i32 1, i32* %a
+  %b = getelementptr inbounds %padded, %padded* %this, i64 0, i32 1
+  store i64 2, i64* %b
+  ret void
+}
+
+; CHECK-LABEL: @new_pair(
+; CHECK: call i8* @tc_new_noinit(i64 8)
+define %pair* @new_pair() {
+  %call = call i8* @_Znwm(i64 8), !safeinit.new !0
+  %p = bitcast i8* %call to %pair*
+  call void @_ZN4pairC2Ev(%pair* %p)
+  ret %pair* %p
+}
+
+; An invoked constructor, with the usual cleanup.
+; CHECK-LABEL: @new_pair_invoke(
+; CHECK: call i8* @tc_new_noinit(i64 8)
+define %pair* @new_pair_invoke() personality i32 (...)* @__gxx_personality_v0 {
+  %call = call i8* @_Znwm(i64 8), !safeinit.new !0
+  %p = bitcast i8* %call to %pair*
+  invoke void @_ZN4pairC2Ev(%pair* %p)
+          to label %cont unwind label %lpad
+
+cont:
+  ret %pair* %p
+
+lpad:
+  %lp = landingpad { i8*, i32 }
+          cleanup
+  call void @_ZdlPv(i8* %call)
+  resume { i8*, i32 } %lp
+}
+
+; CHECK-LABEL: @new_array(
+; CHECK: call i8* @tc_newarray_noinit(i64 8)
+define i32* @new_array() {
+  %call = call i8* @_Znam(i64 8), !safeinit.new !0
+  %p = bitcast i8* %call to i64*
+  store i64 0, i64* %p
+  %q = bitcast i8* %call to i32*
+  ret i32* %q
+}
+
+; The padding isn't written.
+; CHECK-LABEL: @new_padded(
+; CHECK: call i8* @_Znwm(i64 16)
+define %padded* @new_padded() {
+  %call = call i8* @_Znwm(i64 16), !safeinit.new !0
+  %p = bitcast i8* %call to %padded*
+  call void @_ZN6paddedC2Ev(%padded* %p)
+  ret %padded* %p
+}
+
+; A direct call to operator new, rather than a new-expression.
+; CHECK-LABEL: @direct(
+; CHECK: call i8* @_Znwm(i64 8)
+define %pair* @direct() {
+  %call = call i8* @_Znwm(i64 8)
+  %p = bitcast i8* %call to %pair*
+  call void @_ZN4pairC2Ev(%pair* %p)
+  ret %pair* %p
+}
+
+!0 = !{}
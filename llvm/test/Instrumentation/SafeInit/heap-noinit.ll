@@ -0,0 +1,71 @@
+; Test that malloc calls whose result is fully written before any read are
+; switched to the allocator's no-init entry point.
+; RUN: opt < %s -safeinit -STACKZEROINIT_HEAPNOINIT -S | FileCheck %s
+; RUN: opt < %s -safeinit -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare noalias i8* @malloc(i64)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture readonly, i64, i32, i1)
+declare void @use(i8*)
+
+; A buffer copy of the full allocation.
+; CHECK-LABEL: @copy(
+; CHECK: call i8* @tc_malloc_noinit(i64 64)
+; OFF-LABEL: @copy(
+; OFF: call i8* @malloc(i64 64)
+define i8* @copy(i8* %src) {
+  %p = call i8* @malloc(i64 64)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 64, i32 1, i1 false)
+  ret i8* %p
+}
+
+; Stores covering every byte, behind a null check.
+; CHECK-LABEL: @stores(
+; CHECK: call i8* @tc_malloc_noinit(i64 8)
+define i32* @stores() {
+  %p = call i8* @malloc(i64 8)
+  %null = icmp eq i8* %p, null
+  br i1 %null, label %fail, label %ok
+
+ok:
+  %q = bitcast i8* %p to i32*
+  store i32 1, i32* %q
+  %r = getelementptr inbounds i32, i32* %q, i64 1
+  store i32 2, i32* %r
+  ret i32* %q
+
+fail:
+  ret i32* null
+}
+
+; Only part of the allocation is written.
+; CHECK-LABEL: @partial(
+; CHECK: call i8* @malloc(i64 64)
+define i8* @partial(i8* %src) {
+  %p = call i8* @malloc(i64 64)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 32, i32 1, i1 false)
+  ret i8* %p
+}
+
+; The allocation escapes before it's written.
+; CHECK-LABEL: @escapes(
+; CHECK: call i8* @malloc(i64 64)
+define void @escapes(i8* %src) {
+  %p = call i8* @malloc(i64 64)
+  call void @use(i8* %p)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 64, i32 1, i1 false)
+  ret void
+}
+
+; Sizes we don't know.
+; CHECK-LABEL: @variable(
+; CHECK: call i8* @malloc(i64 %n)
+define i8* @variable(i8* %src, i64 %n) {
+  %p = call i8* @malloc(i64 %n)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 %n, i32 1, i1 false)
+  ret i8* %p
+}
+
+; CHECK: declare noalias i8* @tc_malloc_noinit(i64)
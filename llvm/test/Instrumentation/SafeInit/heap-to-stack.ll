@@ -0,0 +1,89 @@
+; Test moving small non-escaping heap allocations to the stack.
+; RUN: opt < %s -safeinit -STACKZEROINIT_HEAPTOSTACK -malloc-returns-zero -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_HEAPTOSTACK -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare noalias i8* @malloc(i64)
+declare void @free(i8*)
+declare void @use(i8*)
+
+@g = global i8* null
+
+; A temporary which is read before it's written is zeroed where it was
+; allocated, and no longer freed.
+; CHECK-LABEL: define i32 @temp(
+; CHECK: %m = alloca [64 x i8], align 16, !no_zeroinit
+; CHECK-NOT: @malloc
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 64, i32 16, i1 false), !stackzeroinit
+; CHECK-NOT: @free
+; CHECK: ret i32
+; OFF-LABEL: define i32 @temp(
+; OFF: call i8* @malloc(i64 64)
+; OFF: call void @free
+define i32 @temp(i32 %x) {
+  %m = call i8* @malloc(i64 64)
+  %null = icmp eq i8* %m, null
+  br i1 %null, label %fail, label %ok
+
+ok:
+  %p = bitcast i8* %m to i32*
+  %q = getelementptr inbounds i32, i32* %p, i64 3
+  %old = load i32, i32* %q
+  store i32 %x, i32* %p
+  %v = load i32, i32* %p
+  %sum = add i32 %old, %v
+  call void @free(i8* %m)
+  ret i32 %sum
+
+fail:
+  ret i32 0
+}
+
+; Allocated on every iteration: the alloca is zeroed on every iteration.
+; CHECK-LABEL: define i32 @loop(
+; CHECK: %m = alloca [16 x i8], align 16, !no_zeroinit
+; CHECK: loop:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+; CHECK-NOT: @free
+; CHECK: br i1
+define i32 @loop(i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = phi i32 [ 0, %entry ], [ %acc.next, %loop ]
+  %m = call i8* @malloc(i64 16)
+  %p = bitcast i8* %m to i32*
+  %v = load i32, i32* %p
+  store i32 %i, i32* %p
+  %acc.next = add i32 %acc, %v
+  call void @free(i8* %m)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret i32 %acc.next
+}
+
+; Allocations which escape, or are too big, stay on the heap.
+; CHECK-LABEL: define void @stays(
+; CHECK: call i8* @malloc(i64 32)
+; CHECK: call i8* @malloc(i64 32)
+; CHECK: call i8* @malloc(i64 4096)
+; CHECK-NOT: alloca
+; CHECK: ret void
+define void @stays() {
+  %a = call i8* @malloc(i64 32)
+  store i8* %a, i8** @g
+  %b = call i8* @malloc(i64 32)
+  call void @use(i8* %b)
+  call void @free(i8* %b)
+  %c = call i8* @malloc(i64 4096)
+  store i8 1, i8* %c
+  call void @free(i8* %c)
+  ret void
+}
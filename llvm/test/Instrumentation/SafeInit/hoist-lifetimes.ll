@@ -0,0 +1,70 @@
+; Test hoisting of loop-scoped lifetimes ahead of SafeInit.
+; RUN: opt < %s -safeinit-hoist-lifetimes -safeinit -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @llvm.lifetime.start(i64, i8* nocapture) nounwind
+declare void @llvm.lifetime.end(i64, i8* nocapture) nounwind
+declare void @use(i8*)
+
+; A scratch buffer declared inside the loop body is initialized once, in the
+; preheader, rather than on every iteration.
+define void @scratch(i32 %n) {
+; CHECK-LABEL: define void @scratch(
+entry:
+  %buf = alloca [4096 x i8], align 16
+  br label %loop.ph
+
+; CHECK: loop.ph:
+; CHECK: call void @llvm.lifetime.start(i64 4096
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: br label %loop
+loop.ph:
+  br label %loop
+
+; CHECK: loop:
+; CHECK-NOT: @llvm.lifetime
+; CHECK-NOT: @llvm.memset
+; CHECK: br i1
+loop:
+  %i = phi i32 [ 0, %loop.ph ], [ %i.next, %loop ]
+  %p = getelementptr inbounds [4096 x i8], [4096 x i8]* %buf, i64 0, i64 0
+  call void @llvm.lifetime.start(i64 4096, i8* %p)
+  call void @use(i8* %p)
+  call void @llvm.lifetime.end(i64 4096, i8* %p)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+; CHECK: exit:
+; CHECK: call void @llvm.lifetime.end(i64 4096
+exit:
+  ret void
+}
+
+; The alloca is also used after the loop, so its contents may flow out of
+; the loop and the lifetime has to stay where it is.
+define void @used_after(i32 %n) {
+; CHECK-LABEL: define void @used_after(
+entry:
+  %x = alloca i32, align 4
+  %x.ptr = bitcast i32* %x to i8*
+  br label %loop
+
+; CHECK: loop:
+; CHECK: call void @llvm.lifetime.start(i64 4
+; CHECK: store i32 0, i32* %x, align 4, !stackzeroinit
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.lifetime.start(i64 4, i8* %x.ptr)
+  call void @use(i8* %x.ptr)
+  call void @llvm.lifetime.end(i64 4, i8* %x.ptr)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  call void @use(i8* %x.ptr)
+  ret void
+}
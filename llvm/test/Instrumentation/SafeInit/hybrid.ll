@@ -0,0 +1,115 @@
+; Test the per-function choice between IR inits and frame clearing.
+; RUN: opt < %s -safeinit-hybrid -STACKZEROINIT_HYBRID -S | FileCheck %s
+; RUN: opt < %s -safeinit-hybrid -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; An init in a loop costs more than clearing the frame once.
+; CHECK: define void @frame(i32 %n) #[[FRAME:[0-9]+]] {
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+; OFF-LABEL: define void @frame(
+; OFF: @llvm.memset
+define void @frame(i32 %n) {
+entry:
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; A small part of a big alloca is cheaper to clear in IR, and an alloca
+; whose init was optimized away costs nothing.
+; CHECK: define void @ir() {
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 8, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+define void @ir() {
+  %buf = alloca [256 x i8], align 16
+  %other = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  %q = getelementptr inbounds [16 x i8], [16 x i8]* %other, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  call void @use(i8* %q)
+  ret void
+}
+
+; CHECK: define void @mixed(i32 %n) #[[MIXED:[0-9]+]] {
+; CHECK: %small = alloca [16 x i8], align 16, !frame_zeroinit
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 16, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @mixed(i32 %n) {
+entry:
+  %buf = alloca [256 x i8], align 16
+  %small = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  %q = getelementptr inbounds [16 x i8], [16 x i8]* %small, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.memset.p0i8.i64(i8* %q, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %q)
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; An explicit policy is left alone.
+; CHECK-LABEL: define void @explicit(
+; CHECK: @llvm.memset
+define void @explicit() #0 {
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+; Pattern inits stay in IR, since the frame is only ever cleared to zero.
+; CHECK: define void @pattern(i32 %n) {
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %p, i8 -52, i64 16, i32 16, i1 false), !stackzeroinit
+define void @pattern(i32 %n) {
+entry:
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 -52, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+attributes #0 = { "safeinit-policy"="ir" }
+
+; CHECK-DAG: attributes #[[FRAME]] = { "safeinit-policy"="frame" }
+; CHECK-DAG: attributes #[[MIXED]] = { "safeinit-policy"="mixed" }
+
+!0 = !{}
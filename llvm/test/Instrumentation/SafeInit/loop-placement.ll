@@ -0,0 +1,79 @@
+; Test that late inits for allocas used in loops are placed just before the
+; outermost loop containing the uses, rather than in the entry block.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+define void @early_return(i1 %err, i32 %n) {
+; CHECK-LABEL: define void @early_return(
+; CHECK: entry:
+; CHECK-NOT: @llvm.memset
+; CHECK: br i1 %err
+entry:
+  %buf = alloca [64 x i8], align 16
+  br i1 %err, label %fail, label %outer.ph
+
+fail:
+  ret void
+
+; CHECK: outer.ph:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 64, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: br label %outer
+outer.ph:
+  br label %outer
+
+; CHECK: outer:
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+outer:
+  %i = phi i32 [ 0, %outer.ph ], [ %i.next, %outer.latch ]
+  br label %inner
+
+inner:
+  %j = phi i32 [ 0, %outer ], [ %j.next, %inner ]
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  %j.next = add i32 %j, 1
+  %c.inner = icmp slt i32 %j.next, %n
+  br i1 %c.inner, label %inner, label %outer.latch
+
+outer.latch:
+  %i.next = add i32 %i, 1
+  %c.outer = icmp slt i32 %i.next, %n
+  br i1 %c.outer, label %outer, label %exit
+
+exit:
+  ret void
+}
+
+; The loop has no preheader, so the init goes at the end of the header's
+; immediate dominator.
+define void @no_preheader(i1 %a, i32 %n) {
+; CHECK-LABEL: define void @no_preheader(
+; CHECK: entry:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 64, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: br i1 %a
+; CHECK: loop:
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %buf = alloca [64 x i8], align 16
+  br i1 %a, label %left, label %loop
+
+left:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ 1, %left ], [ %i.next, %loop ]
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret void
+}
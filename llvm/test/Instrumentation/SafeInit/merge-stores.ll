@@ -0,0 +1,81 @@
+; Test merging the zero stores left from trimmed inits into wide stores.
+; REQUIRES: x86-registered-target
+; RUN: opt < %s -safeinit-merge-stores -STACKZEROINIT_MERGESTORES -mattr=+avx2 -S | FileCheck %s
+; RUN: opt < %s -safeinit-merge-stores -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+; Zero stores of different widths around a field write make one vector store
+; where the last of them was.
+; CHECK-LABEL: define void @interleaved(
+; CHECK: store i64 %v, i64* %f2, align 16
+; CHECK-NOT: store i{{[0-9]+}} 0
+; CHECK: store <2 x i64> zeroinitializer, <2 x i64>* %{{.*}}, align 16, !stackzeroinit
+; CHECK-NOT: store i{{[0-9]+}} 0
+; CHECK: call void @use(
+; OFF-LABEL: define void @interleaved(
+; OFF-NOT: store <
+define void @interleaved(i64 %v) {
+  %buf = alloca [4 x i64], align 16
+  %f0 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 0
+  %f1 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 1
+  %f2 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 2
+  %f3 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 3
+  %lo = bitcast i64* %f1 to i32*
+  %hi = getelementptr inbounds i32, i32* %lo, i64 1
+  store i64 0, i64* %f0, align 16, !stackzeroinit !0
+  store i64 %v, i64* %f2, align 16
+  store i32 0, i32* %lo, align 8, !stackzeroinit !0
+  store i64 %v, i64* %f3, align 8
+  store i32 0, i32* %hi, align 4, !stackzeroinit !0
+  %p = bitcast [4 x i64]* %buf to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+; A 32-byte aligned alloca gets a whole AVX register's worth; a program
+; store merged in leaves it unmarked.
+; CHECK-LABEL: define void @wide(
+; CHECK: store <4 x i64> zeroinitializer, <4 x i64>* %{{.*}}, align 32{{$}}
+; CHECK-NOT: store i64 0
+define void @wide() {
+  %buf = alloca [4 x i64], align 32
+  %f0 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 0
+  %f1 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 1
+  %f2 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 2
+  %f3 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 3
+  store i64 0, i64* %f0, align 32, !stackzeroinit !0
+  store i64 0, i64* %f1, align 8, !stackzeroinit !0
+  store i64 0, i64* %f2, align 16
+  store i64 0, i64* %f3, align 8, !stackzeroinit !0
+  %p = bitcast [4 x i64]* %buf to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+; A load of what the first store wrote, or a call which may throw, keeps the
+; stores apart.
+; CHECK-LABEL: define i64 @blocked(
+; CHECK-NOT: store <
+; CHECK: ret i64
+define i64 @blocked() {
+  %buf = alloca [4 x i64], align 16
+  %f0 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 0
+  %f1 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 1
+  %f2 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 2
+  %f3 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 3
+  store i64 0, i64* %f0, align 16
+  %x = load i64, i64* %f0, align 16
+  store i64 0, i64* %f1, align 8
+  store i64 0, i64* %f2, align 16
+  call void @use(i8* null)
+  store i64 0, i64* %f3, align 8
+  %p = bitcast [4 x i64]* %buf to i8*
+  call void @use(i8* %p)
+  ret i64 %x
+}
+
+!0 = !{}
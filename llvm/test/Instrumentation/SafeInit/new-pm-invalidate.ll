@@ -0,0 +1,38 @@
+; Test that under the new pass manager, SafeInit reports a function it only
+; added stack inits to as changed (invalidating the cached analyses), and a
+; function it left alone as unchanged.
+; RUN: opt < %s -disable-output -debug-pass-manager \
+; RUN:     -passes='function(require<no-op-function>,safeinit,require<no-op-function>)' 2>&1 \
+; RUN:     | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+; @init: its buffer gets an init, so the cached analysis is dropped.
+; CHECK: Running analysis: NoOpFunctionAnalysis
+; CHECK: Running pass: SafeInitPass
+; CHECK: Invalidating analysis: NoOpFunctionAnalysis
+; CHECK: Running pass: RequireAnalysisPass
+; CHECK-NEXT: Running analysis: NoOpFunctionAnalysis
+define void @init() {
+entry:
+  %buf = alloca [16 x i8], align 16
+  %raw = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %raw)
+  ret void
+}
+
+; @noinit: no allocas, so nothing is invalidated.
+; CHECK: Running analysis: NoOpFunctionAnalysis
+; CHECK: Running pass: SafeInitPass
+; CHECK-NOT: Invalidating analysis
+; CHECK: Running pass: RequireAnalysisPass
+; CHECK-NOT: Running analysis: NoOpFunctionAnalysis
+; CHECK: Finished {{(llvm::)?}}Function pass manager run
+define void @noinit(i8* %p) {
+entry:
+  call void @use(i8* %p)
+  ret void
+}
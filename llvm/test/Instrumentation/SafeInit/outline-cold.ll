@@ -0,0 +1,62 @@
+; Test moving big inits which rarely run into cold zeroing functions.
+; RUN: opt < %s -safeinit-outline -STACKZEROINIT_OUTLINECOLD -S | FileCheck %s
+; RUN: opt < %s -safeinit-outline -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; An error path buffer is cleared out of line, the hot one inline.
+; CHECK-LABEL: define void @error_path(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %h, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit
+; CHECK: error:
+; CHECK-NEXT: call void @__safeinit_zero_cold_4096_16(i8* %c)
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+; OFF-LABEL: define void @error_path(
+; OFF-NOT: @__safeinit_zero
+define void @error_path(i1 %fail) {
+entry:
+  %hot = alloca [4096 x i8], align 16
+  %cold = alloca [4096 x i8], align 16
+  %h = getelementptr inbounds [4096 x i8], [4096 x i8]* %hot, i64 0, i64 0
+  %c = getelementptr inbounds [4096 x i8], [4096 x i8]* %cold, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %h, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %h)
+  br i1 %fail, label %error, label %exit, !prof !1
+
+error:
+  call void @llvm.memset.p0i8.i64(i8* %c, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %c)
+  br label %exit
+
+exit:
+  ret void
+}
+
+; Everything in a cold function is cold, but small inits stay inline.
+; CHECK-LABEL: define void @cold_fn(
+; CHECK: call void @__safeinit_zero_cold_2048_8(i8* %b)
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %s, i8 0, i64 64, i32 8, i1 false), !stackzeroinit
+define void @cold_fn() cold {
+  %big = alloca [2048 x i8], align 8
+  %small = alloca [64 x i8], align 8
+  %b = getelementptr inbounds [2048 x i8], [2048 x i8]* %big, i64 0, i64 0
+  %s = getelementptr inbounds [64 x i8], [64 x i8]* %small, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %b, i8 0, i64 2048, i32 8, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %s, i8 0, i64 64, i32 8, i1 false), !stackzeroinit !0
+  call void @use(i8* %b)
+  call void @use(i8* %s)
+  ret void
+}
+
+; CHECK: define linkonce_odr hidden void @__safeinit_zero_cold_4096_16(i8* nocapture) unnamed_addr #[[ATTRS:[0-9]+]] section ".text.unlikely" comdat
+; CHECK-NEXT: entry:
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %0, i8 0, i64 4096, i32 16, i1 false)
+; CHECK-NEXT: ret void
+; CHECK: attributes #[[ATTRS]] = { cold noinline nounwind }
+
+!0 = !{}
+!1 = !{!"branch_weights", i32 1, i32 1000}
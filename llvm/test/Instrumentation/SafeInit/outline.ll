@@ -0,0 +1,80 @@
+; Test sharing zeroing functions between common inits.
+; RUN: opt < %s -safeinit-outline -STACKZEROINIT_OUTLINE -S | FileCheck %s
+; RUN: opt < %s -safeinit-outline -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; Two inits of the same size and alignment share a function.
+; CHECK-LABEL: define void @a(
+; CHECK: call void @__safeinit_zero_128_16(i8* %p)
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+; OFF-LABEL: define void @a(
+; OFF: @llvm.memset
+define void @a() {
+  %buf = alloca [128 x i8], align 16
+  %p = getelementptr inbounds [128 x i8], [128 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 128, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK-LABEL: define void @b(
+; CHECK: call void @__safeinit_zero_128_16(i8* %p)
+; A size used once, a small init, and a memset which isn't SafeInit's are
+; left alone.
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %q, i8 0, i64 96, i32 16, i1 false)
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %r, i8 0, i64 16, i32 16, i1 false)
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %s, i8 0, i64 128, i32 16, i1 false)
+; CHECK: ret void
+define void @b() {
+  %buf = alloca [128 x i8], align 16
+  %buf2 = alloca [96 x i8], align 16
+  %buf3 = alloca [16 x i8], align 16
+  %buf4 = alloca [128 x i8], align 16
+  %p = getelementptr inbounds [128 x i8], [128 x i8]* %buf, i64 0, i64 0
+  %q = getelementptr inbounds [96 x i8], [96 x i8]* %buf2, i64 0, i64 0
+  %r = getelementptr inbounds [16 x i8], [16 x i8]* %buf3, i64 0, i64 0
+  %s = getelementptr inbounds [128 x i8], [128 x i8]* %buf4, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 128, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %q, i8 0, i64 96, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %r, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %s, i8 0, i64 128, i32 16, i1 false)
+  call void @use(i8* %p)
+  call void @use(i8* %q)
+  call void @use(i8* %r)
+  call void @use(i8* %s)
+  ret void
+}
+
+; Pattern inits get their own functions.
+; CHECK-LABEL: define void @c(
+; CHECK: call void @__safeinit_fill_cc_128_16(i8* %p)
+; CHECK: call void @__safeinit_fill_cc_128_16(i8* %q)
+; CHECK: ret void
+define void @c() {
+  %buf = alloca [128 x i8], align 16
+  %buf2 = alloca [128 x i8], align 16
+  %p = getelementptr inbounds [128 x i8], [128 x i8]* %buf, i64 0, i64 0
+  %q = getelementptr inbounds [128 x i8], [128 x i8]* %buf2, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 -52, i64 128, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %q, i8 -52, i64 128, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  call void @use(i8* %q)
+  ret void
+}
+
+; CHECK: define linkonce_odr hidden void @__safeinit_zero_128_16(i8* nocapture) unnamed_addr [[ATTRS:#[0-9]+]] comdat {
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %0, i8 0, i64 128, i32 16, i1 false)
+; CHECK-NEXT: ret void
+; CHECK: define linkonce_odr hidden void @__safeinit_fill_cc_128_16(i8* nocapture) unnamed_addr [[ATTRS]] comdat {
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %0, i8 -52, i64 128, i32 16, i1 false)
+; CHECK-NEXT: ret void
+; CHECK: attributes [[ATTRS]] = { noinline nounwind }
+; OFF-NOT: __safeinit_zero
+
+!0 = !{}
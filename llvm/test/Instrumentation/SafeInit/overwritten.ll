@@ -0,0 +1,76 @@
+; Test that allocas which are fully overwritten before any read aren't
+; initialized.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -passes=safeinit -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%pair = type { i32, i32 }
+
+declare void @use(i8*)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture readonly, i64, i32, i1)
+
+; Both fields are stored before the struct escapes.
+define void @all_fields(i32 %a, i32 %b) {
+; CHECK-LABEL: define void @all_fields(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %p = alloca %pair, align 4
+  %f0 = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  store i32 %a, i32* %f0, align 4
+  %f1 = getelementptr inbounds %pair, %pair* %p, i64 0, i32 1
+  store i32 %b, i32* %f1, align 4
+  %raw = bitcast %pair* %p to i8*
+  call void @use(i8* %raw)
+  ret void
+}
+
+; Only the first field is stored, so the second one could be read by @use.
+define void @one_field(i32 %a) {
+; CHECK-LABEL: define void @one_field(
+; CHECK: %[[GAP:[^ ]+]] = getelementptr inbounds i8, i8* %{{[^ ]+}}, i64 4
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %[[GAP]], i8 0, i64 4, i32 4, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %p = alloca %pair, align 4
+  %f0 = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  store i32 %a, i32* %f0, align 4
+  %raw = bitcast %pair* %p to i8*
+  call void @use(i8* %raw)
+  ret void
+}
+
+; A memcpy covering the whole buffer, across a straight-line branch.
+define void @memcpy_dest(i8* %src) {
+; CHECK-LABEL: define void @memcpy_dest(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %buf = alloca [64 x i8], align 16
+  %raw = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  br label %next
+
+next:
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %raw, i8* %src, i64 64, i32 1, i1 false)
+  call void @use(i8* %raw)
+  ret void
+}
+
+; The pointer escapes before the second store, so the call in between could
+; read the uninitialized half.
+define void @escape_first(i32 %a, i32 %b, i32** %out) {
+; CHECK-LABEL: define void @escape_first(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 4, i32 4, i1 false), !stackzeroinit
+entry:
+  %p = alloca %pair, align 4
+  %f0 = getelementptr inbounds %pair, %pair* %p, i64 0, i32 0
+  store i32* %f0, i32** %out, align 8
+  store i32 %a, i32* %f0, align 4
+  call void @use(i8* null)
+  %f1 = getelementptr inbounds %pair, %pair* %p, i64 0, i32 1
+  store i32 %b, i32* %f1, align 4
+  ret void
+}
@@ -0,0 +1,40 @@
+; Test that SafeInit only initializes the bytes of an alloca which aren't
+; overwritten before they can be read.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_MAXPARTIALRANGES=1 -S | FileCheck %s --check-prefix=FULL
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%hdr = type { i8, i32, i64, i16 }
+
+declare void @use(i8*)
+
+; Every field is stored, leaving only the padding after the i8 and the tail
+; padding after the i16.
+define void @padding(i8 %a, i32 %b, i64 %c, i16 %d) {
+; CHECK-LABEL: define void @padding(
+; CHECK: %[[RAW:[^ ]+]] = bitcast %hdr* %h to i8*
+; CHECK: %[[P1:[^ ]+]] = getelementptr inbounds i8, i8* %[[RAW]], i64 1
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %[[P1]], i8 0, i64 3, i32 1, i1 false), !stackzeroinit
+; CHECK: %[[P2:[^ ]+]] = getelementptr inbounds i8, i8* %[[RAW]], i64 18
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %[[P2]], i8 0, i64 6, i32 2, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+
+; FULL-LABEL: define void @padding(
+; FULL: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 24, i32 8, i1 false), !stackzeroinit
+entry:
+  %h = alloca %hdr, align 8
+  %f0 = getelementptr inbounds %hdr, %hdr* %h, i64 0, i32 0
+  store i8 %a, i8* %f0, align 8
+  %f1 = getelementptr inbounds %hdr, %hdr* %h, i64 0, i32 1
+  store i32 %b, i32* %f1, align 4
+  %f2 = getelementptr inbounds %hdr, %hdr* %h, i64 0, i32 2
+  store i64 %c, i64* %f2, align 8
+  %f3 = getelementptr inbounds %hdr, %hdr* %h, i64 0, i32 3
+  store i16 %d, i16* %f3, align 8
+  %raw = bitcast %hdr* %h to i8*
+  call void @use(i8* %raw)
+  ret void
+}
@@ -0,0 +1,39 @@
+; Test pattern-init mode, where the malloc-fill-byte module flag gives the
+; byte allocas are filled with.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -malloc-fill-byte=0 -S | FileCheck %s --check-prefix=ZERO
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+; CHECK-LABEL: define void @fill(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{[0-9]+}}, i8 -52, i64 16, i32 16, i1 false), !stackzeroinit
+; ZERO-LABEL: define void @fill(
+; ZERO: call void @llvm.memset.p0i8.i64(i8* %{{[0-9]+}}, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+define void @fill() {
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+; The frame is only ever cleared to zero, so the "frame" policy doesn't
+; stop us filling the static allocas.
+; CHECK-LABEL: define void @frame(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{[0-9]+}}, i8 -52, i64 16, i32 16, i1 false), !stackzeroinit
+; ZERO-LABEL: define void @frame(
+; ZERO-NOT: @llvm.memset
+; ZERO: ret void
+define void @frame() #0 {
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+attributes #0 = { "safeinit-policy"="frame" }
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 2, !"malloc-fill-byte", i32 204}
@@ -0,0 +1,42 @@
+; Where X86FrameInit can't clear the frame, "frame" and "dynamic" policies
+; (and -STACKZEROINIT_DYNONLY) fall back to initializing static allocas in IR.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_DYNONLY -S | FileCheck %s --check-prefix=DYNONLY
+
+target datalayout = "e-m:e-p:32:32-f64:32:64-f80:32-n8:16:32-S128"
+target triple = "i386-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+; CHECK-LABEL: define void @frame(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+define void @frame() #0 {
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i32 0, i32 0
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK-LABEL: define void @dynamic(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+define void @dynamic() #1 {
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i32 0, i32 0
+  call void @use(i8* %p)
+  ret void
+}
+
+; DYNONLY-LABEL: define void @global(
+; DYNONLY: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+; DYNONLY: ret void
+define void @global() {
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i32 0, i32 0
+  call void @use(i8* %p)
+  ret void
+}
+
+attributes #0 = { "safeinit-policy"="frame" }
+attributes #1 = { "safeinit-policy"="dynamic" }
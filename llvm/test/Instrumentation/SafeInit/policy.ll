@@ -0,0 +1,65 @@
+; Test the per-function "safeinit-policy" attribute.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_DYNONLY -S | FileCheck %s --check-prefix=DYNONLY
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+; CHECK-LABEL: define void @none(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @none(i64 %n) #0 {
+  %buf = alloca [16 x i8], align 16
+  %vla = alloca i8, i64 %n, align 1
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  call void @use(i8* %vla)
+  ret void
+}
+
+; CHECK-LABEL: define void @frame(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @frame(i64 %n) #1 {
+  %buf = alloca [16 x i8], align 16
+  %vla = alloca i8, i64 %n, align 1
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  call void @use(i8* %vla)
+  ret void
+}
+
+; CHECK-LABEL: define void @dynamic(
+; CHECK-NOT: i64 16, i32 16
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 {{.*}}, i32 1, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @dynamic(i64 %n) #2 {
+  %buf = alloca [16 x i8], align 16
+  %vla = alloca i8, i64 %n, align 1
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  call void @use(i8* %vla)
+  ret void
+}
+
+; "ir" overrides a global -STACKZEROINIT_DYNONLY.
+; DYNONLY-LABEL: define void @ir(
+; DYNONLY: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+; DYNONLY: call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 {{.*}}, i32 1, i1 false), !stackzeroinit
+; DYNONLY: ret void
+define void @ir(i64 %n) #3 {
+  %buf = alloca [16 x i8], align 16
+  %vla = alloca i8, i64 %n, align 1
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  call void @use(i8* %vla)
+  ret void
+}
+
+attributes #0 = { "safeinit-policy"="none" }
+attributes #1 = { "safeinit-policy"="frame" }
+attributes #2 = { "safeinit-policy"="dynamic" }
+attributes #3 = { "safeinit-policy"="ir" }
@@ -0,0 +1,61 @@
+; Test choosing per-function policies from a SafeInit init-cost profile.
+; RUN: opt < %s -safeinit -STACKZEROINIT_PROFILE=%S/Inputs/profile.txt -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+; Many small hot inits: left to the frame
+; CHECK: define void @hot_small() [[FRAME:#[0-9]+]]
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @hot_small() {
+  %a = alloca [16 x i8], align 16
+  %b = alloca [32 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %a, i64 0, i64 0
+  %q = getelementptr inbounds [32 x i8], [32 x i8]* %b, i64 0, i64 0
+  call void @use(i8* %p)
+  call void @use(i8* %q)
+  ret void
+}
+
+; A big hot buffer: memsets
+; CHECK: define void @hot_big() [[IR:#[0-9]+]]
+; CHECK: call void @llvm.memset
+define void @hot_big() {
+  %a = alloca [4096 x i8], align 16
+  %p = getelementptr inbounds [4096 x i8], [4096 x i8]* %a, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+; Too cold to matter, or no stack inits: global options
+; CHECK: define void @cold() {
+; CHECK: call void @llvm.memset
+define void @cold() {
+  %a = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %a, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK: define void @heap_only() {
+define void @heap_only() {
+  ret void
+}
+
+; An explicit policy wins
+; CHECK: define void @pinned() [[PINNED:#[0-9]+]]
+; CHECK: call void @llvm.memset
+define void @pinned() #0 {
+  %a = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %a, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+attributes #0 = { "safeinit-policy"="ir" }
+
+; CHECK-DAG: attributes [[FRAME]] = { "safeinit-policy"="frame" }
+; CHECK-DAG: attributes [[IR]] = { "safeinit-policy"="ir" }
@@ -0,0 +1,32 @@
+; Test that SafeInit raises the alignment of larger allocas to the vector
+; register width (bounded by the stack alignment) for their inits.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_ALIGNTHRESHOLD=0 -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+define void @big() {
+; CHECK-LABEL: define void @big(
+; CHECK: %buf = alloca [256 x i8], align 16
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+; OFF-LABEL: define void @big(
+; OFF: %buf = alloca [256 x i8], align 1
+; OFF: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 1, i1 false), !stackzeroinit
+  %buf = alloca [256 x i8], align 1
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @small() {
+; CHECK-LABEL: define void @small(
+; CHECK: %buf = alloca [32 x i8], align 1
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 32, i32 1, i1 false), !stackzeroinit
+  %buf = alloca [32 x i8], align 1
+  %p = getelementptr inbounds [32 x i8], [32 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
@@ -0,0 +1,99 @@
+; Test placing the inits of inlined allocas again at the level of the caller.
+; RUN: opt < %s -safeinit-hoist-lifetimes -safeinit -STACKZEROINIT_REPLACE -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.lifetime.start(i64, i8* nocapture)
+declare void @llvm.lifetime.end(i64, i8* nocapture)
+
+; A callee's buffer, inlined into a loop: its lifetime is hoisted out of the
+; loop, and its init with it.
+define void @in_loop(i32 %n) {
+; CHECK-LABEL: define void @in_loop(
+entry:
+  %buf.i = alloca [64 x i8], align 16
+  br label %loop.ph
+
+; CHECK: loop.ph:
+; CHECK: call void @llvm.lifetime.start(i64 64
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 64, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: br label %loop
+loop.ph:
+  br label %loop
+
+; CHECK: loop:
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+loop:
+  %i = phi i32 [ 0, %loop.ph ], [ %i.next, %loop ]
+  %p.i = getelementptr inbounds [64 x i8], [64 x i8]* %buf.i, i64 0, i64 0
+  call void @llvm.lifetime.start(i64 64, i8* %p.i)
+  call void @llvm.memset.p0i8.i64(i8* %p.i, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p.i)
+  call void @llvm.lifetime.end(i64 64, i8* %p.i)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret void
+}
+
+; Two inlined callees' buffers merged into one slot: a single init covers
+; both.
+define void @merged() {
+; CHECK-LABEL: define void @merged(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 64, i32 16, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %buf.i = alloca [64 x i8], align 16
+  %p.i = getelementptr inbounds [64 x i8], [64 x i8]* %buf.i, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p.i, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p.i)
+  %p.i2 = getelementptr inbounds [64 x i8], [64 x i8]* %buf.i, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p.i2, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p.i2)
+  ret void
+}
+
+; Allocas with partial inits keep them where they are.
+define void @partial(i32 %n) {
+; CHECK-LABEL: define void @partial(
+; CHECK: loop:
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 32, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+entry:
+  %buf.i = alloca [64 x i8], align 16
+  %p.i = getelementptr inbounds [64 x i8], [64 x i8]* %buf.i, i64 0, i64 0
+  %q.i = getelementptr inbounds [64 x i8], [64 x i8]* %buf.i, i64 0, i64 32
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.memset.p0i8.i64(i8* %q.i, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p.i)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret void
+}
+
+; Allocas without inits (left alone the first time) get none.
+define void @none() {
+; CHECK-LABEL: define void @none(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+entry:
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,149 @@
+; Test clearing loop-scoped buffers only up to what earlier iterations stored.
+; RUN: opt < %s -safeinit-hoist-lifetimes -safeinit -STACKZEROINIT_RESETREGIONS -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @llvm.lifetime.start(i64, i8* nocapture) nounwind
+declare void @llvm.lifetime.end(i64, i8* nocapture) nounwind
+declare void @use(i8*)
+declare void @consume(i8)
+
+; A parse buffer which each iteration fills a prefix of: the mark is raised
+; to the end of the prefix before the inner loop, and only that much is
+; cleared at the top of the next iteration.
+define void @prefix(i32 %n, i64 %len) {
+; CHECK-LABEL: define void @prefix(
+; CHECK: %safeinit.hwm = alloca i64, !no_zeroinit
+entry:
+  %buf = alloca [4096 x i8], align 16
+  br label %loop.ph
+
+; CHECK: loop.ph:
+; CHECK: store i64 4096, i64* %safeinit.hwm
+; CHECK: call void @llvm.lifetime.start(i64 4096
+; CHECK-NEXT: br label %loop
+loop.ph:
+  br label %loop
+
+; CHECK: loop:
+; CHECK: [[HWM:%.*]] = load i64, i64* %safeinit.hwm
+; CHECK: [[CMP:%.*]] = icmp ult i64 [[HWM]], 4096
+; CHECK: [[LEN:%.*]] = select i1 [[CMP]], i64 [[HWM]], i64 4096
+; CHECK: call void @llvm.memset.p0i8.i64(i8* {{.*}}, i8 0, i64 [[LEN]], i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: store i64 0, i64* %safeinit.hwm
+; CHECK-NOT: @llvm.lifetime
+loop:
+  %i = phi i32 [ 0, %loop.ph ], [ %i.next, %latch ]
+  %p = getelementptr inbounds [4096 x i8], [4096 x i8]* %buf, i64 0, i64 0
+  call void @llvm.lifetime.start(i64 4096, i8* %p)
+  br label %fill.ph
+
+; CHECK: fill.ph:
+; CHECK: [[OLD:%.*]] = load i64, i64* %safeinit.hwm
+; CHECK: [[GT:%.*]] = icmp ugt i64 [[END:%.*]], [[OLD]]
+; CHECK: [[NEW:%.*]] = select i1 [[GT]], i64 [[END]], i64 [[OLD]]
+; CHECK: store i64 [[NEW]], i64* %safeinit.hwm
+; CHECK-NEXT: br label %fill
+fill.ph:
+  br label %fill
+
+; CHECK: fill:
+; CHECK-NOT: %safeinit.hwm
+; CHECK: latch:
+fill:
+  %j = phi i64 [ 0, %fill.ph ], [ %j.next, %fill ]
+  %q = getelementptr inbounds [4096 x i8], [4096 x i8]* %buf, i64 0, i64 %j
+  store i8 1, i8* %q, align 1
+  %j.next = add nuw nsw i64 %j, 1
+  %more = icmp ult i64 %j.next, %len
+  br i1 %more, label %fill, label %latch
+
+; CHECK-NOT: @llvm.lifetime
+; CHECK: br i1
+latch:
+  %v = load i8, i8* %p, align 16
+  call void @consume(i8 %v)
+  call void @llvm.lifetime.end(i64 4096, i8* %p)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+; CHECK: exit:
+; CHECK: call void @llvm.lifetime.end(i64 4096
+exit:
+  ret void
+}
+
+; Stores at constant offsets set the mark as it's reset; other stores in the
+; loop raise it as they happen.
+define i64 @fields(i32 %n, i64 %k) {
+; CHECK-LABEL: define i64 @fields(
+entry:
+  %buf = alloca [64 x i64], align 16
+  br label %loop
+
+; CHECK: loop:
+; CHECK: call void @llvm.memset.p0i8.i64(i8* {{.*}}, i8 0, i64 {{.*}}, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: store i64 16, i64* %safeinit.hwm
+; CHECK: store i64 %s, i64* %c, align 8
+; CHECK-NEXT: [[PTR:%.*]] = ptrtoint i64* %c to i64
+; CHECK-NEXT: [[BASE:%.*]] = ptrtoint [64 x i64]* %buf to i64
+; CHECK-NEXT: [[OFF:%.*]] = sub i64 [[PTR]], [[BASE]]
+; CHECK-NEXT: [[END:%.*]] = add i64 [[OFF]], 8
+; CHECK-NEXT: [[OLD:%.*]] = load i64, i64* %safeinit.hwm
+; CHECK-NEXT: [[GT:%.*]] = icmp ugt i64 [[END]], [[OLD]]
+; CHECK-NEXT: [[NEW:%.*]] = select i1 [[GT]], i64 [[END]], i64 [[OLD]]
+; CHECK-NEXT: store i64 [[NEW]], i64* %safeinit.hwm
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %sum = phi i64 [ 0, %entry ], [ %sum.next, %loop ]
+  %p = bitcast [64 x i64]* %buf to i8*
+  call void @llvm.lifetime.start(i64 512, i8* %p)
+  %a = getelementptr inbounds [64 x i64], [64 x i64]* %buf, i64 0, i64 0
+  %b = getelementptr inbounds [64 x i64], [64 x i64]* %buf, i64 0, i64 1
+  %c = getelementptr inbounds [64 x i64], [64 x i64]* %buf, i64 0, i64 %k
+  %s = sext i32 %i to i64
+  store i64 %s, i64* %a, align 16
+  store i64 %sum, i64* %b, align 8
+  store i64 %s, i64* %c, align 8
+  %x = load i64, i64* %b, align 8
+  %sum.next = add i64 %sum, %x
+  call void @llvm.lifetime.end(i64 512, i8* %p)
+  %i.next = add i32 %i, 1
+  %cmp = icmp slt i32 %i.next, %n
+  br i1 %cmp, label %loop, label %exit
+
+exit:
+  ret i64 %sum
+}
+
+; A buffer which escapes is hoisted and initialized once, as usual.
+define void @escapes(i32 %n) {
+; CHECK-LABEL: define void @escapes(
+; CHECK-NOT: %safeinit.hwm
+; CHECK: call void @llvm.lifetime.start(i64 4096
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: br label %loop
+; CHECK-NOT: %safeinit.hwm
+; CHECK: ret void
+entry:
+  %buf = alloca [4096 x i8], align 16
+  br label %loop.ph
+
+loop.ph:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %loop.ph ], [ %i.next, %loop ]
+  %p = getelementptr inbounds [4096 x i8], [4096 x i8]* %buf, i64 0, i64 0
+  call void @llvm.lifetime.start(i64 4096, i8* %p)
+  call void @use(i8* %p)
+  call void @llvm.lifetime.end(i64 4096, i8* %p)
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret void
+}
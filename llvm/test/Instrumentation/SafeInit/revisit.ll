@@ -0,0 +1,54 @@
+; Test that existing inits are shrunk when revisited with callee summaries
+; which weren't available when they were added.
+; RUN: opt < %s -safeinit -STACKZEROINIT_REVISIT -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @init_buf(i8* "safeinit-initializes"="16")
+declare void @init_half(i8* "safeinit-initializes"="8")
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+define void @full() {
+; CHECK-LABEL: define void @full(
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  %m = bitcast [16 x i8]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @init_buf(i8* %p)
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @half() {
+; CHECK-LABEL: define void @half(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 8, i32 8, i1 false), !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  %m = bitcast [16 x i8]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @init_half(i8* %p)
+  call void @use(i8* %p)
+  ret void
+}
+
+; Not our memset, so it stays.
+define void @user() {
+; CHECK-LABEL: define void @user(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 16, i32 16, i1 false)
+; CHECK: ret void
+  %buf = alloca [16 x i8], align 16
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  %m = bitcast [16 x i8]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 16, i32 16, i1 false)
+  call void @init_buf(i8* %p)
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,18 @@
+; Test that the pipeline which utils/safeinit-stress-bench.py times survives
+; llvm-stress -safeinit functions.
+; RUN: llvm-stress -safeinit -size=400 -allocas=32 -seed=1 -o %t.ll
+; RUN: FileCheck %s < %t.ll
+; RUN: opt -safeinit -basicaa -dse -gvn -verify -disable-output %t.ll
+; RUN: llvm-stress -safeinit -size=400 -allocas=32 -seed=2 \
+; RUN:   | opt -safeinit-hoist-lifetimes -safeinit -basicaa -dse -gvn -verify -disable-output
+
+; CHECK: define void @autogen_SD1(
+; CHECK-DAG: alloca [{{[0-9]+}} x i{{8|32|64}}]
+; CHECK-DAG: alloca i8, i64 %size
+; CHECK-DAG: call void @llvm.lifetime.start(
+; CHECK-DAG: call void @llvm.memset.p0i8.i64(
+; CHECK-DAG: call void @llvm.memcpy.p0i8.p0i8.i64(
+; CHECK-DAG: call void @use(
+; CHECK-DAG: br i1 {{.*}}, label %SI{{[0-9]*}}, label %SI
+; CHECK: exit:
+; CHECK-NEXT: ret void
@@ -0,0 +1,106 @@
+; Test the init-insensitive use analysis for buffers which are only written,
+; or only read as strings.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%struct._IO_FILE = type opaque
+
+declare i8* @strcpy(i8*, i8*)
+declare i8* @strncpy(i8*, i8*, i64)
+declare i8* @fgets(i8*, i32, %struct._IO_FILE*)
+declare i64 @strlen(i8*)
+declare i32 @printf(i8*, ...)
+declare i64 @read(i32, i8*, i64)
+declare i64 @recv(i32, i8*, i64, i32)
+declare i64 @write(i32, i8*, i64)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; Copying a string in and printing it only needs the first byte initialized.
+define void @copy_and_print(i8* %s) {
+; CHECK-LABEL: define void @copy_and_print(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 1, i32 16, i1 false), !stackzeroinit
+entry:
+  %buf = alloca [128 x i8], align 16
+  %p = getelementptr inbounds [128 x i8], [128 x i8]* %buf, i64 0, i64 0
+  %d = call i8* @strcpy(i8* %p, i8* %s)
+  %n = call i32 (i8*, ...) @printf(i8* %d)
+  ret void
+}
+
+; Buffers which are only ever written don't need any init.
+define void @write_only(i32 %fd) {
+; CHECK-LABEL: define void @write_only(
+; CHECK-NOT: !stackzeroinit
+; CHECK: ret void
+entry:
+  %buf = alloca [4096 x i8], align 16
+  %p = getelementptr inbounds [4096 x i8], [4096 x i8]* %buf, i64 0, i64 0
+  %r1 = call i64 @read(i32 %fd, i8* %p, i64 4096)
+  %r2 = call i64 @recv(i32 %fd, i8* %p, i64 4096, i32 0)
+  store i8 0, i8* %p
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 1, i64 16, i32 16, i1 false)
+  ret void
+}
+
+; read() doesn't terminate what it reads, so strlen() could run past it into
+; the rest of the buffer: it gets a full init.
+define i64 @read_string(i32 %fd) {
+; CHECK-LABEL: define i64 @read_string(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 256, i32 16, i1 false), !stackzeroinit
+entry:
+  %buf = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  %r = call i64 @read(i32 %fd, i8* %p, i64 255)
+  %l = call i64 @strlen(i8* %p)
+  ret i64 %l
+}
+
+; Neither does strncpy(), nor a store.
+define i64 @strncpy_string(i8* %s) {
+; CHECK-LABEL: define i64 @strncpy_string(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 32, i32 16, i1 false), !stackzeroinit
+entry:
+  %buf = alloca [32 x i8], align 16
+  %p = getelementptr inbounds [32 x i8], [32 x i8]* %buf, i64 0, i64 0
+  %d = call i8* @strncpy(i8* %p, i8* %s, i64 31)
+  %l = call i64 @strlen(i8* %p)
+  ret i64 %l
+}
+
+; (The store covers the first byte, so only the rest is left.)
+define i64 @store_string() {
+; CHECK-LABEL: define i64 @store_string(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 31, i32 1, i1 false), !stackzeroinit
+entry:
+  %buf = alloca [32 x i8], align 16
+  %p = getelementptr inbounds [32 x i8], [32 x i8]* %buf, i64 0, i64 0
+  store i8 65, i8* %p
+  %l = call i64 @strlen(i8* %p)
+  ret i64 %l
+}
+
+; fgets() does terminate the line it reads.
+define i64 @fgets_string(%struct._IO_FILE* %f) {
+; CHECK-LABEL: define i64 @fgets_string(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 1, i32 16, i1 false), !stackzeroinit
+entry:
+  %buf = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  %r = call i8* @fgets(i8* %p, i32 256, %struct._IO_FILE* %f)
+  %l = call i64 @strlen(i8* %r)
+  ret i64 %l
+}
+
+; write() reads a fixed number of bytes, regardless of any terminator.
+define void @not_a_string(i32 %fd, i8* %s) {
+; CHECK-LABEL: define void @not_a_string(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 64, i32 16, i1 false), !stackzeroinit
+entry:
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  %d = call i8* @strcpy(i8* %p, i8* %s)
+  %r = call i64 @write(i32 %fd, i8* %p, i64 64)
+  ret void
+}
@@ -0,0 +1,39 @@
+; Test the SafeInit part of -time-passes.
+; RUN: opt < %s -safeinit -STACKZEROINIT_TYPEDSTOREMAXSIZE=0 -dse -time-passes -disable-output 2>&1 | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_TYPEDSTOREMAXSIZE=0 -dse -time-passes -safeinit-time-report-functions=0 -disable-output 2>&1 | FileCheck %s --check-prefix=NONE
+
+; CHECK-DAG: SafeInit insertion point search
+; CHECK-DAG: MemDep queries for SafeInit memsets
+; CHECK-DAG: SafeInit time by function (top 2)
+; CHECK-DAG: Total: {{.*}} seconds in 2 functions
+; CHECK-DAG: {{%\)  }}first{{$}}
+; CHECK-DAG: {{%\)  }}second{{$}}
+; NONE: SafeInit time by function (top 0)
+; NONE-NOT: {{%\)  }}first
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+
+define void @first() {
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @second(i1 %c) {
+entry:
+  %x = alloca i64, align 8
+  br i1 %c, label %set, label %done
+
+set:
+  store i64 1, i64* %x, align 8
+  br label %done
+
+done:
+  %p = bitcast i64* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
@@ -0,0 +1,73 @@
+; Test that the tracker adds counters for each remaining zero-init memset,
+; which count its executions, bytes and cache lines, and registers them.
+; RUN: opt < %s -safeinittracker -ZEROINITCHECKER_COUNTERS -S | FileCheck %s
+; RUN: opt < %s -safeinittracker -S | FileCheck %s --check-prefix=NOCOUNT
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.memset.p0i8.i32(i8* nocapture, i8, i32, i32, i1)
+
+; Three counters per memset, kinds 5, 7 and 8 (stack, bytes, lines) or 6, 7
+; and 8 (heap, bytes, lines)
+; CHECK: = internal global { i8*, i32, [6 x [2 x i8*]] } { i8* null, i32 6, [6 x [2 x i8*]] [
+; CHECK-SAME: [2 x i8*] [i8* null, i8* inttoptr (i64 5764607523034234880 to i8*)],
+; CHECK-SAME: [2 x i8*] [i8* null, i8* inttoptr (i64 8070450532247928832 to i8*)],
+; CHECK-SAME: [2 x i8*] [i8* null, i8* inttoptr (i64 -9223372036854775808 to i8*)],
+; CHECK-SAME: [2 x i8*] [i8* null, i8* inttoptr (i64 6917529027641081856 to i8*)],
+; CHECK-SAME: [2 x i8*] [i8* null, i8* inttoptr (i64 8070450532247928832 to i8*)],
+; CHECK-SAME: [2 x i8*] [i8* null, i8* inttoptr (i64 -9223372036854775808 to i8*)]] }
+; CHECK: @llvm.global_ctors
+; NOCOUNT-NOT: __sanitizer_stat
+
+define void @stack(i32 %n) {
+; CHECK-LABEL: define void @stack(
+; CHECK: %[[LEN:[0-9]+]] = zext i32 %n to i64
+; CHECK-NEXT: %[[DEST:[0-9]+]] = ptrtoint i8* %buf to i64
+; CHECK-NEXT: %[[OFF:[0-9]+]] = and i64 %[[DEST]], 63
+; CHECK-NEXT: %[[LEN63:[0-9]+]] = add i64 %[[LEN]], 63
+; CHECK-NEXT: %[[END:[0-9]+]] = add i64 %[[OFF]], %[[LEN63]]
+; CHECK-NEXT: %[[LINES:[0-9]+]] = lshr i64 %[[END]], 6
+; CHECK-NEXT: %[[EMPTY:[0-9]+]] = icmp eq i64 %[[LEN]], 0
+; CHECK-NEXT: %[[NLINES:[0-9]+]] = select i1 %[[EMPTY]], i64 0, i64 %[[LINES]]
+; CHECK-NEXT: call void @__sanitizer_stat_report(i8* {{.*}}i64 0)
+; CHECK: store i64 %{{[0-9]+}}, i64* bitcast
+; CHECK: add i64 %{{[0-9]+}}, %[[LEN]]
+; CHECK-NEXT: store
+; CHECK: add i64 %{{[0-9]+}}, %[[NLINES]]
+; CHECK-NEXT: store
+; CHECK-NEXT: call void @llvm.memset.p0i8.i32
+  %buf = alloca i8, i32 %n, align 16
+  call void @llvm.memset.p0i8.i32(i8* %buf, i8 0, i32 %n, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %buf)
+  ret void
+}
+
+; A constant size leaves only the start's offset in its line to work out.
+define void @heap(i8* %p) {
+; CHECK-LABEL: define void @heap(
+; CHECK: %[[DEST:[0-9]+]] = ptrtoint i8* %p to i64
+; CHECK-NEXT: %[[OFF:[0-9]+]] = and i64 %[[DEST]], 63
+; CHECK-NEXT: %[[END:[0-9]+]] = add i64 %[[OFF]], 79
+; CHECK-NEXT: %[[LINES:[0-9]+]] = lshr i64 %[[END]], 6
+; CHECK-NEXT: call void @__sanitizer_stat_report(i8* {{.*}}i64 3)
+; CHECK: add i64 %{{[0-9]+}}, 16
+; CHECK-NEXT: store
+; CHECK: add i64 %{{[0-9]+}}, %[[LINES]]
+; CHECK-NEXT: store
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %p, i8 1
+; CHECK-NEXT: ret void
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !heapzeroinit !0
+  call void @use(i8* %p)
+  ; not ours, so not counted
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 1, i64 16, i32 16, i1 false)
+  ret void
+}
+
+; CHECK: define internal void @{{[0-9]+}}()
+; CHECK-NEXT: call void @__sanitizer_stat_init
+
+!0 = !{}
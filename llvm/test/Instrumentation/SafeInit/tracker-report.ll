@@ -0,0 +1,101 @@
+; Test that the tracker reports each remaining zero-init memset, with its
+; location, size, loop depth and frequency, the costliest first.
+; RUN: opt < %s -safeinittracker -ZEROINITCHECKER_REPORT=- -disable-output | FileCheck %s
+; RUN: opt < %s -passes=safeinittracker -ZEROINITCHECKER_REPORT=- -disable-output | FileCheck %s
+; RUN: opt < %s -safeinittracker -disable-output | FileCheck %s --allow-empty --check-prefix=NOREPORT
+
+; NOREPORT-NOT: ZeroInit
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; About 128 iterations of 64 bytes, so it comes first.
+; CHECK:      --- !ZeroInit
+; CHECK-NEXT: Pass:            safeinittracker
+; CHECK-NEXT: Name:            StackZeroInit
+; CHECK-NEXT: Function:        'in_loop'
+; CHECK-NEXT: Size:            64
+; CHECK-NEXT: LoopDepth:       1
+; CHECK-NEXT: BlockFrequency:  {{[0-9.e+]+}}
+; CHECK-NEXT: EstimatedCost:   {{[0-9.e+]+}}
+; CHECK-NEXT: ...
+define void @in_loop(i64 %n) {
+entry:
+  %buf = alloca [64 x i8], align 16
+  %m = bitcast [64 x i8]* %buf to i8*
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %m)
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop, !prof !1
+
+exit:
+  ret void
+}
+
+; CHECK:      --- !ZeroInit
+; CHECK-NEXT: Pass:            safeinittracker
+; CHECK-NEXT: Name:            StackZeroInit
+; CHECK-NEXT: DebugLoc:        { File: 't.c', Line: 3, Column: 8 }
+; CHECK-NEXT: Function:        'big'
+; CHECK-NEXT: Size:            4096
+; CHECK-NEXT: LoopDepth:       0
+; CHECK-NEXT: BlockFrequency:  1
+; CHECK-NEXT: EstimatedCost:   4096
+; CHECK-NEXT: ...
+define void @big() !dbg !12 {
+  %buf = alloca [4096 x i8], align 16
+  %m = bitcast [4096 x i8]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0, !dbg !14
+  call void @use(i8* %m)
+  ret void
+}
+
+; Non-constant sizes are reported as such, and costed at 1024 bytes.
+; CHECK:      --- !ZeroInit
+; CHECK-NEXT: Pass:            safeinittracker
+; CHECK-NEXT: Name:            StackZeroInit
+; CHECK-NEXT: Function:        'vla'
+; CHECK-NEXT: Size:            '%n'
+; CHECK-NEXT: LoopDepth:       0
+; CHECK-NEXT: BlockFrequency:  1
+; CHECK-NEXT: EstimatedCost:   1024
+; CHECK-NEXT: ...
+define void @vla(i64 %n) {
+  %buf = alloca i8, i64 %n, align 16
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %n, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %buf)
+  ret void
+}
+
+; CHECK:      --- !ZeroInit
+; CHECK-NEXT: Pass:            safeinittracker
+; CHECK-NEXT: Name:            HeapZeroInit
+; CHECK-NEXT: Function:        'heap'
+; CHECK-NEXT: Size:            16
+; CHECK:      ...
+; CHECK-NOT:  ZeroInit
+define void @heap(i8* %p) {
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !heapzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+!llvm.dbg.cu = !{!10}
+!llvm.module.flags = !{!15}
+
+!0 = !{}
+!1 = !{!"branch_weights", i32 1, i32 127}
+!10 = distinct !DICompileUnit(language: DW_LANG_C99, file: !11, producer: "clang", isOptimized: true, emissionKind: FullDebug)
+!11 = !DIFile(filename: "t.c", directory: "/tmp")
+!12 = distinct !DISubprogram(name: "big", scope: !11, file: !11, line: 1, type: !13, isLocal: false, isDefinition: true, unit: !10)
+!13 = !DISubroutineType(types: !{})
+!14 = !DILocation(line: 3, column: 8, scope: !12)
+!15 = !{i32 2, !"Debug Info Version", i32 3}
@@ -0,0 +1,88 @@
+; Test that small allocas of first-class type are initialized with a store of
+; the whole type rather than a memset.
+; RUN: opt < %s -safeinit -S | FileCheck %s
+; RUN: opt < %s -safeinit -STACKZEROINIT_TYPEDSTOREMAXSIZE=0 -S | FileCheck %s --check-prefix=OFF
+; RUN: opt < %s -safeinit -STACKZEROINIT_POISONINIT -S | FileCheck %s --check-prefix=PATTERN
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%pair = type { i32, i32 }
+%padded = type { i8, i32 }
+
+declare void @use(i8*)
+
+define void @scalar() {
+; CHECK-LABEL: define void @scalar(
+; CHECK: store i32 0, i32* %x, align 4, !stackzeroinit
+; CHECK-NOT: @llvm.memset
+; OFF-LABEL: define void @scalar(
+; OFF: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 4, i32 4, i1 false), !stackzeroinit
+; PATTERN-LABEL: define void @scalar(
+; PATTERN: store i32 -858993460, i32* %x, align 4, !stackzeroinit
+  %x = alloca i32, align 4
+  %p = bitcast i32* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @pointer() {
+; CHECK-LABEL: define void @pointer(
+; CHECK: store i8* null, i8** %x, align 8, !stackzeroinit
+; PATTERN-LABEL: define void @pointer(
+; PATTERN: store i8* inttoptr (i64 -3689348814741910324 to i8*), i8** %x, align 8, !stackzeroinit
+  %x = alloca i8*, align 8
+  %p = bitcast i8** %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @vector() {
+; CHECK-LABEL: define void @vector(
+; CHECK: store <4 x float> zeroinitializer, <4 x float>* %x, align 16, !stackzeroinit
+  %x = alloca <4 x float>, align 16
+  %p = bitcast <4 x float>* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+; Structs get a store when they have no padding (which the store wouldn't
+; clear); pattern inits of them keep their memset.
+define void @struct() {
+; CHECK-LABEL: define void @struct(
+; CHECK: store %pair zeroinitializer, %pair* %x, align 4, !stackzeroinit
+; PATTERN-LABEL: define void @struct(
+; PATTERN: call void @llvm.memset.p0i8.i64({{.*}}, i8 -52, i64 8, i32 4, i1 false), !stackzeroinit
+  %x = alloca %pair, align 4
+  %p = bitcast %pair* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @padded() {
+; CHECK-LABEL: define void @padded(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 8, i32 4, i1 false), !stackzeroinit
+  %x = alloca %padded, align 4
+  %p = bitcast %padded* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+; Arrays and anything over the size limit keep their memset.
+define void @array() {
+; CHECK-LABEL: define void @array(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 8, i32 4, i1 false), !stackzeroinit
+  %x = alloca [2 x i32], align 4
+  %p = bitcast [2 x i32]* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @big() {
+; CHECK-LABEL: define void @big(
+; CHECK: call void @llvm.memset.p0i8.i64({{.*}}, i8 0, i64 32, i32 32, i1 false), !stackzeroinit
+  %x = alloca <4 x i64>, align 32
+  %p = bitcast <4 x i64>* %x to i8*
+  call void @use(i8* %p)
+  ret void
+}
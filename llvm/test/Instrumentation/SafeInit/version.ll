@@ -0,0 +1,84 @@
+; Test inline fast paths for small variable-size inits.
+; RUN: opt < %s -safeinit-version -STACKZEROINIT_VERSION -S | FileCheck %s
+; RUN: opt < %s -safeinit-version -S | FileCheck %s --check-prefix=OFF
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; A size of at most 240 bytes, in 16-byte granules, is cleared with a loop
+; of vector stores, without the memset.
+; CHECK-LABEL: define void @bounded(
+; CHECK: %[[NONZERO:.*]] = icmp ne i64 %len, 0
+; CHECK: br i1 %[[NONZERO]], label %safeinit.loop, label %safeinit.cont
+; CHECK: safeinit.loop:
+; CHECK: %safeinit.offset = phi i64 [ 0, %{{.*}} ], [ %[[NEXT:.*]], %safeinit.loop ]
+; CHECK: store <16 x i8> zeroinitializer, <16 x i8>* %{{.*}}, align 16, !stackzeroinit
+; CHECK: %[[NEXT]] = add nuw i64 %safeinit.offset, 16
+; CHECK: br i1 %{{.*}}, label %safeinit.loop, label %safeinit.cont
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+; OFF-LABEL: define void @bounded(
+; OFF: @llvm.memset
+define void @bounded(i64 %n) {
+  %len = and i64 %n, 240
+  %buf = alloca i8, i64 %len, align 16
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %len, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %buf)
+  ret void
+}
+
+; An unbounded size in 8-byte granules takes the loop up to 256 bytes, and
+; the memset otherwise.
+; CHECK-LABEL: define void @versioned(
+; CHECK: %[[LENM1:.*]] = sub i64 %len, 1
+; CHECK: %[[SMALL:.*]] = icmp ult i64 %[[LENM1]], 256
+; CHECK: br i1 %[[SMALL]], label %safeinit.loop, label %safeinit.call
+; CHECK: safeinit.loop:
+; CHECK: store i64 0, i64* %{{.*}}, align 8, !stackzeroinit
+; CHECK: add nuw i64 %safeinit.offset, 8
+; CHECK: safeinit.call:
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %len, i32 16, i1 false), !stackzeroinit
+; CHECK-NEXT: br label %safeinit.cont
+; CHECK: safeinit.cont:
+; CHECK-NEXT: call void @use(i8* %buf)
+define void @versioned(i64 %n) {
+  %len = shl i64 %n, 3
+  %buf = alloca i8, i64 %len, align 16
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %len, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %buf)
+  ret void
+}
+
+; Pattern inits store the pattern.
+; CHECK-LABEL: define void @pattern(
+; CHECK: store i64 -3689348814741910324, i64* %{{.*}}, align 4, !stackzeroinit
+define void @pattern(i64 %n) {
+  %len = shl i64 %n, 3
+  %buf = alloca i8, i64 %len, align 4
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 204, i64 %len, i32 4, i1 false), !stackzeroinit !0
+  call void @use(i8* %buf)
+  ret void
+}
+
+; Byte-granular sizes, and memsets which aren't SafeInit's, are left alone.
+; CHECK-LABEL: define void @untouched(
+; CHECK-NOT: safeinit.loop
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %n, i32 16, i1 false), !stackzeroinit
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %buf2, i8 0, i64 %len, i32 16, i1 false)
+; CHECK-NOT: safeinit.loop
+; CHECK: ret void
+define void @untouched(i64 %n) {
+  %buf = alloca i8, i64 %n, align 16
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 0, i64 %n, i32 16, i1 false), !stackzeroinit !0
+  %len = shl i64 %n, 4
+  %buf2 = alloca i8, i64 %len, align 16
+  call void @llvm.memset.p0i8.i64(i8* %buf2, i8 0, i64 %len, i32 16, i1 false)
+  call void @use(i8* %buf)
+  call void @use(i8* %buf2)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,88 @@
+; RUN: opt < %s -basicaa -dse -S | FileCheck %s
+; RUN: opt < %s -basicaa -dse -malloc-returns-zero -S | FileCheck %s --check-prefix=ZERO
+
+; With a zeroing allocator, memalign and valloc return zeroed memory and
+; realloc zeroes what it adds past the old contents, so clearing that again
+; is dead.
+
+; (memalign is only a known library function on Linux)
+target triple = "x86_64-unknown-linux-gnu"
+
+declare noalias i8* @malloc(i64)
+declare noalias i8* @memalign(i64, i64)
+declare noalias i8* @valloc(i64)
+declare noalias i8* @realloc(i8*, i64)
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: @aligned(
+; CHECK: call void @llvm.memset
+; ZERO-LABEL: @aligned(
+; ZERO-NOT: call void @llvm.memset
+; ZERO: call void @use
+define void @aligned() {
+  %m = call noalias i8* @memalign(i64 64, i64 256)
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 256, i32 64, i1 false)
+  call void @use(i8* %m)
+  ret void
+}
+
+; CHECK-LABEL: @page_aligned(
+; CHECK: store i32 0
+; ZERO-LABEL: @page_aligned(
+; ZERO-NOT: store
+; ZERO: call void @use
+define void @page_aligned() {
+  %m = call noalias i8* @valloc(i64 8192)
+  %p = getelementptr i8, i8* %m, i64 4096
+  %q = bitcast i8* %p to i32*
+  store i32 0, i32* %q
+  call void @use(i8* %m)
+  ret void
+}
+
+; Only the tail past the old 16 bytes is known to be zero.
+; CHECK-LABEL: @grown(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %tail,
+; ZERO-LABEL: @grown(
+; ZERO: call void @llvm.memset.p0i8.i64(i8* %old,
+; ZERO-NOT: call void @llvm.memset
+; ZERO: call void @use
+define void @grown() {
+  %m = call noalias i8* @malloc(i64 16)
+  call void @use(i8* %m)
+  %r = call i8* @realloc(i8* %m, i64 64)
+  %old = getelementptr i8, i8* %r, i64 8
+  call void @llvm.memset.p0i8.i64(i8* %old, i8 0, i64 8, i32 8, i1 false)
+  %tail = getelementptr i8, i8* %r, i64 16
+  call void @llvm.memset.p0i8.i64(i8* %tail, i8 0, i64 48, i32 8, i1 false)
+  call void @use(i8* %r)
+  ret void
+}
+
+; realloc(NULL, n) is malloc(n).
+; CHECK-LABEL: @from_null(
+; CHECK: store i64 0
+; ZERO-LABEL: @from_null(
+; ZERO-NOT: store
+; ZERO: call void @use
+define void @from_null() {
+  %r = call i8* @realloc(i8* null, i64 64)
+  %q = bitcast i8* %r to i64*
+  store i64 0, i64* %q
+  call void @use(i8* %r)
+  ret void
+}
+
+; The old size isn't known.
+; CHECK-LABEL: @unknown_old(
+; CHECK: call void @llvm.memset
+; ZERO-LABEL: @unknown_old(
+; ZERO: call void @llvm.memset
+define void @unknown_old(i8* %m) {
+  %r = call i8* @realloc(i8* %m, i64 64)
+  %tail = getelementptr i8, i8* %r, i64 16
+  call void @llvm.memset.p0i8.i64(i8* %tail, i8 0, i64 48, i32 8, i1 false)
+  call void @use(i8* %r)
+  ret void
+}
@@ -0,0 +1,104 @@
+; RUN: opt < %s -basicaa -dse -S | FileCheck %s
+
+; An llvm.initialized marker stands for a loop storing to every byte of its
+; range, so it kills earlier memsets of that range.
+
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.initialized.p0i8.i64(i8* nocapture, i64)
+declare void @use(i8*)
+
+; CHECK-LABEL: @local(
+; CHECK-NOT: call void @llvm.memset
+; CHECK: call void @llvm.initialized
+define void @local() {
+entry:
+  %a = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.initialized.p0i8.i64(i8* %p, i64 64)
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %q = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 %i
+  store i8 1, i8* %q
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, 64
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; The marker is in the loop preheader, the memset in the entry block.
+; CHECK-LABEL: @nonlocal(
+; CHECK-NOT: call void @llvm.memset
+; CHECK: call void @llvm.initialized
+define void @nonlocal() {
+entry:
+  %a = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  br label %preheader
+
+preheader:
+  call void @llvm.initialized.p0i8.i64(i8* %p, i64 64)
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %preheader ], [ %i.next, %loop ]
+  %q = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 %i
+  store i8 1, i8* %q
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, 64
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; A path from the memset to the use bypasses the loop, so the memset stays.
+; CHECK-LABEL: @bypassed(
+; CHECK: call void @llvm.memset
+; CHECK: call void @llvm.initialized
+define void @bypassed(i1 %skip) {
+entry:
+  %a = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  br i1 %skip, label %exit, label %preheader
+
+preheader:
+  call void @llvm.initialized.p0i8.i64(i8* %p, i64 64)
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %preheader ], [ %i.next, %loop ]
+  %q = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 %i
+  store i8 1, i8* %q
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, 64
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; Only half of the buffer is covered; the memset is shortened to the rest.
+; CHECK-LABEL: @partial(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+define void @partial() {
+entry:
+  %a = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 0
+  %h = getelementptr inbounds [64 x i8], [64 x i8]* %a, i64 0, i64 32
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.initialized.p0i8.i64(i8* %h, i64 32)
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
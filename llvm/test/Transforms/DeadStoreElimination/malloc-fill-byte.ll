@@ -0,0 +1,40 @@
+; RUN: opt < %s -basicaa -dse -S | FileCheck %s
+
+; With the malloc-fill-byte module flag (SafeInit's pattern-init mode),
+; storing the pattern into a fresh allocation is dead, like storing zero
+; into a calloc'ed one.
+
+declare noalias i8* @malloc(i64)
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: @pattern(
+; CHECK-NOT: store
+; CHECK-NOT: @llvm.memset
+; CHECK: call void @use
+define void @pattern() {
+  %m = call noalias i8* @malloc(i64 64)
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 -52, i64 64, i32 8, i1 false)
+  %p = getelementptr i8, i8* %m, i64 8
+  %q = bitcast i8* %p to i32*
+  store i32 -858993460, i32* %q
+  call void @use(i8* %m)
+  ret void
+}
+
+; CHECK-LABEL: @zero(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 64, i32 8, i1 false)
+; CHECK: store i32 0
+; CHECK: call void @use
+define void @zero() {
+  %m = call noalias i8* @malloc(i64 64)
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 64, i32 8, i1 false)
+  %p = getelementptr i8, i8* %m, i64 8
+  %q = bitcast i8* %p to i32*
+  store i32 0, i32* %q
+  call void @use(i8* %m)
+  ret void
+}
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 2, !"malloc-fill-byte", i32 204}
@@ -0,0 +1,159 @@
+; Test removing and trimming SafeInit memsets overwritten on every path
+; using MemorySSA.
+; RUN: opt < %s -basicaa -dse -enable-safeinit-mssa-dse -S | FileCheck %s
+; RUN: opt < %s -basicaa -dse -S | FileCheck %s --check-prefix=NOMSSA
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture readonly, i64, i32, i1)
+declare void @llvm.lifetime.start(i64, i8* nocapture)
+declare void @llvm.lifetime.end(i64, i8* nocapture)
+
+; Overwritten in both arms of a diamond
+; CHECK-LABEL: @diamond(
+; CHECK-NOT: !stackzeroinit
+; CHECK: ret void
+; NOMSSA-LABEL: @diamond(
+; NOMSSA: !stackzeroinit
+define void @diamond(i1 %c) {
+entry:
+  %a = alloca <2 x i64>, align 16
+  %p = bitcast <2 x i64>* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  br i1 %c, label %then, label %else
+
+then:
+  store <2 x i64> <i64 1, i64 2>, <2 x i64>* %a
+  br label %join
+
+else:
+  store <2 x i64> <i64 3, i64 4>, <2 x i64>* %a
+  br label %join
+
+join:
+  call void @use(i8* %p)
+  ret void
+}
+
+; Read on one path
+; CHECK-LABEL: @read_on_one_path(
+; CHECK: !stackzeroinit
+define void @read_on_one_path(i1 %c) {
+entry:
+  %a = alloca <2 x i64>, align 16
+  %p = bitcast <2 x i64>* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  br i1 %c, label %then, label %join
+
+then:
+  store <2 x i64> <i64 1, i64 2>, <2 x i64>* %a
+  br label %join
+
+join:
+  call void @use(i8* %p)
+  ret void
+}
+
+; Overwritten at the top of a loop, and dead when the loop is skipped
+; CHECK-LABEL: @loop(
+; CHECK-NOT: !stackzeroinit
+; CHECK: ret void
+define void @loop(i64 %n) {
+entry:
+  %a = alloca <2 x i64>, align 16
+  %p = bitcast <2 x i64>* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  br label %header
+
+header:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %body ]
+  %done = icmp eq i64 %i, %n
+  br i1 %done, label %exit, label %body
+
+body:
+  store <2 x i64> <i64 1, i64 2>, <2 x i64>* %a
+  call void @use(i8* %p)
+  %i.next = add i64 %i, 1
+  br label %header
+
+exit:
+  ret void
+}
+
+; Only the first half is overwritten on both paths
+; CHECK-LABEL: @partial(
+; CHECK: [[TAIL:%[0-9]+]] = getelementptr inbounds i8, i8* %p, i64 8
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* [[TAIL]], i8 0, i64 8, i32 8, i1 false), !stackzeroinit
+define void @partial(i1 %c) {
+entry:
+  %a = alloca <2 x i64>, align 16
+  %p = bitcast <2 x i64>* %a to i8*
+  %q = bitcast <2 x i64>* %a to i64*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  br i1 %c, label %then, label %else
+
+then:
+  store i64 1, i64* %q
+  br label %join
+
+else:
+  store <2 x i64> <i64 3, i64 4>, <2 x i64>* %a
+  br label %join
+
+join:
+  call void @use(i8* %p)
+  ret void
+}
+
+; Overwritten in parts, in other blocks, except for the tail
+; CHECK-LABEL: @pieces(
+; CHECK: [[TAIL:%[0-9]+]] = getelementptr inbounds i8, i8* %p, i64 500
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* [[TAIL]], i8 0, i64 12, i32 4, i1 false), !stackzeroinit
+define void @pieces(i8* %src, i1 %c) {
+entry:
+  %a = alloca [512 x i8], align 16
+  %p = getelementptr inbounds [512 x i8], [512 x i8]* %a, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 512, i32 16, i1 false), !stackzeroinit !0
+  br i1 %c, label %then, label %else
+
+then:
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 500, i32 1, i1 false)
+  br label %join
+
+else:
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 256, i32 1, i1 false)
+  %q = getelementptr inbounds [512 x i8], [512 x i8]* %a, i64 0, i64 256
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %q, i8* %src, i64 244, i32 1, i1 false)
+  br label %join
+
+join:
+  call void @use(i8* %p)
+  ret void
+}
+
+; The lifetime ends before any read
+; CHECK-LABEL: @lifetime(
+; CHECK-NOT: !stackzeroinit
+; CHECK: ret void
+define void @lifetime(i1 %c) {
+entry:
+  %a = alloca <2 x i64>, align 16
+  %p = bitcast <2 x i64>* %a to i8*
+  call void @llvm.lifetime.start(i64 16, i8* %p)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  br i1 %c, label %then, label %join
+
+then:
+  store <2 x i64> <i64 1, i64 2>, <2 x i64>* %a
+  call void @use(i8* %p)
+  br label %join
+
+join:
+  call void @llvm.lifetime.end(i64 16, i8* %p)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,70 @@
+; Test the remarks on SafeInit memsets.
+; RUN: opt < %s -basicaa -dse -pass-remarks=dse -pass-remarks-missed=dse -S 2>&1 | FileCheck %s
+; RUN: opt < %s -basicaa -dse -dse-nonlocal-block-budget=0 -pass-remarks-missed=dse -S 2>&1 | FileCheck %s --check-prefix=BUDGET
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK: remark: {{.*}} removed SafeInit memset overwritten by store
+define void @overwritten() {
+  %a = alloca i64, align 8
+  %p = bitcast i64* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  store i64 1, i64* %a
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK: remark: {{.*}} kept SafeInit memset: call to use may read it before store overwrites it
+define void @read_first() {
+  %a = alloca i64, align 8
+  %p = bitcast i64* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  store i64 1, i64* %a
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK: remark: {{.*}} removed SafeInit memset overwritten by store in another block
+; BUDGET: remark: {{.*}} gave up on non-local DSE at store after scanning 0 blocks; SafeInit memsets overwritten in other blocks from here on are kept
+define void @small_nonlocal() {
+entry:
+  %a = alloca i64, align 8
+  %p = bitcast i64* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  br label %next
+
+next:
+  store i64 1, i64* %a
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK: remark: {{.*}} shortened SafeInit memset to 16 bytes, the rest is overwritten by store
+define void @shortened() {
+  %a = alloca [4 x i64], align 16
+  %p = bitcast [4 x i64]* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  %q = getelementptr inbounds [4 x i64], [4 x i64]* %a, i64 0, i64 2
+  %r = bitcast i64* %q to <2 x i64>*
+  store <2 x i64> zeroinitializer, <2 x i64>* %r
+  call void @use(i8* %p)
+  ret void
+}
+
+; Other memsets get no remarks
+; CHECK-NOT: remark
+define void @plain() {
+  %a = alloca i64, align 8
+  %p = bitcast i64* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false)
+  store i64 1, i64* %a
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
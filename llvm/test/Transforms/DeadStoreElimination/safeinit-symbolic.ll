@@ -0,0 +1,71 @@
+; Test removing and shortening SafeInit memsets of variable size, whose
+; lengths ScalarEvolution relates to those of the later writes.
+; RUN: opt < %s -basicaa -dse -S | FileCheck %s
+; RUN: opt < %s -aa-pipeline=basic-aa -passes=dse -S | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture readonly, i64, i32, i1)
+
+; The memcpy computes the VLA's size separately: same value, different
+; instruction.
+define void @same_size(i32 %n, i8* %src) {
+; CHECK-LABEL: define void @same_size(
+; CHECK-NOT: @llvm.memset
+; CHECK: call void @llvm.memcpy
+; CHECK: ret void
+  %nz = zext i32 %n to i64
+  %size = mul i64 %nz, 4
+  %vla = alloca i8, i64 %size, align 16
+  call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 %size, i32 16, i1 false), !stackzeroinit !0
+  %len = shl i64 %nz, 2
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %vla, i8* %src, i64 %len, i32 1, i1 false)
+  call void @use(i8* %vla)
+  ret void
+}
+
+; The later memset writes at least as much: add nuw size, 16.
+define void @larger(i64 %size) {
+; CHECK-LABEL: define void @larger(
+; CHECK-NOT: !stackzeroinit
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %vla, i8 1, i64 %len, i32 16, i1 false)
+; CHECK: ret void
+  %len = add nuw i64 %size, 16
+  %vla = alloca i8, i64 %len, align 16
+  call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 %size, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %vla, i8 1, i64 %len, i32 16, i1 false)
+  call void @use(i8* %vla)
+  ret void
+}
+
+; The later write covers only the start: the init is shortened to the rest.
+define void @shortened(i64 %size, i8* %src) {
+; CHECK-LABEL: define void @shortened(
+; CHECK: [[DEST:%.*]] = getelementptr inbounds i8, i8* %vla, i64 %size
+; CHECK: [[LEN:%.*]] = sub i64 %len, %size
+; CHECK: call void @llvm.memset.p0i8.i64(i8* [[DEST]], i8 0, i64 [[LEN]], i32 16, i1 false), !stackzeroinit
+; CHECK: call void @llvm.memcpy.p0i8.p0i8.i64(i8* %vla, i8* %src, i64 %size, i32 1, i1 false)
+  %len = add nuw i64 %size, 16
+  %vla = alloca i8, i64 %len, align 16
+  call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 %len, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %vla, i8* %src, i64 %size, i32 1, i1 false)
+  call void @use(i8* %vla)
+  ret void
+}
+
+; Nothing is known about the relative sizes: the init stays.
+define void @unrelated(i64 %a, i64 %b, i8* %src) {
+; CHECK-LABEL: define void @unrelated(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 %a, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+  %vla = alloca i8, i64 %a, align 16
+  call void @llvm.memset.p0i8.i64(i8* %vla, i8 0, i64 %a, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %vla, i8* %src, i64 %b, i32 1, i1 false)
+  call void @use(i8* %vla)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,106 @@
+; RUN: opt < %s -basicaa -dse -S | FileCheck %s
+; RUN: opt < %s -basicaa -dse -malloc-returns-zero -S | FileCheck %s --check-prefix=NOINIT
+
+; Heap buffers which are only written (directly, or by nocapture writeonly
+; callees) and freed are never read, so all stores into them are dead.
+
+declare noalias i8* @malloc(i64)
+declare noalias i8* @_Znwm(i64)
+declare void @free(i8* nocapture)
+declare void @fill(i8* nocapture writeonly, i64)
+declare void @use(i8* nocapture)
+declare void @stash(i8**, i8* writeonly) argmemonly
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: @written_and_freed(
+; CHECK-NOT: store
+; CHECK-NOT: memset
+; CHECK: call void @fill
+; CHECK: ret void
+; NOINIT-LABEL: @written_and_freed(
+; NOINIT: call noalias i8* @tc_malloc_noinit(i64 64)
+define void @written_and_freed() {
+  %m = call noalias i8* @malloc(i64 64)
+  %null = icmp eq i8* %m, null
+  br i1 %null, label %out, label %init
+
+init:
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 64, i32 8, i1 false)
+  %p = getelementptr i8, i8* %m, i64 8
+  %q = bitcast i8* %p to i32*
+  store i32 1, i32* %q
+  call void @fill(i8* %m, i64 64)
+  call void @free(i8* %m)
+  br label %out
+
+out:
+  ret void
+}
+
+; The buffer is read by @use, so its stores and its zeroing stay.
+; CHECK-LABEL: @read(
+; CHECK: store i8 1
+; NOINIT-LABEL: @read(
+; NOINIT: call noalias i8* @malloc(i64 64)
+define void @read() {
+  %m = call noalias i8* @malloc(i64 64)
+  store i8 1, i8* %m
+  call void @use(i8* %m)
+  call void @free(i8* %m)
+  ret void
+}
+
+; The buffer escapes through the return value.
+; CHECK-LABEL: @escapes(
+; CHECK: store i8 1
+; NOINIT-LABEL: @escapes(
+; NOINIT: call noalias i8* @malloc(i64 64)
+define i8* @escapes() {
+  %m = call noalias i8* @malloc(i64 64)
+  store i8 1, i8* %m
+  call void @fill(i8* %m, i64 64)
+  ret i8* %m
+}
+
+; @stash only writes the buffer, but keeps its pointer in @g.
+@g = global i8* null
+
+; CHECK-LABEL: @captured(
+; CHECK: store i8 1
+; NOINIT-LABEL: @captured(
+; NOINIT: call noalias i8* @malloc(i64 64)
+define void @captured() {
+  %m = call noalias i8* @malloc(i64 64)
+  store i8 1, i8* %m
+  call void @stash(i8** @g, i8* %m)
+  ret void
+}
+
+; Volatile stores stay.
+; CHECK-LABEL: @volatile(
+; CHECK: store volatile i8 1
+; NOINIT-LABEL: @volatile(
+; NOINIT: call noalias i8* @malloc(i64 64)
+define void @volatile() {
+  %m = call noalias i8* @malloc(i64 64)
+  store volatile i8 1, i8* %m
+  call void @free(i8* %m)
+  ret void
+}
+
+; operator new is only switched for new-expressions.
+; NOINIT-LABEL: @new_expr(
+; NOINIT: call noalias i8* @tc_new_noinit(i64 16) #[[BUILTIN:[0-9]+]]
+; NOINIT: call noalias i8* @_Znwm(i64 16)
+define void @new_expr() {
+  %a = call noalias i8* @_Znwm(i64 16) #0
+  call void @fill(i8* %a, i64 16)
+  %b = call noalias i8* @_Znwm(i64 16)
+  call void @fill(i8* %b, i64 16)
+  ret void
+}
+
+; NOINIT: declare noalias i8* @tc_malloc_noinit(i64)
+; NOINIT: declare noalias i8* @tc_new_noinit(i64)
+
+attributes #0 = { builtin }
@@ -0,0 +1,80 @@
+; RUN: opt -S -functionattrs %s | FileCheck %s
+; RUN: opt -S -functionattrs -malloc-returns-zero %s | FileCheck %s --check-prefix=ZERO
+; RUN: opt -S -functionattrs -basicaa -gvn %s | FileCheck %s --check-prefix=GVN
+
+declare noalias i8* @calloc(i64, i64)
+declare noalias i8* @malloc(i64)
+declare void @abort() noreturn nounwind
+
+; A calloc wrapper that only checks for failure.
+; CHECK: define noalias i8* @xcalloc(i64 %n) #[[ZR:[0-9]+]]
+define i8* @xcalloc(i64 %n) {
+entry:
+  %p = call i8* @calloc(i64 1, i64 %n)
+  %fail = icmp eq i8* %p, null
+  br i1 %fail, label %oom, label %ok
+
+oom:
+  call void @abort()
+  unreachable
+
+ok:
+  ret i8* %p
+}
+
+; Wrappers of wrappers are too.
+; CHECK: define noalias i8* @xcalloc_twice(i64 %n) #[[ZR]]
+define i8* @xcalloc_twice(i64 %n) {
+  %p = call i8* @xcalloc(i64 %n)
+  ret i8* %p
+}
+
+; malloc wrappers only return zeroed memory where malloc does.
+; CHECK: define noalias i8* @xmalloc(i64 %n) {
+; ZERO: define noalias i8* @xmalloc(i64 %n) #[[ZR:[0-9]+]]
+define i8* @xmalloc(i64 %n) {
+entry:
+  %p = call i8* @malloc(i64 %n)
+  %fail = icmp eq i8* %p, null
+  br i1 %fail, label %oom, label %ok
+
+oom:
+  call void @abort()
+  unreachable
+
+ok:
+  ret i8* %p
+}
+
+; Not after writing to the memory.
+; CHECK: define noalias i8* @tagged(i64 %n) {
+; ZERO: define noalias i8* @tagged(i64 %n) {
+define i8* @tagged(i64 %n) {
+  %p = call i8* @calloc(i64 1, i64 %n)
+  store i8 1, i8* %p
+  ret i8* %p
+}
+
+; Nor when the pointer may come from elsewhere.
+@pool = global i8* null
+; CHECK: define i8* @from_pool(i64 %n) {
+define i8* @from_pool(i64 %n) {
+  %free = load i8*, i8** @pool
+  %empty = icmp eq i8* %free, null
+  %fresh = call i8* @calloc(i64 1, i64 %n)
+  %p = select i1 %empty, i8* %fresh, i8* %free
+  ret i8* %p
+}
+
+; Loads from what the wrapper returns fold to zero.
+; GVN-LABEL: define i32 @load_zeroed(
+; GVN: ret i32 0
+define i32 @load_zeroed() {
+  %p = call i8* @xcalloc(i64 16)
+  %q = bitcast i8* %p to i32*
+  %v = load i32, i32* %q
+  ret i32 %v
+}
+
+; CHECK: attributes #[[ZR]] = { "safeinit-zeroed-return" }
+; ZERO: attributes #[[ZR]] = { "safeinit-zeroed-return" }
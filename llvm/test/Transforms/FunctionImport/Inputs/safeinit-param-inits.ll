@@ -0,0 +1,24 @@
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; Too big to be imported, so the caller only sees the summary.
+define void @init_buf(i64 %n, i8* "safeinit-initializes"="16" %buf) {
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 1, i64 16, i32 1, i1 false)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  call void @consume(i64 %n)
+  ret void
+}
+
+define weak void @weak_init(i8* "safeinit-initializes"="16" %buf) {
+  call void @llvm.memset.p0i8.i64(i8* %buf, i8 1, i64 16, i32 1, i1 false)
+  ret void
+}
+
+declare void @consume(i64)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
@@ -0,0 +1,31 @@
+; Test that SafeInit parameter init sizes are carried through the summaries
+; and attached to the declarations of functions which aren't imported.
+; RUN: opt -module-summary %s -o %t.bc
+; RUN: opt -module-summary %p/Inputs/safeinit-param-inits.ll -o %t2.bc
+; RUN: llvm-lto -thinlto -o %t3 %t.bc %t2.bc
+; RUN: llvm-bcanalyzer -dump %t2.bc | FileCheck %s --check-prefix=PERMODULE
+; RUN: llvm-bcanalyzer -dump %t3.thinlto.bc | FileCheck %s --check-prefix=COMBINED
+; RUN: opt -function-import -import-instr-limit=5 -summary-file %t3.thinlto.bc %t.bc -S | FileCheck %s
+
+; PERMODULE: <PERMODULE
+; PERMODULE-NEXT: <PARAM_INITS op0=0 op1=16/>
+; COMBINED-DAG: <PARAM_INITS op0=0 op1=16/>
+; COMBINED-DAG: <PARAM_INITS op0=16/>
+
+; CHECK: declare void @init_buf(i64, i8* "safeinit-initializes"="16")
+; Interposable definitions don't count.
+; CHECK: declare void @weak_init(i8*)
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @caller() {
+  %buf = alloca [16 x i8]
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @init_buf(i64 0, i8* %p)
+  call void @weak_init(i8* %p)
+  ret void
+}
+
+declare void @init_buf(i64, i8*)
+declare void @weak_init(i8*)
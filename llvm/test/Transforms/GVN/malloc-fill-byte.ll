@@ -0,0 +1,60 @@
+; RUN: opt < %s -basicaa -gvn -S | FileCheck %s
+
+; With the malloc-fill-byte module flag (SafeInit's pattern-init mode),
+; loads from fresh allocations read the pattern; calloc still zeroes.
+
+declare noalias i8* @malloc(i64)
+declare noalias i8* @calloc(i64, i64)
+
+; CHECK-LABEL: @int(
+; CHECK-NOT: load
+; CHECK: ret i32 -858993460
+define i32 @int(i64 %n) {
+  %m = call noalias i8* @malloc(i64 %n)
+  %p = bitcast i8* %m to i32*
+  %v = load i32, i32* %p
+  ret i32 %v
+}
+
+; CHECK-LABEL: @fp(
+; CHECK-NOT: load
+; CHECK: ret double 0xCCCCCCCCCCCCCCCC
+define double @fp(i64 %n) {
+  %m = call noalias i8* @malloc(i64 %n)
+  %p = bitcast i8* %m to double*
+  %v = load double, double* %p
+  ret double %v
+}
+
+; CHECK-LABEL: @ptr(
+; CHECK-NOT: load
+; CHECK: ret i8* inttoptr (i64 -3689348814741910324 to i8*)
+define i8* @ptr(i64 %n) {
+  %m = call noalias i8* @malloc(i64 %n)
+  %p = bitcast i8* %m to i8**
+  %v = load i8*, i8** %p
+  ret i8* %v
+}
+
+; An i1 has bits we don't know the value of.
+; CHECK-LABEL: @bool(
+; CHECK: load i1
+define i1 @bool(i64 %n) {
+  %m = call noalias i8* @malloc(i64 %n)
+  %p = bitcast i8* %m to i1*
+  %v = load i1, i1* %p
+  ret i1 %v
+}
+
+; CHECK-LABEL: @zeroed(
+; CHECK-NOT: load
+; CHECK: ret i32 0
+define i32 @zeroed(i64 %n) {
+  %m = call noalias i8* @calloc(i64 %n, i64 4)
+  %p = bitcast i8* %m to i32*
+  %v = load i32, i32* %p
+  ret i32 %v
+}
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 2, !"malloc-fill-byte", i32 204}
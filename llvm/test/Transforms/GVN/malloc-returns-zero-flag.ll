@@ -0,0 +1,19 @@
+; RUN: opt < %s -basicaa -gvn -S | FileCheck %s
+
+; The malloc-returns-zero module flag has the same effect as
+; -malloc-returns-zero.
+
+declare noalias i8* @malloc(i64)
+
+; CHECK-LABEL: @test(
+; CHECK-NOT: load
+; CHECK: ret i32 0
+define i32 @test(i64 %n) {
+  %m = call noalias i8* @malloc(i64 %n)
+  %p = bitcast i8* %m to i32*
+  %v = load i32, i32* %p
+  ret i32 %v
+}
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 2, !"malloc-returns-zero", i32 1}
@@ -0,0 +1,34 @@
+; Test the remarks on loads from SafeInit memsets.
+; RUN: opt < %s -basicaa -gvn -pass-remarks=gvn -pass-remarks-missed=gvn -S 2>&1 | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK: remark: {{.*}} folded load from SafeInit memset
+define i32 @folded() {
+  %a = alloca i64, align 8
+  %p = bitcast i64* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  %q = bitcast i64* %a to i32*
+  %v = load i32, i32* %q
+  call void @use(i8* %p)
+  ret i32 %v
+}
+
+; The load reads past the end of the memset.
+; CHECK-NOT: folded load
+; CHECK: remark: {{.*}} load keeps SafeInit memset alive: its value could not be forwarded from the memset
+; CHECK-NOT: folded load
+define i64 @kept() {
+  %a = alloca i64, align 8
+  %p = bitcast i64* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4, i32 8, i1 false), !stackzeroinit !0
+  %v = load i64, i64* %a
+  call void @use(i8* %p)
+  ret i64 %v
+}
+
+!0 = !{}
@@ -0,0 +1,132 @@
+; RUN: opt < %s -basicaa -gvn -S | FileCheck %s
+; RUN: opt < %s -basicaa -gvn -malloc-returns-zero -S | FileCheck %s --check-prefix=ZERO
+
+; Loads of memory cleared by a SafeInit memset of a whole variable-length
+; alloca or malloc(n) are folded, also from other blocks.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare noalias i8* @malloc(i64)
+declare noalias i8* @memalign(i64, i64)
+declare noalias i8* @realloc(i8*, i64)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @use(i32*)
+
+; CHECK-LABEL: @vla(
+; CHECK-NOT: load
+; CHECK: ret i32 0
+define i32 @vla(i64 %n, i1 %c) {
+entry:
+  %a = alloca i32, i64 %n, align 4
+  %p = bitcast i32* %a to i8*
+  %len = mul i64 4, %n
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 %len, i32 4, i1 false), !stackzeroinit !0
+  br i1 %c, label %read, label %out
+
+read:
+  %q = getelementptr i32, i32* %a, i64 3
+  %v = load i32, i32* %q
+  ret i32 %v
+
+out:
+  call void @use(i32* %a)
+  ret i32 1
+}
+
+; A counter that is only ever incremented starts at zero.
+; CHECK-LABEL: @heap(
+; CHECK-NOT: load
+; CHECK: store i32 1
+; CHECK-NOT: load
+; CHECK: %v = phi i32
+; CHECK-NEXT: ret i32 %v
+define i32 @heap(i64 %n, i1 %c) {
+entry:
+  %m = call noalias i8* @malloc(i64 %n)
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 %n, i32 1, i1 false), !heapzeroinit !0
+  %counter = bitcast i8* %m to i32*
+  br i1 %c, label %if, label %join
+
+if:
+  %old = load i32, i32* %counter
+  %inc = add i32 %old, 1
+  store i32 %inc, i32* %counter
+  br label %join
+
+join:
+  %v = load i32, i32* %counter
+  ret i32 %v
+}
+
+; The memset doesn't cover the whole allocation.
+; CHECK-LABEL: @partial(
+; CHECK: %v = load i32
+define i32 @partial(i64 %n, i64 %k) {
+entry:
+  %m = call noalias i8* @malloc(i64 %n)
+  call void @llvm.memset.p0i8.i64(i8* %m, i8 0, i64 %k, i32 1, i1 false), !heapzeroinit !0
+  %q = bitcast i8* %m to i32*
+  %v = load i32, i32* %q
+  ret i32 %v
+}
+
+; Without the memset, the allocation is only known to be zero if malloc
+; returns zeroed memory.
+; CHECK-LABEL: @nomemset(
+; CHECK: ret i32 undef
+; ZERO-LABEL: @nomemset(
+; ZERO-NOT: load
+; ZERO: ret i32 0
+define i32 @nomemset(i64 %n, i1 %c) {
+entry:
+  %m = call noalias i8* @malloc(i64 %n)
+  %q = bitcast i8* %m to i32*
+  br i1 %c, label %read, label %out
+
+read:
+  %v = load i32, i32* %q
+  ret i32 %v
+
+out:
+  ret i32 1
+}
+
+; memalign returns zeroed memory like malloc.
+; CHECK-LABEL: @aligned(
+; CHECK: ret i32 undef
+; ZERO-LABEL: @aligned(
+; ZERO-NOT: load
+; ZERO: ret i32 0
+define i32 @aligned() {
+entry:
+  %m = call noalias i8* @memalign(i64 64, i64 256)
+  %p = getelementptr i8, i8* %m, i64 128
+  %q = bitcast i8* %p to i32*
+  %v = load i32, i32* %q
+  ret i32 %v
+}
+
+; realloc zeroes what it adds past the old 16 bytes, but keeps those.
+; CHECK-LABEL: @grown(
+; CHECK: %v = load i32
+; CHECK: %w = load i32
+; ZERO-LABEL: @grown(
+; ZERO: %v = load i32
+; ZERO-NOT: load
+; ZERO: ret i32 %v
+define i32 @grown() {
+entry:
+  %m = call noalias i8* @malloc(i64 16)
+  %r = call i8* @realloc(i8* %m, i64 64)
+  %p = getelementptr i8, i8* %r, i64 12
+  %q = bitcast i8* %p to i32*
+  %v = load i32, i32* %q
+  %p2 = getelementptr i8, i8* %r, i64 16
+  %q2 = bitcast i8* %p2 to i32*
+  %w = load i32, i32* %q2
+  %s = add i32 %v, %w
+  ret i32 %s
+}
+
+!0 = !{}
@@ -0,0 +1,107 @@
+; Test that small SafeInit memsets don't count against inlining.
+; RUN: opt < %s -inline -inline-threshold=45 -S | FileCheck %s
+; RUN: opt < %s -inline -inline-threshold=45 -inline-safeinit-memset-size=0 -S | FileCheck %s --check-prefix=CHARGED
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; Enough inits to go over the threshold when they're charged for.
+define void @tagged() {
+  %buf = alloca [32 x i8], align 16
+  %p = getelementptr inbounds [32 x i8], [32 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @untagged() {
+  %buf = alloca [32 x i8], align 16
+  %p = getelementptr inbounds [32 x i8], [32 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 32, i32 16, i1 false)
+  call void @use(i8* %p)
+  ret void
+}
+
+; Big ones become memset calls, and aren't free.
+define void @big() {
+  %buf = alloca [4096 x i8], align 16
+  %p = getelementptr inbounds [4096 x i8], [4096 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4096, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+define void @caller() {
+; CHECK-LABEL: @caller(
+; CHECK-NOT: call void @tagged()
+; CHECK: call void @untagged()
+; CHECK: call void @big()
+; CHECK: ret void
+; CHARGED-LABEL: @caller(
+; CHARGED: call void @tagged()
+; CHARGED: call void @untagged()
+; CHARGED: call void @big()
+  call void @tagged()
+  call void @untagged()
+  call void @big()
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,34 @@
+; RUN: opt < %s -instcombine -S | FileCheck %s
+
+; Small SafeInit memsets become stores which are still marked as zero-inits.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: @stack(
+; CHECK: store i64 0, i64* %{{.*}}, align 8, !stackzeroinit
+define void @stack(i8* %p) {
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK-LABEL: @heap(
+; CHECK: store i32 0, i32* %{{.*}}, align 4, !heapzeroinit
+define void @heap(i8* %p) {
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 4, i32 4, i1 false), !heapzeroinit !0
+  call void @use(i8* %p)
+  ret void
+}
+
+; CHECK-LABEL: @plain(
+; CHECK: store i16 0, i16* %{{.*}}, align 2{{$}}
+define void @plain(i8* %p) {
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 2, i32 2, i1 false)
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,30 @@
+; RUN: opt < %s -basicaa -licm -S | FileCheck %s
+; llvm.initialized markers store nothing, so they don't keep loads of the
+; memory they mark in the loop.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+declare void @llvm.initialized.p0i8.i64(i8* nocapture, i64)
+
+; CHECK-LABEL: @hoist(
+; CHECK: entry:
+; CHECK: %x = load i32, i32* %p
+; CHECK: loop:
+; CHECK: call void @llvm.initialized
+define i32 @hoist(i32* %p, i8* %q, i64 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %s = phi i32 [ 0, %entry ], [ %s.next, %loop ]
+  call void @llvm.initialized.p0i8.i64(i8* %q, i64 16)
+  %x = load i32, i32* %p, align 4
+  %s.next = add i32 %s, %x
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret i32 %s.next
+}
@@ -0,0 +1,98 @@
+; RUN: opt < %s -basicaa -licm -S | FileCheck %s
+; A promoted location that a zero memset (such as SafeInit's) has just
+; cleared starts out as zero rather than as a load before the loop.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @use(i32*)
+declare void @clobber(i8*)
+
+; CHECK-LABEL: @zeroed(
+; CHECK-NOT: .promoted = load
+; CHECK: loop:
+; CHECK: phi i32 [ 0, %entry ], [ %sum, %loop ]
+; CHECK: exit:
+; CHECK-NEXT: %[[OUT:.*]] = phi i32 [ %sum, %loop ]
+; CHECK-NEXT: store i32 %[[OUT]], i32* %f
+define void @zeroed(i32* noalias %a, i64 %n) {
+entry:
+  %buf = alloca [4 x i32], align 16
+  %b = bitcast [4 x i32]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %b, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  %f = getelementptr inbounds [4 x i32], [4 x i32]* %buf, i64 0, i64 2
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = load i32, i32* %f, align 4
+  %p = getelementptr inbounds i32, i32* %a, i64 %i
+  %x = load i32, i32* %p, align 4
+  %sum = add i32 %acc, %x
+  store i32 %sum, i32* %f, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i32* %f)
+  ret void
+}
+
+; Something may write the location after the memset: load it.
+; CHECK-LABEL: @clobbered(
+; CHECK: call void @clobber(
+; CHECK-NEXT: %f.promoted = load i32, i32* %f
+define void @clobbered(i32* noalias %a, i64 %n) {
+entry:
+  %buf = alloca [4 x i32], align 16
+  %b = bitcast [4 x i32]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %b, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  %f = getelementptr inbounds [4 x i32], [4 x i32]* %buf, i64 0, i64 2
+  call void @clobber(i8* %b)
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = load i32, i32* %f, align 4
+  %p = getelementptr inbounds i32, i32* %a, i64 %i
+  %x = load i32, i32* %p, align 4
+  %sum = add i32 %acc, %x
+  store i32 %sum, i32* %f, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i32* %f)
+  ret void
+}
+
+; The memset doesn't cover the location: load it.
+; CHECK-LABEL: @partial(
+; CHECK: %f.promoted = load i32, i32* %f
+define void @partial(i32* noalias %a, i64 %n) {
+entry:
+  %buf = alloca [4 x i32], align 16
+  %b = bitcast [4 x i32]* %buf to i8*
+  call void @llvm.memset.p0i8.i64(i8* %b, i8 0, i64 8, i32 16, i1 false), !stackzeroinit !0
+  %f = getelementptr inbounds [4 x i32], [4 x i32]* %buf, i64 0, i64 2
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = load i32, i32* %f, align 4
+  %p = getelementptr inbounds i32, i32* %a, i64 %i
+  %x = load i32, i32* %p, align 4
+  %sum = add i32 %acc, %x
+  store i32 %sum, i32* %f, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i32* %f)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,146 @@
+; RUN: opt -basicaa -loop-idiom < %s -S | FileCheck %s
+; A SafeInit memset right before a loop which overwrites the object loses the
+; bytes the loop stores.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; The loop stores every element: the memset goes, the marker stays.
+; CHECK-LABEL: @full(
+; CHECK-NOT: call void @llvm.memset
+; CHECK: call void @llvm.initialized
+; CHECK-NOT: call void @llvm.memset
+; CHECK: ret void
+define void @full() {
+entry:
+  %a = alloca [100 x i32], align 16
+  %p = bitcast [100 x i32]* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 400, i32 16, i1 false), !stackzeroinit !0
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %v = mul i64 %i, 3
+  %t = trunc i64 %v to i32
+  %e = getelementptr inbounds [100 x i32], [100 x i32]* %a, i64 0, i64 %i
+  store i32 %t, i32* %e, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 100
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; The loop stores the first half: only the second half is cleared.
+; CHECK-LABEL: @partial(
+; CHECK: %[[REST:.*]] = getelementptr inbounds i8, i8* %p, i64 200
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %[[REST]], i8 0, i64 200, i32 8, i1 false), !stackzeroinit
+; CHECK-NOT: call void @llvm.memset
+; CHECK: ret void
+define void @partial() {
+entry:
+  %a = alloca [100 x i32], align 16
+  %p = bitcast [100 x i32]* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 400, i32 16, i1 false), !stackzeroinit !0
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %v = mul i64 %i, 3
+  %t = trunc i64 %v to i32
+  %e = getelementptr inbounds [100 x i32], [100 x i32]* %a, i64 0, i64 %i
+  store i32 %t, i32* %e, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 50
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; A loop turned into a memset replaces the SafeInit one.
+; CHECK-LABEL: @splat(
+; CHECK-NOT: i8 0, i64 256
+; CHECK: call void @llvm.memset.p0i8.i64(i8* {{.*}}, i8 7, i64 256, i32 1, i1 false)
+; CHECK-NOT: i8 0, i64 256
+; CHECK: ret void
+define void @splat() {
+entry:
+  %a = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %a, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 256, i32 16, i1 false), !stackzeroinit !0
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %e = getelementptr inbounds [256 x i8], [256 x i8]* %a, i64 0, i64 %i
+  store i8 7, i8* %e, align 1
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 256
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; A read of the object before the loop keeps the memset.
+; CHECK-LABEL: @read_before(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 400, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+define void @read_before() {
+entry:
+  %a = alloca [100 x i32], align 16
+  %p = bitcast [100 x i32]* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 400, i32 16, i1 false), !stackzeroinit !0
+  call void @use(i8* %p)
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %v = mul i64 %i, 3
+  %t = trunc i64 %v to i32
+  %e = getelementptr inbounds [100 x i32], [100 x i32]* %a, i64 0, i64 %i
+  store i32 %t, i32* %e, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 100
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+; A loop which might not run keeps the memset.
+; CHECK-LABEL: @guarded(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 400, i32 16, i1 false), !stackzeroinit
+; CHECK: ret void
+define void @guarded(i1 %c) {
+entry:
+  %a = alloca [100 x i32], align 16
+  %p = bitcast [100 x i32]* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 400, i32 16, i1 false), !stackzeroinit !0
+  br i1 %c, label %loop, label %exit
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %v = mul i64 %i, 3
+  %t = trunc i64 %v to i32
+  %e = getelementptr inbounds [100 x i32], [100 x i32]* %a, i64 0, i64 %i
+  store i32 %t, i32* %e, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 100
+  br i1 %done, label %exit, label %loop
+
+exit:
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,57 @@
+; RUN: opt < %s -loop-vectorize -force-vector-interleave=1 -S | FileCheck %s
+; llvm.initialized markers left in a loop body (here, by an inner loop that
+; was fully unrolled) store nothing, and must not change how the loop is
+; vectorized: both loops get the same vectorization factor.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @llvm.initialized.p0i8.i64(i8* nocapture, i64)
+
+; CHECK-LABEL: @plain(
+; CHECK: vector.body:
+; CHECK: store <4 x i32>
+define void @plain(i32* noalias %a, i32* noalias %b, i64 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds i32, i32* %b, i64 %i
+  %v = load i32, i32* %pb, align 4
+  %w = shl i32 %v, 1
+  %pa = getelementptr inbounds i32, i32* %a, i64 %i
+  store i32 %w, i32* %pa, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; CHECK-LABEL: @marked(
+; CHECK: vector.body:
+; CHECK-NOT: @llvm.initialized
+; CHECK: store <4 x i32>
+; CHECK: middle.block:
+define void @marked(i32* noalias %a, i32* noalias %b, i64 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds i32, i32* %b, i64 %i
+  %v = load i32, i32* %pb, align 4
+  %w = shl i32 %v, 1
+  %pa = getelementptr inbounds i32, i32* %a, i64 %i
+  %pa8 = bitcast i32* %pa to i8*
+  call void @llvm.initialized.p0i8.i64(i8* %pa8, i64 4)
+  store i32 %w, i32* %pa, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
@@ -0,0 +1,62 @@
+; RUN: opt < %s -basicaa -memcpyopt -S | FileCheck %s
+
+; Memsets built from SafeInit zero-inits are still marked as zero-inits, as
+; long as nothing else went into them.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%quad = type { i32, i32, i32, i32 }
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture, i64, i32, i1)
+
+; CHECK-LABEL: @merged(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{.*}}, i8 0, i64 16, i32 4, i1 false), !stackzeroinit
+define void @merged(i32* %p) {
+  %p1 = getelementptr inbounds i32, i32* %p, i64 1
+  %p2 = getelementptr inbounds i32, i32* %p, i64 2
+  %p3 = getelementptr inbounds i32, i32* %p, i64 3
+  store i32 0, i32* %p, align 4, !stackzeroinit !0
+  store i32 0, i32* %p1, align 4, !stackzeroinit !0
+  store i32 0, i32* %p2, align 4, !stackzeroinit !0
+  store i32 0, i32* %p3, align 4, !stackzeroinit !0
+  ret void
+}
+
+; A program store of zero merged in makes it an ordinary memset.
+; CHECK-LABEL: @mixed(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{.*}}, i8 0, i64 16, i32 4, i1 false){{$}}
+define void @mixed(i32* %p) {
+  %p1 = getelementptr inbounds i32, i32* %p, i64 1
+  %p2 = getelementptr inbounds i32, i32* %p, i64 2
+  %p3 = getelementptr inbounds i32, i32* %p, i64 3
+  store i32 0, i32* %p, align 4, !stackzeroinit !0
+  store i32 0, i32* %p1, align 4, !stackzeroinit !0
+  store i32 0, i32* %p2, align 4
+  store i32 0, i32* %p3, align 4, !stackzeroinit !0
+  ret void
+}
+
+; CHECK-LABEL: @aggregate(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{.*}}, i8 0, i64 16, i32 4, i1 false), !heapzeroinit
+define void @aggregate(%quad* %p) {
+  store %quad zeroinitializer, %quad* %p, align 4, !heapzeroinit !0
+  ret void
+}
+
+; The part of an init a memcpy doesn't overwrite.
+; CHECK-LABEL: @tail(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{.*}}, i8 0, i64 48, i32 {{[0-9]+}}, i1 false), !stackzeroinit
+; CHECK-NEXT: call void @llvm.memcpy.p0i8.p0i8.i64(i8* %d, i8* %s, i64 16,
+define void @tail(i8* %s) {
+  %buf = alloca [64 x i8], align 16
+  %d = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %d, i8 0, i64 64, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %d, i8* %s, i64 16, i32 1, i1 false)
+  call void @use(i8* %d)
+  ret void
+}
+
+!0 = !{}
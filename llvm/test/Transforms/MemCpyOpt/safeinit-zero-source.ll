@@ -0,0 +1,75 @@
+; RUN: opt < %s -basicaa -memcpyopt -S | FileCheck %s
+; RUN: opt < %s -basicaa -memcpyopt -malloc-returns-zero -S | FileCheck %s --check-prefix=ZERO
+
+; Copies from memory known to be zero become memsets, and disappear when
+; the destination is known to be zero too.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare noalias i8* @malloc(i64)
+declare noalias i8* @calloc(i64, i64)
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture, i64, i32, i1)
+
+; A zeroed local copied into a fresh heap object, which is already zero
+; when malloc returns zeroed memory.
+; CHECK-LABEL: @local_to_heap(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %h, i8 0, i64 64, i32 8, i1 false)
+; CHECK-NOT: @llvm.memcpy
+; ZERO-LABEL: @local_to_heap(
+; ZERO-NOT: call void @llvm.memset.p0i8.i64(i8* %h
+; ZERO-NOT: @llvm.memcpy
+; ZERO: ret i8* %h
+define i8* @local_to_heap() {
+  %buf = alloca [64 x i8], align 8
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 64, i32 8, i1 false), !stackzeroinit !0
+  %h = call noalias i8* @malloc(i64 64)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %h, i8* %p, i64 64, i32 8, i1 false)
+  ret i8* %h
+}
+
+; A copy out of calloc'd memory is a memset.
+; CHECK-LABEL: @from_calloc(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %d, i8 0, i64 32, i32 1, i1 false)
+; CHECK-NOT: @llvm.memcpy
+define void @from_calloc(i8* %d) {
+  %c = call noalias i8* @calloc(i64 1, i64 32)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %d, i8* %c, i64 32, i32 1, i1 false)
+  call void @use(i8* %c)
+  ret void
+}
+
+; A copy out of malloc'd memory only is one if malloc returns zeroed memory.
+; CHECK-LABEL: @from_malloc(
+; CHECK: call void @llvm.memcpy
+; ZERO-LABEL: @from_malloc(
+; ZERO: call void @llvm.memset.p0i8.i64(i8* %d, i8 0, i64 32, i32 1, i1 false)
+; ZERO-NOT: @llvm.memcpy
+define void @from_malloc(i8* %d) {
+  %m = call noalias i8* @malloc(i64 32)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %d, i8* %m, i64 32, i32 1, i1 false)
+  call void @use(i8* %m)
+  ret void
+}
+
+; A copy between two buffers memset to the same value does nothing.
+; CHECK-LABEL: @same_value(
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %d, i8 7, i64 16, i32 1, i1 false)
+; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %p, i8 7, i64 16, i32 8, i1 false)
+; CHECK-NOT: @llvm.memcpy
+; CHECK-NOT: @llvm.memset
+; CHECK: ret void
+define void @same_value(i8* %d) {
+  %buf = alloca [16 x i8], align 8
+  %p = getelementptr inbounds [16 x i8], [16 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memset.p0i8.i64(i8* %d, i8 7, i64 16, i32 1, i1 false)
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 7, i64 16, i32 8, i1 false)
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %d, i8* %p, i64 16, i32 1, i1 false)
+  call void @use(i8* %p)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,28 @@
+; RUN: opt < %s -sroa -S | FileCheck %s
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+; The pieces a SafeInit memset is split into, whether stores or smaller
+; memsets, are still marked as zero-inits.
+
+%pair = type { i64, [16 x i8] }
+
+@g = global [16 x i8] zeroinitializer
+
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture, i64, i32, i1)
+
+; CHECK-LABEL: @split(
+; CHECK: store i64 0, i64* %{{.*}}, !stackzeroinit
+; CHECK: call void @llvm.memset.p0i8.i64(i8* %{{.*}}, i8 0, i64 16, i32 {{[0-9]+}}, i1 false), !stackzeroinit
+define i64 @split() {
+  %a = alloca %pair, align 8
+  %p = bitcast %pair* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 24, i32 8, i1 false), !stackzeroinit !0
+  %f0 = getelementptr inbounds %pair, %pair* %a, i64 0, i32 0
+  %x = load volatile i64, i64* %f0, align 8
+  %f1 = getelementptr inbounds %pair, %pair* %a, i64 0, i32 1, i64 0
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @g, i64 0, i64 0), i8* %f1, i64 16, i32 8, i1 true)
+  ret i64 %x
+}
+
+!0 = !{}
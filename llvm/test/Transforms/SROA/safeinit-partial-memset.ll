@@ -0,0 +1,25 @@
+; RUN: opt < %s -sroa -S | FileCheck %s
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+; SafeInit zero-inits which DSE has trimmed to part of an aggregate are split
+; per slice, and the zero is forwarded once the slices are promoted.
+
+%struct.s = type { i32, float, i32* }
+
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: @test(
+; CHECK-NOT: alloca
+; CHECK: ret float 0.000000e+00
+define float @test(i32* %x) {
+  %a = alloca %struct.s
+  %p = bitcast %struct.s* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  %f2 = getelementptr %struct.s, %struct.s* %a, i32 0, i32 2
+  store i32* %x, i32** %f2
+  %f1 = getelementptr %struct.s, %struct.s* %a, i32 0, i32 1
+  %v = load float, float* %f1
+  ret float %v
+}
+
+!0 = !{}
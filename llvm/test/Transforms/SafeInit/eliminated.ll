@@ -0,0 +1,65 @@
+; REQUIRES: asserts
+; RUN: opt < %s -safeinit -O2 -safeinittracker -disable-output -stats -info-output-file - | FileCheck %s
+
+; Inits which the optimizer (or SafeInit itself) must get rid of entirely:
+; none of these may survive -O2.
+
+; CHECK: {{^ *}}4 safeinit{{ *}} - Counts number of alloca calls with zero-initialization added
+; CHECK-NOT: stackzeroinit memsets which weren't removed
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%struct.pair = type { i64, i64 }
+
+declare void @use(i8*)
+declare void @use_pair(%struct.pair*)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture, i8* nocapture readonly, i64, i32, i1)
+
+; A struct written field by field before it's passed on.
+define void @fields(i64 %a, i64 %b) {
+  %p = alloca %struct.pair, align 8
+  %f0 = getelementptr inbounds %struct.pair, %struct.pair* %p, i64 0, i32 0
+  %f1 = getelementptr inbounds %struct.pair, %struct.pair* %p, i64 0, i32 1
+  store i64 %a, i64* %f0, align 8
+  store i64 %b, i64* %f1, align 8
+  call void @use_pair(%struct.pair* %p)
+  ret void
+}
+
+; A buffer copied into in full.
+define void @copied(i8* %src) {
+  %buf = alloca [64 x i8], align 16
+  %p = getelementptr inbounds [64 x i8], [64 x i8]* %buf, i64 0, i64 0
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %p, i8* %src, i64 64, i32 1, i1 false)
+  call void @use(i8* %p)
+  ret void
+}
+
+; Scalars which SROA promotes: the init becomes a plain zero.
+define i32 @scalar(i1 %c, i32 %v) {
+entry:
+  %x = alloca i32, align 4
+  br i1 %c, label %set, label %done
+
+set:
+  store i32 %v, i32* %x, align 4
+  br label %done
+
+done:
+  %r = load i32, i32* %x, align 4
+  ret i32 %r
+}
+
+; A local array only ever read at indices written just before.
+define i64 @array(i64 %a) {
+  %arr = alloca [4 x i64], align 16
+  %e0 = getelementptr inbounds [4 x i64], [4 x i64]* %arr, i64 0, i64 0
+  %e1 = getelementptr inbounds [4 x i64], [4 x i64]* %arr, i64 0, i64 1
+  store i64 %a, i64* %e0, align 16
+  store i64 %a, i64* %e1, align 8
+  %x = load i64, i64* %e0, align 16
+  %y = load i64, i64* %e1, align 8
+  %s = add i64 %x, %y
+  ret i64 %s
+}
@@ -0,0 +1,53 @@
+; REQUIRES: asserts
+; RUN: opt < %s -safeinit -O2 -safeinittracker -disable-output -stats -info-output-file - | FileCheck %s
+
+; Inits the optimizer can't (yet) get rid of, and their budget: no more than
+; these may survive -O2. If a change removes one, lower the budget.
+
+; CHECK-DAG: {{^ *}}3 safeinit{{ *}} - Counts number of alloca calls with zero-initialization added
+; CHECK-DAG: {{^ *}}2 safeinittracker{{ *}} - Counts number of stackzeroinit memsets which weren't removed
+; CHECK-DAG: {{^ *}}280 safeinittracker{{ *}} - Counts number of bytes in constant-size stackzeroinit memsets which weren't removed
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @use(i8*)
+declare i64 @sum(i64*, i64)
+
+; Passed to a function we know nothing about.
+define void @escapes() {
+  %buf = alloca [256 x i8], align 16
+  %p = getelementptr inbounds [256 x i8], [256 x i8]* %buf, i64 0, i64 0
+  call void @use(i8* %p)
+  ret void
+}
+
+; Filled by a loop: LoopIdiomRecognize drops the init, so it isn't counted.
+define i64 @loop_filled() {
+entry:
+  %arr = alloca [512 x i64], align 16
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %e = getelementptr inbounds [512 x i64], [512 x i64]* %arr, i64 0, i64 %i
+  store i64 %i, i64* %e, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %more = icmp ult i64 %i.next, 512
+  br i1 %more, label %loop, label %exit
+
+exit:
+  %p = getelementptr inbounds [512 x i64], [512 x i64]* %arr, i64 0, i64 0
+  %s = call i64 @sum(i64* %p, i64 512)
+  ret i64 %s
+}
+
+; Only partly written before it's passed on: the other 24 bytes are cleared.
+define void @partial(i64 %v) {
+  %buf = alloca [4 x i64], align 16
+  %e0 = getelementptr inbounds [4 x i64], [4 x i64]* %buf, i64 0, i64 0
+  store i64 %v, i64* %e0, align 16
+  %p = bitcast [4 x i64]* %buf to i8*
+  call void @use(i8* %p)
+  ret void
+}
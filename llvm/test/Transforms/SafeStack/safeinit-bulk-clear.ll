@@ -0,0 +1,39 @@
+; RUN: opt -safe-stack -S -mtriple=x86_64-pc-linux-gnu < %s -o - | FileCheck %s
+; RUN: opt -safe-stack -safe-stack-safeinit-bulk-clear=false -S -mtriple=x86_64-pc-linux-gnu < %s -o - | FileCheck -check-prefix=OFF %s
+
+; SafeInit's entry inits of unsafe allocas become one clear of the part of
+; the unsafe frame they occupy.
+
+declare void @use(i8*)
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+define void @foo(i64 %x) safestack {
+entry:
+  ; CHECK: %[[USP:.*]] = load i8*, i8** @__safestack_unsafe_stack_ptr
+  ; CHECK: %[[USST:.*]] = getelementptr i8, i8* %[[USP]], i32 -64
+  ; CHECK-NEXT: store i8* %[[USST]], i8** @__safestack_unsafe_stack_ptr
+  ; CHECK-NEXT: %[[BULK:.*]] = getelementptr i8, i8* %[[USP]], i32 -48
+  ; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %[[BULK]], i8 0, i64 48, i32 16, i1 false), !stackzeroinit
+  ; CHECK-NOT: call void @llvm.memset.p0i8.i64(i8* %pa
+  ; CHECK-NOT: call void @llvm.memset.p0i8.i64(i8* %pb
+  ; CHECK: store i64 %x
+  ; CHECK-NEXT: call void @llvm.memset.p0i8.i64(i8* %c, i8 0, i64 8, i32 8, i1 false), !stackzeroinit
+  ; OFF: call void @llvm.memset.p0i8.i64(i8* %pa, i8 0, i64 16, i32 16, i1 false), !stackzeroinit
+  ; OFF: call void @llvm.memset.p0i8.i64(i8* %pb, i8 0, i64 32, i32 8, i1 false), !stackzeroinit
+  %a = alloca [16 x i8], align 16
+  %b = alloca [32 x i8], align 8
+  %c.i64 = alloca i64, align 8
+  %pa = getelementptr inbounds [16 x i8], [16 x i8]* %a, i64 0, i64 0
+  %pb = getelementptr inbounds [32 x i8], [32 x i8]* %b, i64 0, i64 0
+  %c = bitcast i64* %c.i64 to i8*
+  call void @llvm.memset.p0i8.i64(i8* %pa, i8 0, i64 16, i32 16, i1 false), !stackzeroinit !0
+  call void @llvm.memset.p0i8.i64(i8* %pb, i8 0, i64 32, i32 8, i1 false), !stackzeroinit !0
+  store i64 %x, i64* %c.i64
+  call void @llvm.memset.p0i8.i64(i8* %c, i8 0, i64 8, i32 8, i1 false), !stackzeroinit !0
+  call void @use(i8* %pa)
+  call void @use(i8* %pb)
+  call void @use(i8* %c)
+  ret void
+}
+
+!0 = !{}
@@ -0,0 +1,54 @@
+; RUN: opt < %s -scalarrepl -S | FileCheck %s
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+; Memsets of a run of whole elements, such as SafeInit zero-inits trimmed by
+; DSE, are split per element rather than blocking scalar replacement.
+
+%struct.s = type { i32, float, i8, [8 x i32] }
+
+declare void @llvm.memset.p0i8.i64(i8* nocapture, i8, i64, i32, i1)
+
+; CHECK-LABEL: @test(
+; CHECK-NOT: alloca
+; CHECK: ret i32 0
+define i32 @test(i32 %x) {
+  %a = alloca %struct.s
+  %p = bitcast %struct.s* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 8, i32 4, i1 false), !stackzeroinit !0
+  %arr = getelementptr %struct.s, %struct.s* %a, i32 0, i32 3, i32 2
+  store i32 %x, i32* %arr
+  %f0 = getelementptr %struct.s, %struct.s* %a, i32 0, i32 0
+  %v = load i32, i32* %f0
+  ret i32 %v
+}
+
+; The range may end in padding.
+; CHECK-LABEL: @padding(
+; CHECK-NOT: alloca
+; CHECK: ret i8 0
+define i8 @padding() {
+  %a = alloca %struct.s
+  %p = bitcast %struct.s* %a to i8*
+  %q = getelementptr i8, i8* %p, i64 4
+  call void @llvm.memset.p0i8.i64(i8* %q, i8 0, i64 8, i32 4, i1 false), !stackzeroinit !0
+  %f2 = getelementptr %struct.s, %struct.s* %a, i32 0, i32 2
+  %v = load i8, i8* %f2
+  ret i8 %v
+}
+
+; A memset ending inside an element isn't split; the whole alloca becomes one
+; integer instead, with the memset as a mask.
+; CHECK-LABEL: @partial(
+; CHECK-NOT: alloca
+; CHECK: %mask = and i352 undef, -281474976710656
+; CHECK: trunc i352 %mask to i32
+define i32 @partial() {
+  %a = alloca %struct.s
+  %p = bitcast %struct.s* %a to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p, i8 0, i64 6, i32 4, i1 false), !stackzeroinit !0
+  %f0 = getelementptr %struct.s, %struct.s* %a, i32 0, i32 0
+  %v = load i32, i32* %f0
+  ret i32 %v
+}
+
+!0 = !{}
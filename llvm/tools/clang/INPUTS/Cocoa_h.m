@@ -0,0 +1,2 @@
+
+#import <Cocoa/Cocoa.h>
@@ -0,0 +1,3 @@
+// Not a guarded header!
+
+void f();
@@ -0,0 +1,2 @@
+int DECL_ONE = 1;
+int DECL_TWO = 2;
@@ -0,0 +1,6 @@
+
+@interface ExtInterface {
+  __strong ExtInterface *myivar;
+  __strong void *gcVar;
+}
+@end
@@ -0,0 +1 @@
+unsigned *Buried_Treasure;
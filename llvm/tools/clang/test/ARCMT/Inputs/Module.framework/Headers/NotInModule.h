@@ -0,0 +1 @@
+int not_in_module;
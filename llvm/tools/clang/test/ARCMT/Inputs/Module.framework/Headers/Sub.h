@@ -0,0 +1,3 @@
+#include <Module/Sub2.h>
+int *Module_Sub;
+
@@ -0,0 +1 @@
+int *Module_Sub2;
@@ -0,0 +1 @@
+// the contents are not important
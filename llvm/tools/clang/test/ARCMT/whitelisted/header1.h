@@ -0,0 +1,6 @@
+
+@interface I1 : NSObject
+-(int)prop;
+-(void)setProp:(int)p;
++(id)i1;
+@end
@@ -0,0 +1 @@
+double x2;
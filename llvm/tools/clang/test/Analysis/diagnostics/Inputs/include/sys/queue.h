@@ -0,0 +1,4 @@
+
+void free(void *);
+#define FREE_POINTER(x) free(x)
+
@@ -0,0 +1,7 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+namespace A {
+  namespace B { }
+}
+
+using A::B; // expected-error{{using declaration cannot refer to a namespace}}
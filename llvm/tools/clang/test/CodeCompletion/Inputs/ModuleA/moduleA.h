@@ -0,0 +1 @@
+static int const FROM_MODULE_A = 0;
@@ -0,0 +1 @@
+struct X { int m; };
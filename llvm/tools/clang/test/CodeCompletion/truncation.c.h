@@ -0,0 +1,5 @@
+struct X { };
+struct Y { };
+
+struct Xa { };
+
@@ -0,0 +1,2 @@
+// RUN: %clang_cc1 %s -emit-llvm -debug-info-kind=limited -o /dev/null
+void foo() {}